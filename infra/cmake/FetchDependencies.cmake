@@ -20,6 +20,20 @@ macro(fetch_catch2)
     include(Catch)
 endmacro()
 
+# https://github.com/google/benchmark
+macro(fetch_google_benchmark)
+    FetchContent_Declare(
+    benchmark
+    GIT_REPOSITORY https://github.com/google/benchmark.git
+    GIT_TAG        344117638c8ff7e239044fd0fa7085839fc03021 # v1.8.3
+    SYSTEM
+    FIND_PACKAGE_ARGS
+    )
+    set(BENCHMARK_ENABLE_TESTING OFF CACHE INTERNAL "")
+    set(BENCHMARK_ENABLE_GTEST_TESTS OFF CACHE INTERNAL "")
+    FetchContent_MakeAvailable(benchmark)
+endmacro()
+
 # https://json.nlohmann.me/integration/cmake/#supporting-both
 macro(fetch_nlohmann_json)
     FetchContent_Declare(
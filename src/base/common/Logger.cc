@@ -3,14 +3,18 @@
 #include "TimeUtils.h"
 
 #include "spdlog/sinks/syslog_sink.h"
+#include <spdlog/async.h>
 #include <spdlog/sinks/basic_file_sink.h>
+#include <spdlog/sinks/stdout_color_sinks.h>
 #include <spdlog/spdlog.h>
 
+#include <algorithm>
 #include <cassert>
 #include <filesystem>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <limits>
 #include <thread>
 #include <time.h>
 
@@ -37,6 +41,7 @@ void Logger::initialize(const LoggerContext& context)
     m_initialized = true;
 
     m_context.m_config = context.m_config;
+    update_min_level();
 
     if (context.m_logger_impl) {
         spdlog::set_default_logger(context.m_logger_impl);
@@ -52,12 +57,28 @@ void Logger::do_initialize(
     m_initialized = true;
 
     m_context.m_config = config;
+    update_min_level();
 
     if (!m_context.m_config.is_active()) {
         return;
     }
 
-    if (!m_context.m_config.is_console_only()) {
+    const bool is_async = m_context.m_config.is_async();
+
+    std::string logger_name;
+    spdlog::sink_ptr sink;
+    if (m_context.m_config.is_console_only()) {
+        if (is_async) {
+            logger_name = "hestia_console";
+            sink = std::make_shared<spdlog::sinks::stdout_color_sink_mt>();
+        }
+    }
+    else if (m_context.m_config.is_syslog_only()) {
+        logger_name = "syslog";
+        sink        = std::make_shared<spdlog::sinks::syslog_sink_mt>(
+            "hestiad", LOG_PID, LOG_USER, false);
+    }
+    else {
         if (m_context.m_config.get_log_prefix().empty()) {
             m_context.m_config.set_log_prefix("hestia_app");
         }
@@ -75,15 +96,25 @@ void Logger::do_initialize(
             "_" + TimeUtils::get_current_time_hr() + ".txt";
         logger_path += suffix;
 
+        logger_name = m_context.m_config.get_log_prefix();
+        sink        = std::make_shared<spdlog::sinks::basic_file_sink_mt>(
+            logger_path.string(), true);
+    }
+
+    if (sink) {
         std::shared_ptr<spdlog::logger> logger;
-        if (m_context.m_config.is_syslog_only()) {
-            std::string ident = "hestiad";
-            logger = spdlog::syslog_logger_mt("syslog", ident, LOG_PID);
+        if (is_async) {
+            // Messages go on a bounded queue drained by a single thread - when
+            // it is full the oldest are dropped rather than blocking the caller
+            const auto queue_size = std::max(
+                m_context.m_config.get_async_queue_size(), std::size_t{1});
+            spdlog::init_thread_pool(queue_size, 1);
+            logger = std::make_shared<spdlog::async_logger>(
+                logger_name, sink, spdlog::thread_pool(),
+                spdlog::async_overflow_policy::overrun_oldest);
         }
         else {
-            logger = spdlog::basic_logger_mt(
-                m_context.m_config.get_log_prefix(), logger_path.string(),
-                true);
+            logger = std::make_shared<spdlog::logger>(logger_name, sink);
         }
         m_context.m_logger_impl = logger;
         spdlog::set_default_logger(logger);
@@ -109,12 +140,28 @@ void Logger::do_initialize(
     spdlog::flush_on(spdlog::level::info);
 }
 
+void Logger::update_min_level()
+{
+    if (m_context.m_config.is_active()) {
+        m_min_level = static_cast<int>(m_context.m_config.get_level());
+    }
+    else {
+        m_min_level = std::numeric_limits<int>::max();
+    }
+}
+
 std::string location_prefix(
     const std::string& file_name,
     const std::string& function_name,
     int line_number)
 {
-    return std::filesystem::path(file_name).stem().string()
+    auto stem_start = file_name.find_last_of('/');
+    stem_start      = stem_start == std::string::npos ? 0 : stem_start + 1;
+    auto stem_end   = file_name.find_last_of('.');
+    if (stem_end == std::string::npos || stem_end < stem_start) {
+        stem_end = file_name.size();
+    }
+    return file_name.substr(stem_start, stem_end - stem_start)
            + "::" + function_name + "::" + std::to_string(line_number);
 }
 
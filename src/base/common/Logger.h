@@ -2,15 +2,27 @@
 
 #include "LoggerConfig.h"
 
+#include <atomic>
 #include <memory>
 #include <sstream>
 
+// Log calls below this level (0 DEBUG to 3 ERROR) are compiled out - it is
+// set from the HESTIA_MIN_LOG_LEVEL build option.
+#ifndef HESTIA_MIN_LOG_LEVEL
+#define HESTIA_MIN_LOG_LEVEL 0
+#endif
+
+// The level is checked before the message is formatted, so disabled log
+// calls cost a single load and compare.
 #define LOG_BASE(msg, level)                                                   \
     {                                                                          \
-        std::ostringstream logstream;                                          \
-        logstream << msg;                                                      \
-        hestia::Logger::get_instance().log_line(                               \
-            level, logstream, __FILE__, __FUNCTION__, __LINE__);               \
+        if (static_cast<int>(level) >= HESTIA_MIN_LOG_LEVEL                    \
+            && hestia::Logger::get_instance().should_log(level)) {             \
+            std::ostringstream logstream;                                      \
+            logstream << msg;                                                  \
+            hestia::Logger::get_instance().log_line(                           \
+                level, logstream, __FILE__, __FUNCTION__, __LINE__);           \
+        }                                                                      \
     };
 
 #define LOG_ERROR(msg) LOG_BASE(msg, hestia::LoggerConfig::Level::ERROR);
@@ -45,6 +57,18 @@ class Logger {
 
     LoggerContext& get_modifiable_context();
 
+    /**
+     * Whether a message at this level would be logged with the current config
+     *
+     * @param level The log level
+     * @return True if the message would be logged
+     */
+    bool should_log(LoggerConfig::Level level) const
+    {
+        return static_cast<int>(level)
+               >= m_min_level.load(std::memory_order_relaxed);
+    }
+
     void log_line(
         LoggerConfig::Level level,
         const std::ostringstream& line,
@@ -53,7 +77,11 @@ class Logger {
         int line_number                  = -1);
 
   private:
+    void update_min_level();
+
     LoggerContext m_context;
     bool m_initialized{false};
+    std::atomic<int> m_min_level{
+        static_cast<int>(LoggerConfig::Level::INFO)};
 };
 }  // namespace hestia
\ No newline at end of file
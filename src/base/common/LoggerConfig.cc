@@ -16,13 +16,15 @@ LoggerConfig& LoggerConfig::operator=(const LoggerConfig& other)
 {
     if (this != &other) {
         SerializeableWithFields::operator=(other);
-        m_log_file_path   = other.m_log_file_path;
-        m_log_file_prefix = other.m_log_file_prefix;
-        m_active          = other.m_active;
-        m_console_only    = other.m_console_only;
-        m_syslog_only     = other.m_syslog_only;
-        m_assert          = other.m_assert;
-        m_level           = other.m_level;
+        m_log_file_path    = other.m_log_file_path;
+        m_log_file_prefix  = other.m_log_file_prefix;
+        m_active           = other.m_active;
+        m_console_only     = other.m_console_only;
+        m_syslog_only      = other.m_syslog_only;
+        m_async            = other.m_async;
+        m_async_queue_size = other.m_async_queue_size;
+        m_assert           = other.m_assert;
+        m_level            = other.m_level;
         init();
     }
     return *this;
@@ -35,6 +37,8 @@ void LoggerConfig::init()
     register_scalar_field(&m_active);
     register_scalar_field(&m_console_only);
     register_scalar_field(&m_syslog_only);
+    register_scalar_field(&m_async);
+    register_scalar_field(&m_async_queue_size);
     register_scalar_field(&m_assert);
     register_scalar_field(&m_level);
 }
@@ -64,6 +68,16 @@ bool LoggerConfig::is_syslog_only() const
     return m_syslog_only.get_value();
 }
 
+bool LoggerConfig::is_async() const
+{
+    return m_async.get_value();
+}
+
+std::size_t LoggerConfig::get_async_queue_size() const
+{
+    return m_async_queue_size.get_value();
+}
+
 std::string LoggerConfig::get_type()
 {
     return s_type;
@@ -27,6 +27,10 @@ class LoggerConfig : public SerializeableWithFields {
 
     bool is_syslog_only() const;
 
+    bool is_async() const;
+
+    std::size_t get_async_queue_size() const;
+
     bool should_assert() const { return m_assert.get_value(); }
 
     void set_log_path(const std::string& path)
@@ -58,6 +62,8 @@ class LoggerConfig : public SerializeableWithFields {
 
     void set_level(Level level) { m_level.update_value(level); }
 
+    void set_async(bool async) { m_async.update_value(async); }
+
     LoggerConfig& operator=(const LoggerConfig& other);
 
   private:
@@ -70,6 +76,8 @@ class LoggerConfig : public SerializeableWithFields {
     BooleanField m_assert{"assert", false};
     BooleanField m_console_only{"console_only", false};
     BooleanField m_syslog_only{"syslog_only", false};
+    BooleanField m_async{"async", false};
+    UIntegerField m_async_queue_size{"async_queue_size", 8192};
     EnumField<Level, Level_enum_string_converter> m_level{"level", Level::INFO};
 };
 }  // namespace hestia
\ No newline at end of file
@@ -0,0 +1,88 @@
+#include "ThreadPool.h"
+
+#include "Logger.h"
+
+#include <algorithm>
+
+ThreadPool::ThreadPool(std::size_t num_threads)
+{
+    if (num_threads == 0) {
+        num_threads = std::max(1U, std::thread::hardware_concurrency());
+    }
+
+    m_workers.reserve(num_threads);
+    for (std::size_t idx = 0; idx < num_threads; idx++) {
+        m_workers.emplace_back(&ThreadPool::run_worker, this);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    shut_down();
+}
+
+bool ThreadPool::add_task(Task task)
+{
+    {
+        std::scoped_lock guard(m_mutex);
+        if (!m_accepting) {
+            return false;
+        }
+        m_tasks.push_back(std::move(task));
+    }
+    m_task_cv.notify_one();
+    return true;
+}
+
+void ThreadPool::shut_down()
+{
+    {
+        std::scoped_lock guard(m_mutex);
+        if (!m_accepting) {
+            return;
+        }
+        m_accepting = false;
+    }
+    m_task_cv.notify_all();
+
+    for (auto& worker : m_workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+}
+
+std::size_t ThreadPool::size() const
+{
+    return m_workers.size();
+}
+
+std::size_t ThreadPool::get_num_queued() const
+{
+    std::scoped_lock guard(m_mutex);
+    return m_tasks.size();
+}
+
+void ThreadPool::run_worker()
+{
+    while (true) {
+        Task task;
+        {
+            std::unique_lock<std::mutex> lck(m_mutex);
+            m_task_cv.wait(
+                lck, [this]() { return !m_tasks.empty() || !m_accepting; });
+            if (m_tasks.empty()) {
+                return;
+            }
+            task = std::move(m_tasks.front());
+            m_tasks.pop_front();
+        }
+
+        try {
+            task();
+        }
+        catch (const std::exception& e) {
+            LOG_ERROR("Uncaught exception in thread pool task: " << e.what());
+        }
+    }
+}
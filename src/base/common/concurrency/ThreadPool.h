@@ -0,0 +1,65 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief A fixed-size pool of worker threads running queued tasks
+ *
+ * Tasks are run in the order they are added. On shut down no new tasks are
+ * accepted, tasks already queued are run to completion and the workers are
+ * joined.
+ */
+class ThreadPool {
+  public:
+    using Task = std::function<void()>;
+
+    /**
+     * Constructor
+     *
+     * @param num_threads Number of worker threads - if 0 one per hardware thread is used
+     */
+    ThreadPool(std::size_t num_threads = 0);
+
+    ~ThreadPool();
+
+    /**
+     * Queue a task to be run on a worker
+     *
+     * @param task The task to run
+     * @return False if the pool is shut down and the task was not queued
+     */
+    bool add_task(Task task);
+
+    /**
+     * Stop accepting tasks, finish the queued ones and join the workers
+     */
+    void shut_down();
+
+    /**
+     * Number of worker threads
+     *
+     * @return Number of worker threads
+     */
+    std::size_t size() const;
+
+    /**
+     * Number of tasks queued but not yet picked up by a worker
+     *
+     * @return Number of queued tasks
+     */
+    std::size_t get_num_queued() const;
+
+  private:
+    void run_worker();
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_task_cv;
+    std::deque<Task> m_tasks;
+    std::vector<std::thread> m_workers;
+    bool m_accepting{true};
+};
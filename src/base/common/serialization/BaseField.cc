@@ -27,6 +27,11 @@ bool BaseField::is_primary_key() const
     return m_is_primary_key;
 }
 
+bool BaseField::is_secondary_index() const
+{
+    return m_is_secondary_index;
+}
+
 BaseField::IndexScope BaseField::get_index_scope() const
 {
     return m_index_scope;
@@ -37,6 +42,11 @@ void BaseField::set_is_primary_key(bool is_primary)
     m_is_primary_key = is_primary;
 }
 
+void BaseField::set_is_secondary_index(bool is_index)
+{
+    m_is_secondary_index = is_index;
+}
+
 void BaseField::set_index_scope(IndexScope index_scope)
 {
     m_index_scope = index_scope;
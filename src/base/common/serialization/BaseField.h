@@ -29,6 +29,8 @@ class BaseField {
 
     bool is_primary_key() const;
 
+    bool is_secondary_index() const;
+
     bool modified() const;
 
     void reset();
@@ -37,10 +39,20 @@ class BaseField {
 
     void set_is_primary_key(bool is_primary);
 
+    /**
+     * Mark the field as a secondary index. Unlike the unique name indices
+     * many items can share a value - stores keep the set of items with each
+     * value so they can be filtered on without a full scan.
+     *
+     * @param is_index True if the field should be indexed
+     */
+    void set_is_secondary_index(bool is_index);
+
   protected:
     bool m_modified{false};
     IndexScope m_index_scope{IndexScope::NONE};
     bool m_is_primary_key{false};
+    bool m_is_secondary_index{false};
     std::string m_name;
 };
 
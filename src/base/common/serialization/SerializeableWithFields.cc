@@ -1,5 +1,6 @@
 #include "SerializeableWithFields.h"
 
+#include <algorithm>
 #include <iostream>
 #include <stdexcept>
 
@@ -112,6 +113,33 @@ void SerializeableWithFields::get_index_fields(
     }
 }
 
+void SerializeableWithFields::get_secondary_index_fields(
+    std::vector<std::string>& names) const
+{
+    for (const auto& [name, field] : m_scalar_fields) {
+        if (field->is_secondary_index()) {
+            names.push_back(name);
+        }
+    }
+    for (const auto& [name, field] : m_map_fields) {
+        if (field->is_secondary_index()) {
+            names.push_back(name);
+        }
+    }
+    std::sort(names.begin(), names.end());
+}
+
+void SerializeableWithFields::get_unique_index_fields(
+    std::vector<std::string>& names) const
+{
+    for (const auto& [name, field] : m_scalar_fields) {
+        if (field->get_index_scope() != BaseField::IndexScope::NONE) {
+            names.push_back(name);
+        }
+    }
+    std::sort(names.begin(), names.end());
+}
+
 void SerializeableWithFields::register_scalar_field(ScalarField* field)
 {
     m_scalar_fields[field->get_name()] = field;
@@ -49,6 +49,20 @@ class SerializeableWithFields : public Serializeable {
 
     void get_index_fields(std::vector<IndexField>& fields) const;
 
+    /**
+     * Get the names of fields marked as secondary indices, in sorted order
+     *
+     * @param names Filled with the field names
+     */
+    void get_secondary_index_fields(std::vector<std::string>& names) const;
+
+    /**
+     * Get the names of fields with a unique index, e.g. name, in sorted order
+     *
+     * @param names Filled with the field names
+     */
+    void get_unique_index_fields(std::vector<std::string>& names) const;
+
     std::string get_primary_key() const;
 
     std::string get_primary_key_name() const;
@@ -6,17 +6,134 @@
 #include "Logger.h"
 #include "StreamState.h"
 
+#include <condition_variable>
+#include <deque>
 #include <iostream>
+#include <mutex>
 #include <stdexcept>
 
 namespace hestia {
 
+/**
+ * @brief A fixed ring of staging buffers shared by a reading and writing thread
+ *
+ * The producer takes a free buffer, fills it from the Source and hands it
+ * over. The consumer takes filled buffers in order, drains them to the Sink and
+ * hands them back. Either side can abort the other on error.
+ */
+class StreamBufferRing {
+  public:
+    struct Slot {
+        std::vector<char> m_data;
+        std::size_t m_size{0};
+        bool m_last{false};
+    };
+
+    StreamBufferRing(std::size_t block_size, std::size_t num_buffers) :
+        m_slots(num_buffers)
+    {
+        for (std::size_t idx = 0; idx < num_buffers; idx++) {
+            m_slots[idx].m_data.resize(block_size);
+            m_free.push_back(idx);
+        }
+    }
+
+    Slot* acquire_free()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_free_cv.wait(lock, [this] { return m_aborted || !m_free.empty(); });
+        if (m_aborted) {
+            return nullptr;
+        }
+        const auto idx = m_free.front();
+        m_free.pop_front();
+        return &m_slots[idx];
+    }
+
+    void push_filled(Slot* slot)
+    {
+        {
+            std::scoped_lock guard(m_mutex);
+            m_filled.push_back(index_of(slot));
+        }
+        m_filled_cv.notify_one();
+    }
+
+    Slot* acquire_filled()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_filled_cv.wait(
+            lock, [this] { return m_aborted || !m_filled.empty(); });
+        if (m_aborted) {
+            return nullptr;
+        }
+        const auto idx = m_filled.front();
+        m_filled.pop_front();
+        return &m_slots[idx];
+    }
+
+    void release(Slot* slot)
+    {
+        {
+            std::scoped_lock guard(m_mutex);
+            m_free.push_back(index_of(slot));
+        }
+        m_free_cv.notify_one();
+    }
+
+    void abort()
+    {
+        {
+            std::scoped_lock guard(m_mutex);
+            m_aborted = true;
+        }
+        m_free_cv.notify_all();
+        m_filled_cv.notify_all();
+    }
+
+  private:
+    std::size_t index_of(const Slot* slot) const
+    {
+        return static_cast<std::size_t>(slot - &m_slots[0]);
+    }
+
+    std::vector<Slot> m_slots;
+    std::deque<std::size_t> m_free;
+    std::deque<std::size_t> m_filled;
+    bool m_aborted{false};
+    std::mutex m_mutex;
+    std::condition_variable m_free_cv;
+    std::condition_variable m_filled_cv;
+};
+
+Stream::~Stream()
+{
+    if (m_deferred_flush.valid()) {
+        m_deferred_flush.wait();
+    }
+}
+
 Stream::Ptr Stream::create()
 {
     return std::make_unique<Stream>();
 }
 
 StreamState Stream::reset()
+{
+    StreamState flush_state;
+    if (m_deferred_flush.valid()) {
+        flush_state = m_deferred_flush.get();
+    }
+
+    auto stream_state = do_reset();
+    if (!flush_state.ok() || stream_state.ok()) {
+        stream_state = flush_state;
+    }
+    on_complete(stream_state);
+    return stream_state;
+}
+
+StreamState Stream::do_reset()
 {
     StreamState stream_state;
     if (m_sink) {
@@ -43,12 +160,16 @@ StreamState Stream::reset()
     }
     m_transfer_interval = 0;
     m_transfer_progress = 0;
+    return stream_state;
+}
 
+void Stream::on_complete(const StreamState& state)
+{
     if (m_completion_func) {
-        m_completion_func(stream_state);
-        m_completion_func = nullptr;
+        auto completion_func = std::move(m_completion_func);
+        m_completion_func    = nullptr;
+        completion_func(state);
     }
-    return stream_state;
 }
 
 bool Stream::supports_source_seek() const
@@ -56,6 +177,29 @@ bool Stream::supports_source_seek() const
     return m_source && m_source->supports_seek();
 }
 
+bool Stream::supports_direct_send() const
+{
+    return m_source && m_source->supports_direct_send();
+}
+
+IOResult Stream::send_to(int handle, std::size_t length) noexcept
+{
+    if (!supports_direct_send()) {
+        const std::string msg =
+            "Attempted direct send without a supporting source";
+        LOG_ERROR(msg);
+        return {{StreamState::State::ERROR, msg}, 0};
+    }
+
+    const auto result = m_source->send_to(handle, length);
+    if (!result.ok()) {
+        return result;
+    }
+
+    update_progress(result.m_num_transferred);
+    return result;
+}
+
 void Stream::seek_source_to(std::size_t offset)
 {
     if (supports_source_seek()) {
@@ -121,7 +265,37 @@ bool Stream::has_source() const
     return bool(m_source);
 }
 
-StreamState Stream::flush(std::size_t block_size) noexcept
+bool Stream::has_pending_flush() const
+{
+    return m_deferred_flush.valid();
+}
+
+void Stream::flush_async(std::size_t block_size, std::size_t num_buffers)
+{
+    if (m_deferred_flush.valid()) {
+        throw std::runtime_error(
+            "Requested deferred flush on a stream with one in progress. reset() the stream first.");
+    }
+    LOG_DEBUG("Dispatching deferred stream flush");
+    m_deferred_flush =
+        std::async(std::launch::async, [this, block_size, num_buffers]() {
+            return do_flush(block_size, num_buffers);
+        });
+}
+
+StreamState Stream::flush(
+    std::size_t block_size, std::size_t num_buffers) noexcept
+{
+    if (m_deferred_flush.valid()) {
+        const std::string msg =
+            "Attempted to flush stream with a deferred flush in progress";
+        LOG_ERROR(msg);
+        return {StreamState::State::ERROR, msg};
+    }
+    return do_flush(block_size, num_buffers);
+}
+
+StreamState Stream::do_flush(std::size_t block_size, std::size_t num_buffers)
 {
     LOG_INFO("Starting stream flush");
     if (!m_sink || !m_source) {
@@ -131,6 +305,34 @@ StreamState Stream::flush(std::size_t block_size) noexcept
         return {StreamState::State::ERROR, msg};
     }
 
+    StreamState state;
+    try {
+        state = num_buffers > 1 ? do_pipelined_flush(block_size, num_buffers) :
+                                  do_single_buffer_flush(block_size);
+    }
+    catch (const std::exception& e) {
+        LOG_ERROR("Exception flushing stream: " << e.what());
+        state = {StreamState::State::ERROR, e.what()};
+    }
+    catch (...) {
+        LOG_ERROR("Unknown exception flushing stream");
+        state = {StreamState::State::ERROR, "Unknown exception."};
+    }
+
+    if (auto reset_state = do_reset(); !reset_state.ok()) {
+        reset_state.set_num_transferred(state.get_num_transferred());
+        state = reset_state;
+    }
+    on_complete(state);
+    LOG_INFO(
+        "Finished stream flush with state: " << state.to_string()
+                                             << " and num transferred: "
+                                             << state.get_num_transferred());
+    return state;
+}
+
+StreamState Stream::do_single_buffer_flush(std::size_t block_size)
+{
     std::vector<char> buffer(block_size, 0);
 
     StreamState state;
@@ -149,14 +351,7 @@ StreamState Stream::flush(std::size_t block_size) noexcept
             state = {StreamState::State::ERROR, write_result.m_state.message()};
             break;
         }
-
-        m_transfer_progress += write_result.m_num_transferred;
-        if (m_progress_func
-            && m_transfer_progress
-                   >= m_transfer_interval + m_last_progress_call) {
-            m_last_progress_call = m_transfer_progress.load();
-            m_progress_func(m_transfer_progress);
-        }
+        update_progress(write_result.m_num_transferred);
 
         if (read_result.finished()) {
             state = {StreamState::State::FINISHED};
@@ -164,16 +359,104 @@ StreamState Stream::flush(std::size_t block_size) noexcept
             break;
         }
     }
-    if (auto reset_state = reset(); !reset_state.ok()) {
-        state = reset_state;
+    return state;
+}
+
+StreamState Stream::do_pipelined_flush(
+    std::size_t block_size, std::size_t num_buffers)
+{
+    StreamBufferRing ring(block_size, num_buffers);
+
+    StreamState read_state;
+    std::future<void> reader;
+    try {
+        reader = std::async(std::launch::async, [this, &ring, &read_state]() {
+            try {
+                while (true) {
+                    auto slot = ring.acquire_free();
+                    if (slot == nullptr) {
+                        return;
+                    }
+                    WriteableBufferView writeable_buffer(slot->m_data);
+                    auto read_result = m_source->read(writeable_buffer);
+                    if (!read_result.ok()) {
+                        read_state = read_result.m_state;
+                        ring.abort();
+                        return;
+                    }
+                    slot->m_size = read_result.m_num_transferred;
+                    slot->m_last = read_result.finished();
+                    ring.push_filled(slot);
+                    if (slot->m_last) {
+                        return;
+                    }
+                }
+            }
+            catch (...) {
+                // Don't leave the writer waiting on a slot that won't come
+                ring.abort();
+                throw;
+            }
+        });
+    }
+    catch (const std::exception& e) {
+        LOG_ERROR(
+            "Failed to start stream reader thread - using single buffer: "
+            << e.what());
+        return do_single_buffer_flush(block_size);
+    }
+
+    StreamState state;
+    try {
+        while (true) {
+            auto slot = ring.acquire_filled();
+            if (slot == nullptr) {
+                break;
+            }
+
+            ReadableBufferView readable_buffer(&slot->m_data[0], slot->m_size);
+            auto write_result = m_sink->write(readable_buffer);
+            if (!write_result.ok()) {
+                state = {
+                    StreamState::State::ERROR, write_result.m_state.message()};
+                ring.abort();
+                break;
+            }
+            update_progress(write_result.m_num_transferred);
+
+            const auto is_last = slot->m_last;
+            ring.release(slot);
+            if (is_last) {
+                state = {StreamState::State::FINISHED};
+                state.set_num_transferred(m_transfer_progress);
+                break;
+            }
+        }
+    }
+    catch (...) {
+        // Free the reader, which may be waiting on a slot, before passing on
+        ring.abort();
+        reader.wait();
+        throw;
+    }
+    reader.get();
+
+    if (!read_state.ok()) {
+        return {StreamState::State::ERROR, read_state.message()};
     }
-    LOG_INFO(
-        "Finished stream flush with state: " << state.to_string()
-                                             << " and num transferred: "
-                                             << state.get_num_transferred());
     return state;
 }
 
+void Stream::update_progress(std::size_t num_transferred)
+{
+    m_transfer_progress += num_transferred;
+    if (m_progress_func
+        && m_transfer_progress >= m_transfer_interval + m_last_progress_call) {
+        m_last_progress_call = m_transfer_progress.load();
+        m_progress_func(m_transfer_progress);
+    }
+}
+
 IOResult Stream::read(WriteableBufferView& buffer) noexcept
 {
     if (!m_source) {
@@ -187,12 +470,7 @@ IOResult Stream::read(WriteableBufferView& buffer) noexcept
         return result;
     }
 
-    m_transfer_progress += result.m_num_transferred;
-    if (m_progress_func
-        && m_transfer_progress >= m_transfer_interval + m_last_progress_call) {
-        m_last_progress_call = m_transfer_progress.load();
-        m_progress_func(m_transfer_progress);
-    }
+    update_progress(result.m_num_transferred);
     return result;
 }
 
@@ -209,12 +487,7 @@ IOResult Stream::write(const ReadableBufferView& buffer) noexcept
         return result;
     }
 
-    m_transfer_progress += result.m_num_transferred;
-    if (m_progress_func
-        && m_transfer_progress >= m_transfer_interval + m_last_progress_call) {
-        m_last_progress_call = m_transfer_progress.load();
-        m_progress_func(m_transfer_progress);
-    }
+    update_progress(result.m_num_transferred);
     return result;
 }
 
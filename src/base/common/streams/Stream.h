@@ -7,6 +7,7 @@
 #include "WriteableBufferView.h"
 
 #include <atomic>
+#include <future>
 #include <memory>
 
 namespace hestia {
@@ -26,6 +27,10 @@ namespace hestia {
  * dispatch flushing onto a thread and only wait for completion when we 'reset'
  * the Stream.
  *
+ * Flushes can be pipelined by giving more than one buffer - the Source is then
+ * read into a ring of buffers on a helper thread while the Sink drains the
+ * filled ones, so neither waits on the other.
+ *
  * Resetting the stream will both complete all transfers and detach any Sinks or
  * Sources - allowing the stream to be re-used if needed.
  *
@@ -34,7 +39,7 @@ class Stream {
   public:
     using Ptr = std::unique_ptr<Stream>;
 
-    virtual ~Stream() = default;
+    virtual ~Stream();
 
     /**
      * Factory Constructor
@@ -48,9 +53,30 @@ class Stream {
      * blocks from the former and write them to the latter.
      *
      * @param block_size The size of the blocks to 'stage' data to while doing the flush
+     * @param num_buffers The number of staging buffers - if more than one the read and write are pipelined
      * @return The status of the stream - it can indicate and error state or partial data transfer
      */
-    [[nodiscard]] StreamState flush(std::size_t block_size = 4096) noexcept;
+    [[nodiscard]] StreamState flush(
+        std::size_t block_size = 4096, std::size_t num_buffers = 1) noexcept;
+
+    /**
+     * Dispatch a flush onto a thread and return immediately. The completion
+     * func, if set, is called from that thread when the transfer ends and
+     * reset() waits for it and returns its final state. The Sink and Source
+     * should not be touched until then.
+     *
+     * @param block_size The size of the blocks to 'stage' data to while doing the flush
+     * @param num_buffers The number of ring buffers to pipeline the transfer with
+     */
+    void flush_async(
+        std::size_t block_size = 4096, std::size_t num_buffers = 2);
+
+    /**
+     * True if a flush dispatched with flush_async() has not been waited on
+     *
+     * @return True if a deferred flush is outstanding
+     */
+    bool has_pending_flush() const;
 
     /**
      * Return the size of the data in the sink. Not all sink types may be able
@@ -113,6 +139,23 @@ class Stream {
 
     bool supports_source_seek() const;
 
+    /**
+     * True if the attached Source can send straight to a system handle
+     *
+     * @return True if the attached Source can send straight to a system handle
+     */
+    bool supports_direct_send() const;
+
+    /**
+     * Send up to 'length' bytes from the attached Source straight to a system
+     * handle, such as a socket, without copying through a buffer
+     *
+     * @param handle the system handle to send to
+     * @param length the maximum number of bytes to send
+     * @return the status of the send operation
+     */
+    [[nodiscard]] IOResult send_to(int handle, std::size_t length) noexcept;
+
     void seek_source_to(std::size_t offset);
 
     /**
@@ -147,6 +190,19 @@ class Stream {
     [[nodiscard]] IOResult write(const ReadableBufferView& buffer) noexcept;
 
   protected:
+    StreamState do_flush(std::size_t block_size, std::size_t num_buffers);
+
+    StreamState do_single_buffer_flush(std::size_t block_size);
+
+    StreamState do_pipelined_flush(
+        std::size_t block_size, std::size_t num_buffers);
+
+    StreamState do_reset();
+
+    void on_complete(const StreamState& state);
+
+    void update_progress(std::size_t num_transferred);
+
     completionFunc m_completion_func;
     progressFunc m_progress_func;
 
@@ -156,5 +212,7 @@ class Stream {
 
     StreamSource::Ptr m_source;
     StreamSink::Ptr m_sink;
+
+    std::future<StreamState> m_deferred_flush;
 };
 }  // namespace hestia
@@ -29,5 +29,29 @@ class StreamSource : public StreamIO {
     virtual bool supports_seek() const { return false; }
 
     virtual void seek_to(std::size_t) {}
+
+    /**
+     * True if the source can send its data straight to a system handle, e.g.
+     * with sendfile, without passing through a user-space buffer
+     *
+     * @return True if the source supports send_to
+     */
+    virtual bool supports_direct_send() const { return false; }
+
+    /**
+     * Send up to 'length' bytes of the source to the system handle, picking
+     * up from where the last read or send finished.
+     *
+     * @param handle the system handle, e.g. a socket, to send to
+     * @param length the maximum number of bytes to send
+     * @return the status of the send operation
+     */
+    [[nodiscard]] virtual IOResult send_to(
+        int handle, std::size_t length) noexcept
+    {
+        (void)handle;
+        (void)length;
+        return {{StreamState::State::ERROR, "Direct send not supported"}, 0};
+    }
 };
 }  // namespace hestia
\ No newline at end of file
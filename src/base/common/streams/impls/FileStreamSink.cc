@@ -3,8 +3,25 @@
 #include "FileUtils.h"
 #include "SystemUtils.h"
 
+#include <cstring>
+
+#include <fcntl.h>
+#include <unistd.h>
+
 namespace hestia {
-FileStreamSink::FileStreamSink(const File::Path& path) : m_file(path) {}
+FileStreamSink::FileStreamSink(const File::Path& path) :
+    FileStreamSink(path, 0, 0, true)
+{
+}
+
+FileStreamSink::FileStreamSink(
+    const File::Path& path,
+    std::size_t offset,
+    std::size_t length,
+    bool truncate) :
+    m_path(path), m_truncate(truncate), m_offset(offset), m_length(length)
+{
+}
 
 FileStreamSink::FileStreamSink(int fd, std::size_t length) :
     m_fd(fd), m_length(length)
@@ -16,6 +33,15 @@ FileStreamSink::Ptr FileStreamSink::create(const File::Path& path)
     return std::make_unique<FileStreamSink>(path);
 }
 
+FileStreamSink::Ptr FileStreamSink::create(
+    const File::Path& path,
+    std::size_t offset,
+    std::size_t length,
+    bool truncate)
+{
+    return std::make_unique<FileStreamSink>(path, offset, length, truncate);
+}
+
 FileStreamSink::Ptr FileStreamSink::create(int fd, std::size_t length)
 {
     return std::make_unique<FileStreamSink>(fd, length);
@@ -36,6 +62,47 @@ IOResult FileStreamSink::write(const ReadableBufferView& buffer) noexcept
     }
 }
 
+bool FileStreamSink::open_file() noexcept
+{
+    try {
+        FileUtils::create_if_not_existing(m_path);
+    }
+    catch (const std::exception& e) {
+        set_state(
+            StreamState::State::ERROR,
+            "FileStreamSink: Failed to create directories: "
+                + std::string(e.what()));
+        return false;
+    }
+
+    auto flags = O_WRONLY | O_CREAT | O_CLOEXEC;
+    if (m_truncate) {
+        flags |= O_TRUNC;
+    }
+
+    errno     = 0;
+    m_file_fd = ::open(m_path.c_str(), flags, 0644);
+    if (m_file_fd == -1) {
+        set_state(
+            StreamState::State::ERROR,
+            "FileStreamSink: Failed to open " + m_path.string() + ": "
+                + std::string(::strerror(errno)));
+        return false;
+    }
+
+#ifdef __linux__
+    // Reserve the blocks up front so a large write isn't fragmented. Not
+    // all filesystems support it and the write works without, so failures
+    // are ignored.
+    if (m_length > 0) {
+        (void)::fallocate(
+            m_file_fd, FALLOC_FL_KEEP_SIZE, static_cast<off_t>(m_offset),
+            static_cast<off_t>(m_length));
+    }
+#endif
+    return true;
+}
+
 IOResult FileStreamSink::write_to_file(
     const ReadableBufferView& buffer) noexcept
 {
@@ -43,13 +110,30 @@ IOResult FileStreamSink::write_to_file(
         return {state, 0};
     }
 
-    if (const auto status = m_file.write(buffer.data(), buffer.length());
-        !status.ok()) {
-        set_state(
-            StreamState::State::ERROR,
-            "FileStreamSink write failed: " + status.str());
+    if (m_file_fd == -1 && !open_file()) {
+        return {get_state(), 0};
+    }
+
+    std::size_t written{0};
+    while (written < buffer.length()) {
+        errno         = 0;
+        const auto rc = ::pwrite(
+            m_file_fd, buffer.data() + written, buffer.length() - written,
+            static_cast<off_t>(m_offset + m_write_amount));
+        if (rc < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            set_state(
+                StreamState::State::ERROR,
+                "FileStreamSink write failed: "
+                    + std::string(::strerror(errno)));
+            return {get_state(), written};
+        }
+        written += static_cast<std::size_t>(rc);
+        m_write_amount += static_cast<std::size_t>(rc);
     }
-    return {get_state(), buffer.length()};
+    return {get_state(), written};
 }
 
 IOResult FileStreamSink::write_to_handle(
@@ -88,6 +172,10 @@ IOResult FileStreamSink::write_to_handle(
 
 void FileStreamSink::close()
 {
+    if (m_file_fd != -1) {
+        ::close(m_file_fd);
+        m_file_fd = -1;
+    }
     if (const auto status = m_file.close(); !status.ok()) {
         set_state(
             StreamState::State::ERROR,
@@ -7,12 +7,41 @@ namespace hestia {
 class FileStreamSink : public StreamSink {
   public:
     using Ptr = std::unique_ptr<FileStreamSink>;
+
+    /**
+     * Constructor - replace the file content with what is written
+     *
+     * @param path Path to the file, created if needed
+     */
     FileStreamSink(const File::Path& path);
 
+    /**
+     * Constructor - write into the file starting at 'offset' with pwrite.
+     * Bytes outside the written range are left alone and writing past the
+     * end of file leaves a hole, so the file can be sparse.
+     *
+     * @param path Path to the file, created if needed
+     * @param offset Offset to start writing at
+     * @param length Expected amount to be written, used to preallocate
+     * space - 0 if not known
+     * @param truncate If true empty the file before writing
+     */
+    FileStreamSink(
+        const File::Path& path,
+        std::size_t offset,
+        std::size_t length,
+        bool truncate);
+
     FileStreamSink(int fd, std::size_t length);
 
     static Ptr create(const File::Path& path);
 
+    static Ptr create(
+        const File::Path& path,
+        std::size_t offset,
+        std::size_t length,
+        bool truncate);
+
     static Ptr create(int fd, std::size_t length);
 
     virtual ~FileStreamSink();
@@ -23,13 +52,19 @@ class FileStreamSink : public StreamSink {
   private:
     void close();
 
+    bool open_file() noexcept;
+
     IOResult write_to_file(const ReadableBufferView& buffer) noexcept;
 
     IOResult write_to_handle(const ReadableBufferView& buffer) noexcept;
 
     File m_file;
+    File::Path m_path;
     int m_fd{-1};
+    int m_file_fd{-1};
+    bool m_truncate{true};
 
+    std::size_t m_offset{0};
     std::size_t m_length{0};
     std::size_t m_write_amount{0};
 };
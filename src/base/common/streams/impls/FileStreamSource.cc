@@ -1,13 +1,74 @@
 #include "FileStreamSource.h"
 
+#include "FileUtils.h"
 #include "SystemUtils.h"
 
+#include <algorithm>
+#include <cstring>
 #include <iostream>
 
+#include <csignal>
+#include <ctime>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/sendfile.h>
+#include <unistd.h>
+
 namespace hestia {
-FileStreamSource::FileStreamSource(const File::Path& path) : m_file(path)
+
+namespace {
+// sendfile has no MSG_NOSIGNAL, so SIGPIPE from writing to a closed socket
+// is blocked on this thread and any it raised is consumed before unblocking
+class SigPipeBlock {
+  public:
+    SigPipeBlock()
+    {
+        sigemptyset(&m_sigpipe);
+        sigaddset(&m_sigpipe, SIGPIPE);
+
+        sigset_t pending;
+        sigpending(&pending);
+        m_was_pending = sigismember(&pending, SIGPIPE) == 1;
+        if (!m_was_pending) {
+            pthread_sigmask(SIG_BLOCK, &m_sigpipe, &m_old_mask);
+        }
+    }
+
+    ~SigPipeBlock()
+    {
+        if (m_was_pending) {
+            return;
+        }
+        sigset_t pending;
+        sigpending(&pending);
+        if (sigismember(&pending, SIGPIPE) == 1) {
+            const timespec no_wait{0, 0};
+            sigtimedwait(&m_sigpipe, nullptr, &no_wait);
+        }
+        pthread_sigmask(SIG_SETMASK, &m_old_mask, nullptr);
+    }
+
+  private:
+    sigset_t m_sigpipe;
+    sigset_t m_old_mask;
+    bool m_was_pending{false};
+};
+}  // namespace
+
+FileStreamSource::FileStreamSource(const File::Path& path) :
+    FileStreamSource(path, 0, 0)
+{
+}
+
+FileStreamSource::FileStreamSource(
+    const File::Path& path, std::size_t offset, std::size_t length) :
+    m_path(path), m_offset(offset), m_start(offset)
 {
-    m_size = m_file.get_size();
+    const auto file_size =
+        static_cast<std::size_t>(FileUtils::get_file_size(m_path));
+    m_end = length > 0 ? std::min(file_size, offset + length) : file_size;
+    m_end = std::max(m_end, m_start);
+    m_size = m_end - m_start;
 }
 
 FileStreamSource::Ptr FileStreamSource::create(const File::Path& path)
@@ -15,6 +76,12 @@ FileStreamSource::Ptr FileStreamSource::create(const File::Path& path)
     return std::make_unique<FileStreamSource>(path);
 }
 
+FileStreamSource::Ptr FileStreamSource::create(
+    const File::Path& path, std::size_t offset, std::size_t length)
+{
+    return std::make_unique<FileStreamSource>(path, offset, length);
+}
+
 FileStreamSource::Ptr FileStreamSource::create(int fd, std::size_t length)
 {
     return std::make_unique<FileStreamSource>(fd, length);
@@ -33,7 +100,7 @@ FileStreamSource::~FileStreamSource()
 
 void FileStreamSource::seek_to(std::size_t offset)
 {
-    m_file.seek_to(offset);
+    m_offset = m_start + offset;
     set_state(StreamState::State::READY);
 }
 
@@ -47,25 +114,116 @@ IOResult FileStreamSource::read(WriteableBufferView& buffer) noexcept
     }
 }
 
+bool FileStreamSource::open_file() noexcept
+{
+    errno     = 0;
+    m_file_fd = ::open(m_path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (m_file_fd == -1) {
+        set_state(
+            StreamState::State::ERROR,
+            "FileStreamSource: Failed to open " + m_path.string() + ": "
+                + std::string(::strerror(errno)));
+        return false;
+    }
+    return true;
+}
+
 IOResult FileStreamSource::read_from_file(WriteableBufferView& buffer) noexcept
 {
     if (const auto state = get_state(); !state.ok()) {
         return {state, 0};
     }
 
-    const auto& [op_status, read_state] =
-        m_file.read(buffer.data(), buffer.length());
-    if (!op_status.ok()) {
+    if (m_file_fd == -1 && !open_file()) {
+        return {get_state(), 0};
+    }
+
+    const auto to_read =
+        m_offset < m_end ? std::min(buffer.length(), m_end - m_offset) : 0;
+
+    std::size_t num_read{0};
+    while (num_read < to_read) {
+        errno         = 0;
+        const auto rc = ::pread(
+            m_file_fd, buffer.data() + num_read, to_read - num_read,
+            static_cast<off_t>(m_offset + num_read));
+        if (rc < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            set_state(
+                StreamState::State::ERROR,
+                "FileStreamSource read failed: "
+                    + std::string(::strerror(errno)));
+            return {get_state(), 0};
+        }
+        if (rc == 0) {
+            // The file was truncated since the range was set
+            m_end = m_offset + num_read;
+            break;
+        }
+        num_read += static_cast<std::size_t>(rc);
+    }
+
+    m_offset += num_read;
+    if (m_offset >= m_end) {
+        set_state(StreamState::State::FINISHED);
+    }
+    return {get_state(), num_read};
+}
+
+IOResult FileStreamSource::send_to(int handle, std::size_t length) noexcept
+{
+    if (const auto state = get_state(); !state.ok()) {
+        return {state, 0};
+    }
+
+    // Handle mode sends from the handle's own file position, path mode
+    // from where the last read or send got to.
+    int source_fd = m_fd;
+    if (source_fd == -1) {
+        if (m_file_fd == -1 && !open_file()) {
+            return {get_state(), 0};
+        }
+        source_fd = m_file_fd;
+    }
+
+    const auto total_size = m_fd == -1 ? m_end : m_length;
+    if (m_fd == -1 && m_offset < total_size) {
+        length = std::min(length, total_size - m_offset);
+    }
+
+    ssize_t rc{0};
+    int send_errno{0};
+    {
+        SigPipeBlock sigpipe_block;
+        do {
+            errno = 0;
+            if (m_fd == -1) {
+                auto offset = static_cast<off_t>(m_offset);
+                rc          = ::sendfile(handle, source_fd, &offset, length);
+            }
+            else {
+                rc = ::sendfile(handle, source_fd, nullptr, length);
+            }
+        } while (rc < 0 && errno == EINTR);
+        send_errno = errno;
+    }
+
+    if (rc < 0) {
         set_state(
             StreamState::State::ERROR,
-            "FileStreamSource: " + op_status.message());
+            "FileStreamSource: sendfile failed: "
+                + std::string(::strerror(send_errno)));
         return {get_state(), 0};
     }
 
-    if (read_state.m_finished) {
+    const auto num_sent = static_cast<std::size_t>(rc);
+    m_offset += num_sent;
+    if (num_sent == 0 || m_offset >= total_size) {
         set_state(StreamState::State::FINISHED);
     }
-    return {get_state(), read_state.m_size_read};
+    return {get_state(), num_sent};
 }
 
 IOResult FileStreamSource::read_from_handle(
@@ -84,6 +242,7 @@ IOResult FileStreamSource::read_from_handle(
         return {get_state(), 0};
     }
 
+    m_offset += read_size;
     if (read_size <= buffer.length()) {
         set_state(StreamState::State::FINISHED);
     }
@@ -92,10 +251,9 @@ IOResult FileStreamSource::read_from_handle(
 
 void FileStreamSource::close()
 {
-    if (const auto status = m_file.close(); !status.ok()) {
-        set_state(
-            StreamState::State::ERROR,
-            "FileStreamSource close failed: " + status.str());
+    if (m_file_fd != -1) {
+        ::close(m_file_fd);
+        m_file_fd = -1;
     }
 }
 }  // namespace hestia
\ No newline at end of file
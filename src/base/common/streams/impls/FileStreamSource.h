@@ -8,12 +8,32 @@ class FileStreamSource : public StreamSource {
   public:
     using Ptr = std::unique_ptr<FileStreamSource>;
 
+    /**
+     * Constructor - read the whole file
+     *
+     * @param path Path to the file
+     */
     FileStreamSource(const File::Path& path);
 
+    /**
+     * Constructor - read part of the file with pread. Only the requested
+     * range is read and the stream size is the length of the range.
+     *
+     * @param path Path to the file
+     * @param offset Offset to start reading from
+     * @param length Amount to read, bounded by the end of file - 0 to read
+     * to the end of file
+     */
+    FileStreamSource(
+        const File::Path& path, std::size_t offset, std::size_t length);
+
     FileStreamSource(int fd, std::size_t length);
 
     static Ptr create(const File::Path& path);
 
+    static Ptr create(
+        const File::Path& path, std::size_t offset, std::size_t length);
+
     static Ptr create(int fd, std::size_t length);
 
     virtual ~FileStreamSource();
@@ -24,15 +44,32 @@ class FileStreamSource : public StreamSource {
 
     void seek_to(std::size_t offset) override;
 
+    bool supports_direct_send() const override { return true; }
+
+    /**
+     * Send file content to the handle with sendfile, so it is copied in the
+     * kernel rather than through a user-space buffer.
+     */
+    [[nodiscard]] IOResult send_to(
+        int handle, std::size_t length) noexcept override;
+
   private:
     void close();
 
+    bool open_file() noexcept;
+
     IOResult read_from_file(WriteableBufferView& buffer) noexcept;
 
     IOResult read_from_handle(WriteableBufferView& buffer) noexcept;
 
-    File m_file;
+    File::Path m_path;
     int m_fd{-1};
+    int m_file_fd{-1};
+    std::size_t m_offset{0};
     std::size_t m_length{0};
+
+    // File offsets bounding the range read in path mode
+    std::size_t m_start{0};
+    std::size_t m_end{0};
 };
 }  // namespace hestia
\ No newline at end of file
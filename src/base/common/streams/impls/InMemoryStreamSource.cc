@@ -74,9 +74,11 @@ IOResult InMemoryStreamSource::read_from_source_func(
         return {get_state(), 0};
     }
 
-    if (writeable_buffer.length() >= bytes_read) {
+    // The source is read in buffer sized chunks - it is done once it comes
+    // up short or reaches the expected size
+    if (bytes_read < writeable_buffer.length()
+        || (get_size() > 0 && m_read_buffer_offset >= get_size())) {
         set_state(StreamState::State::FINISHED);
-        return {get_state(), bytes_read};
     }
     return {get_state(), bytes_read};
 }
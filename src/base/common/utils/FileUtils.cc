@@ -1,7 +1,123 @@
 #include "FileUtils.h"
 #include <iostream>
+#include <system_error>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <linux/fs.h>
+#include <sys/ioctl.h>
+#endif
 
 namespace hestia {
+
+namespace {
+class FileDescriptor {
+  public:
+    FileDescriptor(int fd) : m_fd(fd) {}
+
+    ~FileDescriptor()
+    {
+        if (m_fd != -1) {
+            ::close(m_fd);
+        }
+    }
+
+    int m_fd{-1};
+};
+
+[[noreturn]] void throw_file_error(
+    const std::string& what, const FileUtils::Path& path)
+{
+    throw std::filesystem::filesystem_error(
+        what, path, std::error_code(errno, std::generic_category()));
+}
+
+// Copy in the kernel, return false if the filesystems don't support it and
+// nothing was copied
+bool kernel_copy(int source_fd, int target_fd, std::size_t size)
+{
+#ifdef __linux__
+    if (::ioctl(target_fd, FICLONE, source_fd) == 0) {
+        return true;
+    }
+
+    std::size_t copied{0};
+    while (copied < size) {
+        const auto rc = ::copy_file_range(
+            source_fd, nullptr, target_fd, nullptr, size - copied, 0);
+        if (rc < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (copied == 0
+                && (errno == EXDEV || errno == EINVAL || errno == ENOSYS
+                    || errno == EOPNOTSUPP)) {
+                return false;
+            }
+            throw std::system_error(
+                errno, std::generic_category(), "copy_file_range failed");
+        }
+        if (rc == 0) {
+            break;
+        }
+        copied += static_cast<std::size_t>(rc);
+    }
+    return true;
+#else
+    (void)source_fd;
+    (void)target_fd;
+    (void)size;
+    return false;
+#endif
+}
+}  // namespace
+
+void FileUtils::copy_file(const Path& source, const Path& target)
+{
+    FileDescriptor source_fd(::open(source.c_str(), O_RDONLY | O_CLOEXEC));
+    if (source_fd.m_fd == -1) {
+        throw_file_error("Failed to open copy source", source);
+    }
+
+    struct stat source_stat;
+    if (::fstat(source_fd.m_fd, &source_stat) != 0) {
+        throw_file_error("Failed to stat copy source", source);
+    }
+
+    FileDescriptor target_fd(::open(
+        target.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC,
+        source_stat.st_mode & 0777));
+    if (target_fd.m_fd == -1) {
+        throw_file_error("Failed to open copy target", target);
+    }
+
+    if (kernel_copy(
+            source_fd.m_fd, target_fd.m_fd,
+            static_cast<std::size_t>(source_stat.st_size))) {
+        return;
+    }
+
+    std::filesystem::copy_file(
+        source, target, std::filesystem::copy_options::overwrite_existing);
+}
+
+void FileUtils::move_file(const Path& source, const Path& target)
+{
+    std::error_code ec;
+    std::filesystem::rename(source, target, ec);
+    if (!ec) {
+        return;
+    }
+    if (ec != std::errc::cross_device_link) {
+        throw std::filesystem::filesystem_error(
+            "Failed to move file", source, target, ec);
+    }
+    copy_file(source, target);
+    std::filesystem::remove(source);
+}
 bool FileUtils::is_file_with_extension(
     const std::filesystem::directory_entry& dir_entry,
     const std::string& extension)
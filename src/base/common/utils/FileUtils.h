@@ -49,5 +49,24 @@ class FileUtils {
      * @param path the directory path
      */
     static uintmax_t get_file_size(const Path& path);
+
+    /**
+     * Copy a file, replacing the target if it exists. The copy is done in
+     * the kernel - as a reflink (FICLONE) where the filesystem supports it,
+     * otherwise with copy_file_range - falling back to a regular copy.
+     *
+     * @param source the file to copy
+     * @param target where to copy it to
+     */
+    static void copy_file(const Path& source, const Path& target);
+
+    /**
+     * Move a file, replacing the target if it exists. This is a rename if
+     * both paths are on the same filesystem, otherwise a copy and remove.
+     *
+     * @param source the file to move
+     * @param target where to move it to
+     */
+    static void move_file(const Path& source, const Path& target);
 };
 }  // namespace hestia
\ No newline at end of file
@@ -15,6 +15,16 @@
 
 namespace hestia {
 
+static std::string to_hex(const unsigned char* data, std::size_t length)
+{
+    std::stringstream ss;
+    ss << std::hex << std::setfill('0');
+    for (std::size_t i = 0; i < length; i++) {
+        ss << std::hex << std::setw(2) << (unsigned int)data[i];
+    }
+    return ss.str();
+}
+
 std::string HashUtils::do_rand_32()
 {
     std::vector<unsigned char> buffer(32, 0);
@@ -52,10 +62,20 @@ std::string HashUtils::base64_encode(const std::string& input)
     return ret;
 }
 
+const evp_md_st* HashUtils::sha256_digest()
+{
+    return EVP_sha256();
+}
+
+const evp_md_st* HashUtils::md5_digest()
+{
+    return EVP_md5();
+}
+
 std::string HashUtils::uri_encode(const std::string& input, bool encode_slash)
 {
     std::stringstream sstr;
-    for (const auto c : input) {
+    for (const unsigned char c : input) {
         if ((std::isalnum(c) != 0) || c == '_' || c == '-' || c == '~'
             || c == '.') {
             sstr << c;
@@ -92,13 +112,19 @@ std::string HashUtils::do_sha256(const std::string& input)
         return "";
     }
 
-    std::stringstream ss;
-    ss << std::hex << std::setfill('0');
-    for (unsigned int i = 0; i < result_size; i++) {
-        ss << std::hex << std::setw(2) << (unsigned int)hash[i];
-    }
+    const auto hex = to_hex(hash, result_size);
     delete[] hash;
-    return ss.str();
+    return hex;
+}
+
+std::uint64_t HashUtils::do_fnv1a(const std::string& input)
+{
+    std::uint64_t hash{14695981039346656037ULL};
+    for (const auto character : input) {
+        hash ^= static_cast<unsigned char>(character);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
 }
 
 std::string HashUtils::do_h_mac(const std::string& key, const std::string& msg)
@@ -131,4 +157,29 @@ std::string HashUtils::do_h_mac_hex(
     }
     return ss.str();
 }
-}  // namespace hestia
\ No newline at end of file
+EvpHasher::EvpHasher(const evp_md_st* digest) :
+    m_digest(digest), m_context(EVP_MD_CTX_new())
+{
+    EVP_DigestInit_ex(m_context, m_digest, nullptr);
+}
+
+EvpHasher::~EvpHasher()
+{
+    EVP_MD_CTX_free(m_context);
+}
+
+void EvpHasher::update(const char* data, std::size_t length)
+{
+    EVP_DigestUpdate(m_context, data, length);
+}
+
+std::string EvpHasher::finish()
+{
+    unsigned char hash[EVP_MAX_MD_SIZE];
+    unsigned int result_size{0};
+    EVP_DigestFinal_ex(m_context, hash, &result_size);
+    EVP_DigestInit_ex(m_context, m_digest, nullptr);
+    return to_hex(hash, result_size);
+}
+
+}  // namespace hestia
@@ -1,8 +1,12 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <vector>
 
+struct evp_md_st;
+struct evp_md_ctx_st;
+
 namespace hestia {
 class HashUtils {
   public:
@@ -22,5 +26,64 @@ class HashUtils {
     static std::string uri_encode(const std::string& input, bool encode_slash);
 
     static std::string base64_encode(const std::string& input);
+
+    /**
+     * The SHA-256 digest, for an EvpHasher - OpenSSL isn't a public
+     * dependency so callers can't use EVP_sha256() directly.
+     */
+    static const evp_md_st* sha256_digest();
+
+    /**
+     * The MD5 digest, for an EvpHasher
+     */
+    static const evp_md_st* md5_digest();
+
+    /**
+     * 64-bit FNV-1a hash - unlike std::hash it is the same in every build, so
+     * can be used for on-disk layouts and placement
+     *
+     * @param input The data to hash
+     * @return The hash
+     */
+    static std::uint64_t do_fnv1a(const std::string& input);
+};
+
+/**
+ * @brief Incremental hashing with an OpenSSL digest - for hashing data as it
+ * arrives in chunks rather than holding all of it in memory first.
+ */
+class EvpHasher {
+  public:
+    /**
+     * Constructor
+     *
+     * @param digest The digest to use, e.g. EVP_sha256()
+     */
+    explicit EvpHasher(const evp_md_st* digest);
+
+    ~EvpHasher();
+
+    EvpHasher(const EvpHasher&) = delete;
+
+    EvpHasher& operator=(const EvpHasher&) = delete;
+
+    /**
+     * Add data to the hash
+     *
+     * @param data The data
+     * @param length The length of the data
+     */
+    void update(const char* data, std::size_t length);
+
+    /**
+     * Finish the hash and start a new one
+     *
+     * @return The hex encoded digest of the data added since the last call
+     */
+    std::string finish();
+
+  private:
+    const evp_md_st* m_digest{nullptr};
+    evp_md_ctx_st* m_context{nullptr};
 };
 }  // namespace hestia
\ No newline at end of file
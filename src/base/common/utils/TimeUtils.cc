@@ -26,6 +26,13 @@ std::string TimeUtils::get_current_time_iso8601_basic()
     return to_iso8601_basic(std::chrono::system_clock::to_time_t(now));
 }
 
+std::time_t TimeUtils::to_seconds(std::time_t clock_time)
+{
+    return std::chrono::system_clock::to_time_t(
+        std::chrono::system_clock::time_point(
+            std::chrono::system_clock::duration(clock_time)));
+}
+
 std::string TimeUtils::to_iso8601_basic(std::time_t time)
 {
     std::stringstream ss;
@@ -10,5 +10,11 @@ class TimeUtils {
     static std::string get_current_time_hr();
     static std::string get_current_time_iso8601_basic();
     static std::string to_iso8601_basic(std::time_t time);
+
+    /**
+     * Convert a time from get_current_time(), in system clock ticks, to
+     * seconds since the epoch.
+     */
+    static std::time_t to_seconds(std::time_t clock_time);
 };
 }  // namespace hestia
@@ -80,11 +80,11 @@ UserService::Ptr UserService::create(
 
         crud_client = std::make_unique<KeyValueCrudClient>(
             client_config, std::move(user_adapters), kv_backend->m_client,
-            id_generator, time_provider);
+            id_generator, time_provider, kv_backend->m_cache);
 
         token_crud_client = std::make_unique<KeyValueCrudClient>(
             client_config, std::move(token_adapters), kv_backend->m_client,
-            id_generator, time_provider);
+            id_generator, time_provider, kv_backend->m_cache);
     }
     else {
         client_config.m_endpoint = config.m_endpoint;
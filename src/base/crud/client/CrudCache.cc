@@ -0,0 +1,184 @@
+#include "CrudCache.h"
+
+#include <algorithm>
+#include <functional>
+#include <sstream>
+
+namespace hestia {
+
+// Rough allocation overhead of an entry beyond its key and value
+static constexpr std::size_t s_entry_overhead = 128;
+
+CrudCacheConfig::CrudCacheConfig() : SerializeableWithFields(s_type)
+{
+    init();
+}
+
+CrudCacheConfig::CrudCacheConfig(const CrudCacheConfig& other) :
+    SerializeableWithFields(other)
+{
+    *this = other;
+}
+
+std::string CrudCacheConfig::get_type()
+{
+    return s_type;
+}
+
+CrudCacheConfig& CrudCacheConfig::operator=(const CrudCacheConfig& other)
+{
+    if (this != &other) {
+        SerializeableWithFields::operator=(other);
+        m_max_size   = other.m_max_size;
+        m_ttl        = other.m_ttl;
+        m_num_shards = other.m_num_shards;
+        init();
+    }
+    return *this;
+}
+
+void CrudCacheConfig::init()
+{
+    register_scalar_field(&m_max_size);
+    register_scalar_field(&m_ttl);
+    register_scalar_field(&m_num_shards);
+}
+
+bool CrudCacheConfig::is_active() const
+{
+    return m_max_size.get_value() > 0;
+}
+
+std::string CrudCache::Stats::to_string() const
+{
+    std::stringstream sstr;
+    sstr << "hits: " << m_hits << ", misses: " << m_misses
+         << ", evictions: " << m_evictions << ", entries: " << m_count
+         << ", size: " << m_size;
+    return sstr.str();
+}
+
+CrudCache::CrudCache(const CrudCacheConfig& config) :
+    m_ttl(config.m_ttl.get_value()),
+    m_shards(std::max<std::size_t>(1, config.m_num_shards.get_value()))
+{
+    m_shard_budget = config.m_max_size.get_value() / m_shards.size();
+}
+
+CrudCache::Shard& CrudCache::get_shard(const std::string& key) const
+{
+    return m_shards[std::hash<std::string>{}(key) % m_shards.size()];
+}
+
+std::size_t CrudCache::get_entry_size(const Entry& entry)
+{
+    return entry.m_key.size() + entry.m_value.size() + s_entry_overhead;
+}
+
+void CrudCache::erase(Shard& shard, std::list<Entry>::iterator iter)
+{
+    shard.m_size -= get_entry_size(*iter);
+    shard.m_index.erase(iter->m_key);
+    shard.m_entries.erase(iter);
+}
+
+bool CrudCache::get(const std::string& key, std::string& value)
+{
+    auto& shard = get_shard(key);
+    std::scoped_lock guard(shard.m_mutex);
+
+    auto index_iter = shard.m_index.find(key);
+    if (index_iter == shard.m_index.end()) {
+        shard.m_misses++;
+        return false;
+    }
+
+    auto entry_iter = index_iter->second;
+    if (Clock::now() >= entry_iter->m_expiry) {
+        erase(shard, entry_iter);
+        shard.m_misses++;
+        return false;
+    }
+
+    shard.m_entries.splice(
+        shard.m_entries.begin(), shard.m_entries, entry_iter);
+    value = entry_iter->m_value;
+    shard.m_hits++;
+    return true;
+}
+
+uint64_t CrudCache::get_version(const std::string& key) const
+{
+    auto& shard = get_shard(key);
+    std::scoped_lock guard(shard.m_mutex);
+    return shard.m_version;
+}
+
+void CrudCache::put(
+    const std::string& key, const std::string& value, uint64_t version)
+{
+    Entry entry{key, value, Clock::now() + m_ttl};
+    const auto entry_size = get_entry_size(entry);
+    if (entry_size > m_shard_budget) {
+        return;
+    }
+
+    auto& shard = get_shard(key);
+    std::scoped_lock guard(shard.m_mutex);
+    if (shard.m_version != version) {
+        return;
+    }
+
+    if (auto iter = shard.m_index.find(key); iter != shard.m_index.end()) {
+        erase(shard, iter->second);
+    }
+
+    while (!shard.m_entries.empty()
+           && shard.m_size + entry_size > m_shard_budget) {
+        erase(shard, std::prev(shard.m_entries.end()));
+        shard.m_evictions++;
+    }
+
+    shard.m_entries.push_front(std::move(entry));
+    shard.m_index[key] = shard.m_entries.begin();
+    shard.m_size += entry_size;
+}
+
+void CrudCache::remove(const std::vector<std::string>& keys)
+{
+    for (const auto& key : keys) {
+        auto& shard = get_shard(key);
+        std::scoped_lock guard(shard.m_mutex);
+        shard.m_version++;
+        if (auto iter = shard.m_index.find(key); iter != shard.m_index.end()) {
+            erase(shard, iter->second);
+        }
+    }
+}
+
+void CrudCache::clear()
+{
+    for (auto& shard : m_shards) {
+        std::scoped_lock guard(shard.m_mutex);
+        shard.m_version++;
+        shard.m_entries.clear();
+        shard.m_index.clear();
+        shard.m_size = 0;
+    }
+}
+
+CrudCache::Stats CrudCache::get_stats() const
+{
+    Stats stats;
+    for (const auto& shard : m_shards) {
+        std::scoped_lock guard(shard.m_mutex);
+        stats.m_hits += shard.m_hits;
+        stats.m_misses += shard.m_misses;
+        stats.m_evictions += shard.m_evictions;
+        stats.m_count += shard.m_entries.size();
+        stats.m_size += shard.m_size;
+    }
+    return stats;
+}
+
+}  // namespace hestia
@@ -0,0 +1,135 @@
+#pragma once
+
+#include "SerializeableWithFields.h"
+
+#include <chrono>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace hestia {
+
+class CrudCacheConfig : public SerializeableWithFields {
+  public:
+    CrudCacheConfig();
+
+    CrudCacheConfig(const CrudCacheConfig& other);
+
+    static std::string get_type();
+
+    bool is_active() const;
+
+    CrudCacheConfig& operator=(const CrudCacheConfig& other);
+
+    UIntegerField m_max_size{"max_size", 0};
+    UIntegerField m_ttl{"ttl", 30};
+    UIntegerField m_num_shards{"num_shards", 16};
+
+  private:
+    void init();
+
+    static constexpr const char s_type[]{"crud_cache"};
+};
+
+/**
+ * @brief A bounded cache of serialized items read from a CRUD backend
+ *
+ * Entries map a backend key to the stored item content and are kept for at
+ * most 'ttl' seconds. The cache is split into shards, each with its own lock
+ * and least-recently-used list, and the 'max_size' byte budget is shared
+ * evenly between them. A 'max_size' of 0 means the cache shouldn't be used.
+ *
+ * Writers remove keys after the backend write completes. To stop a reader
+ * from filling the cache with a value read before such a write, readers take
+ * a version with 'get_version' before reading the backend and pass it to
+ * 'put', which is dropped if keys in the shard were removed since.
+ *
+ * Only writes made through this cache's clients are seen, so entries can be
+ * up to 'ttl' seconds out of date with writes from other nodes.
+ */
+class CrudCache {
+  public:
+    struct Stats {
+        std::size_t m_hits{0};
+        std::size_t m_misses{0};
+        std::size_t m_evictions{0};
+        std::size_t m_count{0};
+        std::size_t m_size{0};
+
+        std::string to_string() const;
+    };
+
+    explicit CrudCache(const CrudCacheConfig& config = {});
+
+    /**
+     * Look up an entry, counting a hit or miss
+     *
+     * @param key The backend key
+     * @param value Set to the cached content on a hit
+     * @return True on a hit
+     */
+    bool get(const std::string& key, std::string& value);
+
+    /**
+     * Version to pass to 'put' for a value about to be read from the backend
+     *
+     * @param key The backend key
+     * @return The version
+     */
+    uint64_t get_version(const std::string& key) const;
+
+    /**
+     * Add or replace an entry, evicting the least recently used entries to
+     * stay within budget.
+     *
+     * @param key The backend key
+     * @param value The item content
+     * @param version Result of 'get_version' taken before the backend read
+     */
+    void put(
+        const std::string& key, const std::string& value, uint64_t version);
+
+    /**
+     * Remove entries - called once writes to the keys have completed
+     *
+     * @param keys The backend keys
+     */
+    void remove(const std::vector<std::string>& keys);
+
+    void clear();
+
+    Stats get_stats() const;
+
+  private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Entry {
+        std::string m_key;
+        std::string m_value;
+        Clock::time_point m_expiry;
+    };
+
+    struct Shard {
+        mutable std::mutex m_mutex;
+        std::list<Entry> m_entries;
+        std::unordered_map<std::string, std::list<Entry>::iterator> m_index;
+        std::size_t m_size{0};
+        uint64_t m_version{0};
+        std::size_t m_hits{0};
+        std::size_t m_misses{0};
+        std::size_t m_evictions{0};
+    };
+
+    static std::size_t get_entry_size(const Entry& entry);
+
+    Shard& get_shard(const std::string& key) const;
+
+    static void erase(Shard& shard, std::list<Entry>::iterator iter);
+
+    std::size_t m_shard_budget{0};
+    std::chrono::seconds m_ttl{0};
+    mutable std::vector<Shard> m_shards;
+};
+}  // namespace hestia
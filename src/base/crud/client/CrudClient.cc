@@ -35,6 +35,11 @@ CrudClient::CrudClient(
 
 CrudClient::~CrudClient() {}
 
+CrudUnitOfWork::Ptr CrudClient::create_unit_of_work() const
+{
+    return nullptr;
+}
+
 std::string CrudClient::generate_id(const std::string& name) const
 {
     if (m_id_generator == nullptr) {
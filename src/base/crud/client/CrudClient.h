@@ -3,6 +3,7 @@
 #include "CrudClientConfig.h"
 #include "CrudRequest.h"
 #include "CrudResponse.h"
+#include "CrudUnitOfWork.h"
 #include "StringAdapter.h"
 
 #include <memory>
@@ -58,6 +59,14 @@ class CrudClient {
 
     virtual std::string generate_id(const std::string& name) const;
 
+    /**
+     * Create a unit of work to collect writes in, if the backend can batch
+     * them.
+     *
+     * @return The unit of work, or null if writes can't be batched
+     */
+    virtual CrudUnitOfWork::Ptr create_unit_of_work() const;
+
     std::string get_type() const;
 
     void register_parent_service(const std::string& type, CrudService* service);
@@ -268,6 +268,20 @@ void HttpCrudClient::read(
         }
         LOG_INFO("Got response: " << response->body());
 
+        if (const auto total_count =
+                response->header().get_item("hestia-total_count");
+            !total_count.empty()) {
+            try {
+                crud_response.set_total_count(std::stoul(total_count));
+            }
+            catch (const std::exception&) {
+                throw RequestException<CrudRequestError>(
+                    {CrudErrorCode::ERROR,
+                     "Invalid hestia-total_count header in http client GET: "
+                         + total_count});
+            }
+        }
+
         std::vector<std::string> ids;
 
         if (crud_request.get_query().is_id_output_format()) {
@@ -47,5 +47,11 @@ void HttpCrudPath::from_query(const CrudQuery& query, std::string& path)
             from_identifier(query.get_id(), path);
         }
     }
+
+    if (query.is_paged()) {
+        path += path.find('?') == std::string::npos ? "?" : "&";
+        path += "offset=" + std::to_string(query.get_offset())
+                + "&count=" + std::to_string(query.get_page_size());
+    }
 }
 }  // namespace hestia
\ No newline at end of file
@@ -240,6 +240,17 @@ void KeyValueCreateContext::prepare_db_query(
         // Add id to own key set
         set_add_kv_pairs.emplace_back(get_set_key(), id);
 
+        // Add id to secondary index sets
+        VecKeyValuePair index_entries;
+        get_secondary_index_entries(*item_dict, index_entries);
+        for (const auto& [field, value] : index_entries) {
+            set_add_kv_pairs.emplace_back(
+                get_secondary_index_key(field, value), id);
+            set_add_kv_pairs.emplace_back(
+                get_secondary_index_order_key(field),
+                get_secondary_index_order_member(value, id));
+        }
+
         // Add id to any foreign key sets
         for (const auto& field_context : m_foreign_key[count]) {
             set_add_kv_pairs.emplace_back(get_foreign_key(field_context), id);
@@ -274,19 +285,11 @@ std::string KeyValueCreateContext::get_index_field_key(
     std::size_t offset,
     std::size_t num_indices) const
 {
-    const auto& [scope, name, value] = index_field;
-    std::string field_key;
-    if (scope == BaseField::IndexScope::GLOBAL) {
-        field_key = name;
-    }
-    else {
-        std::string parent_id;
-        if (parent_ids.size() == num_indices) {
-            parent_id = parent_ids[offset];
-        }
-        field_key = parent_id.empty() ? name : parent_id + "::" + name;
+    std::string parent_id;
+    if (parent_ids.size() == num_indices) {
+        parent_id = parent_ids[offset];
     }
-    return get_field_key(field_key, value);
+    return KeyValueFieldContext::get_index_field_key(index_field, parent_id);
 }
 
 void KeyValueCreateContext::replace_foreign_key_ids(
@@ -1,5 +1,6 @@
 #include "KeyValueCrudClient.h"
 
+#include "CrudCache.h"
 #include "IdGenerator.h"
 #include "KeyValueStoreClient.h"
 #include "KeyValueStoreRequest.h"
@@ -12,8 +13,10 @@
 #include "RequestException.h"
 
 #include "KeyValueCreateContext.h"
+#include "KeyValueFieldContext.h"
 #include "KeyValueReadContext.h"
 #include "KeyValueRemoveContext.h"
+#include "KeyValueUnitOfWork.h"
 #include "KeyValueUpdateContext.h"
 
 #include <cassert>
@@ -25,14 +28,21 @@ KeyValueCrudClient::KeyValueCrudClient(
     AdapterCollectionPtr adapters,
     KeyValueStoreClient* client,
     IdGenerator* id_generator,
-    TimeProvider* time_provider) :
+    TimeProvider* time_provider,
+    CrudCache* cache) :
     CrudClient(config, std::move(adapters), id_generator, time_provider),
-    m_client(client)
+    m_client(client),
+    m_cache(cache)
 {
 }
 
 KeyValueCrudClient::~KeyValueCrudClient() {}
 
+CrudUnitOfWork::Ptr KeyValueCrudClient::create_unit_of_work() const
+{
+    return std::make_unique<KeyValueUnitOfWork>(m_client);
+}
+
 void KeyValueCrudClient::prepare_creation_overrides(
     const CrudUserContext& user_context,
     const Model& item_template,
@@ -95,16 +105,13 @@ void KeyValueCrudClient::create(
         string_set_queries, set_add_queries, ids, *content, creation_overrides,
         item_template->get_primary_key_name());
 
-    // Make batch requests to the STRING and SET kv store endpoints
-    const auto response = m_client->make_request(
-        {KeyValueStoreRequestMethod::STRING_SET, string_set_queries,
-         m_config.m_endpoint});
-    error_check("STRING_SET", response.get());
-
-    const auto set_response = m_client->make_request(
-        {KeyValueStoreRequestMethod::SET_ADD, set_add_queries,
-         m_config.m_endpoint});
-    error_check("SET_ADD", set_response.get());
+    // Write the items and their index entries in one batch
+    write(
+        crud_request,
+        {{KeyValueStoreRequestMethod::STRING_SET, string_set_queries,
+          m_config.m_endpoint},
+         {KeyValueStoreRequestMethod::SET_ADD, set_add_queries,
+          m_config.m_endpoint}});
 
     // Return the response in the requested format
     const auto json_adapter = get_adapter(CrudAttributes::Format::JSON);
@@ -157,6 +164,13 @@ void KeyValueCrudClient::update(
     VecModelPtr db_items;
     get_db_items(update_context.get_index_keys(), db_items);
 
+    // Note the indexed values before they are updated
+    std::vector<VecKeyValuePair> previous_index_entries;
+    update_context.get_secondary_index_entries(
+        db_items, previous_index_entries);
+    std::vector<std::vector<std::string>> previous_unique_keys;
+    update_context.get_unique_index_keys(db_items, previous_unique_keys);
+
     // Prepare overrides for update content, e.g. last modified time
     Dictionary update_overrides;
     prepare_update_overrides(update_overrides);
@@ -168,11 +182,41 @@ void KeyValueCrudClient::update(
         crud_request, *content, db_items, update_overrides, *updated_content,
         string_set_query);
 
-    // Do the db query
-    const auto set_response = m_client->make_request(
-        {KeyValueStoreRequestMethod::STRING_SET, string_set_query,
-         m_config.m_endpoint});
-    error_check("STRING_SET", set_response.get());
+    std::vector<KeyValuePair> index_add_query;
+    std::vector<KeyValuePair> index_remove_query;
+    update_context.prepare_index_query(
+        previous_index_entries, *updated_content, index_add_query,
+        index_remove_query);
+
+    // Renamed items - only drop an old name if it still refers to the item
+    std::vector<KeyValuePair> stale_unique_keys;
+    update_context.prepare_unique_index_query(
+        previous_unique_keys, db_items, string_set_query, stale_unique_keys);
+    std::vector<std::string> unique_remove_query;
+    if (!stale_unique_keys.empty()) {
+        std::vector<std::string> keys;
+        for (const auto& [key, id] : stale_unique_keys) {
+            keys.push_back(key);
+        }
+        const auto ids = get_db_values(keys);
+        for (std::size_t idx = 0; idx < ids.size(); idx++) {
+            if (ids[idx] == stale_unique_keys[idx].second) {
+                unique_remove_query.push_back(keys[idx]);
+            }
+        }
+    }
+
+    // Do the db query - the items and their index changes in one batch
+    write(
+        crud_request,
+        {{KeyValueStoreRequestMethod::STRING_SET, string_set_query,
+          m_config.m_endpoint},
+         {KeyValueStoreRequestMethod::STRING_REMOVE, unique_remove_query,
+          m_config.m_endpoint},
+         {KeyValueStoreRequestMethod::SET_REMOVE, index_remove_query,
+          m_config.m_endpoint},
+         {KeyValueStoreRequestMethod::SET_ADD, index_add_query,
+          m_config.m_endpoint}});
 
     // Prepare the reponse
     if (crud_request.get_query().is_attribute_output_format()) {
@@ -203,12 +247,24 @@ void KeyValueCrudClient::read(
     auto db_get_item_func = [this](const std::string& key) {
         return get_db_item(key);
     };
-    auto db_get_sets_func =
-        [this](
-            const std::vector<std::string>& keys,
-            std::vector<std::vector<std::string>>& response) {
-            return get_db_sets(keys, response);
-        };
+    auto db_get_set_range_func = [this](
+                                     const std::string& key, std::size_t offset,
+                                     std::size_t count,
+                                     std::vector<std::string>& values) {
+        return get_db_set_range(key, offset, count, values);
+    };
+    auto db_get_set_between_func = [this](
+                                       const std::string& key,
+                                       const std::string& min,
+                                       const std::string& max,
+                                       std::vector<std::string>& values) {
+        get_db_set_between(key, min, max, values);
+    };
+    auto db_set_intersect_func = [this](
+                                     const std::vector<std::string>& keys,
+                                     std::vector<std::string>& values) {
+        get_db_set_intersection(keys, values);
+    };
     auto id_from_parent_id_func = [this](
                                       const std::string& parent_type,
                                       const std::string& child_type,
@@ -217,12 +273,17 @@ void KeyValueCrudClient::read(
         return get_id_from_parent_id(parent_type, child_type, id, user_context);
     };
     KeyValueReadContext read_context(
-        m_adapters.get(), m_config.m_prefix, db_get_item_func, db_get_sets_func,
+        m_adapters.get(), m_config.m_prefix, db_get_item_func,
+        db_get_set_range_func, db_get_set_between_func, db_set_intersect_func,
         id_from_parent_id_func);
+    if (!request.get_query().get_filter().empty()) {
+        index_existing_items();
+    }
     if (!read_context.serialize_request(request)) {
         read_context.on_empty_read(request.get_query(), crud_response);
         return;
     }
+    crud_response.set_total_count(read_context.get_total_count());
 
     // Read item content from the DB
     auto read_content = std::make_unique<Dictionary>();
@@ -299,18 +360,14 @@ void KeyValueCrudClient::remove(
 
     // Set up the db removal queries
     std::vector<KeyValuePair> set_remove_keys;
-    remove_context.prepare_db_query(set_remove_keys);
+    remove_context.prepare_db_query(db_items, set_remove_keys);
 
-    // Do the db removal
-    const auto string_response = m_client->make_request(
-        {KeyValueStoreRequestMethod::STRING_REMOVE,
-         remove_context.get_index_keys(), m_config.m_endpoint});
-    error_check("STRING_REMOVE", string_response.get());
-
-    const auto set_response = m_client->make_request(
-        {KeyValueStoreRequestMethod::SET_REMOVE, set_remove_keys,
-         m_config.m_endpoint});
-    error_check("SET_REMOVE", string_response.get());
+    // Do the db removal - the items and their index entries in one batch
+    write(
+        request, {{KeyValueStoreRequestMethod::STRING_REMOVE,
+                   remove_context.get_index_keys(), m_config.m_endpoint},
+                  {KeyValueStoreRequestMethod::SET_REMOVE, set_remove_keys,
+                   m_config.m_endpoint}});
 
     // Prepare the response
     crud_response.ids() = remove_context.get_index_ids();
@@ -335,39 +392,33 @@ void KeyValueCrudClient::assign_modified_attributes(
 
 std::string KeyValueCrudClient::get_db_item(const std::string& key) const
 {
-    const auto response = m_client->make_request(
-        {KeyValueStoreRequestMethod::STRING_GET, {key}, m_config.m_endpoint});
-    error_check("STRING_GET", response.get());
-    if (response->items().empty() || response->items()[0].empty()) {
+    const auto values = get_db_values({key});
+    if (values.empty()) {
         return {};
     }
-    return response->items()[0];
+    return values[0];
 }
 
 std::vector<std::string> KeyValueCrudClient::get_db_items(
     const std::vector<std::string>& keys) const
 {
-    const auto response = m_client->make_request(
-        {KeyValueStoreRequestMethod::STRING_GET, keys, m_config.m_endpoint});
-    error_check("GET", response.get());
-    return response->get_items();
+    return get_db_values(keys);
 }
 
 void KeyValueCrudClient::get_db_items(
     const std::vector<std::string>& keys, VecModelPtr& items) const
 {
-    const auto response = m_client->make_request(
-        {KeyValueStoreRequestMethod::STRING_GET, keys, m_config.m_endpoint});
-    error_check("GET", response.get());
-
-    const auto any_false = std::any_of(
-        response->found().begin(), response->found().end(),
-        [](bool v) { return !v; });
-    if (any_false) {
+    // Missing keys, whether read from the cache or the store, come back empty
+    const auto values = get_db_values(keys);
+    const auto any_missing =
+        values.size() != keys.size()
+        || std::any_of(values.begin(), values.end(), [](const auto& value) {
+               return value.empty();
+           });
+    if (any_missing) {
         throw std::runtime_error("Attempted to update a non-existing resource");
     }
-    get_adapter(CrudAttributes::Format::JSON)
-        ->from_string(response->items(), items);
+    get_adapter(CrudAttributes::Format::JSON)->from_string(values, items);
 }
 
 bool KeyValueCrudClient::get_db_items(
@@ -375,25 +426,67 @@ bool KeyValueCrudClient::get_db_items(
     Dictionary& db_content,
     bool expects_single) const
 {
-    const auto response = m_client->make_request(
-        {KeyValueStoreRequestMethod::STRING_GET, keys, m_config.m_endpoint});
-    error_check("GET", response.get());
-    if (response->items().empty()) {
+    const auto values = get_db_values(keys);
+    if (values.empty()) {
         return false;
     }
 
     const auto any_empty = std::any_of(
-        response->items().begin(), response->items().end(),
+        values.begin(), values.end(),
         [](const std::string& entry) { return entry.empty(); });
     if (any_empty) {
         return false;
     }
 
     const auto adapter = get_adapter(CrudAttributes::Format::JSON);
-    adapter->from_string(response->items(), db_content, !expects_single);
+    adapter->from_string(values, db_content, !expects_single);
     return true;
 }
 
+std::vector<std::string> KeyValueCrudClient::get_db_values(
+    const std::vector<std::string>& keys) const
+{
+    if (m_cache == nullptr) {
+        const auto response = m_client->make_request(
+            {KeyValueStoreRequestMethod::STRING_GET, keys,
+             m_config.m_endpoint});
+        error_check("GET", response.get());
+        return response->get_items();
+    }
+
+    // Only go to the db for keys missing from the cache
+    std::vector<std::string> values(keys.size());
+    std::vector<std::string> missing_keys;
+    std::vector<std::size_t> missing_offsets;
+    std::vector<uint64_t> versions;
+    for (std::size_t idx = 0; idx < keys.size(); idx++) {
+        if (m_cache->get(keys[idx], values[idx])) {
+            continue;
+        }
+        missing_keys.push_back(keys[idx]);
+        missing_offsets.push_back(idx);
+        versions.push_back(m_cache->get_version(keys[idx]));
+    }
+    if (missing_keys.empty()) {
+        return values;
+    }
+
+    const auto response = m_client->make_request(
+        {KeyValueStoreRequestMethod::STRING_GET, missing_keys,
+         m_config.m_endpoint});
+    error_check("GET", response.get());
+
+    const auto& db_values = response->items();
+    for (std::size_t idx = 0; idx < db_values.size(); idx++) {
+        if (db_values[idx].empty()) {
+            continue;
+        }
+        values[missing_offsets[idx]] = db_values[idx];
+        m_cache->put(missing_keys[idx], db_values[idx], versions[idx]);
+    }
+    return values;
+}
+
 void KeyValueCrudClient::get_db_sets(
     const std::vector<std::string>& keys,
     std::vector<std::vector<std::string>>& values) const
@@ -462,4 +555,227 @@ void KeyValueCrudClient::error_check(
     }
 }
 
+void KeyValueCrudClient::write(
+    const CrudRequest& crud_request,
+    const std::vector<KeyValueStoreRequest>& requests) const
+{
+    std::vector<KeyValueStoreRequest> db_requests;
+    std::vector<std::string> written_keys;
+    for (const auto& request : requests) {
+        if (request.get_kv_pairs().empty() && request.get_keys().empty()) {
+            continue;
+        }
+        db_requests.push_back(request);
+        const auto keys = get_written_keys(request);
+        written_keys.insert(written_keys.end(), keys.begin(), keys.end());
+    }
+    if (db_requests.empty()) {
+        return;
+    }
+
+    if (auto unit_of_work =
+            dynamic_cast<KeyValueUnitOfWork*>(crud_request.get_unit_of_work());
+        unit_of_work != nullptr && unit_of_work->is_for(m_client)) {
+        for (const auto& request : db_requests) {
+            unit_of_work->add(request);
+        }
+        if (m_cache != nullptr) {
+            m_cache->remove(written_keys);
+            unit_of_work->on_commit([cache = m_cache, written_keys]() {
+                cache->remove(written_keys);
+            });
+        }
+        return;
+    }
+
+    // The item and its index entries are written in one batch, so they are
+    // applied together
+    if (db_requests.size() == 1) {
+        const auto response = m_client->make_request(db_requests[0]);
+        error_check(db_requests[0].method_as_string(), response.get());
+    }
+    else {
+        const auto response = m_client->make_batch_request(db_requests);
+        error_check("BATCH", response.get());
+    }
+    if (m_cache != nullptr) {
+        m_cache->remove(written_keys);
+    }
+}
+
+std::vector<std::string> KeyValueCrudClient::get_written_keys(
+    const KeyValueStoreRequest& request)
+{
+    if (request.method() == KeyValueStoreRequestMethod::STRING_REMOVE) {
+        return request.get_keys();
+    }
+    std::vector<std::string> keys;
+    if (request.method() == KeyValueStoreRequestMethod::STRING_SET) {
+        for (const auto& [key, value] : request.get_kv_pairs()) {
+            keys.push_back(key);
+        }
+    }
+    return keys;
+}
+
+void KeyValueCrudClient::get_db_set_between(
+    const std::string& key,
+    const std::string& min,
+    const std::string& max,
+    std::vector<std::string>& values) const
+{
+    KeyValueStoreRequest request(
+        KeyValueStoreRequestMethod::SET_LIST_BETWEEN,
+        std::vector<std::string>{key}, m_config.m_endpoint);
+    request.set_bounds(min, max);
+
+    const auto response = m_client->make_request(request);
+    error_check("SET_LIST_BETWEEN", response.get());
+    if (!response->ids().empty()) {
+        values = response->ids()[0];
+    }
+}
+
+void KeyValueCrudClient::index_existing_items() const
+{
+    if (m_indexed_existing_items) {
+        return;
+    }
+    std::scoped_lock guard(m_index_mutex);
+    if (m_indexed_existing_items) {
+        return;
+    }
+
+    KeyValueFieldContext field_context(m_adapters.get(), m_config.m_prefix);
+    const auto& fields = field_context.get_secondary_index_fields();
+    if (fields.empty()) {
+        m_indexed_existing_items = true;
+        return;
+    }
+
+    std::string indexed_fields = "ordered";
+    for (const auto& field : fields) {
+        indexed_fields += ":" + field;
+    }
+    const auto marker_key = field_context.get_secondary_index_marker_key();
+    if (get_db_item(marker_key) == indexed_fields) {
+        m_indexed_existing_items = true;
+        return;
+    }
+
+    std::vector<std::vector<std::string>> id_sets;
+    get_db_sets({field_context.get_set_key()}, id_sets);
+    std::vector<std::string> ids;
+    if (!id_sets.empty()) {
+        ids = std::move(id_sets[0]);
+    }
+
+    // Re-adding entries for items that are already indexed is harmless
+    const auto adapter          = get_adapter(CrudAttributes::Format::JSON);
+    const std::size_t chunk_size = 1000;
+    for (std::size_t offset = 0; offset < ids.size(); offset += chunk_size) {
+        const std::vector<std::string> chunk_ids(
+            ids.begin() + offset,
+            ids.begin() + std::min(offset + chunk_size, ids.size()));
+        std::vector<std::string> keys;
+        field_context.get_item_keys(chunk_ids, keys);
+        const auto db_items = get_db_values(keys);
+
+        VecKeyValuePair set_add_query;
+        for (std::size_t idx = 0; idx < db_items.size(); idx++) {
+            if (db_items[idx].empty()) {
+                continue;
+            }
+            Dictionary item_dict;
+            adapter->dict_from_string(db_items[idx], item_dict);
+
+            VecKeyValuePair entries;
+            field_context.get_secondary_index_entries(item_dict, entries);
+            for (const auto& [field, value] : entries) {
+                set_add_query.emplace_back(
+                    field_context.get_secondary_index_key(field, value),
+                    chunk_ids[idx]);
+                set_add_query.emplace_back(
+                    field_context.get_secondary_index_order_key(field),
+                    field_context.get_secondary_index_order_member(
+                        value, chunk_ids[idx]));
+            }
+        }
+        if (!set_add_query.empty()) {
+            const auto response = m_client->make_request(
+                {KeyValueStoreRequestMethod::SET_ADD, set_add_query,
+                 m_config.m_endpoint});
+            error_check("SET_ADD", response.get());
+        }
+    }
+
+    // The distinct value sets are replaced by the ordered indexes
+    std::vector<std::string> values_keys;
+    for (const auto& field : fields) {
+        values_keys.push_back(
+            field_context.get_secondary_index_values_key(field));
+    }
+    std::vector<std::vector<std::string>> value_sets;
+    get_db_sets(values_keys, value_sets);
+    VecKeyValuePair set_remove_query;
+    for (std::size_t idx = 0; idx < value_sets.size(); idx++) {
+        for (const auto& value : value_sets[idx]) {
+            set_remove_query.emplace_back(values_keys[idx], value);
+        }
+    }
+
+    std::vector<KeyValueStoreRequest> requests;
+    if (!set_remove_query.empty()) {
+        requests.push_back(
+            {KeyValueStoreRequestMethod::SET_REMOVE, set_remove_query,
+             m_config.m_endpoint});
+    }
+    requests.push_back(
+        {KeyValueStoreRequestMethod::STRING_SET,
+         VecKeyValuePair{{marker_key, indexed_fields}}, m_config.m_endpoint});
+    const auto response = m_client->make_batch_request(requests);
+    error_check("BATCH", response.get());
+    if (m_cache != nullptr) {
+        m_cache->remove({marker_key});
+    }
+
+    LOG_INFO(
+        "Indexed " << ids.size() << " existing items of type "
+                   << m_adapters->get_type());
+    m_indexed_existing_items = true;
+}
+
+std::size_t KeyValueCrudClient::get_db_set_range(
+    const std::string& key,
+    std::size_t offset,
+    std::size_t count,
+    std::vector<std::string>& values) const
+{
+    KeyValueStoreRequest request(
+        KeyValueStoreRequestMethod::SET_LIST, std::vector<std::string>{key},
+        m_config.m_endpoint);
+    request.set_range(offset, count);
+
+    const auto response = m_client->make_request(request);
+    error_check("SET_LIST", response.get());
+    if (response->ids().empty()) {
+        return 0;
+    }
+    values = response->ids()[0];
+    return response->set_sizes().empty() ? values.size() :
+                                           response->set_sizes()[0];
+}
+
+void KeyValueCrudClient::get_db_set_intersection(
+    const std::vector<std::string>& keys,
+    std::vector<std::string>& values) const
+{
+    const auto response = m_client->make_request(
+        {KeyValueStoreRequestMethod::SET_INTERSECT, keys, m_config.m_endpoint});
+    error_check("SET_INTERSECT", response.get());
+    if (!response->ids().empty()) {
+        values = response->ids()[0];
+    }
+}
+
 }  // namespace hestia
\ No newline at end of file
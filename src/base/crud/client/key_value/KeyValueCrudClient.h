@@ -3,9 +3,14 @@
 #include "CrudClient.h"
 #include "Response.h"
 
+#include <atomic>
+#include <mutex>
+
 namespace hestia {
 
+class CrudCache;
 class KeyValueStoreClient;
+class KeyValueStoreRequest;
 
 class KeyValueCrudClient : public CrudClient {
   public:
@@ -14,10 +19,13 @@ class KeyValueCrudClient : public CrudClient {
         AdapterCollectionPtr adapters,
         KeyValueStoreClient* client,
         IdGenerator* id_generator   = nullptr,
-        TimeProvider* time_provider = nullptr);
+        TimeProvider* time_provider = nullptr,
+        CrudCache* cache            = nullptr);
 
     virtual ~KeyValueCrudClient();
 
+    CrudUnitOfWork::Ptr create_unit_of_work() const override;
+
   private:
     void create(
         const CrudRequest& request,
@@ -69,16 +77,77 @@ class KeyValueCrudClient : public CrudClient {
 
     std::string get_db_item(const std::string& key) const;
 
+    /**
+     * Get string values from the db, or the cache if there is one. Values
+     * for missing keys are empty.
+     *
+     * @param keys The db keys
+     * @return The values in key order
+     */
+    std::vector<std::string> get_db_values(
+        const std::vector<std::string>& keys) const;
+
     void get_db_sets(
         const std::vector<std::string>& keys,
         std::vector<std::vector<std::string>>& values) const;
 
+    std::size_t get_db_set_range(
+        const std::string& key,
+        std::size_t offset,
+        std::size_t count,
+        std::vector<std::string>& values) const;
+
+    /**
+     * Get the members of a sorted set in [min, max), in sorted order
+     *
+     * @param key The set's db key
+     * @param min The first member to get
+     * @param max The member to stop at
+     * @param values Filled with the members
+     */
+    void get_db_set_between(
+        const std::string& key,
+        const std::string& min,
+        const std::string& max,
+        std::vector<std::string>& values) const;
+
+    void get_db_set_intersection(
+        const std::vector<std::string>& keys,
+        std::vector<std::string>& values) const;
+
     std::string get_lock_key(
         const std::string& id, CrudLockType lock_type) const;
 
     void error_check(
         const std::string& identifier, const BaseResponse* response) const;
 
+    /**
+     * Make db write requests as one batch, or queue them if the CRUD request
+     * has a unit of work for this store. Requests with nothing to write are
+     * dropped.
+     *
+     * @param crud_request The CRUD request the writes are for
+     * @param requests The db write requests
+     */
+    void write(
+        const CrudRequest& crud_request,
+        const std::vector<KeyValueStoreRequest>& requests) const;
+
+    static std::vector<std::string> get_written_keys(
+        const KeyValueStoreRequest& request);
+
+    /**
+     * Add items stored before their type's secondary indexes, or before the
+     * ordered indexes, to the indexes and clear out the old distinct value
+     * sets. This is done once for each set of index fields - the fields are
+     * recorded in the store when it completes.
+     */
+    void index_existing_items() const;
+
     KeyValueStoreClient* m_client{nullptr};
+    CrudCache* m_cache{nullptr};
+
+    mutable std::atomic<bool> m_indexed_existing_items{false};
+    mutable std::mutex m_index_mutex;
 };
 }  // namespace hestia
\ No newline at end of file
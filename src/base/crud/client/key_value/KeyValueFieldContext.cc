@@ -3,6 +3,11 @@
 #include "ErrorUtils.h"
 
 #include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 
 namespace hestia {
 
@@ -36,9 +41,147 @@ std::string KeyValueFieldContext::get_prefix() const
     return m_key_prefix + ":" + m_adapters->get_type();
 }
 
+std::string KeyValueFieldContext::get_index_field_key(
+    const SerializeableWithFields::IndexField& index_field,
+    const std::string& parent_id) const
+{
+    std::string field_key = index_field.m_name;
+    if (index_field.m_scope != BaseField::IndexScope::GLOBAL
+        && !parent_id.empty()) {
+        field_key = parent_id + "::" + field_key;
+    }
+    return get_field_key(field_key, index_field.m_value);
+}
+
 std::string KeyValueFieldContext::get_set_key() const
 {
     return get_prefix() + "s";
 }
 
+std::string KeyValueFieldContext::get_secondary_index_key(
+    const std::string& field, const std::string& value) const
+{
+    return get_prefix() + "_idx_" + field + ":" + value;
+}
+
+std::string KeyValueFieldContext::get_secondary_index_order_key(
+    const std::string& field) const
+{
+    return get_prefix() + "_idx_" + field + "_order";
+}
+
+std::string KeyValueFieldContext::get_secondary_index_values_key(
+    const std::string& field) const
+{
+    return get_prefix() + "_idx_" + field + "s";
+}
+
+std::string KeyValueFieldContext::get_secondary_index_marker_key() const
+{
+    return get_prefix() + "_idx_version";
+}
+
+std::string KeyValueFieldContext::get_secondary_index_order_member(
+    const std::string& value, const std::string& id)
+{
+    // The separator sorts ahead of any character in a value, so a value
+    // sorts ahead of longer values it is a prefix of whatever the ids
+    return get_sortable_value(value) + '\x01' + id;
+}
+
+std::string KeyValueFieldContext::get_id_from_order_member(
+    const std::string& member)
+{
+    const auto separator = member.rfind('\x01');
+    if (separator == std::string::npos) {
+        return {};
+    }
+    return member.substr(separator + 1);
+}
+
+std::string KeyValueFieldContext::get_sortable_value(const std::string& value)
+{
+    char* value_end{nullptr};
+    auto number = std::strtod(value.c_str(), &value_end);
+    if (value.empty() || *value_end != '\0' || std::isnan(number)) {
+        return "s" + value;
+    }
+
+    // The double's bits are flipped so that their big-endian hex sorts in
+    // numeric order - sign bit set for positives, all bits for negatives
+    if (number == 0.0) {
+        number = 0.0;
+    }
+    uint64_t bits{0};
+    std::memcpy(&bits, &number, sizeof(bits));
+    const uint64_t sign_bit = uint64_t{1} << 63;
+    bits                    = (bits & sign_bit) != 0 ? ~bits : bits | sign_bit;
+
+    char hex[17];
+    std::snprintf(
+        hex, sizeof(hex), "%016llx", static_cast<unsigned long long>(bits));
+    std::string sortable = "n" + std::string(hex);
+
+    // Large integers, e.g. times in ns, can share a double so their digits
+    // follow to keep them in order
+    const auto digits_start = value.find_first_not_of('0');
+    if (digits_start != std::string::npos
+        && value.find_first_not_of("0123456789") == std::string::npos) {
+        const auto digits = value.substr(digits_start);
+        char length[3];
+        std::snprintf(length, sizeof(length), "%02zu", digits.size());
+        sortable += std::string(length) + digits;
+    }
+    return sortable;
+}
+
+void KeyValueFieldContext::load_index_fields() const
+{
+    if (m_loaded_index_fields) {
+        return;
+    }
+    auto item_template = m_adapters->get_model_factory()->create();
+    item_template->get_secondary_index_fields(m_secondary_index_fields);
+    item_template->get_unique_index_fields(m_unique_index_fields);
+    m_loaded_index_fields = true;
+}
+
+const std::vector<std::string>&
+KeyValueFieldContext::get_secondary_index_fields() const
+{
+    load_index_fields();
+    return m_secondary_index_fields;
+}
+
+const std::vector<std::string>&
+KeyValueFieldContext::get_unique_index_fields() const
+{
+    load_index_fields();
+    return m_unique_index_fields;
+}
+
+void KeyValueFieldContext::get_secondary_index_entries(
+    const Dictionary& item_dict, VecKeyValuePair& entries) const
+{
+    for (const auto& field : get_secondary_index_fields()) {
+        const auto field_dict = item_dict.get_map_item(field);
+        if (field_dict == nullptr) {
+            continue;
+        }
+
+        std::string value;
+        if (field_dict->get_type() == Dictionary::Type::SCALAR) {
+            value = field_dict->get_scalar();
+        }
+        else if (const auto id_dict = field_dict->get_map_item("id");
+                 id_dict != nullptr) {
+            value = id_dict->get_scalar();
+        }
+
+        if (!value.empty()) {
+            entries.emplace_back(field, value);
+        }
+    }
+}
+
 }  // namespace hestia
\ No newline at end of file
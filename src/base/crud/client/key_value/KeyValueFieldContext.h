@@ -1,5 +1,6 @@
 #pragma once
 
+#include "SerializeableWithFields.h"
 #include "StringAdapter.h"
 
 namespace hestia {
@@ -22,11 +23,105 @@ class KeyValueFieldContext {
 
     std::string get_set_key() const;
 
+    /**
+     * Key mapping a uniquely indexed field value, e.g. a name, to an item id.
+     * Fields indexed within a parent are scoped by the parent's id.
+     *
+     * @param index_field The indexed field and its value
+     * @param parent_id Id of the item's parent, if any
+     * @return The key
+     */
+    std::string get_index_field_key(
+        const SerializeableWithFields::IndexField& index_field,
+        const std::string& parent_id) const;
+
     std::string get_prefix() const;
 
+    /**
+     * Key for the set of ids of items with this value of a secondary index
+     * field
+     */
+    std::string get_secondary_index_key(
+        const std::string& field, const std::string& value) const;
+
+    /**
+     * Key for the ordered index of a secondary index field, used to resolve
+     * prefix and range filters. It holds a member for each (value, id) pair,
+     * made by get_secondary_index_order_member, kept in sorted order.
+     */
+    std::string get_secondary_index_order_key(const std::string& field) const;
+
+    /**
+     * Key for the set of distinct values of a secondary index field, which
+     * the ordered index replaces. It is only read to clear it out.
+     */
+    std::string get_secondary_index_values_key(const std::string& field) const;
+
+    /**
+     * Key recording which secondary index fields existing items have been
+     * added to the indexes for
+     */
+    std::string get_secondary_index_marker_key() const;
+
+    /**
+     * Member of a field's ordered index for an item. Members sort by value,
+     * with numbers ordered numerically ahead of other values.
+     *
+     * @param value The field value
+     * @param id The item id
+     * @return The member
+     */
+    static std::string get_secondary_index_order_member(
+        const std::string& value, const std::string& id);
+
+    /**
+     * Get the item id back from a member of a field's ordered index
+     *
+     * @param member The member
+     * @return The item id
+     */
+    static std::string get_id_from_order_member(const std::string& member);
+
+    /**
+     * Encode a value so that encoded values sort in the value's order -
+     * numerically for numbers, as text otherwise
+     *
+     * @param value The value
+     * @return The encoded value
+     */
+    static std::string get_sortable_value(const std::string& value);
+
+    /**
+     * Names of the secondary index fields on the model type, loaded from a
+     * model template the first time it is needed.
+     */
+    const std::vector<std::string>& get_secondary_index_fields() const;
+
+    /**
+     * Names of the uniquely indexed fields on the model type, e.g. name
+     */
+    const std::vector<std::string>& get_unique_index_fields() const;
+
+    /**
+     * Get the (field, value) pair for each secondary index field set in the
+     * serialized item. Foreign key fields are indexed on their id.
+     *
+     * @param item_dict The serialized item
+     * @param entries Filled with the indexed field names and values
+     */
+    void get_secondary_index_entries(
+        const Dictionary& item_dict, VecKeyValuePair& entries) const;
+
   protected:
     const AdapterCollection* m_adapters{nullptr};
     std::string m_key_prefix;
+
+  private:
+    void load_index_fields() const;
+
+    mutable bool m_loaded_index_fields{false};
+    mutable std::vector<std::string> m_secondary_index_fields;
+    mutable std::vector<std::string> m_unique_index_fields;
 };
 
 }  // namespace hestia
\ No newline at end of file
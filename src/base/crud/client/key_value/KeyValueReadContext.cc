@@ -1,6 +1,11 @@
 #include "KeyValueReadContext.h"
 
+#include "Logger.h"
+#include "RequestException.h"
+
+#include <algorithm>
 #include <iostream>
+#include <iterator>
 
 namespace hestia {
 
@@ -8,11 +13,15 @@ KeyValueReadContext::KeyValueReadContext(
     const AdapterCollection* adapters,
     const std::string& key_prefix,
     dbGetItemFunc db_get_item_func,
-    dbGetSetsFunc db_get_sets_func,
+    dbGetSetRangeFunc db_get_set_range_func,
+    dbGetSetBetweenFunc db_get_set_between_func,
+    dbSetIntersectFunc db_set_intersect_func,
     idFromParentIdFunc id_from_parent_id_func) :
     KeyValueFieldContext(adapters, key_prefix),
     m_db_get_item_func(db_get_item_func),
-    m_db_get_sets_func(db_get_sets_func),
+    m_db_get_set_range_func(db_get_set_range_func),
+    m_db_get_set_between_func(db_get_set_between_func),
+    m_db_set_intersect_func(db_set_intersect_func),
     m_id_from_parent_id_func(id_from_parent_id_func)
 {
 }
@@ -22,6 +31,11 @@ const std::vector<std::string>& KeyValueReadContext::get_index_keys() const
     return m_index_keys;
 }
 
+std::size_t KeyValueReadContext::get_total_count() const
+{
+    return m_total_count;
+}
+
 bool KeyValueReadContext::serialize_request(const CrudRequest& request)
 {
     auto template_item = m_adapters->get_model_factory()->create();
@@ -32,15 +46,14 @@ bool KeyValueReadContext::serialize_request(const CrudRequest& request)
         if (!serialize_ids(query, request.get_user_context())) {
             return false;
         }
+        m_total_count = m_index_keys.size();
     }
     else {
         if (query.get_filter().empty()) {
-            serialize_empty();
+            serialize_empty(query);
         }
         else {
-            if (!serialize_filter(query)) {
-                return false;
-            }
+            return serialize_filter(query);
         }
     }
     return true;
@@ -75,25 +88,214 @@ bool KeyValueReadContext::serialize_ids(
 
 bool KeyValueReadContext::serialize_filter(const CrudQuery& query)
 {
-    const auto& [key, value] = *query.get_filter().data().begin();
-    const auto matching_id   = m_db_get_item_func(get_field_key(key, value));
+    std::vector<FilterTerm> terms;
+    for (const auto& [key, value] : query.get_filter().data()) {
+        terms.push_back(parse_filter_term(key, value));
+        check_filter_term(terms.back());
+    }
+
+    if (terms.size() > 1 || is_secondary_index_field(terms[0].m_field)) {
+        return serialize_index_filter(query, terms);
+    }
+
+    // A single exact match on a uniquely indexed field, e.g. name
+    const auto matching_id =
+        m_db_get_item_func(get_field_key(terms[0].m_field, terms[0].m_value));
     if (matching_id.empty()) {
         return false;
     }
     add_item_id(matching_id);
+    m_total_count = 1;
+    return true;
+}
+
+bool KeyValueReadContext::is_secondary_index_field(
+    const std::string& field) const
+{
+    const auto& index_fields = get_secondary_index_fields();
+    return std::binary_search(index_fields.begin(), index_fields.end(), field);
+}
+
+void KeyValueReadContext::check_filter_term(const FilterTerm& term) const
+{
+    if (is_secondary_index_field(term.m_field)) {
+        return;
+    }
+
+    // Unique index fields may be scoped by a parent, e.g. parent_id::name
+    const auto scope_end = term.m_field.rfind("::");
+    const auto field     = scope_end == std::string::npos ?
+                               term.m_field :
+                               term.m_field.substr(scope_end + 2);
+
+    const auto& unique_fields = get_unique_index_fields();
+    std::string msg;
+    if (!std::binary_search(
+            unique_fields.begin(), unique_fields.end(), field)) {
+        msg = "Filter on field without an index: " + term.m_field;
+    }
+    else if (term.m_op != FilterOp::EQUAL) {
+        msg = "Prefix and range filters need a secondary index, not set for: "
+              + term.m_field;
+    }
+    else {
+        return;
+    }
+    LOG_ERROR(msg);
+    throw RequestException<CrudRequestError>(
+        {CrudErrorCode::UNSUPPORTED_REQUEST_METHOD, msg});
+}
+
+bool KeyValueReadContext::serialize_index_filter(
+    const CrudQuery& query, const std::vector<FilterTerm>& terms)
+{
+    // Exact matches on secondary index fields are intersected in the store.
+    // Unique index matches resolve to a single id and prefix and range
+    // matches to the ids in a range of the field's ordered index - these are
+    // intersected here.
+    std::vector<std::string> exact_keys;
+    std::vector<std::vector<std::string>> resolved_ids;
+    for (const auto& term : terms) {
+        if (!is_secondary_index_field(term.m_field)) {
+            const auto id =
+                m_db_get_item_func(get_field_key(term.m_field, term.m_value));
+            if (id.empty()) {
+                return false;
+            }
+            resolved_ids.push_back({id});
+        }
+        else if (term.m_op == FilterOp::EQUAL) {
+            exact_keys.push_back(
+                get_secondary_index_key(term.m_field, term.m_value));
+        }
+        else {
+            std::vector<std::string> ids;
+            get_ids_in_range(term, ids);
+            if (ids.empty()) {
+                return false;
+            }
+            resolved_ids.push_back(std::move(ids));
+        }
+    }
+
+    std::vector<std::string> ids;
+    if (!exact_keys.empty()) {
+        m_db_set_intersect_func(exact_keys, ids);
+    }
+    else {
+        ids = std::move(resolved_ids.back());
+        resolved_ids.pop_back();
+    }
+
+    for (const auto& term_ids : resolved_ids) {
+        std::vector<std::string> common;
+        std::set_intersection(
+            ids.begin(), ids.end(), term_ids.begin(), term_ids.end(),
+            std::back_inserter(common));
+        ids = std::move(common);
+    }
+
+    m_total_count = ids.size();
+    if (ids.empty()) {
+        return false;
+    }
+
+    const auto begin = std::min(query.get_offset(), ids.size());
+    const auto end   = query.get_page_size() == 0 ?
+                           ids.size() :
+                           std::min(begin + query.get_page_size(), ids.size());
+    for (auto idx = begin; idx < end; idx++) {
+        add_item_id(ids[idx]);
+    }
     return true;
 }
 
-void KeyValueReadContext::serialize_empty()
+void KeyValueReadContext::get_ids_in_range(
+    const FilterTerm& term, std::vector<std::string>& ids) const
+{
+    std::string min;
+    std::string max;
+    get_order_bounds(term, min, max);
+
+    std::vector<std::string> members;
+    m_db_get_set_between_func(
+        get_secondary_index_order_key(term.m_field), min, max, members);
+    for (const auto& member : members) {
+        ids.push_back(get_id_from_order_member(member));
+    }
+    std::sort(ids.begin(), ids.end());
+    ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+}
+
+void KeyValueReadContext::get_order_bounds(
+    const FilterTerm& term, std::string& min, std::string& max)
 {
-    std::vector<std::vector<std::string>> db_response;
-    m_db_get_sets_func({get_set_key()}, db_response);
+    if (term.m_op == FilterOp::PREFIX) {
+        // Only text values are matched by prefix
+        min = get_sortable_value("") + term.m_value;
+        max = min + '\xff';
+        return;
+    }
+
+    // Numbers are only compared with numbers, and text with text. Members
+    // for a value are the value, a separator below '\x02' and an id. Bounds
+    // for a decimal also span the integers that share its double.
+    const auto value = get_sortable_value(term.m_value);
+    const std::string type_begin(1, value[0]);
+    const std::string type_end(1, static_cast<char>(value[0] + 1));
+    const bool is_inexact  = value[0] == 'n' && value.size() == 17;
+    const auto after_value = value + (is_inexact ? '\xff' : '\x02');
+    switch (term.m_op) {
+        case FilterOp::LESS:
+            min = type_begin;
+            max = value;
+            break;
+        case FilterOp::LESS_EQUAL:
+            min = type_begin;
+            max = after_value;
+            break;
+        case FilterOp::GREATER:
+            min = after_value;
+            max = type_end;
+            break;
+        case FilterOp::GREATER_EQUAL:
+            min = value;
+            max = type_end;
+            break;
+        default:
+            break;
+    }
+}
 
-    if (!db_response.empty()) {
-        for (const auto& id : db_response[0]) {
-            add_item_id(id);
+KeyValueReadContext::FilterTerm KeyValueReadContext::parse_filter_term(
+    const std::string& key, const std::string& value)
+{
+    static const std::vector<std::pair<std::string, FilterOp>> suffixes{
+        {"__prefix", FilterOp::PREFIX},     {"__lt", FilterOp::LESS},
+        {"__lte", FilterOp::LESS_EQUAL},    {"__gt", FilterOp::GREATER},
+        {"__gte", FilterOp::GREATER_EQUAL},
+    };
+
+    for (const auto& [suffix, op] : suffixes) {
+        if (key.size() > suffix.size()
+            && key.compare(key.size() - suffix.size(), suffix.size(), suffix)
+                   == 0) {
+            return {key.substr(0, key.size() - suffix.size()), value, op};
         }
     }
+    return {key, value, FilterOp::EQUAL};
+}
+
+void KeyValueReadContext::serialize_empty(const CrudQuery& query)
+{
+    // Only the ids in the requested page are loaded from the set
+    std::vector<std::string> ids;
+    m_total_count = m_db_get_set_range_func(
+        get_set_key(), query.get_offset(), query.get_page_size(), ids);
+
+    for (const auto& id : ids) {
+        add_item_id(id);
+    }
 }
 
 std::string KeyValueReadContext::get_id_from_name(
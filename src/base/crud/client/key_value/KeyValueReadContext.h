@@ -11,10 +11,17 @@
 namespace hestia {
 class KeyValueReadContext : public KeyValueFieldContext {
   public:
-    using dbGetItemFunc      = std::function<std::string(const std::string&)>;
-    using dbGetSetsFunc      = std::function<void(
-        const std::vector<std::string>&,
-        std::vector<std::vector<std::string>>&)>;
+    using dbGetItemFunc     = std::function<std::string(const std::string&)>;
+    using dbGetSetRangeFunc = std::function<std::size_t(
+        const std::string&, std::size_t, std::size_t,
+        std::vector<std::string>&)>;
+    using dbGetSetBetweenFunc = std::function<void(
+        const std::string&,
+        const std::string&,
+        const std::string&,
+        std::vector<std::string>&)>;
+    using dbSetIntersectFunc = std::function<void(
+        const std::vector<std::string>&, std::vector<std::string>&)>;
     using idFromParentIdFunc = std::function<std::string(
         const std::string&,
         const std::string&,
@@ -25,7 +32,9 @@ class KeyValueReadContext : public KeyValueFieldContext {
         const AdapterCollection* adapters,
         const std::string& key_prefix,
         dbGetItemFunc db_get_item_func,
-        dbGetSetsFunc db_get_sets_func,
+        dbGetSetRangeFunc db_get_set_range_func,
+        dbGetSetBetweenFunc db_get_set_between_func,
+        dbSetIntersectFunc db_set_intersect_func,
         idFromParentIdFunc id_from_parent_id_func);
 
     bool serialize_request(const CrudRequest& request);
@@ -35,6 +44,14 @@ class KeyValueReadContext : public KeyValueFieldContext {
 
     const std::vector<std::string>& get_index_keys() const;
 
+    /**
+     * Total number of items matching the request - for a paged listing this
+     * counts items outside the page too.
+     *
+     * @return Total number of matching items
+     */
+    std::size_t get_total_count() const;
+
     const std::vector<std::string>& get_foreign_key_proxy_keys() const;
 
     void get_foreign_key_query(
@@ -53,6 +70,39 @@ class KeyValueReadContext : public KeyValueFieldContext {
         const Dictionary& foreign_key_dict, Dictionary& read_result) const;
 
   private:
+    enum class FilterOp {
+        EQUAL,
+        PREFIX,
+        LESS,
+        LESS_EQUAL,
+        GREATER,
+        GREATER_EQUAL
+    };
+
+    struct FilterTerm {
+        std::string m_field;
+        std::string m_value;
+        FilterOp m_op{FilterOp::EQUAL};
+    };
+
+    static FilterTerm parse_filter_term(
+        const std::string& key, const std::string& value);
+
+    /**
+     * Get the range of a field's ordered index holding the members that
+     * match a prefix or range filter term
+     *
+     * @param term The filter term
+     * @param min The first member in the range
+     * @param max The member after the range
+     */
+    static void get_order_bounds(
+        const FilterTerm& term, std::string& min, std::string& max);
+
+    void check_filter_term(const FilterTerm& term) const;
+
+    bool is_secondary_index_field(const std::string& field) const;
+
     void add_item_id(const std::string& item_id);
 
     void add_db_item_to_dict(
@@ -78,16 +128,25 @@ class KeyValueReadContext : public KeyValueFieldContext {
 
     bool serialize_filter(const CrudQuery& query);
 
-    void serialize_empty();
+    bool serialize_index_filter(
+        const CrudQuery& query, const std::vector<FilterTerm>& terms);
+
+    void get_ids_in_range(
+        const FilterTerm& term, std::vector<std::string>& ids) const;
+
+    void serialize_empty(const CrudQuery& query);
 
     void update_foreign_proxy_keys(const std::string& item_id);
 
     std::vector<std::string> m_index_keys;
     std::vector<std::string> m_foreign_key_proxy_keys;
     VecKeyValuePair m_foreign_key_proxies;
+    std::size_t m_total_count{0};
 
     dbGetItemFunc m_db_get_item_func;
-    dbGetSetsFunc m_db_get_sets_func;
+    dbGetSetRangeFunc m_db_get_set_range_func;
+    dbGetSetBetweenFunc m_db_get_set_between_func;
+    dbSetIntersectFunc m_db_set_intersect_func;
     idFromParentIdFunc m_id_from_parent_id_func;
 };
 }  // namespace hestia
\ No newline at end of file
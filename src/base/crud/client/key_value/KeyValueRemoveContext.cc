@@ -21,10 +21,32 @@ void KeyValueRemoveContext::serialize_request(const CrudRequest& request)
 }
 
 void KeyValueRemoveContext::prepare_db_query(
+    const std::vector<std::string>& db_items,
     std::vector<KeyValuePair>& db_query) const
 {
     for (const auto& id : m_index_ids) {
         db_query.push_back({get_set_key(), id});
     }
+
+    if (get_secondary_index_fields().empty()) {
+        return;
+    }
+
+    const auto adapter = m_adapters->get_adapter(
+        CrudAttributes::to_string(CrudAttributes::Format::JSON));
+    for (std::size_t idx = 0; idx < db_items.size(); idx++) {
+        Dictionary item_dict;
+        adapter->dict_from_string(db_items[idx], item_dict);
+
+        VecKeyValuePair entries;
+        get_secondary_index_entries(item_dict, entries);
+        for (const auto& [field, value] : entries) {
+            db_query.push_back(
+                {get_secondary_index_key(field, value), m_index_ids[idx]});
+            db_query.push_back(
+                {get_secondary_index_order_key(field),
+                 get_secondary_index_order_member(value, m_index_ids[idx])});
+        }
+    }
 }
 }  // namespace hestia
\ No newline at end of file
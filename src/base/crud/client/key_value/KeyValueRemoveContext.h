@@ -11,7 +11,16 @@ class KeyValueRemoveContext : public KeyValueFieldContext {
 
     void serialize_request(const CrudRequest& request);
 
-    void prepare_db_query(std::vector<KeyValuePair>& db_query) const;
+    /**
+     * Prepare the SET_REMOVE query taking the items out of their type set
+     * and any secondary index sets and ordered indexes.
+     *
+     * @param db_items The items' serialized content as read from the db
+     * @param db_query Filled with the set keys and ids to remove
+     */
+    void prepare_db_query(
+        const std::vector<std::string>& db_items,
+        std::vector<KeyValuePair>& db_query) const;
 
     const std::vector<std::string>& get_index_ids() const
     {
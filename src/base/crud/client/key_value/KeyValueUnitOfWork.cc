@@ -0,0 +1,67 @@
+#include "KeyValueUnitOfWork.h"
+
+#include "KeyValueStoreClient.h"
+#include "RequestException.h"
+
+#include "Logger.h"
+
+namespace hestia {
+
+KeyValueUnitOfWork::KeyValueUnitOfWork(KeyValueStoreClient* client) :
+    m_client(client)
+{
+}
+
+void KeyValueUnitOfWork::add(const KeyValueStoreRequest& request)
+{
+    if (m_requests.empty() || m_requests.back().method() != request.method()) {
+        m_requests.push_back(request);
+        return;
+    }
+
+    // Consecutive writes of the same kind go in one request
+    const auto& last = m_requests.back();
+    if (request.get_kv_pairs().empty()) {
+        auto keys = last.get_keys();
+        keys.insert(
+            keys.end(), request.get_keys().begin(), request.get_keys().end());
+        m_requests.back() =
+            KeyValueStoreRequest(request.method(), keys, request.get_url());
+    }
+    else {
+        auto kv_pairs = last.get_kv_pairs();
+        kv_pairs.insert(
+            kv_pairs.end(), request.get_kv_pairs().begin(),
+            request.get_kv_pairs().end());
+        m_requests.back() =
+            KeyValueStoreRequest(request.method(), kv_pairs, request.get_url());
+    }
+}
+
+void KeyValueUnitOfWork::do_commit()
+{
+    if (m_requests.empty()) {
+        return;
+    }
+
+    const auto response = m_client->make_batch_request(m_requests);
+    m_requests.clear();
+    if (!response->ok()) {
+        const std::string msg = "Error in kv_store batch write: "
+                                + response->get_base_error().to_string();
+        LOG_ERROR(msg);
+        throw RequestException<CrudRequestError>({CrudErrorCode::ERROR, msg});
+    }
+}
+
+bool KeyValueUnitOfWork::empty() const
+{
+    return m_requests.empty();
+}
+
+bool KeyValueUnitOfWork::is_for(const KeyValueStoreClient* client) const
+{
+    return m_client == client;
+}
+
+}  // namespace hestia
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "CrudUnitOfWork.h"
+#include "KeyValueStoreRequest.h"
+
+#include <vector>
+
+namespace hestia {
+
+class KeyValueStoreClient;
+
+/**
+ * @brief A unit of work collecting key-value store writes
+ *
+ * Writes from KeyValueCrudClients sharing the store are queued in order and
+ * sent as a single batch request on commit.
+ */
+class KeyValueUnitOfWork : public CrudUnitOfWork {
+  public:
+    explicit KeyValueUnitOfWork(KeyValueStoreClient* client);
+
+    /**
+     * Queue a write request, merging it with the last queued request if
+     * both have the same method.
+     *
+     * @param request The write request
+     */
+    void add(const KeyValueStoreRequest& request);
+
+    bool empty() const override;
+
+    /**
+     * Return true if the writes are for this store
+     *
+     * @param client The store
+     * @return True if the writes are for this store
+     */
+    bool is_for(const KeyValueStoreClient* client) const;
+
+  protected:
+    void do_commit() override;
+
+  private:
+    KeyValueStoreClient* m_client{nullptr};
+    std::vector<KeyValueStoreRequest> m_requests;
+};
+}  // namespace hestia
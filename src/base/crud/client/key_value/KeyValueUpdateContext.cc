@@ -1,6 +1,9 @@
 #include "KeyValueUpdateContext.h"
 
 #include "Logger.h"
+
+#include <algorithm>
+#include <cassert>
 #include <iostream>
 
 namespace hestia {
@@ -126,6 +129,127 @@ void KeyValueUpdateContext::prepare_db_query(
     prepare_query_keys(updated_content, db_query);
 }
 
+void KeyValueUpdateContext::get_secondary_index_entries(
+    const VecModelPtr& db_items, std::vector<VecKeyValuePair>& entries) const
+{
+    if (get_secondary_index_fields().empty()) {
+        return;
+    }
+
+    for (const auto& db_item : db_items) {
+        Dictionary item_dict;
+        db_item->serialize(item_dict);
+
+        VecKeyValuePair item_entries;
+        KeyValueFieldContext::get_secondary_index_entries(
+            item_dict, item_entries);
+        entries.push_back(item_entries);
+    }
+}
+
+void KeyValueUpdateContext::prepare_index_query(
+    const std::vector<VecKeyValuePair>& previous_entries,
+    const Dictionary& updated_content,
+    std::vector<KeyValuePair>& set_add_query,
+    std::vector<KeyValuePair>& set_remove_query) const
+{
+    if (previous_entries.empty()) {
+        return;
+    }
+
+    std::vector<const Dictionary*> updated_items;
+    if (updated_content.get_type() == Dictionary::Type::SEQUENCE) {
+        for (const auto& dict_item : updated_content.get_sequence()) {
+            updated_items.push_back(dict_item.get());
+        }
+    }
+    else {
+        updated_items.push_back(&updated_content);
+    }
+    assert(updated_items.size() == previous_entries.size());
+
+    for (std::size_t idx = 0; idx < updated_items.size(); idx++) {
+        const auto& id = m_index_ids[idx];
+
+        VecKeyValuePair entries;
+        KeyValueFieldContext::get_secondary_index_entries(
+            *updated_items[idx], entries);
+
+        // Only touch the index sets for values the update changed
+        for (const auto& previous : previous_entries[idx]) {
+            if (std::find(entries.begin(), entries.end(), previous)
+                == entries.end()) {
+                set_remove_query.emplace_back(
+                    get_secondary_index_key(previous.first, previous.second),
+                    id);
+                set_remove_query.emplace_back(
+                    get_secondary_index_order_key(previous.first),
+                    get_secondary_index_order_member(previous.second, id));
+            }
+        }
+        for (const auto& entry : entries) {
+            if (std::find(
+                    previous_entries[idx].begin(), previous_entries[idx].end(),
+                    entry)
+                == previous_entries[idx].end()) {
+                set_add_query.emplace_back(
+                    get_secondary_index_key(entry.first, entry.second), id);
+                set_add_query.emplace_back(
+                    get_secondary_index_order_key(entry.first),
+                    get_secondary_index_order_member(entry.second, id));
+            }
+        }
+    }
+}
+
+void KeyValueUpdateContext::get_unique_index_keys(
+    const VecModelPtr& db_items,
+    std::vector<std::vector<std::string>>& keys) const
+{
+    for (const auto& db_item : db_items) {
+        SerializeableWithFields::VecIndexField index;
+        db_item->get_index_fields(index);
+
+        std::vector<std::string> item_keys;
+        for (const auto& index_field : index) {
+            const auto parent_id =
+                index_field.m_scope == BaseField::IndexScope::GLOBAL ?
+                    std::string() :
+                    db_item->get_parent_id();
+            item_keys.push_back(get_index_field_key(index_field, parent_id));
+        }
+        keys.push_back(item_keys);
+    }
+}
+
+void KeyValueUpdateContext::prepare_unique_index_query(
+    const std::vector<std::vector<std::string>>& previous_keys,
+    const VecModelPtr& db_items,
+    std::vector<KeyValuePair>& string_set_query,
+    std::vector<KeyValuePair>& stale_keys) const
+{
+    std::vector<std::vector<std::string>> keys;
+    get_unique_index_keys(db_items, keys);
+    assert(keys.size() == previous_keys.size());
+
+    for (std::size_t idx = 0; idx < keys.size(); idx++) {
+        const auto& id = m_index_ids[idx];
+        for (const auto& key : keys[idx]) {
+            if (std::find(
+                    previous_keys[idx].begin(), previous_keys[idx].end(), key)
+                == previous_keys[idx].end()) {
+                string_set_query.emplace_back(key, id);
+            }
+        }
+        for (const auto& key : previous_keys[idx]) {
+            if (std::find(keys[idx].begin(), keys[idx].end(), key)
+                == keys[idx].end()) {
+                stale_keys.emplace_back(key, id);
+            }
+        }
+    }
+}
+
 void KeyValueUpdateContext::prepare_query_keys(
     const Dictionary& updated_content,
     std::vector<KeyValuePair>& db_query) const
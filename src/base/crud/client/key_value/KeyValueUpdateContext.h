@@ -30,6 +30,59 @@ class KeyValueUpdateContext : public KeyValueFieldContext {
         Dictionary& updated_content,
         std::vector<KeyValuePair>& db_query) const;
 
+    /**
+     * Record the secondary index entries of the items as stored, before the
+     * update is applied.
+     *
+     * @param db_items The items as read from the db
+     * @param entries Filled with the index entries for each item
+     */
+    void get_secondary_index_entries(
+        const VecModelPtr& db_items,
+        std::vector<VecKeyValuePair>& entries) const;
+
+    /**
+     * Prepare db queries moving each item between secondary index sets, and
+     * its member of the field's ordered index, for any indexed field the
+     * update changed.
+     *
+     * @param previous_entries The index entries from before the update
+     * @param updated_content The updated items
+     * @param set_add_query Filled with the index set entries to add
+     * @param set_remove_query Filled with the index set entries to remove
+     */
+    void prepare_index_query(
+        const std::vector<VecKeyValuePair>& previous_entries,
+        const Dictionary& updated_content,
+        std::vector<KeyValuePair>& set_add_query,
+        std::vector<KeyValuePair>& set_remove_query) const;
+
+    /**
+     * Get the keys mapping each item's uniquely indexed fields, e.g. its name,
+     * to its id.
+     *
+     * @param db_items The items
+     * @param keys Filled with the keys for each item
+     */
+    void get_unique_index_keys(
+        const VecModelPtr& db_items,
+        std::vector<std::vector<std::string>>& keys) const;
+
+    /**
+     * Prepare db queries moving the unique index keys of any item whose
+     * indexed fields the update changed, e.g. on a rename.
+     *
+     * @param previous_keys The index keys from before the update
+     * @param db_items The updated items
+     * @param string_set_query Filled with the new keys for each item id
+     * @param stale_keys Filled with the keys no longer used and their item id
+     */
+    void prepare_unique_index_query(
+        const std::vector<std::vector<std::string>>& previous_keys,
+        const VecModelPtr& db_items,
+        std::vector<KeyValuePair>& string_set_query,
+        std::vector<KeyValuePair>& stale_keys) const;
+
     const std::vector<std::string>& get_index_ids() const
     {
         return m_index_ids;
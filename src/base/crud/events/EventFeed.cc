@@ -33,8 +33,13 @@ EventFeedConfig& EventFeedConfig::operator=(const EventFeedConfig& other)
 {
     if (this != &other) {
         SerializeableWithFields::operator=(other);
-        m_output_path = other.m_output_path;
-        m_active      = other.m_active;
+        m_output_path     = other.m_output_path;
+        m_active          = other.m_active;
+        m_max_queue_size  = other.m_max_queue_size;
+        m_flush_interval  = other.m_flush_interval;
+        m_fsync_interval  = other.m_fsync_interval;
+        m_rotate_size     = other.m_rotate_size;
+        m_rotate_interval = other.m_rotate_interval;
         init();
     }
     return *this;
@@ -44,6 +49,11 @@ void EventFeedConfig::init()
 {
     register_scalar_field(&m_output_path);
     register_scalar_field(&m_active);
+    register_scalar_field(&m_max_queue_size);
+    register_scalar_field(&m_flush_interval);
+    register_scalar_field(&m_fsync_interval);
+    register_scalar_field(&m_rotate_size);
+    register_scalar_field(&m_rotate_interval);
 }
 
 bool EventFeedConfig::is_active() const
@@ -61,6 +71,31 @@ const std::string& EventFeedConfig::get_output_path() const
     return m_output_path.get_value();
 }
 
+std::size_t EventFeedConfig::get_max_queue_size() const
+{
+    return m_max_queue_size.get_value();
+}
+
+std::size_t EventFeedConfig::get_flush_interval() const
+{
+    return m_flush_interval.get_value();
+}
+
+std::size_t EventFeedConfig::get_fsync_interval() const
+{
+    return m_fsync_interval.get_value();
+}
+
+std::size_t EventFeedConfig::get_rotate_size() const
+{
+    return m_rotate_size.get_value();
+}
+
+std::size_t EventFeedConfig::get_rotate_interval() const
+{
+    return m_rotate_interval.get_value();
+}
+
 void EventFeed::initialize(const EventFeedConfig& config)
 {
     m_config = config;
@@ -20,6 +20,21 @@ class EventFeedConfig : public SerializeableWithFields {
 
     const std::string& get_output_path() const;
 
+    /// @brief Most events held for the writer - more are dropped
+    std::size_t get_max_queue_size() const;
+
+    /// @brief Longest an event waits before being written, in milliseconds
+    std::size_t get_flush_interval() const;
+
+    /// @brief Written batches between fsyncs, 0 to leave it to the OS
+    std::size_t get_fsync_interval() const;
+
+    /// @brief Size in bytes at which the feed file is rotated, 0 for never
+    std::size_t get_rotate_size() const;
+
+    /// @brief Age in seconds at which the feed file is rotated, 0 for never
+    std::size_t get_rotate_interval() const;
+
     EventFeedConfig& operator=(const EventFeedConfig& other);
 
   private:
@@ -28,6 +43,11 @@ class EventFeedConfig : public SerializeableWithFields {
     static constexpr const char s_type[]{"event_feed"};
     StringField m_output_path{"output_path", "event_feed.yaml"};
     BooleanField m_active{"active", true};
+    UIntegerField m_max_queue_size{"max_queue_size", 65536};
+    UIntegerField m_flush_interval{"flush_interval", 100};
+    UIntegerField m_fsync_interval{"fsync_interval", 0};
+    UIntegerField m_rotate_size{"rotate_size", 0};
+    UIntegerField m_rotate_interval{"rotate_interval", 0};
 };
 
 /// Class for logging filesystem events to librobinhood-compatible YAML
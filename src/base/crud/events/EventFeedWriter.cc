@@ -0,0 +1,254 @@
+#include "EventFeedWriter.h"
+
+#include "ErrorUtils.h"
+#include "Logger.h"
+#include "TimeUtils.h"
+#include "YamlUtils.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace hestia {
+
+EventFeedWriter::EventFeedWriter(
+    const std::filesystem::path& path, const EventFeedConfig& config) :
+    m_path(path),
+    m_max_queue_size(config.get_max_queue_size()),
+    m_flush_interval(std::max<std::size_t>(1, config.get_flush_interval())),
+    m_fsync_interval(config.get_fsync_interval()),
+    m_rotate_size(config.get_rotate_size()),
+    m_rotate_interval(config.get_rotate_interval())
+{
+    m_thread = std::thread([this]() { run(); });
+}
+
+EventFeedWriter::~EventFeedWriter()
+{
+    {
+        std::scoped_lock guard(m_mutex);
+        m_stop = true;
+    }
+    m_wake_cv.notify_all();
+    m_thread.join();
+}
+
+bool EventFeedWriter::push(Dictionary::Ptr event)
+{
+    const auto depth = m_queue_depth.fetch_add(1);
+    if (depth >= m_max_queue_size) {
+        m_queue_depth--;
+        if (const auto dropped = ++m_num_dropped; dropped % 1000 == 1) {
+            LOG_WARN(
+                "Event feed queue full - dropped " << dropped << " events");
+        }
+        return false;
+    }
+
+    auto node     = new Node;
+    node->m_event = std::move(event);
+    node->m_next  = m_head.load(std::memory_order_relaxed);
+    while (!m_head.compare_exchange_weak(
+        node->m_next, node, std::memory_order_release,
+        std::memory_order_relaxed)) {
+    }
+    m_num_accepted++;
+
+    if (depth + 1 == s_batch_size) {
+        // Taking the lock means the writer can't miss the wakeup
+        std::scoped_lock guard(m_mutex);
+        m_wake_cv.notify_one();
+    }
+    return true;
+}
+
+void EventFeedWriter::flush()
+{
+    std::unique_lock guard(m_mutex);
+    const std::size_t target = m_num_accepted;
+    m_flush_requested        = true;
+    m_wake_cv.notify_one();
+    m_flushed_cv.wait(guard, [this, target]() {
+        return m_num_processed >= target || m_stop;
+    });
+}
+
+void EventFeedWriter::run()
+{
+    while (true) {
+        bool stopping{false};
+        {
+            std::unique_lock guard(m_mutex);
+            m_wake_cv.wait_for(guard, m_flush_interval, [this]() {
+                return m_stop || m_flush_requested
+                       || m_queue_depth >= s_batch_size;
+            });
+            stopping          = m_stop;
+            m_flush_requested = false;
+        }
+
+        write_batch();
+        if (stopping) {
+            break;
+        }
+    }
+    close();
+}
+
+void EventFeedWriter::write_batch()
+{
+    // The list comes newest first
+    Node* ordered{nullptr};
+    auto node = m_head.exchange(nullptr, std::memory_order_acquire);
+    while (node != nullptr) {
+        const auto next = node->m_next;
+        node->m_next    = ordered;
+        ordered         = node;
+        node            = next;
+    }
+
+    std::string buffer;
+    std::size_t count{0};
+    std::size_t num_serialized{0};
+    while (ordered != nullptr) {
+        const auto next = ordered->m_next;
+        try {
+            YamlUtils::dict_to_yaml(*ordered->m_event, buffer);
+            num_serialized++;
+        }
+        catch (const std::exception& e) {
+            LOG_ERROR("Failed to serialize event: " << e.what());
+            m_num_dropped++;
+        }
+        delete ordered;
+        ordered = next;
+        count++;
+    }
+
+    if (count > 0) {
+        m_queue_depth -= count;
+    }
+
+    try {
+        if (!buffer.empty()) {
+            open();
+            if (needs_rotation(buffer.size())) {
+                rotate();
+                open();
+            }
+            write_all(buffer);
+            m_num_written += num_serialized;
+
+            m_unsynced_batches++;
+            if (m_fsync_interval > 0
+                && m_unsynced_batches >= m_fsync_interval) {
+                ::fsync(m_fd);
+                m_unsynced_batches = 0;
+            }
+        }
+    }
+    catch (const std::exception& e) {
+        LOG_ERROR("Dropping " << num_serialized << " events: " << e.what());
+        m_num_dropped += num_serialized;
+    }
+
+    {
+        std::scoped_lock guard(m_mutex);
+        m_num_processed += count;
+    }
+    m_flushed_cv.notify_all();
+}
+
+bool EventFeedWriter::needs_rotation(std::size_t batch_size) const
+{
+    if (m_size == 0) {
+        return false;
+    }
+    if (m_rotate_size > 0 && m_size + batch_size > m_rotate_size) {
+        return true;
+    }
+    return m_rotate_interval.count() > 0
+           && std::chrono::steady_clock::now() - m_opened_at
+                  >= m_rotate_interval;
+}
+
+void EventFeedWriter::rotate()
+{
+    close();
+
+    const auto base_path =
+        m_path.string() + "." + TimeUtils::get_current_time_iso8601_basic();
+    auto rotated_path = base_path;
+    for (std::size_t idx = 1; std::filesystem::exists(rotated_path); idx++) {
+        rotated_path = base_path + "." + std::to_string(idx);
+    }
+    std::filesystem::rename(m_path, rotated_path);
+    LOG_INFO("Rotated event feed to: " << rotated_path);
+}
+
+void EventFeedWriter::open()
+{
+    if (m_fd != -1) {
+        return;
+    }
+
+    if (m_path.has_parent_path()) {
+        std::filesystem::create_directories(m_path.parent_path());
+    }
+
+    errno = 0;
+    m_fd  = ::open(m_path.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+    if (m_fd == -1) {
+        const std::string msg = "Failed to open event feed at: "
+                                + m_path.string() + " | "
+                                + ::strerror(errno);
+        LOG_ERROR(msg);
+        THROW_WITH_SOURCE_LOC(msg);
+    }
+
+    struct stat file_stat;
+    m_size = ::fstat(m_fd, &file_stat) == 0 ?
+                 static_cast<std::size_t>(file_stat.st_size) :
+                 0;
+    m_opened_at = std::chrono::steady_clock::now();
+}
+
+void EventFeedWriter::close()
+{
+    if (m_fd == -1) {
+        return;
+    }
+    if (m_unsynced_batches > 0) {
+        ::fsync(m_fd);
+        m_unsynced_batches = 0;
+    }
+    ::close(m_fd);
+    m_fd   = -1;
+    m_size = 0;
+}
+
+void EventFeedWriter::write_all(const std::string& buffer)
+{
+    std::size_t written{0};
+    while (written < buffer.size()) {
+        errno            = 0;
+        const auto count = ::write(
+            m_fd, buffer.data() + written, buffer.size() - written);
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            const std::string msg = "Failed to write to event feed at: "
+                                    + m_path.string() + " | "
+                                    + ::strerror(errno);
+            THROW_WITH_SOURCE_LOC(msg);
+        }
+        written += static_cast<std::size_t>(count);
+    }
+    m_size += buffer.size();
+}
+
+}  // namespace hestia
@@ -0,0 +1,125 @@
+#pragma once
+
+#include "Dictionary.h"
+#include "EventFeed.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <mutex>
+#include <thread>
+
+namespace hestia {
+
+/**
+ * @brief Writes event feed entries to file off the request path
+ *
+ * Events are pushed onto a lock-free queue and serialized to YAML and
+ * appended to the feed file by a background thread. Everything queued when
+ * the thread wakes goes out in a single write (group commit), fsync-ed
+ * every 'fsync_interval' batches.
+ *
+ * The thread wakes every 'flush_interval' milliseconds, or sooner once a
+ * batch worth of events is queued. Events pushed while 'max_queue_size' are
+ * already waiting are dropped and counted.
+ *
+ * Once it reaches 'rotate_size' bytes or 'rotate_interval' seconds of age
+ * the feed file is renamed with a timestamp suffix and a new one started.
+ */
+class EventFeedWriter {
+  public:
+    /**
+     * Constructor - starts the writer thread
+     *
+     * @param path Path to the feed file - appended to if it exists
+     * @param config Queue, sync and rotation settings
+     */
+    EventFeedWriter(
+        const std::filesystem::path& path, const EventFeedConfig& config);
+
+    /**
+     * Destructor - writes out anything still queued
+     */
+    ~EventFeedWriter();
+
+    /**
+     * Queue an event for writing. Safe to call from any thread.
+     *
+     * @param event The event - a YAML document once serialized
+     * @return False if the queue is full and the event was dropped
+     */
+    bool push(Dictionary::Ptr event);
+
+    /**
+     * Block until every event pushed so far has been written out
+     */
+    void flush();
+
+    /**
+     * Number of events waiting to be written
+     */
+    std::size_t get_queue_depth() const { return m_queue_depth; }
+
+    /**
+     * Number of events lost, to a full queue or a failed write
+     */
+    std::size_t get_num_dropped() const { return m_num_dropped; }
+
+    /**
+     * Number of events written out
+     */
+    std::size_t get_num_written() const { return m_num_written; }
+
+  private:
+    struct Node {
+        Dictionary::Ptr m_event;
+        Node* m_next{nullptr};
+    };
+
+    void run();
+
+    void write_batch();
+
+    void write_all(const std::string& buffer);
+
+    void open();
+
+    void close();
+
+    void rotate();
+
+    bool needs_rotation(std::size_t batch_size) const;
+
+    static constexpr std::size_t s_batch_size{256};
+
+    std::filesystem::path m_path;
+    std::size_t m_max_queue_size{0};
+    std::chrono::milliseconds m_flush_interval;
+    std::size_t m_fsync_interval{0};
+    std::size_t m_rotate_size{0};
+    std::chrono::seconds m_rotate_interval;
+
+    // Producers push onto the head, the writer takes the whole list
+    std::atomic<Node*> m_head{nullptr};
+    std::atomic<std::size_t> m_queue_depth{0};
+    std::atomic<std::size_t> m_num_dropped{0};
+    std::atomic<std::size_t> m_num_written{0};
+    std::atomic<std::size_t> m_num_accepted{0};
+
+    std::mutex m_mutex;
+    std::condition_variable m_wake_cv;
+    std::condition_variable m_flushed_cv;
+    std::size_t m_num_processed{0};
+    bool m_flush_requested{false};
+    bool m_stop{false};
+
+    // Only touched by the writer thread
+    int m_fd{-1};
+    std::size_t m_size{0};
+    std::size_t m_unsynced_batches{0};
+    std::chrono::steady_clock::time_point m_opened_at;
+
+    std::thread m_thread;
+};
+}  // namespace hestia
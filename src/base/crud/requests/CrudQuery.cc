@@ -1,4 +1,6 @@
 #include "CrudQuery.h"
+
+#include <algorithm>
 #include <stdexcept>
 
 namespace hestia {
@@ -113,6 +115,26 @@ std::size_t CrudQuery::get_offset() const
     return m_offset;
 }
 
+std::size_t CrudQuery::get_count() const
+{
+    return m_count;
+}
+
+std::size_t CrudQuery::get_page_size() const
+{
+    return m_count == 0 ? 0 : std::min(m_count, m_max_items);
+}
+
+std::size_t CrudQuery::get_total_count() const
+{
+    return m_total_count;
+}
+
+bool CrudQuery::is_paged() const
+{
+    return m_offset > 0 || m_count > 0;
+}
+
 bool CrudQuery::is_filter() const
 {
     return m_format == Format::GET || m_format == Format::LIST;
@@ -179,6 +201,16 @@ void CrudQuery::set_count(std::size_t count)
     m_count = count;
 }
 
+void CrudQuery::set_max_items(std::size_t max_items)
+{
+    m_max_items = max_items;
+}
+
+void CrudQuery::set_total_count(std::size_t count)
+{
+    m_total_count = count;
+}
+
 const CrudAttributes& CrudQuery::get_attributes() const
 {
     return m_attributes;
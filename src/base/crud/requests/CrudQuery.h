@@ -71,6 +71,25 @@ class CrudQuery {
 
     std::size_t get_offset() const;
 
+    std::size_t get_count() const;
+
+    /**
+     * The number of items requested for a page of a listing, capped at the
+     * query's max items, or 0 if no limit was requested.
+     *
+     * @return The page size
+     */
+    std::size_t get_page_size() const;
+
+    /**
+     * Total number of items matching the query, set once it has been run.
+     *
+     * @return The total number of matching items
+     */
+    std::size_t get_total_count() const;
+
+    bool is_paged() const;
+
     bool has_single_id() const;
 
     bool is_filter() const;
@@ -91,18 +110,32 @@ class CrudQuery {
 
     void set_ids(const VecCrudIdentifier& ids);
 
+    /**
+     * Set the filter as a map of field names to values. All entries must
+     * match. A single name-like entry is looked up on the field's unique
+     * index, otherwise fields must be secondary indices. A field name can
+     * take a suffix to change the match: '__prefix', '__lt', '__lte', '__gt'
+     * or '__gte', with numeric values compared as numbers.
+     *
+     * @param filter The filter
+     */
     void set_filter(const Map& filter);
 
     void set_offset(std::size_t offset);
 
     void set_count(std::size_t count);
 
+    void set_max_items(std::size_t max_items);
+
+    void set_total_count(std::size_t count);
+
   private:
     CrudAttributes m_attributes;
 
     std::size_t m_max_items{1000};
     std::size_t m_offset{0};
     std::size_t m_count{0};
+    std::size_t m_total_count{0};
 
     Format m_format{Format::LIST};
     OutputFormat m_output_format{OutputFormat::ATTRIBUTES};
@@ -69,6 +69,16 @@ std::string CrudRequest::method_as_string() const
     }
 }
 
+void CrudRequest::set_unit_of_work(CrudUnitOfWork* unit_of_work)
+{
+    m_unit_of_work = unit_of_work;
+}
+
+CrudUnitOfWork* CrudRequest::get_unit_of_work() const
+{
+    return m_unit_of_work;
+}
+
 bool CrudRequest::has_items() const
 {
     return !m_items.empty();
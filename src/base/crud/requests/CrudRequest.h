@@ -4,6 +4,7 @@
 #include "Model.h"
 
 namespace hestia {
+class CrudUnitOfWork;
 
 class CrudRequest : public BaseCrudRequest, public MethodRequest<CrudMethod> {
   public:
@@ -50,8 +51,19 @@ class CrudRequest : public BaseCrudRequest, public MethodRequest<CrudMethod> {
 
     bool should_update_event_feed() const { return m_update_event_feed; }
 
+    /**
+     * Collect the request's writes in this unit of work instead of applying
+     * them immediately. The unit must outlive the request.
+     *
+     * @param unit_of_work The unit of work, or null to apply writes immediately
+     */
+    void set_unit_of_work(CrudUnitOfWork* unit_of_work);
+
+    CrudUnitOfWork* get_unit_of_work() const;
+
   protected:
     bool m_update_event_feed{true};
+    CrudUnitOfWork* m_unit_of_work{nullptr};
     VecModelPtr m_items;
 };
 }  // namespace hestia
\ No newline at end of file
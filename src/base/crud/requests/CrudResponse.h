@@ -51,6 +51,16 @@ class CrudResponse : public Response<CrudErrorCode> {
 
     bool found() const;
 
+    /**
+     * Total number of items matching a read query - for a paged listing this
+     * is the size of the full listing rather than the page.
+     *
+     * @return Total number of matching items
+     */
+    std::size_t get_total_count() const { return m_total_count; }
+
+    void set_total_count(std::size_t count) { m_total_count = count; }
+
     void set_item(std::unique_ptr<Model> item);
 
     void set_dict(std::unique_ptr<Dictionary> dict);
@@ -70,6 +80,7 @@ class CrudResponse : public Response<CrudErrorCode> {
     std::vector<Map> m_modified_attrs;
 
     bool m_locked{false};
+    std::size_t m_total_count{0};
     std::string m_type;
 
   protected:
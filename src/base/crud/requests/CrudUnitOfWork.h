@@ -0,0 +1,68 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace hestia {
+
+/**
+ * @brief A group of CRUD writes applied to the backend together
+ *
+ * Requests made with a unit of work attached (see
+ * CrudRequest::set_unit_of_work) have their writes collected rather than
+ * applied, and 'commit' applies them all at once. Reads are never deferred,
+ * so a request can't read back a write made earlier in the same unit.
+ *
+ * Units are made by the CrudService and only apply to services sharing its
+ * backend. Backends that can't batch writes don't make units, in which case
+ * requests are applied immediately as usual.
+ *
+ * Work that depends on the writes being visible, such as event feed
+ * notifications, is held back with 'on_commit' until they are applied.
+ */
+class CrudUnitOfWork {
+  public:
+    using Ptr = std::unique_ptr<CrudUnitOfWork>;
+
+    virtual ~CrudUnitOfWork() = default;
+
+    /**
+     * Apply the collected writes, atomically if the backend supports it, and
+     * then run any 'on_commit' callbacks. Throws if the writes can't be
+     * applied, in which case the callbacks are dropped.
+     */
+    void commit()
+    {
+        auto callbacks = std::move(m_on_commit);
+        m_on_commit.clear();
+        do_commit();
+        for (const auto& callback : callbacks) {
+            callback();
+        }
+    }
+
+    /**
+     * Register a function to be called once the writes are applied
+     *
+     * @param func The function to call after a successful commit
+     */
+    void on_commit(std::function<void()> func)
+    {
+        m_on_commit.push_back(std::move(func));
+    }
+
+    /**
+     * Return true if no writes have been collected
+     *
+     * @return True if no writes have been collected
+     */
+    virtual bool empty() const = 0;
+
+  protected:
+    virtual void do_commit() = 0;
+
+  private:
+    std::vector<std::function<void()>> m_on_commit;
+};
+}  // namespace hestia
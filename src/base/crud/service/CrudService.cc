@@ -124,8 +124,19 @@ CrudService::~CrudService() {}
                              << ", Method: " << request.method_as_string());
 
     if (m_event_feed != nullptr && request.should_update_event_feed()) {
-        m_event_feed->on_event(
-            CrudEvent(get_type(), request.method(), request, *response));
+        if (auto unit_of_work = request.get_unit_of_work();
+            unit_of_work != nullptr && request.method() != CrudMethod::READ) {
+            // Listeners may read the item back, so wait for the write
+            auto event = std::make_shared<CrudEvent>(
+                get_type(), request.method(), request, *response);
+            auto event_feed = m_event_feed;
+            unit_of_work->on_commit(
+                [event_feed, event]() { event_feed->on_event(*event); });
+        }
+        else {
+            m_event_feed->on_event(
+                CrudEvent(get_type(), request.method(), request, *response));
+        }
     }
 
     return response;
@@ -185,6 +196,14 @@ bool CrudService::is_locked(
     return m_client->is_locked(id, lock_type);
 }
 
+CrudUnitOfWork::Ptr CrudService::create_unit_of_work() const
+{
+    if (m_client == nullptr) {
+        return nullptr;
+    }
+    return m_client->create_unit_of_work();
+}
+
 std::string CrudService::get_type() const
 {
     return m_client->get_type();
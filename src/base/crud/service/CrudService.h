@@ -1,6 +1,7 @@
 #pragma once
 
 #include "CrudResponse.h"
+#include "CrudUnitOfWork.h"
 #include "Model.h"
 #include "Service.h"
 
@@ -32,6 +33,14 @@ class CrudService : public Service<CrudRequest, CrudResponse, CrudErrorCode> {
         const CrudRequest& request,
         const std::string& type = {}) const noexcept override;
 
+    /**
+     * Create a unit of work to collect writes from requests to this service,
+     * and others sharing its backend, so they can be applied together.
+     *
+     * @return The unit of work, or null if the backend can't batch writes
+     */
+    CrudUnitOfWork::Ptr create_unit_of_work() const;
+
     void register_parent_service(const std::string& type, CrudService* service);
 
     void register_child_service(const std::string& type, CrudService* service);
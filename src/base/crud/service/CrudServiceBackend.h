@@ -5,6 +5,8 @@
 
 namespace hestia {
 
+class CrudCache;
+
 class CrudServiceBackend {
   public:
     enum class Type { HTTP_REST, KEY_VALUE_STORE, RELATIONAL_DATABASE };
@@ -17,12 +19,14 @@ class CrudServiceBackend {
 
 class KeyValueStoreCrudServiceBackend : public CrudServiceBackend {
   public:
-    KeyValueStoreCrudServiceBackend(KeyValueStoreClient* client) :
-        m_client(client)
+    KeyValueStoreCrudServiceBackend(
+        KeyValueStoreClient* client, CrudCache* cache = nullptr) :
+        m_client(client), m_cache(cache)
     {
         m_type = Type::KEY_VALUE_STORE;
     }
     KeyValueStoreClient* m_client{nullptr};
+    CrudCache* m_cache{nullptr};
 };
 
 class HttpRestCrudServiceBackend : public CrudServiceBackend {
@@ -61,7 +61,8 @@ class CrudServiceFactory {
             }
             crud_client = std::make_unique<KeyValueCrudClient>(
                 crud_client_config, std::move(adapter_collection),
-                kv_backend->m_client, id_generator.get());
+                kv_backend->m_client, id_generator.get(), nullptr,
+                kv_backend->m_cache);
         }
         else if (backend->get_type() == CrudServiceBackend::Type::HTTP_REST) {
             auto http_backend =
@@ -1,24 +1,99 @@
 #include "CurlClient.h"
 
 #include "ErrorUtils.h"
+#include "HashUtils.h"
 #include "Logger.h"
 
+#include <algorithm>
+#include <cstring>
 #include <stdexcept>
+#include <vector>
 
 namespace hestia {
 
-CurlClient::CurlClient(const CurlClientConfig& config) : m_config(config) {}
+class CurlHandlePool {
+  public:
+    CurlHandlePool(std::size_t max_idle) : m_max_idle(max_idle) {}
+
+    std::unique_ptr<CurlHandle> acquire()
+    {
+        {
+            std::scoped_lock guard(m_mutex);
+            if (!m_idle.empty()) {
+                auto handle = std::move(m_idle.back());
+                m_idle.pop_back();
+                return handle;
+            }
+        }
+        return std::make_unique<CurlHandle>();
+    }
+
+    void release(std::unique_ptr<CurlHandle> handle)
+    {
+        try {
+            handle->reset();
+        }
+        catch (const std::exception& e) {
+            LOG_ERROR("Dropping curl handle after failed reset: " << e.what());
+            return;
+        }
+
+        std::scoped_lock guard(m_mutex);
+        if (m_idle.size() < m_max_idle) {
+            m_idle.push_back(std::move(handle));
+        }
+    }
+
+    std::size_t size() const
+    {
+        std::scoped_lock guard(m_mutex);
+        return m_idle.size();
+    }
+
+  private:
+    std::size_t m_max_idle{0};
+    std::vector<std::unique_ptr<CurlHandle>> m_idle;
+    mutable std::mutex m_mutex;
+};
+
+class CurlHandleLease {
+  public:
+    CurlHandleLease(CurlHandlePool* pool) :
+        m_pool(pool), m_handle(pool->acquire())
+    {
+    }
+
+    ~CurlHandleLease() { m_pool->release(std::move(m_handle)); }
+
+    CurlHandle* get() const { return m_handle.get(); }
+
+  private:
+    CurlHandlePool* m_pool{nullptr};
+    std::unique_ptr<CurlHandle> m_handle;
+};
+
+CurlClient::CurlClient(const CurlClientConfig& config) :
+    m_config(config),
+    m_handles(std::make_unique<CurlHandlePool>(config.m_max_idle_handles))
+{
+}
 
 CurlClient::~CurlClient()
 {
     LOG_INFO("Shutting Down");
-    if (m_config.m_do_global_init) {
+    m_handles.reset();
+    if (m_config.m_do_global_init && m_initialized) {
         curl_global_cleanup();
     }
 }
 
 void CurlClient::initialize()
 {
+    std::scoped_lock guard(m_init_mutex);
+    if (m_initialized) {
+        return;
+    }
+
     LOG_INFO("Initializing curl");
     if (m_config.m_do_global_init) {
         auto rc = curl_global_init(CURL_GLOBAL_DEFAULT);
@@ -30,121 +105,120 @@ void CurlClient::initialize()
     LOG_INFO("Curl intialized");
 }
 
+std::size_t CurlClient::get_num_idle_handles() const
+{
+    return m_handles->size();
+}
+
 size_t CurlClient::curl_write_data(
-    void* buffer, size_t, size_t nmemb, void* userp)
+    void* buffer, size_t size, size_t nmemb, void* userp)
 {
-    LOG_INFO("Callback fired: ");
     if (userp == nullptr) {
         return 0;
     }
 
-    auto client = reinterpret_cast<CurlClient*>(userp);
-    return client->on_write(buffer, nmemb);
+    auto handle = reinterpret_cast<CurlHandle*>(userp);
+    return on_write(handle->m_request_context, buffer, size * nmemb);
 }
 
-size_t CurlClient::on_write(void* buffer, size_t nmemb)
+size_t CurlClient::on_write(
+    CurlRequestContext& context, void* buffer, size_t length)
 {
-    auto handle        = m_handles[std::this_thread::get_id()];
-    size_t num_written = nmemb;
+    size_t num_written = length;
 
-    if (handle->m_request_context.m_stream != nullptr
-        && handle->m_request_context.m_stream->waiting_for_content()) {
-        ReadableBufferView buffer_view(const_cast<void*>(buffer), nmemb);
-        auto result = handle->m_request_context.m_stream->write(buffer_view);
+    if (context.m_stream != nullptr
+        && context.m_stream->waiting_for_content()) {
+        ReadableBufferView buffer_view(buffer, length);
+        auto result = context.m_stream->write(buffer_view);
         if (!result.ok()) {
             LOG_ERROR("Error populating stream");
         }
         num_written = result.m_num_transferred;
     }
     else {
-        auto char_buf = reinterpret_cast<char*>(buffer);
-        std::vector<char> body(nmemb, 0);
-        for (std::size_t idx = 0; idx < nmemb; idx++) {
-            body[idx] = char_buf[idx];
-        }
-        handle->m_request_context.m_response->append_to_body(
-            {body.begin(), body.end()});
+        context.m_response->append_to_body(
+            std::string(reinterpret_cast<const char*>(buffer), length));
     }
-
-    LOG_INFO("Got response with size: " << nmemb);
     return num_written;
 }
 
 size_t CurlClient::curl_read_data(
-    char* buffer, size_t, size_t nmemb, void* userp)
+    char* buffer, size_t size, size_t nmemb, void* userp)
 {
-    LOG_INFO("Callback fired with size: " << nmemb);
     if (userp == nullptr) {
         return 0;
     }
 
-    auto client = reinterpret_cast<CurlClient*>(userp);
-    return client->on_read(buffer, nmemb);
+    auto handle = reinterpret_cast<CurlHandle*>(userp);
+    return on_read(handle->m_request_context, buffer, size * nmemb);
 }
 
-size_t CurlClient::on_read(char* buffer, size_t nmemb)
+size_t CurlClient::on_read(
+    CurlRequestContext& context, char* buffer, size_t length)
 {
-    auto handle      = m_handles[std::this_thread::get_id()];
-    auto num_to_read = nmemb;
-    if (handle->m_request_context.m_stream != nullptr) {
-        LOG_INFO("Reading from input stream");
-        if (handle->m_request_context.m_stream->has_content()) {
-            WriteableBufferView buffer_view(buffer, num_to_read);
-            auto result = handle->m_request_context.m_stream->read(buffer_view);
-            if (!result.ok()) {
-                LOG_ERROR("Error reading from stream");
-            }
-            LOG_INFO(
-                "Finished reading from input stream --- "
-                << result.m_num_transferred);
-            return result.m_num_transferred;
-        }
-        else {
-            LOG_INFO("Finished reading from input stream 0");
+    if (context.m_stream != nullptr) {
+        if (!context.m_stream->has_content()) {
             return 0;
         }
-    }
-    else {
-        if (handle->m_request_context.m_read_offset + nmemb
-            > handle->m_request_context.m_request->body().size()) {
-            num_to_read = handle->m_request_context.m_request->body().size();
-        }
-        LOG_INFO("Returning " << num_to_read << " bytes ");
-        for (std::size_t idx = 0; idx < num_to_read; idx++) {
-            buffer[idx] =
-                handle->m_request_context.m_request
-                    ->body()[handle->m_request_context.m_read_offset + idx];
+
+        WriteableBufferView buffer_view(buffer, length);
+        auto result = context.m_stream->read(buffer_view);
+        if (!result.ok()) {
+            LOG_ERROR("Error reading from stream");
         }
-        handle->m_request_context.m_read_offset += num_to_read;
-        LOG_INFO(
-            "New offset is " << handle->m_request_context.m_read_offset
-                             << " bytes ");
+        return result.m_num_transferred;
+    }
+
+    const auto& body = context.m_request->body();
+    if (context.m_read_offset >= body.size()) {
+        return 0;
     }
+
+    const auto num_to_read =
+        std::min(length, body.size() - context.m_read_offset);
+    std::memcpy(buffer, body.data() + context.m_read_offset, num_to_read);
+    context.m_read_offset += num_to_read;
     return num_to_read;
 }
 
+size_t CurlClient::curl_header_data(
+    char* buffer, size_t size, size_t nitems, void* userp)
+{
+    if (userp == nullptr) {
+        return 0;
+    }
+
+    auto handle = reinterpret_cast<CurlHandle*>(userp);
+    handle->m_request_context.m_response->header().add_line(
+        std::string(buffer, size * nitems));
+    return size * nitems;
+}
+
 size_t CurlClient::curl_seek_data(void* userp, curl_off_t offset, int origin)
 {
-    LOG_INFO(
+    LOG_DEBUG(
         "Seek data fired with offset: " << offset << " and origin " << origin);
     if (userp == nullptr) {
-        return 0;
+        return CURL_SEEKFUNC_CANTSEEK;
     }
 
-    auto client = reinterpret_cast<CurlClient*>(userp);
-    return client->on_seek(offset, origin);
+    auto handle = reinterpret_cast<CurlHandle*>(userp);
+    return on_seek(handle->m_request_context, offset);
 }
 
-size_t CurlClient::on_seek(curl_off_t offset, int)
+size_t CurlClient::on_seek(CurlRequestContext& context, curl_off_t offset)
 {
-    auto handle = m_handles[std::this_thread::get_id()];
-    if (handle->m_request_context.m_stream != nullptr) {
-        if (handle->m_request_context.m_stream->supports_source_seek()) {
-            handle->m_request_context.m_stream->seek_source_to(offset);
-            return 0;
+    if (context.m_stream != nullptr) {
+        if (context.m_stream->supports_source_seek()) {
+            context.m_stream->seek_source_to(offset);
+            return CURL_SEEKFUNC_OK;
         }
     }
-    return 2;
+    else if (context.m_request != nullptr) {
+        context.m_read_offset = static_cast<std::size_t>(offset);
+        return CURL_SEEKFUNC_OK;
+    }
+    return CURL_SEEKFUNC_CANTSEEK;
 }
 
 void CurlClient::setup_handle(CurlHandle* handle)
@@ -157,7 +231,7 @@ void CurlClient::setup_handle(CurlHandle* handle)
             + handle->m_error_buffer);
     }
 
-    rc = curl_easy_setopt(handle->m_handle, CURLOPT_WRITEDATA, this);
+    rc = curl_easy_setopt(handle->m_handle, CURLOPT_WRITEDATA, handle);
     if (rc != CURLE_OK) {
         throw std::runtime_error(
             "Failed to set curl writedata with error: "
@@ -172,13 +246,28 @@ void CurlClient::setup_handle(CurlHandle* handle)
             + handle->m_error_buffer);
     }
 
-    rc = curl_easy_setopt(handle->m_handle, CURLOPT_READDATA, this);
+    rc = curl_easy_setopt(handle->m_handle, CURLOPT_READDATA, handle);
     if (rc != CURLE_OK) {
         throw std::runtime_error(
             "Failed to set curl readdata with error: "
             + handle->m_error_buffer);
     }
 
+    rc = curl_easy_setopt(
+        handle->m_handle, CURLOPT_HEADERFUNCTION, curl_header_data);
+    if (rc != CURLE_OK) {
+        throw std::runtime_error(
+            "Failed to set curl headerfunction with error: "
+            + handle->m_error_buffer);
+    }
+
+    rc = curl_easy_setopt(handle->m_handle, CURLOPT_HEADERDATA, handle);
+    if (rc != CURLE_OK) {
+        throw std::runtime_error(
+            "Failed to set curl headerdata with error: "
+            + handle->m_error_buffer);
+    }
+
     rc = curl_easy_setopt(
         handle->m_handle, CURLOPT_SEEKFUNCTION, curl_seek_data);
     if (rc != CURLE_OK) {
@@ -187,7 +276,7 @@ void CurlClient::setup_handle(CurlHandle* handle)
             + handle->m_error_buffer);
     }
 
-    rc = curl_easy_setopt(handle->m_handle, CURLOPT_SEEKDATA, this);
+    rc = curl_easy_setopt(handle->m_handle, CURLOPT_SEEKDATA, handle);
     if (rc != CURLE_OK) {
         throw std::runtime_error(
             "Failed to set curl seekdata with error: "
@@ -202,10 +291,10 @@ HttpResponse::Ptr CurlClient::make_request(
         initialize();
     }
 
-    auto handle                           = std::make_unique<CurlHandle>();
-    m_handles[std::this_thread::get_id()] = handle.get();
+    CurlHandleLease lease(m_handles.get());
+    auto handle = lease.get();
 
-    setup_handle(handle.get());
+    setup_handle(handle);
 
     if (request.get_method() == HttpRequest::Method::GET) {
         handle->prepare_get();
@@ -213,6 +302,9 @@ HttpResponse::Ptr CurlClient::make_request(
     else if (request.get_method() == HttpRequest::Method::PUT) {
         handle->prepare_put(request, stream);
     }
+    else if (request.get_method() == HttpRequest::Method::POST) {
+        handle->prepare_post(request);
+    }
     else if (request.get_method() == HttpRequest::Method::DELETE) {
         handle->prepare_delete();
     }
@@ -225,11 +317,21 @@ HttpResponse::Ptr CurlClient::make_request(
     handle->m_request_context.m_response = response.get();
     handle->m_request_context.m_stream   = stream;
 
-    const auto url = request.get_path();
+    auto url = request.get_path();
+    if (!request.get_queries().empty()) {
+        std::string query_string;
+        request.get_queries().for_each_item(
+            [&query_string](const std::string& key, const std::string& value) {
+                query_string += (query_string.empty() ? "?" : "&")
+                                + HashUtils::uri_encode(key, true) + "="
+                                + HashUtils::uri_encode(value, true);
+            });
+        url += query_string;
+    }
     curl_easy_setopt(handle->m_handle, CURLOPT_URL, url.c_str());
 
-    LOG_INFO("Making request to: " << url);
-    LOG_INFO(request.to_string());
+    LOG_DEBUG("Making request to: " << url);
+    LOG_DEBUG(request.to_string());
     auto rc = curl_easy_perform(handle->m_handle);
     if (rc != CURLE_OK) {
         std::string msg = SOURCE_LOC() + " | Failed request: " + url;
@@ -241,7 +343,8 @@ HttpResponse::Ptr CurlClient::make_request(
 
     long http_code = 0;
     curl_easy_getinfo(handle->m_handle, CURLINFO_RESPONSE_CODE, &http_code);
-    if (http_code != 200 || rc == CURLE_ABORTED_BY_CALLBACK) {
+    if (http_code < 200 || http_code >= 300
+        || rc == CURLE_ABORTED_BY_CALLBACK) {
         LOG_INFO(
             "Error in http response: "
             << http_code << " | "
@@ -251,9 +354,7 @@ HttpResponse::Ptr CurlClient::make_request(
                            + handle->m_request_context.m_response->body());
     }
 
-    m_handles.erase(std::this_thread::get_id());
-
-    LOG_INFO("Request all done");
+    LOG_DEBUG("Request all done");
 
     return response;
 }
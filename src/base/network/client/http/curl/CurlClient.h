@@ -4,17 +4,24 @@
 #include "HttpClient.h"
 
 #include <atomic>
-#include <thread>
-#include <unordered_map>
+#include <memory>
+#include <mutex>
 
 namespace hestia {
 struct CurlClientConfig {
     bool m_do_global_init{true};
+    std::size_t m_max_idle_handles{16};
 };
 
+class CurlHandlePool;
+
 /**
  * @brief A http client using CURL
  *
+ * Easy handles are taken from a pool and returned to it after each request,
+ * so the connections and DNS entries they cache are reused by later requests
+ * to the same host. Up to 'max_idle_handles' are kept between requests -
+ * concurrent callers beyond that get a new handle which is freed after use.
  */
 class CurlClient : public HttpClient {
   public:
@@ -27,6 +34,12 @@ class CurlClient : public HttpClient {
      */
     void initialize();
 
+    /**
+     * Number of handles currently held idle in the pool
+     * @return Number of idle handles
+     */
+    std::size_t get_num_idle_handles() const;
+
     /**
      * Make a sync http request and wait for the response
      * @param request the http request
@@ -39,22 +52,28 @@ class CurlClient : public HttpClient {
     static size_t curl_write_data(
         void* buffer, size_t size, size_t nmemb, void* userp);
 
-    size_t on_write(void* buffer, size_t nmemb);
+    static size_t on_write(
+        CurlRequestContext& context, void* buffer, size_t length);
 
     static size_t curl_read_data(
         char* buffer, size_t size, size_t nmemb, void* userp);
 
-    size_t on_read(char* buffer, size_t nmemb);
+    static size_t on_read(
+        CurlRequestContext& context, char* buffer, size_t length);
+
+    static size_t curl_header_data(
+        char* buffer, size_t size, size_t nitems, void* userp);
 
     static size_t curl_seek_data(void* userp, curl_off_t offset, int origin);
 
-    size_t on_seek(curl_off_t offset, int origin);
+    static size_t on_seek(CurlRequestContext& context, curl_off_t offset);
 
     void setup_handle(CurlHandle* handle);
 
     CurlClientConfig m_config;
     std::atomic<bool> m_initialized{false};
+    std::mutex m_init_mutex;
 
-    std::unordered_map<std::thread::id, CurlHandle*> m_handles;
+    std::unique_ptr<CurlHandlePool> m_handles;
 };
 }  // namespace hestia
\ No newline at end of file
@@ -2,6 +2,8 @@
 
 #include "Logger.h"
 
+#include <algorithm>
+
 namespace hestia {
 CurlHandle::CurlHandle()
 {
@@ -15,13 +17,17 @@ CurlHandle::~CurlHandle()
 
 void CurlHandle::setup()
 {
-    LOG_INFO("Setting up curl handle");
+    LOG_DEBUG("Setting up curl handle");
     m_handle = curl_easy_init();
     if (m_handle == nullptr) {
         throw std::runtime_error("Failed to initialize curl session");
     }
-
     m_error_buffer = std::string(CURL_ERROR_SIZE, ' ');
+    set_default_options();
+}
+
+void CurlHandle::set_default_options()
+{
     auto rc =
         curl_easy_setopt(m_handle, CURLOPT_ERRORBUFFER, m_error_buffer.data());
     if (rc != CURLE_OK) {
@@ -33,11 +39,29 @@ void CurlHandle::setup()
         throw std::runtime_error(
             "Failed to set curl writedata with error: " + m_error_buffer);
     }
+
+    rc = curl_easy_setopt(m_handle, CURLOPT_TCP_KEEPALIVE, 1L);
+    if (rc != CURLE_OK) {
+        throw std::runtime_error(
+            "Failed to set curl tcp keepalive with error: " + m_error_buffer);
+    }
+}
+
+void CurlHandle::reset()
+{
+    curl_easy_reset(m_handle);
+    if (m_headers != nullptr) {
+        curl_slist_free_all(m_headers);
+        m_headers = nullptr;
+    }
+    m_request_context = {};
+    std::fill(m_error_buffer.begin(), m_error_buffer.end(), ' ');
+    set_default_options();
 }
 
 void CurlHandle::free()
 {
-    LOG_INFO("Freeing handle");
+    LOG_DEBUG("Freeing handle");
     if (m_handle != nullptr) {
         curl_easy_cleanup(m_handle);
         m_handle = nullptr;
@@ -77,6 +101,25 @@ void CurlHandle::prepare_put(const HttpRequest& request, Stream* stream)
     }
 }
 
+void CurlHandle::prepare_post(const HttpRequest& request)
+{
+    auto rc = curl_easy_setopt(m_handle, CURLOPT_POST, 1L);
+    if (rc != CURLE_OK) {
+        throw std::runtime_error(
+            "Failed to set curl to post mode with error: " + m_error_buffer);
+    }
+
+    // The body is supplied by the read callback
+    rc = curl_easy_setopt(
+        m_handle, CURLOPT_POSTFIELDSIZE_LARGE,
+        static_cast<curl_off_t>(request.body().size()));
+    if (rc != CURLE_OK) {
+        throw std::runtime_error(
+            "Failed to set curl request body size with error: "
+            + m_error_buffer);
+    }
+}
+
 void CurlHandle::prepare_get()
 {
     auto rc = curl_easy_setopt(m_handle, CURLOPT_HTTPGET, 1L);
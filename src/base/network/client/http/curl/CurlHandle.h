@@ -30,8 +30,16 @@ class CurlHandle {
 
     void free();
 
+    /**
+     * Clear all per-request state so the handle can be reused. Open
+     * connections and the DNS cache are kept.
+     */
+    void reset();
+
     void prepare_put(const HttpRequest& request, Stream* stream);
 
+    void prepare_post(const HttpRequest& request);
+
     void prepare_get();
 
     void prepare_delete();
@@ -40,6 +48,8 @@ class CurlHandle {
 
     void setup();
 
+    void set_default_options();
+
     CURL* m_handle{nullptr};
     curl_slist* m_headers{nullptr};
 
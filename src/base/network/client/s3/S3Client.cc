@@ -1,12 +1,76 @@
 #include "S3Client.h"
 
 #include "HttpRequest.h"
+#include "ThreadPool.h"
 #include "XmlAttribute.h"
 #include "XmlDocument.h"
 #include "XmlElement.h"
 
+#include "ErrorUtils.h"
+#include "Logger.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <mutex>
+
 namespace hestia {
 
+namespace {
+/**
+ * @brief Finishes a part task under the parts mutex and wakes the thread
+ * waiting on the parts - however the task exits, so that thread is never
+ * left waiting on a task that threw.
+ */
+class PartTaskGuard {
+  public:
+    PartTaskGuard(
+        std::mutex& mutex,
+        std::condition_variable& parts_cv,
+        std::function<void()> on_exit) :
+        m_mutex(mutex), m_parts_cv(parts_cv), m_on_exit(std::move(on_exit))
+    {
+    }
+
+    ~PartTaskGuard()
+    {
+        std::scoped_lock guard(m_mutex);
+        m_on_exit();
+        m_parts_cv.notify_all();
+    }
+
+    PartTaskGuard(const PartTaskGuard&) = delete;
+
+    PartTaskGuard& operator=(const PartTaskGuard&) = delete;
+
+  private:
+    std::mutex& m_mutex;
+    std::condition_variable& m_parts_cv;
+    std::function<void()> m_on_exit;
+};
+}  // namespace
+
+static void set_queries(
+    const Map& queries, HttpRequest& http_request, S3Request& s3_request)
+{
+    http_request.set_queries(queries);
+
+    // Queries are part of the signature
+    s3_request.m_queries.clear();
+    queries.for_each_item(
+        [&s3_request](const std::string& key, const std::string& value) {
+            s3_request.m_queries.push_back({key, value});
+        });
+    std::sort(s3_request.m_queries.begin(), s3_request.m_queries.end());
+}
+
+static std::string get_range_header(const S3Range& range)
+{
+    return "bytes=" + std::to_string(range.m_offset) + "-"
+           + std::to_string(range.m_offset + range.m_length - 1);
+}
+
 S3Client::S3Client(HttpClient* http_client) : m_http_client(http_client) {}
 
 S3Client::~S3Client() {}
@@ -32,7 +96,7 @@ S3Status S3Client::create_bucket(
 
     // Post-body header updates
     s3_request.populate_authorization_headers(
-        S3Request::PayloadSignatureType::SIGNED, http_request);
+        S3Request::PayloadSignatureType::SIGNED, http_request, &m_signing_keys);
 
     return do_request(http_request)->m_status;
 }
@@ -45,7 +109,7 @@ S3Status S3Client::head_bucket(
     HttpRequest http_request(path, HttpRequest::Method::HEAD);
     s3_request.populate_headers(bucket.name(), http_request.get_header());
     s3_request.populate_authorization_headers(
-        S3Request::PayloadSignatureType::SIGNED, http_request);
+        S3Request::PayloadSignatureType::SIGNED, http_request, &m_signing_keys);
 
     return do_request(http_request)->m_status;
 }
@@ -58,7 +122,7 @@ S3Status S3Client::delete_bucket(
     HttpRequest http_request(path, HttpRequest::Method::DELETE);
     s3_request.populate_headers(bucket.name(), http_request.get_header());
     s3_request.populate_authorization_headers(
-        S3Request::PayloadSignatureType::SIGNED, http_request);
+        S3Request::PayloadSignatureType::SIGNED, http_request, &m_signing_keys);
 
     return do_request(http_request)->m_status;
 }
@@ -71,7 +135,7 @@ S3ListBucketResponse::Ptr S3Client::list_buckets(
     HttpRequest http_request(path, HttpRequest::Method::GET);
     s3_request.populate_headers({}, http_request.get_header());
     s3_request.populate_authorization_headers(
-        S3Request::PayloadSignatureType::SIGNED, http_request);
+        S3Request::PayloadSignatureType::SIGNED, http_request, &m_signing_keys);
 
     return std::make_unique<S3ListBucketResponse>(*do_request(http_request));
 }
@@ -88,7 +152,8 @@ S3Status S3Client::put_object(
     s3_request.populate_headers(
         bucket.name(), http_request.get_header(), object.m_content_mimetype);
     s3_request.populate_authorization_headers(
-        S3Request::PayloadSignatureType::UNSIGNED, http_request);
+        S3Request::PayloadSignatureType::UNSIGNED, http_request,
+        &m_signing_keys);
 
     const auto response = std::make_unique<S3Response>(
         m_http_client->make_request(http_request, stream));
@@ -105,7 +170,7 @@ S3Status S3Client::delete_object(
     HttpRequest http_request(path, HttpRequest::Method::DELETE);
     s3_request.populate_headers(bucket.name(), http_request.get_header());
     s3_request.populate_authorization_headers(
-        S3Request::PayloadSignatureType::SIGNED, http_request);
+        S3Request::PayloadSignatureType::SIGNED, http_request, &m_signing_keys);
 
     return do_request(http_request)->m_status;
 }
@@ -120,8 +185,13 @@ S3Status S3Client::get_object(
 
     HttpRequest http_request(path, HttpRequest::Method::GET);
     s3_request.populate_headers(bucket.name(), http_request.get_header());
+    if (s3_request.m_range.m_length > 0) {
+        http_request.get_header().set_item(
+            "range", get_range_header(s3_request.m_range));
+    }
     s3_request.populate_authorization_headers(
-        S3Request::PayloadSignatureType::UNSIGNED, http_request);
+        S3Request::PayloadSignatureType::UNSIGNED, http_request,
+        &m_signing_keys);
 
     auto response = std::make_unique<S3Response>(
         m_http_client->make_request(http_request, stream));
@@ -137,21 +207,436 @@ S3ListObjectsResponse::Ptr S3Client::list_objects(
 
     Map query;
     request.build_query(query);
-    http_request.set_queries(query);
+    auto s3_request = request.m_s3_request;
+    set_queries(query, http_request, s3_request);
 
-    request.m_s3_request.populate_headers(
-        bucket.name(), http_request.get_header());
-    request.m_s3_request.populate_authorization_headers(
-        S3Request::PayloadSignatureType::UNSIGNED, http_request);
+    s3_request.populate_headers(bucket.name(), http_request.get_header());
+    s3_request.populate_authorization_headers(
+        S3Request::PayloadSignatureType::UNSIGNED, http_request,
+        &m_signing_keys);
 
     return std::make_unique<S3ListObjectsResponse>(
         *do_request(http_request), request.m_is_v2_type);
 }
 
+S3Status S3Client::put_object_parallel(
+    const S3Object& object,
+    const S3Bucket& bucket,
+    const S3Request& s3_request,
+    Stream* stream,
+    std::size_t length,
+    const S3TransferConfig& config)
+{
+    std::string upload_id;
+    auto status =
+        create_multipart_upload(object, bucket, s3_request, upload_id);
+    if (!status.is_ok()) {
+        return status;
+    }
+
+    const auto part_size = std::max(config.m_part_size, std::size_t(1));
+    const auto num_parts = (length + part_size - 1) / part_size;
+    const auto max_in_flight =
+        std::max(config.m_max_parallel_parts, std::size_t(1));
+
+    std::mutex mutex;
+    std::condition_variable parts_cv;
+    std::size_t num_in_flight{0};
+    bool failed{false};
+    S3CompleteMultipartUploadRequest complete_request;
+    complete_request.m_parts.resize(num_parts);
+
+    // Parts are read from the stream in order on this thread, with at most
+    // 'max_in_flight' buffered or uploading at once.
+    ThreadPool workers(std::min(max_in_flight, num_parts));
+    for (std::size_t idx = 0; idx < num_parts; idx++) {
+        {
+            std::unique_lock lock(mutex);
+            parts_cv.wait(lock, [&num_in_flight, &failed, max_in_flight]() {
+                return num_in_flight < max_in_flight || failed;
+            });
+            if (failed) {
+                break;
+            }
+        }
+
+        std::string body(std::min(part_size, length - idx * part_size), 0);
+        std::size_t num_read{0};
+        while (num_read < body.size()) {
+            WriteableBufferView buffer(
+                body.data() + num_read, body.size() - num_read);
+            const auto result = stream->read(buffer);
+            if (!result.ok() || result.m_num_transferred == 0) {
+                break;
+            }
+            num_read += result.m_num_transferred;
+        }
+        if (num_read < body.size()) {
+            std::scoped_lock guard(mutex);
+            status = S3Status(
+                S3StatusCode::_500_INTERNAL_SERVER_ERROR, s3_request,
+                "Failed to read part " + std::to_string(idx + 1)
+                    + " from stream.");
+            failed = true;
+            break;
+        }
+
+        {
+            std::scoped_lock guard(mutex);
+            num_in_flight++;
+        }
+        workers.add_task([this, &object, &bucket, &s3_request, &upload_id,
+                          &config, &mutex, &parts_cv, &num_in_flight, &failed,
+                          &status, &complete_request, idx,
+                          body = std::move(body)]() mutable {
+            PartTaskGuard task_guard(
+                mutex, parts_cv, [&num_in_flight]() { num_in_flight--; });
+
+            S3Part part;
+            part.m_number = idx + 1;
+            S3Status part_status;
+            try {
+                part_status = upload_part(
+                    object, bucket, s3_request, upload_id, part,
+                    std::move(body), config.m_max_part_attempts);
+            }
+            catch (const std::exception& e) {
+                part_status = S3Status(
+                    S3StatusCode::_500_INTERNAL_SERVER_ERROR, s3_request,
+                    "Failed to upload part " + std::to_string(idx + 1) + ": "
+                        + e.what());
+            }
+
+            std::scoped_lock guard(mutex);
+            if (part_status.is_ok()) {
+                complete_request.m_parts[idx] = part;
+            }
+            else if (!failed) {
+                status = part_status;
+                failed = true;
+            }
+        });
+    }
+    workers.shut_down();
+
+    if (failed) {
+        LOG_ERROR(
+            "Aborting multipart upload " << upload_id << ": "
+                                         << status.to_string());
+        const auto abort_status =
+            abort_multipart_upload(object, bucket, s3_request, upload_id);
+        if (!abort_status.is_ok()) {
+            LOG_ERROR(
+                "Failed to abort multipart upload "
+                << upload_id << ": " << abort_status.to_string());
+        }
+        return status;
+    }
+    return complete_multipart_upload(
+        object, bucket, s3_request, upload_id, complete_request);
+}
+
+S3Status S3Client::get_object_parallel(
+    const S3Object& object,
+    const S3Bucket& bucket,
+    const S3Request& s3_request,
+    Stream* stream,
+    const S3TransferConfig& config)
+{
+    const auto& range    = s3_request.m_range;
+    const auto part_size = std::max(config.m_part_size, std::size_t(1));
+    const auto num_parts = (range.m_length + part_size - 1) / part_size;
+    const auto max_in_flight =
+        std::max(config.m_max_parallel_parts, std::size_t(1));
+
+    std::mutex mutex;
+    std::condition_variable parts_cv;
+    std::map<std::size_t, std::string> fetched;
+    bool failed{false};
+    S3Status status;
+
+    auto fetch_part = [this, &object, &bucket, &s3_request, &config, &range,
+                       &mutex, &parts_cv, &fetched, &failed, &status,
+                       part_size](std::size_t idx) {
+        // A part not dealt with by the time the task exits fails the transfer
+        bool handled{false};
+        PartTaskGuard task_guard(
+            mutex, parts_cv, [&s3_request, &failed, &status, &handled, idx]() {
+                if (failed || handled) {
+                    return;
+                }
+                status = S3Status(
+                    S3StatusCode::_500_INTERNAL_SERVER_ERROR, s3_request,
+                    "Failed to fetch part " + std::to_string(idx + 1));
+                failed = true;
+            });
+
+        const auto offset = idx * part_size;
+        const S3Range part_range(
+            range.m_offset + offset,
+            std::min(part_size, range.m_length - offset));
+
+        std::string body;
+        S3Status part_status;
+        try {
+            part_status = get_object_range(
+                object, bucket, s3_request, part_range, body,
+                config.m_max_part_attempts);
+        }
+        catch (const std::exception& e) {
+            part_status = S3Status(
+                S3StatusCode::_500_INTERNAL_SERVER_ERROR, s3_request,
+                "Failed to fetch part " + std::to_string(idx + 1) + ": "
+                    + e.what());
+        }
+
+        std::scoped_lock guard(mutex);
+        if (part_status.is_ok() && body.size() == part_range.m_length) {
+            fetched[idx] = std::move(body);
+            handled      = true;
+        }
+        else if (!failed) {
+            status = part_status.is_ok() ?
+                         S3Status(
+                             S3StatusCode::_500_INTERNAL_SERVER_ERROR,
+                             s3_request,
+                             "Short read of part " + std::to_string(idx + 1)) :
+                         part_status;
+            failed = true;
+        }
+    };
+
+    // Ranges are fetched up to 'max_in_flight' ahead of the next one to be
+    // written, which is done on this thread so the sink sees them in order.
+    ThreadPool workers(std::min(max_in_flight, num_parts));
+    std::size_t num_dispatched{0};
+    for (std::size_t idx = 0; idx < num_parts; idx++) {
+        for (; num_dispatched < num_parts
+               && num_dispatched < idx + max_in_flight;
+             num_dispatched++) {
+            workers.add_task(
+                [fetch_part, num_dispatched]() { fetch_part(num_dispatched); });
+        }
+
+        std::string body;
+        {
+            std::unique_lock lock(mutex);
+            parts_cv.wait(lock, [&fetched, &failed, idx]() {
+                return fetched.find(idx) != fetched.end() || failed;
+            });
+            if (failed) {
+                break;
+            }
+            body = std::move(fetched[idx]);
+            fetched.erase(idx);
+        }
+
+        std::size_t num_written{0};
+        while (num_written < body.size()) {
+            const auto result = stream->write(ReadableBufferView(
+                body.data() + num_written, body.size() - num_written));
+            if (!result.ok() || result.m_num_transferred == 0) {
+                break;
+            }
+            num_written += result.m_num_transferred;
+        }
+        if (num_written < body.size()) {
+            std::scoped_lock guard(mutex);
+            status = S3Status(
+                S3StatusCode::_500_INTERNAL_SERVER_ERROR, s3_request,
+                "Failed to write part " + std::to_string(idx + 1)
+                    + " to stream.");
+            failed = true;
+            break;
+        }
+    }
+    workers.shut_down();
+    return status;
+}
+
+S3Status S3Client::create_multipart_upload(
+    const S3Object& object,
+    const S3Bucket& bucket,
+    const S3Request& request,
+    std::string& upload_id) const
+{
+    const auto path = request.get_resource_path(bucket.name(), object.m_key);
+
+    HttpRequest http_request(path, HttpRequest::Method::POST);
+    Map queries;
+    queries.set_item("uploads", "");
+    auto s3_request = request;
+    set_queries(queries, http_request, s3_request);
+
+    s3_request.populate_headers(
+        bucket.name(), http_request.get_header(), object.m_content_mimetype);
+    s3_request.populate_authorization_headers(
+        S3Request::PayloadSignatureType::SIGNED, http_request, &m_signing_keys);
+
+    const auto response = do_request(http_request);
+    if (!response->is_ok()) {
+        return response->m_status;
+    }
+
+    S3CreateMultipartUploadResponse create_response;
+    try {
+        create_response.deserialize(response->m_http_response->body());
+    }
+    catch (const std::exception& e) {
+        return S3Status(
+            S3StatusCode::_500_INTERNAL_SERVER_ERROR, s3_request, e.what());
+    }
+    upload_id = create_response.m_upload_id;
+    return response->m_status;
+}
+
+S3Status S3Client::upload_part(
+    const S3Object& object,
+    const S3Bucket& bucket,
+    const S3Request& request,
+    const std::string& upload_id,
+    S3Part& part,
+    std::string body,
+    std::size_t max_attempts) const
+{
+    const auto path = request.get_resource_path(bucket.name(), object.m_key);
+
+    HttpRequest http_request(path, HttpRequest::Method::PUT);
+    Map queries;
+    queries.set_item("partNumber", std::to_string(part.m_number));
+    queries.set_item("uploadId", upload_id);
+    auto s3_request = request;
+    set_queries(queries, http_request, s3_request);
+
+    part.m_size         = body.size();
+    http_request.body() = std::move(body);
+    s3_request.populate_headers(bucket.name(), http_request.get_header());
+    http_request.get_header().set_item(
+        "Content-Length", std::to_string(part.m_size));
+    s3_request.populate_authorization_headers(
+        S3Request::PayloadSignatureType::UNSIGNED, http_request,
+        &m_signing_keys);
+
+    const auto response = do_request(http_request, max_attempts);
+    if (response->is_ok()) {
+        part.m_etag = response->m_http_response->header().get_item("ETag");
+    }
+    return response->m_status;
+}
+
+S3Status S3Client::complete_multipart_upload(
+    const S3Object& object,
+    const S3Bucket& bucket,
+    const S3Request& request,
+    const std::string& upload_id,
+    const S3CompleteMultipartUploadRequest& parts) const
+{
+    const auto path = request.get_resource_path(bucket.name(), object.m_key);
+
+    HttpRequest http_request(path, HttpRequest::Method::POST);
+    Map queries;
+    queries.set_item("uploadId", upload_id);
+    auto s3_request = request;
+    set_queries(queries, http_request, s3_request);
+
+    http_request.body() = parts.to_string();
+    s3_request.populate_headers(
+        bucket.name(), http_request.get_header(), "application/xml");
+    s3_request.populate_authorization_headers(
+        S3Request::PayloadSignatureType::SIGNED, http_request, &m_signing_keys);
+
+    const auto response = do_request(http_request);
+    if (!response->is_ok()) {
+        return response->m_status;
+    }
+
+    // An error completing the upload can come after a 200 status
+    S3CompleteMultipartUploadResponse complete_response;
+    try {
+        complete_response.deserialize(response->m_http_response->body());
+    }
+    catch (const std::exception& e) {
+        return S3Status(
+            S3StatusCode::_500_INTERNAL_SERVER_ERROR, s3_request,
+            e.what() + std::string(" | ") + response->m_http_response->body());
+    }
+    return response->m_status;
+}
+
+S3Status S3Client::abort_multipart_upload(
+    const S3Object& object,
+    const S3Bucket& bucket,
+    const S3Request& request,
+    const std::string& upload_id) const
+{
+    const auto path = request.get_resource_path(bucket.name(), object.m_key);
+
+    HttpRequest http_request(path, HttpRequest::Method::DELETE);
+    Map queries;
+    queries.set_item("uploadId", upload_id);
+    auto s3_request = request;
+    set_queries(queries, http_request, s3_request);
+
+    s3_request.populate_headers(bucket.name(), http_request.get_header());
+    s3_request.populate_authorization_headers(
+        S3Request::PayloadSignatureType::SIGNED, http_request, &m_signing_keys);
+
+    return do_request(http_request)->m_status;
+}
+
+S3Status S3Client::get_object_range(
+    const S3Object& object,
+    const S3Bucket& bucket,
+    const S3Request& s3_request,
+    const S3Range& range,
+    std::string& body,
+    std::size_t max_attempts) const
+{
+    const auto path = s3_request.get_resource_path(bucket.name(), object.m_key);
+
+    HttpRequest http_request(path, HttpRequest::Method::GET);
+    s3_request.populate_headers(bucket.name(), http_request.get_header());
+    http_request.get_header().set_item("range", get_range_header(range));
+    s3_request.populate_authorization_headers(
+        S3Request::PayloadSignatureType::UNSIGNED, http_request,
+        &m_signing_keys);
+
+    const auto response = do_request(http_request, max_attempts);
+    if (response->is_ok()) {
+        body = std::move(response->m_http_response->body());
+    }
+    return response->m_status;
+}
+
 S3Response::Ptr S3Client::do_request(const HttpRequest& http_request) const
 {
     return std::make_unique<S3Response>(
         m_http_client->make_request(http_request));
 }
 
+S3Response::Ptr S3Client::do_request(
+    const HttpRequest& http_request, std::size_t max_attempts) const
+{
+    const auto num_attempts = std::max(max_attempts, std::size_t(1));
+    for (std::size_t attempt = 1;; attempt++) {
+        try {
+            auto response = do_request(http_request);
+            if (response->is_ok() || attempt == num_attempts) {
+                return response;
+            }
+            LOG_WARN(
+                "Retrying request to " << http_request.get_path() << ": "
+                                       << response->m_status.to_string());
+        }
+        catch (const std::exception& e) {
+            if (attempt == num_attempts) {
+                throw;
+            }
+            LOG_WARN(
+                "Retrying request to " << http_request.get_path() << ": "
+                                       << e.what());
+        }
+    }
+}
+
 }  // namespace hestia
\ No newline at end of file
@@ -2,6 +2,7 @@
 
 #include "HttpClient.h"
 #include "S3Bucket.h"
+#include "S3MultipartUpload.h"
 #include "S3Object.h"
 #include "S3Path.h"
 #include "S3Responses.h"
@@ -11,9 +12,20 @@
 #include "HttpRequest.h"
 #include "S3ListObjectsRequest.h"
 #include "S3Request.h"
+#include "S3SigningKeyCache.h"
 
 namespace hestia {
 
+/**
+ * @brief Settings for moving large objects as parts transferred in parallel
+ */
+struct S3TransferConfig {
+    std::size_t m_part_size{8 * 1024 * 1024};
+    std::size_t m_multipart_threshold{16 * 1024 * 1024};
+    std::size_t m_max_parallel_parts{4};
+    std::size_t m_max_part_attempts{3};
+};
+
 class S3Client {
   public:
     using Ptr = std::unique_ptr<S3Client>;
@@ -52,7 +64,98 @@ class S3Client {
     S3ListObjectsResponse::Ptr list_objects(
         const S3Bucket& bucket, const S3ListObjectsRequest& request);
 
+    /**
+     * Put an object as a multipart upload, reading parts from the stream in
+     * order and uploading up to 'max_parallel_parts' at once. A failed part
+     * is retried on its own and the upload is aborted if it can't be put.
+     *
+     * @param object The object to put
+     * @param bucket The bucket to put it in
+     * @param request Request settings - user, endpoint and timestamp
+     * @param stream Stream with a source holding 'length' bytes
+     * @param length Number of bytes to put
+     * @param config Part size and parallelism
+     * @return The status of the upload
+     */
+    S3Status put_object_parallel(
+        const S3Object& object,
+        const S3Bucket& bucket,
+        const S3Request& request,
+        Stream* stream,
+        std::size_t length,
+        const S3TransferConfig& config);
+
+    /**
+     * Get the byte range in 'request.m_range' as up to 'max_parallel_parts'
+     * concurrent range requests, writing them to the stream sink in order.
+     * A failed range is retried on its own.
+     *
+     * @param object The object to get
+     * @param bucket The bucket holding it
+     * @param request Request settings, including the range to get
+     * @param stream Stream with a sink to write the data to
+     * @param config Part size and parallelism
+     * @return The status of the get
+     */
+    S3Status get_object_parallel(
+        const S3Object& object,
+        const S3Bucket& bucket,
+        const S3Request& request,
+        Stream* stream,
+        const S3TransferConfig& config);
+
+    S3Status create_multipart_upload(
+        const S3Object& object,
+        const S3Bucket& bucket,
+        const S3Request& request,
+        std::string& upload_id) const;
+
+    /**
+     * Upload a part of a multipart upload
+     *
+     * @param part The part - its ETag is set from the response
+     * @param body The part data
+     */
+    S3Status upload_part(
+        const S3Object& object,
+        const S3Bucket& bucket,
+        const S3Request& request,
+        const std::string& upload_id,
+        S3Part& part,
+        std::string body,
+        std::size_t max_attempts = 1) const;
+
+    S3Status complete_multipart_upload(
+        const S3Object& object,
+        const S3Bucket& bucket,
+        const S3Request& request,
+        const std::string& upload_id,
+        const S3CompleteMultipartUploadRequest& parts) const;
+
+    S3Status abort_multipart_upload(
+        const S3Object& object,
+        const S3Bucket& bucket,
+        const S3Request& request,
+        const std::string& upload_id) const;
+
+    /**
+     * Get a byte range of an object into memory
+     *
+     * @param range The range to get
+     * @param body Set to the data
+     */
+    S3Status get_object_range(
+        const S3Object& object,
+        const S3Bucket& bucket,
+        const S3Request& request,
+        const S3Range& range,
+        std::string& body,
+        std::size_t max_attempts = 1) const;
+
   private:
+    S3Response::Ptr do_request(
+        const HttpRequest& request, std::size_t max_attempts) const;
+
     void prepare_headers(
         const S3Request& request,
         const S3Bucket& bucket,
@@ -62,5 +165,6 @@ class S3Client {
     S3Response::Ptr do_request(const HttpRequest& request) const;
 
     HttpClient* m_http_client{nullptr};
+    mutable S3SigningKeyCache m_signing_keys;
 };
 }  // namespace hestia
\ No newline at end of file
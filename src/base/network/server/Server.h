@@ -16,6 +16,11 @@ class Server {
         int m_http_port{8000};
         int m_http2_port{8080};
         std::size_t m_num_threads{0};
+        int m_listen_backlog{1024};
+        std::size_t m_max_connections{4096};
+        std::size_t m_keep_alive_timeout{5};
+        std::size_t m_max_requests_per_connection{1000};
+        std::size_t m_socket_buffer_size{1024 * 1024};
         std::size_t m_body_buffer_size{0x77359400};  // Approx 2GB
         bool m_block_on_launch{false};
         int m_argc{0};
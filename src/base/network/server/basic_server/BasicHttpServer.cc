@@ -13,12 +13,21 @@
 
 #include "Logger.h"
 
+#include <sstream>
 #include <string>
 
 namespace hestia {
 BasicHttpServer::BasicHttpServer(const Config& config, WebApp* web_app) :
-    Server(config, web_app), m_tcp_server(std::make_unique<TcpServer>())
+    Server(config, web_app)
 {
+    TcpServer::Config tcp_config;
+    tcp_config.m_num_workers        = m_config.m_num_threads;
+    tcp_config.m_listen_backlog     = m_config.m_listen_backlog;
+    tcp_config.m_max_connections    = m_config.m_max_connections;
+    tcp_config.m_keep_alive_timeout = m_config.m_keep_alive_timeout;
+    tcp_config.m_buffer_size        = m_config.m_socket_buffer_size;
+    m_tcp_server = std::make_unique<TcpServer>(tcp_config);
+
     if (m_config.m_block_on_launch) {
         m_tcp_server->set_block_on_listen(true);
     }
@@ -59,7 +68,7 @@ BasicHttpServer::Status BasicHttpServer::start()
 }
 
 bool BasicHttpServer::on_head(
-    RequestContext& request_context, Socket* socket) const
+    RequestContext& request_context, Socket* socket, bool& keep_alive) const
 {
     LOG_INFO(
         "Got headers: "
@@ -69,7 +78,19 @@ bool BasicHttpServer::on_head(
     if (request_context.get_response()->get_completion_status()
         == HttpResponse::CompletionStatus::FINISHED) {
         LOG_INFO("Response finished after reading headers - don't want body");
-        socket->respond(request_context.get_response()->to_string());
+
+        // Any unread body is still on the wire, so only keep the connection
+        // if it has all arrived already.
+        const auto expected_body_size = request_context.get_request()
+                                            .get_header()
+                                            .get_content_length_as_size_t();
+        if (request_context.get_request().body().size() < expected_body_size) {
+            keep_alive = false;
+        }
+        else {
+            take_excess_body(request_context, socket, expected_body_size);
+        }
+        respond(socket, *request_context.get_response(), keep_alive);
         return true;
     }
     else if (request_context.get_request().get_header().has_expect_continue()) {
@@ -88,75 +109,88 @@ bool BasicHttpServer::on_body_chunk(
     std::size_t expected_body_size,
     std::size_t& body_count) const
 {
-    LOG_INFO("On body chunk");
+    LOG_DEBUG("On body chunk");
 
     IOResult write_result;
     if (last_event == HttpEvent::HEADERS
-        && !context.get_request().body().empty()
-        && context.get_request().body().size() <= expected_body_size) {
-        write_result = context.get_stream()->write(
+        && !context.get_request().body().empty()) {
+        write_result = context.write_to_stream(
             ReadableBufferView(context.get_request().body()));
     }
     else {
-        write_result =
-            context.get_stream()->write(ReadableBufferView(socket->recieve()));
+        // Received straight into the socket buffer and passed on without a
+        // copy, any excess is the start of the next request
+        auto chunk                = socket->recieve_buffer();
+        const auto remaining_size = expected_body_size - body_count;
+        if (chunk.length() > remaining_size) {
+            socket->push_unread(std::string(
+                chunk.data() + remaining_size,
+                chunk.length() - remaining_size));
+            chunk = chunk.slice(0, remaining_size);
+        }
+        write_result = context.write_to_stream(chunk);
     }
 
     if (!write_result.ok()) {
         LOG_ERROR("Failed to write to stream ");
-        socket->respond(
-            HttpResponse::create(
-                HttpStatus(HttpStatus::Code::_500_INTERNAL_SERVER_ERROR))
-                ->to_string());
+        respond_with_error(socket);
         return true;
     }
 
     body_count += write_result.m_num_transferred;
     last_event = HttpEvent::BODY;
 
-    LOG_INFO(
+    LOG_DEBUG(
         "Body count is: " << body_count
                           << " expected_body_size is: " << expected_body_size);
 
     if (body_count >= expected_body_size) {
         LOG_INFO("Finished with streamed body - sending eom");
-
-        // if (context.get_stream()->waiting_for_content())
-        //{
-        LOG_INFO("Resetting stream");
-        auto reset_state = context.get_stream()->reset();
-        if (!reset_state.ok()) {
-            LOG_ERROR("Error resetting stream: " << reset_state.to_string());
-            socket->respond(
-                HttpResponse::create(
-                    HttpStatus(HttpStatus::Code::_500_INTERNAL_SERVER_ERROR))
-                    ->to_string());
-            return true;
-        }
-        //}
-
-        m_web_app->on_event(&context, HttpEvent::EOM);
-        socket->respond(context.get_response()->to_string());
         return true;
     }
     return false;
 }
 
 void BasicHttpServer::on_connection(Socket* socket)
+{
+    while (socket->connected()) {
+        const auto request_count = socket->increment_request_count();
+        const bool keep_alive =
+            m_config.m_keep_alive_timeout > 0
+            && request_count < m_config.m_max_requests_per_connection;
+
+        if (!on_request(socket, keep_alive)) {
+            break;
+        }
+
+        // With no pipelined request waiting the connection is handed back to
+        // the TcpServer to wait for the next one without holding this worker.
+        if (!socket->has_unread()) {
+            return;
+        }
+    }
+    socket->close();
+}
+
+bool BasicHttpServer::on_request(Socket* socket, bool keep_alive) const
 {
     RequestContext request_context;
+    request_context.set_chunk_size(m_config.m_socket_buffer_size);
     HttpEvent last_event{HttpEvent::CONNECTED};
 
     std::size_t received_body_count{0};
     std::size_t expected_body_size{0};
     while (socket->connected()) {
         if (last_event == HttpEvent::CONNECTED) {
-            request_context.get_writeable_request().on_chunk(socket->recieve());
+            request_context.get_writeable_request().on_chunk(
+                socket->recieve());
 
             if (request_context.get_request().has_read_header()) {
-                const bool should_disconnect = on_head(request_context, socket);
-                if (should_disconnect) {
-                    break;
+                keep_alive =
+                    keep_alive
+                    && request_context.get_request().should_keep_alive();
+                if (on_head(request_context, socket, keep_alive)) {
+                    return keep_alive;
                 }
                 last_event = HttpEvent::HEADERS;
             }
@@ -166,41 +200,45 @@ void BasicHttpServer::on_connection(Socket* socket)
                 expected_body_size = request_context.get_request()
                                          .get_header()
                                          .get_content_length_as_size_t();
+                take_excess_body(request_context, socket, expected_body_size);
             }
 
             if (expected_body_size == 0) {
                 m_web_app->on_event(&request_context, HttpEvent::EOM);
-                socket->respond(request_context.get_response()->to_string());
-                if (request_context.get_stream()->has_content()) {
-                    LOG_INFO("Responding with stream");
-                    request_context.set_output_chunk_handler(
-                        [&socket](
-                            const hestia::ReadableBufferView& buffer,
-                            bool finished) {
-                            (void)finished;
-                            socket->respond(
-                                std::string(buffer.data(), buffer.length()));
-                            return buffer.length();
-                        });
-                    request_context.flush_stream();
-                }
-                break;
+                return respond_with_stream(socket, request_context, keep_alive);
             }
             else if (
                 request_context.get_response()->get_completion_status()
                 == HttpResponse::CompletionStatus::AWAITING_BODY_CHUNK) {
-                const bool should_disconnect = on_body_chunk(
-                    request_context, socket, last_event, expected_body_size,
-                    received_body_count);
-                if (should_disconnect) {
-                    break;
+                if (on_body_chunk(
+                        request_context, socket, last_event,
+                        expected_body_size, received_body_count)) {
+                    if (received_body_count < expected_body_size) {
+                        return false;
+                    }
+
+                    LOG_INFO("Resetting stream");
+                    auto reset_state = request_context.get_stream()->reset();
+                    if (!reset_state.ok()) {
+                        LOG_ERROR(
+                            "Error resetting stream: "
+                            << reset_state.to_string());
+                        respond_with_error(socket);
+                        return false;
+                    }
+                    m_web_app->on_event(&request_context, HttpEvent::EOM);
+                    respond(
+                        socket, *request_context.get_response(), keep_alive);
+                    return keep_alive;
                 }
             }
             else {
-                if (request_context.get_request().body().size()
-                    < expected_body_size) {
-                    request_context.get_writeable_request().body() +=
-                        socket->recieve();
+                auto& body = request_context.get_writeable_request().body();
+                if (body.size() < expected_body_size) {
+                    const auto chunk = socket->recieve_buffer();
+                    body.append(chunk.data(), chunk.length());
+                    take_excess_body(
+                        request_context, socket, expected_body_size);
                 }
 
                 if (request_context.get_writeable_request().body().size()
@@ -214,23 +252,109 @@ void BasicHttpServer::on_connection(Socket* socket)
                             LOG_ERROR(
                                 "Error resetting stream: "
                                 << reset_state.to_string());
-                            socket->respond(
-                                HttpResponse::create(
-                                    HttpStatus(HttpStatus::Code::
-                                                   _500_INTERNAL_SERVER_ERROR))
-                                    ->to_string());
-                            break;
+                            respond_with_error(socket);
+                            return false;
                         }
                     }
                     m_web_app->on_event(&request_context, HttpEvent::EOM);
-                    socket->respond(
-                        request_context.get_response()->to_string());
-                    break;
+                    respond(
+                        socket, *request_context.get_response(), keep_alive);
+                    return keep_alive;
                 }
             }
         }
     }
-    socket->close();
+    return false;
+}
+
+void BasicHttpServer::take_excess_body(
+    RequestContext& context,
+    Socket* socket,
+    std::size_t expected_body_size) const
+{
+    auto& body = context.get_writeable_request().body();
+    if (body.size() > expected_body_size) {
+        socket->push_unread(body.substr(expected_body_size));
+        body.resize(expected_body_size);
+    }
+}
+
+void BasicHttpServer::respond(
+    Socket* socket, HttpResponse& response, bool keep_alive) const
+{
+    // Without a length the client would read the body until the connection
+    // closes. Chunked bodies carry their own framing.
+    if (response.header().get_content_length().empty()
+        && response.header().get_item("Transfer-Encoding").empty()) {
+        response.header().set_item(
+            "Content-Length", std::to_string(response.body().size()));
+    }
+    response.header().set_item(
+        "Connection", keep_alive ? "keep-alive" : "close");
+    socket->respond(
+        response.header_to_string(),
+        hestia::ReadableBufferView(response.body()));
+}
+
+bool BasicHttpServer::respond_with_stream(
+    Socket* socket, RequestContext& request_context, bool keep_alive) const
+{
+    auto stream = request_context.get_stream();
+    if (!stream->has_source()) {
+        respond(socket, *request_context.get_response(), keep_alive);
+        return keep_alive;
+    }
+
+    // The body length comes from the stream source, if it knows it,
+    // otherwise the body is sent in chunks
+    const auto response = request_context.get_response();
+    auto& header        = response->header();
+    const bool chunked  = !stream->has_content();
+    if (chunked) {
+        header.set_item("Transfer-Encoding", "chunked");
+    }
+    else if (header.get_content_length().empty()) {
+        header.set_item(
+            "Content-Length", std::to_string(stream->get_source_size()));
+    }
+    respond(socket, *response, keep_alive);
+
+    LOG_INFO("Responding with stream");
+    if (!chunked) {
+        request_context.set_output_handle(socket->get_handle());
+    }
+    request_context.set_output_chunk_handler(
+        [socket, chunked](
+            const hestia::ReadableBufferView& buffer, bool finished) {
+            if (!chunked) {
+                socket->respond(buffer);
+                return buffer.length();
+            }
+
+            if (buffer.length() > 0) {
+                std::stringstream chunk_size;
+                chunk_size << std::hex << buffer.length() << "\r\n";
+                socket->respond(chunk_size.str());
+                socket->respond(buffer);
+                socket->respond("\r\n");
+            }
+            if (finished) {
+                socket->respond("0\r\n\r\n");
+            }
+            return buffer.length();
+        });
+    request_context.flush_stream();
+
+    // A failed stream replaces the response, but its headers are already
+    // sent so the client can only tell from the connection closing
+    return keep_alive && request_context.get_response() == response;
+}
+
+void BasicHttpServer::respond_with_error(Socket* socket) const
+{
+    auto response = HttpResponse::create(
+        HttpStatus(HttpStatus::Code::_500_INTERNAL_SERVER_ERROR));
+    respond(socket, *response, false);
 }
 
 void BasicHttpServer::wait_until_bound()
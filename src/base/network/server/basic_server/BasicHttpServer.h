@@ -6,6 +6,17 @@ class TcpServer;
 class Socket;
 
 namespace hestia {
+
+/**
+ * @brief A HTTP/1.1 server on top of the TcpServer
+ *
+ * Connections are persistent unless the client asks otherwise, keep-alive is
+ * disabled with a zero 'keep_alive_timeout' or 'max_requests_per_connection'
+ * is reached. Requests on a connection are handled in turn, each with a fresh
+ * RequestContext, and bytes read past the end of one request are kept for the
+ * next so pipelined requests work. Between requests the TcpServer watches
+ * the connection so it doesn't hold a worker while idle.
+ */
 class BasicHttpServer : public Server {
   public:
     BasicHttpServer(const Config& config, WebApp* web_app);
@@ -21,7 +32,10 @@ class BasicHttpServer : public Server {
   private:
     void on_connection(Socket* socket);
 
-    bool on_head(RequestContext& context, Socket* socket) const;
+    bool on_request(Socket* socket, bool keep_alive) const;
+
+    bool on_head(
+        RequestContext& context, Socket* socket, bool& keep_alive) const;
 
     bool on_body_chunk(
         RequestContext& context,
@@ -34,6 +48,19 @@ class BasicHttpServer : public Server {
 
     void receive_until_header_end(std::string& message, Socket* socket);
 
+    void respond(
+        Socket* socket, HttpResponse& response, bool keep_alive) const;
+
+    void respond_with_error(Socket* socket) const;
+
+    bool respond_with_stream(
+        Socket* socket, RequestContext& request_context, bool keep_alive) const;
+
+    void take_excess_body(
+        RequestContext& context,
+        Socket* socket,
+        std::size_t expected_body_size) const;
+
     std::unique_ptr<TcpServer> m_tcp_server;
 };
 }  // namespace hestia
\ No newline at end of file
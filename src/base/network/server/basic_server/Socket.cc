@@ -2,14 +2,20 @@
 
 #include "Logger.h"
 
+#include <chrono>
 #include <iostream>
+#include <thread>
 
 #include <arpa/inet.h>
 #include <errno.h>
+#include <fcntl.h>
 #include <netinet/in.h>
 #include <string.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
 #include <sys/socket.h>
 #include <sys/types.h>
+#include <sys/uio.h>
 #include <unistd.h>
 
 Socket::Ptr SocketFactory::create(const std::string& address, unsigned port)
@@ -37,7 +43,10 @@ Socket::Ptr Socket::create(int handle)
     return std::make_unique<Socket>(handle);
 }
 
-Socket::~Socket() {}
+Socket::~Socket()
+{
+    close_event_handles();
+}
 
 bool Socket::ok() const
 {
@@ -95,6 +104,11 @@ std::string Socket::get_address() const
     return m_address;
 }
 
+void Socket::set_listen_backlog(int backlog)
+{
+    m_listen_backlog = backlog;
+}
+
 void Socket::initialize()
 {
     m_handle         = ::socket(AF_INET, SOCK_STREAM, 0);
@@ -182,20 +196,69 @@ void Socket::do_listen(
     bound_func(true);
 
     while (bound()) {
-        const auto new_socket_handle = do_accept();
-        if (new_socket_handle < 0) {
-            if (!closed()) {
-                const std::string msg = "Socket: Accept failed";
-                {
-                    std::scoped_lock guard(m_mutex);
-                    m_state.on_bind_error(new_socket_handle, msg);
+        if (!wait_for_connection()) {
+            continue;
+        }
+
+        // Drain all pending connections - without epoll the accept blocks
+        // so only take one per pass.
+        while (bound()) {
+            errno                        = 0;
+            const auto new_socket_handle = do_accept();
+            if (new_socket_handle < 0) {
+                if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR
+                    || errno == ECONNABORTED) {
+                    break;
+                }
+                if (errno == EMFILE || errno == ENFILE) {
+                    LOG_WARN("Socket: Out of file handles - pausing accept");
+                    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                    break;
+                }
+                if (!closed()) {
+                    const std::string msg = "Socket: Accept failed";
+                    {
+                        std::scoped_lock guard(m_mutex);
+                        m_state.on_bind_error(new_socket_handle, msg);
+                    }
+                    LOG_ERROR(msg);
+                    do_close();
                 }
-                LOG_ERROR(msg);
-                do_close();
+                return;
+            }
+            connection_func(new_socket_handle);
+            if (m_epoll_handle == -1) {
+                break;
             }
-            return;
         }
-        connection_func(new_socket_handle);
+    }
+}
+
+bool Socket::wait_for_connection()
+{
+    if (m_epoll_handle == -1) {
+        return true;
+    }
+
+    epoll_event event;
+    errno         = 0;
+    const auto rc = ::epoll_wait(m_epoll_handle, &event, 1, -1);
+    if (rc < 0 && errno != EINTR) {
+        LOG_ERROR("Socket: epoll wait failed: " << ::strerror(errno));
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return rc > 0 && event.data.fd == m_handle;
+}
+
+void Socket::close_event_handles()
+{
+    if (m_epoll_handle != -1) {
+        ::close(m_epoll_handle);
+        m_epoll_handle = -1;
+    }
+    if (m_wakeup_handle != -1) {
+        ::close(m_wakeup_handle);
+        m_wakeup_handle = -1;
     }
 }
 
@@ -215,7 +278,8 @@ std::string Socket::send(const std::string& message)
 
     int n{0};
     {
-        n = ::write(m_handle, message.c_str(), message.length());
+        n = ::send(
+            m_handle, message.c_str(), message.length(), MSG_NOSIGNAL);
     }
     if (n < 0) {
         on_socker_error("Socket: Send failed.");
@@ -252,18 +316,62 @@ void Socket::on_socker_error(const std::string& message)
     }
 }
 
+void Socket::push_unread(const std::string& data)
+{
+    m_unread.insert(0, data);
+}
+
+bool Socket::has_unread() const
+{
+    return !m_unread.empty();
+}
+
+std::size_t Socket::increment_request_count()
+{
+    return ++m_request_count;
+}
+
+int Socket::get_handle() const
+{
+    return m_handle;
+}
+
 std::string Socket::recieve()
 {
-    const int buffer_size = 512;
-    std::vector<char> buffer(buffer_size, 0);
+    const auto buffer = recieve_buffer();
+    return std::string(buffer.data(), buffer.length());
+}
 
-    std::size_t result{0};
-    {
-        result = ::read(m_handle, buffer.data(), buffer_size);
+void Socket::set_buffer_size(std::size_t size)
+{
+    m_buffer_size = size;
+}
+
+hestia::ReadableBufferView Socket::recieve_buffer()
+{
+    if (!m_unread.empty()) {
+        m_returned_unread.clear();
+        m_returned_unread.swap(m_unread);
+        return hestia::ReadableBufferView(m_returned_unread);
     }
 
+    // Uninitialized so pages are only touched as reads fill them
+    thread_local std::unique_ptr<char[]> buffer;
+    thread_local std::size_t buffer_size{0};
+    if (buffer_size < m_buffer_size) {
+        buffer.reset(new char[m_buffer_size]);
+        buffer_size = m_buffer_size;
+    }
+
+    ssize_t result{0};
+    do {
+        errno  = 0;
+        result = ::read(m_handle, buffer.get(), m_buffer_size);
+    } while (result < 0 && errno == EINTR);
+
     if (result > 0) {
-        return std::string(buffer.begin(), buffer.begin() + result);
+        return hestia::ReadableBufferView(
+            buffer.get(), static_cast<std::size_t>(result));
     }
     else if (result == 0) {
         {
@@ -276,7 +384,7 @@ std::string Socket::recieve()
         LOG_ERROR(msg);
         {
             std::scoped_lock guard(m_mutex);
-            m_state.on_connect_error(result, msg);
+            m_state.on_connect_error(static_cast<int>(result), msg);
         }
     }
     return {};
@@ -285,26 +393,101 @@ std::string Socket::recieve()
 void Socket::close()
 {
     LOG_INFO("Closing Socket");
-    do_close();
     {
         std::scoped_lock guard(m_mutex);
         m_state.set_disconnected();
     }
+    do_close();
 }
 
-void Socket::respond(const std::string& message)
+bool Socket::respond(const std::string& message)
 {
-    std::size_t result{0};
-    {
-        result = ::write(
-            m_handle, message.c_str(), static_cast<int>(message.size()));
+    return respond(hestia::ReadableBufferView(message));
+}
+
+bool Socket::respond(const hestia::ReadableBufferView& buffer)
+{
+    iovec io_buffer{const_cast<char*>(buffer.data()), buffer.length()};
+    return write_all(&io_buffer, 1);
+}
+
+bool Socket::respond(
+    const std::string& header, const hestia::ReadableBufferView& body)
+{
+    iovec io_buffers[2] = {
+        {const_cast<char*>(header.data()), header.size()},
+        {const_cast<char*>(body.data()), body.length()}};
+    return write_all(io_buffers, 2);
+}
+
+bool Socket::write_all(iovec* buffers, int num_buffers)
+{
+    msghdr message{};
+    message.msg_iov    = buffers;
+    message.msg_iovlen = static_cast<std::size_t>(num_buffers);
+
+    while (message.msg_iovlen > 0) {
+        errno         = 0;
+        const auto rc = ::sendmsg(m_handle, &message, MSG_NOSIGNAL);
+        if (rc < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            LOG_ERROR("Socket: write failed: " << ::strerror(errno));
+            return false;
+        }
+
+        // Skip past whatever was written, possibly part way into a buffer
+        auto num_written = static_cast<std::size_t>(rc);
+        while (message.msg_iovlen > 0
+               && num_written >= message.msg_iov->iov_len) {
+            num_written -= message.msg_iov->iov_len;
+            message.msg_iov++;
+            message.msg_iovlen--;
+        }
+        if (message.msg_iovlen > 0) {
+            message.msg_iov->iov_base =
+                static_cast<char*>(message.msg_iov->iov_base) + num_written;
+            message.msg_iov->iov_len -= num_written;
+        }
     }
-    (void)result;
+    return true;
 }
 
 void Socket::listen_impl()
 {
-    ::listen(m_handle, 5);
+    ::listen(m_handle, m_listen_backlog);
+
+    const auto flags = ::fcntl(m_handle, F_GETFL, 0);
+    if (flags == -1 || ::fcntl(m_handle, F_SETFL, flags | O_NONBLOCK) == -1) {
+        LOG_WARN("Socket: Failed to set non-blocking - using blocking accept");
+        return;
+    }
+
+    m_epoll_handle  = ::epoll_create1(EPOLL_CLOEXEC);
+    m_wakeup_handle = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (m_epoll_handle == -1 || m_wakeup_handle == -1) {
+        LOG_WARN("Socket: Failed to create epoll - using blocking accept");
+        close_event_handles();
+        ::fcntl(m_handle, F_SETFL, flags);
+        return;
+    }
+
+    epoll_event listen_event;
+    listen_event.events  = EPOLLIN;
+    listen_event.data.fd = m_handle;
+    epoll_event wakeup_event;
+    wakeup_event.events  = EPOLLIN;
+    wakeup_event.data.fd = m_wakeup_handle;
+    if (::epoll_ctl(m_epoll_handle, EPOLL_CTL_ADD, m_handle, &listen_event)
+            == -1
+        || ::epoll_ctl(
+               m_epoll_handle, EPOLL_CTL_ADD, m_wakeup_handle, &wakeup_event)
+               == -1) {
+        LOG_WARN("Socket: Failed to register epoll - using blocking accept");
+        close_event_handles();
+        ::fcntl(m_handle, F_SETFL, flags);
+    }
 }
 
 int Socket::do_accept()
@@ -314,13 +497,19 @@ int Socket::do_accept()
 
     int rc{0};
     {
-        rc = ::accept(m_handle, (sockaddr*)&cli_addr, &clilen);
+        rc = ::accept4(
+            m_handle, (sockaddr*)&cli_addr, &clilen, SOCK_CLOEXEC);
     }
     return rc;
 }
 
 void Socket::do_close()
 {
+    if (m_wakeup_handle != -1) {
+        const uint64_t wakeup{1};
+        [[maybe_unused]] const auto rc =
+            ::write(m_wakeup_handle, &wakeup, sizeof(wakeup));
+    }
     ::shutdown(m_handle, 2);
     ::close(m_handle);
 }
@@ -1,11 +1,14 @@
 #pragma once
 
+#include "ReadableBufferView.h"
 #include "SocketState.h"
 
 #include <functional>
 #include <memory>
 #include <mutex>
 
+struct iovec;
+
 /**
  * @brief Socket class - wraps the system socket library
  *
@@ -76,9 +79,20 @@ class Socket {
      */
     void close();
 
+    /**
+     * Set the maximum number of pending connections queued by the system
+     * before they are accepted - must be called before do_listen
+     * @param backlog the maximum number of pending connections
+     */
+    void set_listen_backlog(int backlog);
+
     /**
      * Start listening at the previously supplied address and port
      * Call the input func for any new connections
+     *
+     * The listening socket is non-blocking and waited on with epoll, so
+     * all pending connections are accepted on each wake-up and close() can
+     * interrupt the wait.
      * @param connection_func function to be called for any new connections
      */
     using onIncomingConnectionFunc = std::function<void(int)>;
@@ -116,11 +130,68 @@ class Socket {
      */
     std::string recieve();
 
+    /**
+     * Wait on the connection to receive content into a buffer reused by
+     * all sockets on the calling thread, avoiding a copy and allocation
+     * per read
+     * @return a view of the received content, valid until the next receive
+     * on this thread
+     */
+    hestia::ReadableBufferView recieve_buffer();
+
+    /**
+     * Set the size of the buffer used to receive content
+     * @param size the buffer size
+     */
+    void set_buffer_size(std::size_t size);
+
+    /**
+     * Return data to the socket to be handed out again by the next recieve,
+     * e.g. the start of a pipelined request read along with the current one
+     * @param data the data to return
+     */
+    void push_unread(const std::string& data);
+
+    /**
+     * True if there is returned data waiting to be recieved
+     * @return True if there is returned data waiting to be recieved
+     */
+    bool has_unread() const;
+
+    /**
+     * Count a request as handled on this connection
+     * @return the number of requests handled so far, including this one
+     */
+    std::size_t increment_request_count();
+
+    /**
+     * Return the system socket handle
+     * @return the system socket handle
+     */
+    int get_handle() const;
+
     /**
      * Respond to a received message
      * @param message the response
+     * @return True if the whole response was sent
+     */
+    bool respond(const std::string& message);
+
+    /**
+     * Respond to a received message
+     * @param buffer the response
+     * @return True if the whole response was sent
+     */
+    bool respond(const hestia::ReadableBufferView& buffer);
+
+    /**
+     * Respond with a header and body in a single gathered write
+     * @param header the response header
+     * @param body the response body
+     * @return True if the whole response was sent
      */
-    void respond(const std::string& message);
+    bool respond(
+        const std::string& header, const hestia::ReadableBufferView& body);
 
     /**
      * Send a message
@@ -147,7 +218,20 @@ class Socket {
 
     virtual int do_accept();
 
+    bool wait_for_connection();
+
+    void close_event_handles();
+
+    bool write_all(iovec* buffers, int num_buffers);
+
     int m_handle{0};
+    std::size_t m_buffer_size{1024 * 1024};
+    std::string m_unread;
+    std::string m_returned_unread;
+    std::size_t m_request_count{0};
+    int m_listen_backlog{1024};
+    int m_epoll_handle{-1};
+    int m_wakeup_handle{-1};
 
     mutable std::mutex m_mutex;
     SocketState m_state;
@@ -3,11 +3,32 @@
 #include "Logger.h"
 #include "Socket.h"
 
+#include <algorithm>
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
 TcpServer::TcpServer(std::unique_ptr<SocketFactory> socket_factory) :
+    TcpServer(Config(), std::move(socket_factory))
+{
+}
+
+TcpServer::TcpServer(
+    const Config& config, std::unique_ptr<SocketFactory> socket_factory) :
+    m_config(config),
     m_socket_factory(
         socket_factory ? std::move(socket_factory) :
                          std::make_unique<SocketFactory>())
 {
+    if (m_config.m_num_workers == 0) {
+        // Handlers block on socket I/O, so oversubscribe the cores
+        m_config.m_num_workers =
+            4 * std::max(1U, std::thread::hardware_concurrency());
+    }
+    if (m_config.m_max_connections < m_config.m_num_workers) {
+        m_config.m_max_connections = m_config.m_num_workers;
+    }
 }
 
 TcpServer::~TcpServer()
@@ -23,12 +44,24 @@ void TcpServer::listen(
     m_connection_callback = connection_success_func;
     m_failed_callback     = connection_failed_func;
 
+    {
+        std::scoped_lock guard(m_connections_mutex);
+        m_shutting_down = false;
+    }
+    m_workers = std::make_unique<ThreadPool>(m_config.m_num_workers);
+    if (m_config.m_keep_alive_timeout > 0) {
+        start_idle_watcher();
+    }
+
     m_working_socket = m_socket_factory->create(address.m_host, address.m_port);
+    m_working_socket->set_listen_backlog(m_config.m_listen_backlog);
 
     auto socket_task = [this]() {
         LOG_INFO("Launching server bind socket");
         auto on_connection = [this](int handle) {
-            this->on_connection(Socket::create(handle));
+            auto socket = Socket::create(handle);
+            socket->set_buffer_size(m_config.m_buffer_size);
+            this->on_connection(std::move(socket));
         };
 
         auto on_bound = [this](bool bound) {
@@ -58,6 +91,12 @@ void TcpServer::listen(
 
 void TcpServer::shut_down()
 {
+    {
+        std::scoped_lock guard(m_connections_mutex);
+        m_shutting_down = true;
+    }
+    m_connections_cv.notify_all();
+
     if (m_working_socket) {
         m_working_socket->close();
         LOG_INFO("Waiting for Socket to finish");
@@ -66,28 +105,236 @@ void TcpServer::shut_down()
         }
         m_working_socket.reset();
     }
-    m_threads.remove_marked();
-    m_threads.join_and_clear_all();
+    stop_idle_watcher();
+    if (m_workers) {
+        LOG_INFO("Waiting for workers to finish");
+        m_workers->shut_down();
+        m_workers.reset();
+    }
     LOG_INFO("Finished shutdown");
 }
 
 void TcpServer::on_connection(Socket::Ptr client_connection)
 {
-    m_threads.remove_marked();
+    {
+        std::unique_lock<std::mutex> lck(m_connections_mutex);
+        if (m_num_connections >= m_config.m_max_connections) {
+            LOG_WARN(
+                "Connection limit of " << m_config.m_max_connections
+                                       << " reached - pausing accept");
+            m_connections_cv.wait(lck, [this]() {
+                return m_shutting_down
+                       || m_num_connections < m_config.m_max_connections;
+            });
+        }
+        if (m_shutting_down) {
+            client_connection->close();
+            return;
+        }
+        m_num_connections++;
+    }
+
+    dispatch(std::move(client_connection));
+}
 
-    auto worker_func = [this](Socket::Ptr client_connection) {
-        m_connection_callback(client_connection.get());
-        this->on_thread_complete(std::this_thread::get_id());
+void TcpServer::dispatch(std::shared_ptr<Socket> connection)
+{
+    auto worker_func = [this, connection]() {
+        // Queued connections, e.g. idle keep-alive ones which became
+        // readable, are dropped rather than served once shutting down
+        if (is_shutting_down()) {
+            connection->close();
+            on_connection_complete(nullptr);
+            return;
+        }
+
+        try {
+            m_connection_callback(connection.get());
+        }
+        catch (const std::exception& e) {
+            LOG_ERROR("Error handling connection: " << e.what());
+            connection->close();
+        }
+        on_connection_complete(connection);
     };
 
-    auto worker = std::make_unique<std::thread>(
-        worker_func, std::move(client_connection));
-    m_threads.add(std::move(worker));
+    if (!m_workers->add_task(worker_func)) {
+        connection->close();
+        on_connection_complete(nullptr);
+    }
+}
+
+void TcpServer::on_connection_complete(std::shared_ptr<Socket> connection)
+{
+    {
+        std::scoped_lock guard(m_connections_mutex);
+        m_num_connections--;
+    }
+    m_connections_cv.notify_one();
+
+    if (!connection || !connection->connected()) {
+        return;
+    }
+    if (m_config.m_keep_alive_timeout > 0 && !is_shutting_down()) {
+        add_idle(connection);
+    }
+    else {
+        connection->close();
+    }
+}
+
+bool TcpServer::is_shutting_down() const
+{
+    std::scoped_lock guard(m_connections_mutex);
+    return m_shutting_down;
+}
+
+std::size_t TcpServer::get_num_connections() const
+{
+    std::scoped_lock guard(m_connections_mutex);
+    return m_num_connections;
+}
+
+std::size_t TcpServer::get_num_idle_connections() const
+{
+    std::scoped_lock guard(m_idle_mutex);
+    return m_idle_connections.size();
+}
+
+void TcpServer::start_idle_watcher()
+{
+    m_idle_epoll_handle  = ::epoll_create1(EPOLL_CLOEXEC);
+    m_idle_wakeup_handle = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (m_idle_epoll_handle == -1 || m_idle_wakeup_handle == -1) {
+        LOG_ERROR("Failed to create idle connection watcher - no keep-alive");
+        stop_idle_watcher();
+        m_config.m_keep_alive_timeout = 0;
+        return;
+    }
+
+    epoll_event wakeup_event;
+    wakeup_event.events  = EPOLLIN;
+    wakeup_event.data.fd = m_idle_wakeup_handle;
+    ::epoll_ctl(
+        m_idle_epoll_handle, EPOLL_CTL_ADD, m_idle_wakeup_handle,
+        &wakeup_event);
+
+    m_idle_watcher = std::thread(&TcpServer::watch_idle, this);
+}
+
+void TcpServer::stop_idle_watcher()
+{
+    if (m_idle_watcher.joinable()) {
+        const uint64_t wakeup{1};
+        [[maybe_unused]] const auto rc =
+            ::write(m_idle_wakeup_handle, &wakeup, sizeof(wakeup));
+        m_idle_watcher.join();
+    }
+
+    std::scoped_lock guard(m_idle_mutex);
+    for (auto& [handle, idle] : m_idle_connections) {
+        idle.m_socket->close();
+    }
+    m_idle_connections.clear();
+
+    if (m_idle_epoll_handle != -1) {
+        ::close(m_idle_epoll_handle);
+        m_idle_epoll_handle = -1;
+    }
+    if (m_idle_wakeup_handle != -1) {
+        ::close(m_idle_wakeup_handle);
+        m_idle_wakeup_handle = -1;
+    }
 }
 
-void TcpServer::on_thread_complete(std::thread::id id)
+void TcpServer::add_idle(std::shared_ptr<Socket> connection)
 {
-    m_threads.mark_for_removal(id);
+    if (connection->has_unread()) {
+        {
+            std::scoped_lock guard(m_connections_mutex);
+            m_num_connections++;
+        }
+        dispatch(connection);
+        return;
+    }
+
+    const auto handle = connection->get_handle();
+    const auto deadline =
+        std::chrono::steady_clock::now()
+        + std::chrono::seconds(m_config.m_keep_alive_timeout);
+
+    std::scoped_lock guard(m_idle_mutex);
+    if (m_idle_epoll_handle == -1) {
+        connection->close();
+        return;
+    }
+    m_idle_connections[handle] = {connection, deadline};
+
+    epoll_event event;
+    event.events  = EPOLLIN | EPOLLRDHUP | EPOLLONESHOT;
+    event.data.fd = handle;
+    if (::epoll_ctl(m_idle_epoll_handle, EPOLL_CTL_ADD, handle, &event)
+        == -1) {
+        LOG_ERROR("Failed to watch idle connection - closing it");
+        m_idle_connections.erase(handle);
+        connection->close();
+    }
+}
+
+void TcpServer::watch_idle()
+{
+    const int max_events{64};
+    epoll_event events[max_events];
+
+    while (true) {
+        const auto num_events =
+            ::epoll_wait(m_idle_epoll_handle, events, max_events, 1000);
+
+        std::vector<std::shared_ptr<Socket>> ready;
+        {
+            std::scoped_lock guard(m_idle_mutex);
+            for (int idx = 0; idx < num_events; idx++) {
+                const auto handle = events[idx].data.fd;
+                if (handle == m_idle_wakeup_handle) {
+                    return;
+                }
+
+                auto iter = m_idle_connections.find(handle);
+                if (iter == m_idle_connections.end()) {
+                    continue;
+                }
+                ::epoll_ctl(
+                    m_idle_epoll_handle, EPOLL_CTL_DEL, handle, nullptr);
+                ready.push_back(iter->second.m_socket);
+                m_idle_connections.erase(iter);
+            }
+
+            const auto now = std::chrono::steady_clock::now();
+            for (auto iter = m_idle_connections.begin();
+                 iter != m_idle_connections.end();) {
+                if (iter->second.m_deadline <= now) {
+                    ::epoll_ctl(
+                        m_idle_epoll_handle, EPOLL_CTL_DEL, iter->first,
+                        nullptr);
+                    iter->second.m_socket->close();
+                    iter = m_idle_connections.erase(iter);
+                }
+                else {
+                    iter++;
+                }
+            }
+        }
+
+        // Connections already accepted aren't held back by the limit, they
+        // only count towards it for new connections.
+        for (auto& connection : ready) {
+            {
+                std::scoped_lock guard(m_connections_mutex);
+                m_num_connections++;
+            }
+            dispatch(connection);
+        }
+    }
 }
 
 void TcpServer::set_block_on_listen(bool block)
@@ -1,15 +1,31 @@
 #pragma once
 
 #include "ConnectionResult.h"
-#include "ThreadCollection.h"
+#include "ThreadPool.h"
 
+#include <chrono>
 #include <condition_variable>
 #include <functional>
 #include <future>
+#include <thread>
+#include <unordered_map>
 
 class Socket;
 class SocketFactory;
 
+/**
+ * @brief A TCP server handing accepted connections to a pool of workers
+ *
+ * A single acceptor thread waits on the listening socket and queues each new
+ * connection on a fixed-size worker pool, so the thread count doesn't grow
+ * with the number of clients. Once 'max_connections' connections are queued
+ * or being handled the acceptor stops accepting, leaving further clients in
+ * the system listen backlog until a worker frees up.
+ *
+ * If 'keep_alive_timeout' is set, a connection the handler leaves open is
+ * watched without tying up a worker and queued again once the client sends
+ * more data, or closed once it has been idle for the timeout in seconds.
+ */
 class TcpServer {
   public:
     struct Address {
@@ -18,11 +34,23 @@ class TcpServer {
         unsigned int m_port{8000};
     };
 
+    struct Config {
+        std::size_t m_num_workers{0};
+        int m_listen_backlog{1024};
+        std::size_t m_max_connections{4096};
+        std::size_t m_keep_alive_timeout{0};
+        std::size_t m_buffer_size{1024 * 1024};
+    };
+
     using onConnectionSuccessFunc = std::function<void(Socket*)>;
     using onConnectionFailedFunc = std::function<void(const ConnectionResult&)>;
 
     TcpServer(std::unique_ptr<SocketFactory> socket_factory = nullptr);
 
+    TcpServer(
+        const Config& config,
+        std::unique_ptr<SocketFactory> socket_factory = nullptr);
+
     virtual ~TcpServer();
 
     void listen(
@@ -36,14 +64,57 @@ class TcpServer {
 
     void wait_until_bound();
 
+    /**
+     * Number of connections queued or being handled by a worker
+     *
+     * @return Number of active connections
+     */
+    std::size_t get_num_connections() const;
+
+    /**
+     * Number of open connections waiting for a client to send more data
+     *
+     * @return Number of idle connections
+     */
+    std::size_t get_num_idle_connections() const;
+
   private:
+    struct IdleConnection {
+        std::shared_ptr<Socket> m_socket;
+        std::chrono::steady_clock::time_point m_deadline;
+    };
+
     void on_connection(std::unique_ptr<Socket> client_handle);
 
-    void on_thread_complete(std::thread::id id);
+    void dispatch(std::shared_ptr<Socket> connection);
+
+    void on_connection_complete(std::shared_ptr<Socket> connection);
 
-    ThreadCollection m_threads;
+    bool is_shutting_down() const;
+
+    void start_idle_watcher();
+
+    void stop_idle_watcher();
+
+    void add_idle(std::shared_ptr<Socket> connection);
+
+    void watch_idle();
+
+    Config m_config;
+    std::unique_ptr<ThreadPool> m_workers;
     bool m_block_on_listen{false};
 
+    std::size_t m_num_connections{0};
+    bool m_shutting_down{false};
+    mutable std::mutex m_connections_mutex;
+    std::condition_variable m_connections_cv;
+
+    int m_idle_epoll_handle{-1};
+    int m_idle_wakeup_handle{-1};
+    std::thread m_idle_watcher;
+    std::unordered_map<int, IdleConnection> m_idle_connections;
+    mutable std::mutex m_idle_mutex;
+
     std::unique_ptr<Socket> m_working_socket;
     std::future<int> m_working_socket_task;
     std::condition_variable m_working_socket_bound_cv;
@@ -64,7 +64,7 @@ void ProxygenRequestHandler::onBody(std::unique_ptr<folly::IOBuf> body) noexcept
     if (m_request_context->get_response()->get_completion_status()
         == HttpResponse::CompletionStatus::AWAITING_BODY_CHUNK) {
         ReadableBufferView read_buffer(body->data(), body->length());
-        auto status = m_request_context->get_stream()->write(read_buffer);
+        auto status = m_request_context->write_to_stream(read_buffer);
         LOG_INFO("Wrote " << status.m_num_transferred << " bytes to stream");
         if (!status.ok()) {
             LOG_ERROR(
@@ -109,7 +109,7 @@ void ProxygenRequestHandler::onEOM() noexcept
             [this,
              event_base](const ReadableBufferView& buffer, bool finished) {
                 on_output_chunk(buffer, finished, event_base);
-                return 0;
+                return buffer.length();
             });
 
         m_request_context->set_output_complete_handler(
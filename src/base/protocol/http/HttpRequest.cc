@@ -59,7 +59,7 @@ void HttpRequest::on_chunk(const std::string& msg)
                 }
             }
             else if (buffer == "\r") {
-                if (first_line) {
+                if (first_line && !m_header_buffer.empty()) {
                     m_header.add_line(m_header_buffer + buffer);
                     m_header_buffer.clear();
                 }
@@ -122,6 +122,19 @@ bool HttpRequest::is_content_outstanding() const
     return std::stoul(content_length) > m_body.size();
 }
 
+bool HttpRequest::should_keep_alive() const
+{
+    const auto connection =
+        StringUtils::to_lower(m_header.get_item("Connection"));
+    if (connection == "close") {
+        return false;
+    }
+    else if (connection == "keep-alive") {
+        return true;
+    }
+    return !StringUtils::starts_with(m_preamble.m_version, "HTTP/1.0");
+}
+
 void HttpRequest::overwrite_path(const std::string& new_path)
 {
     m_preamble.m_path = new_path;
@@ -43,6 +43,14 @@ class HttpRequest {
 
     bool is_content_outstanding() const;
 
+    /**
+     * True if the client wants the connection kept open after this request,
+     * going by the Connection header and otherwise the HTTP version
+     *
+     * @return True if the connection should be kept open
+     */
+    bool should_keep_alive() const;
+
     std::string to_string() const;
 
     void set_context(RequestContext* context);
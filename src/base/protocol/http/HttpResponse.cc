@@ -77,13 +77,17 @@ void HttpResponse::append_to_body(const std::string& body)
 }
 
 std::string HttpResponse::to_string() const
+{
+    return header_to_string() + m_body;
+}
+
+std::string HttpResponse::header_to_string() const
 {
     std::stringstream sstr;
     sstr << "HTTP/1.1"
          << " " << m_code << " " << m_message << "\n";
     sstr << m_header.to_string();
     sstr << "\n";
-    sstr << m_body;
     return sstr.str();
 }
 
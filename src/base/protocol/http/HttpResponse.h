@@ -56,6 +56,8 @@ class HttpResponse {
 
     std::string to_string() const;
 
+    std::string header_to_string() const;
+
   private:
     int m_code{200};
     CompletionStatus m_completion_status{CompletionStatus::FINISHED};
@@ -7,7 +7,7 @@ static std::unordered_map<HttpStatus::Code, HttpStatus::CodeAndId> errors = {
     {HttpStatus::Code::_100_CONTINUE, {100, "Continue"}},
     {HttpStatus::Code::_200_OK, {200, "OK"}},
     {HttpStatus::Code::_201_CREATED, {201, "Created"}},
-    {HttpStatus::Code::_204_NO_CONTENT, {201, "No Content"}},
+    {HttpStatus::Code::_204_NO_CONTENT, {204, "No Content"}},
     {HttpStatus::Code::_400_BAD_REQUEST, {400, "Bad Request"}},
     {HttpStatus::Code::_403_FORBIDDEN, {403, "Forbidden"}},
     {HttpStatus::Code::_404_NOT_FOUND, {404, "Not Found"}},
@@ -15,6 +15,7 @@ static std::unordered_map<HttpStatus::Code, HttpStatus::CodeAndId> errors = {
     {HttpStatus::Code::_411_LENGTH_REQURED, {411, "Length Required"}},
     {HttpStatus::Code::_500_INTERNAL_SERVER_ERROR,
      {500, "Internal Server Error"}},
+    {HttpStatus::Code::_503_SERVICE_UNAVAILABLE, {503, "Service Unavailable"}},
     {HttpStatus::Code::CUSTOM, {0, "Custom"}},
 };
 
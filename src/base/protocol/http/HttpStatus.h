@@ -17,6 +17,7 @@ class HttpStatus {
         _409_CONFLICT,
         _411_LENGTH_REQURED,
         _500_INTERNAL_SERVER_ERROR,
+        _503_SERVICE_UNAVAILABLE,
         CUSTOM
     };
 
@@ -60,6 +60,47 @@ void RequestContext::set_output_complete_handler(onCompleteFunc func)
     m_on_output_complete = func;
 }
 
+void RequestContext::set_input_filter(RequestInputFilter::Ptr filter)
+{
+    m_input_filter = std::move(filter);
+}
+
+RequestInputFilter* RequestContext::get_input_filter() const
+{
+    return m_input_filter.get();
+}
+
+void RequestContext::set_input_rollback_handler(onInputRollbackFunc func)
+{
+    m_on_input_rollback = func;
+}
+
+void RequestContext::rollback_input()
+{
+    if (m_on_input_rollback) {
+        LOG_INFO("Rolling back request input.");
+        m_on_input_rollback();
+        m_on_input_rollback = nullptr;
+    }
+}
+
+void RequestContext::set_input_commit_handler(onInputCommitFunc func)
+{
+    m_on_input_commit = func;
+}
+
+HttpResponse::Ptr RequestContext::commit_input()
+{
+    m_on_input_rollback = nullptr;
+    if (!m_on_input_commit) {
+        return nullptr;
+    }
+    LOG_INFO("Committing request input.");
+    auto commit       = std::move(m_on_input_commit);
+    m_on_input_commit = nullptr;
+    return commit();
+}
+
 void RequestContext::set_response(HttpResponse::Ptr http_response)
 {
     m_response = std::move(http_response);
@@ -82,26 +123,45 @@ bool RequestContext::finished() const
 
 void RequestContext::flush_stream()
 {
-    if (!m_on_output_chunk) {
-        return;
-    }
-
-    std::vector<char> buffer(m_chunk_size, 0);
-    WriteableBufferView writeable_buffer(&buffer[0], m_chunk_size);
-    while (true) {
-        const auto result = m_stream->read(writeable_buffer);
-        if (!result.ok()) {
-            m_response = HttpResponse::create(500, "Internal Server Error");
-            break;
+    if (m_output_handle != -1 && m_stream->supports_direct_send()) {
+        while (true) {
+            const auto result =
+                m_stream->send_to(m_output_handle, m_chunk_size);
+            if (!result.ok()) {
+                m_response = HttpResponse::create(500, "Internal Server Error");
+                break;
+            }
+            if (result.finished()) {
+                break;
+            }
         }
-
-        ReadableBufferView readable_buffer(
-            &buffer[0], result.m_num_transferred);
-        m_on_output_chunk(readable_buffer, result.finished());
-        if (result.finished()) {
-            break;
+    }
+    else if (m_on_output_chunk) {
+        std::vector<char> buffer(m_chunk_size, 0);
+        WriteableBufferView writeable_buffer(&buffer[0], m_chunk_size);
+        while (true) {
+            const auto result = m_stream->read(writeable_buffer);
+            if (!result.ok()) {
+                m_response =
+                    HttpResponse::create(500, "Internal Server Error");
+                break;
+            }
+
+            ReadableBufferView readable_buffer(
+                &buffer[0], result.m_num_transferred);
+            if (m_on_output_chunk(readable_buffer, result.finished())
+                < readable_buffer.length()) {
+                LOG_INFO("Output chunk not taken - stopping stream flush.");
+                break;
+            }
+            if (result.finished()) {
+                break;
+            }
         }
     }
+    else {
+        return;
+    }
 
     if (const auto stream_state = m_stream->reset(); !stream_state.ok()) {
         m_response = HttpResponse::create(500, "Internal Server Error");
@@ -116,6 +176,9 @@ void RequestContext::flush_stream()
 
 IOResult RequestContext::write_to_stream(const ReadableBufferView& buffer)
 {
+    if (m_input_filter) {
+        return m_input_filter->write(buffer, m_stream.get());
+    }
     return m_stream->write(buffer);
 }
 
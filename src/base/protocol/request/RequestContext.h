@@ -4,6 +4,7 @@
 #include "HttpRequest.h"
 #include "HttpResponse.h"
 #include "ReadableBufferView.h"
+#include "RequestInputFilter.h"
 #include "Stream.h"
 
 #include <atomic>
@@ -40,6 +41,23 @@ class RequestContext {
 
     std::size_t get_chunk_size() const { return m_chunk_size; }
 
+    void set_chunk_size(std::size_t size) { m_chunk_size = size; }
+
+    /**
+     * If set, and the stream source supports it, flush_stream sends the
+     * stream content straight to this system handle instead of through the
+     * output chunk handler.
+     *
+     * @param handle a system handle, e.g. the client socket
+     */
+    void set_output_handle(int handle) { m_output_handle = handle; }
+
+    /**
+     * Set a handler for stream output chunks. If it takes fewer bytes than
+     * it is given, e.g. as the client has gone, flush_stream stops.
+     *
+     * @param func The chunk handler
+     */
     using onChunkFunc = std::function<std::size_t(
         const ReadableBufferView& buffer, bool finished)>;
     void set_output_chunk_handler(onChunkFunc func);
@@ -50,15 +68,56 @@ class RequestContext {
     using onCompleteFunc = std::function<void(const HttpResponse* response)>;
     void set_output_complete_handler(onCompleteFunc func);
 
+    /**
+     * If set, body chunks given to write_to_stream pass through the filter
+     * on their way to the stream.
+     *
+     * @param filter The input filter
+     */
+    void set_input_filter(RequestInputFilter::Ptr filter);
+
+    RequestInputFilter* get_input_filter() const;
+
+    /**
+     * Set a handler to undo the effects of the request body, e.g. remove an
+     * object it was written to, if it is rejected once complete.
+     *
+     * @param func The rollback handler
+     */
+    using onInputRollbackFunc = std::function<void()>;
+    void set_input_rollback_handler(onInputRollbackFunc func);
+
+    void rollback_input();
+
+    /**
+     * Set a handler to put the request body in place, e.g. swap in an object
+     * it was staged in, once it is accepted.
+     *
+     * @param func The commit handler - returning the response to the request
+     */
+    using onInputCommitFunc = std::function<HttpResponse::Ptr()>;
+    void set_input_commit_handler(onInputCommitFunc func);
+
+    /**
+     * Run the commit handler, if any, and drop the rollback handler
+     *
+     * @return The handler's response, or nullptr if none was set
+     */
+    HttpResponse::Ptr commit_input();
+
     void set_response(HttpResponse::Ptr http_response);
 
     [[nodiscard]] IOResult write_to_stream(const ReadableBufferView& buffer);
 
   private:
     std::size_t m_chunk_size{4000};
+    int m_output_handle{-1};
     onInputCompleteFunc m_on_input_complete;
     onCompleteFunc m_on_output_complete;
     onChunkFunc m_on_output_chunk;
+    onInputRollbackFunc m_on_input_rollback;
+    onInputCommitFunc m_on_input_commit;
+    RequestInputFilter::Ptr m_input_filter;
 
     HttpRequest m_request;
     HttpResponse::Ptr m_response;
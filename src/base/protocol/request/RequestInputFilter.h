@@ -0,0 +1,33 @@
+#pragma once
+
+#include "ReadableBufferView.h"
+#include "Stream.h"
+
+#include <memory>
+
+namespace hestia {
+
+/**
+ * @brief Sees each chunk of a request body on its way into the request Stream
+ *
+ * A filter can check the body as it streams in, e.g. against a signature,
+ * or transform it before writing it on, e.g. to strip a chunked encoding.
+ */
+class RequestInputFilter {
+  public:
+    using Ptr = std::unique_ptr<RequestInputFilter>;
+
+    virtual ~RequestInputFilter() = default;
+
+    /**
+     * Take a chunk of the body and write it, or what it decodes to, to the
+     * stream
+     *
+     * @param buffer The body chunk
+     * @param stream The stream to write to
+     * @return The state of the write - with the number of body bytes consumed
+     */
+    [[nodiscard]] virtual IOResult write(
+        const ReadableBufferView& buffer, Stream* stream) noexcept = 0;
+};
+}  // namespace hestia
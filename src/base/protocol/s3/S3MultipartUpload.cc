@@ -0,0 +1,187 @@
+#include "S3MultipartUpload.h"
+
+#include "ErrorUtils.h"
+#include "XmlDocument.h"
+#include "XmlElement.h"
+#include "XmlParser.h"
+
+#include <stdexcept>
+
+namespace hestia {
+
+static void add_text_element(
+    XmlElement& parent, const std::string& tag, const std::string& text)
+{
+    auto element = XmlElement::create(tag);
+    element->set_text(text);
+    parent.add_child(std::move(element));
+}
+
+static XmlDocument::Ptr parse_document(
+    const std::string& body, const std::string& root_tag)
+{
+    if (body.empty()) {
+        throw std::runtime_error(
+            SOURCE_LOC() + " | Empty body parsing " + root_tag + ".");
+    }
+
+    XmlParser parser;
+    auto xml_doc = parser.run(body);
+    if (!xml_doc->has_root()) {
+        throw std::runtime_error(
+            SOURCE_LOC() + " | No root element in parsed xml body.");
+    }
+
+    if (xml_doc->get_root()->get_tag_name() != root_tag) {
+        throw std::runtime_error(
+            SOURCE_LOC() + " | Missing required tag: " + root_tag
+            + " parsing xml body.");
+    }
+    return xml_doc;
+}
+
+S3Part::S3Part(const XmlElement& element)
+{
+    for (const auto& child : element.get_children()) {
+        if (child->get_tag_name() == "PartNumber") {
+            m_number = std::stoull(child->get_text());
+        }
+        else if (child->get_tag_name() == "ETag") {
+            m_etag = child->get_text();
+        }
+        else if (child->get_tag_name() == "Size") {
+            m_size = std::stoull(child->get_text());
+        }
+        else if (child->get_tag_name() == "LastModified") {
+            m_last_modified = S3Timestamp(child->get_text());
+        }
+    }
+}
+
+XmlElementPtr S3Part::to_xml() const
+{
+    auto root = XmlElement::create("Part");
+    add_text_element(*root, "PartNumber", std::to_string(m_number));
+    add_text_element(*root, "ETag", m_etag);
+    if (m_size > 0) {
+        add_text_element(*root, "Size", std::to_string(m_size));
+        add_text_element(*root, "LastModified", m_last_modified.m_value);
+    }
+    return root;
+}
+
+void S3CreateMultipartUploadResponse::deserialize(const std::string& body)
+{
+    const auto xml_doc = parse_document(body, "InitiateMultipartUploadResult");
+    for (const auto& child : xml_doc->get_root()->get_children()) {
+        if (child->get_tag_name() == "Bucket") {
+            m_bucket = child->get_text();
+        }
+        else if (child->get_tag_name() == "Key") {
+            m_key = child->get_text();
+        }
+        else if (child->get_tag_name() == "UploadId") {
+            m_upload_id = child->get_text();
+        }
+    }
+}
+
+std::string S3CreateMultipartUploadResponse::to_string() const
+{
+    auto root = XmlElement::create("InitiateMultipartUploadResult");
+    add_text_element(*root, "Bucket", m_bucket);
+    add_text_element(*root, "Key", m_key);
+    add_text_element(*root, "UploadId", m_upload_id);
+    return XmlDocument::to_string(*root);
+}
+
+void S3CompleteMultipartUploadRequest::deserialize(const std::string& body)
+{
+    const auto xml_doc = parse_document(body, "CompleteMultipartUpload");
+    for (const auto& child : xml_doc->get_root()->get_children()) {
+        if (child->get_tag_name() == "Part") {
+            m_parts.push_back(S3Part(*child));
+        }
+    }
+}
+
+std::string S3CompleteMultipartUploadRequest::to_string() const
+{
+    auto root = XmlElement::create("CompleteMultipartUpload");
+    for (const auto& part : m_parts) {
+        auto part_element = XmlElement::create("Part");
+        add_text_element(
+            *part_element, "PartNumber", std::to_string(part.m_number));
+        add_text_element(*part_element, "ETag", part.m_etag);
+        root->add_child(std::move(part_element));
+    }
+    return XmlDocument::to_string(*root);
+}
+
+void S3CompleteMultipartUploadResponse::deserialize(const std::string& body)
+{
+    const auto xml_doc =
+        parse_document(body, "CompleteMultipartUploadResult");
+    for (const auto& child : xml_doc->get_root()->get_children()) {
+        if (child->get_tag_name() == "Location") {
+            m_location = child->get_text();
+        }
+        else if (child->get_tag_name() == "Bucket") {
+            m_bucket = child->get_text();
+        }
+        else if (child->get_tag_name() == "Key") {
+            m_key = child->get_text();
+        }
+        else if (child->get_tag_name() == "ETag") {
+            m_etag = child->get_text();
+        }
+    }
+}
+
+std::string S3CompleteMultipartUploadResponse::to_string() const
+{
+    auto root = XmlElement::create("CompleteMultipartUploadResult");
+    add_text_element(*root, "Location", m_location);
+    add_text_element(*root, "Bucket", m_bucket);
+    add_text_element(*root, "Key", m_key);
+    add_text_element(*root, "ETag", m_etag);
+    return XmlDocument::to_string(*root);
+}
+
+std::string S3ListPartsResponse::to_string() const
+{
+    auto root = XmlElement::create("ListPartsResult");
+    add_text_element(*root, "Bucket", m_bucket);
+    add_text_element(*root, "Key", m_key);
+    add_text_element(*root, "UploadId", m_upload_id);
+    add_text_element(
+        *root, "PartNumberMarker", std::to_string(m_part_number_marker));
+    add_text_element(
+        *root, "NextPartNumberMarker",
+        std::to_string(m_next_part_number_marker));
+    add_text_element(*root, "MaxParts", std::to_string(m_max_parts));
+    add_text_element(*root, "IsTruncated", m_is_truncated ? "true" : "false");
+    for (const auto& part : m_parts) {
+        root->add_child(part.to_xml());
+    }
+    return XmlDocument::to_string(*root);
+}
+
+std::string S3ListMultipartUploadsResponse::to_string() const
+{
+    auto root = XmlElement::create("ListMultipartUploadsResult");
+    add_text_element(*root, "Bucket", m_bucket);
+    add_text_element(*root, "MaxUploads", std::to_string(m_max_uploads));
+    add_text_element(*root, "IsTruncated", m_is_truncated ? "true" : "false");
+    for (const auto& upload : m_uploads) {
+        auto upload_element = XmlElement::create("Upload");
+        add_text_element(*upload_element, "Key", upload.m_key);
+        add_text_element(*upload_element, "UploadId", upload.m_upload_id);
+        add_text_element(
+            *upload_element, "Initiated", upload.m_initiated.m_value);
+        root->add_child(std::move(upload_element));
+    }
+    return XmlDocument::to_string(*root);
+}
+
+}  // namespace hestia
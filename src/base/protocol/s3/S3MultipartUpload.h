@@ -0,0 +1,108 @@
+#pragma once
+
+#include "S3Types.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace hestia {
+
+class XmlElement;
+using XmlElementPtr = std::unique_ptr<XmlElement>;
+
+/**
+ * @brief A part of an S3 multipart upload
+ */
+class S3Part {
+  public:
+    S3Part() = default;
+
+    S3Part(const XmlElement& element);
+
+    XmlElementPtr to_xml() const;
+
+    std::size_t m_number{0};
+    std::string m_etag;
+    std::size_t m_size{0};
+    S3Timestamp m_last_modified;
+};
+
+/**
+ * @brief Body of the response to a CreateMultipartUpload request
+ */
+class S3CreateMultipartUploadResponse {
+  public:
+    void deserialize(const std::string& body);
+
+    std::string to_string() const;
+
+    std::string m_bucket;
+    std::string m_key;
+    std::string m_upload_id;
+};
+
+/**
+ * @brief Body of a CompleteMultipartUpload request - the parts to make up the
+ * object, in order.
+ */
+class S3CompleteMultipartUploadRequest {
+  public:
+    void deserialize(const std::string& body);
+
+    std::string to_string() const;
+
+    std::vector<S3Part> m_parts;
+};
+
+/**
+ * @brief Body of the response to a CompleteMultipartUpload request
+ */
+class S3CompleteMultipartUploadResponse {
+  public:
+    void deserialize(const std::string& body);
+
+    std::string to_string() const;
+
+    std::string m_location;
+    std::string m_bucket;
+    std::string m_key;
+    std::string m_etag;
+};
+
+/**
+ * @brief Body of the response to a ListParts request
+ */
+class S3ListPartsResponse {
+  public:
+    std::string to_string() const;
+
+    std::string m_bucket;
+    std::string m_key;
+    std::string m_upload_id;
+    std::size_t m_part_number_marker{0};
+    std::size_t m_next_part_number_marker{0};
+    std::size_t m_max_parts{0};
+    bool m_is_truncated{false};
+    std::vector<S3Part> m_parts;
+};
+
+/**
+ * @brief Body of the response to a ListMultipartUploads request
+ */
+class S3ListMultipartUploadsResponse {
+  public:
+    struct Upload {
+        std::string m_key;
+        std::string m_upload_id;
+        S3Timestamp m_initiated;
+    };
+
+    std::string to_string() const;
+
+    std::string m_bucket;
+    std::size_t m_max_uploads{0};
+    bool m_is_truncated{false};
+    std::vector<Upload> m_uploads;
+};
+}  // namespace hestia
@@ -1,5 +1,6 @@
 #include "S3Request.h"
 
+#include "S3SigningKeyCache.h"
 #include "XmlAttribute.h"
 #include "XmlElement.h"
 
@@ -235,7 +236,9 @@ void S3Request::populate_headers(
 }
 
 void S3Request::populate_authorization_headers(
-    PayloadSignatureType payload_sig_type, HttpRequest& req) const
+    PayloadSignatureType payload_sig_type,
+    HttpRequest& req,
+    S3SigningKeyCache* signing_keys) const
 {
     std::string payload_sig = "UNSIGNED-PAYLOAD";
     if (payload_sig_type == PayloadSignatureType::SIGNED) {
@@ -246,13 +249,22 @@ void S3Request::populate_authorization_headers(
             payload_sig = HashUtils::do_sha256(req.body());
         }
     }
+    populate_authorization_headers(payload_sig, req, signing_keys);
+}
+
+void S3Request::populate_authorization_headers(
+    const std::string& payload_sig,
+    HttpRequest& req,
+    S3SigningKeyCache* signing_keys) const
+{
     req.get_header().set_item("x-amz-content-sha256", payload_sig);
 
     const auto credential = m_user_context.m_user_id + "/" + get_scope();
     const std::string auth_value =
         "AWS4-HMAC-SHA256 Credential=" + credential
         + ",SignedHeaders=" + get_signed_headers_flat() + ",Signature="
-        + get_signature(req, payload_sig, m_user_context.m_user_secret_key);
+        + get_signature(
+            req, payload_sig, m_user_context.m_user_secret_key, signing_keys);
     req.get_header().set_item("authorization", auth_value);
 }
 
@@ -311,28 +323,54 @@ std::string S3Request::create_string_to_sign(
 std::string S3Request::get_signature(
     const HttpRequest& req,
     const std::string& payload_sha256,
-    const std::string& secret_key) const
+    const std::string& secret_key,
+    S3SigningKeyCache* signing_keys) const
 {
     return get_signature(
-        create_string_to_sign(req, payload_sha256), secret_key);
+        create_string_to_sign(req, payload_sha256), secret_key, signing_keys);
 }
 
 std::string S3Request::get_signature(
-    const std::string& string_to_sign, const std::string& secret_key) const
+    const std::string& string_to_sign,
+    const std::string& secret_key,
+    S3SigningKeyCache* signing_keys) const
+{
+    return HashUtils::do_h_mac_hex(
+        get_signing_key(secret_key, signing_keys), string_to_sign);
+}
+
+std::string S3Request::get_signing_key(
+    const std::string& secret_key, S3SigningKeyCache* signing_keys) const
+{
+    const auto date       = get_date();
+    const auto derive_key = [this, &date, &secret_key]() {
+        const auto key             = "AWS4" + secret_key;
+        const auto date_key        = HashUtils::do_h_mac(key, date);
+        const auto date_region_key = HashUtils::do_h_mac(date_key, m_region);
+        const auto date_region_service_key =
+            HashUtils::do_h_mac(date_region_key, m_service);
+        return HashUtils::do_h_mac(date_region_service_key, m_scope_suffix);
+    };
+    if (signing_keys == nullptr) {
+        return derive_key();
+    }
+
+    // The secret is only held in the cache as a hash
+    return signing_keys->get(
+        date,
+        m_region + '\n' + m_service + '\n' + HashUtils::do_sha256(secret_key),
+        derive_key);
+}
+
+std::string S3Request::get_date() const
 {
-    const auto key             = "AWS4" + secret_key;
-    const auto date_key        = HashUtils::do_h_mac(key, m_timestamp.m_value);
-    const auto date_region_key = HashUtils::do_h_mac(date_key, m_region);
-    const auto date_region_service_key =
-        HashUtils::do_h_mac(date_region_key, m_service);
-    const auto signing_key =
-        HashUtils::do_h_mac(date_region_service_key, m_scope_suffix);
-    return HashUtils::do_h_mac_hex(signing_key, string_to_sign);
+    // The scope has the date only, while clients time stamp requests in full
+    return m_timestamp.m_value.substr(0, 8);
 }
 
 std::string S3Request::get_scope() const
 {
-    return m_timestamp.m_value + "/" + m_region + "/" + m_service + "/"
+    return get_date() + "/" + m_region + "/" + m_service + "/"
            + m_scope_suffix;
 }
 
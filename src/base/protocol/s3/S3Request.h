@@ -11,6 +11,7 @@
 namespace hestia {
 
 class XmlElement;
+class S3SigningKeyCache;
 
 enum class S3UriStyle { VIRTUAL_HOST, PATH };
 
@@ -69,7 +70,8 @@ class S3Request {
     std::string get_signature(
         const HttpRequest& req,
         const std::string& payload_sha256,
-        const std::string& secret_key) const;
+        const std::string& secret_key,
+        S3SigningKeyCache* signing_keys = nullptr) const;
 
     void populate_headers(
         const std::string& bucket_name,
@@ -77,7 +79,36 @@ class S3Request {
         const std::string& payload_type = {}) const;
 
     void populate_authorization_headers(
-        PayloadSignatureType payload_sig_type, HttpRequest& req) const;
+        PayloadSignatureType payload_sig_type,
+        HttpRequest& req,
+        S3SigningKeyCache* signing_keys = nullptr) const;
+
+    /**
+     * Sign the request with the given value for the payload hash - a SHA256
+     * of a body not held in memory, or a streaming payload type.
+     *
+     * @param payload_sig The value for the 'x-amz-content-sha256' header
+     * @param req The request to add the headers to
+     * @param signing_keys If set, the signing key is taken from this cache
+     */
+    void populate_authorization_headers(
+        const std::string& payload_sig,
+        HttpRequest& req,
+        S3SigningKeyCache* signing_keys = nullptr) const;
+
+    /**
+     * The key derived from the secret key, date and scope which signs the
+     * request - and the chunks of a streaming payload.
+     *
+     * @param secret_key The user's secret key
+     * @param signing_keys If set, the key is taken from this cache
+     * @return The binary signing key
+     */
+    std::string get_signing_key(
+        const std::string& secret_key,
+        S3SigningKeyCache* signing_keys = nullptr) const;
+
+    std::string get_scope() const;
 
     std::string to_string() const;
 
@@ -112,8 +143,6 @@ class S3Request {
 
     void add_query(const std::pair<std::string, std::string>& query);
 
-    std::string get_scope() const;
-
     void sort_queries();
 
     void parse_credentials(const std::string& credentials);
@@ -127,7 +156,11 @@ class S3Request {
         const HttpRequest& request, const std::string& payload_sha256) const;
 
     std::string get_signature(
-        const std::string& string_to_sign, const std::string& secret_key) const;
+        const std::string& string_to_sign,
+        const std::string& secret_key,
+        S3SigningKeyCache* signing_keys) const;
+
+    std::string get_date() const;
 
     std::string get_signed_headers_flat() const;
 
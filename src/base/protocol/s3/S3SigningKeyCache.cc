@@ -0,0 +1,38 @@
+#include "S3SigningKeyCache.h"
+
+namespace hestia {
+
+std::string S3SigningKeyCache::get(
+    const std::string& date,
+    const std::string& scope_id,
+    const deriveKeyFunc& derive_key)
+{
+    {
+        std::scoped_lock guard(m_mutex);
+        if (date == m_date) {
+            if (const auto iter = m_keys.find(scope_id);
+                iter != m_keys.end()) {
+                return iter->second;
+            }
+        }
+    }
+
+    auto signing_key = derive_key();
+
+    std::scoped_lock guard(m_mutex);
+    if (date > m_date) {
+        m_date = date;
+        m_keys.clear();
+    }
+    if (date == m_date) {
+        m_keys.emplace(scope_id, signing_key);
+    }
+    return signing_key;
+}
+
+std::size_t S3SigningKeyCache::size() const
+{
+    std::scoped_lock guard(m_mutex);
+    return m_keys.size();
+}
+}  // namespace hestia
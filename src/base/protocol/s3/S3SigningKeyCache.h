@@ -0,0 +1,42 @@
+#pragma once
+
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace hestia {
+
+/**
+ * @brief The SigV4 signing keys derived for a client's requests
+ *
+ * A signing key only changes with the date, region, service and secret key,
+ * so a client signing many requests derives it once a day rather than with
+ * four HMACs for every request. Keys for earlier dates are dropped once the
+ * date moves on.
+ */
+class S3SigningKeyCache {
+  public:
+    using deriveKeyFunc = std::function<std::string()>;
+
+    /**
+     * Get a signing key, deriving it if it isn't cached
+     *
+     * @param date The request date, as YYYYMMDD
+     * @param scope_id Identifies the region, service and secret key
+     * @param derive_key Derives the key if it isn't cached
+     * @return The binary signing key
+     */
+    std::string get(
+        const std::string& date,
+        const std::string& scope_id,
+        const deriveKeyFunc& derive_key);
+
+    std::size_t size() const;
+
+  private:
+    mutable std::mutex m_mutex;
+    std::string m_date;
+    std::unordered_map<std::string, std::string> m_keys;
+};
+}  // namespace hestia
@@ -22,6 +22,14 @@ static std::unordered_map<
         {S3StatusCode::_400_INVALID_BUCKET_NAME,
          {HttpStatus::Code::_400_BAD_REQUEST,
           {"InvalidBucketName", "The specified bucket is not valid."}}},
+        {S3StatusCode::_400_INVALID_PART,
+         {HttpStatus::Code::_400_BAD_REQUEST,
+          {"InvalidPart",
+           "One or more of the specified parts could not be found. The part might not have been uploaded, or the specified entity tag might not have matched the part's entity tag."}}},
+        {S3StatusCode::_400_INVALID_PART_ORDER,
+         {HttpStatus::Code::_400_BAD_REQUEST,
+          {"InvalidPartOrder",
+           "The list of parts was not in ascending order. The parts list must be specified in order by part number."}}},
         {S3StatusCode::_400_INVALID_SIGNATURE_TYPE,
          {HttpStatus::Code::_400_BAD_REQUEST,
           {"InvalidRequest", "Please use AWS4-HMAC-SHA256."}}},
@@ -29,6 +37,14 @@ static std::unordered_map<
          {HttpStatus::Code::_400_BAD_REQUEST,
           {"AuthorizationHeaderMalformed",
            "The authorization header you provided is invalid."}}},
+        {S3StatusCode::_400_MALFORMED_XML,
+         {HttpStatus::Code::_400_BAD_REQUEST,
+          {"MalformedXML",
+           "The XML you provided was not well-formed or did not validate against our published schema."}}},
+        {S3StatusCode::_400_X_AMZ_CONTENT_SHA256_MISMATCH,
+         {HttpStatus::Code::_400_BAD_REQUEST,
+          {"XAmzContentSHA256Mismatch",
+           "The provided 'x-amz-content-sha256' header does not match what was computed."}}},
         {S3StatusCode::_403_INVALID_KEY_ID,
          {HttpStatus::Code::_403_FORBIDDEN,
           {"InvalidAccessKeyId", "The given key is not valid."}}},
@@ -48,6 +64,10 @@ static std::unordered_map<
          {HttpStatus::Code::_404_NOT_FOUND,
           {"NoSuchVersion",
            "The version ID specified in the request does not match any existing version."}}},
+        {S3StatusCode::_404_NO_SUCH_UPLOAD,
+         {HttpStatus::Code::_404_NOT_FOUND,
+          {"NoSuchUpload",
+           "The specified multipart upload does not exist. The upload ID might be invalid, or the multipart upload might have been aborted or completed."}}},
         {S3StatusCode::_404_NOT_IMPLEMENTED,
          {HttpStatus::Code::_404_NOT_FOUND,
           {"NotImplemented",
@@ -67,6 +87,9 @@ static std::unordered_map<
          {HttpStatus::Code::_400_BAD_REQUEST,
           {"InternalError",
            "We encountered an internal error. Please try again."}}},
+        {S3StatusCode::_503_SLOW_DOWN,
+         {HttpStatus::Code::_503_SERVICE_UNAVAILABLE,
+          {"SlowDown", "Please reduce your request rate."}}},
 };
 
 S3Status::S3Status(
@@ -124,10 +147,8 @@ S3Status::S3Status(const HttpResponse& http_response)
         }
     }
 
-    if (m_code_str.empty()) {
-        m_code = HttpStatus::get_code_from_numeric(http_response.code());
-    }
-    else {
+    m_code = HttpStatus::get_code_from_numeric(http_response.code());
+    if (!m_code_str.empty()) {
         for (const auto& error : errors) {
             if (error.second.second.first == m_code_str) {
                 m_s3_code = error.first;
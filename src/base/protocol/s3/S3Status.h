@@ -39,7 +39,7 @@ class S3Status : public HttpStatus {
 
     XmlElementPtr to_xml() const;
 
-    S3StatusCode m_s3_code;
+    S3StatusCode m_s3_code{S3StatusCode::CUSTOM};
     std::string m_code_str;
     std::string m_request_id;
     S3Path m_path;
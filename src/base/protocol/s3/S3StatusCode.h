@@ -5,19 +5,25 @@ enum class S3StatusCode {
     _400_INCOMPLETE_BODY,
     _400_INVALID_ARGUMENT,
     _400_INVALID_BUCKET_NAME,
+    _400_INVALID_PART,
+    _400_INVALID_PART_ORDER,
     _400_INVALID_SIGNATURE_TYPE,
     _400_AUTHORIZATION_HEADER_MALFORMED,
+    _400_MALFORMED_XML,
+    _400_X_AMZ_CONTENT_SHA256_MISMATCH,
     _403_INVALID_KEY_ID,
     _403_ACCESS_DENIED,
     _403_SIGNATURE_DOES_NOT_MATCH,
     _404_NO_SUCH_BUCKET,
     _404_NO_SUCH_KEY,
     _404_NO_SUCH_VERSION,
+    _404_NO_SUCH_UPLOAD,
     _404_NOT_IMPLEMENTED,
     _409_BUCKET_EXISTS,
     _409_BUCKET_NOT_EMPTY,
     _411_MISSING_CONTENT_LENGTH,
     _500_INTERNAL_SERVER_ERROR,
+    _503_SLOW_DOWN,
     CUSTOM
 };
 }
\ No newline at end of file
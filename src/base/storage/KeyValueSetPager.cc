@@ -0,0 +1,42 @@
+#include "KeyValueSetPager.h"
+
+#include <algorithm>
+#include <iterator>
+
+namespace hestia {
+
+void KeyValueSetPager::list_page(
+    const std::string& key,
+    const std::set<std::string>& members,
+    std::size_t offset,
+    std::size_t count,
+    std::vector<std::string>& values)
+{
+    auto member_iter = members.begin();
+    auto cursor_iter = m_cursors.find(key);
+    if (offset > 0 && cursor_iter != m_cursors.end()
+        && cursor_iter->second.m_offset == offset) {
+        member_iter = members.upper_bound(cursor_iter->second.m_last_member);
+    }
+    else {
+        std::advance(member_iter, std::min(offset, members.size()));
+    }
+
+    for (; member_iter != members.end()
+           && (count == 0 || values.size() < count);
+         member_iter++) {
+        values.push_back(*member_iter);
+    }
+
+    if (values.empty() || member_iter == members.end()) {
+        if (cursor_iter != m_cursors.end()) {
+            m_cursors.erase(cursor_iter);
+        }
+        return;
+    }
+    auto& cursor         = m_cursors[key];
+    cursor.m_offset      = offset + values.size();
+    cursor.m_last_member = values.back();
+}
+
+}  // namespace hestia
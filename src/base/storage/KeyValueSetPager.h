@@ -0,0 +1,44 @@
+#pragma once
+
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace hestia {
+
+/**
+ * @brief Pages through the sorted sets of a key-value store
+ *
+ * The end of the last page listed from each set is remembered, so a request
+ * for the page following it resumes with a lower_bound on the last member
+ * rather than stepping over every earlier member again. Other offsets fall
+ * back to stepping from the start of the set. As with any cursor, members
+ * added or removed before it since the last page shift later pages by rank,
+ * but no member is listed twice or skipped while paging.
+ */
+class KeyValueSetPager {
+  public:
+    /**
+     * List a page of a set's members
+     * @param key the set key
+     * @param members the set's members
+     * @param offset number of members to skip
+     * @param count maximum number of members to list, 0 for no limit
+     * @param values filled with the page of members
+     */
+    void list_page(
+        const std::string& key,
+        const std::set<std::string>& members,
+        std::size_t offset,
+        std::size_t count,
+        std::vector<std::string>& values);
+
+  private:
+    struct Cursor {
+        std::size_t m_offset{0};
+        std::string m_last_member;
+    };
+    std::unordered_map<std::string, Cursor> m_cursors;
+};
+}  // namespace hestia
@@ -4,6 +4,10 @@
 
 #include "Logger.h"
 
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+
 #define CATCH_FLOW()                                                           \
     catch (const RequestException<RequestError<CrudErrorCode>>& e)             \
     {                                                                          \
@@ -63,7 +67,18 @@ KeyValueStoreResponse::Ptr KeyValueStoreClient::make_request(
             break;
         case KeyValueStoreRequestMethod::SET_LIST:
             try {
-                set_list(request.get_keys(), response->ids());
+                if (request.has_range()) {
+                    set_list_range(
+                        request.get_keys(), request.get_offset(),
+                        request.get_count(), response->ids(),
+                        response->set_sizes());
+                }
+                else {
+                    set_list(request.get_keys(), response->ids());
+                    for (const auto& values : response->ids()) {
+                        response->set_sizes().push_back(values.size());
+                    }
+                }
             }
             CATCH_FLOW();
             break;
@@ -73,6 +88,26 @@ KeyValueStoreResponse::Ptr KeyValueStoreClient::make_request(
             }
             CATCH_FLOW();
             break;
+        case KeyValueStoreRequestMethod::SET_LIST_BETWEEN:
+            try {
+                set_list_between(
+                    request.get_keys(), request.get_min(), request.get_max(),
+                    response->ids());
+                for (const auto& values : response->ids()) {
+                    response->set_sizes().push_back(values.size());
+                }
+            }
+            CATCH_FLOW();
+            break;
+        case KeyValueStoreRequestMethod::SET_INTERSECT:
+            try {
+                std::vector<std::string> values;
+                set_intersect(request.get_keys(), values);
+                response->set_sizes().push_back(values.size());
+                response->ids().push_back(std::move(values));
+            }
+            CATCH_FLOW();
+            break;
         default:
             const std::string msg =
                 "Method: " + request.method_as_string() + " not supported";
@@ -86,6 +121,129 @@ KeyValueStoreResponse::Ptr KeyValueStoreClient::make_request(
     return response;
 }
 
+KeyValueStoreResponse::Ptr KeyValueStoreClient::make_batch_request(
+    const std::vector<KeyValueStoreRequest>& requests) const noexcept
+{
+    if (requests.empty()) {
+        return std::make_unique<KeyValueStoreResponse>(KeyValueStoreRequest(
+            KeyValueStoreRequestMethod::STRING_SET, VecKeyValuePair{}));
+    }
+
+    const auto& request = requests.front();
+    auto response       = std::make_unique<KeyValueStoreResponse>(request);
+    try {
+        apply_batch(requests);
+    }
+    CATCH_FLOW();
+    return response;
+}
+
+void KeyValueStoreClient::apply_batch(
+    const std::vector<KeyValueStoreRequest>& requests) const
+{
+    for (const auto& request : requests) {
+        switch (request.method()) {
+            case KeyValueStoreRequestMethod::STRING_SET:
+                string_set(request.get_kv_pairs());
+                break;
+            case KeyValueStoreRequestMethod::STRING_REMOVE:
+                string_remove(request.get_keys());
+                break;
+            case KeyValueStoreRequestMethod::SET_ADD:
+                set_add(request.get_kv_pairs());
+                break;
+            case KeyValueStoreRequestMethod::SET_REMOVE:
+                set_remove(request.get_kv_pairs());
+                break;
+            case KeyValueStoreRequestMethod::STRING_EXISTS:
+            case KeyValueStoreRequestMethod::STRING_GET:
+            case KeyValueStoreRequestMethod::SET_LIST:
+            case KeyValueStoreRequestMethod::SET_INTERSECT:
+            case KeyValueStoreRequestMethod::SET_LIST_BETWEEN:
+            default:
+                throw std::runtime_error(
+                    "Method: " + request.method_as_string()
+                    + " not supported in a batch");
+        }
+    }
+}
+
+void KeyValueStoreClient::set_list_range(
+    const std::vector<std::string>& keys,
+    std::size_t offset,
+    std::size_t count,
+    std::vector<std::vector<std::string>>& values,
+    std::vector<std::size_t>& set_sizes) const
+{
+    std::vector<std::vector<std::string>> full_sets;
+    set_list(keys, full_sets);
+
+    for (auto& members : full_sets) {
+        set_sizes.push_back(members.size());
+        std::sort(members.begin(), members.end());
+
+        const auto begin = std::min(offset, members.size());
+        const auto end   = count == 0 ?
+                               members.size() :
+                               std::min(begin + count, members.size());
+        values.emplace_back(
+            std::make_move_iterator(members.begin() + begin),
+            std::make_move_iterator(members.begin() + end));
+    }
+}
+
+void KeyValueStoreClient::set_list_between(
+    const std::vector<std::string>& keys,
+    const std::string& min,
+    const std::string& max,
+    std::vector<std::vector<std::string>>& values) const
+{
+    std::vector<std::vector<std::string>> full_sets;
+    set_list(keys, full_sets);
+
+    for (auto& members : full_sets) {
+        std::vector<std::string> in_range;
+        for (auto& member : members) {
+            if (member >= min && member < max) {
+                in_range.push_back(std::move(member));
+            }
+        }
+        std::sort(in_range.begin(), in_range.end());
+        values.push_back(std::move(in_range));
+    }
+}
+
+void KeyValueStoreClient::set_intersect(
+    const std::vector<std::string>& keys,
+    std::vector<std::string>& values) const
+{
+    if (keys.empty()) {
+        return;
+    }
+
+    std::vector<std::vector<std::string>> sets;
+    set_list(keys, sets);
+
+    // Start from the smallest set so the working result stays small
+    std::sort(
+        sets.begin(), sets.end(), [](const auto& lhs, const auto& rhs) {
+            return lhs.size() < rhs.size();
+        });
+
+    values = std::move(sets[0]);
+    std::sort(values.begin(), values.end());
+    for (std::size_t idx = 1; idx < sets.size() && !values.empty(); idx++) {
+        auto& members = sets[idx];
+        std::sort(members.begin(), members.end());
+
+        std::vector<std::string> common;
+        std::set_intersection(
+            values.begin(), values.end(), members.begin(), members.end(),
+            std::back_inserter(common));
+        values = std::move(common);
+    }
+}
+
 void KeyValueStoreClient::on_exception(
     const KeyValueStoreRequest& request,
     KeyValueStoreResponse* response,
@@ -18,6 +18,17 @@ class KeyValueStoreClient {
     [[nodiscard]] KeyValueStoreResponse::Ptr make_request(
         const KeyValueStoreRequest& request) const noexcept;
 
+    /**
+     * Apply a batch of write requests (STRING_SET, STRING_REMOVE, SET_ADD and
+     * SET_REMOVE) in order as a single unit. Stores that support it apply
+     * the batch atomically in one round trip.
+     *
+     * @param requests The write requests
+     * @return A single response for the batch, in error if any write failed
+     */
+    [[nodiscard]] KeyValueStoreResponse::Ptr make_batch_request(
+        const std::vector<KeyValueStoreRequest>& requests) const noexcept;
+
   protected:
     virtual void string_get(
         const std::vector<std::string>& key,
@@ -37,8 +48,63 @@ class KeyValueStoreClient {
         const std::vector<std::string>& key,
         std::vector<std::vector<std::string>>& values) const = 0;
 
+    /**
+     * List a page of each set's members in sorted order, along with the full
+     * size of each set. The default implementation lists the full sets - stores
+     * should override it to avoid loading members outside the page.
+     *
+     * @param keys The set keys
+     * @param offset Number of members to skip in each set
+     * @param count Maximum number of members to return per set, 0 for no limit
+     * @param values Filled with the page of members for each set
+     * @param set_sizes Filled with the total number of members in each set
+     */
+    virtual void set_list_range(
+        const std::vector<std::string>& keys,
+        std::size_t offset,
+        std::size_t count,
+        std::vector<std::vector<std::string>>& values,
+        std::vector<std::size_t>& set_sizes) const;
+
     virtual void set_remove(const VecKeyValuePair& entry) const = 0;
 
+    /**
+     * List the members of each set between two bounds, in sorted order. The
+     * default implementation lists the full sets - stores keeping their sets
+     * ordered should override it to find the bounds directly.
+     *
+     * @param keys The set keys
+     * @param min The lowest member to list
+     * @param max The member to list up to, but not including
+     * @param values Filled with the members in range for each set
+     */
+    virtual void set_list_between(
+        const std::vector<std::string>& keys,
+        const std::string& min,
+        const std::string& max,
+        std::vector<std::vector<std::string>>& values) const;
+
+    /**
+     * Find the members common to all of the given sets. The default
+     * implementation lists each set and intersects them in the client - stores
+     * that can intersect sets natively should override it.
+     *
+     * @param keys The set keys
+     * @param values Filled with the sorted members common to all sets
+     */
+    virtual void set_intersect(
+        const std::vector<std::string>& keys,
+        std::vector<std::string>& values) const;
+
+    /**
+     * Apply the writes in a batch. The default implementation applies each in
+     * turn, so is neither atomic nor a single round trip.
+     *
+     * @param requests The write requests
+     */
+    virtual void apply_batch(
+        const std::vector<KeyValueStoreRequest>& requests) const;
+
     void on_exception(
         const KeyValueStoreRequest& request,
         KeyValueStoreResponse* response,
@@ -52,6 +52,20 @@ class ObjectStoreClient {
         const ObjectStoreRequest& request,
         Stream* stream = nullptr) const noexcept;
 
+    /**
+     * Return objects to move off the store to make room for a PUT - for
+     * stores with a fixed size which leave moving them to their owner.
+     *
+     * @param request the PUT request
+     * @return ids of the objects, in the order they should go - none by default
+     */
+    virtual std::vector<std::string> get_eviction_candidates(
+        const ObjectStoreRequest& request) const
+    {
+        (void)request;
+        return {};
+    }
+
   protected:
     virtual bool exists(const StorageObject& object) const = 0;
 
@@ -0,0 +1,43 @@
+#include "BlockAllocator.h"
+
+#include <algorithm>
+
+namespace hestia {
+BlockAllocator::BlockAllocator(
+    std::size_t block_size, std::size_t blocks_per_slab) :
+    m_block_size(std::max<std::size_t>(block_size, 1)),
+    m_blocks_per_slab(std::max<std::size_t>(blocks_per_slab, 1))
+{
+}
+
+BlockAllocator::Ptr BlockAllocator::create(
+    std::size_t block_size, std::size_t blocks_per_slab)
+{
+    return std::make_shared<BlockAllocator>(block_size, blocks_per_slab);
+}
+
+char* BlockAllocator::allocate()
+{
+    std::scoped_lock guard(m_mutex);
+    if (m_free.empty()) {
+        // Slabs start small and double, so small stores stay small
+        const auto num_blocks = std::min(
+            m_blocks_per_slab, std::size_t{1} << std::min<std::size_t>(
+                                   m_slabs.size(), 16));
+        m_slabs.emplace_back(new char[m_block_size * num_blocks]);
+        const auto slab = m_slabs.back().get();
+        for (std::size_t idx = num_blocks; idx > 0; idx--) {
+            m_free.push_back(slab + (idx - 1) * m_block_size);
+        }
+    }
+    const auto block = m_free.back();
+    m_free.pop_back();
+    return block;
+}
+
+void BlockAllocator::release(char* block)
+{
+    std::scoped_lock guard(m_mutex);
+    m_free.push_back(block);
+}
+}  // namespace hestia
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace hestia {
+
+/**
+ * @brief Hands out fixed-size blocks of memory carved from larger slabs
+ *
+ * Released blocks go on a free list for reuse rather than back to the
+ * system, so a store which is filling and emptying doesn't keep hitting the
+ * heap. Slabs double in size up to 'blocks_per_slab' blocks and are only
+ * freed when the allocator is destroyed. Thread-safe.
+ */
+class BlockAllocator {
+  public:
+    using Ptr = std::shared_ptr<BlockAllocator>;
+
+    /**
+     * Constructor
+     *
+     * @param block_size Size of each block
+     * @param blocks_per_slab Most blocks allocated from the system at a time
+     */
+    BlockAllocator(std::size_t block_size, std::size_t blocks_per_slab = 64);
+
+    static Ptr create(
+        std::size_t block_size = s_default_block_size,
+        std::size_t blocks_per_slab = 64);
+
+    /**
+     * Get a block - its content is undefined
+     *
+     * @return The block - give it back with 'release'
+     */
+    char* allocate();
+
+    /**
+     * Give back a block from 'allocate'
+     *
+     * @param block The block
+     */
+    void release(char* block);
+
+    std::size_t get_block_size() const { return m_block_size; }
+
+    static constexpr std::size_t s_default_block_size{64 * 1024};
+
+  private:
+    std::size_t m_block_size{s_default_block_size};
+    std::size_t m_blocks_per_slab{64};
+    std::mutex m_mutex;
+    std::vector<std::unique_ptr<char[]>> m_slabs;
+    std::vector<char*> m_free;
+};
+}  // namespace hestia
@@ -1,80 +1,151 @@
 #include "BlockList.h"
 
-#include <iostream>
+#include <algorithm>
+#include <cstring>
+#include <iterator>
 
 namespace hestia {
-void BlockList::add_block(
-    const hestia::Extent& extent,
-    const ReadableBufferView& buffer,
-    std::size_t offset)
+BlockList::BlockList(BlockAllocator::Ptr allocator) :
+    m_allocator(allocator ? std::move(allocator) : BlockAllocator::create())
 {
-    if (const auto [iter, added] =
-            m_blocks.emplace(extent.m_offset, Block(extent, buffer, offset));
-        !added) {
-        iter->second = Block(extent, buffer, offset);
+}
+
+BlockList::BlockList(const BlockList& other) : m_allocator(other.m_allocator)
+{
+    *this = other;
+}
+
+BlockList::BlockList(BlockList&& other) noexcept :
+    m_allocator(other.m_allocator),
+    m_blocks(std::move(other.m_blocks)),
+    m_extents(std::move(other.m_extents))
+{
+    other.m_blocks.clear();
+    other.m_extents.clear();
+}
+
+BlockList::~BlockList()
+{
+    clear();
+}
+
+BlockList& BlockList::operator=(const BlockList& other)
+{
+    if (this != &other) {
+        clear();
+        m_allocator = other.m_allocator;
+        for (const auto& [index, block] : other.m_blocks) {
+            auto copy = m_allocator->allocate();
+            std::memcpy(copy, block, m_allocator->get_block_size());
+            m_blocks.emplace(index, copy);
+        }
+        m_extents = other.m_extents;
     }
+    return *this;
+}
+
+BlockList& BlockList::operator=(BlockList&& other) noexcept
+{
+    if (this != &other) {
+        clear();
+        m_allocator = other.m_allocator;
+        m_blocks    = std::move(other.m_blocks);
+        m_extents   = std::move(other.m_extents);
+        other.m_blocks.clear();
+        other.m_extents.clear();
+    }
+    return *this;
+}
+
+void BlockList::clear()
+{
+    for (const auto& [index, block] : m_blocks) {
+        m_allocator->release(block);
+    }
+    m_blocks.clear();
+    m_extents.clear();
 }
 
 hestia::Extent BlockList::get_extent_bounds() const
 {
-    if (m_blocks.empty()) {
+    if (m_extents.empty()) {
         return {};
     }
 
-    auto bounds     = m_blocks.begin()->second.extent();
-    const auto end  = m_blocks.rbegin()->second.extent().get_end();
-    bounds.m_length = end - bounds.m_offset;
-    return bounds;
+    const auto offset = m_extents.begin()->first;
+    return {offset, m_extents.rbegin()->second - offset};
 }
 
-void BlockList::write(const Extent& extent, const ReadableBufferView& buffer)
+std::size_t BlockList::get_memory_size() const
+{
+    return m_blocks.size() * m_allocator->get_block_size();
+}
+
+std::size_t BlockList::get_num_new_blocks(const Extent& extent) const
 {
-    auto working_ext = extent;
     if (extent.empty()) {
-        working_ext = {0, buffer.length()};
+        return 0;
     }
 
-    if (auto bounds = get_extent_bounds();
-        !bounds.includes_or_overlaps(working_ext)) {
-        add_block(working_ext, buffer);
-        return;
+    const auto block_size = m_allocator->get_block_size();
+    const auto first      = extent.m_offset / block_size;
+    const auto last       = (extent.get_end() - 1) / block_size;
+
+    std::size_t num_existing{0};
+    for (auto iter = m_blocks.lower_bound(first);
+         iter != m_blocks.end() && iter->first <= last; iter++) {
+        num_existing++;
     }
+    return last - first + 1 - num_existing;
+}
 
-    for (auto& [offset, block] : m_blocks) {
-        if (block.equals(working_ext)) {
-            const auto delta_offset = working_ext.m_offset - extent.m_offset;
-            add_block(working_ext, buffer, delta_offset);
-            break;
-        }
-        else if (block.includes(working_ext)) {
-            const auto delta_offset = working_ext.m_offset - extent.m_offset;
-            const auto block_offset =
-                working_ext.m_offset - block.extent().m_offset;
-            block.set_data(
-                buffer.slice(delta_offset, working_ext.m_length), block_offset);
-            break;
-        }
-        else if (block.overlaps(working_ext)) {
-            const auto overlap_length =
-                block.extent().get_overlapping_length(working_ext);
-            const auto delta_offset = working_ext.m_offset - extent.m_offset;
-            const auto block_offset =
-                working_ext.m_offset - block.extent().m_offset;
-            block.set_data(
-                buffer.slice(delta_offset, delta_offset + overlap_length),
-                block_offset);
-
-            working_ext.m_offset += overlap_length;
-            working_ext.m_length -= overlap_length;
-            if (working_ext.m_length == 0) {
-                return;
-            }
+void BlockList::add_extent(std::size_t offset, std::size_t end)
+{
+    // Merge with any extents it overlaps or touches
+    auto iter = m_extents.upper_bound(offset);
+    if (iter != m_extents.begin()) {
+        if (const auto prev = std::prev(iter); prev->second >= offset) {
+            offset = prev->first;
+            end    = std::max(end, prev->second);
+            m_extents.erase(prev);
         }
     }
-    if (working_ext.m_offset == extent.m_offset
-        && working_ext.m_length == extent.m_length) {
-        add_block(working_ext, buffer);
+    while (iter != m_extents.end() && iter->first <= end) {
+        end  = std::max(end, iter->second);
+        iter = m_extents.erase(iter);
     }
+    m_extents.emplace(offset, end);
+}
+
+void BlockList::write(const Extent& extent, const ReadableBufferView& buffer)
+{
+    const auto offset = extent.empty() ? 0 : extent.m_offset;
+    const auto length = extent.empty() ?
+                            buffer.length() :
+                            std::min(extent.m_length, buffer.length());
+    if (length == 0) {
+        return;
+    }
+
+    const auto block_size = m_allocator->get_block_size();
+    std::size_t num_written{0};
+    while (num_written < length) {
+        const auto position     = offset + num_written;
+        const auto index        = position / block_size;
+        const auto block_offset = position % block_size;
+        const auto count =
+            std::min(block_size - block_offset, length - num_written);
+
+        auto iter = m_blocks.find(index);
+        if (iter == m_blocks.end()) {
+            auto block = m_allocator->allocate();
+            iter       = m_blocks.emplace(index, block).first;
+        }
+        std::memcpy(
+            iter->second + block_offset, buffer.data() + num_written, count);
+        num_written += count;
+    }
+    add_extent(offset, offset + length);
 }
 
 std::pair<bool, std::size_t> BlockList::read(
@@ -82,67 +153,53 @@ std::pair<bool, std::size_t> BlockList::read(
 {
     auto working_ext = extent;
     if (extent.empty()) {
-        const auto bounds = get_extent_bounds();
-        working_ext       = {0, bounds.m_offset + bounds.m_length};
+        working_ext = {0, get_extent_bounds().get_end()};
+    }
+    if (working_ext.empty()) {
+        return {false, 0};
     }
 
-    if (auto bounds = get_extent_bounds();
-        !bounds.includes_or_overlaps(working_ext)) {
+    // All of the extent must have been written
+    auto extent_iter = m_extents.upper_bound(working_ext.m_offset);
+    if (extent_iter == m_extents.begin()) {
+        return {false, 0};
+    }
+    if (std::prev(extent_iter)->second < working_ext.get_end()) {
         return {false, 0};
     }
 
-    std::size_t buffer_loc{0};
-    std::size_t bytes_read{0};
-    for (const auto& [offset, block] : m_blocks) {
-        if (block.equals(working_ext)) {
-            for (std::size_t idx = 0; idx < working_ext.m_length; idx++) {
-                buffer.data()[buffer_loc] = block.data()[idx];
-                buffer_loc++;
-            }
-            bytes_read += working_ext.m_length;
-            return {true, bytes_read};
-        }
-        else if (block.includes(working_ext)) {
-            const auto left_offset =
-                working_ext.m_offset - block.extent().m_offset;
-            for (std::size_t idx = 0; idx < working_ext.m_length; idx++) {
-                buffer.data()[buffer_loc] = block.data()[left_offset + idx];
-                buffer_loc++;
-            }
-            bytes_read += working_ext.m_length;
-            return {true, bytes_read};
-        }
-        else if (block.overlaps(working_ext)) {
-            if (block.extent().m_offset > working_ext.m_offset) {
-                return {false, bytes_read};
-            }
-
-            const auto left_offset =
-                working_ext.m_offset - block.extent().m_offset;
-            const auto overlap_length =
-                block.extent().get_overlapping_length(working_ext);
-
-            for (std::size_t idx = 0; idx < overlap_length; idx++) {
-                buffer.data()[buffer_loc] = block.data()[left_offset + idx];
-                buffer_loc++;
-            }
-            working_ext.m_offset += overlap_length;
-            working_ext.m_length -= overlap_length;
-            bytes_read += overlap_length;
-            if (working_ext.m_length == 0) {
-                return {true, bytes_read};
-            }
-        }
+    const auto length     = std::min(working_ext.m_length, buffer.length());
+    const auto block_size = m_allocator->get_block_size();
+
+    // Written extents are fully backed, so the blocks are consecutive
+    auto block_iter = m_blocks.find(working_ext.m_offset / block_size);
+    std::size_t num_read{0};
+    while (num_read < length) {
+        const auto position     = working_ext.m_offset + num_read;
+        const auto block_offset = position % block_size;
+        const auto count =
+            std::min(block_size - block_offset, length - num_read);
+        std::memcpy(
+            buffer.data() + num_read, block_iter->second + block_offset,
+            count);
+        num_read += count;
+        block_iter++;
     }
-    return {false, 0};
+    return {true, num_read};
 }
 
 std::string BlockList::dump() const
 {
     std::string ret;
-    for (const auto& [offset, block] : m_blocks) {
-        ret += block.dump() + "\n";
+    for (const auto& [offset, end] : m_extents) {
+        std::string data(end - offset, 0);
+        WriteableBufferView buffer(data.data(), data.size());
+        read({offset, end - offset}, buffer);
+
+        ret += "OFFSET" + std::to_string(offset);
+        ret += "LENGTH" + std::to_string(end - offset);
+        ret += "DATA" + data + "\n";
     }
     return ret;
 }
-}  // namespace hestia
\ No newline at end of file
+}  // namespace hestia
@@ -1,6 +1,6 @@
 #pragma once
 
-#include "Block.h"
+#include "BlockAllocator.h"
 #include "Extent.h"
 #include "ReadableBufferView.h"
 #include "WriteableBufferView.h"
@@ -10,15 +10,38 @@
 namespace hestia {
 
 /**
- * @brief A data container backed by Blocks at arbitary offsets
+ * @brief A data container backed by fixed-size blocks
  *
- * The BlockList is an in-memory data container. When written to it will either
- * create a new Block to receive the data or merge it into a pre-existing block.
- * It supports writing at arbitary offsets into the container, but only reading
- * from existing extents (or data ranges).
+ * The BlockList is an in-memory data container. Its content is kept in
+ * equally sized blocks from a BlockAllocator, indexed by their position in
+ * the container, alongside a record of which extents have been written.
+ * Finding the blocks and extents for a read or write is logarithmic in the
+ * container size and data is copied a block at a time.
+ *
+ * It supports writing at arbitary offsets into the container, but only
+ * reading from extents (or data ranges) which have been fully written.
+ * Not thread-safe.
  */
 class BlockList {
   public:
+    /**
+     * Constructor
+     *
+     * @param allocator Source of the blocks - if null one with the default
+     * block size is created
+     */
+    BlockList(BlockAllocator::Ptr allocator = nullptr);
+
+    BlockList(const BlockList& other);
+
+    BlockList(BlockList&& other) noexcept;
+
+    ~BlockList();
+
+    BlockList& operator=(const BlockList& other);
+
+    BlockList& operator=(BlockList&& other) noexcept;
+
     /**
      * Return a string representation of the container - intended for debugging
      * @return a string representation of the container - intended for debugging
@@ -27,7 +50,8 @@ class BlockList {
 
     /**
      * Read from the container given a certain extent
-     * @param extent the extent to read from
+     * @param extent the extent to read from - if empty, from the start of the
+     * container to the end of its data
      * @param buffer the buffer to read into
      * @return a pair with the status of the read (false if failed) and number of bytes read
      */
@@ -36,19 +60,38 @@ class BlockList {
 
     /**
      * Write data into the container
-     * @param extent the extent to write to
+     * @param extent the extent to write to - if empty, the whole buffer at
+     * the start of the container
      * @param buffer the buffer to read from
      */
     void write(const Extent& extent, const ReadableBufferView& buffer);
 
+    /**
+     * Return the smallest extent covering all data in the container
+     * @return the smallest extent covering all data in the container
+     */
+    hestia::Extent get_extent_bounds() const;
+
+    /**
+     * Return how much memory the container's blocks take up
+     * @return how much memory the container's blocks take up
+     */
+    std::size_t get_memory_size() const;
+
+    /**
+     * Return how many more blocks writing to the extent would need
+     * @param extent the extent to be written
+     * @return how many more blocks writing to the extent would need
+     */
+    std::size_t get_num_new_blocks(const Extent& extent) const;
+
   private:
-    void add_block(
-        const Extent& extent,
-        const ReadableBufferView& buffer,
-        std::size_t offset = 0);
+    void add_extent(std::size_t offset, std::size_t end);
 
-    hestia::Extent get_extent_bounds() const;
+    void clear();
 
-    std::map<std::size_t, Block> m_blocks;
+    BlockAllocator::Ptr m_allocator;
+    std::map<std::size_t, char*> m_blocks;
+    std::map<std::size_t, std::size_t> m_extents;
 };
-}  // namespace hestia
\ No newline at end of file
+}  // namespace hestia
@@ -1,50 +1,183 @@
 #include "BlockStore.h"
 
-#include <fstream>
+#include <algorithm>
 #include <stdexcept>
 
 namespace hestia {
 
-BlockStore::BlockStore(const Uuid& id) : m_id(id) {}
+BlockStore::BlockStore(const Uuid& id, const BlockStoreConfig& config) :
+    m_id(id)
+{
+    const auto num_shards = std::max<std::size_t>(config.m_num_shards, 1);
+    if (config.m_memory_budget > 0) {
+        m_shard_budget =
+            std::max<std::size_t>(config.m_memory_budget / num_shards, 1);
+    }
+
+    for (std::size_t idx = 0; idx < num_shards; idx++) {
+        auto shard         = std::make_unique<Shard>();
+        shard->m_allocator = BlockAllocator::create(config.m_block_size);
+        m_shards.push_back(std::move(shard));
+    }
+}
 
 const Uuid& BlockStore::id() const
 {
     return m_id;
 }
 
-bool BlockStore::has_key(const std::string& key)
+BlockStore::Shard& BlockStore::get_shard(const std::string& key) const
+{
+    return *m_shards[std::hash<std::string>{}(key) % m_shards.size()];
+}
+
+bool BlockStore::has_key(const std::string& key) const
 {
-    return m_data.find(key) != m_data.end();
+    auto& shard = get_shard(key);
+    std::scoped_lock guard(shard.m_mutex);
+    return shard.m_entries.find(key) != shard.m_entries.end();
 }
 
 void BlockStore::remove(const std::string& key)
 {
-    if (auto iter = m_data.find(key); iter != m_data.end()) {
-        m_data.erase(iter);
+    auto& shard = get_shard(key);
+    std::scoped_lock guard(shard.m_mutex);
+    if (auto iter = shard.m_entries.find(key); iter != shard.m_entries.end()) {
+        shard.m_size -= iter->second.m_blocks.get_memory_size();
+        shard.m_lru.erase(iter->second.m_lru_iter);
+        shard.m_entries.erase(iter);
     }
 }
 
-const BlockList& BlockStore::get_block_list(const std::string& key) const
+BlockList BlockStore::get_block_list(const std::string& key) const
 {
-    if (auto iter = m_data.find(key); iter != m_data.end()) {
-        return iter->second;
+    auto& shard = get_shard(key);
+    std::scoped_lock guard(shard.m_mutex);
+    if (auto iter = shard.m_entries.find(key); iter != shard.m_entries.end()) {
+        return iter->second.m_blocks;
     }
     else {
         throw std::runtime_error("Requested blocklist not found");
     }
 }
 
-void BlockStore::set_block_list(const std::string& key, const BlockList& blocks)
+BlockList BlockStore::take_block_list(const std::string& key)
+{
+    auto& shard = get_shard(key);
+    std::scoped_lock guard(shard.m_mutex);
+    auto iter = shard.m_entries.find(key);
+    if (iter == shard.m_entries.end()) {
+        throw std::runtime_error("Requested blocklist not found");
+    }
+
+    auto blocks = std::move(iter->second.m_blocks);
+    shard.m_size -= blocks.get_memory_size();
+    shard.m_lru.erase(iter->second.m_lru_iter);
+    shard.m_entries.erase(iter);
+    return blocks;
+}
+
+BlockStore::ReturnCode BlockStore::set_block_list(
+    const std::string& key, BlockList&& blocks)
+{
+    auto& shard = get_shard(key);
+    std::scoped_lock guard(shard.m_mutex);
+
+    auto iter               = shard.m_entries.find(key);
+    const auto current_size = iter == shard.m_entries.end() ?
+                                  0 :
+                                  iter->second.m_blocks.get_memory_size();
+    if (!has_room(shard, current_size, blocks.get_memory_size())) {
+        return {
+            ReturnCode::Status::NO_SPACE,
+            "No space in store for object " + key};
+    }
+
+    if (iter == shard.m_entries.end()) {
+        shard.m_lru.push_front(key);
+        iter = shard.m_entries
+                   .emplace(
+                       key,
+                       Entry{BlockList(shard.m_allocator), shard.m_lru.begin()})
+                   .first;
+    }
+    else {
+        shard.m_lru.splice(
+            shard.m_lru.begin(), shard.m_lru, iter->second.m_lru_iter);
+    }
+    shard.m_size += blocks.get_memory_size() - current_size;
+    iter->second.m_blocks = std::move(blocks);
+    return {};
+}
+
+Extent BlockStore::get_extent_bounds(const std::string& key) const
+{
+    auto& shard = get_shard(key);
+    std::scoped_lock guard(shard.m_mutex);
+    if (auto iter = shard.m_entries.find(key); iter != shard.m_entries.end()) {
+        return iter->second.m_blocks.get_extent_bounds();
+    }
+    return {};
+}
+
+std::size_t BlockStore::get_memory_size() const
 {
-    m_data[key] = blocks;
+    std::size_t size{0};
+    for (const auto& shard : m_shards) {
+        std::scoped_lock guard(shard->m_mutex);
+        size += shard->m_size;
+    }
+    return size;
+}
+
+std::vector<std::string> BlockStore::get_eviction_candidates(
+    const std::string& key, const Extent& extent) const
+{
+    if (m_shard_budget == 0) {
+        return {};
+    }
+
+    auto& shard = get_shard(key);
+    std::scoped_lock guard(shard.m_mutex);
+
+    std::size_t current_size{0};
+    std::size_t num_new_blocks{0};
+    if (auto iter = shard.m_entries.find(key); iter != shard.m_entries.end()) {
+        current_size   = iter->second.m_blocks.get_memory_size();
+        num_new_blocks = iter->second.m_blocks.get_num_new_blocks(extent);
+    }
+    else {
+        num_new_blocks =
+            BlockList(shard.m_allocator).get_num_new_blocks(extent);
+    }
+    const auto new_size =
+        current_size + num_new_blocks * shard.m_allocator->get_block_size();
+    if (new_size > m_shard_budget) {
+        return {};
+    }
+
+    std::vector<std::string> candidates;
+    auto size = shard.m_size + new_size - current_size;
+    for (auto lru_iter = shard.m_lru.rbegin();
+         size > m_shard_budget && lru_iter != shard.m_lru.rend(); lru_iter++) {
+        if (*lru_iter != key) {
+            size -= shard.m_entries.find(*lru_iter)
+                        ->second.m_blocks.get_memory_size();
+            candidates.push_back(*lru_iter);
+        }
+    }
+    return candidates;
 }
 
 std::string BlockStore::dump() const
 {
     std::string output;
-    for (const auto& [key, blocklist] : m_data) {
-        output += "Key: " + key + '\n';
-        output += blocklist.dump() + '\n';
+    for (const auto& shard : m_shards) {
+        std::scoped_lock guard(shard->m_mutex);
+        for (const auto& [key, entry] : shard->m_entries) {
+            output += "Key: " + key + '\n';
+            output += entry.m_blocks.dump() + '\n';
+        }
     }
     return output;
 }
@@ -54,18 +187,59 @@ void BlockStore::load(const std::filesystem::path& directory)
     (void)directory;
 }
 
+bool BlockStore::has_room(
+    const Shard& shard, std::size_t current_size, std::size_t new_size) const
+{
+    return m_shard_budget == 0
+           || shard.m_size - current_size + new_size <= m_shard_budget;
+}
+
 BlockStore::ReturnCode BlockStore::write(
     const std::string& key,
     const Extent& extent,
     const ReadableBufferView& buffer)
 {
-    auto iter = m_data.find(key);
-    if (iter == m_data.end()) {
-        m_data[key] = BlockList();
-        m_data[key].write(extent, buffer);
-        return {};
+    const Extent write_extent =
+        extent.empty() ?
+            Extent{0, buffer.length()} :
+            Extent{extent.m_offset, std::min(extent.m_length, buffer.length())};
+
+    auto& shard = get_shard(key);
+    std::scoped_lock guard(shard.m_mutex);
+
+    auto iter         = shard.m_entries.find(key);
+    const bool is_new = iter == shard.m_entries.end();
+    if (is_new) {
+        shard.m_lru.push_front(key);
+        iter = shard.m_entries
+                   .emplace(
+                       key,
+                       Entry{BlockList(shard.m_allocator), shard.m_lru.begin()})
+                   .first;
+    }
+    else {
+        shard.m_lru.splice(
+            shard.m_lru.begin(), shard.m_lru, iter->second.m_lru_iter);
     }
-    iter->second.write(extent, buffer);
+
+    auto& blocks            = iter->second.m_blocks;
+    const auto current_size = blocks.get_memory_size();
+    const auto new_size     = current_size
+                          + blocks.get_num_new_blocks(write_extent)
+                                * shard.m_allocator->get_block_size();
+    if (!has_room(shard, current_size, new_size)) {
+        if (is_new) {
+            shard.m_lru.erase(iter->second.m_lru_iter);
+            shard.m_entries.erase(iter);
+        }
+        return {
+            ReturnCode::Status::NO_SPACE,
+            "No space in store to write " + extent.to_string() + " of object "
+                + key};
+    }
+
+    blocks.write(write_extent, buffer);
+    shard.m_size += new_size - current_size;
     return {};
 }
 
@@ -74,17 +248,23 @@ BlockStore::ReturnCode BlockStore::read(
     const Extent& extent,
     WriteableBufferView& buffer) const
 {
-    auto iter = m_data.find(key);
-    if (iter == m_data.end()) {
+    auto& shard = get_shard(key);
+    std::scoped_lock guard(shard.m_mutex);
+
+    auto iter = shard.m_entries.find(key);
+    if (iter == shard.m_entries.end()) {
         const auto msg = "Key " + key + " not found during read";
         return ReturnCode{ReturnCode::Status::ID_NOT_FOUND, msg};
     }
+    shard.m_lru.splice(
+        shard.m_lru.begin(), shard.m_lru, iter->second.m_lru_iter);
 
-    const auto& [found, bytes_read] = iter->second.read(extent, buffer);
+    const auto& [found, bytes_read] =
+        iter->second.m_blocks.read(extent, buffer);
     if (!found) {
         const auto msg = "Read Failed to find extent: " + extent.to_string();
         return ReturnCode{ReturnCode::Status::EXTENT_NOT_FOUND, msg};
     }
     return BlockStore::ReturnCode{bytes_read};
 }
-}  // namespace hestia
\ No newline at end of file
+}  // namespace hestia
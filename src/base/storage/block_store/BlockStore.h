@@ -5,20 +5,42 @@
 #include "WriteableBufferView.h"
 
 #include <filesystem>
+#include <list>
+#include <mutex>
 #include <unordered_map>
+#include <vector>
 
 namespace hestia {
 
+/**
+ * @brief Settings for a BlockStore
+ */
+struct BlockStoreConfig {
+    // Size of the blocks objects are stored in
+    std::size_t m_block_size{BlockAllocator::s_default_block_size};
+    // Number of independently locked partitions of the store
+    std::size_t m_num_shards{16};
+    // Most memory the store's blocks may take up - 0 for no limit
+    std::size_t m_memory_budget{0};
+};
+
 /**
  * @brief An in-memory Object Store primitive - it uses BlockList containers for storage
  *
- * This is a basic in-memory Object Store supporting Extents via BlockList
- * containers. It is intended mostly for development/mocking.
+ * This is an in-memory Object Store supporting Extents via BlockList
+ * containers. Objects are spread over shards by a hash of their key, each
+ * with its own lock and BlockAllocator, so operations on different objects
+ * mostly don't contend. Thread-safe.
+ *
+ * With a memory budget each shard may use an equal share of it, and writes
+ * that would go over the share fail with NO_SPACE. The store doesn't evict
+ * anything itself - it suggests its least recently used objects to whoever
+ * owns their placement, which can move them elsewhere before writing.
  */
 class BlockStore {
   public:
     struct ReturnCode {
-        enum class Status { ID_NOT_FOUND, EXTENT_NOT_FOUND, OK };
+        enum class Status { ID_NOT_FOUND, EXTENT_NOT_FOUND, NO_SPACE, OK };
 
         ReturnCode() = default;
 
@@ -40,8 +62,9 @@ class BlockStore {
      * Constructor
      *
      * @param id optinal id in case of using multiple stores
+     * @param config store settings
      */
-    BlockStore(const Uuid& id = {});
+    BlockStore(const Uuid& id = {}, const BlockStoreConfig& config = {});
 
     /**
      * Dump the store to the filesystem at the given path - intended for
@@ -57,7 +80,7 @@ class BlockStore {
      * @param key Object key to check
      * @return whether an object with this key has been added to the store
      */
-    bool has_key(const std::string& key);
+    bool has_key(const std::string& key) const;
 
     /**
      * Return the store id
@@ -66,9 +89,57 @@ class BlockStore {
      */
     const Uuid& id() const;
 
-    const BlockList& get_block_list(const std::string& key) const;
+    /**
+     * Return a copy of an object's data
+     *
+     * @param key key of the object
+     * @return a copy of the object's data - throws if not found
+     */
+    BlockList get_block_list(const std::string& key) const;
+
+    /**
+     * Remove an object from the store, handing over its data
+     *
+     * @param key key of the object
+     * @return the object's data - throws if not found
+     */
+    BlockList take_block_list(const std::string& key);
+
+    /**
+     * Add an object's data to the store, replacing any existing data
+     *
+     * @param key key of the object
+     * @param blocks the object's data - left as it is if there is no room
+     * @return whether the operation was a sucess
+     */
+    ReturnCode set_block_list(const std::string& key, BlockList&& blocks);
+
+    /**
+     * Return the smallest extent covering all of an object's data
+     *
+     * @param key key of the object
+     * @return the object's extent bounds - empty if not found
+     */
+    Extent get_extent_bounds(const std::string& key) const;
 
-    void set_block_list(const std::string& key, const BlockList& blocks);
+    /**
+     * Return how much memory the objects in the store take up
+     *
+     * @return how much memory the objects in the store take up
+     */
+    std::size_t get_memory_size() const;
+
+    /**
+     * Return the least recently used objects to remove to make room for a
+     * write, in the order they should go
+     *
+     * @param key key of the object to be written - never suggested itself
+     * @param extent the extent to be written
+     * @return the keys of the objects - empty if there is room already, or
+     * if removing objects wouldn't make enough
+     */
+    std::vector<std::string> get_eviction_candidates(
+        const std::string& key, const Extent& extent) const;
 
     /**
      * Load the store into memory from the filesystem
@@ -111,7 +182,29 @@ class BlockStore {
         const ReadableBufferView& buffer);
 
   private:
+    struct Entry {
+        BlockList m_blocks;
+        std::list<std::string>::iterator m_lru_iter;
+    };
+
+    // Least recently used entries are at the back of 'm_lru'
+    struct Shard {
+        std::mutex m_mutex;
+        BlockAllocator::Ptr m_allocator;
+        std::unordered_map<std::string, Entry> m_entries;
+        std::list<std::string> m_lru;
+        std::size_t m_size{0};
+    };
+
+    Shard& get_shard(const std::string& key) const;
+
+    bool has_room(
+        const Shard& shard,
+        std::size_t current_size,
+        std::size_t new_size) const;
+
     Uuid m_id;
-    std::unordered_map<std::string, BlockList> m_data;
+    std::size_t m_shard_budget{0};
+    std::vector<std::unique_ptr<Shard>> m_shards;
 };
-}  // namespace hestia
\ No newline at end of file
+}  // namespace hestia
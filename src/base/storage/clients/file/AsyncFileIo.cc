@@ -0,0 +1,289 @@
+#include "AsyncFileIo.h"
+
+#include "Logger.h"
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <string>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#ifdef HAVE_LIBURING
+#include <liburing.h>
+#endif
+
+namespace hestia {
+
+AlignedBufferPool::AlignedBufferPool(
+    std::size_t buffer_size, std::size_t max_pooled) :
+    m_buffer_size(
+        (std::max<std::size_t>(buffer_size, 1) + s_alignment - 1)
+        / s_alignment * s_alignment),
+    m_max_pooled(max_pooled)
+{
+}
+
+AlignedBufferPool::~AlignedBufferPool()
+{
+    for (auto buffer : m_free) {
+        std::free(buffer);
+    }
+}
+
+char* AlignedBufferPool::acquire()
+{
+    {
+        std::scoped_lock guard(m_mutex);
+        if (!m_free.empty()) {
+            auto buffer = m_free.back();
+            m_free.pop_back();
+            return buffer;
+        }
+    }
+
+    void* buffer{nullptr};
+    if (::posix_memalign(&buffer, s_alignment, m_buffer_size) != 0) {
+        throw std::bad_alloc();
+    }
+    return static_cast<char*>(buffer);
+}
+
+void AlignedBufferPool::release(char* buffer)
+{
+    {
+        std::scoped_lock guard(m_mutex);
+        if (m_free.size() < m_max_pooled) {
+            m_free.push_back(buffer);
+            return;
+        }
+    }
+    std::free(buffer);
+}
+
+AsyncFileIoContext::AsyncFileIoContext(
+    std::size_t queue_depth, std::size_t block_size, bool direct_io) :
+    m_queue_depth(std::max<std::size_t>(queue_depth, 1)),
+    m_direct_io(direct_io),
+    m_buffer_pool(block_size, 4 * m_queue_depth)
+{
+}
+
+AsyncFileIoContext::~AsyncFileIoContext() = default;
+
+ThreadPool* AsyncFileIoContext::get_thread_pool()
+{
+    std::scoped_lock guard(m_mutex);
+    if (!m_thread_pool) {
+        m_thread_pool = std::make_unique<ThreadPool>(m_queue_depth);
+    }
+    return m_thread_pool.get();
+}
+
+int AsyncFileIoContext::open(
+    const std::filesystem::path& path,
+    int flags,
+    std::size_t offset,
+    bool& is_direct) const
+{
+    is_direct = false;
+    if (m_direct_io && offset % AlignedBufferPool::s_alignment == 0) {
+        const auto fd = ::open(path.c_str(), flags | O_DIRECT, 0644);
+        if (fd != -1 || errno != EINVAL) {
+            is_direct = fd != -1;
+            return fd;
+        }
+    }
+    return ::open(path.c_str(), flags, 0644);
+}
+
+ThreadPoolFileIoEngine::ThreadPoolFileIoEngine(ThreadPool* thread_pool) :
+    m_thread_pool(thread_pool)
+{
+}
+
+ThreadPoolFileIoEngine::~ThreadPoolFileIoEngine()
+{
+    // Ops reference this engine until they complete
+    std::unique_lock guard(m_mutex);
+    m_done_cv.wait(guard, [this]() { return m_num_in_flight == 0; });
+}
+
+void ThreadPoolFileIoEngine::do_io(FileIoOp& op)
+{
+    while (op.m_num_transferred < op.m_length) {
+        errno          = 0;
+        auto buffer    = op.m_buffer + op.m_num_transferred;
+        const auto len = op.m_length - op.m_num_transferred;
+        const auto offset =
+            static_cast<off_t>(op.m_offset + op.m_num_transferred);
+        const auto rc = op.m_is_write ?
+                            ::pwrite(op.m_fd, buffer, len, offset) :
+                            ::pread(op.m_fd, buffer, len, offset);
+        if (rc < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            op.m_error = errno;
+            return;
+        }
+        if (rc == 0) {
+            return;
+        }
+        op.m_num_transferred += static_cast<std::size_t>(rc);
+    }
+}
+
+void ThreadPoolFileIoEngine::submit(FileIoOp& op)
+{
+    {
+        std::scoped_lock guard(m_mutex);
+        m_num_in_flight++;
+    }
+
+    auto task = [this, &op]() {
+        do_io(op);
+        {
+            std::scoped_lock guard(m_mutex);
+            op.m_done = true;
+            m_num_in_flight--;
+        }
+        m_done_cv.notify_all();
+    };
+
+    if (m_thread_pool == nullptr || !m_thread_pool->add_task(task)) {
+        task();
+    }
+}
+
+void ThreadPoolFileIoEngine::wait(FileIoOp& op)
+{
+    std::unique_lock guard(m_mutex);
+    m_done_cv.wait(guard, [&op]() { return op.m_done; });
+}
+
+#ifdef HAVE_LIBURING
+class IoUringFileIoEngine : public FileIoEngine {
+  public:
+    IoUringFileIoEngine(std::size_t queue_depth)
+    {
+        if (const auto rc = ::io_uring_queue_init(
+                static_cast<unsigned>(queue_depth), &m_ring, 0);
+            rc < 0) {
+            throw std::runtime_error(
+                "io_uring setup failed: " + std::string(::strerror(-rc)));
+        }
+    }
+
+    ~IoUringFileIoEngine()
+    {
+        // The kernel may still be using the buffers
+        while (m_num_in_flight > 0) {
+            reap_one();
+        }
+        ::io_uring_queue_exit(&m_ring);
+    }
+
+    void submit(FileIoOp& op) override
+    {
+        auto sqe = ::io_uring_get_sqe(&m_ring);
+        while (sqe == nullptr) {
+            reap_one();
+            sqe = ::io_uring_get_sqe(&m_ring);
+        }
+
+        auto buffer = op.m_buffer + op.m_num_transferred;
+        const auto len =
+            static_cast<unsigned>(op.m_length - op.m_num_transferred);
+        const auto offset = op.m_offset + op.m_num_transferred;
+        if (op.m_is_write) {
+            ::io_uring_prep_write(sqe, op.m_fd, buffer, len, offset);
+        }
+        else {
+            ::io_uring_prep_read(sqe, op.m_fd, buffer, len, offset);
+        }
+        ::io_uring_sqe_set_data(sqe, &op);
+        m_num_in_flight++;
+
+        int rc{0};
+        do {
+            rc = ::io_uring_submit(&m_ring);
+        } while (rc == -EINTR);
+        if (rc < 0) {
+            m_num_in_flight--;
+            op.m_error = -rc;
+            op.m_done  = true;
+        }
+    }
+
+    void wait(FileIoOp& op) override
+    {
+        while (!op.m_done) {
+            reap_one();
+        }
+    }
+
+  private:
+    void reap_one()
+    {
+        io_uring_cqe* cqe{nullptr};
+        int rc{0};
+        do {
+            rc = ::io_uring_wait_cqe(&m_ring, &cqe);
+        } while (rc == -EINTR);
+        if (rc < 0) {
+            LOG_ERROR("io_uring wait failed: " << ::strerror(-rc));
+            throw std::runtime_error("io_uring wait failed");
+        }
+
+        auto op = static_cast<FileIoOp*>(::io_uring_cqe_get_data(cqe));
+
+        const auto res = cqe->res;
+        ::io_uring_cqe_seen(&m_ring, cqe);
+        m_num_in_flight--;
+
+        if (res == -EINTR || res == -EAGAIN) {
+            submit(*op);
+        }
+        else if (res < 0) {
+            op->m_error = -res;
+            op->m_done  = true;
+        }
+        else if (res == 0) {
+            op->m_done = true;
+        }
+        else {
+            op->m_num_transferred += static_cast<std::size_t>(res);
+            if (op->m_num_transferred < op->m_length) {
+                submit(*op);
+            }
+            else {
+                op->m_done = true;
+            }
+        }
+    }
+
+    io_uring m_ring;
+    std::size_t m_num_in_flight{0};
+};
+#endif
+
+FileIoEngine::Ptr FileIoEngine::create(AsyncFileIoContext& context)
+{
+#ifdef HAVE_LIBURING
+    try {
+        return std::make_unique<IoUringFileIoEngine>(context.m_queue_depth);
+    }
+    catch (const std::exception& e) {
+        LOG_WARN("Using thread pool for file io: " << std::string(e.what()));
+    }
+#endif
+    return std::make_unique<ThreadPoolFileIoEngine>(context.get_thread_pool());
+}
+
+}  // namespace hestia
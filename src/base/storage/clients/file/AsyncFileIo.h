@@ -0,0 +1,188 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+class ThreadPool;
+
+namespace hestia {
+
+/**
+ * @brief A single positional read or write of a file
+ *
+ * The 'done' and result fields are set by the FileIoEngine it is submitted
+ * to. The op and its buffer must stay alive until the engine reports it
+ * done.
+ */
+struct FileIoOp {
+    int m_fd{-1};
+    char* m_buffer{nullptr};
+    std::size_t m_length{0};
+    std::size_t m_offset{0};
+    bool m_is_write{false};
+
+    std::size_t m_num_transferred{0};
+    int m_error{0};
+    bool m_done{false};
+};
+
+/**
+ * @brief A pool of equally sized, aligned buffers suitable for O_DIRECT
+ *
+ * Buffers are kept for reuse when released, up to a limit. Thread-safe.
+ */
+class AlignedBufferPool {
+  public:
+    /**
+     * Constructor
+     *
+     * @param buffer_size Size of each buffer - rounded up to the alignment
+     * @param max_pooled Number of released buffers kept for reuse
+     */
+    AlignedBufferPool(std::size_t buffer_size, std::size_t max_pooled);
+
+    ~AlignedBufferPool();
+
+    /**
+     * Get a buffer, allocating one if none are free
+     *
+     * @return The buffer - give it back with 'release'
+     */
+    char* acquire();
+
+    /**
+     * Give back a buffer from 'acquire'
+     *
+     * @param buffer The buffer
+     */
+    void release(char* buffer);
+
+    std::size_t get_buffer_size() const { return m_buffer_size; }
+
+    static constexpr std::size_t s_alignment{4096};
+
+  private:
+    std::size_t m_buffer_size{0};
+    std::size_t m_max_pooled{0};
+    std::mutex m_mutex;
+    std::vector<char*> m_free;
+};
+
+/**
+ * @brief Settings and resources shared by a file store's async streams
+ */
+struct AsyncFileIoContext {
+    /**
+     * Constructor
+     *
+     * @param queue_depth Number of ops each stream keeps in flight
+     * @param block_size Size of each op
+     * @param direct_io Open files with O_DIRECT where possible
+     */
+    AsyncFileIoContext(
+        std::size_t queue_depth, std::size_t block_size, bool direct_io);
+
+    ~AsyncFileIoContext();
+
+    /**
+     * Get the pool for engines without io_uring, started on first use
+     *
+     * @return The thread pool
+     */
+    ThreadPool* get_thread_pool();
+
+    /**
+     * Open a file, with O_DIRECT if it is enabled, 'offset' is aligned and
+     * the filesystem supports it
+     *
+     * @param path Path to the file
+     * @param flags Flags for open
+     * @param offset Offset the stream starts at
+     * @param is_direct Set true if the file was opened with O_DIRECT
+     * @return The file descriptor, or -1 with errno set
+     */
+    int open(
+        const std::filesystem::path& path,
+        int flags,
+        std::size_t offset,
+        bool& is_direct) const;
+
+    std::size_t m_queue_depth{8};
+    bool m_direct_io{false};
+    AlignedBufferPool m_buffer_pool;
+
+  private:
+    std::mutex m_mutex;
+    std::unique_ptr<ThreadPool> m_thread_pool;
+};
+
+/**
+ * @brief Runs file ops asynchronously
+ *
+ * Each engine is used by a single stream at a time. With liburing support
+ * (HAVE_LIBURING) each engine has its own io_uring, otherwise ops run on
+ * the context's thread pool with pread and pwrite. Short transfers are
+ * continued until the op is complete or the end of file is reached.
+ */
+class FileIoEngine {
+  public:
+    using Ptr = std::unique_ptr<FileIoEngine>;
+
+    virtual ~FileIoEngine() = default;
+
+    /**
+     * Create an engine, using io_uring if available and falling back to
+     * the context's thread pool
+     *
+     * @param context Shared settings and resources
+     * @return The engine
+     */
+    static Ptr create(AsyncFileIoContext& context);
+
+    /**
+     * Start an op
+     *
+     * @param op The op - it must stay alive until done
+     */
+    virtual void submit(FileIoOp& op) = 0;
+
+    /**
+     * Wait for a submitted op to be done
+     *
+     * @param op The op
+     */
+    virtual void wait(FileIoOp& op) = 0;
+};
+
+/**
+ * @brief FileIoEngine running ops on a thread pool with pread and pwrite
+ */
+class ThreadPoolFileIoEngine : public FileIoEngine {
+  public:
+    ThreadPoolFileIoEngine(ThreadPool* thread_pool);
+
+    ~ThreadPoolFileIoEngine();
+
+    void submit(FileIoOp& op) override;
+
+    void wait(FileIoOp& op) override;
+
+    /**
+     * Do the op on the calling thread
+     *
+     * @param op The op
+     */
+    static void do_io(FileIoOp& op);
+
+  private:
+    ThreadPool* m_thread_pool{nullptr};
+    std::mutex m_mutex;
+    std::condition_variable m_done_cv;
+    std::size_t m_num_in_flight{0};
+};
+
+}  // namespace hestia
@@ -0,0 +1,236 @@
+#include "AsyncFileStreamSink.h"
+
+#include "FileUtils.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace hestia {
+AsyncFileStreamSink::AsyncFileStreamSink(
+    const std::filesystem::path& path,
+    std::size_t offset,
+    std::size_t length,
+    bool truncate,
+    std::shared_ptr<AsyncFileIoContext> context) :
+    m_path(path),
+    m_offset(offset),
+    m_length(length),
+    m_truncate(truncate),
+    m_context(std::move(context)),
+    m_block_offset(offset)
+{
+}
+
+AsyncFileStreamSink::Ptr AsyncFileStreamSink::create(
+    const std::filesystem::path& path,
+    std::size_t offset,
+    std::size_t length,
+    bool truncate,
+    std::shared_ptr<AsyncFileIoContext> context)
+{
+    return std::make_unique<AsyncFileStreamSink>(
+        path, offset, length, truncate, std::move(context));
+}
+
+AsyncFileStreamSink::~AsyncFileStreamSink()
+{
+    close();
+}
+
+bool AsyncFileStreamSink::open_file() noexcept
+{
+    try {
+        FileUtils::create_if_not_existing(m_path);
+        m_engine = FileIoEngine::create(*m_context);
+    }
+    catch (const std::exception& e) {
+        set_state(
+            StreamState::State::ERROR,
+            "AsyncFileStreamSink: Failed to start io: "
+                + std::string(e.what()));
+        return false;
+    }
+
+    auto flags = O_WRONLY | O_CREAT | O_CLOEXEC;
+    if (m_truncate) {
+        flags |= O_TRUNC;
+    }
+
+    errno = 0;
+    m_fd  = m_context->open(m_path, flags, m_offset, m_is_direct);
+    if (m_fd == -1) {
+        set_state(
+            StreamState::State::ERROR,
+            "AsyncFileStreamSink: Failed to open " + m_path.string() + ": "
+                + std::string(::strerror(errno)));
+        return false;
+    }
+
+#ifdef __linux__
+    if (m_length > 0) {
+        (void)::fallocate(
+            m_fd, FALLOC_FL_KEEP_SIZE, static_cast<off_t>(m_offset),
+            static_cast<off_t>(m_length));
+    }
+#endif
+    return true;
+}
+
+IOResult AsyncFileStreamSink::write(const ReadableBufferView& buffer) noexcept
+{
+    if (const auto state = get_state(); !state.ok()) {
+        return {state, 0};
+    }
+
+    if (m_fd == -1 && !open_file()) {
+        return {get_state(), 0};
+    }
+
+    const auto block_size = m_context->m_buffer_pool.get_buffer_size();
+    std::size_t num_written{0};
+    try {
+        while (num_written < buffer.length()) {
+            if (m_block == nullptr) {
+                m_block = m_context->m_buffer_pool.acquire();
+            }
+
+            const auto count = std::min(
+                block_size - m_block_fill, buffer.length() - num_written);
+            std::memcpy(
+                m_block + m_block_fill, buffer.data() + num_written, count);
+            m_block_fill += count;
+            num_written += count;
+
+            if (m_block_fill == block_size) {
+                submit_block(block_size);
+            }
+        }
+    }
+    catch (const std::exception& e) {
+        set_state(
+            StreamState::State::ERROR,
+            "AsyncFileStreamSink write failed: " + std::string(e.what()));
+    }
+    return {get_state(), num_written};
+}
+
+void AsyncFileStreamSink::submit_block(std::size_t length)
+{
+    if (m_ops.size() >= m_context->m_queue_depth) {
+        pop_op();
+    }
+
+    auto op        = std::make_unique<FileIoOp>();
+    op->m_fd       = m_fd;
+    op->m_buffer   = m_block;
+    op->m_length   = length;
+    op->m_offset   = m_block_offset;
+    op->m_is_write = true;
+    m_engine->submit(*op);
+    m_ops.push_back(std::move(op));
+
+    m_block_offset += length;
+    m_block      = nullptr;
+    m_block_fill = 0;
+}
+
+void AsyncFileStreamSink::pop_op()
+{
+    auto op = std::move(m_ops.front());
+    m_ops.pop_front();
+
+    m_engine->wait(*op);
+    m_context->m_buffer_pool.release(op->m_buffer);
+    if (op->m_error != 0) {
+        set_state(
+            StreamState::State::ERROR,
+            "AsyncFileStreamSink write failed: "
+                + std::string(::strerror(op->m_error)));
+    }
+    else if (op->m_num_transferred < op->m_length) {
+        set_state(
+            StreamState::State::ERROR, "AsyncFileStreamSink short write");
+    }
+}
+
+void AsyncFileStreamSink::flush()
+{
+    while (!m_ops.empty()) {
+        pop_op();
+    }
+
+    if (m_block_fill == 0 || !get_state().ok()) {
+        return;
+    }
+
+    // O_DIRECT needs whole blocks, so the tail goes through the page cache
+    if (m_is_direct) {
+        const auto flags = ::fcntl(m_fd, F_GETFL);
+        ::fcntl(m_fd, F_SETFL, flags & ~O_DIRECT);
+        m_is_direct = false;
+    }
+
+    FileIoOp op;
+    op.m_fd       = m_fd;
+    op.m_buffer   = m_block;
+    op.m_length   = m_block_fill;
+    op.m_offset   = m_block_offset;
+    op.m_is_write = true;
+    ThreadPoolFileIoEngine::do_io(op);
+
+    m_block_offset += m_block_fill;
+    m_block_fill = 0;
+    if (op.m_error != 0 || op.m_num_transferred < op.m_length) {
+        set_state(
+            StreamState::State::ERROR,
+            "AsyncFileStreamSink write failed: "
+                + std::string(::strerror(op.m_error)));
+    }
+}
+
+StreamState AsyncFileStreamSink::finish() noexcept
+{
+    if (m_fd != -1) {
+        try {
+            flush();
+        }
+        catch (const std::exception& e) {
+            set_state(
+                StreamState::State::ERROR,
+                "AsyncFileStreamSink flush failed: " + std::string(e.what()));
+        }
+    }
+    close();
+    return StreamSink::finish();
+}
+
+void AsyncFileStreamSink::close() noexcept
+{
+    // Buffers can't be given back while ops are still using them
+    try {
+        while (!m_ops.empty()) {
+            pop_op();
+        }
+    }
+    catch (const std::exception& e) {
+        set_state(
+            StreamState::State::ERROR,
+            "AsyncFileStreamSink close failed: " + std::string(e.what()));
+    }
+    m_engine.reset();
+
+    if (m_block != nullptr) {
+        m_context->m_buffer_pool.release(m_block);
+        m_block      = nullptr;
+        m_block_fill = 0;
+    }
+
+    if (m_fd != -1) {
+        ::close(m_fd);
+        m_fd = -1;
+    }
+}
+}  // namespace hestia
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "AsyncFileIo.h"
+#include "StreamSink.h"
+
+#include <deque>
+
+namespace hestia {
+
+/**
+ * @brief Writes into a file with a queue of async ops
+ *
+ * Incoming data is gathered into block sized, aligned buffers from the
+ * context's pool and each full block is written asynchronously, with up to
+ * the context's queue depth in flight. The last partial block and any
+ * outstanding writes are completed in 'finish', which reports failures.
+ *
+ * With O_DIRECT enabled and an aligned 'offset' the page cache is bypassed,
+ * apart from the last partial block.
+ */
+class AsyncFileStreamSink : public StreamSink {
+  public:
+    using Ptr = std::unique_ptr<AsyncFileStreamSink>;
+
+    /**
+     * Constructor
+     *
+     * @param path Path to the file, created if needed
+     * @param offset Offset to start writing at
+     * @param length Expected amount to be written, used to preallocate
+     * space - 0 if not known
+     * @param truncate If true empty the file before writing
+     * @param context Shared settings and resources
+     */
+    AsyncFileStreamSink(
+        const std::filesystem::path& path,
+        std::size_t offset,
+        std::size_t length,
+        bool truncate,
+        std::shared_ptr<AsyncFileIoContext> context);
+
+    static Ptr create(
+        const std::filesystem::path& path,
+        std::size_t offset,
+        std::size_t length,
+        bool truncate,
+        std::shared_ptr<AsyncFileIoContext> context);
+
+    virtual ~AsyncFileStreamSink();
+
+    [[nodiscard]] IOResult write(
+        const ReadableBufferView& buffer) noexcept override;
+
+    [[nodiscard]] StreamState finish() noexcept override;
+
+  private:
+    bool open_file() noexcept;
+
+    void submit_block(std::size_t length);
+
+    void pop_op();
+
+    void flush();
+
+    void close() noexcept;
+
+    std::filesystem::path m_path;
+    std::size_t m_offset{0};
+    std::size_t m_length{0};
+    bool m_truncate{true};
+    std::shared_ptr<AsyncFileIoContext> m_context;
+    FileIoEngine::Ptr m_engine;
+    int m_fd{-1};
+    bool m_is_direct{false};
+
+    char* m_block{nullptr};
+    std::size_t m_block_fill{0};
+    std::size_t m_block_offset{0};
+    std::deque<std::unique_ptr<FileIoOp>> m_ops;
+};
+}  // namespace hestia
@@ -0,0 +1,181 @@
+#include "AsyncFileStreamSource.h"
+
+#include "FileUtils.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace hestia {
+AsyncFileStreamSource::AsyncFileStreamSource(
+    const std::filesystem::path& path,
+    std::size_t offset,
+    std::size_t length,
+    std::shared_ptr<AsyncFileIoContext> context) :
+    m_path(path), m_context(std::move(context)), m_position(offset)
+{
+    const auto file_size =
+        static_cast<std::size_t>(FileUtils::get_file_size(m_path));
+    m_end = length > 0 ? std::min(file_size, offset + length) : file_size;
+    m_end = std::max(m_end, offset);
+    m_size = m_end - offset;
+
+    m_next_offset = offset / AlignedBufferPool::s_alignment
+                    * AlignedBufferPool::s_alignment;
+}
+
+AsyncFileStreamSource::Ptr AsyncFileStreamSource::create(
+    const std::filesystem::path& path,
+    std::size_t offset,
+    std::size_t length,
+    std::shared_ptr<AsyncFileIoContext> context)
+{
+    return std::make_unique<AsyncFileStreamSource>(
+        path, offset, length, std::move(context));
+}
+
+AsyncFileStreamSource::~AsyncFileStreamSource()
+{
+    close();
+}
+
+bool AsyncFileStreamSource::open_file() noexcept
+{
+    try {
+        m_engine = FileIoEngine::create(*m_context);
+    }
+    catch (const std::exception& e) {
+        set_state(
+            StreamState::State::ERROR,
+            "AsyncFileStreamSource: Failed to start io: "
+                + std::string(e.what()));
+        return false;
+    }
+
+    errno = 0;
+    bool is_direct{false};
+    m_fd = m_context->open(m_path, O_RDONLY | O_CLOEXEC, 0, is_direct);
+    if (m_fd == -1) {
+        set_state(
+            StreamState::State::ERROR,
+            "AsyncFileStreamSource: Failed to open " + m_path.string() + ": "
+                + std::string(::strerror(errno)));
+        return false;
+    }
+    return true;
+}
+
+void AsyncFileStreamSource::fill_queue()
+{
+    const auto block_size = m_context->m_buffer_pool.get_buffer_size();
+    while (m_ops.size() < m_context->m_queue_depth && m_next_offset < m_end) {
+        auto op        = std::make_unique<FileIoOp>();
+        op->m_fd       = m_fd;
+        op->m_buffer   = m_context->m_buffer_pool.acquire();
+        op->m_length   = block_size;
+        op->m_offset   = m_next_offset;
+        op->m_is_write = false;
+        m_engine->submit(*op);
+
+        m_next_offset += block_size;
+        m_ops.push_back(std::move(op));
+    }
+}
+
+void AsyncFileStreamSource::pop_op()
+{
+    auto& op = m_ops.front();
+    m_engine->wait(*op);
+    m_context->m_buffer_pool.release(op->m_buffer);
+    m_ops.pop_front();
+}
+
+IOResult AsyncFileStreamSource::read(WriteableBufferView& buffer) noexcept
+{
+    if (const auto state = get_state(); !state.ok()) {
+        return {state, 0};
+    }
+
+    if (m_fd == -1 && !open_file()) {
+        return {get_state(), 0};
+    }
+
+    std::size_t num_read{0};
+    try {
+        while (num_read < buffer.length() && m_position < m_end) {
+            fill_queue();
+
+            auto& op = *m_ops.front();
+            m_engine->wait(op);
+            if (op.m_error != 0) {
+                set_state(
+                    StreamState::State::ERROR,
+                    "AsyncFileStreamSource read failed: "
+                        + std::string(::strerror(op.m_error)));
+                return {get_state(), num_read};
+            }
+
+            const auto op_end =
+                std::min(op.m_offset + op.m_num_transferred, m_end);
+            if (op.m_num_transferred < op.m_length) {
+                // The file was truncated since the range was set
+                m_end = op_end;
+            }
+
+            if (m_position < op_end) {
+                const auto count =
+                    std::min(op_end - m_position, buffer.length() - num_read);
+                std::memcpy(
+                    buffer.data() + num_read,
+                    op.m_buffer + (m_position - op.m_offset), count);
+                num_read += count;
+                m_position += count;
+            }
+
+            if (m_position >= op_end) {
+                pop_op();
+            }
+        }
+    }
+    catch (const std::exception& e) {
+        set_state(
+            StreamState::State::ERROR,
+            "AsyncFileStreamSource read failed: " + std::string(e.what()));
+        return {get_state(), num_read};
+    }
+
+    if (m_position >= m_end) {
+        set_state(StreamState::State::FINISHED);
+    }
+    return {get_state(), num_read};
+}
+
+StreamState AsyncFileStreamSource::finish() noexcept
+{
+    close();
+    return StreamSource::finish();
+}
+
+void AsyncFileStreamSource::close() noexcept
+{
+    // Buffers can't be given back while ops are still using them
+    try {
+        while (!m_ops.empty()) {
+            pop_op();
+        }
+    }
+    catch (const std::exception& e) {
+        set_state(
+            StreamState::State::ERROR,
+            "AsyncFileStreamSource close failed: " + std::string(e.what()));
+    }
+    m_engine.reset();
+
+    if (m_fd != -1) {
+        ::close(m_fd);
+        m_fd = -1;
+    }
+}
+}  // namespace hestia
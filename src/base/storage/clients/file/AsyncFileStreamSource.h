@@ -0,0 +1,68 @@
+#pragma once
+
+#include "AsyncFileIo.h"
+#include "StreamSource.h"
+
+#include <deque>
+
+namespace hestia {
+
+/**
+ * @brief Reads part of a file with a queue of async ops
+ *
+ * Up to the context's queue depth of block sized reads are kept in flight
+ * ahead of the consumer, into aligned buffers from the context's pool.
+ * Reads start from the block boundary below 'offset' so the file can be
+ * read with O_DIRECT, bypassing the page cache.
+ */
+class AsyncFileStreamSource : public StreamSource {
+  public:
+    using Ptr = std::unique_ptr<AsyncFileStreamSource>;
+
+    /**
+     * Constructor
+     *
+     * @param path Path to the file
+     * @param offset Offset to start reading from
+     * @param length Amount to read, bounded by the end of file - 0 to read
+     * to the end of file
+     * @param context Shared settings and resources
+     */
+    AsyncFileStreamSource(
+        const std::filesystem::path& path,
+        std::size_t offset,
+        std::size_t length,
+        std::shared_ptr<AsyncFileIoContext> context);
+
+    static Ptr create(
+        const std::filesystem::path& path,
+        std::size_t offset,
+        std::size_t length,
+        std::shared_ptr<AsyncFileIoContext> context);
+
+    virtual ~AsyncFileStreamSource();
+
+    [[nodiscard]] IOResult read(WriteableBufferView& buffer) noexcept override;
+
+    [[nodiscard]] StreamState finish() noexcept override;
+
+  private:
+    bool open_file() noexcept;
+
+    void fill_queue();
+
+    void pop_op();
+
+    void close() noexcept;
+
+    std::filesystem::path m_path;
+    std::shared_ptr<AsyncFileIoContext> m_context;
+    FileIoEngine::Ptr m_engine;
+    int m_fd{-1};
+
+    std::size_t m_position{0};
+    std::size_t m_end{0};
+    std::size_t m_next_offset{0};
+    std::deque<std::unique_ptr<FileIoOp>> m_ops;
+};
+}  // namespace hestia
@@ -29,7 +29,11 @@ FileHsmObjectStoreClientConfig& FileHsmObjectStoreClientConfig::operator=(
     if (this != &other) {
         SerializeableWithFields::operator=(other);
         m_root = other.m_root;
-        m_mode = other.m_mode;
+        m_mode        = other.m_mode;
+        m_io_engine   = other.m_io_engine;
+        m_queue_depth = other.m_queue_depth;
+        m_block_size  = other.m_block_size;
+        m_direct_io   = other.m_direct_io;
         init();
     }
     return *this;
@@ -39,6 +43,10 @@ void FileHsmObjectStoreClientConfig::init()
 {
     register_scalar_field(&m_root);
     register_scalar_field(&m_mode);
+    register_scalar_field(&m_io_engine);
+    register_scalar_field(&m_queue_depth);
+    register_scalar_field(&m_block_size);
+    register_scalar_field(&m_direct_io);
 }
 
 const std::string& FileHsmObjectStoreClientConfig::get_root() const
@@ -52,6 +60,15 @@ FileObjectStoreClientConfig::Mode FileHsmObjectStoreClientConfig::get_mode()
     return m_mode.get_value();
 }
 
+void FileHsmObjectStoreClientConfig::apply_io_settings(
+    FileObjectStoreClientConfig& config) const
+{
+    config.m_io_engine.init_value(m_io_engine.get_value());
+    config.m_queue_depth.init_value(m_queue_depth.get_value());
+    config.m_block_size.init_value(m_block_size.get_value());
+    config.m_direct_io.init_value(m_direct_io.get_value());
+}
+
 FileHsmObjectStoreClient::FileHsmObjectStoreClient()
 {
     LOG_INFO("Created");
@@ -108,6 +125,7 @@ void FileHsmObjectStoreClient::do_initialize(
                 FileObjectStoreClientConfig::Mode::DATA_ONLY);
             file_config.m_root.init_value(
                 (m_store / ("tier" + tier_id)).string());
+            config.apply_io_settings(file_config);
 
             auto tier_client = std::make_unique<FileObjectStoreClient>();
             tier_client->do_initialize(id, {}, file_config);
@@ -120,16 +138,31 @@ void FileHsmObjectStoreClient::do_initialize(
         FileObjectStoreClientConfig file_config;
         file_config.m_mode.init_value(
             FileObjectStoreClientConfig::Mode::METADATA_ONLY);
-        file_config.m_root = (m_store / "metadata").string();
-        m_metadata_client  = std::make_unique<FileObjectStoreClient>();
+        file_config.m_root.init_value((m_store / "metadata").string());
+        m_metadata_client = std::make_unique<FileObjectStoreClient>();
+        m_metadata_client->do_initialize(id, {}, file_config);
     }
 }
 
-FileObjectStoreClient* FileHsmObjectStoreClient::get_client(uint8_t tier) const
+FileObjectStoreClient* FileHsmObjectStoreClient::get_tier_client(
+    uint8_t tier) const
 {
     if (auto iter = m_tier_clients.find(tier); iter != m_tier_clients.end()) {
         return iter->second.get();
     }
+    return nullptr;
+}
+
+FileObjectStoreClient* FileHsmObjectStoreClient::get_metadata_client() const
+{
+    return m_metadata_client.get();
+}
+
+FileObjectStoreClient* FileHsmObjectStoreClient::get_client(uint8_t tier) const
+{
+    if (auto client = get_tier_client(tier); client != nullptr) {
+        return client;
+    }
     throw std::runtime_error("Unexpected tier input in file hsm client");
 }
 
@@ -228,12 +261,6 @@ void FileHsmObjectStoreClient::remove(
     }
 }
 
-std::filesystem::path FileHsmObjectStoreClient::get_tier_path(
-    uint8_t tier) const
-{
-    return m_store / ("tier" + std::to_string(tier));
-}
-
 void FileHsmObjectStoreClient::copy(const HsmObjectStoreRequest& request) const
 {
     if (m_tier_clients.empty()) {
@@ -242,7 +269,7 @@ void FileHsmObjectStoreClient::copy(const HsmObjectStoreRequest& request) const
 
     auto source_client = get_client(request.source_tier());
     source_client->migrate(
-        request.object().id(), get_tier_path(request.target_tier()), true);
+        request.object().id(), *get_client(request.target_tier()), true);
 }
 
 void FileHsmObjectStoreClient::move(const HsmObjectStoreRequest& request) const
@@ -253,6 +280,6 @@ void FileHsmObjectStoreClient::move(const HsmObjectStoreRequest& request) const
 
     auto source_client = get_client(request.source_tier());
     source_client->migrate(
-        request.object().id(), get_tier_path(request.target_tier()), false);
+        request.object().id(), *get_client(request.target_tier()), false);
 }
 }  // namespace hestia
@@ -21,6 +21,13 @@ class FileHsmObjectStoreClientConfig : public SerializeableWithFields {
 
     FileObjectStoreClientConfig::Mode get_mode() const;
 
+    /**
+     * Copy the io engine settings into the config for a tier's store
+     *
+     * @param config The tier's config
+     */
+    void apply_io_settings(FileObjectStoreClientConfig& config) const;
+
   private:
     void init();
 
@@ -29,6 +36,14 @@ class FileHsmObjectStoreClientConfig : public SerializeableWithFields {
         FileObjectStoreClientConfig::Mode_enum_string_converter>
         m_mode{"mode", FileObjectStoreClientConfig::Mode::DATA_ONLY};
     StringField m_root{"root", "hsm_object_store"};
+    EnumField<
+        FileObjectStoreClientConfig::IoEngine,
+        FileObjectStoreClientConfig::IoEngine_enum_string_converter>
+        m_io_engine{
+            "io_engine", FileObjectStoreClientConfig::IoEngine::BUFFERED};
+    UIntegerField m_queue_depth{"queue_depth", 8};
+    UIntegerField m_block_size{"block_size", 1048576};
+    BooleanField m_direct_io{"direct_io", false};
 };
 
 class FileHsmObjectStoreClient : public HsmObjectStoreClient {
@@ -53,6 +68,21 @@ class FileHsmObjectStoreClient : public HsmObjectStoreClient {
         const std::string& cache_path,
         const FileHsmObjectStoreClientConfig& config);
 
+    /**
+     * Get the store holding a tier's data
+     *
+     * @param tier The tier
+     * @return The tier's store, or nullptr if this client doesn't hold it
+     */
+    FileObjectStoreClient* get_tier_client(uint8_t tier) const;
+
+    /**
+     * Get the store holding object metadata for all tiers
+     *
+     * @return The metadata store, or nullptr in DATA_ONLY mode
+     */
+    FileObjectStoreClient* get_metadata_client() const;
+
   private:
     void put(
         const HsmObjectStoreRequest& request, Stream* stream) const override;
@@ -68,8 +98,6 @@ class FileHsmObjectStoreClient : public HsmObjectStoreClient {
 
     void move(const HsmObjectStoreRequest& request) const override;
 
-    std::filesystem::path get_tier_path(uint8_t tier) const;
-
     FileObjectStoreClient* get_client(uint8_t tier) const;
 
     std::filesystem::path m_store{"hsm_object_store"};
@@ -0,0 +1,312 @@
+#include "FileKeyValueLog.h"
+
+#include "ErrorUtils.h"
+#include "Logger.h"
+
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace hestia {
+
+static constexpr std::size_t s_header_size =
+    sizeof(char) + sizeof(uint32_t) + sizeof(uint64_t);
+
+FileKeyValueLog::FileKeyValueLog(
+    const std::filesystem::path& path, std::size_t fsync_interval) :
+    m_path(path), m_fsync_interval(fsync_interval)
+{
+}
+
+FileKeyValueLog::~FileKeyValueLog()
+{
+    close();
+}
+
+const std::filesystem::path& FileKeyValueLog::get_path() const
+{
+    return m_path;
+}
+
+void FileKeyValueLog::open()
+{
+    if (m_fd != -1) {
+        return;
+    }
+
+    if (m_path.has_parent_path()) {
+        std::filesystem::create_directories(m_path.parent_path());
+    }
+
+    errno = 0;
+    m_fd  = ::open(m_path.c_str(), O_RDWR | O_CREAT | O_APPEND, 0644);
+    if (m_fd == -1) {
+        const std::string msg = "Failed to open key-value log at: "
+                                + m_path.string() + " | "
+                                + ::strerror(errno);
+        LOG_ERROR(msg);
+        THROW_WITH_SOURCE_LOC(msg);
+    }
+
+    struct stat file_stat;
+    if (::fstat(m_fd, &file_stat) == 0) {
+        m_size = static_cast<std::size_t>(file_stat.st_size);
+    }
+}
+
+void FileKeyValueLog::close()
+{
+    if (m_fd == -1) {
+        return;
+    }
+    if (m_unsynced_batches > 0) {
+        ::fsync(m_fd);
+        m_unsynced_batches = 0;
+    }
+    ::close(m_fd);
+    m_fd = -1;
+}
+
+std::size_t FileKeyValueLog::size() const
+{
+    return m_size;
+}
+
+std::size_t FileKeyValueLog::get_record_size(
+    const std::string& key, const std::string& value)
+{
+    return s_header_size + key.size() + value.size();
+}
+
+void FileKeyValueLog::serialize(
+    const Record& record,
+    std::string& buffer,
+    std::size_t base_offset,
+    std::vector<std::size_t>* value_offsets)
+{
+    const auto key_length   = static_cast<uint32_t>(record.m_key.size());
+    const auto value_length = static_cast<uint64_t>(record.m_value.size());
+
+    char header[s_header_size];
+    header[0] = static_cast<char>(record.m_op);
+    std::memcpy(&header[1], &key_length, sizeof(key_length));
+    std::memcpy(
+        &header[1 + sizeof(key_length)], &value_length, sizeof(value_length));
+
+    buffer.append(header, s_header_size);
+    buffer.append(record.m_key);
+    if (value_offsets != nullptr) {
+        value_offsets->push_back(base_offset + buffer.size());
+    }
+    buffer.append(record.m_value);
+}
+
+void FileKeyValueLog::write_all(int fd, const std::string& buffer) const
+{
+    std::size_t written{0};
+    while (written < buffer.size()) {
+        errno            = 0;
+        const auto count = ::write(
+            fd, buffer.data() + written, buffer.size() - written);
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            const std::string msg = "Failed to write to key-value log at: "
+                                    + m_path.string() + " | "
+                                    + ::strerror(errno);
+            LOG_ERROR(msg);
+            THROW_WITH_SOURCE_LOC(msg);
+        }
+        written += static_cast<std::size_t>(count);
+    }
+}
+
+std::size_t FileKeyValueLog::append(
+    const std::vector<Record>& records, std::vector<std::size_t>* value_offsets)
+{
+    if (records.empty()) {
+        return 0;
+    }
+    open();
+
+    const auto num_offsets = value_offsets ? value_offsets->size() : 0;
+    std::string buffer;
+    for (const auto& record : records) {
+        serialize(record, buffer, m_size, value_offsets);
+    }
+    try {
+        write_all(m_fd, buffer);
+    }
+    catch (const std::exception&) {
+        // Drop any partial write so later records land where expected
+        if (::ftruncate(m_fd, static_cast<off_t>(m_size)) != 0) {
+            LOG_ERROR(
+                "Failed to drop partial write from log at: "
+                << m_path.string() << " | " << ::strerror(errno));
+        }
+        if (value_offsets != nullptr) {
+            value_offsets->resize(num_offsets);
+        }
+        throw;
+    }
+    m_size += buffer.size();
+
+    m_unsynced_batches++;
+    if (m_fsync_interval > 0 && m_unsynced_batches >= m_fsync_interval) {
+        sync();
+    }
+    return buffer.size();
+}
+
+void FileKeyValueLog::sync()
+{
+    if (m_fd != -1 && m_unsynced_batches > 0) {
+        ::fsync(m_fd);
+        m_unsynced_batches = 0;
+    }
+}
+
+std::string FileKeyValueLog::read_value(
+    std::size_t offset, std::size_t length) const
+{
+    std::string value(length, 0);
+    std::size_t num_read{0};
+    while (num_read < length) {
+        errno            = 0;
+        const auto count = ::pread(
+            m_fd, &value[num_read], length - num_read,
+            static_cast<off_t>(offset + num_read));
+        if (count < 0 && errno == EINTR) {
+            continue;
+        }
+        if (count <= 0) {
+            const std::string msg = "Failed to read from key-value log at: "
+                                    + m_path.string();
+            LOG_ERROR(msg);
+            THROW_WITH_SOURCE_LOC(msg);
+        }
+        num_read += static_cast<std::size_t>(count);
+    }
+    return value;
+}
+
+void FileKeyValueLog::replay(onRecordFunc func)
+{
+    open();
+
+    std::string contents(m_size, 0);
+    if (m_size > 0) {
+        contents = read_value(0, m_size);
+    }
+
+    std::size_t offset{0};
+    while (offset + s_header_size <= contents.size()) {
+        const auto op = static_cast<Op>(contents[offset]);
+
+        uint32_t key_length{0};
+        uint64_t value_length{0};
+        std::memcpy(&key_length, &contents[offset + 1], sizeof(key_length));
+        std::memcpy(
+            &value_length, &contents[offset + 1 + sizeof(key_length)],
+            sizeof(value_length));
+
+        const auto record_size = s_header_size + key_length + value_length;
+        if ((op != Op::SET && op != Op::REMOVE)
+            || offset + record_size > contents.size()) {
+            break;
+        }
+
+        const auto key_offset   = offset + s_header_size;
+        const auto value_offset = key_offset + key_length;
+        func(
+            op, contents.substr(key_offset, key_length),
+            contents.substr(value_offset, value_length), value_offset,
+            record_size);
+        offset += record_size;
+    }
+
+    if (offset < contents.size()) {
+        LOG_WARN(
+            "Dropping " << contents.size() - offset
+                        << " bytes of incomplete records from log at: "
+                        << m_path.string());
+        if (::ftruncate(m_fd, static_cast<off_t>(offset)) == 0) {
+            m_size = offset;
+        }
+    }
+}
+
+void FileKeyValueLog::rewrite(
+    const std::vector<Record>& records, std::vector<std::size_t>* value_offsets)
+{
+    auto temp_path = m_path;
+    temp_path += ".compact";
+
+    errno         = 0;
+    const auto fd = ::open(
+        temp_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_APPEND, 0644);
+    if (fd == -1) {
+        const std::string msg = "Failed to open key-value log for rewrite at: "
+                                + temp_path.string() + " | "
+                                + ::strerror(errno);
+        LOG_ERROR(msg);
+        THROW_WITH_SOURCE_LOC(msg);
+    }
+
+    std::string buffer;
+    for (const auto& record : records) {
+        serialize(record, buffer, 0, value_offsets);
+    }
+    try {
+        write_all(fd, buffer);
+    }
+    catch (const std::exception&) {
+        ::close(fd);
+        std::filesystem::remove(temp_path);
+        throw;
+    }
+    ::fsync(fd);
+    ::close(fd);
+
+    close();
+    std::filesystem::rename(temp_path, m_path);
+    sync_parent_dir(m_path);
+    open();
+}
+
+void FileKeyValueLog::create(
+    const std::filesystem::path& path, const std::vector<Record>& records)
+{
+    auto temp_path = path;
+    temp_path += ".create";
+
+    // Left behind if an earlier create was interrupted
+    std::filesystem::remove(temp_path);
+    {
+        FileKeyValueLog log(temp_path);
+        log.open();
+        log.append(records);
+        log.sync();
+    }
+    std::filesystem::rename(temp_path, path);
+    sync_parent_dir(path);
+}
+
+void FileKeyValueLog::sync_parent_dir(const std::filesystem::path& path)
+{
+    // So the rename survives a crash
+    const auto dir = path.has_parent_path() ? path.parent_path() :
+                                              std::filesystem::path(".");
+    const auto fd = ::open(dir.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd == -1) {
+        LOG_WARN("Failed to open log directory for sync: " << dir.string());
+        return;
+    }
+    ::fsync(fd);
+    ::close(fd);
+}
+
+}  // namespace hestia
\ No newline at end of file
@@ -0,0 +1,154 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace hestia {
+
+/**
+ * @brief An append-only log of key-value records on disk
+ *
+ * Records are only ever appended - an update or removal is a new record which
+ * supersedes earlier ones for the same key. Owners rebuild their in-memory
+ * index by replaying the log on startup and periodically compact it by
+ * rewriting only the live records.
+ *
+ * Appends are made with a single write per batch and fsync-ed every
+ * 'fsync_interval' batches, with 0 leaving it to the OS. A torn record at
+ * the end of the log, e.g. from a crash mid-write, is dropped on replay.
+ *
+ * This class is not thread-safe - owners should serialize access.
+ */
+class FileKeyValueLog {
+  public:
+    enum class Op : char { SET = 'S', REMOVE = 'R' };
+
+    struct Record {
+        Op m_op{Op::SET};
+        std::string m_key;
+        std::string m_value;
+    };
+
+    /**
+     * Constructor
+     *
+     * @param path Path to the log file - it is created if needed
+     * @param fsync_interval Number of appended batches between fsyncs, 0 to never explicitly sync
+     */
+    FileKeyValueLog(
+        const std::filesystem::path& path, std::size_t fsync_interval = 0);
+
+    ~FileKeyValueLog();
+
+    /**
+     * Open the log for appending and reading, creating it if needed.
+     */
+    void open();
+
+    /**
+     * Close the log, syncing outstanding appends first.
+     */
+    void close();
+
+    using onRecordFunc = std::function<void(
+        Op op,
+        const std::string& key,
+        const std::string& value,
+        std::size_t value_offset,
+        std::size_t record_size)>;
+
+    /**
+     * Read through the full log in order, calling the provided func for each
+     * record.
+     *
+     * @param func called for each record with the offset of its value in the log
+     */
+    void replay(onRecordFunc func);
+
+    /**
+     * Append a batch of records with a single write.
+     *
+     * @param records The records to append
+     * @param value_offsets If not null it is filled with the log offset of each record's value
+     * @return the total size of the appended records
+     */
+    std::size_t append(
+        const std::vector<Record>& records,
+        std::vector<std::size_t>* value_offsets = nullptr);
+
+    /**
+     * Read a value previously appended to the log
+     *
+     * @param offset The value offset as reported on append or replay
+     * @param length The value length
+     * @return The value
+     */
+    std::string read_value(std::size_t offset, std::size_t length) const;
+
+    /**
+     * Atomically replace the log with one containing only the provided
+     * records - used for compaction. The new log is written to a temporary
+     * file, synced and renamed over the old one.
+     *
+     * @param records The live records to keep
+     * @param value_offsets If not null it is filled with the new log offset of each record's value
+     */
+    void rewrite(
+        const std::vector<Record>& records,
+        std::vector<std::size_t>* value_offsets = nullptr);
+
+    /**
+     * Atomically create a log holding only the provided records, e.g. to
+     * import another store. As for rewrite() the records are written to a
+     * temporary file, synced and renamed into place, so a log at the path
+     * is only ever complete.
+     *
+     * @param path Path to the log file - any existing log there is replaced
+     * @param records The records to write
+     */
+    static void create(
+        const std::filesystem::path& path, const std::vector<Record>& records);
+
+    /**
+     * Force outstanding appends to disk
+     */
+    void sync();
+
+    /**
+     * Size of the log file in bytes
+     *
+     * @return Size of the log file in bytes
+     */
+    std::size_t size() const;
+
+    /**
+     * The on-disk size of a record with the given key and value
+     *
+     * @return The on-disk size of the record
+     */
+    static std::size_t get_record_size(
+        const std::string& key, const std::string& value);
+
+    const std::filesystem::path& get_path() const;
+
+  private:
+    static void serialize(
+        const Record& record,
+        std::string& buffer,
+        std::size_t base_offset,
+        std::vector<std::size_t>* value_offsets);
+
+    void write_all(int fd, const std::string& buffer) const;
+
+    static void sync_parent_dir(const std::filesystem::path& path);
+
+    std::filesystem::path m_path;
+    std::size_t m_fsync_interval{0};
+    std::size_t m_unsynced_batches{0};
+    std::size_t m_size{0};
+    int m_fd{-1};
+};
+}  // namespace hestia
\ No newline at end of file
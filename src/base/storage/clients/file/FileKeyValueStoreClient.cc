@@ -1,16 +1,14 @@
 #include "FileKeyValueStoreClient.h"
 
 #include "File.h"
-#include "FileUtils.h"
 #include "JsonUtils.h"
 #include "StringUtils.h"
 
-#include <fstream>
-#include <iterator>
-#include <set>
-
 #include "Logger.h"
 
+#include <algorithm>
+#include <iterator>
+
 namespace hestia {
 FileKeyValueStoreClient::FileKeyValueStoreClient() {}
 
@@ -30,103 +28,407 @@ void FileKeyValueStoreClient::initialize(
 void FileKeyValueStoreClient::do_initialize(
     const std::string& cache_path, const FileKeyValueStoreClientConfig& config)
 {
+    std::scoped_lock guard(m_mutex);
+
     m_store = std::filesystem::path(config.m_root.get_value());
     if (m_store.is_relative()) {
         m_store = std::filesystem::path(cache_path) / m_store;
     }
+    m_fsync_interval      = config.m_fsync_interval.get_value();
+    m_compaction_min_size = config.m_compaction_min_size.get_value();
     LOG_INFO("Initializing at: " + m_store.string());
+
+    m_loaded = false;
+    load();
+}
+
+void FileKeyValueStoreClient::load() const
+{
+    if (m_loaded) {
+        return;
+    }
+
+    m_string_index.clear();
+    m_set_index.clear();
+    m_legacy_sets.clear();
+    m_string_live_size = 0;
+    m_set_live_size    = 0;
+
+    const auto string_log_path = m_store / "strings.log";
+    if (!std::filesystem::exists(string_log_path)) {
+        migrate_legacy_strings(string_log_path);
+    }
+
+    m_string_log =
+        std::make_unique<FileKeyValueLog>(string_log_path, m_fsync_interval);
+    m_string_log->replay([this](
+                             FileKeyValueLog::Op op, const std::string& key,
+                             const std::string& value, std::size_t offset,
+                             std::size_t record_size) {
+        if (auto iter = m_string_index.find(key);
+            iter != m_string_index.end()) {
+            m_string_live_size -= iter->second.m_record_size;
+            m_string_index.erase(iter);
+        }
+        if (op == FileKeyValueLog::Op::SET) {
+            m_string_index[key] = {offset, value.size(), record_size};
+            m_string_live_size += record_size;
+        }
+    });
+
+    m_set_log = std::make_unique<FileKeyValueLog>(
+        m_store / "sets.log", m_fsync_interval);
+    m_set_log->replay([this](
+                          FileKeyValueLog::Op op, const std::string& key,
+                          const std::string& value, std::size_t,
+                          std::size_t record_size) {
+        auto& members = m_set_index[key];
+        if (op == FileKeyValueLog::Op::SET) {
+            if (members.insert(value).second) {
+                m_set_live_size += record_size;
+            }
+        }
+        else if (members.erase(value) > 0) {
+            m_set_live_size -= FileKeyValueLog::get_record_size(key, value);
+        }
+    });
+
+    if (std::filesystem::is_directory(m_store)) {
+        const std::string legacy_suffix = "_set.meta";
+        for (const auto& entry : std::filesystem::directory_iterator(m_store)) {
+            const auto name = entry.path().filename().string();
+            if (name.size() > legacy_suffix.size()
+                && name.compare(
+                       name.size() - legacy_suffix.size(),
+                       legacy_suffix.size(), legacy_suffix)
+                       == 0) {
+                m_legacy_sets.insert(
+                    name.substr(0, name.size() - legacy_suffix.size()));
+            }
+        }
+    }
+    m_loaded = true;
+}
+
+void FileKeyValueStoreClient::migrate_legacy_strings(
+    const std::filesystem::path& log_path) const
+{
+    const auto legacy_path = m_store / m_db_name;
+    if (!std::filesystem::is_regular_file(legacy_path)) {
+        return;
+    }
+    LOG_INFO("Migrating json key-value store at: " << legacy_path.string());
+
+    Map legacy_values;
+    JsonUtils::read(legacy_path, legacy_values);
+
+    std::vector<FileKeyValueLog::Record> records;
+    legacy_values.for_each_item(
+        [&records](const std::string& key, const std::string& value) {
+            records.push_back({FileKeyValueLog::Op::SET, key, value});
+        });
+
+    // The log only appears once complete, so an interrupted migration is
+    // started again on the next load
+    FileKeyValueLog::create(log_path, records);
+
+    auto migrated_path = legacy_path;
+    migrated_path += ".migrated";
+    std::filesystem::rename(legacy_path, migrated_path);
+}
+
+void FileKeyValueStoreClient::migrate_legacy_set(const std::string& key) const
+{
+    const auto prefix = StringUtils::replace(key, ':', '_');
+    auto iter         = m_legacy_sets.find(prefix);
+    if (iter == m_legacy_sets.end()) {
+        return;
+    }
+
+    const auto legacy_path = m_store / (prefix + "_set.meta");
+    if (!std::filesystem::is_regular_file(legacy_path)) {
+        m_legacy_sets.erase(iter);
+        return;
+    }
+    LOG_INFO("Migrating legacy set file: " << legacy_path.string());
+
+    std::vector<std::string> file_values;
+    {
+        File in_file(legacy_path);
+        in_file.read_lines(file_values);
+    }
+
+    const auto& members = m_set_index[key];
+    std::set<std::string> added;
+    std::vector<FileKeyValueLog::Record> records;
+    for (const auto& value : file_values) {
+        if (!value.empty() && members.count(value) == 0
+            && added.insert(value).second) {
+            records.push_back({FileKeyValueLog::Op::SET, key, value});
+        }
+    }
+    m_set_log->append(records);
+    m_set_log->sync();
+    apply_set_records(records);
+    m_legacy_sets.erase(prefix);
+
+    auto migrated_path = legacy_path;
+    migrated_path += ".migrated";
+    std::filesystem::rename(legacy_path, migrated_path);
+}
+
+void FileKeyValueStoreClient::apply_set_records(
+    const std::vector<FileKeyValueLog::Record>& records) const
+{
+    for (const auto& record : records) {
+        const auto record_size =
+            FileKeyValueLog::get_record_size(record.m_key, record.m_value);
+        auto& members = m_set_index[record.m_key];
+        if (record.m_op == FileKeyValueLog::Op::SET) {
+            if (members.insert(record.m_value).second) {
+                m_set_live_size += record_size;
+            }
+        }
+        else if (members.erase(record.m_value) > 0) {
+            m_set_live_size -= record_size;
+        }
+    }
+}
+
+void FileKeyValueStoreClient::compact_if_needed() const
+{
+    if (m_string_log->size() > m_compaction_min_size
+        && m_string_log->size() > 2 * m_string_live_size) {
+        LOG_INFO("Compacting key-value string log");
+        std::vector<FileKeyValueLog::Record> records;
+        records.reserve(m_string_index.size());
+        for (const auto& [key, location] : m_string_index) {
+            records.push_back(
+                {FileKeyValueLog::Op::SET, key,
+                 m_string_log->read_value(
+                     location.m_offset, location.m_length)});
+        }
+
+        std::vector<std::size_t> offsets;
+        m_string_log->rewrite(records, &offsets);
+        for (std::size_t idx = 0; idx < records.size(); idx++) {
+            m_string_index[records[idx].m_key].m_offset = offsets[idx];
+        }
+    }
+
+    if (m_set_log->size() > m_compaction_min_size
+        && m_set_log->size() > 2 * m_set_live_size) {
+        LOG_INFO("Compacting key-value set log");
+        std::vector<FileKeyValueLog::Record> records;
+        for (auto iter = m_set_index.begin(); iter != m_set_index.end();) {
+            if (iter->second.empty()) {
+                iter = m_set_index.erase(iter);
+                continue;
+            }
+            for (const auto& member : iter->second) {
+                records.push_back(
+                    {FileKeyValueLog::Op::SET, iter->first, member});
+            }
+            iter++;
+        }
+        m_set_log->rewrite(records);
+    }
 }
 
 void FileKeyValueStoreClient::string_get(
     const std::vector<std::string>& keys,
     std::vector<std::string>& values) const
 {
-    JsonUtils::get_values(m_store / m_db_name, keys, values);
+    std::scoped_lock guard(m_mutex);
+    load();
+
+    for (const auto& key : keys) {
+        if (auto iter = m_string_index.find(key);
+            iter != m_string_index.end()) {
+            values.push_back(m_string_log->read_value(
+                iter->second.m_offset, iter->second.m_length));
+        }
+        else {
+            values.push_back("");
+        }
+    }
 }
 
 void FileKeyValueStoreClient::string_set(
     const std::vector<KeyValuePair>& kv_pairs) const
 {
-    const auto path = m_store / m_db_name;
-    FileUtils::create_if_not_existing(path);
-    JsonUtils::set_values(path, kv_pairs);
+    std::scoped_lock guard(m_mutex);
+    load();
+
+    append_strings(kv_pairs);
+    compact_if_needed();
+}
+
+void FileKeyValueStoreClient::append_strings(
+    const VecKeyValuePair& kv_pairs) const
+{
+    std::vector<FileKeyValueLog::Record> records;
+    records.reserve(kv_pairs.size());
+    for (const auto& [key, value] : kv_pairs) {
+        records.push_back({FileKeyValueLog::Op::SET, key, value});
+    }
+
+    std::vector<std::size_t> offsets;
+    m_string_log->append(records, &offsets);
+
+    for (std::size_t idx = 0; idx < kv_pairs.size(); idx++) {
+        const auto& [key, value] = kv_pairs[idx];
+        auto& location           = m_string_index[key];
+        m_string_live_size -= location.m_record_size;
+
+        location = {
+            offsets[idx], value.size(),
+            FileKeyValueLog::get_record_size(key, value)};
+        m_string_live_size += location.m_record_size;
+    }
 }
 
 void FileKeyValueStoreClient::string_remove(
     const std::vector<std::string>& keys) const
 {
-    JsonUtils::remove_keys(m_store / m_db_name, keys);
+    std::scoped_lock guard(m_mutex);
+    load();
+
+    std::vector<FileKeyValueLog::Record> records;
+    for (const auto& key : keys) {
+        if (m_string_index.find(key) != m_string_index.end()) {
+            records.push_back({FileKeyValueLog::Op::REMOVE, key, {}});
+        }
+    }
+    m_string_log->append(records);
+
+    for (const auto& record : records) {
+        if (auto iter = m_string_index.find(record.m_key);
+            iter != m_string_index.end()) {
+            m_string_live_size -= iter->second.m_record_size;
+            m_string_index.erase(iter);
+        }
+    }
+    compact_if_needed();
 }
 
 void FileKeyValueStoreClient::string_exists(
     const std::vector<std::string>& keys, std::vector<bool>& found) const
 {
-    return JsonUtils::has_keys(m_store / m_db_name, keys, found);
+    std::scoped_lock guard(m_mutex);
+    load();
+
+    for (const auto& key : keys) {
+        found.push_back(m_string_index.find(key) != m_string_index.end());
+    }
 }
 
 void FileKeyValueStoreClient::set_add(const VecKeyValuePair& entries) const
 {
-    for (const auto& entry : entries) {
-        const auto prefix = StringUtils::replace(entry.first, ':', '_');
-        const auto path   = m_store / (prefix + "_set.meta");
-        FileUtils::create_if_not_existing(path);
+    std::scoped_lock guard(m_mutex);
+    load();
 
-        std::ofstream out_file(path, std::ios_base::app);
-        out_file << entry.second << "\n";
+    std::set<std::pair<std::string, std::string>> added;
+    std::vector<FileKeyValueLog::Record> records;
+    for (const auto& [key, value] : entries) {
+        migrate_legacy_set(key);
+        auto iter = m_set_index.find(key);
+        if ((iter == m_set_index.end() || iter->second.count(value) == 0)
+            && added.emplace(key, value).second) {
+            records.push_back({FileKeyValueLog::Op::SET, key, value});
+        }
     }
+    m_set_log->append(records);
+    apply_set_records(records);
+    compact_if_needed();
 }
 
 void FileKeyValueStoreClient::set_list(
     const std::vector<std::string>& keys,
     std::vector<std::vector<std::string>>& total_values) const
 {
+    std::scoped_lock guard(m_mutex);
+    load();
+
     for (const auto& key : keys) {
-        const auto prefix = StringUtils::replace(key, ':', '_');
-        const auto path   = m_store / (prefix + "_set.meta");
+        migrate_legacy_set(key);
 
         std::vector<std::string> values;
-        if (!std::filesystem::exists(path)) {
-            total_values.push_back(values);
-            continue;
+        if (auto iter = m_set_index.find(key); iter != m_set_index.end()) {
+            values.assign(iter->second.begin(), iter->second.end());
         }
+        total_values.push_back(values);
+    }
+}
 
-        File in_file(path);
-        std::vector<std::string> file_values;
-        in_file.read_lines(file_values);
+void FileKeyValueStoreClient::set_list_range(
+    const std::vector<std::string>& keys,
+    std::size_t offset,
+    std::size_t count,
+    std::vector<std::vector<std::string>>& total_values,
+    std::vector<std::size_t>& set_sizes) const
+{
+    std::scoped_lock guard(m_mutex);
+    load();
+
+    for (const auto& key : keys) {
+        migrate_legacy_set(key);
 
-        std::set<std::string> s(file_values.begin(), file_values.end());
-        for (const auto& value : s) {
-            values.push_back(value);
+        std::vector<std::string> values;
+        std::size_t set_size{0};
+        if (auto iter = m_set_index.find(key); iter != m_set_index.end()) {
+            set_size = iter->second.size();
+            m_set_pager.list_page(key, iter->second, offset, count, values);
         }
         total_values.push_back(values);
+        set_sizes.push_back(set_size);
     }
 }
 
-void FileKeyValueStoreClient::set_remove(const VecKeyValuePair& entries) const
+void FileKeyValueStoreClient::set_list_between(
+    const std::vector<std::string>& keys,
+    const std::string& min,
+    const std::string& max,
+    std::vector<std::vector<std::string>>& total_values) const
 {
-    for (const auto& entry : entries) {
-        const auto prefix = StringUtils::replace(entry.first, ':', '_');
-        const auto path   = m_store / (prefix + "_set.meta");
+    std::scoped_lock guard(m_mutex);
+    load();
 
-        if (!std::filesystem::exists(path)) {
-            return;
-        }
+    for (const auto& key : keys) {
+        migrate_legacy_set(key);
 
-        std::vector<std::string> file_values;
-        {
-            File in_file(path);
-            in_file.read_lines(file_values);
+        std::vector<std::string> values;
+        if (auto iter = m_set_index.find(key); iter != m_set_index.end()) {
+            const auto& members = iter->second;
+            for (auto member_iter = members.lower_bound(min);
+                 member_iter != members.end() && *member_iter < max;
+                 member_iter++) {
+                values.push_back(*member_iter);
+            }
         }
+        total_values.push_back(values);
+    }
+}
 
-        std::set<std::string> s(file_values.begin(), file_values.end());
-        s.erase(entry.second);
+void FileKeyValueStoreClient::set_remove(const VecKeyValuePair& entries) const
+{
+    std::scoped_lock guard(m_mutex);
+    load();
 
-        std::vector<std::string> write_values;
-        std::copy(s.begin(), s.end(), std::back_inserter(write_values));
+    std::set<std::pair<std::string, std::string>> removed;
+    std::vector<FileKeyValueLog::Record> records;
+    for (const auto& [key, value] : entries) {
+        migrate_legacy_set(key);
 
-        File out_file(path);
-        out_file.write_lines(write_values);
+        auto iter = m_set_index.find(key);
+        if (iter != m_set_index.end() && iter->second.count(value) > 0
+            && removed.emplace(key, value).second) {
+            records.push_back({FileKeyValueLog::Op::REMOVE, key, value});
+        }
     }
+    m_set_log->append(records);
+    apply_set_records(records);
+    compact_if_needed();
 }
 
 }  // namespace hestia
\ No newline at end of file
@@ -1,10 +1,16 @@
 #pragma once
 
+#include "FileKeyValueLog.h"
+#include "KeyValueSetPager.h"
 #include "KeyValueStoreClient.h"
 #include "SerializeableWithFields.h"
 
 #include <filesystem>
+#include <memory>
 #include <mutex>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace hestia {
 
@@ -14,10 +20,27 @@ class FileKeyValueStoreClientConfig : public SerializeableWithFields {
         SerializeableWithFields("file_kv_store_config")
     {
         register_scalar_field(&m_root);
+        register_scalar_field(&m_fsync_interval);
+        register_scalar_field(&m_compaction_min_size);
     }
     StringField m_root{"root", "kv_store"};
+    UIntegerField m_fsync_interval{"fsync_interval", 0};
+    UIntegerField m_compaction_min_size{"compaction_min_size", 4194304};
 };
 
+/**
+ * @brief Key-value store backed by append-only record logs on the filesystem
+ *
+ * Strings and sets each have a FileKeyValueLog. On startup the logs are
+ * replayed into in-memory indices - for strings the index holds the location
+ * of each value in the log, for sets it holds the members. Writes append a
+ * single batch to the log and update the index, so no operation needs to
+ * parse or rewrite the whole store. Once a log is mostly superseded records
+ * it is compacted.
+ *
+ * Stores in the older whole-file json format are migrated on first use.
+ */
+
 class FileKeyValueStoreClient : public KeyValueStoreClient {
   public:
     FileKeyValueStoreClient();
@@ -50,9 +73,54 @@ class FileKeyValueStoreClient : public KeyValueStoreClient {
         const std::vector<std::string>& key,
         std::vector<std::vector<std::string>>& values) const override;
 
+    void set_list_range(
+        const std::vector<std::string>& keys,
+        std::size_t offset,
+        std::size_t count,
+        std::vector<std::vector<std::string>>& values,
+        std::vector<std::size_t>& set_sizes) const override;
+
     void set_remove(const VecKeyValuePair& entry) const override;
 
+    void set_list_between(
+        const std::vector<std::string>& keys,
+        const std::string& min,
+        const std::string& max,
+        std::vector<std::vector<std::string>>& values) const override;
+
+    struct ValueLocation {
+        std::size_t m_offset{0};
+        std::size_t m_length{0};
+        std::size_t m_record_size{0};
+    };
+
+    void load() const;
+
+    void append_strings(const VecKeyValuePair& kv_pairs) const;
+
+    void migrate_legacy_strings(const std::filesystem::path& log_path) const;
+
+    void migrate_legacy_set(const std::string& key) const;
+
+    void apply_set_records(
+        const std::vector<FileKeyValueLog::Record>& records) const;
+
+    void compact_if_needed() const;
+
     std::filesystem::path m_store{"kv_store"};
     std::string m_db_name{"strings_db.json"};
+    std::size_t m_fsync_interval{0};
+    std::size_t m_compaction_min_size{4194304};
+
+    mutable std::mutex m_mutex;
+    mutable bool m_loaded{false};
+    mutable std::unique_ptr<FileKeyValueLog> m_string_log;
+    mutable std::unique_ptr<FileKeyValueLog> m_set_log;
+    mutable std::unordered_map<std::string, ValueLocation> m_string_index;
+    mutable std::unordered_map<std::string, std::set<std::string>> m_set_index;
+    mutable KeyValueSetPager m_set_pager;
+    mutable std::size_t m_string_live_size{0};
+    mutable std::size_t m_set_live_size{0};
+    mutable std::unordered_set<std::string> m_legacy_sets;
 };
 }  // namespace hestia
\ No newline at end of file
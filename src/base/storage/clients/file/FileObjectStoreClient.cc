@@ -1,19 +1,35 @@
 #include "FileObjectStoreClient.h"
 
+#include "AsyncFileStreamSink.h"
+#include "AsyncFileStreamSource.h"
 #include "FileStreamSink.h"
 #include "FileStreamSource.h"
 
 #include "FileUtils.h"
+#include "HashUtils.h"
 #include "Logger.h"
 #include "ProjectConfig.h"
 #include "StringUtils.h"
 
+#include <cstdio>
 #include <exception>
 #include <fstream>
 #include <string>
 
 namespace hestia {
 
+// Two levels of directories named for bytes of the id's FNV-1a hash
+static std::filesystem::path get_shard_dirs(const std::string& object_id)
+{
+    const auto hash = HashUtils::do_fnv1a(object_id);
+
+    char dirs[6];
+    std::snprintf(
+        dirs, sizeof(dirs), "%02x/%02x", static_cast<unsigned>(hash & 0xff),
+        static_cast<unsigned>((hash >> 8) & 0xff));
+    return dirs;
+}
+
 FileObjectStoreClient::Ptr FileObjectStoreClient::create()
 {
     return std::make_unique<FileObjectStoreClient>();
@@ -42,26 +58,223 @@ void FileObjectStoreClient::do_initialize(
 {
     m_id = id;
 
-    m_root = config.m_root.get_value();
-    m_mode = config.m_mode.get_value();
+    m_root                = config.m_root.get_value();
+    m_mode                = config.m_mode.get_value();
+    m_compaction_min_size = config.m_compaction_min_size.get_value();
 
     if (m_root.is_relative()) {
         m_root = std::filesystem::path(cache_path) / m_root;
     }
 
+    if (config.m_io_engine.get_value()
+        == FileObjectStoreClientConfig::IoEngine::ASYNC) {
+        m_async_io = std::make_shared<AsyncFileIoContext>(
+            config.m_queue_depth.get_value(), config.m_block_size.get_value(),
+            config.m_direct_io.get_value());
+    }
+
     LOG_INFO("Initializing with root: " + m_root.string());
 
     hestia::FileUtils::create_if_not_existing(m_root);
+
+    if (needs_metadata()) {
+        load_metadata();
+    }
+}
+
+void FileObjectStoreClient::load_metadata()
+{
+    std::scoped_lock guard(m_metadata_mutex);
+
+    m_metadata.clear();
+    m_metadata_index.clear();
+    m_metadata_live_size = 0;
+
+    const auto log_path = m_root / "metadata.log";
+    if (!std::filesystem::exists(log_path)) {
+        import_legacy_metadata(log_path);
+    }
+
+    m_metadata_log = std::make_unique<FileKeyValueLog>(log_path);
+    m_metadata_log->replay([this](
+                               FileKeyValueLog::Op op, const std::string& key,
+                               const std::string& value, std::size_t,
+                               std::size_t record_size) {
+        unindex_metadata(key);
+        if (op == FileKeyValueLog::Op::SET) {
+            index_metadata(key, deserialize_metadata(value), record_size);
+        }
+    });
+}
+
+void FileObjectStoreClient::import_legacy_metadata(
+    const std::filesystem::path& log_path)
+{
+    if (!std::filesystem::is_directory(m_root)) {
+        return;
+    }
+
+    std::vector<std::filesystem::path> legacy_paths;
+    for (const auto& dir_entry : std::filesystem::directory_iterator(m_root)) {
+        if (FileUtils::is_file_with_extension(dir_entry, ".meta")) {
+            legacy_paths.push_back(dir_entry.path());
+        }
+    }
+    if (legacy_paths.empty()) {
+        return;
+    }
+    LOG_INFO(
+        "Importing " << legacy_paths.size()
+                     << " metadata files at: " << m_root.string());
+
+    std::vector<FileKeyValueLog::Record> records;
+    records.reserve(legacy_paths.size());
+    for (const auto& path : legacy_paths) {
+        MetadataItems items;
+        std::ifstream md_file(path);
+        std::string line;
+        while (std::getline(md_file, line)) {
+            items.push_back(StringUtils::split_on_first(line, ' '));
+        }
+        records.push_back(
+            {FileKeyValueLog::Op::SET,
+             FileUtils::get_filename_without_extension(path),
+             serialize_metadata(items)});
+    }
+
+    // The log only appears once complete, so an interrupted import is
+    // started again on the next load
+    FileKeyValueLog::create(log_path, records);
+
+    for (const auto& path : legacy_paths) {
+        std::filesystem::remove(path);
+    }
+}
+
+std::string FileObjectStoreClient::serialize_metadata(
+    const MetadataItems& items)
+{
+    std::string value;
+    for (const auto& [key, item_value] : items) {
+        value += key;
+        value += '\0';
+        value += item_value;
+        value += '\0';
+    }
+    return value;
+}
+
+FileObjectStoreClient::MetadataItems
+FileObjectStoreClient::deserialize_metadata(const std::string& value)
+{
+    MetadataItems items;
+    std::size_t offset{0};
+    while (offset < value.size()) {
+        const auto key_end = value.find('\0', offset);
+        if (key_end == std::string::npos) {
+            break;
+        }
+        auto value_end = value.find('\0', key_end + 1);
+        if (value_end == std::string::npos) {
+            value_end = value.size();
+        }
+        items.emplace_back(
+            value.substr(offset, key_end - offset),
+            value.substr(key_end + 1, value_end - key_end - 1));
+        offset = value_end + 1;
+    }
+    return items;
+}
+
+void FileObjectStoreClient::index_metadata(
+    const std::string& object_id,
+    const MetadataItems& items,
+    std::size_t record_size) const
+{
+    for (const auto& [key, value] : items) {
+        m_metadata_index[key][value].insert(object_id);
+    }
+    m_metadata[object_id] = {items, record_size};
+    m_metadata_live_size += record_size;
+}
+
+void FileObjectStoreClient::unindex_metadata(const std::string& object_id) const
+{
+    const auto iter = m_metadata.find(object_id);
+    if (iter == m_metadata.end()) {
+        return;
+    }
+
+    for (const auto& [key, value] : iter->second.m_items) {
+        auto key_iter = m_metadata_index.find(key);
+        if (key_iter == m_metadata_index.end()) {
+            continue;
+        }
+        if (auto value_iter = key_iter->second.find(value);
+            value_iter != key_iter->second.end()) {
+            value_iter->second.erase(object_id);
+            if (value_iter->second.empty()) {
+                key_iter->second.erase(value_iter);
+            }
+        }
+        if (key_iter->second.empty()) {
+            m_metadata_index.erase(key_iter);
+        }
+    }
+    m_metadata_live_size -= iter->second.m_record_size;
+    m_metadata.erase(iter);
+}
+
+void FileObjectStoreClient::set_metadata(
+    const std::string& object_id, const MetadataItems& items) const
+{
+    const auto value = serialize_metadata(items);
+
+    std::scoped_lock guard(m_metadata_mutex);
+    m_metadata_log->append({{FileKeyValueLog::Op::SET, object_id, value}});
+    unindex_metadata(object_id);
+    index_metadata(
+        object_id, items, FileKeyValueLog::get_record_size(object_id, value));
+    compact_metadata_if_needed();
+}
+
+void FileObjectStoreClient::remove_metadata(const std::string& object_id) const
+{
+    std::scoped_lock guard(m_metadata_mutex);
+    if (m_metadata.find(object_id) == m_metadata.end()) {
+        return;
+    }
+    m_metadata_log->append({{FileKeyValueLog::Op::REMOVE, object_id, {}}});
+    unindex_metadata(object_id);
+    compact_metadata_if_needed();
+}
+
+void FileObjectStoreClient::compact_metadata_if_needed() const
+{
+    if (m_metadata_log->size() <= m_compaction_min_size
+        || m_metadata_log->size() <= 2 * m_metadata_live_size) {
+        return;
+    }
+
+    LOG_INFO("Compacting object store metadata log");
+    std::vector<FileKeyValueLog::Record> records;
+    records.reserve(m_metadata.size());
+    for (const auto& [object_id, entry] : m_metadata) {
+        records.push_back(
+            {FileKeyValueLog::Op::SET, object_id,
+             serialize_metadata(entry.m_items)});
+    }
+    m_metadata_log->rewrite(records);
 }
 
 void FileObjectStoreClient::remove(const StorageObject& object) const
 {
     if (needs_metadata()) {
-        std::filesystem::remove(get_metadata_path(object.id()));
+        remove_metadata(object.id());
     }
 
     if (needs_data()) {
-        std::filesystem::remove(get_data_path(object.id()));
+        std::filesystem::remove(resolve_data_path(object.id()));
     }
 }
 
@@ -79,7 +292,7 @@ bool FileObjectStoreClient::needs_data() const
 
 void FileObjectStoreClient::migrate(
     const std::string& object_id,
-    const std::filesystem::path& root,
+    const FileObjectStoreClient& target,
     bool keep_existing)
 {
     if (!exists(object_id)) {
@@ -87,42 +300,32 @@ void FileObjectStoreClient::migrate(
             "Couldn't find requested source object during migrate.");
     }
 
-    const auto target_data_path     = get_data_path(object_id, root);
-    const auto target_metadata_path = get_metadata_path(object_id, root);
-    const auto source_data_path     = get_data_path(object_id);
-    const auto source_metadata_path = get_metadata_path(object_id);
-
-    if (needs_data()) {
-        hestia::FileUtils::create_if_not_existing(target_data_path);
-    }
-
-    if (needs_metadata()) {
-        hestia::FileUtils::create_if_not_existing(target_metadata_path);
+    if (&target == this) {
+        return;
     }
 
-    if (keep_existing) {
-        if (needs_metadata()) {
-            std::filesystem::copy(
-                source_metadata_path, target_metadata_path,
-                std::filesystem::copy_options::overwrite_existing);
+    if (needs_metadata() && target.needs_metadata()) {
+        MetadataItems items;
+        {
+            std::scoped_lock guard(m_metadata_mutex);
+            items = m_metadata[object_id].m_items;
         }
-
-        if (needs_data()) {
-            if (std::filesystem::is_regular_file(source_data_path)) {
-                std::filesystem::copy(
-                    source_data_path, target_data_path,
-                    std::filesystem::copy_options::overwrite_existing);
-            }
+        target.set_metadata(object_id, items);
+        if (!keep_existing) {
+            remove_metadata(object_id);
         }
     }
-    else {
-        if (needs_metadata()) {
-            std::filesystem::rename(source_metadata_path, target_metadata_path);
-        }
 
-        if (needs_data()) {
-            if (std::filesystem::is_regular_file(source_data_path)) {
-                std::filesystem::rename(source_data_path, target_data_path);
+    if (needs_data() && target.needs_data()) {
+        const auto source_data_path = resolve_data_path(object_id);
+        const auto target_data_path = target.get_data_path(object_id);
+        if (std::filesystem::is_regular_file(source_data_path)) {
+            hestia::FileUtils::create_if_not_existing(target_data_path);
+            if (keep_existing) {
+                FileUtils::copy_file(source_data_path, target_data_path);
+            }
+            else {
+                FileUtils::move_file(source_data_path, target_data_path);
             }
         }
     }
@@ -134,32 +337,42 @@ bool FileObjectStoreClient::exists(const StorageObject& object) const
 }
 
 void FileObjectStoreClient::put(
-    const StorageObject& object, const Extent&, Stream* stream) const
+    const StorageObject& object, const Extent& extent, Stream* stream) const
 {
     if (needs_metadata()) {
-        auto path = get_metadata_path(object.id());
-        FileUtils::create_if_not_existing(path);
-
-        std::ofstream meta_file(path);
-        auto for_item =
-            [&meta_file](const std::string& key, const std::string& value) {
-                meta_file << key << " " << value << "\n";
-            };
-        object.metadata().for_each_item(for_item);
+        MetadataItems items;
+        object.metadata().for_each_item(
+            [&items](const std::string& key, const std::string& value) {
+                items.emplace_back(key, value);
+            });
+        set_metadata(object.id(), items);
     }
 
     if (needs_data()) {
-        LOG_INFO("Adding to sink: " << get_data_path(object.id()));
+        const auto data_path = resolve_data_path(object.id());
+        LOG_INFO("Adding to sink: " << data_path);
         if (stream != nullptr) {
-            auto stream_sink =
-                std::make_unique<FileStreamSink>(get_data_path(object.id()));
-            stream->set_sink(std::move(stream_sink));
+            // Only a write of the whole object replaces existing content,
+            // others (e.g. multipart upload parts) are written in place
+            const bool is_whole_object =
+                extent.empty()
+                || (extent.m_offset == 0 && extent.m_length == object.size());
+            if (m_async_io) {
+                stream->set_sink(AsyncFileStreamSink::create(
+                    data_path, extent.m_offset, extent.m_length,
+                    is_whole_object, m_async_io));
+            }
+            else {
+                stream->set_sink(FileStreamSink::create(
+                    data_path, extent.m_offset, extent.m_length,
+                    is_whole_object));
+            }
         }
     }
 }
 
 void FileObjectStoreClient::get(
-    StorageObject& object, const Extent&, Stream* stream) const
+    StorageObject& object, const Extent& extent, Stream* stream) const
 {
     if (!exists(object)) {
         const std::string msg =
@@ -176,82 +389,98 @@ void FileObjectStoreClient::get(
 
     if (needs_data()) {
         if (stream != nullptr) {
-            auto stream_source =
-                std::make_unique<FileStreamSource>(get_data_path(object.id()));
-            stream->set_source(std::move(stream_source));
+            const auto data_path = resolve_data_path(object.id());
+            if (m_async_io) {
+                stream->set_source(AsyncFileStreamSource::create(
+                    data_path, extent.m_offset, extent.m_length, m_async_io));
+            }
+            else {
+                stream->set_source(FileStreamSource::create(
+                    data_path, extent.m_offset, extent.m_length));
+            }
         }
     }
 }
 
 bool FileObjectStoreClient::has_data(const std::string& object_id) const
 {
-    return std::filesystem::is_regular_file(get_data_path(object_id));
+    return std::filesystem::is_regular_file(resolve_data_path(object_id));
 }
 
 void FileObjectStoreClient::list(
     const KeyValuePair& query, std::vector<StorageObject>& objects) const
 {
-    for (const auto& dir_entry : std::filesystem::directory_iterator(m_root)) {
-        if (FileUtils::is_file_with_extension(dir_entry, ".meta")) {
-            const auto object_id =
-                FileUtils::get_filename_without_extension(dir_entry.path());
-
-            if (const auto value = get_metadata_item(object_id, query.first);
-                value == query.second) {
-                StorageObject object(object_id);
-                read_metadata(object);
-                objects.push_back(object);
-            }
-        }
+    std::scoped_lock guard(m_metadata_mutex);
+
+    const auto key_iter = m_metadata_index.find(query.first);
+    if (key_iter == m_metadata_index.end()) {
+        return;
+    }
+    const auto value_iter = key_iter->second.find(query.second);
+    if (value_iter == key_iter->second.end()) {
+        return;
     }
-}
 
-std::string FileObjectStoreClient::get_metadata_item(
-    const std::string& object_id, const std::string& search_key) const
-{
-    std::ifstream md_file(get_metadata_path(object_id));
-    std::string line;
-    std::string value;
-    while (std::getline(md_file, line)) {
-        const auto& [key, val] = StringUtils::split_on_first(line, ' ');
-        if (search_key == key) {
-            value = val;
-            break;
+    for (const auto& object_id : value_iter->second) {
+        StorageObject object(object_id);
+        for (const auto& [key, value] : m_metadata[object_id].m_items) {
+            object.set_metadata(key, value);
         }
+        objects.push_back(object);
     }
-    return value;
 }
 
 void FileObjectStoreClient::read_metadata(StorageObject& object) const
 {
-    std::ifstream md_file(get_metadata_path(object.id()));
-    std::pair<std::string, std::string> pair;
-    while (md_file >> pair.first >> pair.second) {
-        object.set_metadata(pair.first, pair.second);
+    std::scoped_lock guard(m_metadata_mutex);
+    if (const auto iter = m_metadata.find(object.id());
+        iter != m_metadata.end()) {
+        for (const auto& [key, value] : iter->second.m_items) {
+            object.set_metadata(key, value);
+        }
     }
 }
 
 std::filesystem::path FileObjectStoreClient::get_data_path(
-    const std::string& object_id, const std::filesystem::path& root) const
+    const std::string& object_id) const
 {
-    return root.empty() ? m_root / (object_id + ".data") :
-                          root / (object_id + ".data");
+    return m_root / get_shard_dirs(object_id) / (object_id + ".data");
 }
 
-std::filesystem::path FileObjectStoreClient::get_metadata_path(
-    const std::string& object_id, const std::filesystem::path& root) const
+std::filesystem::path FileObjectStoreClient::get_legacy_data_path(
+    const std::string& object_id) const
 {
-    return root.empty() ? m_root / (object_id + ".meta") :
-                          root / (object_id + ".meta");
+    return m_root / (object_id + ".data");
+}
+
+std::filesystem::path FileObjectStoreClient::resolve_data_path(
+    const std::string& object_id) const
+{
+    auto path = get_data_path(object_id);
+    if (std::filesystem::exists(path)) {
+        return path;
+    }
+
+    // Move data from the flat layout into place on first use. If another
+    // thread beats us to it the rename fails but the data is in place.
+    if (const auto legacy_path = get_legacy_data_path(object_id);
+        std::filesystem::is_regular_file(legacy_path)) {
+        LOG_INFO("Moving data for " << object_id << " into sharded layout");
+        std::filesystem::create_directories(path.parent_path());
+        std::error_code ec;
+        std::filesystem::rename(legacy_path, path, ec);
+    }
+    return path;
 }
 
 bool FileObjectStoreClient::exists(const std::string& object_id) const
 {
     if (needs_metadata()) {
-        return std::filesystem::is_regular_file(get_metadata_path(object_id));
+        std::scoped_lock guard(m_metadata_mutex);
+        return m_metadata.find(object_id) != m_metadata.end();
     }
     else {
-        return std::filesystem::is_regular_file(get_data_path(object_id));
+        return std::filesystem::is_regular_file(resolve_data_path(object_id));
     }
 }
-}  // namespace hestia
+}  // namespace hestia
\ No newline at end of file
@@ -1,28 +1,64 @@
 #pragma once
 
+#include "AsyncFileIo.h"
+#include "FileKeyValueLog.h"
 #include "ObjectStoreClient.h"
 
 #include "EnumUtils.h"
 
 #include <filesystem>
+#include <mutex>
+#include <set>
+#include <unordered_map>
 
 namespace hestia {
 
 class FileObjectStoreClientConfig : public SerializeableWithFields {
   public:
     STRINGABLE_ENUM(Mode, DATA_AND_METADATA, DATA_ONLY, METADATA_ONLY)
+    STRINGABLE_ENUM(IoEngine, BUFFERED, ASYNC)
 
     FileObjectStoreClientConfig() :
         SerializeableWithFields("file_object_store_client_config")
     {
         register_scalar_field(&m_root);
         register_scalar_field(&m_mode);
+        register_scalar_field(&m_compaction_min_size);
+        register_scalar_field(&m_io_engine);
+        register_scalar_field(&m_queue_depth);
+        register_scalar_field(&m_block_size);
+        register_scalar_field(&m_direct_io);
     }
 
     EnumField<Mode, Mode_enum_string_converter> m_mode{"mode", Mode::DATA_ONLY};
     StringField m_root{"root", "object_store"};
+    UIntegerField m_compaction_min_size{"compaction_min_size", 4194304};
+    EnumField<IoEngine, IoEngine_enum_string_converter> m_io_engine{
+        "io_engine", IoEngine::BUFFERED};
+    UIntegerField m_queue_depth{"queue_depth", 8};
+    UIntegerField m_block_size{"block_size", 1048576};
+    BooleanField m_direct_io{"direct_io", false};
 };
 
+/**
+ * @brief Object store keeping each object's data in a file
+ *
+ * Data files are spread over two levels of directories named for a hash of
+ * the object id, e.g. 'root/3f/a2/<id>.data', so no one directory gets too
+ * big. Data files from the older flat layout, directly under the root, are
+ * moved into place when the object is next accessed.
+ *
+ * Metadata for all objects is kept in a single FileKeyValueLog, replayed
+ * into memory on startup and indexed by metadata key and value so 'list'
+ * doesn't need to touch the filesystem. Per-object '.meta' files from the
+ * older layout are imported into the log on startup. The index is per
+ * client, so one store root shouldn't be shared between processes.
+ *
+ * With the 'ASYNC' io engine data is streamed in 'block_size' pieces with
+ * up to 'queue_depth' reads or writes in flight per stream, using io_uring
+ * where built with liburing and a thread pool otherwise. 'direct_io' opens
+ * data files with O_DIRECT where the filesystem supports it.
+ */
 class FileObjectStoreClient : public ObjectStoreClient {
   public:
     enum class Mode { DATA_AND_METADATA, DATA_ONLY, METADATA_ONLY };
@@ -45,11 +81,25 @@ class FileObjectStoreClient : public ObjectStoreClient {
         const std::string& cache_path,
         const FileObjectStoreClientConfig& config);
 
+    /**
+     * Copy or move an object into another file store
+     *
+     * @param object_id The object to copy or move
+     * @param target The store to copy or move it to
+     * @param keep_existing If true copy the object, otherwise move it
+     */
     void migrate(
         const std::string& object_id,
-        const std::filesystem::path& root,
+        const FileObjectStoreClient& target,
         bool keep_existing = true);
 
+    /**
+     * Whether this store keeps object metadata
+     *
+     * @return True unless the store is in DATA_ONLY mode
+     */
+    bool needs_metadata() const;
+
   private:
     // ObjectStoreClient API
     bool exists(const StorageObject& object) const override;
@@ -69,27 +119,63 @@ class FileObjectStoreClient : public ObjectStoreClient {
         std::vector<StorageObject>& matching_objects) const override;
 
     // Internal API
-    std::filesystem::path get_data_path(
-        const std::string& object_key,
-        const std::filesystem::path& root = {}) const;
-    std::filesystem::path get_metadata_path(
-        const std::string& object_key,
-        const std::filesystem::path& root = {}) const;
+    std::filesystem::path get_data_path(const std::string& object_key) const;
 
-    bool needs_metadata() const;
+    std::filesystem::path get_legacy_data_path(
+        const std::string& object_key) const;
 
-    bool needs_data() const;
+    std::filesystem::path resolve_data_path(
+        const std::string& object_key) const;
 
-    std::string get_metadata_item(
-        const std::string& object_key, const std::string& key) const;
+    bool needs_data() const;
 
     bool has_data(const std::string& object_key) const;
 
     void read_metadata(StorageObject& object) const;
 
+    using MetadataItems = std::vector<std::pair<std::string, std::string>>;
+
+    void load_metadata();
+
+    void import_legacy_metadata(const std::filesystem::path& log_path);
+
+    void set_metadata(
+        const std::string& object_key, const MetadataItems& items) const;
+
+    void remove_metadata(const std::string& object_key) const;
+
+    void index_metadata(
+        const std::string& object_key,
+        const MetadataItems& items,
+        std::size_t record_size) const;
+
+    void unindex_metadata(const std::string& object_key) const;
+
+    void compact_metadata_if_needed() const;
+
+    static std::string serialize_metadata(const MetadataItems& items);
+
+    static MetadataItems deserialize_metadata(const std::string& value);
+
+    struct MetadataEntry {
+        MetadataItems m_items;
+        std::size_t m_record_size{0};
+    };
+
     FileObjectStoreClientConfig m_config;
     std::filesystem::path m_root{"object_store"};
     FileObjectStoreClientConfig::Mode m_mode{
         FileObjectStoreClientConfig::Mode::DATA_ONLY};
+    std::size_t m_compaction_min_size{4194304};
+    std::shared_ptr<AsyncFileIoContext> m_async_io;
+
+    mutable std::mutex m_metadata_mutex;
+    std::unique_ptr<FileKeyValueLog> m_metadata_log;
+    mutable std::unordered_map<std::string, MetadataEntry> m_metadata;
+    mutable std::unordered_map<
+        std::string,
+        std::unordered_map<std::string, std::set<std::string>>>
+        m_metadata_index;
+    mutable std::size_t m_metadata_live_size{0};
 };
 }  // namespace hestia
\ No newline at end of file
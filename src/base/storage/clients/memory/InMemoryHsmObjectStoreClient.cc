@@ -10,31 +10,6 @@
 
 namespace hestia {
 
-InMemoryObjectStoreClientConfig::InMemoryObjectStoreClientConfig() :
-    SerializeableWithFields("in_memory_hsm_object_store_client")
-{
-    init();
-}
-
-InMemoryObjectStoreClientConfig::InMemoryObjectStoreClientConfig(
-    const InMemoryObjectStoreClientConfig& other) :
-    SerializeableWithFields(other)
-{
-    *this = other;
-}
-
-InMemoryObjectStoreClientConfig& InMemoryObjectStoreClientConfig::operator=(
-    const InMemoryObjectStoreClientConfig& other)
-{
-    if (this != &other) {
-        SerializeableWithFields::operator=(other);
-        init();
-    }
-    return *this;
-}
-
-void InMemoryObjectStoreClientConfig::init() {}
-
 InMemoryHsmObjectStoreClient::InMemoryHsmObjectStoreClient()
 {
     LOG_INFO("Created");
@@ -67,13 +42,15 @@ void InMemoryHsmObjectStoreClient::initialize(
 
 void InMemoryHsmObjectStoreClient::do_initialize(
     const std::string& id,
-    const std::string&,
-    const InMemoryObjectStoreClientConfig&)
+    const std::string& cache_path,
+    const InMemoryObjectStoreClientConfig& config)
 {
     m_id = id;
 
     for (const auto& tier_id : m_tier_names) {
-        m_tiers[tier_id] = std::make_unique<InMemoryObjectStoreClient>();
+        auto client = std::make_unique<InMemoryObjectStoreClient>();
+        client->do_initialize(id, cache_path, config);
+        m_tiers[tier_id] = std::move(client);
     }
 }
 
@@ -88,6 +65,14 @@ InMemoryObjectStoreClient* InMemoryHsmObjectStoreClient::get_tier_client(
         + " - it is missing from the input config.");
 }
 
+std::vector<std::string> InMemoryHsmObjectStoreClient::get_eviction_candidates(
+    const HsmObjectStoreRequest& request) const
+{
+    return get_tier_client(request.target_tier())
+        ->get_eviction_candidates(
+            HsmObjectStoreRequest::to_base_request(request));
+}
+
 std::string InMemoryHsmObjectStoreClient::dump() const
 {
     std::string output;
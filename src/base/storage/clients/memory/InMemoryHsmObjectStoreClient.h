@@ -2,25 +2,19 @@
 
 #include "HsmObjectStoreClient.h"
 #include "InMemoryObjectStoreClient.h"
-#include "SerializeableWithFields.h"
 
 #include <unordered_map>
 
 namespace hestia {
-class InMemoryObjectStoreClientConfig : public SerializeableWithFields {
-  public:
-    InMemoryObjectStoreClientConfig();
-
-    InMemoryObjectStoreClientConfig(
-        const InMemoryObjectStoreClientConfig& other);
-
-    InMemoryObjectStoreClientConfig& operator=(
-        const InMemoryObjectStoreClientConfig& other);
-
-  private:
-    void init();
-};
 
+/**
+ * @brief HSM object store with an in-memory store for each tier
+ *
+ * Each tier's store has the settings in the config, e.g. its own memory
+ * budget. A tier short of memory refuses writes, but suggests objects to
+ * move to another tier first - the HSM service moves them so it knows
+ * where they went.
+ */
 class InMemoryHsmObjectStoreClient : public HsmObjectStoreClient {
   public:
     using Ptr = std::unique_ptr<InMemoryHsmObjectStoreClient>;
@@ -43,6 +37,9 @@ class InMemoryHsmObjectStoreClient : public HsmObjectStoreClient {
         const std::string& cache_path,
         const InMemoryObjectStoreClientConfig& config);
 
+    std::vector<std::string> get_eviction_candidates(
+        const HsmObjectStoreRequest& request) const override;
+
     std::string dump() const;
 
   private:
@@ -2,6 +2,7 @@
 
 #include "StringUtils.h"
 
+#include <algorithm>
 #include <iterator>
 #include <set>
 #include <sstream>
@@ -94,6 +95,45 @@ void InMemoryKeyValueStoreClient::set_list(
     }
 }
 
+void InMemoryKeyValueStoreClient::set_list_range(
+    const std::vector<std::string>& keys,
+    std::size_t offset,
+    std::size_t count,
+    std::vector<std::vector<std::string>>& total_values,
+    std::vector<std::size_t>& set_sizes) const
+{
+    for (const auto& key : keys) {
+        std::vector<std::string> values;
+        std::size_t set_size{0};
+        if (auto iter = m_set_db.find(key); iter != m_set_db.end()) {
+            set_size = iter->second.size();
+            m_set_pager.list_page(key, iter->second, offset, count, values);
+        }
+        total_values.push_back(values);
+        set_sizes.push_back(set_size);
+    }
+}
+
+void InMemoryKeyValueStoreClient::set_list_between(
+    const std::vector<std::string>& keys,
+    const std::string& min,
+    const std::string& max,
+    std::vector<std::vector<std::string>>& total_values) const
+{
+    for (const auto& key : keys) {
+        std::vector<std::string> values;
+        if (auto iter = m_set_db.find(key); iter != m_set_db.end()) {
+            const auto& members = iter->second;
+            for (auto member_iter = members.lower_bound(min);
+                 member_iter != members.end() && *member_iter < max;
+                 member_iter++) {
+                values.push_back(*member_iter);
+            }
+        }
+        total_values.push_back(values);
+    }
+}
+
 void InMemoryKeyValueStoreClient::set_remove(
     const VecKeyValuePair& entries) const
 {
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "KeyValueSetPager.h"
 #include "KeyValueStoreClient.h"
 
 #include <map>
@@ -37,9 +38,23 @@ class InMemoryKeyValueStoreClient : public KeyValueStoreClient {
         const std::vector<std::string>& key,
         std::vector<std::vector<std::string>>& values) const override;
 
+    void set_list_range(
+        const std::vector<std::string>& keys,
+        std::size_t offset,
+        std::size_t count,
+        std::vector<std::vector<std::string>>& values,
+        std::vector<std::size_t>& set_sizes) const override;
+
     void set_remove(const VecKeyValuePair& entry) const override;
 
+    void set_list_between(
+        const std::vector<std::string>& keys,
+        const std::string& min,
+        const std::string& max,
+        std::vector<std::vector<std::string>>& values) const override;
+
     mutable std::unordered_map<std::string, std::string> m_string_db;
     mutable std::unordered_map<std::string, std::set<std::string>> m_set_db;
+    mutable KeyValueSetPager m_set_pager;
 };
 }  // namespace hestia
\ No newline at end of file
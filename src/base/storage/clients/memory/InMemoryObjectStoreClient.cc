@@ -6,9 +6,59 @@
 #include "Logger.h"
 #include "ProjectConfig.h"
 
+#include <algorithm>
+#include <stdexcept>
 #include <iostream>
 
 namespace hestia {
+InMemoryObjectStoreClientConfig::InMemoryObjectStoreClientConfig() :
+    SerializeableWithFields("in_memory_hsm_object_store_client")
+{
+    init();
+}
+
+InMemoryObjectStoreClientConfig::InMemoryObjectStoreClientConfig(
+    const InMemoryObjectStoreClientConfig& other) :
+    SerializeableWithFields(other)
+{
+    *this = other;
+}
+
+InMemoryObjectStoreClientConfig& InMemoryObjectStoreClientConfig::operator=(
+    const InMemoryObjectStoreClientConfig& other)
+{
+    if (this != &other) {
+        SerializeableWithFields::operator=(other);
+        m_memory_budget = other.m_memory_budget;
+        m_block_size    = other.m_block_size;
+        m_num_shards    = other.m_num_shards;
+        init();
+    }
+    return *this;
+}
+
+void InMemoryObjectStoreClientConfig::init()
+{
+    register_scalar_field(&m_memory_budget);
+    register_scalar_field(&m_block_size);
+    register_scalar_field(&m_num_shards);
+}
+
+BlockStoreConfig InMemoryObjectStoreClientConfig::get_block_store_config()
+    const
+{
+    BlockStoreConfig config;
+    config.m_memory_budget = m_memory_budget.get_value();
+    config.m_block_size    = m_block_size.get_value();
+    config.m_num_shards    = m_num_shards.get_value();
+    return config;
+}
+
+InMemoryObjectStoreClient::InMemoryObjectStoreClient() :
+    m_data(std::make_unique<BlockStore>())
+{
+}
+
 InMemoryObjectStoreClient::Ptr InMemoryObjectStoreClient::create()
 {
     return std::make_unique<InMemoryObjectStoreClient>();
@@ -20,14 +70,47 @@ std::string InMemoryObjectStoreClient::get_registry_identifier()
            + "::InMemoryObjectStoreClient";
 }
 
+void InMemoryObjectStoreClient::initialize(
+    const std::string& id,
+    const std::string& cache_path,
+    const Dictionary& config_data)
+{
+    InMemoryObjectStoreClientConfig config;
+    config.deserialize(config_data);
+    do_initialize(id, cache_path, config);
+}
+
+void InMemoryObjectStoreClient::do_initialize(
+    const std::string& id,
+    const std::string&,
+    const InMemoryObjectStoreClientConfig& config)
+{
+    m_id   = id;
+    m_data = std::make_unique<BlockStore>(
+        Uuid{}, config.get_block_store_config());
+}
+
 bool InMemoryObjectStoreClient::exists(const StorageObject& object) const
 {
-    return m_metadata.find(object.id()) != m_metadata.end();
+    return has_object(object.id());
+}
+
+bool InMemoryObjectStoreClient::has_object(const std::string& object_id) const
+{
+    std::scoped_lock guard(m_metadata_mutex);
+    return m_metadata.find(object_id) != m_metadata.end();
 }
 
 std::string InMemoryObjectStoreClient::dump() const
 {
-    return m_data.dump();
+    return m_data->dump();
+}
+
+std::vector<std::string> InMemoryObjectStoreClient::get_eviction_candidates(
+    const ObjectStoreRequest& request) const
+{
+    return m_data->get_eviction_candidates(
+        request.object().id(), request.extent());
 }
 
 void InMemoryObjectStoreClient::migrate(
@@ -35,45 +118,89 @@ void InMemoryObjectStoreClient::migrate(
     InMemoryObjectStoreClient* target_client,
     bool delete_after)
 {
-    auto iter                            = m_metadata.find(object_id);
-    target_client->m_metadata[object_id] = iter->second;
+    if (target_client == this) {
+        return;
+    }
 
-    if (delete_after) {
-        m_metadata.erase(object_id);
+    Map metadata;
+    {
+        std::scoped_lock guard(m_metadata_mutex);
+        auto iter = m_metadata.find(object_id);
+        if (iter == m_metadata.end()) {
+            throw std::runtime_error(
+                "Object " + object_id + " not found in store.");
+        }
+        metadata = iter->second;
+    }
+
+    if (m_data->has_key(object_id)) {
+        auto blocks = delete_after ? m_data->take_block_list(object_id) :
+                                     m_data->get_block_list(object_id);
+        if (const auto rc = target_client->m_data->set_block_list(
+                object_id, std::move(blocks));
+            !rc.is_ok()) {
+            if (delete_after) {
+                (void)m_data->set_block_list(object_id, std::move(blocks));
+            }
+            throw std::runtime_error(rc.m_message);
+        }
     }
 
-    target_client->m_data.set_block_list(
-        object_id, m_data.get_block_list(object_id));
+    {
+        std::scoped_lock guard(target_client->m_metadata_mutex);
+        target_client->m_metadata[object_id] = metadata;
+    }
     if (delete_after) {
-        m_data.remove(object_id);
+        std::scoped_lock guard(m_metadata_mutex);
+        m_metadata.erase(object_id);
     }
 }
 
 void InMemoryObjectStoreClient::get(
     StorageObject& object, const Extent& extent, Stream* stream) const
 {
-    auto md_iter = m_metadata.find(object.id());
-    if (md_iter == m_metadata.end()) {
-        const std::string msg =
-            "Object " + object.id() + " not found in store.";
-        LOG_ERROR(msg);
-        throw ObjectStoreException(
-            {ObjectStoreErrorCode::OBJECT_NOT_FOUND, msg});
+    {
+        std::scoped_lock guard(m_metadata_mutex);
+        auto md_iter = m_metadata.find(object.id());
+        if (md_iter == m_metadata.end()) {
+            const std::string msg =
+                "Object " + object.id() + " not found in store.";
+            LOG_ERROR(msg);
+            throw ObjectStoreException(
+                {ObjectStoreErrorCode::OBJECT_NOT_FOUND, msg});
+        }
+        object.get_metadata_as_writeable().merge(md_iter->second);
     }
-    object.get_metadata_as_writeable().merge(md_iter->second);
 
     if (stream != nullptr) {
+        // An empty extent means the whole object
+        auto read_extent = extent;
+        if (read_extent.empty()) {
+            read_extent = {
+                0, m_data->get_extent_bounds(object.id()).get_end()};
+        }
+
         auto source_func =
-            [this, object, extent](
+            [this, object, read_extent](
                 WriteableBufferView& buffer,
                 std::size_t offset) -> InMemoryStreamSource::Status {
-            (void)offset;
-            const auto status = m_data.read(object.id(), extent, buffer);
+            if (offset >= read_extent.m_length) {
+                return {true, 0};
+            }
+
+            // One buffer's worth at a time, from where the stream got to
+            const Extent chunk_extent = {
+                read_extent.m_offset + offset,
+                std::min(buffer.length(), read_extent.m_length - offset)};
+            WriteableBufferView chunk_buffer(
+                buffer.data(), chunk_extent.m_length);
+            const auto status =
+                m_data->read(object.id(), chunk_extent, chunk_buffer);
             return {status.is_ok(), status.m_bytes_read};
         };
-        LOG_INFO("Getting data with size: " << extent.m_length);
+        LOG_INFO("Getting data with size: " << read_extent.m_length);
         auto source = InMemoryStreamSource::create(source_func);
-        source->set_size(extent.m_length);
+        source->set_size(read_extent.m_length);
         stream->set_source(std::move(source));
     }
 }
@@ -82,12 +209,15 @@ void InMemoryObjectStoreClient::put(
     const StorageObject& object, const Extent& extent, Stream* stream) const
 {
     LOG_INFO("Starting client PUT: " + object.to_string());
-    auto md_iter = m_metadata.find(object.id());
-    if (md_iter == m_metadata.end()) {
-        m_metadata[object.id()] = object.metadata();
-    }
-    else {
-        md_iter->second.merge(object.metadata());
+    {
+        std::scoped_lock guard(m_metadata_mutex);
+        auto md_iter = m_metadata.find(object.id());
+        if (md_iter == m_metadata.end()) {
+            m_metadata[object.id()] = object.metadata();
+        }
+        else {
+            md_iter->second.merge(object.metadata());
+        }
     }
 
     if (stream != nullptr) {
@@ -95,9 +225,14 @@ void InMemoryObjectStoreClient::put(
         auto sink_func = [this, object, extent](
                              const ReadableBufferView& buffer,
                              std::size_t offset) -> InMemoryStreamSink::Status {
+            // An empty extent would be taken as the whole object
+            if (buffer.length() == 0) {
+                return {true, 0};
+            }
             const Extent chunk_extent = {
                 extent.m_offset + offset, buffer.length()};
-            const auto status = m_data.write(object.id(), chunk_extent, buffer);
+            const auto status =
+                m_data->write(object.id(), chunk_extent, buffer);
             return {status.is_ok(), buffer.length()};
         };
         auto sink = InMemoryStreamSink::create(sink_func);
@@ -110,23 +245,26 @@ void InMemoryObjectStoreClient::put(
 void InMemoryObjectStoreClient::remove(const StorageObject& object) const
 {
     const auto obj_id = object.id();
-    auto md_iter      = m_metadata.find(obj_id);
-    if (md_iter == m_metadata.end()) {
-        const std::string msg = "Object " + obj_id + " not found in store.";
-        LOG_ERROR(msg);
-        throw ObjectStoreException(
-            {ObjectStoreErrorCode::OBJECT_NOT_FOUND, msg});
-    }
-    m_metadata.erase(md_iter);
-    if (m_data.has_key(obj_id)) {
-        m_data.remove(obj_id);
+    {
+        std::scoped_lock guard(m_metadata_mutex);
+        auto md_iter = m_metadata.find(obj_id);
+        if (md_iter == m_metadata.end()) {
+            const std::string msg =
+                "Object " + obj_id + " not found in store.";
+            LOG_ERROR(msg);
+            throw ObjectStoreException(
+                {ObjectStoreErrorCode::OBJECT_NOT_FOUND, msg});
+        }
+        m_metadata.erase(md_iter);
     }
+    m_data->remove(obj_id);
 }
 
 void InMemoryObjectStoreClient::list(
     const KeyValuePair& query,
     std::vector<StorageObject>& matching_objects) const
 {
+    std::scoped_lock guard(m_metadata_mutex);
     for (const auto& [key, md] : m_metadata) {
         if (md.has_key_and_value(query)) {
             StorageObject object(key);
@@ -2,25 +2,79 @@
 
 #include "BlockStore.h"
 #include "ObjectStoreClient.h"
+#include "SerializeableWithFields.h"
+
+#include <mutex>
 
 namespace hestia {
+class InMemoryObjectStoreClientConfig : public SerializeableWithFields {
+  public:
+    InMemoryObjectStoreClientConfig();
+
+    InMemoryObjectStoreClientConfig(
+        const InMemoryObjectStoreClientConfig& other);
+
+    InMemoryObjectStoreClientConfig& operator=(
+        const InMemoryObjectStoreClientConfig& other);
+
+    BlockStoreConfig get_block_store_config() const;
+
+  private:
+    void init();
+
+    UIntegerField m_memory_budget{"memory_budget", 0};
+    UIntegerField m_block_size{
+        "block_size", BlockAllocator::s_default_block_size};
+    UIntegerField m_num_shards{"num_shards", 16};
+};
+
+/**
+ * @brief Object store keeping data and metadata in memory
+ *
+ * Data is kept in a BlockStore, so with a 'memory_budget' writes which
+ * would exceed it fail. The store's owner can make room first by moving
+ * the objects it suggests elsewhere. Thread-safe.
+ */
 class InMemoryObjectStoreClient : public ObjectStoreClient {
   public:
     using Ptr = std::unique_ptr<InMemoryObjectStoreClient>;
 
+    InMemoryObjectStoreClient();
+
     virtual ~InMemoryObjectStoreClient() = default;
 
     static Ptr create();
 
     static std::string get_registry_identifier();
 
+    void initialize(
+        const std::string& id,
+        const std::string& cache_path,
+        const Dictionary& config) override;
+
+    void do_initialize(
+        const std::string& id,
+        const std::string& cache_path,
+        const InMemoryObjectStoreClientConfig& config);
+
     void migrate(
         const std::string& object_id,
         InMemoryObjectStoreClient* target_client,
         bool delete_after = false);
 
+    std::vector<std::string> get_eviction_candidates(
+        const ObjectStoreRequest& request) const override;
+
     std::string dump() const;
 
+    /**
+     * Return whether the store has the object
+     *
+     * @param object_id The object
+     * @return whether the store has the object
+     */
+    bool has_object(const std::string& object_id) const;
+
   private:
     bool exists(const StorageObject& object) const override;
 
@@ -32,13 +86,12 @@ class InMemoryObjectStoreClient : public ObjectStoreClient {
 
     void remove(const StorageObject& object) const override;
 
-    bool exists(const Uuid& object_id) const;
-
     void list(
         const KeyValuePair& query,
         std::vector<StorageObject>& matching_objects) const override;
 
-    mutable BlockStore m_data;
+    std::unique_ptr<BlockStore> m_data;
+    mutable std::mutex m_metadata_mutex;
     mutable std::unordered_map<std::string, Map> m_metadata;
 };
-}  // namespace hestia
\ No newline at end of file
+}  // namespace hestia
@@ -4,6 +4,9 @@
 
 #include <hiredis.h>
 
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
 #include <optional>
 #include <stdexcept>
 
@@ -43,20 +46,69 @@ class RedisReplyWrapper {
     }
 
     void as_array(std::vector<std::string>& array)
+    {
+        to_array(m_reply, array);
+    }
+
+    /**
+     * Read an array reply to one of the commands queued in a transaction
+     * @param idx the command's index within the transaction
+     * @param array filled with the reply
+     */
+    void exec_element_as_array(
+        std::size_t idx, std::vector<std::string>& array)
+    {
+        check_exec();
+        if (idx >= m_reply->elements) {
+            const std::string msg = "Error making EXEC request - missing reply";
+            LOG_ERROR(msg);
+            throw std::runtime_error(msg);
+        }
+        to_array(m_reply->element[idx], array);
+    }
+
+    /**
+     * Read a SCAN reply
+     * @param keys filled with the keys in this step of the scan
+     * @return the cursor to continue the scan from, "0" once complete
+     */
+    std::string as_scan(std::vector<std::string>& keys)
+    {
+        if (m_reply->type != REDIS_REPLY_ARRAY || m_reply->elements != 2
+            || m_reply->element[0]->type != REDIS_REPLY_STRING) {
+            LOG_ERROR("Error making SCAN request");
+            throw std::runtime_error("Error making SCAN request");
+        }
+        to_array(m_reply->element[1], keys);
+        return std::string(m_reply->element[0]->str, m_reply->element[0]->len);
+    }
+
+    void check_exec()
     {
         if (m_reply->type != REDIS_REPLY_ARRAY) {
-            LOG_ERROR("Error making SADD request");
-            throw std::runtime_error("Error making SADD request");
+            LOG_ERROR("Error making EXEC request - transaction aborted");
+            throw std::runtime_error(
+                "Error making EXEC request - transaction aborted");
         }
+    }
 
+    /**
+     * Check that a transaction ran and that none of its commands failed.
+     * Redis runs the rest of a transaction after a failed command, so a
+     * failure only shows up in that command's element of the EXEC reply.
+     */
+    void check_exec_elements()
+    {
+        check_exec();
         for (std::size_t idx = 0; idx < m_reply->elements; idx++) {
-            auto each_reply = m_reply->element[idx];
-            if (each_reply->type == REDIS_REPLY_STRING) {
-                array.push_back(std::string(each_reply->str, each_reply->len));
-            }
-            else if (m_reply->type != REDIS_REPLY_NIL) {
-                LOG_ERROR("Error making MULTIGET request");
-                throw std::runtime_error("Error making MULTIGET request");
+            const auto each_reply = m_reply->element[idx];
+            if (each_reply->type == REDIS_REPLY_ERROR) {
+                const std::string msg =
+                    "Error in EXEC request - command " + std::to_string(idx)
+                    + " failed: "
+                    + std::string(each_reply->str, each_reply->len);
+                LOG_ERROR(msg);
+                throw std::runtime_error(msg);
             }
         }
     }
@@ -71,6 +123,30 @@ class RedisReplyWrapper {
     }
 
     redisReply* m_reply{nullptr};
+
+  private:
+    static void to_array(redisReply* reply, std::vector<std::string>& array)
+    {
+        if (reply->type != REDIS_REPLY_ARRAY) {
+            LOG_ERROR("Error making set request - expected an array");
+            throw std::runtime_error(
+                "Error making set request - expected an array");
+        }
+
+        for (std::size_t idx = 0; idx < reply->elements; idx++) {
+            auto each_reply = reply->element[idx];
+            if (each_reply->type == REDIS_REPLY_STRING) {
+                array.push_back(std::string(each_reply->str, each_reply->len));
+            }
+            else if (each_reply->type == REDIS_REPLY_NIL) {
+                array.push_back("");
+            }
+            else {
+                LOG_ERROR("Error making MULTIGET request");
+                throw std::runtime_error("Error making MULTIGET request");
+            }
+        }
+    }
 };
 
 class RedisContextWrapper {
@@ -96,9 +172,90 @@ class RedisContextWrapper {
         }
     }
 
+    bool is_valid() const
+    {
+        return m_context != nullptr && m_context->err == 0;
+    }
+
     redisContext* m_context{nullptr};
 };
 
+class RedisContextPool {
+  public:
+    RedisContextPool(
+        const std::string& address, int port, std::size_t max_size) :
+        m_address(address),
+        m_port(port),
+        m_max_size(std::max(max_size, std::size_t{1}))
+    {
+    }
+
+    std::unique_ptr<RedisContextWrapper> acquire()
+    {
+        std::unique_lock<std::mutex> lck(m_mutex);
+        m_cv.wait(lck, [this]() {
+            return !m_idle.empty() || m_num_open < m_max_size;
+        });
+
+        if (!m_idle.empty()) {
+            auto context = std::move(m_idle.back());
+            m_idle.pop_back();
+            return context;
+        }
+
+        // Connect outside the lock so other callers can use idle contexts
+        m_num_open++;
+        lck.unlock();
+        auto context = std::make_unique<RedisContextWrapper>(
+            redisConnect(m_address.c_str(), m_port));
+        if (!context->is_valid()) {
+            release(nullptr);
+            context->check_if_valid();
+        }
+        return context;
+    }
+
+    void release(std::unique_ptr<RedisContextWrapper> context)
+    {
+        {
+            std::scoped_lock guard(m_mutex);
+            if (context && context->is_valid()) {
+                m_idle.push_back(std::move(context));
+            }
+            else {
+                // Broken contexts are dropped and replaced on next acquire
+                m_num_open--;
+            }
+        }
+        m_cv.notify_one();
+    }
+
+  private:
+    std::string m_address;
+    int m_port{0};
+    std::size_t m_max_size{1};
+    std::size_t m_num_open{0};
+    std::vector<std::unique_ptr<RedisContextWrapper>> m_idle;
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+};
+
+class RedisContextLease {
+  public:
+    RedisContextLease(RedisContextPool* pool) :
+        m_pool(pool), m_context(pool->acquire())
+    {
+    }
+
+    ~RedisContextLease() { m_pool->release(std::move(m_context)); }
+
+    RedisContextWrapper* get() const { return m_context.get(); }
+
+  private:
+    RedisContextPool* m_pool{nullptr};
+    std::unique_ptr<RedisContextWrapper> m_context;
+};
+
 RedisKeyValueStoreClient::RedisKeyValueStoreClient() : KeyValueStoreClient() {}
 
 RedisKeyValueStoreClient::~RedisKeyValueStoreClient()
@@ -117,42 +274,85 @@ void RedisKeyValueStoreClient::initialize(
 void RedisKeyValueStoreClient::do_initialize(
     const std::string&, const RedisKeyValueStoreClientConfig& config)
 {
-    m_config     = config;
-    auto context = redisConnect(
-        m_config.m_backend_address.get_value().c_str(),
-        m_config.m_backend_port.get_value());
-    m_context = std::make_unique<RedisContextWrapper>(context);
-    m_context->check_if_valid();
+    m_config = config;
+    m_pool   = std::make_unique<RedisContextPool>(
+        m_config.m_backend_address.get_value(),
+        static_cast<int>(m_config.m_backend_port.get_value()),
+        m_config.m_pool_size.get_value());
+
+    // Connect up-front so a bad address is reported at startup
+    {
+        RedisContextLease lease(m_pool.get());
+    }
+    migrate_legacy_sets();
 }
 
 std::unique_ptr<RedisReplyWrapper> RedisKeyValueStoreClient::make_request(
-    const std::string& request, const std::string& binary_string) const
+    const Command& command) const
 {
-    redisReply* reply;
-    std::unique_lock<std::mutex> lck(m_redis_context_mutex);
-    if (binary_string.empty()) {
-        reply = reinterpret_cast<redisReply*>(
-            redisCommand(m_context->m_context, request.c_str()));
+    auto replies = make_requests({command});
+    return std::move(replies[0]);
+}
+
+std::vector<std::unique_ptr<RedisReplyWrapper>>
+RedisKeyValueStoreClient::make_requests(
+    const std::vector<Command>& commands) const
+{
+    std::vector<std::unique_ptr<RedisReplyWrapper>> replies;
+    if (commands.empty()) {
+        return replies;
     }
-    else {
-        reply = reinterpret_cast<redisReply*>(redisCommand(
-            m_context->m_context, request.c_str(), binary_string.c_str(),
-            binary_string.length()));
+
+    RedisContextLease lease(m_pool.get());
+    auto context = lease.get();
+
+    std::vector<const char*> argv;
+    std::vector<std::size_t> argv_len;
+    for (const auto& command : commands) {
+        argv.clear();
+        argv_len.clear();
+        for (const auto& arg : command) {
+            argv.push_back(arg.data());
+            argv_len.push_back(arg.size());
+        }
+        if (redisAppendCommandArgv(
+                context->m_context, static_cast<int>(argv.size()), argv.data(),
+                argv_len.data())
+            != REDIS_OK) {
+            context->check_if_valid();
+        }
     }
-    if (reply == nullptr) {
-        m_context->check_if_valid();
+
+    // All replies are read, even after an error reply, so the connection
+    // isn't left with unread replies when returned to the pool.
+    replies.reserve(commands.size());
+    for (std::size_t idx = 0; idx < commands.size(); idx++) {
+        void* reply{nullptr};
+        if (redisGetReply(context->m_context, &reply) != REDIS_OK
+            || reply == nullptr) {
+            context->check_if_valid();
+        }
+        replies.push_back(std::make_unique<RedisReplyWrapper>(
+            reinterpret_cast<redisReply*>(reply)));
     }
-    return std::make_unique<RedisReplyWrapper>(reply);
+    return replies;
 }
 
 void RedisKeyValueStoreClient::string_exists(
     const std::vector<std::string>& keys, std::vector<bool>& found) const
 {
+    std::vector<Command> commands;
+    for (const auto& key : keys) {
+        if (!key.empty()) {
+            commands.push_back({"EXISTS", key});
+        }
+    }
+    auto replies = make_requests(commands);
+
+    std::size_t reply_idx{0};
     for (const auto& key : keys) {
         if (!key.empty()) {
-            const std::string command = "EXISTS " + key;
-            auto reply                = make_request(command);
-            found.push_back(reply->as_int() == 1);
+            found.push_back(replies[reply_idx++]->as_int() == 1);
         }
         else {
             found.push_back(false);
@@ -165,9 +365,8 @@ void RedisKeyValueStoreClient::string_get(
     std::vector<std::string>& values) const
 {
     if (keys.size() == 1) {
-        const std::string command = "GET " + keys[0];
-        auto reply                = make_request(command);
-        const auto value_opt      = reply->as_string_or_nill();
+        auto reply           = make_request({"GET", keys[0]});
+        const auto value_opt = reply->as_string_or_nill();
         if (value_opt) {
             values.push_back(*value_opt);
         }
@@ -176,10 +375,8 @@ void RedisKeyValueStoreClient::string_get(
         }
     }
     else if (!keys.empty()) {
-        std::string command = "MGET ";
-        for (const auto& k : keys) {
-            command += k + " ";
-        }
+        Command command{"MGET"};
+        command.insert(command.end(), keys.begin(), keys.end());
         auto reply = make_request(command);
         reply->as_array(values);
     }
@@ -188,28 +385,40 @@ void RedisKeyValueStoreClient::string_get(
 void RedisKeyValueStoreClient::string_set(
     const std::vector<KeyValuePair>& kv_pairs) const
 {
-    for (const auto& pair : kv_pairs) {
-        const std::string command = "SET " + pair.first + " %b";
-        auto reply                = make_request(command, pair.second);
-        reply->check_ok();
+    if (kv_pairs.empty()) {
+        return;
     }
+
+    Command command{"MSET"};
+    command.reserve(1 + 2 * kv_pairs.size());
+    for (const auto& [key, value] : kv_pairs) {
+        command.push_back(key);
+        command.push_back(value);
+    }
+    auto reply = make_request(command);
+    reply->check_ok();
 }
 
 void RedisKeyValueStoreClient::string_remove(
     const std::vector<std::string>& keys) const
 {
-    for (const auto& key : keys) {
-        const std::string command = "DEL " + key;
-        auto reply                = make_request(command);
-        reply->as_int();
+    if (keys.empty()) {
+        return;
     }
+
+    Command command{"DEL"};
+    command.insert(command.end(), keys.begin(), keys.end());
+    auto reply = make_request(command);
+    reply->as_int();
 }
 
 void RedisKeyValueStoreClient::set_add(const VecKeyValuePair& entries) const
 {
-    for (const auto& entry : entries) {
-        const std::string command = "SADD " + entry.first + " " + entry.second;
-        auto reply                = make_request(command);
+    std::vector<Command> commands;
+    for (const auto& [key, value] : entries) {
+        commands.push_back({"ZADD", key, "0", value});
+    }
+    for (const auto& reply : make_requests(commands)) {
         reply->as_int();
     }
 }
@@ -218,24 +427,214 @@ void RedisKeyValueStoreClient::set_list(
     const std::vector<std::string>& keys,
     std::vector<std::vector<std::string>>& total_values) const
 {
+    std::vector<Command> commands;
+    for (const auto& key : keys) {
+        if (!key.empty()) {
+            commands.push_back({"ZRANGE", key, "0", "-1"});
+        }
+    }
+    auto replies = make_requests(commands);
+
+    std::size_t reply_idx{0};
+    for (const auto& key : keys) {
+        std::vector<std::string> value;
+        if (!key.empty()) {
+            replies[reply_idx++]->as_array(value);
+        }
+        total_values.push_back(value);
+    }
+}
+
+void RedisKeyValueStoreClient::set_list_range(
+    const std::vector<std::string>& keys,
+    std::size_t offset,
+    std::size_t count,
+    std::vector<std::vector<std::string>>& total_values,
+    std::vector<std::size_t>& set_sizes) const
+{
+    // Members all have the same score so are ranked by value, a page is then
+    // a rank range found in O(log(N)) rather than sorting the whole set
+    const auto start = std::to_string(offset);
+    const auto stop =
+        count == 0 ? std::string("-1") : std::to_string(offset + count - 1);
+    std::vector<Command> commands;
+    for (const auto& key : keys) {
+        if (!key.empty()) {
+            commands.push_back({"ZCARD", key});
+            commands.push_back({"ZRANGE", key, start, stop});
+        }
+    }
+    auto replies = make_requests(commands);
+
+    std::size_t reply_idx{0};
     for (const auto& key : keys) {
         std::vector<std::string> value;
+        std::size_t set_size{0};
         if (!key.empty()) {
-            const std::string command = "SMEMBERS " + key;
-            auto reply                = make_request(command);
-            reply->as_array(value);
+            set_size = static_cast<std::size_t>(replies[reply_idx++]->as_int());
+            replies[reply_idx++]->as_array(value);
         }
         total_values.push_back(value);
+        set_sizes.push_back(set_size);
     }
 }
 
 void RedisKeyValueStoreClient::set_remove(const VecKeyValuePair& entries) const
 {
-    for (const auto& entry : entries) {
-        const std::string command = "SREM " + entry.first + " " + entry.second;
-        auto reply                = make_request(command);
+    std::vector<Command> commands;
+    for (const auto& [key, value] : entries) {
+        commands.push_back({"ZREM", key, value});
+    }
+    for (const auto& reply : make_requests(commands)) {
         reply->as_int();
     }
 }
 
+void RedisKeyValueStoreClient::set_list_between(
+    const std::vector<std::string>& keys,
+    const std::string& min,
+    const std::string& max,
+    std::vector<std::vector<std::string>>& total_values) const
+{
+    // Members share a score so ZRANGEBYLEX finds the bounds by value
+    std::vector<Command> commands;
+    for (const auto& key : keys) {
+        if (!key.empty()) {
+            commands.push_back({"ZRANGEBYLEX", key, "[" + min, "(" + max});
+        }
+    }
+    auto replies = make_requests(commands);
+
+    std::size_t reply_idx{0};
+    for (const auto& key : keys) {
+        std::vector<std::string> value;
+        if (!key.empty()) {
+            replies[reply_idx++]->as_array(value);
+        }
+        total_values.push_back(value);
+    }
+}
+
+void RedisKeyValueStoreClient::set_intersect(
+    const std::vector<std::string>& keys,
+    std::vector<std::string>& values) const
+{
+    if (keys.empty()) {
+        return;
+    }
+
+    // ZINTER needs Redis 6.2, so intersect into a scratch key instead - the
+    // transaction stops concurrent intersections sharing it
+    const std::string scratch_key{"hestia_kv_set_intersect"};
+    Command intersect{
+        "ZINTERSTORE", scratch_key, std::to_string(keys.size())};
+    intersect.insert(intersect.end(), keys.begin(), keys.end());
+    auto replies = make_requests(
+        {{"MULTI"},
+         intersect,
+         {"ZRANGE", scratch_key, "0", "-1"},
+         {"DEL", scratch_key},
+         {"EXEC"}});
+    replies.front()->check_ok();
+    replies.back()->exec_element_as_array(1, values);
+}
+
+void RedisKeyValueStoreClient::migrate_legacy_sets() const
+{
+    // Sets used to be stored as plain Redis sets, which can't be paged
+    // without sorting them. Any left are converted to sorted sets once, with
+    // a marker key recording that it has been done.
+    const std::string marker_key{"hestia_kv_set_format"};
+    if (const auto format =
+            make_request({"GET", marker_key})->as_string_or_nill();
+        format && *format == "zset") {
+        return;
+    }
+
+    const std::string convert_script =
+        "if redis.call('TYPE', KEYS[1]).ok == 'set' then "
+        "local members = redis.call('SMEMBERS', KEYS[1]) "
+        "redis.call('DEL', KEYS[1]) "
+        "for _, member in ipairs(members) do "
+        "redis.call('ZADD', KEYS[1], 0, member) end "
+        "return 1 end "
+        "return 0";
+
+    std::string cursor{"0"};
+    std::size_t num_converted{0};
+    do {
+        std::vector<std::string> keys;
+        cursor = make_request({"SCAN", cursor, "COUNT", "1000"})->as_scan(keys);
+
+        std::vector<Command> commands;
+        for (const auto& key : keys) {
+            commands.push_back({"EVAL", convert_script, "1", key});
+        }
+        for (const auto& reply : make_requests(commands)) {
+            num_converted += static_cast<std::size_t>(reply->as_int());
+        }
+    } while (cursor != "0");
+
+    make_request({"SET", marker_key, "zset"})->check_ok();
+    LOG_INFO("Converted " << num_converted << " sets to sorted sets");
+}
+
+void RedisKeyValueStoreClient::apply_batch(
+    const std::vector<KeyValueStoreRequest>& requests) const
+{
+    // The writes are queued in a MULTI/EXEC transaction and pipelined, so the
+    // batch is applied atomically in one round trip
+    std::vector<Command> commands{{"MULTI"}};
+    for (const auto& request : requests) {
+        switch (request.method()) {
+            case KeyValueStoreRequestMethod::STRING_SET:
+                if (!request.get_kv_pairs().empty()) {
+                    Command command{"MSET"};
+                    for (const auto& [key, value] : request.get_kv_pairs()) {
+                        command.push_back(key);
+                        command.push_back(value);
+                    }
+                    commands.push_back(std::move(command));
+                }
+                break;
+            case KeyValueStoreRequestMethod::STRING_REMOVE:
+                if (!request.get_keys().empty()) {
+                    Command command{"DEL"};
+                    command.insert(
+                        command.end(), request.get_keys().begin(),
+                        request.get_keys().end());
+                    commands.push_back(std::move(command));
+                }
+                break;
+            case KeyValueStoreRequestMethod::SET_ADD:
+                for (const auto& [key, value] : request.get_kv_pairs()) {
+                    commands.push_back({"ZADD", key, "0", value});
+                }
+                break;
+            case KeyValueStoreRequestMethod::SET_REMOVE:
+                for (const auto& [key, value] : request.get_kv_pairs()) {
+                    commands.push_back({"ZREM", key, value});
+                }
+                break;
+            case KeyValueStoreRequestMethod::STRING_EXISTS:
+            case KeyValueStoreRequestMethod::STRING_GET:
+            case KeyValueStoreRequestMethod::SET_LIST:
+            case KeyValueStoreRequestMethod::SET_INTERSECT:
+            case KeyValueStoreRequestMethod::SET_LIST_BETWEEN:
+            default:
+                throw std::runtime_error(
+                    "Method: " + request.method_as_string()
+                    + " not supported in a batch");
+        }
+    }
+    if (commands.size() == 1) {
+        return;
+    }
+    commands.push_back({"EXEC"});
+
+    auto replies = make_requests(commands);
+    replies.front()->check_ok();
+    replies.back()->check_exec_elements();
+}
+
 }  // namespace hestia
\ No newline at end of file
@@ -4,13 +4,13 @@
 #include "SerializeableWithFields.h"
 
 #include <memory>
-#include <mutex>
 #include <string>
+#include <vector>
 
 namespace hestia {
 
 class RedisReplyWrapper;
-class RedisContextWrapper;
+class RedisContextPool;
 
 class RedisKeyValueStoreClientConfig : public SerializeableWithFields {
   public:
@@ -19,12 +19,26 @@ class RedisKeyValueStoreClientConfig : public SerializeableWithFields {
     {
         register_scalar_field(&m_backend_address);
         register_scalar_field(&m_backend_port);
+        register_scalar_field(&m_pool_size);
     }
 
     StringField m_backend_address{"backend_address", "127.0.0.1"};
     UIntegerField m_backend_port{"backend_port", 6379};
+    UIntegerField m_pool_size{"pool_size", 4};
 };
 
+/**
+ * @brief Key-value store backed by a Redis server
+ *
+ * Requests are served from a pool of up to 'pool_size' connections so
+ * concurrent callers don't queue on a single socket. Each batch of keys is
+ * sent as one pipelined group of commands - or a single multi-key command
+ * such as MSET where Redis has one - so a batch costs one round trip rather
+ * than one per key.
+ *
+ * Sets are held as sorted sets with every member given the same score, so
+ * they are ordered by value and can be paged by rank.
+ */
 class RedisKeyValueStoreClient : public KeyValueStoreClient {
   public:
     RedisKeyValueStoreClient();
@@ -56,15 +70,40 @@ class RedisKeyValueStoreClient : public KeyValueStoreClient {
         const std::vector<std::string>& key,
         std::vector<std::vector<std::string>>& values) const override;
 
+    void set_list_range(
+        const std::vector<std::string>& keys,
+        std::size_t offset,
+        std::size_t count,
+        std::vector<std::vector<std::string>>& values,
+        std::vector<std::size_t>& set_sizes) const override;
+
     void set_remove(const VecKeyValuePair& entry) const override;
 
+    void set_list_between(
+        const std::vector<std::string>& keys,
+        const std::string& min,
+        const std::string& max,
+        std::vector<std::vector<std::string>>& values) const override;
+
+    void set_intersect(
+        const std::vector<std::string>& keys,
+        std::vector<std::string>& values) const override;
+
+    void apply_batch(
+        const std::vector<KeyValueStoreRequest>& requests) const override;
+
   private:
+    using Command = std::vector<std::string>;
+
     std::unique_ptr<RedisReplyWrapper> make_request(
-        const std::string& request,
-        const std::string& binary_string = "") const;
+        const Command& command) const;
+
+    std::vector<std::unique_ptr<RedisReplyWrapper>> make_requests(
+        const std::vector<Command>& commands) const;
+
+    void migrate_legacy_sets() const;
 
     RedisKeyValueStoreClientConfig m_config;
-    std::unique_ptr<RedisContextWrapper> m_context;
-    mutable std::mutex m_redis_context_mutex;
+    std::unique_ptr<RedisContextPool> m_pool;
 };
 }  // namespace hestia
\ No newline at end of file
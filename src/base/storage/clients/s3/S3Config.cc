@@ -25,6 +25,10 @@ S3Config& S3Config::operator=(const S3Config& other)
         m_uri_style                = other.m_uri_style;
         m_s3_access_key_id         = other.m_s3_access_key_id;
         m_s3_secret_access_key_var = other.m_s3_secret_access_key_var;
+        m_part_size                = other.m_part_size;
+        m_multipart_threshold      = other.m_multipart_threshold;
+        m_max_parallel_parts       = other.m_max_parallel_parts;
+        m_max_part_attempts        = other.m_max_part_attempts;
         init();
     }
     return *this;
@@ -39,6 +43,10 @@ void S3Config::init()
     register_scalar_field(&m_uri_style);
     register_scalar_field(&m_s3_access_key_id);
     register_scalar_field(&m_s3_secret_access_key_var);
+    register_scalar_field(&m_part_size);
+    register_scalar_field(&m_multipart_threshold);
+    register_scalar_field(&m_max_parallel_parts);
+    register_scalar_field(&m_max_part_attempts);
 }
 
 const std::string& S3Config::get_metadata_prefix() const
@@ -56,6 +64,26 @@ bool S3Config::is_path_uri_style() const
     return m_uri_style.get_value() == UriStyle::PATH;
 }
 
+std::size_t S3Config::get_part_size() const
+{
+    return m_part_size.get_value();
+}
+
+std::size_t S3Config::get_multipart_threshold() const
+{
+    return m_multipart_threshold.get_value();
+}
+
+std::size_t S3Config::get_max_parallel_parts() const
+{
+    return m_max_parallel_parts.get_value();
+}
+
+std::size_t S3Config::get_max_part_attempts() const
+{
+    return m_max_part_attempts.get_value();
+}
+
 const std::string& S3Config::get_user_agent() const
 {
     return m_user_agent.get_value();
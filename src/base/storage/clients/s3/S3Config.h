@@ -27,6 +27,14 @@ class S3Config : public SerializeableWithFields {
 
     bool is_path_uri_style() const;
 
+    std::size_t get_part_size() const;
+
+    std::size_t get_multipart_threshold() const;
+
+    std::size_t get_max_parallel_parts() const;
+
+    std::size_t get_max_part_attempts() const;
+
     S3Config& operator=(const S3Config& other);
 
   private:
@@ -69,5 +77,28 @@ class S3Config : public SerializeableWithFields {
      **/
     EnumField<UriStyle, UriStyle_enum_string_converter> m_uri_style{
         "uri_style", UriStyle::PATH};
+
+    /**
+     * Objects are put and got in parts of this size when they are at least
+     * 'multipart_threshold' bytes
+     **/
+    UIntegerField m_part_size{"part_size", 8 * 1024 * 1024};
+
+    /**
+     * Objects at least this big are moved in parts - 0 to always use a single
+     *request
+     **/
+    UIntegerField m_multipart_threshold{
+        "multipart_threshold", 16 * 1024 * 1024};
+
+    /**
+     * Maximum number of parts of an object in flight at once
+     **/
+    UIntegerField m_max_parallel_parts{"max_parallel_parts", 4};
+
+    /**
+     * Number of times a part is tried before the transfer fails
+     **/
+    UIntegerField m_max_part_attempts{"max_part_attempts", 3};
 };
 }  // namespace hestia
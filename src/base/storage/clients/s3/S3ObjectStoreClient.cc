@@ -54,6 +54,19 @@ void S3ObjectStoreClient::do_initialize(
     m_container_adapter =
         S3BucketAdapter::create(m_config.get_metadata_prefix());
     m_object_adapter = S3ObjectAdapter::create(m_config.get_metadata_prefix());
+
+    m_transfer_config.m_part_size = m_config.get_part_size();
+    m_transfer_config.m_multipart_threshold =
+        m_config.get_multipart_threshold();
+    m_transfer_config.m_max_parallel_parts = m_config.get_max_parallel_parts();
+    m_transfer_config.m_max_part_attempts  = m_config.get_max_part_attempts();
+}
+
+bool S3ObjectStoreClient::use_parallel_transfer(std::size_t length) const
+{
+    return m_transfer_config.m_multipart_threshold > 0
+           && length >= m_transfer_config.m_multipart_threshold
+           && length > m_transfer_config.m_part_size;
 }
 
 void S3ObjectStoreClient::put(
@@ -80,11 +93,49 @@ void S3ObjectStoreClient::put(
     }
     */
 
-    const auto bucket_status = m_s3_client->head_bucket(s3_bucket, s3_request);
+    ensure_bucket(s3_bucket, s3_request);
+
+    LOG_INFO("Doing PUT with StorageObject: " + object.to_string());
+    LOG_INFO("Doing PUT with S3Object: " + s3_object.to_string());
+
+    S3Status status;
+    const auto length = stream == nullptr ? 0 :
+                        extent.empty()    ? stream->get_source_size() :
+                                            extent.m_length;
+    if (stream != nullptr && stream->has_source()
+        && use_parallel_transfer(length)) {
+        status = m_s3_client->put_object_parallel(
+            s3_object, s3_bucket, s3_request, stream, length,
+            m_transfer_config);
+    }
+    else {
+        status =
+            m_s3_client->put_object(s3_object, s3_bucket, s3_request, stream);
+    }
+    if (!status.is_ok()) {
+        on_bucket_status(s3_bucket, status);
+        throw std::runtime_error(
+            SOURCE_LOC() + " | Error putting s3 object: " + status.to_string());
+    }
+}
+
+void S3ObjectStoreClient::ensure_bucket(
+    const S3Bucket& bucket, const S3Request& request) const
+{
+    {
+        std::scoped_lock guard(m_buckets_mutex);
+        if (m_known_buckets.find(bucket.name()) != m_known_buckets.end()) {
+            return;
+        }
+    }
+
+    const auto bucket_status = m_s3_client->head_bucket(bucket, request);
     if (!bucket_status.is_ok()) {
-        if (bucket_status.get_s3_code() == S3StatusCode::_404_NO_SUCH_BUCKET) {
+        // A HEAD response has no body to carry the S3 error code
+        if (bucket_status.get_s3_code() == S3StatusCode::_404_NO_SUCH_BUCKET
+            || bucket_status.get_code_and_id().first == 404) {
             const auto bucket_create_status =
-                m_s3_client->create_bucket(s3_bucket, s3_request);
+                m_s3_client->create_bucket(bucket, request);
             if (!bucket_create_status.is_ok()) {
                 throw std::runtime_error(
                     SOURCE_LOC() + " | Error creating s3 bucket: "
@@ -98,13 +149,17 @@ void S3ObjectStoreClient::put(
         }
     }
 
-    LOG_INFO("Doing PUT with StorageObject: " + object.to_string());
-    LOG_INFO("Doing PUT with S3Object: " + s3_object.to_string());
-    const auto status =
-        m_s3_client->put_object(s3_object, s3_bucket, s3_request, stream);
-    if (!status.is_ok()) {
-        throw std::runtime_error(
-            SOURCE_LOC() + " | Error putting s3 object: " + status.to_string());
+    std::scoped_lock guard(m_buckets_mutex);
+    m_known_buckets.insert(bucket.name());
+}
+
+void S3ObjectStoreClient::on_bucket_status(
+    const S3Bucket& bucket, const S3Status& status) const
+{
+    if (status.get_s3_code() == S3StatusCode::_404_NO_SUCH_BUCKET) {
+        LOG_INFO("Forgetting removed bucket: " + bucket.name());
+        std::scoped_lock guard(m_buckets_mutex);
+        m_known_buckets.erase(bucket.name());
     }
 }
 
@@ -124,9 +179,19 @@ void S3ObjectStoreClient::get(
     LOG_INFO("Doing GET with S3Object: " + s3_object.to_string());
 
     m_object_adapter->from_s3(object, s3_bucket, s3_object);
-    const auto status =
-        m_s3_client->get_object(s3_object, s3_bucket, s3_request, stream);
+
+    S3Status status;
+    if (stream != nullptr && stream->waiting_for_content()
+        && use_parallel_transfer(extent.m_length)) {
+        status = m_s3_client->get_object_parallel(
+            s3_object, s3_bucket, s3_request, stream, m_transfer_config);
+    }
+    else {
+        status =
+            m_s3_client->get_object(s3_object, s3_bucket, s3_request, stream);
+    }
     if (!status.is_ok()) {
+        on_bucket_status(s3_bucket, status);
         throw std::runtime_error(
             SOURCE_LOC() + " | Error getting s3 object: " + status.to_string());
     }
@@ -144,6 +209,7 @@ void S3ObjectStoreClient::remove(const StorageObject& object) const
     const auto status =
         m_s3_client->delete_object(s3_object, s3_bucket, s3_request);
     if (!status.is_ok()) {
+        on_bucket_status(s3_bucket, status);
         throw std::runtime_error(
             SOURCE_LOC()
             + " | Error deleting s3 object: " + status.to_string());
@@ -12,6 +12,8 @@
 #include "ObjectStoreClient.h"
 
 #include <memory>
+#include <mutex>
+#include <unordered_set>
 
 namespace hestia {
 
@@ -54,9 +56,32 @@ class S3ObjectStoreClient : public ObjectStoreClient {
     void list(const KeyValuePair& query, std::vector<StorageObject>& found)
         const override;
 
+    bool use_parallel_transfer(std::size_t length) const;
+
+    /**
+     * Make sure the bucket exists - creating it if needed. Buckets known to
+     * exist are remembered so a put is usually a single request.
+     *
+     * @param bucket The bucket
+     * @param request Request settings - user, endpoint and timestamp
+     */
+    void ensure_bucket(const S3Bucket& bucket, const S3Request& request) const;
+
+    /**
+     * Forget a remembered bucket if the request status says it is gone
+     *
+     * @param bucket The bucket
+     * @param status The status of a request in the bucket
+     */
+    void on_bucket_status(const S3Bucket& bucket, const S3Status& status) const;
+
     S3Config m_config;
+    S3TransferConfig m_transfer_config;
     S3Client* m_s3_client{nullptr};
     std::unique_ptr<S3BucketAdapter> m_container_adapter;
     std::unique_ptr<S3ObjectAdapter> m_object_adapter;
+
+    mutable std::mutex m_buckets_mutex;
+    mutable std::unordered_set<std::string> m_known_buckets;
 };
 }  // namespace hestia
\ No newline at end of file
@@ -18,6 +18,20 @@ class HsmObjectStoreClient : public ObjectStoreClient {
         const HsmObjectStoreRequest& request,
         Stream* stream = nullptr) const noexcept;
 
+    /**
+     * Return objects to move off the PUT request's target tier to make
+     * room for it - none by default
+     *
+     * @param request the PUT request
+     * @return ids of the objects, in the order they should go
+     */
+    virtual std::vector<std::string> get_eviction_candidates(
+        const HsmObjectStoreRequest& request) const
+    {
+        (void)request;
+        return {};
+    }
+
     void set_tier_names(const std::vector<std::string>& tier_names);
 
   protected:
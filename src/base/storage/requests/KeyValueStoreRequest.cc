@@ -31,6 +31,44 @@ const std::vector<std::string>& KeyValueStoreRequest::get_keys() const
     return m_keys;
 }
 
+void KeyValueStoreRequest::set_range(std::size_t offset, std::size_t count)
+{
+    m_offset = offset;
+    m_count  = count;
+}
+
+bool KeyValueStoreRequest::has_range() const
+{
+    return m_offset > 0 || m_count > 0;
+}
+
+std::size_t KeyValueStoreRequest::get_offset() const
+{
+    return m_offset;
+}
+
+std::size_t KeyValueStoreRequest::get_count() const
+{
+    return m_count;
+}
+
+void KeyValueStoreRequest::set_bounds(
+    const std::string& min, const std::string& max)
+{
+    m_min = min;
+    m_max = max;
+}
+
+const std::string& KeyValueStoreRequest::get_min() const
+{
+    return m_min;
+}
+
+const std::string& KeyValueStoreRequest::get_max() const
+{
+    return m_max;
+}
+
 std::string KeyValueStoreRequest::method_as_string() const
 {
     switch (m_method) {
@@ -48,6 +86,10 @@ std::string KeyValueStoreRequest::method_as_string() const
             return "SET_LIST";
         case KeyValueStoreRequestMethod::SET_REMOVE:
             return "SET_REMOVE";
+        case KeyValueStoreRequestMethod::SET_INTERSECT:
+            return "SET_INTERSECT";
+        case KeyValueStoreRequestMethod::SET_LIST_BETWEEN:
+            return "SET_LIST_BETWEEN";
         default:
             return "UNKNOWN";
     }
@@ -13,7 +13,9 @@ enum class KeyValueStoreRequestMethod {
     STRING_REMOVE,
     SET_ADD,
     SET_LIST,
-    SET_REMOVE
+    SET_REMOVE,
+    SET_INTERSECT,
+    SET_LIST_BETWEEN
 };
 
 using KeyValuePair    = std::pair<std::string, std::string>;
@@ -37,10 +39,42 @@ class KeyValueStoreRequest :
 
     const std::vector<std::string>& get_keys() const;
 
+    /**
+     * Limit a SET_LIST request to a page of each set's members, in sorted
+     * order
+     *
+     * @param offset Number of members to skip
+     * @param count Maximum number of members to return, 0 for no limit
+     */
+    void set_range(std::size_t offset, std::size_t count);
+
+    bool has_range() const;
+
+    std::size_t get_offset() const;
+
+    std::size_t get_count() const;
+
+    /**
+     * Bound a SET_LIST_BETWEEN request to the members of each set in
+     * [min, max), in sorted order
+     *
+     * @param min The lowest member to list
+     * @param max The member to list up to, but not including
+     */
+    void set_bounds(const std::string& min, const std::string& max);
+
+    const std::string& get_min() const;
+
+    const std::string& get_max() const;
+
     std::string method_as_string() const override;
 
   private:
     std::vector<std::string> m_keys;
     VecKeyValuePair m_kv_pairs;
+    std::size_t m_offset{0};
+    std::size_t m_count{0};
+    std::string m_min;
+    std::string m_max;
 };
 }  // namespace hestia
\ No newline at end of file
@@ -18,6 +18,16 @@ std::vector<std::vector<std::string>>& KeyValueStoreResponse::ids()
     return m_ids;
 }
 
+const std::vector<std::size_t>& KeyValueStoreResponse::set_sizes() const
+{
+    return m_set_sizes;
+}
+
+std::vector<std::size_t>& KeyValueStoreResponse::set_sizes()
+{
+    return m_set_sizes;
+}
+
 const std::vector<std::string>& KeyValueStoreResponse::get_items() const
 {
     return m_items;
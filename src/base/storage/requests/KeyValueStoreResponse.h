@@ -19,6 +19,10 @@ class KeyValueStoreResponse : public Response<CrudErrorCode> {
 
     std::vector<std::vector<std::string>>& ids();
 
+    const std::vector<std::size_t>& set_sizes() const;
+
+    std::vector<std::size_t>& set_sizes();
+
     const std::vector<std::string>& get_items() const;
 
     std::vector<std::string>& items();
@@ -33,6 +37,7 @@ class KeyValueStoreResponse : public Response<CrudErrorCode> {
 
   private:
     std::vector<std::vector<std::string>> m_ids;
+    std::vector<std::size_t> m_set_sizes;
     std::vector<std::string> m_items;
     std::vector<bool> m_found;
 
@@ -60,6 +60,21 @@ HttpResponse::Ptr CrudWebView::on_get(
             if (has_id) {
                 query.set_ids({id});
             }
+
+            try {
+                if (const auto offset =
+                        request.get_queries().get_item("offset");
+                    !offset.empty()) {
+                    query.set_offset(std::stoul(offset));
+                }
+                if (const auto count = request.get_queries().get_item("count");
+                    !count.empty()) {
+                    query.set_count(std::stoul(count));
+                }
+            }
+            catch (const std::exception&) {
+                return HttpResponse::create(HttpStatus::Code::_400_BAD_REQUEST);
+            }
         }
 
         auto crud_response = m_service->make_request(
@@ -74,6 +89,9 @@ HttpResponse::Ptr CrudWebView::on_get(
         if (has_id && !crud_response->found()) {
             return HttpResponse::create({HttpStatus::Code::_404_NOT_FOUND});
         }
+        response->header().set_item(
+            "hestia-total_count",
+            std::to_string(crud_response->get_total_count()));
 
         if (request.get_header().has_html_accept_type()) {
             std::string json_body;
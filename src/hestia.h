@@ -145,15 +145,16 @@ int hestia_update(
 /// @param subject The type of item to be read, for example a Storage Object (HESTIA_OBJECT)
 /// @param query_format A format specifier for the type of query, e.g. searching with an id or by attributes
 /// @param id_format A format specifier for provided IDs - this allows a range of ways to address items
-/// @param offset Intended for paging but not currently implemented
-/// @param count Intended for paging but not currently implemented
+/// @param offset For listings, the number of items to skip before returning results
+/// @param count For listings, the maximum number of items to return - 0 for no limit
 /// @param input An input buffer for the query, formatted according to query_format
 /// @param len_input Size of the provided input buffer
 /// @param output_format Format specifier for requested output - for example you can request just an ID for the updated
 /// item or its full JSON representation. The buffer will be allocated by Hestia
 /// and should be free'd when finished with 'hestia_finish()'
 /// @param len_output Length of the output buffer - will be returned by Hestia.
-/// @param total_count Intended for paging but not currently implemented
+/// @param total_count If not null it is set to the total number of items matching the query, including
+/// any outside the requested page
 ///
 /// @return 0 on success, hestia_error_e value on failure
 int hestia_read(
@@ -261,6 +261,7 @@ OpStatus HestiaClient::read(const HestiaType& subject, CrudQuery& query)
             HsmItem::to_name(subject.m_hsm_type));
         ERROR_CHECK(response, "READ");
         query.attributes() = response->attributes();
+        query.set_total_count(response->get_total_count());
 
         VecCrudIdentifier ids;
         for (const auto& id : response->ids()) {
@@ -61,6 +61,18 @@ OpStatus HestiaServer::run()
     server_config.m_http_port = m_config.get_server_config().get_port();
     server_config.m_block_on_launch =
         m_config.get_server_config().should_block_on_launch();
+    server_config.m_num_threads =
+        m_config.get_server_config().get_num_threads();
+    server_config.m_listen_backlog =
+        m_config.get_server_config().get_listen_backlog();
+    server_config.m_max_connections =
+        m_config.get_server_config().get_max_connections();
+    server_config.m_keep_alive_timeout =
+        m_config.get_server_config().get_keep_alive_timeout();
+    server_config.m_max_requests_per_connection =
+        m_config.get_server_config().get_max_requests_per_connection();
+    server_config.m_socket_buffer_size =
+        m_config.get_server_config().get_socket_buffer_size();
 
     m_server = std::make_unique<BasicHttpServer>(server_config, web_app.get());
 
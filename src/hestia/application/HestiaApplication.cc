@@ -66,8 +66,12 @@ OpStatus HestiaApplication::initialize(
     std::unique_ptr<CrudServiceBackend> crud_backend;
     if (uses_local_storage()) {
         setup_key_value_store();
+        if (m_config.get_crud_cache_config().is_active()) {
+            m_crud_cache =
+                std::make_unique<CrudCache>(m_config.get_crud_cache_config());
+        }
         crud_backend = std::make_unique<KeyValueStoreCrudServiceBackend>(
-            m_kv_store_client.get());
+            m_kv_store_client.get(), m_crud_cache.get());
     }
     else {
         crud_backend =
@@ -102,6 +106,10 @@ std::string HestiaApplication::get_runtime_info() const
     sstr << "App Mode: "
          << ApplicationMode_enum_string_converter().init().to_string(m_app_mode)
          << '\n';
+    if (m_crud_cache != nullptr) {
+        sstr << "Metadata Cache: " << m_crud_cache->get_stats().to_string()
+             << '\n';
+    }
     return sstr.str();
 }
 
@@ -220,8 +228,9 @@ void HestiaApplication::setup_hsm_service(
     }
 
     auto dpe = DataPlacementEngineFactory::get_engine(
-        PlacementEngineType::BASIC,
-        hsm_services->get_service(HsmItem::Type::TIER));
+        PlacementEngineType::CAPACITY,
+        hsm_services->get_service(HsmItem::Type::TIER),
+        hsm_services->get_service(HsmItem::Type::EXTENT));
 
     ServiceConfig hsm_service_config;
     auto hsm_service = std::make_unique<HsmService>(
@@ -234,8 +243,8 @@ void HestiaApplication::setup_hsm_service(
         const auto output_path =
             get_cache_path() + "/"
             + m_config.get_event_feed_config().get_output_path();
-        auto event_sink =
-            std::make_unique<HsmEventSink>(output_path, m_hsm_service);
+        auto event_sink = std::make_unique<HsmEventSink>(
+            output_path, m_hsm_service, m_config.get_event_feed_config());
         m_event_feed->add_sink(std::move(event_sink));
     }
 
@@ -291,6 +300,8 @@ void HestiaApplication::setup_user_service(
 void HestiaApplication::setup_http_clients()
 {
     CurlClientConfig http_client_config;
+    http_client_config.m_max_idle_handles =
+        m_config.get_http_client_max_idle_handles();
     m_http_client = std::make_unique<CurlClient>(http_client_config);
     m_s3_client   = std::make_unique<S3Client>(m_http_client.get());
 }
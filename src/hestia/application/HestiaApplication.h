@@ -87,6 +87,7 @@ class HestiaApplication : public IHestiaApplication {
 
     std::unique_ptr<EventFeed> m_event_feed;
     std::unique_ptr<KeyValueStoreClient> m_kv_store_client;
+    std::unique_ptr<CrudCache> m_crud_cache;
     std::unique_ptr<HttpClient> m_http_client;
     std::unique_ptr<S3Client> m_s3_client;
     std::unique_ptr<HsmObjectStoreClient> m_object_store_client;
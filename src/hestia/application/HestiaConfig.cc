@@ -34,9 +34,12 @@ HestiaConfig& HestiaConfig::operator=(const HestiaConfig& other)
         m_backends               = other.m_backends;
         m_tiers                  = other.m_tiers;
         m_event_feed_config      = other.m_event_feed_config;
+        m_crud_cache_config      = other.m_crud_cache_config;
 
         m_enable_user_management = other.m_enable_user_management;
         m_enable_default_dataset = other.m_enable_default_dataset;
+        m_http_client_max_idle_handles =
+            other.m_http_client_max_idle_handles;
         init();
     }
     return *this;
@@ -47,6 +50,7 @@ void HestiaConfig::init()
     register_scalar_field(&m_cache_path);
     register_scalar_field(&m_enable_user_management);
     register_scalar_field(&m_enable_default_dataset);
+    register_scalar_field(&m_http_client_max_idle_handles);
     register_map_field(&m_server_config);
 
     register_map_field(&m_logger);
@@ -54,6 +58,7 @@ void HestiaConfig::init()
     register_sequence_field(&m_backends);
     register_sequence_field(&m_tiers);
     register_map_field(&m_event_feed_config);
+    register_map_field(&m_crud_cache_config);
 }
 
 void HestiaConfig::add_object_store_backend(const ObjectStoreBackend& backend)
@@ -66,6 +71,11 @@ void HestiaConfig::add_storage_tier(const StorageTier& tier)
     m_tiers.get_container_as_writeable().push_back(tier);
 }
 
+const CrudCacheConfig& HestiaConfig::get_crud_cache_config() const
+{
+    return m_crud_cache_config.value();
+}
+
 const EventFeedConfig& HestiaConfig::get_event_feed_config() const
 {
     return m_event_feed_config.value();
@@ -98,6 +108,11 @@ const std::vector<StorageTier>& HestiaConfig::get_storage_tiers() const
     return m_tiers.container();
 }
 
+std::size_t HestiaConfig::get_http_client_max_idle_handles() const
+{
+    return m_http_client_max_idle_handles.get_value();
+}
+
 bool HestiaConfig::default_dataset_enabled() const
 {
     return m_enable_default_dataset.get_value();
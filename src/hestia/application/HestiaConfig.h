@@ -1,5 +1,6 @@
 #pragma once
 
+#include "CrudCache.h"
 #include "DataPlacementEngineFactory.h"
 #include "EventFeed.h"
 #include "KeyValueStoreClientFactory.h"
@@ -24,6 +25,8 @@ class HestiaConfig : public SerializeableWithFields {
 
     void add_storage_tier(const StorageTier& tier);
 
+    const CrudCacheConfig& get_crud_cache_config() const;
+
     const EventFeedConfig& get_event_feed_config() const;
 
     const KeyValueStoreClientConfig& get_key_value_store_config() const;
@@ -42,6 +45,8 @@ class HestiaConfig : public SerializeableWithFields {
 
     const std::string& get_user_token() const;
 
+    std::size_t get_http_client_max_idle_handles() const;
+
     bool user_management_enabled() const;
 
     bool default_dataset_enabled() const;
@@ -72,6 +77,8 @@ class HestiaConfig : public SerializeableWithFields {
     StringField m_cache_path{"cache_path"};
     BooleanField m_enable_user_management{"enable_user_management", false};
     BooleanField m_enable_default_dataset{"enable_default_dataset", true};
+    UIntegerField m_http_client_max_idle_handles{
+        "http_client_max_idle_handles", 16};
 
     TypedDictField<ServerConfig> m_server_config{ServerConfig::get_type()};
 
@@ -84,6 +91,8 @@ class HestiaConfig : public SerializeableWithFields {
         std::string(HsmItem::tier_name) + "s"};
     TypedDictField<EventFeedConfig> m_event_feed_config{
         EventFeedConfig::get_type()};
+    TypedDictField<CrudCacheConfig> m_crud_cache_config{
+        CrudCacheConfig::get_type()};
 };
 
 }  // namespace hestia
\ No newline at end of file
@@ -30,6 +30,13 @@ ServerConfig& ServerConfig::operator=(const ServerConfig& other)
         m_tag                = other.m_tag;
         m_api_prefix         = other.m_api_prefix;
         m_run_blocking       = other.m_run_blocking;
+
+        m_num_threads                 = other.m_num_threads;
+        m_listen_backlog              = other.m_listen_backlog;
+        m_max_connections             = other.m_max_connections;
+        m_keep_alive_timeout          = other.m_keep_alive_timeout;
+        m_max_requests_per_connection = other.m_max_requests_per_connection;
+        m_socket_buffer_size          = other.m_socket_buffer_size;
         init();
     }
     return *this;
@@ -50,6 +57,12 @@ void ServerConfig::init()
     register_scalar_field(&m_api_prefix);
     register_scalar_field(&m_tag);
     register_scalar_field(&m_run_blocking);
+    register_scalar_field(&m_num_threads);
+    register_scalar_field(&m_listen_backlog);
+    register_scalar_field(&m_max_connections);
+    register_scalar_field(&m_keep_alive_timeout);
+    register_scalar_field(&m_max_requests_per_connection);
+    register_scalar_field(&m_socket_buffer_size);
 }
 
 const std::string& ServerConfig::get_static_resource_path() const
@@ -92,6 +105,36 @@ bool ServerConfig::should_block_on_launch() const
     return m_run_blocking.get_value();
 }
 
+std::size_t ServerConfig::get_num_threads() const
+{
+    return m_num_threads.get_value();
+}
+
+int ServerConfig::get_listen_backlog() const
+{
+    return static_cast<int>(m_listen_backlog.get_value());
+}
+
+std::size_t ServerConfig::get_max_connections() const
+{
+    return m_max_connections.get_value();
+}
+
+std::size_t ServerConfig::get_keep_alive_timeout() const
+{
+    return m_keep_alive_timeout.get_value();
+}
+
+std::size_t ServerConfig::get_max_requests_per_connection() const
+{
+    return m_max_requests_per_connection.get_value();
+}
+
+std::size_t ServerConfig::get_socket_buffer_size() const
+{
+    return m_socket_buffer_size.get_value();
+}
+
 bool ServerConfig::is_controller() const
 {
     return m_controller.get_value();
@@ -31,6 +31,18 @@ class ServerConfig : public SerializeableWithFields {
 
     bool should_block_on_launch() const;
 
+    std::size_t get_num_threads() const;
+
+    int get_listen_backlog() const;
+
+    std::size_t get_max_connections() const;
+
+    std::size_t get_keep_alive_timeout() const;
+
+    std::size_t get_max_requests_per_connection() const;
+
+    std::size_t get_socket_buffer_size() const;
+
     void set_controller_address(const std::string& host, unsigned port)
     {
         m_controller_address.update_value(host + ":" + std::to_string(port));
@@ -59,5 +71,12 @@ class ServerConfig : public SerializeableWithFields {
     BooleanField m_controller{"is_controller"};
     StringField m_tag{"tag"};
     BooleanField m_run_blocking{"run_blocking", true};
+    UIntegerField m_num_threads{"num_threads", 0};
+    UIntegerField m_listen_backlog{"listen_backlog", 1024};
+    UIntegerField m_max_connections{"max_connections", 4096};
+    UIntegerField m_keep_alive_timeout{"keep_alive_timeout", 5};
+    UIntegerField m_max_requests_per_connection{
+        "max_requests_per_connection", 1000};
+    UIntegerField m_socket_buffer_size{"socket_buffer_size", 1024 * 1024};
 };
 }  // namespace hestia
\ No newline at end of file
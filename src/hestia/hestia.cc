@@ -441,8 +441,6 @@ int hestia_read(
         return hestia_error_e::HESTIA_ERROR_CLIENT_STATE;
     }
 
-    (void)total_count;
-
     std::string query_body;
     if (query_format != HESTIA_QUERY_NONE) {
         if (query == nullptr) {
@@ -488,6 +486,10 @@ int hestia_read(
         return status.m_error_code;
     }
 
+    if (total_count != nullptr) {
+        *total_count = static_cast<int>(crud_query.get_total_count());
+    }
+
     return process_results(
         output_format, crud_query.ids(), crud_query.get_attributes(), response,
         len_response);
@@ -138,12 +138,14 @@ HttpResponse::Ptr HestiaHsmActionView::do_hsm_action(
     std::string redirect_location;
     if (action.is_data_io_action()) {
         auto completion_cb = [request_context = request.get_context(),
-                              &redirect_location](
+                              &redirect_location, this](
                                  HsmActionResponse::Ptr response_ret) {
             if (response_ret->ok()) {
                 LOG_INFO("Data action completed sucessfully");
                 if (!response_ret->get_redirect_location().empty()) {
-                    redirect_location = response_ret->get_redirect_location();
+                    redirect_location = response_ret->get_redirect_location()
+                                        + m_path
+                                        + response_ret->get_redirect_query();
                 }
                 else {
                     auto response = HttpResponse::create();
@@ -163,14 +165,17 @@ HttpResponse::Ptr HestiaHsmActionView::do_hsm_action(
                     HttpResponse::create(500, "Internal Server Error."));
             }
         };
+        HsmActionRequest action_request(
+            action, {auth.m_user_id, auth.m_user_token});
+        action_request.set_placed_tier(request.get_queries());
         m_hestia_service->do_data_io_action(
-            HsmActionRequest(action, {auth.m_user_id, auth.m_user_token}),
-            request.get_context()->get_stream(), completion_cb);
+            action_request, request.get_context()->get_stream(),
+            completion_cb);
 
         if (!redirect_location.empty()) {
             response = HttpResponse::create(307, "Found");
             response->header().set_item(
-                "Location", "http://" + redirect_location + m_path);
+                "Location", "http://" + redirect_location);
         }
     }
     else {
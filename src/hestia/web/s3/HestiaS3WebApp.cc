@@ -16,7 +16,10 @@ HestiaS3WebApp::HestiaS3WebApp(
     HestiaS3WebAppConfig config,
     DistributedHsmService* hsm_service,
     UserService* user_service) :
-    WebApp(user_service), m_config(config), m_hsm_service(hsm_service)
+    WebApp(user_service),
+    m_config(config),
+    m_hsm_service(hsm_service),
+    m_uploads(std::make_unique<S3MultipartUploads>())
 {
     (void)m_config;
     set_up_routing();
@@ -28,8 +31,10 @@ void HestiaS3WebApp::set_up_routing()
 {
     auto s3_router = std::make_unique<S3UrlRouter>();
 
-    s3_router->set_object_view(std::make_unique<S3ObjectView>(m_hsm_service));
-    s3_router->set_bucket_view(std::make_unique<S3BucketView>(m_hsm_service));
+    s3_router->set_object_view(
+        std::make_unique<S3ObjectView>(m_hsm_service, m_uploads.get()));
+    s3_router->set_bucket_view(
+        std::make_unique<S3BucketView>(m_hsm_service, m_uploads.get()));
     s3_router->set_bucket_list_view(
         std::make_unique<S3BucketListView>(m_hsm_service));
 
@@ -1,7 +1,10 @@
 #pragma once
 
+#include "S3MultipartUploads.h"
 #include "WebApp.h"
 
+#include <memory>
+
 namespace hestia {
 
 class DistributedHsmService;
@@ -24,5 +27,6 @@ class HestiaS3WebApp : public WebApp {
   private:
     HestiaS3WebAppConfig m_config;
     DistributedHsmService* m_hsm_service{nullptr};
+    std::unique_ptr<S3MultipartUploads> m_uploads;
 };
 }  // namespace hestia
\ No newline at end of file
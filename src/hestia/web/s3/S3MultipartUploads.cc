@@ -0,0 +1,123 @@
+#include "S3MultipartUploads.h"
+
+#include "HashUtils.h"
+
+#include <algorithm>
+#include <tuple>
+
+namespace hestia {
+
+std::string S3MultipartUploads::get_staging_name(const std::string& upload_id)
+{
+    return s_staging_prefix + upload_id;
+}
+
+bool S3MultipartUploads::is_staging_name(const std::string& name)
+{
+    return name.rfind(s_staging_prefix, 0) == 0;
+}
+
+std::string S3MultipartUploads::generate_id()
+{
+    // Hex encoded, as the raw random bytes aren't valid in xml or json
+    return HashUtils::do_sha256(HashUtils::do_rand_32()).substr(0, 32);
+}
+
+void S3MultipartUploads::add(const Upload& upload)
+{
+    std::scoped_lock guard(m_mutex);
+    m_uploads[upload.m_id] = upload;
+}
+
+S3MultipartUploads::Status S3MultipartUploads::get(
+    const std::string& upload_id, Upload& upload) const
+{
+    std::scoped_lock guard(m_mutex);
+    const auto iter = m_uploads.find(upload_id);
+    if (iter == m_uploads.end()) {
+        return Status::NO_SUCH_UPLOAD;
+    }
+    upload = iter->second;
+    return Status::OK;
+}
+
+void S3MultipartUploads::remove(const std::string& upload_id)
+{
+    std::scoped_lock guard(m_mutex);
+    m_uploads.erase(upload_id);
+}
+
+std::vector<S3MultipartUploads::Upload> S3MultipartUploads::list(
+    const std::string& bucket) const
+{
+    std::vector<Upload> uploads;
+    {
+        std::scoped_lock guard(m_mutex);
+        for (const auto& [id, upload] : m_uploads) {
+            if (upload.m_bucket == bucket) {
+                uploads.push_back(upload);
+            }
+        }
+    }
+    std::sort(
+        uploads.begin(), uploads.end(),
+        [](const Upload& lhs, const Upload& rhs) {
+            return std::tie(lhs.m_key, lhs.m_id)
+                   < std::tie(rhs.m_key, rhs.m_id);
+        });
+    return uploads;
+}
+
+S3MultipartUploads::Status S3MultipartUploads::start_part(
+    const std::string& upload_id,
+    std::size_t number,
+    std::size_t size,
+    std::size_t& offset)
+{
+    std::scoped_lock guard(m_mutex);
+    const auto iter = m_uploads.find(upload_id);
+    if (iter == m_uploads.end()) {
+        return Status::NO_SUCH_UPLOAD;
+    }
+
+    auto& upload = iter->second;
+    if (!upload.m_has_part_stride) {
+        if (number != 1) {
+            return Status::AWAITING_FIRST_PART;
+        }
+        upload.m_has_part_stride = true;
+        upload.m_part_stride     = size;
+    }
+    else if (size > upload.m_part_stride) {
+        return Status::INVALID_PART;
+    }
+    offset = (number - 1) * upload.m_part_stride;
+    return Status::OK;
+}
+
+void S3MultipartUploads::add_part(
+    const std::string& upload_id, const S3Part& part)
+{
+    std::scoped_lock guard(m_mutex);
+    if (const auto iter = m_uploads.find(upload_id); iter != m_uploads.end()) {
+        iter->second.m_parts[part.m_number] = part;
+    }
+}
+
+void S3MultipartUploads::remove_part(
+    const std::string& upload_id, const S3Part& part)
+{
+    std::scoped_lock guard(m_mutex);
+    const auto iter = m_uploads.find(upload_id);
+    if (iter == m_uploads.end()) {
+        return;
+    }
+
+    auto& parts = iter->second.m_parts;
+    if (const auto part_iter = parts.find(part.m_number);
+        part_iter != parts.end() && part_iter->second.m_etag == part.m_etag) {
+        parts.erase(part_iter);
+    }
+}
+
+}  // namespace hestia
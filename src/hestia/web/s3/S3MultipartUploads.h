@@ -0,0 +1,127 @@
+#pragma once
+
+#include "S3MultipartUpload.h"
+
+#include <ctime>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace hestia {
+
+/**
+ * @brief The multipart uploads in progress on this gateway
+ *
+ * The data for an upload is written into a hidden staging object in the
+ * target bucket, with each part stored at a fixed 'stride' offset given by
+ * the size of part 1. Clients upload all parts but the last at the same size,
+ * so the parts of a completed upload sit back to back in the staging object
+ * and completing it only has to update its metadata. Other parts can't be
+ * placed until part 1 has started, so they are turned away until then with a
+ * status the client retries.
+ *
+ * Upload state is kept in memory, so uploads don't survive a restart and all
+ * requests for an upload must reach the same gateway.
+ *
+ * Single object puts are staged the same way, until the payload is accepted.
+ * Staging objects of uploads or puts in progress when a gateway stops are
+ * left behind - gateways share the metadata store, so one starting up can't
+ * tell them from another gateway's live ones. They are hidden from listings
+ * and all named with the staging prefix, so can be found and removed once
+ * no gateway is using them.
+ */
+class S3MultipartUploads {
+  public:
+    struct Upload {
+        std::string m_id;
+        std::string m_bucket;
+        std::string m_key;
+        std::string m_object_id;
+        std::string m_user_id;
+        S3Timestamp m_initiated;
+        bool m_has_part_stride{false};
+        std::size_t m_part_stride{0};
+        std::map<std::size_t, S3Part> m_parts;
+    };
+
+    enum class Status {
+        OK,
+        NO_SUCH_UPLOAD,
+        INVALID_PART,
+        AWAITING_FIRST_PART
+    };
+
+    /**
+     * Name of the staging object holding an upload's or staged put's data
+     *
+     * @param upload_id The upload, or a generated id for a put
+     * @return The object name
+     */
+    static std::string get_staging_name(const std::string& upload_id);
+
+    /**
+     * Whether the object name is for a staging object - which shouldn't be
+     * listed.
+     */
+    static bool is_staging_name(const std::string& name);
+
+    static std::string generate_id();
+
+    void add(const Upload& upload);
+
+    Status get(const std::string& upload_id, Upload& upload) const;
+
+    void remove(const std::string& upload_id);
+
+    /**
+     * Get the uploads in progress for a bucket
+     *
+     * @param bucket The bucket name
+     * @return The uploads, ordered by key then upload id
+     */
+    std::vector<Upload> list(const std::string& bucket) const;
+
+    /**
+     * Reserve space for a part about to be written, fixing the upload's part
+     * stride on part 1.
+     *
+     * @param upload_id The upload
+     * @param number The part number
+     * @param size The part size
+     * @param offset Set to the part's offset in the staging object
+     * @return INVALID_PART if the part is larger than the stride or
+     * AWAITING_FIRST_PART if part 1 hasn't started yet
+     */
+    Status start_part(
+        const std::string& upload_id,
+        std::size_t number,
+        std::size_t size,
+        std::size_t& offset);
+
+    /**
+     * Record a part once its data is written, replacing any earlier upload of
+     * the same part number.
+     *
+     * @param upload_id The upload
+     * @param part The part
+     */
+    void add_part(const std::string& upload_id, const S3Part& part);
+
+    /**
+     * Drop a part whose data was rejected after it was written, unless it
+     * has since been replaced by a new upload of the same part number.
+     *
+     * @param upload_id The upload
+     * @param part The part
+     */
+    void remove_part(const std::string& upload_id, const S3Part& part);
+
+  private:
+    static constexpr const char s_staging_prefix[]{".hestia-staging-"};
+
+    mutable std::mutex m_mutex;
+    std::unordered_map<std::string, Upload> m_uploads;
+};
+}  // namespace hestia
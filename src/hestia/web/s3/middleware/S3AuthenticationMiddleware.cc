@@ -1,5 +1,6 @@
 #include "S3AuthenticationMiddleware.h"
 
+#include "RequestContext.h"
 #include "S3AuthorisationChecker.h"
 
 namespace hestia {
@@ -13,18 +14,22 @@ HttpResponse::Ptr S3AuthenticationMiddleware::call(
         return func(request);
     }
 
-    const auto& auth_response =
+    if (event == HttpEvent::EOM) {
+        if (auto verifier = dynamic_cast<S3PayloadVerifier*>(
+                request.get_context()->get_input_filter());
+            verifier != nullptr) {
+            return on_payload_complete(request, *verifier, func);
+        }
+    }
+
+    auto auth_response =
         S3AuthorisationChecker::authorise(*m_user_service, request);
 
     if (auth_response.m_status == S3AuthorisationChecker::Status::FAILED) {
         LOG_INFO(
             "Did not authenticate user: "
             + auth_response.m_s3_status.to_string());
-
-        const auto& [code, id] = auth_response.m_s3_status.get_code_and_id();
-        auto response          = HttpResponse::create(code, id);
-        response->set_body(auth_response.m_s3_status.to_string());
-        return response;
+        return on_error(auth_response.m_s3_status);
     }
     else if (
         auth_response.m_status
@@ -34,13 +39,16 @@ HttpResponse::Ptr S3AuthenticationMiddleware::call(
             return HttpResponse::create(
                 HttpStatus::Code::_500_INTERNAL_SERVER_ERROR);
         }
-        else {
-            auto response = HttpResponse::create();
-            LOG_INFO("Auth waiting for EOM for signed payload");
-            response->set_completion_status(
-                HttpResponse::CompletionStatus::AWAITING_EOM);
-            return response;
-        }
+
+        auth.m_user_id    = auth_response.m_user.m_id;
+        auth.m_user_token = auth_response.m_user.m_token;
+
+        // The payload is checked as it streams to the view, with the verdict
+        // given at EOM.
+        LOG_INFO("Authenticated user pending payload: " + auth.m_user_id);
+        request.get_context()->set_input_filter(
+            std::move(auth_response.m_payload_verifier));
+        return func(request);
     }
     else {
         auth.m_user_id    = auth_response.m_user.m_id;
@@ -50,4 +58,52 @@ HttpResponse::Ptr S3AuthenticationMiddleware::call(
         return func(request);
     }
 }
-}  // namespace hestia
\ No newline at end of file
+
+HttpResponse::Ptr S3AuthenticationMiddleware::on_payload_complete(
+    const HttpRequest& request,
+    S3PayloadVerifier& verifier,
+    responseProviderFunc func)
+{
+    auto context = request.get_context();
+
+    // The view had the body buffered rather than streamed
+    if (auto& body = context->get_writeable_request().body();
+        verifier.get_num_consumed() == 0 && !body.empty()) {
+        if (const auto result = verifier.write(body); !result.ok()) {
+            LOG_ERROR("Failed to verify buffered payload.");
+            return HttpResponse::create(
+                HttpStatus::Code::_500_INTERNAL_SERVER_ERROR);
+        }
+    }
+
+    S3StatusCode error_code{S3StatusCode::_500_INTERNAL_SERVER_ERROR};
+    switch (verifier.finish()) {
+        case S3PayloadVerifier::Status::OK:
+            return func(request);
+        case S3PayloadVerifier::Status::HASH_MISMATCH:
+            error_code = S3StatusCode::_400_X_AMZ_CONTENT_SHA256_MISMATCH;
+            break;
+        case S3PayloadVerifier::Status::SIGNATURE_MISMATCH:
+            error_code = S3StatusCode::_403_SIGNATURE_DOES_NOT_MATCH;
+            break;
+        case S3PayloadVerifier::Status::INCOMPLETE_BODY:
+            error_code = S3StatusCode::_400_INCOMPLETE_BODY;
+            break;
+        case S3PayloadVerifier::Status::MALFORMED_CHUNK:
+            error_code = S3StatusCode::_400_INVALID_ARGUMENT;
+            break;
+    }
+
+    LOG_INFO("Rejected payload - rolling back.");
+    context->rollback_input();
+    return on_error(S3Status(error_code, S3Request(request)));
+}
+
+HttpResponse::Ptr S3AuthenticationMiddleware::on_error(const S3Status& status)
+{
+    const auto& [code, id] = status.get_code_and_id();
+    auto response          = HttpResponse::create(code, id);
+    response->set_body(status.to_string());
+    return response;
+}
+}  // namespace hestia
@@ -3,6 +3,9 @@
 #include "AuthenticationMiddleware.h"
 
 namespace hestia {
+class S3PayloadVerifier;
+class S3Status;
+
 class S3AuthenticationMiddleware : public AuthenticationMiddleware {
   public:
     virtual ~S3AuthenticationMiddleware() = default;
@@ -11,5 +14,13 @@ class S3AuthenticationMiddleware : public AuthenticationMiddleware {
         AuthorizationContext& user,
         HttpEvent event,
         responseProviderFunc func) override;
+
+  private:
+    HttpResponse::Ptr on_payload_complete(
+        const HttpRequest& request,
+        S3PayloadVerifier& verifier,
+        responseProviderFunc func);
+
+    static HttpResponse::Ptr on_error(const S3Status& status);
 };
 }  // namespace hestia
\ No newline at end of file
@@ -19,6 +19,25 @@ S3AuthorisationChecker::AuthResponse S3AuthorisationChecker::authorise(
             UserContext()};
     }
 
+    if (S3PayloadVerifier::is_unsupported_streaming_payload(http_request)) {
+        LOG_ERROR("Unsupported streaming payload type.");
+        return {
+            Status::FAILED,
+            {S3StatusCode::_404_NOT_IMPLEMENTED, s3_request},
+            UserContext()};
+    }
+    else if (
+        S3PayloadVerifier::is_streaming_payload(http_request)
+        && http_request.get_header()
+               .get_item("x-amz-decoded-content-length")
+               .empty()) {
+        LOG_ERROR("Streaming payload is missing its decoded length.");
+        return {
+            Status::FAILED,
+            {S3StatusCode::_411_MISSING_CONTENT_LENGTH, s3_request},
+            UserContext()};
+    }
+
     const auto& [user_status, user_context] =
         find_user(user_service, s3_request);
     if (!user_status.is_ok()) {
@@ -26,13 +45,24 @@ S3AuthorisationChecker::AuthResponse S3AuthorisationChecker::authorise(
         return {Status::FAILED, user_status, user_context};
     }
 
+    s3_request.set_user_secret_key(user_context.m_token);
+
     if (awaiting_signed_payload(http_request)) {
-        return {Status::WAITING_FOR_PAYLOAD, {}, user_context};
+        // The signature covers the declared payload hash rather than the
+        // payload, so it can be checked before the payload arrives.
+        const auto check_status = check(
+            s3_request, http_request,
+            http_request.get_header().get_item("x-amz-content-sha256"));
+        if (!check_status.is_ok()) {
+            return {Status::FAILED, check_status, user_context};
+        }
+        return {
+            Status::WAITING_FOR_PAYLOAD, {}, user_context,
+            S3PayloadVerifier::create(s3_request, http_request)};
     }
 
-    s3_request.set_user_secret_key(user_context.m_token);
-
-    const auto check_status = check(s3_request, http_request);
+    const auto check_status = check(
+        s3_request, http_request, HashUtils::do_sha256(http_request.body()));
     return {
         check_status.is_ok() ? Status::VALID : Status::FAILED, check_status,
         user_context};
@@ -73,6 +103,11 @@ S3AuthorisationChecker::find_user(
 
 bool S3AuthorisationChecker::awaiting_signed_payload(const HttpRequest& request)
 {
+    // The chunk framing has to be stripped even if the body is all here
+    if (S3PayloadVerifier::is_streaming_payload(request)) {
+        return true;
+    }
+
     if (!request.is_content_outstanding()) {
         return false;
     }
@@ -86,10 +121,12 @@ bool S3AuthorisationChecker::awaiting_signed_payload(const HttpRequest& request)
 }
 
 S3Status S3AuthorisationChecker::check(
-    const S3Request& s3_request, const HttpRequest& http_request)
+    const S3Request& s3_request,
+    const HttpRequest& http_request,
+    const std::string& payload_sha256)
 {
     const auto signature = s3_request.get_signature(
-        http_request, HashUtils::do_sha256(http_request.body()),
+        http_request, payload_sha256,
         s3_request.get_user_context().m_user_secret_key);
     if (s3_request.m_signature == signature) {
         return {};
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "HttpRequest.h"
+#include "S3PayloadVerifier.h"
 #include "S3Request.h"
 #include "S3Status.h"
 #include "UserService.h"
@@ -24,14 +25,27 @@ class S3AuthorisationChecker {
         Status m_status;
         S3Status m_s3_status;
         UserContext m_user;
+        S3PayloadVerifier::Ptr m_payload_verifier;
     };
 
+    /**
+     * Check the request signature. If the signed payload is still to arrive
+     * the signature is checked against the payload hash it declares and
+     * WAITING_FOR_PAYLOAD returned, with a verifier to check the payload
+     * against the declared hash as it streams in.
+     *
+     * @param user_service To look up the signing user
+     * @param request The request to check
+     * @return The result of the check
+     */
     static AuthResponse authorise(
         const UserService& user_service, const HttpRequest& request);
 
   private:
     static S3Status check(
-        const S3Request& s3_request, const HttpRequest& request);
+        const S3Request& s3_request,
+        const HttpRequest& request,
+        const std::string& payload_sha256);
 
     static std::pair<S3Status, UserContext> find_user(
         const UserService& user_service, S3Request& s3_request);
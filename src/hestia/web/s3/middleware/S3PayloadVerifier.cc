@@ -0,0 +1,300 @@
+#include "S3PayloadVerifier.h"
+
+#include "Logger.h"
+#include "StringUtils.h"
+
+#include <algorithm>
+
+namespace hestia {
+
+// Hex chunk size, the signature key and a 64 character signature fit easily
+static constexpr std::size_t max_chunk_header_length{256};
+
+static const std::string empty_payload_sha256 =
+    "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855";
+
+static const std::string chunk_signature_key{";chunk-signature="};
+
+S3PayloadVerifier::S3PayloadVerifier(
+    const S3Request& s3_request, const HttpRequest& http_request)
+{
+    const auto& header = http_request.get_header();
+    m_payload_sha256   = header.get_item("x-amz-content-sha256");
+    m_is_chunked       = is_streaming_payload(http_request);
+
+    // Unsigned payloads are only passed through, e.g. to take their MD5
+    m_checks_hash = !m_is_chunked && !m_payload_sha256.empty()
+                    && m_payload_sha256 != s_unsigned_payload;
+    if (!m_is_chunked) {
+        return;
+    }
+
+    m_decoded_length     = get_payload_length(http_request);
+    m_signing_key        = s3_request.get_signing_key(
+        s3_request.get_user_context().m_user_secret_key);
+    m_timestamp          = header.get_item("x-amz-date");
+    m_scope              = s3_request.get_scope();
+    m_previous_signature = s3_request.m_signature;
+}
+
+S3PayloadVerifier::Ptr S3PayloadVerifier::create(
+    const S3Request& s3_request, const HttpRequest& http_request)
+{
+    return std::make_unique<S3PayloadVerifier>(s3_request, http_request);
+}
+
+bool S3PayloadVerifier::is_streaming_payload(const HttpRequest& request)
+{
+    return request.get_header().get_item("x-amz-content-sha256")
+           == s_streaming_payload;
+}
+
+bool S3PayloadVerifier::is_unsupported_streaming_payload(
+    const HttpRequest& request)
+{
+    const auto payload_type =
+        request.get_header().get_item("x-amz-content-sha256");
+    return StringUtils::starts_with(payload_type, "STREAMING-")
+           && payload_type != s_streaming_payload;
+}
+
+std::size_t S3PayloadVerifier::get_payload_length(const HttpRequest& request)
+{
+    if (!is_streaming_payload(request)) {
+        return request.get_header().get_content_length_as_size_t();
+    }
+
+    try {
+        return std::stoull(
+            request.get_header().get_item("x-amz-decoded-content-length"));
+    }
+    catch (const std::exception&) {
+        return 0;
+    }
+}
+
+IOResult S3PayloadVerifier::write(
+    const ReadableBufferView& buffer, Stream* stream) noexcept
+{
+    if (m_is_chunked) {
+        return write_chunked(buffer, stream);
+    }
+
+    if (m_checks_hash) {
+        m_hasher.update(buffer.data(), buffer.length());
+    }
+    m_num_consumed += buffer.length();
+    return forward(buffer, stream);
+}
+
+IOResult S3PayloadVerifier::write(std::string& body) noexcept
+{
+    if (!m_is_chunked) {
+        if (m_checks_hash) {
+            m_hasher.update(body.data(), body.size());
+        }
+        if (m_md5_hasher) {
+            m_md5_hasher->update(body.data(), body.size());
+        }
+        m_num_consumed += body.size();
+        return {{}, body.size()};
+    }
+
+    const auto result = write_chunked(ReadableBufferView(body), nullptr);
+    if (result.ok()) {
+        body = std::move(m_buffered_output);
+    }
+    return result;
+}
+
+S3PayloadVerifier::Status S3PayloadVerifier::finish()
+{
+    if (m_status != Status::OK) {
+        return m_status;
+    }
+
+    if (m_is_chunked) {
+        if (m_chunk_state != ChunkState::DONE
+            || m_num_decoded != m_decoded_length) {
+            LOG_ERROR(
+                "Incomplete aws-chunked payload - decoded "
+                << m_num_decoded << " of " << m_decoded_length << " bytes.");
+            return Status::INCOMPLETE_BODY;
+        }
+    }
+    else if (const auto hash = m_hasher.finish();
+             m_checks_hash && hash != StringUtils::to_lower(m_payload_sha256)) {
+        LOG_ERROR(
+            "Payload hash does not match: " << m_payload_sha256 << " | "
+                                            << hash);
+        return Status::HASH_MISMATCH;
+    }
+    return Status::OK;
+}
+
+IOResult S3PayloadVerifier::write_chunked(
+    const ReadableBufferView& buffer, Stream* stream)
+{
+    std::size_t offset{0};
+    while (offset < buffer.length()) {
+        const auto remaining = buffer.length() - offset;
+        const auto data      = buffer.data() + offset;
+
+        if (m_chunk_state == ChunkState::HEADER) {
+            const auto line_end = std::find(data, data + remaining, '\n');
+            const std::size_t count =
+                line_end == data + remaining ? remaining
+                                             : (line_end - data) + 1;
+            m_chunk_line.append(data, count);
+            offset += count;
+
+            if (m_chunk_line.size() > max_chunk_header_length) {
+                on_malformed("Chunk header is too long.");
+            }
+            else if (m_chunk_line.back() == '\n' && !on_chunk_header()) {
+                on_malformed("Bad chunk header: " + m_chunk_line);
+            }
+        }
+        else if (m_chunk_state == ChunkState::DATA) {
+            const auto count = std::min(remaining, m_chunk_remaining);
+            const auto chunk = buffer.slice(offset, count);
+            m_hasher.update(chunk.data(), count);
+
+            const auto result = forward(chunk, stream);
+            if (!result.ok()) {
+                return result;
+            }
+            offset += count;
+            m_chunk_remaining -= count;
+            m_num_decoded += count;
+
+            if (m_chunk_remaining == 0) {
+                on_chunk_end();
+            }
+        }
+        else if (m_chunk_state == ChunkState::DATA_END) {
+            const auto count = std::min(remaining, 2 - m_chunk_line.size());
+            m_chunk_line.append(data, count);
+            offset += count;
+
+            if (m_chunk_line.size() == 2) {
+                if (m_chunk_line != "\r\n") {
+                    on_malformed("Chunk data is not followed by CRLF.");
+                }
+                else {
+                    m_chunk_line.clear();
+                    m_chunk_state = m_is_last_chunk ? ChunkState::DONE :
+                                                      ChunkState::HEADER;
+                }
+            }
+        }
+        else if (m_chunk_state == ChunkState::DONE) {
+            on_malformed("Data after the final chunk.");
+        }
+        else {
+            // Once the framing is lost the rest of the body is dropped, it
+            // is rejected at the end.
+            offset = buffer.length();
+        }
+    }
+    m_num_consumed += buffer.length();
+    return {{}, buffer.length()};
+}
+
+void S3PayloadVerifier::enable_md5()
+{
+    m_md5_hasher = std::make_unique<EvpHasher>(HashUtils::md5_digest());
+}
+
+const std::string& S3PayloadVerifier::get_md5()
+{
+    if (m_md5.empty() && m_md5_hasher) {
+        m_md5 = m_md5_hasher->finish();
+    }
+    return m_md5;
+}
+
+IOResult S3PayloadVerifier::forward(
+    const ReadableBufferView& buffer, Stream* stream)
+{
+    if (m_md5_hasher) {
+        m_md5_hasher->update(buffer.data(), buffer.length());
+    }
+    if (stream == nullptr) {
+        m_buffered_output.append(buffer.data(), buffer.length());
+        return {{}, buffer.length()};
+    }
+
+    const auto result = stream->write(buffer);
+    if (result.ok() && result.m_num_transferred != buffer.length()) {
+        return {
+            {StreamState::State::ERROR, "Stream did not take all chunk data."},
+            result.m_num_transferred};
+    }
+    return result;
+}
+
+bool S3PayloadVerifier::on_chunk_header()
+{
+    // <hex size>;chunk-signature=<signature>\r\n
+    const auto line_size = m_chunk_line.size();
+    if (line_size < 2 || m_chunk_line[line_size - 2] != '\r') {
+        return false;
+    }
+
+    const auto signature_pos = m_chunk_line.find(chunk_signature_key);
+    if (signature_pos == std::string::npos || signature_pos == 0
+        || signature_pos > 16) {
+        return false;
+    }
+
+    const auto size_str = m_chunk_line.substr(0, signature_pos);
+    if (size_str.find_first_not_of("0123456789abcdefABCDEF")
+        != std::string::npos) {
+        return false;
+    }
+
+    const auto signature_start = signature_pos + chunk_signature_key.size();
+    m_chunk_signature          = m_chunk_line.substr(
+        signature_start, line_size - 2 - signature_start);
+    m_chunk_remaining = StringUtils::to_int(size_str, true);
+    m_chunk_line.clear();
+
+    m_is_last_chunk = m_chunk_remaining == 0;
+    m_chunk_state   = ChunkState::DATA;
+    if (m_is_last_chunk) {
+        on_chunk_end();
+    }
+    return true;
+}
+
+void S3PayloadVerifier::on_chunk_end()
+{
+    const auto string_to_sign = "AWS4-HMAC-SHA256-PAYLOAD\n" + m_timestamp
+                                + '\n' + m_scope + '\n' + m_previous_signature
+                                + '\n' + empty_payload_sha256 + '\n'
+                                + m_hasher.finish();
+    if (HashUtils::do_h_mac_hex(m_signing_key, string_to_sign)
+        != m_chunk_signature) {
+        LOG_ERROR("Chunk signature does not match: " << m_chunk_signature);
+        on_error(Status::SIGNATURE_MISMATCH);
+    }
+    m_previous_signature = m_chunk_signature;
+    m_chunk_state        = ChunkState::DATA_END;
+}
+
+void S3PayloadVerifier::on_malformed(const std::string& message)
+{
+    LOG_ERROR("Malformed aws-chunked payload: " << message);
+    on_error(Status::MALFORMED_CHUNK);
+    m_chunk_state = ChunkState::FAILED;
+}
+
+void S3PayloadVerifier::on_error(Status status)
+{
+    if (m_status == Status::OK) {
+        m_status = status;
+    }
+}
+
+}  // namespace hestia
@@ -0,0 +1,149 @@
+#pragma once
+
+#include "HashUtils.h"
+#include "HttpRequest.h"
+#include "RequestInputFilter.h"
+#include "S3Request.h"
+
+// Reference:
+// https://docs.aws.amazon.com/AmazonS3/latest/API/sigv4-streaming.html
+
+namespace hestia {
+
+/**
+ * @brief Checks a signed S3 payload as it streams into the request Stream
+ *
+ * With a SHA256 in the 'x-amz-content-sha256' header the body is hashed
+ * chunk by chunk on its way to the stream and compared with the header once
+ * complete.
+ *
+ * With 'STREAMING-AWS4-HMAC-SHA256-PAYLOAD' the body is 'aws-chunked'
+ * encoded, each chunk carrying a signature chained from the request
+ * signature. The chunk framing is stripped so only the object data reaches
+ * the stream, and each chunk signature is checked once its data is in.
+ *
+ * With 'UNSIGNED-PAYLOAD', or no hash header, the body is passed through
+ * unchecked - which is still of use to get its MD5.
+ *
+ * The data is written on before it is verified, so whoever consumes the
+ * stream has to roll back if finish() doesn't return OK.
+ */
+class S3PayloadVerifier : public RequestInputFilter {
+  public:
+    using Ptr = std::unique_ptr<S3PayloadVerifier>;
+
+    enum class Status {
+        OK,
+        HASH_MISMATCH,
+        SIGNATURE_MISMATCH,
+        INCOMPLETE_BODY,
+        MALFORMED_CHUNK
+    };
+
+    /**
+     * Constructor
+     *
+     * @param s3_request The parsed request - with the user secret key set
+     * @param http_request The request with the payload to verify
+     */
+    S3PayloadVerifier(
+        const S3Request& s3_request, const HttpRequest& http_request);
+
+    static Ptr create(
+        const S3Request& s3_request, const HttpRequest& http_request);
+
+    /**
+     * True if the request has an aws-chunked payload with signed chunks
+     */
+    static bool is_streaming_payload(const HttpRequest& request);
+
+    /**
+     * True if the request has an aws-chunked payload of a type we don't
+     * handle - e.g. unsigned or with trailing checksums.
+     */
+    static bool is_unsupported_streaming_payload(const HttpRequest& request);
+
+    /**
+     * The length of the object data in the request - for aws-chunked payloads
+     * this is the decoded length rather than the length on the wire.
+     */
+    static std::size_t get_payload_length(const HttpRequest& request);
+
+    [[nodiscard]] IOResult write(
+        const ReadableBufferView& buffer, Stream* stream) noexcept override;
+
+    /**
+     * Verify a body which was buffered rather than streamed. An aws-chunked
+     * body is decoded in place.
+     *
+     * @param body The complete request body
+     * @return The state of the decode
+     */
+    [[nodiscard]] IOResult write(std::string& body) noexcept;
+
+    /**
+     * The verdict on the payload, once all of it has been written
+     *
+     * @return OK if the payload matches its signature
+     */
+    Status finish();
+
+    std::size_t get_num_consumed() const { return m_num_consumed; }
+
+    /**
+     * Also take the MD5 of the object data, e.g. for a part's ETag. This
+     * must be called before any data is written.
+     */
+    void enable_md5();
+
+    /**
+     * The MD5 of the object data, once all of it has been written
+     *
+     * @return The hex encoded MD5, or empty if it wasn't enabled
+     */
+    const std::string& get_md5();
+
+  private:
+    enum class ChunkState { HEADER, DATA, DATA_END, DONE, FAILED };
+
+    IOResult write_chunked(const ReadableBufferView& buffer, Stream* stream);
+
+    IOResult forward(const ReadableBufferView& buffer, Stream* stream);
+
+    bool on_chunk_header();
+
+    void on_chunk_end();
+
+    void on_malformed(const std::string& message);
+
+    void on_error(Status status);
+
+    static constexpr const char s_streaming_payload[]{
+        "STREAMING-AWS4-HMAC-SHA256-PAYLOAD"};
+
+    static constexpr const char s_unsigned_payload[]{"UNSIGNED-PAYLOAD"};
+
+    bool m_is_chunked{false};
+    bool m_checks_hash{false};
+    std::string m_payload_sha256;
+    std::size_t m_decoded_length{0};
+    std::size_t m_num_decoded{0};
+    std::size_t m_num_consumed{0};
+    Status m_status{Status::OK};
+    EvpHasher m_hasher{HashUtils::sha256_digest()};
+    std::unique_ptr<EvpHasher> m_md5_hasher;
+    std::string m_md5;
+
+    // aws-chunked state
+    ChunkState m_chunk_state{ChunkState::HEADER};
+    std::string m_chunk_line;
+    std::size_t m_chunk_remaining{0};
+    bool m_is_last_chunk{false};
+    std::string m_chunk_signature;
+    std::string m_previous_signature;
+    std::string m_signing_key;
+    std::string m_timestamp;
+    std::string m_scope;
+    std::string m_buffered_output;
+};
+}  // namespace hestia
@@ -12,14 +12,17 @@
 
 #include "Logger.h"
 
+#include <algorithm>
 #include <iostream>
 #include <sstream>
 
 namespace hestia {
-S3BucketView::S3BucketView(DistributedHsmService* service) :
+S3BucketView::S3BucketView(
+    DistributedHsmService* service, S3MultipartUploads* uploads) :
     S3WebView(service),
     m_dataset_adapter(std::make_unique<S3DatasetAdapter>()),
-    m_object_adapter(std::make_unique<S3HsmObjectAdapter>())
+    m_object_adapter(std::make_unique<S3HsmObjectAdapter>()),
+    m_uploads(uploads)
 {
     LOG_INFO("Loaded S3BucketView");
 }
@@ -38,17 +41,67 @@ HttpResponse::Ptr S3BucketView::on_get(
         return std::move(status);
     }
 
+    if (request.get_queries().has_item("uploads")) {
+        return on_list_multipart_uploads(
+            list_object_request.m_s3_request, request);
+    }
+
     auto response = HttpResponse::create();
     auto dataset  = get_bucket_response->get_item_as<Dataset>();
 
     S3ListObjectsResponse s3_list_objects_response;
     m_object_adapter->on_list_objects(*dataset, s3_list_objects_response);
+
+    // Multipart upload staging objects aren't visible until completed
+    auto& contents = s3_list_objects_response.m_contents;
+    contents.erase(
+        std::remove_if(
+            contents.begin(), contents.end(),
+            [](const S3Object& object) {
+                return S3MultipartUploads::is_staging_name(object.m_key);
+            }),
+        contents.end());
+    s3_list_objects_response.m_key_count = contents.size();
+
     response->body() = s3_list_objects_response.to_string();
 
     S3ViewUtils::set_common_headers(*response);
     return response;
 }
 
+HttpResponse::Ptr S3BucketView::on_list_multipart_uploads(
+    const S3Request& s3_request, const HttpRequest& request)
+{
+    S3ListMultipartUploadsResponse s3_response;
+    s3_response.m_bucket      = s3_request.get_bucket_name();
+    s3_response.m_max_uploads = 1000;
+    if (const auto max_uploads = request.get_queries().get_item("max-uploads");
+        !max_uploads.empty()) {
+        try {
+            s3_response.m_max_uploads = std::stoull(max_uploads);
+        }
+        catch (const std::exception&) {
+            return S3ViewUtils::on_error(
+                s3_request, S3StatusCode::_400_INVALID_ARGUMENT,
+                "Invalid max-uploads: " + max_uploads);
+        }
+    }
+
+    for (const auto& upload : m_uploads->list(s3_response.m_bucket)) {
+        if (s3_response.m_uploads.size() == s3_response.m_max_uploads) {
+            s3_response.m_is_truncated = true;
+            break;
+        }
+        s3_response.m_uploads.push_back(
+            {upload.m_key, upload.m_id, upload.m_initiated});
+    }
+
+    auto response = HttpResponse::create();
+    response->set_body(s3_response.to_string());
+    S3ViewUtils::set_common_headers(*response);
+    return response;
+}
+
 HttpResponse::Ptr S3BucketView::on_head(
     const HttpRequest& request, HttpEvent, const AuthorizationContext& auth)
 {
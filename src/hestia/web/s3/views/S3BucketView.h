@@ -2,6 +2,7 @@
 
 #include "S3DatasetAdapter.h"
 #include "S3HsmObjectAdapter.h"
+#include "S3MultipartUploads.h"
 #include "S3WebView.h"
 
 namespace hestia {
@@ -9,7 +10,8 @@ class DistributedHsmService;
 
 class S3BucketView : public S3WebView {
   public:
-    S3BucketView(DistributedHsmService* service);
+    S3BucketView(
+        DistributedHsmService* service, S3MultipartUploads* uploads);
 
     HttpResponse::Ptr on_get(
         const HttpRequest& request,
@@ -32,7 +34,11 @@ class S3BucketView : public S3WebView {
         const AuthorizationContext&) override;
 
   private:
+    HttpResponse::Ptr on_list_multipart_uploads(
+        const S3Request& s3_request, const HttpRequest& request);
+
     std::unique_ptr<S3DatasetAdapter> m_dataset_adapter;
     std::unique_ptr<S3HsmObjectAdapter> m_object_adapter;
+    S3MultipartUploads* m_uploads{nullptr};
 };
 }  // namespace hestia
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include "DistributedHsmService.h"
 #include "S3HsmObjectAdapter.h"
 #include "S3Path.h"
+#include "S3PayloadVerifier.h"
 #include "S3ViewUtils.h"
 
 #include "Dataset.h"
@@ -12,13 +13,50 @@
 #include "HsmService.h"
 #include "RequestContext.h"
 
+#include "HashUtils.h"
 #include "Logger.h"
 
 #include <sstream>
+#include <stdexcept>
 
 namespace hestia {
-S3ObjectView::S3ObjectView(DistributedHsmService* service) :
-    S3WebView(service), m_object_adatper(std::make_unique<S3HsmObjectAdapter>())
+
+static std::size_t get_size_query(
+    const Map& queries, const std::string& key, std::size_t default_value)
+{
+    if (!queries.has_item(key)) {
+        return default_value;
+    }
+    try {
+        return std::stoull(queries.get_item(key));
+    }
+    catch (const std::exception&) {
+        return default_value;
+    }
+}
+
+static std::string strip_quotes(const std::string& etag)
+{
+    if (etag.size() >= 2 && etag.front() == '"' && etag.back() == '"') {
+        return etag.substr(1, etag.size() - 2);
+    }
+    return etag;
+}
+
+static std::string hex_to_bytes(const std::string& hex)
+{
+    std::string bytes;
+    for (std::size_t idx = 0; idx + 1 < hex.size(); idx += 2) {
+        bytes += static_cast<char>(std::stoi(hex.substr(idx, 2), nullptr, 16));
+    }
+    return bytes;
+}
+
+S3ObjectView::S3ObjectView(
+    DistributedHsmService* service, S3MultipartUploads* uploads) :
+    S3WebView(service),
+    m_object_adatper(std::make_unique<S3HsmObjectAdapter>()),
+    m_uploads(uploads)
 {
     LOG_INFO("Loaded object view");
 }
@@ -31,6 +69,9 @@ HttpResponse::Ptr S3ObjectView::on_get(
     if (event != HttpEvent::HEADERS) {
         return HttpResponse::create();
     }
+    if (request.get_queries().has_item("uploadId")) {
+        return on_list_parts(S3Request(request), request, auth);
+    }
     return on_get_or_head(request, event, auth, true);
 }
 
@@ -176,29 +217,18 @@ HttpResponse::Ptr S3ObjectView::on_put_object(
     const HttpRequest& request,
     const AuthorizationContext& auth)
 {
-    auto [object_status, object_get_response] =
-        on_get_object(s3_request, auth, false);
-    if (object_status->error()) {
-        return std::move(object_status);
-    }
-
-    if (object_get_response->found()) {
-        auto remove_response = on_delete_object(
-            s3_request, auth,
-            object_get_response->get_item()->get_primary_key());
-        if (remove_response->error()) {
-            return remove_response;
-        }
-    }
-
     auto [status, get_bucket_response] = on_get_bucket(s3_request, auth);
     if (status->error()) {
         return std::move(status);
     }
 
-    CrudIdentifier object_id;
-    object_id.set_name(s3_request.get_object_key());
-    object_id.set_parent_primary_key(
+    // The data is written into a hidden staging object, which only replaces
+    // any object at the key once the payload is accepted - so a rejected
+    // payload leaves the existing object as it was.
+    CrudIdentifier staging_id;
+    staging_id.set_name(S3MultipartUploads::get_staging_name(
+        S3MultipartUploads::generate_id()));
+    staging_id.set_parent_primary_key(
         get_bucket_response->get_item()->get_primary_key());
 
     Map attributes =
@@ -207,7 +237,7 @@ HttpResponse::Ptr S3ObjectView::on_put_object(
         CrudRequest{
             CrudMethod::CREATE,
             {auth.m_user_id, auth.m_user_token},
-            {object_id},
+            {staging_id},
             {attributes},
             CrudQuery::OutputFormat::ITEM},
         HsmItem::hsm_object_name);
@@ -216,55 +246,173 @@ HttpResponse::Ptr S3ObjectView::on_put_object(
         LOG_ERROR(msg);
         return S3ViewUtils::on_server_error(s3_request, msg);
     }
+    const auto object_id = create_response->get_item()->get_primary_key();
 
-    if (const auto content_length =
-            request.get_header().get_content_length_as_size_t();
-        content_length > 0) {
-        return on_put_data(
-            request, auth, create_response->get_item()->get_primary_key(),
-            content_length);
+    const auto content_length = S3PayloadVerifier::get_payload_length(request);
+    if (content_length == 0) {
+        return on_replace_object(s3_request, auth, object_id);
     }
-    else {
-        return HttpResponse::create();
+
+    auto context = request.get_context();
+    auto written = std::make_shared<bool>(false);
+    context->set_input_rollback_handler(
+        [this, s3_request, auth, object_id]() {
+            (void)on_delete_object(s3_request, auth, object_id);
+        });
+    context->set_input_commit_handler(
+        [this, s3_request, auth, object_id, written]() {
+            if (!*written) {
+                (void)on_delete_object(s3_request, auth, object_id);
+                return S3ViewUtils::on_server_error(
+                    s3_request, "Failed to write object data.");
+            }
+            return on_replace_object(s3_request, auth, object_id);
+        });
+
+    auto response = on_put_data(
+        request, auth, object_id, content_length, 0,
+        [written]() { *written = true; });
+    if (response->code() == 307) {
+        // The data goes to another node, which stages it itself
+        context->set_input_rollback_handler({});
+        context->set_input_commit_handler({});
+        (void)on_delete_object(s3_request, auth, object_id);
+    }
+    return response;
+}
+
+HttpResponse::Ptr S3ObjectView::on_replace_object(
+    const S3Request& s3_request,
+    const AuthorizationContext& auth,
+    const std::string& staging_id) const
+{
+    const CrudUserContext user_context{auth.m_user_id, auth.m_user_token};
+
+    auto get_response = m_service->make_request(
+        CrudRequest{
+            CrudQuery{staging_id, CrudQuery::OutputFormat::ITEM},
+            user_context},
+        HsmItem::hsm_object_name);
+    if (!get_response->ok() || !get_response->found()) {
+        const auto msg = get_response->ok() ?
+                             "Missing staging object " + staging_id :
+                             get_response->get_error().to_string();
+        LOG_ERROR(msg);
+        return S3ViewUtils::on_server_error(s3_request, msg);
+    }
+    auto object = *get_response->get_item_as<HsmObject>();
+    return on_replace_object(
+        s3_request, auth, object, s3_request.get_object_key(),
+        s3_request.get_bucket_name());
+}
+
+HttpResponse::Ptr S3ObjectView::on_replace_object(
+    const S3Request& s3_request,
+    const AuthorizationContext& auth,
+    HsmObject& object,
+    const std::string& key,
+    const std::string& bucket_name) const
+{
+    auto [object_status, object_get_response] =
+        on_get_object(s3_request, auth, false, key, bucket_name);
+    if (object_status->error()) {
+        return std::move(object_status);
+    }
+
+    // Any existing object is moved aside rather than deleted first, so it can
+    // be put back if the new object can't take its key.
+    std::unique_ptr<HsmObject> existing;
+    if (object_get_response->found()) {
+        existing = std::make_unique<HsmObject>(
+            *object_get_response->get_item_as<HsmObject>());
+        existing->set_name(S3MultipartUploads::get_staging_name(
+            S3MultipartUploads::generate_id()));
+        if (auto response = on_rename_object(s3_request, auth, *existing);
+            response->error()) {
+            return response;
+        }
+    }
+
+    object.set_name(key);
+    if (auto response = on_rename_object(s3_request, auth, object);
+        response->error()) {
+        if (existing) {
+            existing->set_name(key);
+            (void)on_rename_object(s3_request, auth, *existing);
+        }
+        return response;
+    }
+
+    if (existing) {
+        // The key is already replaced, so failing to clean up only leaves a
+        // hidden staging object behind.
+        (void)on_delete_object(s3_request, auth, existing->get_primary_key());
     }
+    return HttpResponse::create();
+}
+
+HttpResponse::Ptr S3ObjectView::on_rename_object(
+    const S3Request& s3_request,
+    const AuthorizationContext& auth,
+    const HsmObject& object) const
+{
+    auto update_response = m_service->make_request(
+        TypedCrudRequest<HsmObject>(
+            CrudMethod::UPDATE, object, {auth.m_user_id, auth.m_user_token}),
+        HsmItem::hsm_object_name);
+    if (!update_response->ok()) {
+        const auto msg = update_response->get_error().to_string();
+        LOG_ERROR(msg);
+        return S3ViewUtils::on_server_error(s3_request, msg);
+    }
+    return HttpResponse::create();
 }
 
 HttpResponse::Ptr S3ObjectView::on_put_data(
     const HttpRequest& request,
     const AuthorizationContext& auth,
     const std::string& object_id,
-    std::size_t content_length)
+    std::size_t content_length,
+    std::size_t offset,
+    std::function<void()> on_complete)
 {
     auto response = HttpResponse::create();
 
     HsmAction action(HsmItem::Type::OBJECT, HsmAction::Action::PUT_DATA);
     action.set_subject_key(object_id);
+    action.set_offset(offset);
     action.set_size(content_length);
     std::string redirect_location;
 
-    auto completion_cb =
-        [&response, &redirect_location](HsmActionResponse::Ptr response_ret) {
-            if (response_ret->ok()) {
-                LOG_INFO("Data action completed sucessfully");
-                if (!response_ret->get_redirect_location().empty()) {
-                    redirect_location = response_ret->get_redirect_location();
-                }
+    auto completion_cb = [&response, &redirect_location, on_complete, this](
+                             HsmActionResponse::Ptr response_ret) {
+        if (response_ret->ok()) {
+            LOG_INFO("Data action completed sucessfully");
+            if (!response_ret->get_redirect_location().empty()) {
+                redirect_location = response_ret->get_redirect_location()
+                                    + m_path
+                                    + response_ret->get_redirect_query();
             }
-            else {
-                LOG_ERROR(
-                    "Error in data action \n"
-                    << response_ret->get_error().to_string());
-                response = HttpResponse::create(500, "Internal Server Error.");
+            else if (on_complete) {
+                on_complete();
             }
-        };
+        }
+        else {
+            LOG_ERROR(
+                "Error in data action \n"
+                << response_ret->get_error().to_string());
+            response = HttpResponse::create(500, "Internal Server Error.");
+        }
+    };
+    HsmActionRequest action_request(
+        action, {auth.m_user_id, auth.m_user_token});
+    action_request.set_placed_tier(request.get_queries());
     m_service->do_data_io_action(
-        HsmActionRequest(action, {auth.m_user_id, auth.m_user_token}),
-        request.get_context()->get_stream(), completion_cb);
+        action_request, request.get_context()->get_stream(), completion_cb);
 
     if (!redirect_location.empty()) {
         response = HttpResponse::create(307, "Found");
-        response->header().set_item(
-            "Location", "http://" + redirect_location + m_path);
+        response->header().set_item("Location", "http://" + redirect_location);
     }
     else {
         response->set_completion_status(
@@ -279,6 +427,21 @@ HttpResponse::Ptr S3ObjectView::on_put(
     HttpEvent event,
     const AuthorizationContext& auth)
 {
+    const auto& queries = request.get_queries();
+    if (queries.has_item("uploadId") && queries.has_item("partNumber")) {
+        if (event == HttpEvent::BODY) {
+            return HttpResponse::create();
+        }
+        return on_upload_part(S3Request(request), request, auth, event);
+    }
+
+    // The payload was accepted, so a staged object can take its key
+    if (event == HttpEvent::EOM) {
+        if (auto response = request.get_context()->commit_input()) {
+            return response;
+        }
+    }
+
     if (event != HttpEvent::HEADERS) {
         // This says 'just continue streaming' to the webserver
         return HttpResponse::create();
@@ -345,6 +508,9 @@ HttpResponse::Ptr S3ObjectView::on_delete(
     LOG_INFO("S3ObjectView:on_delete");
 
     S3Request s3_request(request);
+    if (request.get_queries().has_item("uploadId")) {
+        return on_abort_multipart_upload(s3_request, request, auth);
+    }
 
     auto [status, object_get_response] = on_get_object(s3_request, auth);
     if (status->error()) {
@@ -377,4 +543,409 @@ HttpResponse::Ptr S3ObjectView::on_delete_object(
     }
     return HttpResponse::create();
 }
+
+HttpResponse::Ptr S3ObjectView::on_post(
+    const HttpRequest& request,
+    HttpEvent event,
+    const AuthorizationContext& auth)
+{
+    const auto& queries = request.get_queries();
+    if (!queries.has_item("uploads") && !queries.has_item("uploadId")) {
+        return on_not_supported(request);
+    }
+
+    // Wait for the full body - the part list on completing an upload
+    if (event == HttpEvent::HEADERS) {
+        return HttpResponse::create(
+            HttpResponse::CompletionStatus::AWAITING_EOM);
+    }
+    if (event != HttpEvent::EOM) {
+        return HttpResponse::create();
+    }
+
+    S3Request s3_request(request);
+    if (queries.has_item("uploads")) {
+        return on_create_multipart_upload(s3_request, request, auth);
+    }
+    return on_complete_multipart_upload(s3_request, request, auth);
+}
+
+HttpResponse::Ptr S3ObjectView::on_create_multipart_upload(
+    const S3Request& s3_request,
+    const HttpRequest& request,
+    const AuthorizationContext& auth)
+{
+    auto [status, get_bucket_response] = on_get_bucket(s3_request, auth);
+    if (status->error()) {
+        return std::move(status);
+    }
+
+    S3MultipartUploads::Upload upload;
+    upload.m_id      = S3MultipartUploads::generate_id();
+    upload.m_bucket  = s3_request.get_bucket_name();
+    upload.m_key     = s3_request.get_object_key();
+    upload.m_user_id = auth.m_user_id;
+
+    // The parts are written into a staging object, which takes the key's
+    // name when the upload completes.
+    CrudIdentifier object_id;
+    object_id.set_name(S3MultipartUploads::get_staging_name(upload.m_id));
+    object_id.set_parent_primary_key(
+        get_bucket_response->get_item()->get_primary_key());
+
+    Map attributes =
+        request.get_header().get_items_with_prefix(S3Path::meta_prefix);
+    auto create_response = m_service->make_request(
+        CrudRequest{
+            CrudMethod::CREATE,
+            {auth.m_user_id, auth.m_user_token},
+            {object_id},
+            {attributes},
+            CrudQuery::OutputFormat::ITEM},
+        HsmItem::hsm_object_name);
+    if (!create_response->ok()) {
+        const auto msg = create_response->get_error().to_string();
+        LOG_ERROR(msg);
+        return S3ViewUtils::on_server_error(s3_request, msg);
+    }
+    upload.m_object_id = create_response->get_item()->get_primary_key();
+    m_uploads->add(upload);
+
+    LOG_INFO(
+        "Created multipart upload " << upload.m_id << " for "
+                                    << upload.m_bucket << "/" << upload.m_key);
+
+    S3CreateMultipartUploadResponse s3_response;
+    s3_response.m_bucket    = upload.m_bucket;
+    s3_response.m_key       = upload.m_key;
+    s3_response.m_upload_id = upload.m_id;
+
+    auto response = HttpResponse::create();
+    response->set_body(s3_response.to_string());
+    S3ViewUtils::set_common_headers(*response);
+    return response;
+}
+
+HttpResponse::Ptr S3ObjectView::on_upload_part(
+    const S3Request& s3_request,
+    const HttpRequest& request,
+    const AuthorizationContext& auth,
+    HttpEvent event)
+{
+    auto [status, upload] = on_get_upload(s3_request, request, auth);
+    if (status->error()) {
+        return std::move(status);
+    }
+
+    const auto part_number =
+        get_size_query(request.get_queries(), "partNumber", 0);
+    if (part_number < 1 || part_number > 10000) {
+        return S3ViewUtils::on_error(
+            s3_request, S3StatusCode::_400_INVALID_ARGUMENT,
+            "Part number must be an integer between 1 and 10000.");
+    }
+
+    if (event == HttpEvent::EOM) {
+        const auto iter = upload.m_parts.find(part_number);
+        if (iter == upload.m_parts.end()) {
+            return S3ViewUtils::on_server_error(
+                s3_request, "Failed to write part "
+                                + std::to_string(part_number) + " of upload "
+                                + upload.m_id);
+        }
+        auto response = HttpResponse::create();
+        response->header().set_item("ETag", iter->second.m_etag);
+        return response;
+    }
+
+    S3Part part;
+    part.m_number = part_number;
+    part.m_size   = S3PayloadVerifier::get_payload_length(request);
+
+    std::size_t offset{0};
+    const auto start_status =
+        m_uploads->start_part(upload.m_id, part_number, part.m_size, offset);
+    if (start_status == S3MultipartUploads::Status::NO_SUCH_UPLOAD) {
+        return S3ViewUtils::on_error(
+            s3_request, S3StatusCode::_404_NO_SUCH_UPLOAD);
+    }
+    else if (start_status == S3MultipartUploads::Status::INVALID_PART) {
+        return S3ViewUtils::on_error(
+            s3_request, S3StatusCode::_400_INVALID_PART,
+            "Parts other than the last must be the same size.");
+    }
+    else if (start_status == S3MultipartUploads::Status::AWAITING_FIRST_PART) {
+        return S3ViewUtils::on_error(
+            s3_request, S3StatusCode::_503_SLOW_DOWN,
+            "Part 1 must be started before the other parts.");
+    }
+
+    if (part.m_size == 0) {
+        EvpHasher hasher(HashUtils::md5_digest());
+        part.m_etag = "\"" + hasher.finish() + "\"";
+        m_uploads->add_part(upload.m_id, part);
+        auto response = HttpResponse::create();
+        response->header().set_item("ETag", part.m_etag);
+        return response;
+    }
+
+    // The part's ETag is the MD5 of its data, taken as it streams in. Signed
+    // payloads already pass through a verifier - others get one just for this.
+    auto context = request.get_context();
+    auto verifier =
+        dynamic_cast<S3PayloadVerifier*>(context->get_input_filter());
+    if (verifier == nullptr) {
+        auto new_verifier = S3PayloadVerifier::create(s3_request, request);
+        verifier          = new_verifier.get();
+        context->set_input_filter(std::move(new_verifier));
+    }
+    verifier->enable_md5();
+
+    // The part is recorded once its data is written, so incomplete parts
+    // can't be used to complete the upload. The rollback has to see the
+    // ETag set on completion to tell this upload of the part from others.
+    auto written_part = std::make_shared<S3Part>(part);
+    auto on_complete  = [uploads = m_uploads, id = upload.m_id, written_part,
+                        verifier]() {
+        written_part->m_etag = "\"" + verifier->get_md5() + "\"";
+        uploads->add_part(id, *written_part);
+    };
+    context->set_input_rollback_handler(
+        [uploads = m_uploads, id = upload.m_id, written_part]() {
+            uploads->remove_part(id, *written_part);
+        });
+    return on_put_data(
+        request, auth, upload.m_object_id, part.m_size, offset, on_complete);
+}
+
+HttpResponse::Ptr S3ObjectView::on_complete_multipart_upload(
+    const S3Request& s3_request,
+    const HttpRequest& request,
+    const AuthorizationContext& auth)
+{
+    auto [status, upload] = on_get_upload(s3_request, request, auth);
+    if (status->error()) {
+        return std::move(status);
+    }
+
+    S3CompleteMultipartUploadRequest complete_request;
+    try {
+        complete_request.deserialize(request.body());
+    }
+    catch (const std::exception& e) {
+        LOG_ERROR(e.what());
+        return S3ViewUtils::on_error(
+            s3_request, S3StatusCode::_400_MALFORMED_XML);
+    }
+    if (complete_request.m_parts.empty()) {
+        return S3ViewUtils::on_error(
+            s3_request, S3StatusCode::_400_MALFORMED_XML,
+            "At least one part must be specified.");
+    }
+
+    // The listed parts must be in order and sit back to back in the staging
+    // object - so only the last part can be short.
+    std::size_t size{0};
+    std::size_t last_number{0};
+    EvpHasher etags_hasher(HashUtils::md5_digest());
+    for (const auto& listed_part : complete_request.m_parts) {
+        if (listed_part.m_number <= last_number) {
+            return S3ViewUtils::on_error(
+                s3_request, S3StatusCode::_400_INVALID_PART_ORDER);
+        }
+        last_number = listed_part.m_number;
+
+        const auto iter = upload.m_parts.find(listed_part.m_number);
+        if (iter == upload.m_parts.end()
+            || strip_quotes(iter->second.m_etag)
+                   != strip_quotes(listed_part.m_etag)) {
+            return S3ViewUtils::on_error(
+                s3_request, S3StatusCode::_400_INVALID_PART,
+                "Part " + std::to_string(listed_part.m_number)
+                    + " was not found or its ETag doesn't match.");
+        }
+        if ((listed_part.m_number - 1) * upload.m_part_stride != size) {
+            return S3ViewUtils::on_error(
+                s3_request, S3StatusCode::_400_INVALID_PART,
+                "Parts must be contiguous and all but the last the same "
+                "size.");
+        }
+        size += iter->second.m_size;
+        const auto part_md5 = hex_to_bytes(strip_quotes(iter->second.m_etag));
+        etags_hasher.update(part_md5.data(), part_md5.size());
+    }
+
+    if (auto stitch_response =
+            on_stitch_upload(s3_request, auth, upload, size);
+        stitch_response->error()) {
+        return stitch_response;
+    }
+    m_uploads->remove(upload.m_id);
+
+    S3CompleteMultipartUploadResponse s3_response;
+    s3_response.m_location = "/" + upload.m_bucket + "/" + upload.m_key;
+    s3_response.m_bucket   = upload.m_bucket;
+    s3_response.m_key      = upload.m_key;
+    s3_response.m_etag     = "\"" + etags_hasher.finish() + "-"
+                         + std::to_string(complete_request.m_parts.size())
+                         + "\"";
+
+    auto response = HttpResponse::create();
+    response->set_body(s3_response.to_string());
+    S3ViewUtils::set_common_headers(*response);
+    return response;
+}
+
+HttpResponse::Ptr S3ObjectView::on_stitch_upload(
+    const S3Request& s3_request,
+    const AuthorizationContext& auth,
+    const S3MultipartUploads::Upload& upload,
+    std::size_t size) const
+{
+    const CrudUserContext user_context{auth.m_user_id, auth.m_user_token};
+
+    auto get_response = m_service->make_request(
+        CrudRequest{
+            CrudQuery{upload.m_object_id, CrudQuery::OutputFormat::ITEM},
+            user_context},
+        HsmItem::hsm_object_name);
+    if (!get_response->ok() || !get_response->found()) {
+        const auto msg =
+            get_response->ok() ?
+                "Missing staging object for upload " + upload.m_id :
+                get_response->get_error().to_string();
+        LOG_ERROR(msg);
+        return S3ViewUtils::on_server_error(s3_request, msg);
+    }
+    auto object = *get_response->get_item_as<HsmObject>();
+
+    // The parts were written as extents of the staging object, so its data is
+    // already in place - replace the per-part extents with a single one
+    // covering the object. Parts written in parallel can each have created
+    // a record for the tier, so only the first is kept.
+    if (size > 0) {
+        if (object.tiers().empty()) {
+            const auto msg = "No data found for upload " + upload.m_id;
+            LOG_ERROR(msg);
+            return S3ViewUtils::on_server_error(s3_request, msg);
+        }
+
+        auto tier_extents = object.tiers()[0];
+        for (const auto& other : object.tiers()) {
+            if (other.get_tier_id() != tier_extents.get_tier_id()) {
+                const auto msg =
+                    "Parts of upload " + upload.m_id + " span storage tiers";
+                LOG_ERROR(msg);
+                return S3ViewUtils::on_server_error(s3_request, msg);
+            }
+        }
+        tier_extents.set_extent({0, size});
+
+        auto extent_response = m_service->make_request(
+            TypedCrudRequest<TierExtents>(
+                CrudMethod::UPDATE, tier_extents, user_context),
+            HsmItem::tier_extents_name);
+        if (!extent_response->ok()) {
+            const auto msg = extent_response->get_error().to_string();
+            LOG_ERROR(msg);
+            return S3ViewUtils::on_server_error(s3_request, msg);
+        }
+
+        for (std::size_t idx = 1; idx < object.tiers().size(); idx++) {
+            auto remove_response = m_service->make_request(
+                CrudRequest{
+                    CrudMethod::REMOVE,
+                    user_context,
+                    {object.tiers()[idx].get_primary_key()}},
+                HsmItem::tier_extents_name);
+            if (!remove_response->ok()) {
+                const auto msg = remove_response->get_error().to_string();
+                LOG_ERROR(msg);
+                return S3ViewUtils::on_server_error(s3_request, msg);
+            }
+        }
+    }
+
+    // Completing an upload replaces any object already at the key
+    object.set_size(size);
+    return on_replace_object(
+        s3_request, auth, object, upload.m_key, upload.m_bucket);
+}
+
+HttpResponse::Ptr S3ObjectView::on_abort_multipart_upload(
+    const S3Request& s3_request,
+    const HttpRequest& request,
+    const AuthorizationContext& auth)
+{
+    auto [status, upload] = on_get_upload(s3_request, request, auth);
+    if (status->error()) {
+        return std::move(status);
+    }
+
+    auto remove_response =
+        on_delete_object(s3_request, auth, upload.m_object_id);
+    if (remove_response->error()) {
+        return remove_response;
+    }
+    m_uploads->remove(upload.m_id);
+    return HttpResponse::create(HttpStatus::Code::_204_NO_CONTENT);
+}
+
+HttpResponse::Ptr S3ObjectView::on_list_parts(
+    const S3Request& s3_request,
+    const HttpRequest& request,
+    const AuthorizationContext& auth)
+{
+    auto [status, upload] = on_get_upload(s3_request, request, auth);
+    if (status->error()) {
+        return std::move(status);
+    }
+
+    const auto& queries = request.get_queries();
+
+    S3ListPartsResponse s3_response;
+    s3_response.m_bucket    = upload.m_bucket;
+    s3_response.m_key       = upload.m_key;
+    s3_response.m_upload_id = upload.m_id;
+    s3_response.m_max_parts = get_size_query(queries, "max-parts", 1000);
+    s3_response.m_part_number_marker =
+        get_size_query(queries, "part-number-marker", 0);
+
+    for (auto iter = upload.m_parts.upper_bound(
+             s3_response.m_part_number_marker);
+         iter != upload.m_parts.end(); iter++) {
+        if (s3_response.m_parts.size() == s3_response.m_max_parts) {
+            s3_response.m_is_truncated = true;
+            break;
+        }
+        s3_response.m_parts.push_back(iter->second);
+        s3_response.m_next_part_number_marker = iter->first;
+    }
+
+    auto response = HttpResponse::create();
+    response->set_body(s3_response.to_string());
+    S3ViewUtils::set_common_headers(*response);
+    return response;
+}
+
+std::pair<HttpResponse::Ptr, S3MultipartUploads::Upload>
+S3ObjectView::on_get_upload(
+    const S3Request& s3_request,
+    const HttpRequest& request,
+    const AuthorizationContext& auth) const
+{
+    S3MultipartUploads::Upload upload;
+    const auto status =
+        m_uploads->get(request.get_queries().get_item("uploadId"), upload);
+    if (status != S3MultipartUploads::Status::OK
+        || upload.m_bucket != s3_request.get_bucket_name()
+        || upload.m_key != s3_request.get_object_key()
+        || upload.m_user_id != auth.m_user_id) {
+        return {
+            S3ViewUtils::on_error(
+                s3_request, S3StatusCode::_404_NO_SUCH_UPLOAD),
+            S3MultipartUploads::Upload()};
+    }
+    return {HttpResponse::create(), upload};
+}
 }  // namespace hestia
\ No newline at end of file
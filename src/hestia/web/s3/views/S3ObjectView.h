@@ -1,11 +1,15 @@
 #pragma once
 
 #include "S3HsmObjectAdapter.h"
+#include "S3MultipartUploads.h"
 #include "S3WebView.h"
 
+#include <functional>
+
 namespace hestia {
 
 class DistributedHsmService;
+class HsmObject;
 class CrudResponse;
 using CrudResponsePtr = std::unique_ptr<CrudResponse>;
 
@@ -16,7 +20,8 @@ class S3ObjectView : public S3WebView {
         std::size_t m_size{0};
     };
 
-    S3ObjectView(DistributedHsmService* service);
+    S3ObjectView(
+        DistributedHsmService* service, S3MultipartUploads* uploads);
 
     HttpResponse::Ptr on_get(
         const HttpRequest& request,
@@ -28,6 +33,11 @@ class S3ObjectView : public S3WebView {
         HttpEvent,
         const AuthorizationContext& auth) override;
 
+    HttpResponse::Ptr on_post(
+        const HttpRequest& request,
+        HttpEvent,
+        const AuthorizationContext& auth) override;
+
     HttpResponse::Ptr on_delete(
         const HttpRequest& request,
         HttpEvent,
@@ -66,7 +76,71 @@ class S3ObjectView : public S3WebView {
         const HttpRequest& request,
         const AuthorizationContext& auth,
         const std::string& object_id,
-        std::size_t content_length);
+        std::size_t content_length,
+        std::size_t offset                = 0,
+        std::function<void()> on_complete = {});
+
+    HttpResponse::Ptr on_create_multipart_upload(
+        const S3Request& s3_request,
+        const HttpRequest& request,
+        const AuthorizationContext& auth);
+
+    HttpResponse::Ptr on_upload_part(
+        const S3Request& s3_request,
+        const HttpRequest& request,
+        const AuthorizationContext& auth,
+        HttpEvent event);
+
+    HttpResponse::Ptr on_complete_multipart_upload(
+        const S3Request& s3_request,
+        const HttpRequest& request,
+        const AuthorizationContext& auth);
+
+    HttpResponse::Ptr on_abort_multipart_upload(
+        const S3Request& s3_request,
+        const HttpRequest& request,
+        const AuthorizationContext& auth);
+
+    HttpResponse::Ptr on_list_parts(
+        const S3Request& s3_request,
+        const HttpRequest& request,
+        const AuthorizationContext& auth);
+
+    std::pair<HttpResponse::Ptr, S3MultipartUploads::Upload> on_get_upload(
+        const S3Request& s3_request,
+        const HttpRequest& request,
+        const AuthorizationContext& auth) const;
+
+    /**
+     * Give a staging object the request's key, replacing any object there
+     *
+     * @param s3_request The request
+     * @param auth The user
+     * @param staging_id Id of the staging object
+     * @return The response
+     */
+    HttpResponse::Ptr on_replace_object(
+        const S3Request& s3_request,
+        const AuthorizationContext& auth,
+        const std::string& staging_id) const;
+
+    HttpResponse::Ptr on_replace_object(
+        const S3Request& s3_request,
+        const AuthorizationContext& auth,
+        HsmObject& object,
+        const std::string& key,
+        const std::string& bucket_name) const;
+
+    HttpResponse::Ptr on_rename_object(
+        const S3Request& s3_request,
+        const AuthorizationContext& auth,
+        const HsmObject& object) const;
+
+    HttpResponse::Ptr on_stitch_upload(
+        const S3Request& s3_request,
+        const AuthorizationContext& auth,
+        const S3MultipartUploads::Upload& upload,
+        std::size_t size) const;
 
     std::pair<HttpResponse::Ptr, CrudResponsePtr> on_get_object(
         const S3Request& req,
@@ -81,5 +155,6 @@ class S3ObjectView : public S3WebView {
         const std::string& key) const;
 
     std::unique_ptr<S3HsmObjectAdapter> m_object_adatper;
+    S3MultipartUploads* m_uploads{nullptr};
 };
 }  // namespace hestia
\ No newline at end of file
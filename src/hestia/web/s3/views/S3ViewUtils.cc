@@ -13,6 +13,17 @@ CrudIdentifier S3ViewUtils::path_to_crud_id(const S3Path& path)
     return id;
 }
 
+HttpResponse::Ptr S3ViewUtils::on_error(
+    const S3Request& req, S3StatusCode code, const std::string& msg)
+{
+    S3Status s3_status(code, req, msg);
+    const auto& [http_code, id] = s3_status.get_code_and_id();
+    auto response               = HttpResponse::create(http_code, id);
+    response->set_body(s3_status.to_string());
+    set_common_headers(*response);
+    return response;
+}
+
 HttpResponse::Ptr S3ViewUtils::on_server_error(
     const S3Request& req, const std::string& msg)
 {
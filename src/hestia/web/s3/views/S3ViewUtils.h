@@ -45,6 +45,11 @@ class S3ViewUtils {
   public:
     static CrudIdentifier path_to_crud_id(const S3Path& path);
 
+    static HttpResponse::Ptr on_error(
+        const S3Request& req,
+        S3StatusCode code,
+        const std::string& msg = {});
+
     static HttpResponse::Ptr on_server_error(
         const S3Request& req, const std::string& msg);
 
@@ -45,6 +45,8 @@ class HsmAction : public HsmItem, public OwnableModel {
 
     std::size_t get_size() const { return m_to_transfer.get_value(); }
 
+    Status get_status() const { return m_status.get_value(); }
+
     std::size_t get_num_transferred() const
     {
         return m_transferred.get_value();
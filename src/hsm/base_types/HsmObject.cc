@@ -45,6 +45,9 @@ HsmObject& HsmObject::operator=(const HsmObject& other)
 void HsmObject::init()
 {
     m_name.set_index_scope(BaseField::IndexScope::PARENT);
+    m_creation_time.set_is_secondary_index(true);
+    m_size.set_is_secondary_index(true);
+    m_dataset.set_is_secondary_index(true);
 
     register_scalar_field(&m_size);
     register_one_to_one_proxy_field(&m_metadata);
@@ -46,6 +46,9 @@ std::string TierExtents::get_type()
 
 void TierExtents::init()
 {
+    m_tier_id.set_is_secondary_index(true);
+    m_object.set_is_secondary_index(true);
+
     register_scalar_field(&m_tier_id);
     register_sequence_field(&m_extents);
 
@@ -67,6 +70,13 @@ void TierExtents::remove_extent(const Extent& extent)
     }
 }
 
+void TierExtents::set_extent(const Extent& extent)
+{
+    auto& extents = m_extents.get_container_as_writeable();
+    extents.clear();
+    extents[extent.m_offset] = extent;
+}
+
 bool TierExtents::empty() const
 {
     return m_extents.container().empty();
@@ -80,4 +90,13 @@ std::size_t TierExtents::get_size() const
     return m_extents.container().rbegin()->second.get_end();
 }
 
+std::size_t TierExtents::get_stored_size() const
+{
+    std::size_t size{0};
+    for (const auto& [offset, extent] : m_extents.container()) {
+        size += extent.m_length;
+    }
+    return size;
+}
+
 }  // namespace hestia
\ No newline at end of file
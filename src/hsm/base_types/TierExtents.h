@@ -20,6 +20,13 @@ class TierExtents : public HsmItem, public LockableModel {
 
     std::size_t get_size() const;
 
+    /**
+     * Total length of the extents - unlike get_size() this leaves out gaps
+     *
+     * @return The length
+     */
+    std::size_t get_stored_size() const;
+
     static std::string get_type();
 
     const std::string& get_tier_id() const { return m_tier.get_id(); }
@@ -34,6 +41,13 @@ class TierExtents : public HsmItem, public LockableModel {
 
     void remove_extent(const Extent& extent);
 
+    /**
+     * Replace all extents with a single extent
+     *
+     * @param extent The extent
+     */
+    void set_extent(const Extent& extent);
+
     void set_object_id(const std::string& id) { m_object.set_id(id); }
 
     void set_tier_id(const std::string& id) { m_tier.set_id(id); }
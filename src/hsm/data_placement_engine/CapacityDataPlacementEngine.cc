@@ -0,0 +1,248 @@
+#include "CapacityDataPlacementEngine.h"
+
+#include "StorageTier.h"
+#include "TierExtents.h"
+
+#include "HashUtils.h"
+#include "Logger.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace hestia {
+CapacityDataPlacementEngine::CapacityDataPlacementEngine(
+    CrudService* tier_service,
+    CrudService* extent_service,
+    std::chrono::seconds refresh_interval,
+    double high_watermark) :
+    DataPlacementEngine(tier_service),
+    m_extent_service(extent_service),
+    m_refresh_interval(refresh_interval),
+    m_high_watermark(high_watermark)
+{
+}
+
+CapacityDataPlacementEngine::~CapacityDataPlacementEngine()
+{
+    if (m_refresh_task.valid()) {
+        m_refresh_task.wait();
+    }
+}
+
+std::uint8_t CapacityDataPlacementEngine::choose_tier(
+    const std::size_t length, const std::uint8_t hint)
+{
+    refresh_if_stale();
+
+    std::scoped_lock guard(m_mutex);
+    const auto tiers = get_tiers_by_speed();
+
+    auto iter = std::find(tiers.begin(), tiers.end(), hint);
+    if (iter == tiers.end()) {
+        return hint;
+    }
+
+    for (; iter != tiers.end(); iter++) {
+        if (has_room(m_tiers[*iter], length)) {
+            if (*iter != hint) {
+                LOG_INFO(
+                    "Tier " << int(hint) << " is near full - placing "
+                            << length << " bytes on tier " << int(*iter));
+            }
+            return *iter;
+        }
+    }
+    LOG_WARN("No tier has room for " << length << " bytes");
+    return hint;
+}
+
+std::string CapacityDataPlacementEngine::choose_node(
+    const std::uint8_t tier,
+    const std::size_t length,
+    const std::string& object_id)
+{
+    refresh_if_stale();
+
+    std::scoped_lock guard(m_mutex);
+    auto tier_iter = m_tiers.find(tier);
+    if (tier_iter == m_tiers.end() || tier_iter->second.m_nodes.empty()) {
+        return {};
+    }
+
+    std::string chosen_node;
+    if (!object_id.empty()) {
+        // Rendezvous hashing - the node scoring highest for the object
+        std::uint64_t highest_score{0};
+        for (const auto& node : tier_iter->second.m_nodes) {
+            if (const auto score = get_node_score(node, object_id);
+                chosen_node.empty() || score > highest_score) {
+                highest_score = score;
+                chosen_node   = node;
+            }
+        }
+    }
+    else {
+        std::size_t least_assigned{std::numeric_limits<std::size_t>::max()};
+        for (const auto& node : tier_iter->second.m_nodes) {
+            if (const auto assigned = m_node_assigned[node];
+                assigned < least_assigned) {
+                least_assigned = assigned;
+                chosen_node    = node;
+            }
+        }
+    }
+    m_node_assigned[chosen_node] += length;
+    return chosen_node;
+}
+
+std::uint64_t CapacityDataPlacementEngine::get_node_score(
+    const std::string& node, const std::string& object_id)
+{
+    // Mixed so that similar node names don't give similar scores
+    auto hash = HashUtils::do_fnv1a(node + "/" + object_id);
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53ULL;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+void CapacityDataPlacementEngine::on_put_started(
+    const std::uint8_t tier, const std::size_t length)
+{
+    std::scoped_lock guard(m_mutex);
+    if (auto iter = m_tiers.find(tier); iter != m_tiers.end()) {
+        iter->second.m_in_flight += length;
+    }
+}
+
+void CapacityDataPlacementEngine::on_put_finished(
+    const std::uint8_t tier, const std::size_t length, const std::size_t added)
+{
+    std::scoped_lock guard(m_mutex);
+    if (auto iter = m_tiers.find(tier); iter != m_tiers.end()) {
+        auto& state = iter->second;
+        state.m_in_flight -= std::min(length, state.m_in_flight);
+        state.m_used += added;
+    }
+}
+
+void CapacityDataPlacementEngine::refresh_if_stale()
+{
+    std::unique_lock guard(m_mutex);
+    if (m_refresh_pending
+        || (!m_tiers.empty()
+            && Clock::now() - m_last_refresh < m_refresh_interval)) {
+        return;
+    }
+    m_refresh_pending = true;
+
+    // Only the first load holds up the caller. Later ones scan the extents
+    // in the background while the usage counted from writes is used.
+    if (m_tiers.empty()) {
+        guard.unlock();
+        refresh();
+        return;
+    }
+    m_refresh_task = std::async(std::launch::async, [this]() { refresh(); });
+}
+
+void CapacityDataPlacementEngine::refresh()
+{
+    // The db reads are made without holding the lock
+    std::map<std::uint8_t, TierState> tiers;
+    std::unordered_map<std::string, std::uint8_t> tier_names;
+    bool has_capacity{false};
+
+    const auto tier_response = m_tier_service->make_request(
+        CrudRequest{CrudQuery{CrudQuery::OutputFormat::ITEM}, {}});
+    if (tier_response->ok()) {
+        for (const auto& item : tier_response->items()) {
+            const auto tier = dynamic_cast<const StorageTier*>(item.get());
+            if (tier == nullptr) {
+                continue;
+            }
+            auto& state       = tiers[tier->id_uint()];
+            state.m_id        = tier->get_primary_key();
+            state.m_capacity  = tier->get_capacity();
+            state.m_bandwidth = tier->get_bandwidth();
+            for (const auto& backend : tier->get_backends()) {
+                if (!backend.get_node_id().empty()) {
+                    state.m_nodes.push_back(backend.get_node_id());
+                }
+            }
+            tier_names[state.m_id] = tier->id_uint();
+            has_capacity           = has_capacity || state.m_capacity > 0;
+        }
+    }
+    else {
+        LOG_ERROR(
+            "Failed to list tiers for placement: "
+            << tier_response->get_error().to_string());
+    }
+
+    // Usage only matters for tiers with a capacity
+    if (has_capacity && m_extent_service != nullptr) {
+        const auto extent_response = m_extent_service->make_request(
+            CrudRequest{CrudQuery{CrudQuery::OutputFormat::ITEM}, {}});
+        if (extent_response->ok()) {
+            for (const auto& item : extent_response->items()) {
+                const auto extents =
+                    dynamic_cast<const TierExtents*>(item.get());
+                if (extents == nullptr) {
+                    continue;
+                }
+                auto iter = tier_names.find(extents->get_tier_id());
+                if (iter == tier_names.end()) {
+                    continue;
+                }
+                tiers[iter->second].m_used += extents->get_stored_size();
+            }
+        }
+        else {
+            LOG_ERROR(
+                "Failed to list tier extents for placement: "
+                << extent_response->get_error().to_string());
+        }
+    }
+
+    std::scoped_lock guard(m_mutex);
+    for (auto& [name, state] : tiers) {
+        if (auto iter = m_tiers.find(name); iter != m_tiers.end()) {
+            state.m_in_flight = iter->second.m_in_flight;
+        }
+    }
+    m_tiers           = std::move(tiers);
+    m_last_refresh    = Clock::now();
+    m_refresh_pending = false;
+}
+
+bool CapacityDataPlacementEngine::has_room(
+    const TierState& tier, std::size_t length) const
+{
+    if (tier.m_capacity == 0) {
+        return true;
+    }
+    const auto limit = static_cast<double>(tier.m_capacity) * m_high_watermark;
+    return static_cast<double>(tier.m_used + tier.m_in_flight + length)
+           <= limit;
+}
+
+std::vector<std::uint8_t> CapacityDataPlacementEngine::get_tiers_by_speed()
+    const
+{
+    std::vector<std::uint8_t> names;
+    for (const auto& [name, state] : m_tiers) {
+        names.push_back(name);
+    }
+
+    // Faster tiers first, with the lower tier number first for equal speeds
+    std::stable_sort(
+        names.begin(), names.end(), [this](std::uint8_t lhs, std::uint8_t rhs) {
+            return m_tiers.at(lhs).m_bandwidth > m_tiers.at(rhs).m_bandwidth;
+        });
+    return names;
+}
+
+}  // namespace hestia
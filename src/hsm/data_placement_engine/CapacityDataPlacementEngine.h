@@ -0,0 +1,94 @@
+#pragma once
+
+#include "DataPlacementEngine.h"
+
+#include <chrono>
+#include <future>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+
+namespace hestia {
+
+/**
+ * @brief Places writes by tier speed and free capacity
+ *
+ * Writes go to the fastest tier, no faster than the hinted one, which has
+ * room for them. A tier has room if its usage, including in-flight writes,
+ * stays under 'high_watermark' of its capacity - so writes spill down to
+ * slower tiers as faster ones fill. Tiers are ordered by bandwidth, fastest
+ * first, and then by tier number. Tiers without a capacity never fill.
+ *
+ * Tier usage is found by summing the tier extents in the db when first
+ * needed and then every 'refresh_interval' in the background, and kept up
+ * to date with writes through this engine in between.
+ *
+ * An object's data is placed on one of a tier's nodes by rendezvous hashing
+ * of its id, so retried writes of a new object find the same node and
+ * objects spread evenly over the nodes. Writes without an object go to the
+ * node with the fewest bytes assigned so far.
+ */
+class CapacityDataPlacementEngine : public DataPlacementEngine {
+  public:
+    CapacityDataPlacementEngine(
+        CrudService* tier_service,
+        CrudService* extent_service = nullptr,
+        std::chrono::seconds refresh_interval = std::chrono::seconds(30),
+        double high_watermark                 = 0.9);
+
+    virtual ~CapacityDataPlacementEngine();
+
+    std::uint8_t choose_tier(
+        const std::size_t length, const std::uint8_t hint = 0) override;
+
+    std::string choose_node(
+        const std::uint8_t tier,
+        const std::size_t length,
+        const std::string& object_id = {}) override;
+
+    void on_put_started(
+        const std::uint8_t tier, const std::size_t length) override;
+
+    void on_put_finished(
+        const std::uint8_t tier,
+        const std::size_t length,
+        const std::size_t added) override;
+
+    /**
+     * Re-read the tiers and their usage from the db
+     */
+    void refresh();
+
+  private:
+    using Clock = std::chrono::steady_clock;
+
+    struct TierState {
+        std::string m_id;
+        std::size_t m_capacity{0};
+        std::size_t m_bandwidth{0};
+        std::size_t m_used{0};
+        std::size_t m_in_flight{0};
+        std::vector<std::string> m_nodes;
+    };
+
+    void refresh_if_stale();
+
+    bool has_room(const TierState& tier, std::size_t length) const;
+
+    static std::uint64_t get_node_score(
+        const std::string& node, const std::string& object_id);
+
+    std::vector<std::uint8_t> get_tiers_by_speed() const;
+
+    CrudService* m_extent_service{nullptr};
+    std::chrono::seconds m_refresh_interval;
+    double m_high_watermark{0.9};
+
+    std::mutex m_mutex;
+    bool m_refresh_pending{false};
+    std::future<void> m_refresh_task;
+    Clock::time_point m_last_refresh;
+    std::map<std::uint8_t, TierState> m_tiers;
+    std::unordered_map<std::string, std::size_t> m_node_assigned;
+};
+}  // namespace hestia
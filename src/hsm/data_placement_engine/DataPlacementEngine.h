@@ -15,6 +15,59 @@ class DataPlacementEngine {
     virtual std::uint8_t choose_tier(
         const std::size_t length, const std::uint8_t hint = 0) = 0;
 
+    /**
+     * Choose which node, of those with a backend for the tier, should take
+     * an object's data. Data already on the tier is found from the object's
+     * extents, so this is only asked for data new to the tier.
+     *
+     * @param tier The tier being accessed
+     * @param length The length of the write, if any
+     * @param object_id The object being accessed, if any
+     * @return Id of the chosen node, or empty to leave it to the caller
+     */
+    virtual std::string choose_node(
+        const std::uint8_t tier,
+        const std::size_t length,
+        const std::string& object_id = {})
+    {
+        (void)tier;
+        (void)length;
+        (void)object_id;
+        return {};
+    }
+
+    /**
+     * Note that a write to the tier has started so its bytes count towards
+     * the tier's usage while in-flight.
+     *
+     * @param tier The tier being written to
+     * @param length The length of the write
+     */
+    virtual void on_put_started(
+        const std::uint8_t tier, const std::size_t length)
+    {
+        (void)tier;
+        (void)length;
+    }
+
+    /**
+     * Note that a write started with 'on_put_started' has finished
+     *
+     * @param tier The tier written to
+     * @param length The length of the write
+     * @param added How much the write grew the tier's usage by - less than
+     * the length if it overwrote existing data, and 0 if it failed
+     */
+    virtual void on_put_finished(
+        const std::uint8_t tier,
+        const std::size_t length,
+        const std::size_t added)
+    {
+        (void)tier;
+        (void)length;
+        (void)added;
+    }
+
   protected:
     CrudService* m_tier_service{nullptr};
 };
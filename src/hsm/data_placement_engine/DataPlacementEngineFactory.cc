@@ -7,6 +7,8 @@ std::string DataPlacementEngineFactory::to_string(
     switch (placement_engine_type) {
         case PlacementEngineType::BASIC:
             return "BASIC";
+        case PlacementEngineType::CAPACITY:
+            return "CAPACITY";
         case PlacementEngineType::ROBINHOOD:
             return "ROBINHOOD";
         default:
@@ -19,6 +21,7 @@ bool DataPlacementEngineFactory::is_placement_engine_available(
 {
     switch (placement_engine_type) {
         case PlacementEngineType::BASIC:
+        case PlacementEngineType::CAPACITY:
             return true;
         case PlacementEngineType::ROBINHOOD:
 #ifdef HAS_ROBINHOOD
@@ -31,13 +34,17 @@ bool DataPlacementEngineFactory::is_placement_engine_available(
     }
 }
 
-
 std::unique_ptr<DataPlacementEngine> DataPlacementEngineFactory::get_engine(
-    PlacementEngineType placement_engine_type, CrudService* tier_service)
+    PlacementEngineType placement_engine_type,
+    CrudService* tier_service,
+    CrudService* extent_service)
 {
     switch (placement_engine_type) {
         case PlacementEngineType::BASIC:
             return std::make_unique<BasicDataPlacementEngine>(tier_service);
+        case PlacementEngineType::CAPACITY:
+            return std::make_unique<CapacityDataPlacementEngine>(
+                tier_service, extent_service);
         case PlacementEngineType::ROBINHOOD:
 #ifdef HAS_ROBINHOOD
             return std::make_unique<RobinhoodDataPlacementEngine>();
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "BasicDataPlacementEngine.h"
+#include "CapacityDataPlacementEngine.h"
 
 #ifdef HAS_ROBINHOOD
 #include "RobinhoodPlacementEngine.h"
@@ -10,7 +11,7 @@
 #include <string>
 
 namespace hestia {
-enum class PlacementEngineType { BASIC, ROBINHOOD };
+enum class PlacementEngineType { BASIC, CAPACITY, ROBINHOOD };
 
 class DataPlacementEngineFactory {
 
@@ -21,7 +22,9 @@ class DataPlacementEngineFactory {
         PlacementEngineType placement_engine_type);
 
     static std::unique_ptr<DataPlacementEngine> get_engine(
-        PlacementEngineType placement_engine_type, CrudService* tier_service);
+        PlacementEngineType placement_engine_type,
+        CrudService* tier_service,
+        CrudService* extent_service = nullptr);
 };
 
 }  // namespace hestia
\ No newline at end of file
@@ -1,10 +1,12 @@
 #include "DistributedHsmService.h"
 
 #include "CrudServiceFactory.h"
+#include "DataPlacementEngine.h"
 #include "HsmService.h"
 #include "HttpClient.h"
 #include "KeyValueStoreClient.h"
 
+#include "HsmObject.h"
 #include "IdGenerator.h"
 #include "StorageTier.h"
 #include "TimeProvider.h"
@@ -135,7 +137,8 @@ HsmActionResponse::Ptr DistributedHsmService::make_request(
         auto response =
             HsmActionResponse::create(request, request.get_action());
 
-        auto node_address = get_backend_address(request.source_tier());
+        auto node_address = get_backend_address(
+            request.source_tier(), request.get_action().get_subject_key());
         if (node_address.empty()) {
             const std::string message = "No backend found for source tier: "
                                         + std::to_string(request.source_tier());
@@ -160,14 +163,12 @@ void DistributedHsmService::do_data_io_action(
     dataIoCompletionFunc completion_func) const
 {
     if (m_config.m_self.is_controller()) {
-        std::string tier_name;
         if (request.get_action().get_action() == HsmAction::Action::PUT_DATA) {
-            tier_name = std::to_string(request.target_tier());
-        }
-        else {
-            tier_name = std::to_string(request.source_tier());
+            put_data(request, stream, completion_func);
+            return;
         }
 
+        const auto tier_name = std::to_string(request.source_tier());
         for (const auto& backend : get_backends()) {
             if (backend.has_tier_name(tier_name)) {
                 LOG_INFO("Controller has backend locally - using that.");
@@ -177,32 +178,12 @@ void DistributedHsmService::do_data_io_action(
             }
         }
 
-        if (request.get_action().get_action() == HsmAction::Action::PUT_DATA) {
-            auto response =
-                HsmActionResponse::create(request, request.get_action());
-
-            auto node_address = get_backend_address(request.target_tier());
-            if (node_address.empty()) {
-                const std::string message =
-                    "No backend found for tier: "
-                    + std::to_string(request.target_tier());
-                LOG_ERROR(message);
-                response->on_error(
-                    {HsmActionErrorCode::ITEM_NOT_FOUND, message});
-                completion_func(std::move(response));
-            }
-            else {
-                LOG_INFO("Redirecting to: " + node_address);
-                response->set_redirect_location(node_address);
-                completion_func(std::move(response));
-            }
-        }
-        else if (
-            request.get_action().get_action() == HsmAction::Action::GET_DATA) {
+        if (request.get_action().get_action() == HsmAction::Action::GET_DATA) {
             auto response =
                 HsmActionResponse::create(request, request.get_action());
 
-            auto node_address = get_backend_address(request.source_tier());
+            auto node_address = get_backend_address(
+                request.source_tier(), request.get_action().get_subject_key());
             if (node_address.empty()) {
                 const std::string message =
                     "No backend found for tier: "
@@ -224,6 +205,56 @@ void DistributedHsmService::do_data_io_action(
     }
 }
 
+void DistributedHsmService::put_data(
+    const HsmActionRequest& request,
+    Stream* stream,
+    dataIoCompletionFunc completion_func) const
+{
+    auto response = HsmActionResponse::create(request, request.get_action());
+
+    const auto object = get_object(request.get_action().get_subject_key());
+    if (object == nullptr) {
+        const std::string message =
+            "Object " + request.get_action().get_subject_key() + " not found";
+        LOG_ERROR(message);
+        response->on_error({HsmActionErrorCode::ITEM_NOT_FOUND, message});
+        completion_func(std::move(response));
+        return;
+    }
+
+    // The tier is chosen once, here, and passed on with the write - it may
+    // spill below the requested one
+    const auto length = request.extent().empty() ? stream->get_source_size() :
+                                                   request.extent().m_length;
+    auto placed_request = request;
+    placed_request.set_placed_tier(
+        m_hsm_service->choose_put_tier(request, *object, length));
+    const auto tier_name = std::to_string(placed_request.target_tier());
+
+    for (const auto& backend : get_backends()) {
+        if (backend.has_tier_name(tier_name)) {
+            LOG_INFO("Controller has backend locally - using that.");
+            m_hsm_service->do_data_io_action(
+                placed_request, stream, completion_func);
+            return;
+        }
+    }
+
+    const auto node_address =
+        get_node_address(placed_request.target_tier(), object.get(), length);
+    if (node_address.empty()) {
+        const std::string message = "No backend found for tier: " + tier_name;
+        LOG_ERROR(message);
+        response->on_error({HsmActionErrorCode::ITEM_NOT_FOUND, message});
+    }
+    else {
+        LOG_INFO("Redirecting to: " + node_address);
+        response->set_redirect_location(node_address);
+        response->set_redirect_placed_tier(placed_request.target_tier());
+    }
+    completion_func(std::move(response));
+}
+
 UserService* DistributedHsmService::get_user_service()
 {
     return m_user_service;
@@ -326,7 +357,14 @@ void DistributedHsmService::register_backends()
 }
 
 std::string DistributedHsmService::get_backend_address(
-    uint8_t tier_name, const std::string&) const
+    uint8_t tier_name, const std::string& object_id, std::size_t length) const
+{
+    const auto object = object_id.empty() ? nullptr : get_object(object_id);
+    return get_node_address(tier_name, object.get(), length);
+}
+
+std::string DistributedHsmService::get_node_address(
+    uint8_t tier_name, const HsmObject* object, std::size_t length) const
 {
     auto tier_service = m_hsm_service->get_service(HsmItem::Type::TIER);
     CrudIdentifier tier_id(
@@ -350,7 +388,24 @@ std::string DistributedHsmService::get_backend_address(
         LOG_INFO("No backends found for tier: " + tier_id.get_name());
         return {};
     }
-    const auto node_id = tier->get_backends()[0].get_node_id();
+
+    // Data already on the tier is on the node recorded in the object's
+    // extents - only data new to the tier is placed by the engine
+    std::string node_id;
+    if (object != nullptr) {
+        node_id = get_object_node_id(*tier, *object);
+    }
+    if (node_id.empty()) {
+        if (auto engine = m_hsm_service->get_placement_engine();
+            engine != nullptr) {
+            node_id = engine->choose_node(
+                tier_name, length,
+                object != nullptr ? object->get_primary_key() : std::string());
+        }
+    }
+    if (node_id.empty()) {
+        node_id = tier->get_backends()[0].get_node_id();
+    }
     LOG_INFO("Checking node id: " << node_id << " for backend");
 
     auto node_service      = m_hsm_service->get_service(HsmItem::Type::NODE);
@@ -378,6 +433,42 @@ std::string DistributedHsmService::get_backend_address(
     return node_address;
 }
 
+std::unique_ptr<HsmObject> DistributedHsmService::get_object(
+    const std::string& object_id) const
+{
+    auto object_service  = m_hsm_service->get_service(HsmItem::Type::OBJECT);
+    auto object_response = object_service->make_request(CrudRequest{
+        CrudQuery{object_id, CrudQuery::OutputFormat::ITEM},
+        m_user_service->get_current_user_context()});
+    if (!object_response->ok()) {
+        LOG_ERROR(
+            "Failed to get object " + object_id + ": "
+            + object_response->get_error().to_string());
+        return nullptr;
+    }
+    if (!object_response->found()) {
+        return nullptr;
+    }
+    return std::make_unique<HsmObject>(
+        *object_response->get_item_as<HsmObject>());
+}
+
+std::string DistributedHsmService::get_object_node_id(
+    const StorageTier& tier, const HsmObject& object) const
+{
+    for (const auto& extent : object.tiers()) {
+        if (extent.get_tier_id() != tier.get_primary_key()) {
+            continue;
+        }
+        for (const auto& backend : tier.get_backends()) {
+            if (backend.get_primary_key() == extent.get_backend_id()) {
+                return backend.get_node_id();
+            }
+        }
+    }
+    return {};
+}
+
 HsmService* DistributedHsmService::get_hsm_service()
 {
     return m_hsm_service.get();
@@ -11,6 +11,8 @@ namespace hestia {
 class KeyValueStoreClient;
 class HttpClient;
 class UserService;
+class HsmObject;
+class StorageTier;
 
 class HsmService;
 using HsmServicePtr = std::unique_ptr<HsmService>;
@@ -60,14 +62,39 @@ class DistributedHsmService {
 
     const DistributedHsmServiceConfig& get_self_config() const;
 
+    /**
+     * Get the address of a node with a backend for the tier. If the object
+     * has data on the tier it is the node recorded in its extents, otherwise
+     * the placement engine chooses one.
+     *
+     * @param tier_name The tier
+     * @param object_id The object being accessed, if any
+     * @param length Length of the data to be written, if any
+     * @return The node address, or empty if the tier has no backends
+     */
     std::string get_backend_address(
-        uint8_t tier_name, const std::string& object_id = {}) const;
+        uint8_t tier_name,
+        const std::string& object_id = {},
+        std::size_t length           = 0) const;
 
     void register_self();
 
   private:
     void register_backends();
 
+    void put_data(
+        const HsmActionRequest& request,
+        Stream* stream,
+        dataIoCompletionFunc completion_func) const;
+
+    std::string get_node_address(
+        uint8_t tier_name, const HsmObject* object, std::size_t length) const;
+
+    std::unique_ptr<HsmObject> get_object(const std::string& object_id) const;
+
+    std::string get_object_node_id(
+        const StorageTier& tier, const HsmObject& object) const;
+
     DistributedHsmServiceConfig m_config;
     HsmServicePtr m_hsm_service;
     UserService* m_user_service;
@@ -1,6 +1,6 @@
 #include "HsmService.h"
 
-#include "BasicDataPlacementEngine.h"
+#include "CapacityDataPlacementEngine.h"
 #include "DataPlacementEngine.h"
 #include "HsmObjectStoreClient.h"
 
@@ -84,8 +84,9 @@ HsmService::Ptr HsmService::create(
     services->create_default_services(
         config, &backend, user_service, event_feed);
 
-    auto placement_engine = std::make_unique<BasicDataPlacementEngine>(
-        services->get_service(HsmItem::Type::TIER));
+    auto placement_engine = std::make_unique<CapacityDataPlacementEngine>(
+        services->get_service(HsmItem::Type::TIER),
+        services->get_service(HsmItem::Type::EXTENT));
 
     return std::make_unique<HsmService>(
         config, std::move(services), object_store, std::move(placement_engine),
@@ -102,6 +103,11 @@ CrudService* HsmService::get_service(HsmItem::Type type) const
     return m_services->get_service(type);
 }
 
+DataPlacementEngine* HsmService::get_placement_engine() const
+{
+    return m_placement_engine.get();
+}
+
 CrudResponse::Ptr HsmService::make_request(
     const CrudRequest& req, const std::string& type) const noexcept
 {
@@ -296,27 +302,55 @@ void HsmService::put_data(
 
     const auto working_object = get_response->get_item_as<HsmObject>();
 
-    auto chosen_tier = req.target_tier();
-    if (m_placement_engine != nullptr) {
-        chosen_tier = m_placement_engine->choose_tier(
-            working_object->size(), req.target_tier());
-    }
+    const auto put_length = req.extent().empty() ? stream->get_source_size() :
+                                                   req.extent().m_length;
+
+    const auto chosen_tier = choose_put_tier(req, *working_object, put_length);
 
     StorageObject storage_object(working_object->id());
     storage_object.get_metadata_as_writeable().set_item(
         "hestia-user_token", req.get_user_context().m_token);
 
-    HsmObjectStoreRequest data_put_request(
-        storage_object, HsmObjectStoreRequestMethod::PUT);
-    data_put_request.set_target_tier(chosen_tier);
-    data_put_request.set_action_id(working_action.get_primary_key());
-
+    // Stores tell a whole-object write from a partial one by its size
     auto working_extent = req.extent();
     if (working_extent.empty()) {
         working_extent = {0, stream->get_source_size()};
+        storage_object.set_size(working_extent.m_length);
     }
+
+    if (m_placement_engine != nullptr) {
+        // Count the write against the tier until it completes, then only by
+        // what it adds to the object's data there - overwrites add less
+        std::size_t added{working_extent.m_length};
+        for (const auto& tier_extents : working_object->tiers()) {
+            if (tier_extents.get_tier_id() == get_tier_id(chosen_tier)) {
+                auto updated = tier_extents;
+                updated.add_extent(working_extent);
+                const auto before = tier_extents.get_stored_size();
+                const auto after  = updated.get_stored_size();
+                added             = after > before ? after - before : 0;
+                break;
+            }
+        }
+
+        m_placement_engine->on_put_started(chosen_tier, put_length);
+        completion_func = [placement_engine = m_placement_engine.get(),
+                           chosen_tier, put_length, added, completion_func](
+                              HsmActionResponse::Ptr response) {
+            placement_engine->on_put_finished(
+                chosen_tier, put_length, response->ok() ? added : 0);
+            completion_func(std::move(response));
+        };
+    }
+
+    HsmObjectStoreRequest data_put_request(
+        storage_object, HsmObjectStoreRequestMethod::PUT);
+    data_put_request.set_target_tier(chosen_tier);
+    data_put_request.set_action_id(working_action.get_primary_key());
     data_put_request.set_extent(working_extent);
 
+    make_room(data_put_request, req.get_user_context());
+
     auto data_put_response =
         m_object_store->make_request(data_put_request, stream);
     CRUD_ERROR_CHECK(data_put_response, working_action, completion_func);
@@ -400,28 +434,16 @@ void HsmService::on_put_data_complete(
     }
     extent.add_extent(working_extent);
 
-    CrudResponsePtr extent_put_response;
-    auto extent_service = m_services->get_service(HsmItem::Type::EXTENT);
-    if (extent_needs_creation) {
-        extent_put_response =
-            extent_service->make_request(TypedCrudRequest<TierExtents>(
-                CrudMethod::CREATE, extent, user_context));
-    }
-    else {
-        extent_put_response =
-            extent_service->make_request(TypedCrudRequest<TierExtents>(
-                CrudMethod::UPDATE, extent, user_context));
-    }
-
-    if (!extent_put_response->ok()) {
-        auto response = HsmActionResponse::create(req, working_action);
-        response->on_error(
-            {HsmActionErrorCode::ERROR,
-             extent_put_response->get_error().to_string()});
+    // The extent, object and action writes are sent to the db together
+    auto unit_of_work = create_db_unit_of_work();
 
-        completion_func(std::move(response));
-        return;
-    }
+    auto extent_service = m_services->get_service(HsmItem::Type::EXTENT);
+    TypedCrudRequest<TierExtents> extent_request(
+        extent_needs_creation ? CrudMethod::CREATE : CrudMethod::UPDATE, extent,
+        user_context);
+    extent_request.set_unit_of_work(unit_of_work.get());
+    auto extent_put_response = extent_service->make_request(extent_request);
+    CRUD_ERROR_CHECK(extent_put_response, working_action, completion_func);
 
     auto updated_object = working_object;
     if (extent.get_size() > updated_object.size()) {
@@ -429,14 +451,18 @@ void HsmService::on_put_data_complete(
     }
 
     auto object_service = m_services->get_service(HsmItem::Type::OBJECT);
-    auto object_put_response =
-        object_service->make_request(TypedCrudRequest<HsmObject>{
-            CrudMethod::UPDATE, updated_object, user_context});
-    auto response = HsmActionResponse::create(req, working_action);
+    TypedCrudRequest<HsmObject> object_request(
+        CrudMethod::UPDATE, updated_object, user_context);
+    object_request.set_unit_of_work(unit_of_work.get());
+    auto object_put_response = object_service->make_request(object_request);
+    CRUD_ERROR_CHECK(object_put_response, working_action, completion_func);
 
     set_action_finished_ok(
         user_context, working_action.get_primary_key(),
-        working_extent.m_length);
+        working_extent.m_length, unit_of_work.get());
+
+    auto response = commit_db_unit_of_work(
+        req, user_context, working_action, unit_of_work.get());
 
     LOG_INFO(
         "Finished HSMService PUT | Action ID: "
@@ -445,6 +471,73 @@ void HsmService::on_put_data_complete(
     completion_func(std::move(response));
 }
 
+uint8_t HsmService::choose_put_tier(
+    const HsmActionRequest& req,
+    const HsmObject& object,
+    std::size_t length) const
+{
+    if (req.has_placed_tier()) {
+        return req.target_tier();
+    }
+
+    if (!req.extent().empty() && !object.tiers().empty()) {
+        const auto& tier_id = object.tiers()[0].get_tier_id();
+        for (const auto& [tier, id] : m_tier_cache) {
+            if (id == tier_id) {
+                return tier;
+            }
+        }
+    }
+
+    if (m_placement_engine != nullptr) {
+        return m_placement_engine->choose_tier(length, req.target_tier());
+    }
+    return req.target_tier();
+}
+
+void HsmService::make_room(
+    const HsmObjectStoreRequest& request,
+    const CrudUserContext& user_context) const
+{
+    const auto candidates = m_object_store->get_eviction_candidates(request);
+    if (candidates.empty()) {
+        return;
+    }
+
+    const auto tier = request.target_tier();
+    bool has_lower_tier{false};
+    uint8_t lower_tier{0};
+    for (const auto& [tier_id, id] : m_tier_cache) {
+        if (tier_id > tier && (!has_lower_tier || tier_id < lower_tier)) {
+            lower_tier     = tier_id;
+            has_lower_tier = true;
+        }
+    }
+    if (!has_lower_tier) {
+        LOG_WARN("Tier " << int(tier) << " is full and has no tier below it");
+        return;
+    }
+
+    for (const auto& object_id : candidates) {
+        HsmAction action(HsmItem::Type::OBJECT, HsmAction::Action::MOVE_DATA);
+        action.set_subject_key(object_id);
+        action.set_source_tier(tier);
+        action.set_target_tier(lower_tier);
+
+        const auto response = move_data(HsmActionRequest(action, user_context));
+        if (!response->ok()) {
+            LOG_ERROR(
+                "Failed to evict object " << object_id << " from tier "
+                                          << int(tier) << ": "
+                                          << response->get_error().to_string());
+            return;
+        }
+        LOG_INFO(
+            "Evicted object " << object_id << " from tier " << int(tier)
+                              << " to tier " << int(lower_tier));
+    }
+}
+
 const std::string& HsmService::get_tier_id(uint8_t tier) const
 {
     if (const auto& iter = m_tier_cache.find(tier);
@@ -567,7 +660,7 @@ void HsmService::on_get_data_complete(
 void HsmService::set_action_error(
     const CrudUserContext& user_context,
     const std::string& action_id,
-    const std::string& message)
+    const std::string& message) const
 {
     auto action_service = get_service(HsmItem::Type::ACTION);
 
@@ -595,31 +688,64 @@ void HsmService::set_action_error(
 void HsmService::set_action_finished_ok(
     const CrudUserContext& user_context,
     const std::string& action_id,
-    std::size_t bytes) const
+    std::size_t bytes,
+    CrudUnitOfWork* unit_of_work) const
 {
     auto action_service = get_service(HsmItem::Type::ACTION);
 
-    const auto action_read = action_service->make_request(CrudRequest{
-        CrudQuery{CrudIdentifier(action_id), CrudQuery::OutputFormat::ITEM},
-        user_context});
-    if (!action_read->ok()) {
-        throw std::runtime_error("Failed to get action for error assignment");
-    }
-
-    if (!action_read->found()) {
-        throw std::runtime_error("Failed to find action for error assignment");
-    }
-
-    auto action = *action_read->get_item_as<HsmAction>();
+    // Only the modified status fields are sent, the update merges them into
+    // the stored action so it doesn't need reading first
+    HsmAction action;
+    action.set_primary_key(action_id);
     action.on_finished_ok(bytes);
 
     LOG_INFO("Updating Action");
 
-    const auto action_update = action_service->make_request(
-        TypedCrudRequest<HsmAction>{CrudMethod::UPDATE, action, user_context});
+    TypedCrudRequest<HsmAction> update_request{
+        CrudMethod::UPDATE, action, user_context};
+    update_request.set_unit_of_work(unit_of_work);
+    const auto action_update = action_service->make_request(update_request);
     if (!action_update->ok()) {
-        throw std::runtime_error("Failed to get action for error assignment");
+        throw std::runtime_error("Failed to update action on completion");
+    }
+}
+
+CrudUnitOfWork::Ptr HsmService::create_db_unit_of_work() const
+{
+    return m_services->get_service(HsmItem::Type::OBJECT)
+        ->create_unit_of_work();
+}
+
+HsmActionResponse::Ptr HsmService::commit_db_unit_of_work(
+    const BaseRequest& req,
+    const CrudUserContext& user_context,
+    const HsmAction& working_action,
+    CrudUnitOfWork* unit_of_work) const noexcept
+{
+    auto response = HsmActionResponse::create(req, working_action);
+    if (unit_of_work == nullptr) {
+        return response;
+    }
+
+    try {
+        unit_of_work->commit();
     }
+    catch (const std::exception& e) {
+        response->on_error(
+            {HsmActionErrorCode::ERROR, SOURCE_LOC() + " | " + e.what()});
+
+        // The action's finished status was part of the failed batch, so it
+        // would otherwise be left looking as if it is still running
+        try {
+            set_action_error(
+                user_context, working_action.get_primary_key(), e.what());
+        }
+        catch (const std::exception& action_error) {
+            LOG_ERROR(
+                "Failed to mark action as failed: " << action_error.what());
+        }
+    }
+    return response;
 }
 
 void HsmService::set_action_progress(const std::string&, std::size_t) {}
@@ -644,12 +770,15 @@ HsmActionResponse::Ptr HsmService::move_data(
 
     const auto working_object = get_response->get_item_as<HsmObject>();
 
-    HsmObjectStoreRequest copy_data_request(
-        working_object->id(), HsmObjectStoreRequestMethod::COPY);
+    StorageObject storage_object(working_object->id());
     auto working_extent = req.extent();
     if (working_extent.empty()) {
         working_extent = {0, working_object->size()};
+        storage_object.set_size(working_extent.m_length);
     }
+
+    HsmObjectStoreRequest copy_data_request(
+        storage_object, HsmObjectStoreRequestMethod::COPY);
     copy_data_request.set_extent(working_extent);
     copy_data_request.set_source_tier(req.source_tier());
     copy_data_request.set_target_tier(req.target_tier());
@@ -693,35 +822,35 @@ HsmActionResponse::Ptr HsmService::move_data(
     target_extent.add_extent(working_extent);
     source_extent.remove_extent(working_extent);
 
-    CrudResponsePtr extent_put_response;
+    auto unit_of_work = create_db_unit_of_work();
+
     auto extent_service = m_services->get_service(HsmItem::Type::EXTENT);
-    if (extent_needs_creation) {
-        extent_put_response =
-            extent_service->make_request(TypedCrudRequest<TierExtents>(
-                CrudMethod::CREATE, target_extent, req.get_user_context()));
-    }
-    else {
-        extent_put_response =
-            extent_service->make_request(TypedCrudRequest<TierExtents>(
-                CrudMethod::UPDATE, target_extent, req.get_user_context()));
-    }
+    TypedCrudRequest<TierExtents> target_extent_request(
+        extent_needs_creation ? CrudMethod::CREATE : CrudMethod::UPDATE,
+        target_extent, req.get_user_context());
+    target_extent_request.set_unit_of_work(unit_of_work.get());
+    auto extent_put_response =
+        extent_service->make_request(target_extent_request);
     CRUD_ERROR_CHECK_RETURN(extent_put_response, working_action);
 
-    extent_put_response =
-        extent_service->make_request(TypedCrudRequest<TierExtents>(
-            CrudMethod::UPDATE, source_extent, req.get_user_context()));
+    TypedCrudRequest<TierExtents> source_extent_request(
+        CrudMethod::UPDATE, source_extent, req.get_user_context());
+    source_extent_request.set_unit_of_work(unit_of_work.get());
+    extent_put_response = extent_service->make_request(source_extent_request);
     CRUD_ERROR_CHECK_RETURN(extent_put_response, working_action);
 
-    auto object_put_response =
-        object_service->make_request(TypedCrudRequest<HsmObject>{
-            CrudMethod::UPDATE, *working_object, req.get_user_context()});
+    TypedCrudRequest<HsmObject> object_request{
+        CrudMethod::UPDATE, *working_object, req.get_user_context()};
+    object_request.set_unit_of_work(unit_of_work.get());
+    auto object_put_response = object_service->make_request(object_request);
     CRUD_ERROR_CHECK_RETURN(object_put_response, working_action);
 
     set_action_finished_ok(
         req.get_user_context(), working_action.get_primary_key(),
-        working_extent.m_length);
+        working_extent.m_length, unit_of_work.get());
 
-    auto response = HsmActionResponse::create(req, working_action);
+    auto response = commit_db_unit_of_work(
+        req, req.get_user_context(), working_action, unit_of_work.get());
 
     LOG_INFO("Finished HSMService MOVE DATA");
 
@@ -748,13 +877,15 @@ HsmActionResponse::Ptr HsmService::copy_data(
 
     const auto working_object = get_response->get_item_as<HsmObject>();
 
-    HsmObjectStoreRequest copy_data_request(
-        working_object->id(), HsmObjectStoreRequestMethod::COPY);
-
+    StorageObject storage_object(working_object->id());
     auto working_extent = req.extent();
     if (working_extent.empty()) {
         working_extent = {0, working_object->size()};
+        storage_object.set_size(working_extent.m_length);
     }
+
+    HsmObjectStoreRequest copy_data_request(
+        storage_object, HsmObjectStoreRequestMethod::COPY);
     copy_data_request.set_extent(working_extent);
     copy_data_request.set_source_tier(req.source_tier());
     copy_data_request.set_target_tier(req.target_tier());
@@ -789,30 +920,28 @@ HsmActionResponse::Ptr HsmService::copy_data(
     }
     target_extent.add_extent(working_extent);
 
-    CrudResponsePtr extent_put_response;
+    auto unit_of_work = create_db_unit_of_work();
+
     auto extent_service = m_services->get_service(HsmItem::Type::EXTENT);
-    if (extent_needs_creation) {
-        extent_put_response =
-            extent_service->make_request(TypedCrudRequest<TierExtents>(
-                CrudMethod::CREATE, target_extent, req.get_user_context()));
-    }
-    else {
-        extent_put_response =
-            extent_service->make_request(TypedCrudRequest<TierExtents>(
-                CrudMethod::UPDATE, target_extent, req.get_user_context()));
-    }
+    TypedCrudRequest<TierExtents> extent_request(
+        extent_needs_creation ? CrudMethod::CREATE : CrudMethod::UPDATE,
+        target_extent, req.get_user_context());
+    extent_request.set_unit_of_work(unit_of_work.get());
+    auto extent_put_response = extent_service->make_request(extent_request);
     CRUD_ERROR_CHECK_RETURN(extent_put_response, working_action);
 
-    auto object_put_response =
-        object_service->make_request(TypedCrudRequest<HsmObject>{
-            CrudMethod::UPDATE, *working_object, req.get_user_context()});
+    TypedCrudRequest<HsmObject> object_request{
+        CrudMethod::UPDATE, *working_object, req.get_user_context()};
+    object_request.set_unit_of_work(unit_of_work.get());
+    auto object_put_response = object_service->make_request(object_request);
     CRUD_ERROR_CHECK_RETURN(object_put_response, working_action);
 
     set_action_finished_ok(
         req.get_user_context(), working_action.get_primary_key(),
-        working_extent.m_length);
+        working_extent.m_length, unit_of_work.get());
 
-    auto response = HsmActionResponse::create(req, working_action);
+    auto response = commit_db_unit_of_work(
+        req, req.get_user_context(), working_action, unit_of_work.get());
 
     LOG_INFO("Finished HSMService COPY DATA");
 
@@ -874,29 +1003,38 @@ HsmActionResponse::Ptr HsmService::release_data(
         "Will update extent: " << extent.get_primary_key() << " "
                                << extent.get_extents().size());
 
+    auto unit_of_work = create_db_unit_of_work();
+
     CrudResponsePtr extent_response;
     auto extent_service = m_services->get_service(HsmItem::Type::EXTENT);
 
     if (extent.empty()) {
-        extent_response = extent_service->make_request(CrudRequest(
+        CrudRequest remove_request(
             CrudMethod::REMOVE, req.get_user_context(),
-            {extent.get_primary_key()}));
+            {extent.get_primary_key()});
+        remove_request.set_unit_of_work(unit_of_work.get());
+        extent_response = extent_service->make_request(remove_request);
     }
     else {
-        extent_response =
-            extent_service->make_request(TypedCrudRequest<TierExtents>(
-                CrudMethod::UPDATE, extent, req.get_user_context()));
+        TypedCrudRequest<TierExtents> update_request(
+            CrudMethod::UPDATE, extent, req.get_user_context());
+        update_request.set_unit_of_work(unit_of_work.get());
+        extent_response = extent_service->make_request(update_request);
     }
     CRUD_ERROR_CHECK_RETURN(extent_response, working_action);
 
-    auto object_put_response =
-        object_service->make_request(TypedCrudRequest<HsmObject>{
-            CrudMethod::UPDATE, *working_object, req.get_user_context()});
+    TypedCrudRequest<HsmObject> object_request{
+        CrudMethod::UPDATE, *working_object, req.get_user_context()};
+    object_request.set_unit_of_work(unit_of_work.get());
+    auto object_put_response = object_service->make_request(object_request);
+    CRUD_ERROR_CHECK_RETURN(object_put_response, working_action);
 
     set_action_finished_ok(
-        req.get_user_context(), working_action.get_primary_key(), 0);
+        req.get_user_context(), working_action.get_primary_key(), 0,
+        unit_of_work.get());
 
-    auto response = HsmActionResponse::create(req, working_action);
+    auto response = commit_db_unit_of_work(
+        req, req.get_user_context(), working_action, unit_of_work.get());
 
     LOG_INFO("Finished HSMService REMOVE");
 
@@ -15,6 +15,7 @@
 
 namespace hestia {
 class HsmObjectStoreClient;
+class HsmObjectStoreRequest;
 class HsmEventSink;
 class KeyValueStoreClient;
 
@@ -43,6 +44,8 @@ class HsmService : public CrudService {
 
     CrudService* get_service(HsmItem::Type type) const;
 
+    DataPlacementEngine* get_placement_engine() const;
+
     [[nodiscard]] CrudResponse::Ptr make_request(
         const CrudRequest& request,
         const std::string& type = {}) const noexcept override;
@@ -58,6 +61,23 @@ class HsmService : public CrudService {
 
     void update_tiers(const std::string& user_id);
 
+    /**
+     * Choose the tier a write to the object lands on. A partial write into
+     * an object with data lands on that data's tier, so extents written
+     * separately (e.g. multipart upload parts) stay together. Otherwise the
+     * placement engine chooses, unless the request already has a placed
+     * tier.
+     *
+     * @param request The write
+     * @param object The object written to
+     * @param length The length of the write
+     * @return The tier
+     */
+    uint8_t choose_put_tier(
+        const HsmActionRequest& request,
+        const HsmObject& object,
+        std::size_t length) const;
+
   private:
     CrudResponse::Ptr crud_create(
         HsmItem::Type subject_type, const CrudRequest& request) const noexcept;
@@ -108,15 +128,48 @@ class HsmService : public CrudService {
 
     const std::string& get_tier_id(uint8_t tier) const;
 
+    /**
+     * Move the objects the store suggests off a PUT's target tier, to the
+     * next tier down, so the PUT fits. They are moved like any other data,
+     * so their extents follow them.
+     *
+     * @param request The data PUT
+     * @param user_context User making the PUT
+     */
+    void make_room(
+        const HsmObjectStoreRequest& request,
+        const CrudUserContext& user_context) const;
+
     void set_action_error(
         const CrudUserContext& user_context,
         const std::string& action_id,
-        const std::string& message);
+        const std::string& message) const;
 
     void set_action_finished_ok(
         const CrudUserContext& user_context,
         const std::string& action_id,
-        std::size_t bytes) const;
+        std::size_t bytes,
+        CrudUnitOfWork* unit_of_work = nullptr) const;
+
+    /**
+     * Start a unit of work to batch the metadata writes made on completing
+     * an action.
+     *
+     * @return The unit of work, or null if the backend can't batch writes
+     */
+    CrudUnitOfWork::Ptr create_db_unit_of_work() const;
+
+    /**
+     * Apply the batched metadata writes for an action
+     *
+     * @return The action response, in error if the writes failed, in which
+     * case the action is also marked as failed
+     */
+    HsmActionResponse::Ptr commit_db_unit_of_work(
+        const BaseRequest& req,
+        const CrudUserContext& user_context,
+        const HsmAction& working_action,
+        CrudUnitOfWork* unit_of_work) const noexcept;
 
     void set_action_progress(const std::string& action_id, std::size_t bytes);
 
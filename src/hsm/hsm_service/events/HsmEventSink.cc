@@ -5,7 +5,6 @@
 #include "Logger.h"
 #include "StringUtils.h"
 #include "TimeUtils.h"
-#include "YamlUtils.h"
 
 #include "HsmItem.h"
 #include "HsmService.h"
@@ -17,11 +16,16 @@
 namespace hestia {
 
 HsmEventSink::HsmEventSink(
-    const std::string& output_file, HsmService* hsm_service) :
-    m_hsm_service(hsm_service), m_output_file(output_file)
+    const std::string& output_file,
+    HsmService* hsm_service,
+    const EventFeedConfig& config) :
+    m_hsm_service(hsm_service),
+    m_writer(std::make_unique<EventFeedWriter>(output_file, config))
 {
 }
 
+HsmEventSink::~HsmEventSink() = default;
+
 bool HsmEventSink::will_handle(
     const std::string& subject_type, CrudMethod method) const
 {
@@ -76,11 +80,9 @@ void HsmEventSink::on_event(const CrudEvent& event)
     }
 }
 
-void HsmEventSink::write(const std::string& content) const
+void HsmEventSink::write(Dictionary::Ptr event) const
 {
-    std::ofstream output_file;
-    output_file.open(m_output_file, std::ios::app);
-    output_file << content;
+    m_writer->push(std::move(event));
 }
 
 Dictionary* HsmEventSink::add_root(Dictionary& input) const
@@ -146,13 +148,12 @@ void set_xattrs(Dictionary& dict, const Map& meta, const char delim = '.')
 void HsmEventSink::on_extent_changed(const CrudEvent& event) const
 {
     LOG_INFO("Got hsm extent changed");
-    std::string out;
     for (const auto& id : event.get_ids()) {
-        Dictionary output_dict;
-        on_extent_changed(event.get_user_context(), *add_root(output_dict), id);
-        YamlUtils::dict_to_yaml(output_dict, out);
+        auto output_dict = Dictionary::create();
+        on_extent_changed(
+            event.get_user_context(), *add_root(*output_dict), id);
+        write(std::move(output_dict));
     }
-    write(out);
 }
 
 void HsmEventSink::on_extent_changed(
@@ -235,17 +236,15 @@ void HsmEventSink::on_extent_changed(
 void HsmEventSink::on_object_create(const CrudEvent& event) const
 {
     LOG_INFO("Got hsm object create");
-    std::string out;
     std::size_t count{0};
     assert(event.get_ids().size() == event.get_modified_attrs().size());
     for (const auto& id : event.get_ids()) {
-        Dictionary output_dict;
+        auto output_dict = Dictionary::create();
         on_object_create(
-            *add_root(output_dict), id, event.get_modified_attrs()[count]);
-        YamlUtils::dict_to_yaml(output_dict, out);
+            *add_root(*output_dict), id, event.get_modified_attrs()[count]);
+        write(std::move(output_dict));
         count++;
     }
-    write(out);
 }
 
 void HsmEventSink::on_object_read(const CrudEvent& event) const
@@ -253,18 +252,15 @@ void HsmEventSink::on_object_read(const CrudEvent& event) const
     LOG_INFO("Object read");
     assert(!event.get_ids().empty());
 
-    Dictionary dict;
-    auto root_dict = add_root(dict);
+    auto dict      = Dictionary::create();
+    auto root_dict = add_root(*dict);
 
     root_dict->set_tag("read");
 
     set_string(*root_dict, "id", event.get_ids()[0]);
     set_literal(
         *root_dict, "time", std::to_string(TimeUtils::get_current_time()));
-
-    std::string out;
-    YamlUtils::dict_to_yaml(dict, out);
-    write(out);
+    write(std::move(dict));
 }
 
 void HsmEventSink::on_object_create(
@@ -283,13 +279,11 @@ void HsmEventSink::on_object_create(
 void HsmEventSink::on_object_remove(const CrudEvent& event) const
 {
     LOG_INFO("Got hsm object remove");
-    std::string out;
     for (const auto& id : event.get_ids()) {
-        Dictionary output_dict;
-        on_object_remove(*add_root(output_dict), id);
-        YamlUtils::dict_to_yaml(output_dict, out);
+        auto output_dict = Dictionary::create();
+        on_object_remove(*add_root(*output_dict), id);
+        write(std::move(output_dict));
     }
-    write(out);
 }
 
 void HsmEventSink::on_object_remove(
@@ -350,30 +344,26 @@ void HsmEventSink::on_user_metadata_read(
 
 void HsmEventSink::on_user_metadata_update(const CrudEvent& event) const
 {
-    std::string out;
     std::size_t count{0};
     assert(event.get_ids().size() == event.get_modified_attrs().size());
     for (const auto& id : event.get_ids()) {
-        Dictionary output_dict;
+        auto output_dict = Dictionary::create();
         on_user_metadata_update(
-            event.get_user_context(), *add_root(output_dict), id,
+            event.get_user_context(), *add_root(*output_dict), id,
             event.get_modified_attrs()[count]);
-        YamlUtils::dict_to_yaml(output_dict, out);
+        write(std::move(output_dict));
         count++;
     }
-    write(out);
 }
 
 void HsmEventSink::on_user_metadata_read(const CrudEvent& event) const
 {
-    std::string out;
     for (const auto& id : event.get_ids()) {
-        Dictionary output_dict;
+        auto output_dict = Dictionary::create();
         on_user_metadata_read(
-            event.get_user_context(), *add_root(output_dict), id);
-        YamlUtils::dict_to_yaml(output_dict, out);
+            event.get_user_context(), *add_root(*output_dict), id);
+        write(std::move(output_dict));
     }
-    write(out);
 }
 
 }  // namespace hestia
\ No newline at end of file
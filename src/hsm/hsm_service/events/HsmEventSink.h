@@ -1,18 +1,33 @@
 #pragma once
 
 #include "Dictionary.h"
+#include "EventFeedWriter.h"
 #include "EventSink.h"
 #include "Map.h"
 
+#include <memory>
 #include <string>
 
 namespace hestia {
 
 class HsmService;
 
+/**
+ * @brief Feeds HSM object changes to a RobinHood-compatible YAML file
+ *
+ * Events are built on the calling thread, as they need lookups against the
+ * current state, and written out in the background by an EventFeedWriter.
+ */
 class HsmEventSink : public EventSink {
   public:
-    HsmEventSink(const std::string& output_file, HsmService* hsm_service);
+    HsmEventSink(
+        const std::string& output_file,
+        HsmService* hsm_service,
+        const EventFeedConfig& config = {});
+
+    ~HsmEventSink();
+
+    const EventFeedWriter& get_writer() const { return *m_writer; }
 
     void on_event(const CrudEvent& event) override;
 
@@ -57,11 +72,11 @@ class HsmEventSink : public EventSink {
 
     void on_object_remove(Dictionary& dict, const std::string& id) const;
 
-    void write(const std::string& content) const;
+    void write(Dictionary::Ptr event) const;
 
     Dictionary* add_root(Dictionary& input) const;
 
     HsmService* m_hsm_service{nullptr};
-    std::string m_output_file;
+    std::unique_ptr<EventFeedWriter> m_writer;
 };
 }  // namespace hestia
\ No newline at end of file
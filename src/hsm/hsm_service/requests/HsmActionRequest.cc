@@ -1,5 +1,6 @@
 #include "HsmActionRequest.h"
 
+#include <cstdint>
 #include <sstream>
 
 namespace hestia {
@@ -58,6 +59,29 @@ uint8_t HsmActionRequest::target_tier() const
     return m_action.get_target_tier();
 }
 
+void HsmActionRequest::set_placed_tier(uint8_t tier)
+{
+    m_action.set_target_tier(tier);
+    m_has_placed_tier = true;
+}
+
+void HsmActionRequest::set_placed_tier(const Map& queries)
+{
+    const auto tier = queries.get_item(placed_tier_query);
+    if (tier.empty() || tier.size() > 3
+        || tier.find_first_not_of("0123456789") != std::string::npos) {
+        return;
+    }
+    if (const auto value = std::stoul(tier); value <= UINT8_MAX) {
+        set_placed_tier(static_cast<uint8_t>(value));
+    }
+}
+
+bool HsmActionRequest::has_placed_tier() const
+{
+    return m_has_placed_tier;
+}
+
 Extent HsmActionRequest::extent() const
 {
     return {m_action.get_offset(), m_action.get_size()};
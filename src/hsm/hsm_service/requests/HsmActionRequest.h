@@ -3,6 +3,7 @@
 #include "CrudRequest.h"
 #include "Extent.h"
 #include "HsmAction.h"
+#include "Map.h"
 
 #include <memory>
 
@@ -14,6 +15,11 @@ class HsmActionRequest :
   public:
     using Ptr = std::unique_ptr<HsmActionRequest>;
 
+    /**
+     * Query parameter carrying a placed tier on a redirect
+     */
+    static constexpr char placed_tier_query[]{"hestia_placed_tier"};
+
     HsmActionRequest(
         const HsmAction& action, const CrudUserContext& user_context);
 
@@ -33,6 +39,23 @@ class HsmActionRequest :
 
     uint8_t target_tier() const;
 
+    /**
+     * Write to this tier without placing the write again - e.g. when the
+     * controller chose the tier before redirecting the write here
+     *
+     * @param tier The tier
+     */
+    void set_placed_tier(uint8_t tier);
+
+    /**
+     * Take the placed tier passed on with a redirect, if there is one
+     *
+     * @param queries Queries of the redirected http request
+     */
+    void set_placed_tier(const Map& queries);
+
+    bool has_placed_tier() const;
+
     std::string to_string() const;
 
     HsmItem::Type get_subject() const { return m_action.get_subject(); }
@@ -40,5 +63,6 @@ class HsmActionRequest :
   private:
     CrudUserContext m_user_context;
     HsmAction m_action;
+    bool m_has_placed_tier{false};
 };
 }  // namespace hestia
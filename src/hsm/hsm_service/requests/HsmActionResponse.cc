@@ -36,6 +36,17 @@ const std::string& HsmActionResponse::get_redirect_location() const
     return m_redirect_location;
 }
 
+void HsmActionResponse::set_redirect_placed_tier(uint8_t tier)
+{
+    m_redirect_query = "?" + std::string(HsmActionRequest::placed_tier_query)
+                       + "=" + std::to_string(tier);
+}
+
+std::string HsmActionResponse::get_redirect_query() const
+{
+    return m_redirect_query;
+}
+
 HsmAction& HsmActionResponse::action()
 {
     return m_action;
@@ -23,6 +23,21 @@ class HsmActionResponse : public Response<HsmActionErrorCode> {
 
     const std::string& get_redirect_location() const;
 
+    /**
+     * Pass the tier chosen for a write on with the redirect, so the node
+     * redirected to doesn't place the write again
+     *
+     * @param tier The tier
+     */
+    void set_redirect_placed_tier(uint8_t tier);
+
+    /**
+     * Query to add to the redirect location, if any
+     *
+     * @return The query, starting with '?', or empty
+     */
+    std::string get_redirect_query() const;
+
     HsmAction& action();
 
     const HsmAction& get_action() const;
@@ -31,5 +46,6 @@ class HsmActionResponse : public Response<HsmActionErrorCode> {
     HsmAction m_action;
     HsmObjectStoreResponse::Ptr m_object_store_response;
     std::string m_redirect_location;
+    std::string m_redirect_query;
 };
 }  // namespace hestia
@@ -4,6 +4,8 @@
 #include "HsmObjectStoreClientManager.h"
 
 #include "DistributedHsmService.h"
+#include "FileHsmObjectStoreClient.h"
+#include "FileObjectStoreClient.h"
 #include "InMemoryStreamSink.h"
 #include "InMemoryStreamSource.h"
 
@@ -297,10 +299,42 @@ HsmObjectStoreResponse::Ptr DistributedHsmObjectStoreClient::do_local_op(
     }
 }
 
+std::vector<std::string>
+DistributedHsmObjectStoreClient::get_eviction_candidates(
+    const HsmObjectStoreRequest& request) const
+{
+    // Tiers on other nodes make room for themselves when the put gets there
+    if (!m_client_manager->has_client(request.target_tier())) {
+        return {};
+    }
+
+    if (auto hsm_client =
+            m_client_manager->get_hsm_client(request.target_tier());
+        hsm_client != nullptr) {
+        return hsm_client->get_eviction_candidates(request);
+    }
+    return m_client_manager->get_client(request.target_tier())
+        ->get_eviction_candidates(
+            HsmObjectStoreRequest::to_base_request(request));
+}
+
 HsmObjectStoreResponse::Ptr
 DistributedHsmObjectStoreClient::do_local_copy_or_move(
     const HsmObjectStoreRequest& request, bool is_copy) const
 {
+    // Whole objects between file tiers are copied or moved in the kernel
+    const auto& extent = request.extent();
+    if (extent.empty()
+        || (extent.m_offset == 0
+            && extent.m_length == request.object().size())) {
+        auto source_client = get_file_client(request.source_tier());
+        auto target_client = get_file_client(request.target_tier());
+        if (source_client != nullptr && target_client != nullptr) {
+            return do_local_file_copy_or_move(
+                request, source_client, target_client, is_copy);
+        }
+    }
+
     Stream stream;
 
     HsmObjectStoreRequest get_request(
@@ -309,7 +343,7 @@ DistributedHsmObjectStoreClient::do_local_copy_or_move(
     get_request.set_extent(request.extent());
 
     HsmObjectStoreRequest put_request(
-        request.object().id(), HsmObjectStoreRequestMethod::PUT);
+        request.object(), HsmObjectStoreRequestMethod::PUT);
     put_request.set_target_tier(request.target_tier());
     put_request.set_extent(request.extent());
 
@@ -351,7 +385,8 @@ DistributedHsmObjectStoreClient::do_local_copy_or_move(
 
     auto result = HsmObjectStoreResponse::create(request, m_id);
 
-    auto stream_result = stream.flush();
+    auto stream_result =
+        stream.flush(m_config.m_buffer_size, m_config.m_num_buffers);
     if (!stream_result.ok()) {
         result->on_error(
             {HsmObjectStoreErrorCode::ERROR,
@@ -386,6 +421,109 @@ DistributedHsmObjectStoreClient::do_local_copy_or_move(
     return result;
 }
 
+HsmObjectStoreResponse::Ptr
+DistributedHsmObjectStoreClient::do_local_file_copy_or_move(
+    const HsmObjectStoreRequest& request,
+    FileObjectStoreClient* source_client,
+    FileObjectStoreClient* target_client,
+    bool is_copy) const
+{
+    LOG_INFO("Doing COPY/MOVE between file tiers");
+
+    auto response = HsmObjectStoreResponse::create(request, m_id);
+    try {
+        source_client->migrate(
+            request.object().id(), *target_client, is_copy);
+        do_local_file_metadata_copy_or_move(
+            request, source_client, target_client, is_copy);
+    }
+    catch (const std::exception& e) {
+        const std::string msg =
+            "Failed to copy or move between file tiers: "
+            + std::string(e.what());
+        LOG_ERROR(msg);
+        response->on_error({HsmObjectStoreErrorCode::ERROR, msg});
+    }
+    return response;
+}
+
+void DistributedHsmObjectStoreClient::do_local_file_metadata_copy_or_move(
+    const HsmObjectStoreRequest& request,
+    FileObjectStoreClient* source_client,
+    FileObjectStoreClient* target_client,
+    bool is_copy) const
+{
+    // Migrating the data only carries metadata when both tier stores keep
+    // it - file hsm clients keep metadata in a store of their own
+    auto source_metadata = get_file_metadata_client(request.source_tier());
+    auto target_metadata = get_file_metadata_client(request.target_tier());
+    if (source_metadata == target_metadata
+        || (source_metadata == source_client
+            && target_metadata == target_client)) {
+        return;
+    }
+
+    if (source_metadata != nullptr && target_metadata != nullptr) {
+        source_metadata->migrate(
+            request.object().id(), *target_metadata, is_copy);
+        return;
+    }
+
+    ObjectStoreResponse::Ptr response;
+    if (target_metadata != nullptr) {
+        // As with a stream copy the target gets the request's metadata
+        HsmObjectStoreRequest put_request(
+            request.object(), HsmObjectStoreRequestMethod::PUT);
+        response = target_metadata->make_request(
+            HsmObjectStoreRequest::to_base_request(put_request));
+    }
+    else if (!is_copy) {
+        HsmObjectStoreRequest remove_request(
+            request.object().id(), HsmObjectStoreRequestMethod::REMOVE);
+        response = source_metadata->make_request(
+            HsmObjectStoreRequest::to_base_request(remove_request));
+    }
+    if (response && !response->ok()) {
+        throw std::runtime_error(
+            "Failed to copy or move metadata: "
+            + response->get_error().to_string());
+    }
+}
+
+FileObjectStoreClient* DistributedHsmObjectStoreClient::get_file_client(
+    uint8_t tier) const
+{
+    if (auto hsm_client = m_client_manager->get_hsm_client(tier);
+        hsm_client != nullptr) {
+        if (auto file_hsm_client =
+                dynamic_cast<FileHsmObjectStoreClient*>(hsm_client)) {
+            return file_hsm_client->get_tier_client(tier);
+        }
+        return nullptr;
+    }
+    return dynamic_cast<FileObjectStoreClient*>(
+        m_client_manager->get_client(tier));
+}
+
+FileObjectStoreClient*
+DistributedHsmObjectStoreClient::get_file_metadata_client(uint8_t tier) const
+{
+    if (auto hsm_client = m_client_manager->get_hsm_client(tier);
+        hsm_client != nullptr) {
+        if (auto file_hsm_client =
+                dynamic_cast<FileHsmObjectStoreClient*>(hsm_client)) {
+            return file_hsm_client->get_metadata_client();
+        }
+        return nullptr;
+    }
+    auto file_client = dynamic_cast<FileObjectStoreClient*>(
+        m_client_manager->get_client(tier));
+    if (file_client != nullptr && file_client->needs_metadata()) {
+        return file_client;
+    }
+    return nullptr;
+}
+
 HsmObjectStoreResponse::Ptr
 DistributedHsmObjectStoreClient::do_remote_copy_or_move_with_local_source(
     const HsmObjectStoreRequest& request, bool is_copy) const
@@ -507,7 +645,7 @@ DistributedHsmObjectStoreClient::do_remote_copy_or_move_with_local_target(
 
     HsmObjectStoreResponse::Ptr put_response;
     HsmObjectStoreRequest put_request(
-        request.object().id(), HsmObjectStoreRequestMethod::PUT);
+        request.object(), HsmObjectStoreRequestMethod::PUT);
     put_request.set_target_tier(request.target_tier());
     put_request.set_extent(request.extent());
 
@@ -11,10 +11,12 @@ class HttpClient;
 class S3Client;
 class HsmObjectStoreClientManager;
 class DistributedHsmService;
+class FileObjectStoreClient;
 
 class DistributedHsmObjectStoreClientConfig {
   public:
-    std::size_t m_buffer_size{4096};
+    std::size_t m_buffer_size{1024 * 1024};
+    std::size_t m_num_buffers{2};
 };
 
 class DistributedHsmObjectStoreClient : public HsmObjectStoreClient {
@@ -41,6 +43,9 @@ class DistributedHsmObjectStoreClient : public HsmObjectStoreClient {
         const HsmObjectStoreRequest& request,
         Stream* stream = nullptr) const noexcept override;
 
+    std::vector<std::string> get_eviction_candidates(
+        const HsmObjectStoreRequest& request) const override;
+
   private:
     HsmObjectStoreResponse::Ptr do_remote_get(
         const HsmObjectStoreRequest& request, Stream* stream) const;
@@ -62,6 +67,22 @@ class DistributedHsmObjectStoreClient : public HsmObjectStoreClient {
     HsmObjectStoreResponse::Ptr do_local_copy_or_move(
         const HsmObjectStoreRequest& request, bool is_copy) const;
 
+    HsmObjectStoreResponse::Ptr do_local_file_copy_or_move(
+        const HsmObjectStoreRequest& request,
+        FileObjectStoreClient* source_client,
+        FileObjectStoreClient* target_client,
+        bool is_copy) const;
+
+    void do_local_file_metadata_copy_or_move(
+        const HsmObjectStoreRequest& request,
+        FileObjectStoreClient* source_client,
+        FileObjectStoreClient* target_client,
+        bool is_copy) const;
+
+    FileObjectStoreClient* get_file_client(uint8_t tier) const;
+
+    FileObjectStoreClient* get_file_metadata_client(uint8_t tier) const;
+
     HsmObjectStoreResponse::Ptr do_remote_copy_or_move_with_local_source(
         const HsmObjectStoreRequest& request, bool is_copy) const;
 
@@ -28,8 +28,8 @@ void S3DatasetAdapter::on_list_buckets(
     const VecModelPtr& items, S3ListBucketResponse& list_bucket_response)
 {
     for (const auto& dataset : items) {
-        const auto timestamp =
-            TimeUtils::to_iso8601_basic(dataset->get_creation_time());
+        const auto timestamp = TimeUtils::to_iso8601_basic(
+            TimeUtils::to_seconds(dataset->get_creation_time()));
         list_bucket_response.m_buckets.push_back(
             {dataset->name(), S3Timestamp(timestamp)});
     }
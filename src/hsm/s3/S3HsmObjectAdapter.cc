@@ -38,8 +38,8 @@ void S3HsmObjectAdapter::on_list_objects(
         S3Object s3_object;
         s3_object.m_bucket = dataset.name();
         s3_object.m_key    = object.name();
-        s3_object.m_last_modified =
-            TimeUtils::to_iso8601_basic(object.get_last_modified_time());
+        s3_object.m_last_modified = TimeUtils::to_iso8601_basic(
+            TimeUtils::to_seconds(object.get_last_modified_time()));
         s3_object.m_size = object.size();
         list_objects_response.m_contents.push_back(s3_object);
     }
@@ -0,0 +1,84 @@
+#include <benchmark/benchmark.h>
+
+#include "BlockList.h"
+#include "BlockStore.h"
+
+#include <sstream>
+#include <thread>
+#include <vector>
+
+static constexpr std::size_t object_size{16 * 1024 * 1024};
+
+// Arg: chunk size - the object is written as a run of chunks
+static void BM_block_list_write(benchmark::State& state)
+{
+    const auto chunk_size = static_cast<std::size_t>(state.range(0));
+
+    std::vector<char> chunk(chunk_size, 'a');
+    for (auto _ : state) {
+        hestia::BlockList block_list;
+        for (std::size_t offset = 0; offset < object_size;
+             offset += chunk_size) {
+            block_list.write(
+                hestia::Extent(offset, chunk_size),
+                hestia::ReadableBufferView(chunk));
+        }
+        benchmark::DoNotOptimize(block_list);
+    }
+    state.SetBytesProcessed(state.iterations() * object_size);
+}
+BENCHMARK(BM_block_list_write)
+    ->RangeMultiplier(16)
+    ->Range(4096, 1024 * 1024)
+    ->Unit(benchmark::kMillisecond);
+
+// Arg: chunk size - the object is read back as a run of chunks
+static void BM_block_list_read(benchmark::State& state)
+{
+    const auto chunk_size = static_cast<std::size_t>(state.range(0));
+
+    std::vector<char> content(object_size, 'a');
+    hestia::BlockList block_list;
+    block_list.write(
+        hestia::Extent(0, object_size), hestia::ReadableBufferView(content));
+
+    std::vector<char> chunk(chunk_size);
+    for (auto _ : state) {
+        for (std::size_t offset = 0; offset < object_size;
+             offset += chunk_size) {
+            hestia::WriteableBufferView buffer(chunk);
+            block_list.read(hestia::Extent(offset, chunk_size), buffer);
+        }
+        benchmark::DoNotOptimize(chunk.data());
+    }
+    state.SetBytesProcessed(state.iterations() * object_size);
+}
+BENCHMARK(BM_block_list_read)
+    ->RangeMultiplier(16)
+    ->Range(4096, 1024 * 1024)
+    ->Unit(benchmark::kMillisecond);
+
+// Threads each put, get and remove their own object in a shared store
+static void BM_block_store_put_get(benchmark::State& state)
+{
+    static constexpr std::size_t store_object_size{1024 * 1024};
+    static hestia::BlockStore store;
+
+    std::stringstream key;
+    key << std::this_thread::get_id();
+
+    std::vector<char> content(store_object_size, 'a');
+    std::vector<char> read_content(store_object_size);
+    for (auto _ : state) {
+        (void)store.write(
+            key.str(), hestia::Extent(0, store_object_size),
+            hestia::ReadableBufferView(content));
+
+        hestia::WriteableBufferView buffer(read_content);
+        (void)store.read(
+            key.str(), hestia::Extent(0, store_object_size), buffer);
+        store.remove(key.str());
+    }
+    state.SetBytesProcessed(state.iterations() * 2 * store_object_size);
+}
+BENCHMARK(BM_block_store_put_get)->ThreadRange(1, 8)->UseRealTime();
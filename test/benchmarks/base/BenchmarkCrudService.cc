@@ -0,0 +1,110 @@
+#include <benchmark/benchmark.h>
+
+#include "MockCrudService.h"
+
+#include <map>
+
+using ServiceCache = std::map<std::size_t, hestia::mock::MockCrudService::Ptr>;
+
+/**
+ * Services are slow to fill at the larger sizes, so one is kept per size
+ * and reused across runs. Creates go to their own services so the read and
+ * list sizes stay fixed.
+ */
+static hestia::mock::MockCrudService* get_populated_service(
+    ServiceCache& cache, std::size_t num_items)
+{
+    auto& service = cache[num_items];
+    if (!service) {
+        service = hestia::mock::MockCrudService::create();
+        for (std::size_t idx = 0; idx < num_items; idx++) {
+            (void)service->make_request(hestia::CrudRequest{
+                hestia::CrudMethod::CREATE,
+                {},
+                {},
+                hestia::CrudQuery::OutputFormat::ID});
+        }
+    }
+    return service.get();
+}
+
+static ServiceCache read_services;
+static ServiceCache create_services;
+
+// Arg: number of items already in the service
+static void BM_crud_create(benchmark::State& state)
+{
+    auto service = get_populated_service(
+        create_services, static_cast<std::size_t>(state.range(0)));
+
+    for (auto _ : state) {
+        const auto response = service->make_request(hestia::CrudRequest{
+            hestia::CrudMethod::CREATE,
+            {},
+            {},
+            hestia::CrudQuery::OutputFormat::ITEM});
+        if (!response->ok()) {
+            state.SkipWithError("Create failed");
+            break;
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// Arg: number of items in the service
+static void BM_crud_read(benchmark::State& state)
+{
+    const auto num_items = static_cast<std::size_t>(state.range(0));
+
+    auto service = get_populated_service(read_services, num_items);
+
+    std::size_t count{0};
+    for (auto _ : state) {
+        const hestia::CrudQuery query(
+            hestia::CrudIdentifier(std::to_string(count++ % num_items + 1)),
+            hestia::CrudQuery::OutputFormat::ITEM);
+        const auto response =
+            service->make_request(hestia::CrudRequest{query, {}});
+        if (!response->ok() || !response->found()) {
+            state.SkipWithError("Read failed");
+            break;
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// Args: number of items in the service, page size
+static void BM_crud_list(benchmark::State& state)
+{
+    const auto num_items = static_cast<std::size_t>(state.range(0));
+    const auto page_size = static_cast<std::size_t>(state.range(1));
+
+    auto service = get_populated_service(read_services, num_items);
+
+    std::size_t offset{0};
+    for (auto _ : state) {
+        hestia::CrudQuery query(hestia::CrudQuery::OutputFormat::ITEM);
+        query.set_offset(offset);
+        query.set_count(page_size);
+        const auto response =
+            service->make_request(hestia::CrudRequest{query, {}});
+        if (!response->ok()) {
+            state.SkipWithError("List failed");
+            break;
+        }
+        offset = (offset + page_size) % num_items;
+    }
+    state.SetItemsProcessed(state.iterations() * page_size);
+}
+
+BENCHMARK(BM_crud_create)
+    ->RangeMultiplier(10)
+    ->Range(1000, 1000000)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_crud_read)
+    ->RangeMultiplier(10)
+    ->Range(1000, 1000000)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_crud_list)
+    ->ArgsProduct({benchmark::CreateRange(1000, 1000000, 10), {100}})
+    ->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,323 @@
+#include <benchmark/benchmark.h>
+
+#include "BasicHttpServer.h"
+#ifdef HAVE_PROXYGEN
+#include "ProxygenServer.h"
+#endif
+
+#include "MockWebService.h"
+#include "MockWebView.h"
+#include "UrlRouter.h"
+
+#include "InMemoryKeyValueStoreClient.h"
+#include "UserService.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cctype>
+#include <functional>
+#include <memory>
+
+class BenchmarkWebApp : public hestia::WebApp {
+  public:
+    BenchmarkWebApp(hestia::UserService* user_service) :
+        hestia::WebApp(user_service)
+    {
+        m_url_router = std::make_unique<hestia::UrlRouter>();
+        m_url_router->add_pattern(
+            {"/"}, std::make_unique<hestia::mock::MockWebView>(&m_service));
+    }
+
+  private:
+    hestia::mock::MockWebService m_service;
+};
+
+/**
+ * Keep-alive client writing raw requests and reading back responses framed
+ * by their content-length. Reconnects when the server closes on it.
+ */
+class HttpLoadClient {
+  public:
+    HttpLoadClient(const std::string& ip, int port)
+    {
+        m_address.sin_family = AF_INET;
+        m_address.sin_port   = htons(port);
+        ::inet_aton(ip.c_str(), &m_address.sin_addr);
+    }
+
+    ~HttpLoadClient() { disconnect(); }
+
+    bool request(const std::string& message, std::size_t& body_size)
+    {
+        for (std::size_t attempt = 0; attempt < 2; attempt++) {
+            if (m_handle == -1 && !connect()) {
+                return false;
+            }
+            if (send_all(message) && read_response(body_size)) {
+                return true;
+            }
+            disconnect();
+        }
+        return false;
+    }
+
+  private:
+    bool connect()
+    {
+        m_handle = ::socket(AF_INET, SOCK_STREAM, 0);
+        timeval timeout{5, 0};
+        ::setsockopt(
+            m_handle, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+        if (::connect(m_handle, (sockaddr*)&m_address, sizeof(m_address))
+            != 0) {
+            disconnect();
+            return false;
+        }
+        m_buffer.clear();
+        return true;
+    }
+
+    void disconnect()
+    {
+        if (m_handle != -1) {
+            ::close(m_handle);
+            m_handle = -1;
+        }
+    }
+
+    bool send_all(const std::string& message)
+    {
+        std::size_t num_written{0};
+        while (num_written < message.size()) {
+            const auto count = ::write(
+                m_handle, message.data() + num_written,
+                message.size() - num_written);
+            if (count <= 0) {
+                return false;
+            }
+            num_written += count;
+        }
+        return true;
+    }
+
+    bool fill()
+    {
+        char chunk[64 * 1024];
+        const auto count = ::read(m_handle, chunk, sizeof(chunk));
+        if (count <= 0) {
+            return false;
+        }
+        m_buffer.append(chunk, count);
+        return true;
+    }
+
+    bool find_header_end(std::size_t& header_end, std::size_t& separator_size)
+    {
+        header_end = std::string::npos;
+        for (const std::string separator : {"\r\n\r\n", "\n\n"}) {
+            if (const auto pos = m_buffer.find(separator); pos < header_end) {
+                header_end     = pos;
+                separator_size = separator.size();
+            }
+        }
+        return header_end != std::string::npos;
+    }
+
+    bool read_response(std::size_t& body_size)
+    {
+        // The basic server ends lines with a bare '\n'
+        std::size_t header_end{0};
+        std::size_t separator_size{0};
+        while (!find_header_end(header_end, separator_size)) {
+            if (!fill()) {
+                return false;
+            }
+        }
+
+        auto header = m_buffer.substr(0, header_end);
+        std::transform(
+            header.begin(), header.end(), header.begin(), [](char c) {
+                return static_cast<char>(std::tolower(c));
+            });
+        if (header.rfind("http/1.1 2", 0) != 0) {
+            return false;
+        }
+
+        body_size = 0;
+        if (const auto pos = header.find("content-length:");
+            pos != std::string::npos) {
+            body_size = std::stoull(header.substr(pos + 15));
+        }
+
+        const auto response_size = header_end + separator_size + body_size;
+        while (m_buffer.size() < response_size) {
+            if (!fill()) {
+                return false;
+            }
+        }
+        m_buffer.erase(0, response_size);
+
+        if (header.find("connection:close") != std::string::npos
+            || header.find("connection: close") != std::string::npos) {
+            disconnect();
+        }
+        return true;
+    }
+
+    sockaddr_in m_address{};
+    int m_handle{-1};
+    std::string m_buffer;
+};
+
+static std::string make_put_request(std::size_t size)
+{
+    return "PUT / HTTP/1.1\r\nContent-Length: " + std::to_string(size)
+           + "\r\n\r\n" + std::string(size, 'a');
+}
+
+static const std::string get_request{"GET / HTTP/1.1\r\n\r\n"};
+
+using ServerFactory = std::function<std::unique_ptr<hestia::Server>(
+    const hestia::Server::Config&, hestia::WebApp*)>;
+
+/**
+ * Server running for the life of the process, shared by every thread of a
+ * benchmark. Each server backs a single mock object - the get servers have
+ * it set once up front so concurrent reads don't race with writes.
+ */
+class BenchmarkServer {
+  public:
+    BenchmarkServer(
+        const ServerFactory& factory, int port, std::size_t seeded_size = 0)
+    {
+        hestia::KeyValueStoreCrudServiceBackend backend(&m_kv_store_client);
+        m_user_service = hestia::UserService::create({}, &backend);
+        m_web_app = std::make_unique<BenchmarkWebApp>(m_user_service.get());
+
+        m_config.m_http_port                   = port;
+        m_config.m_max_requests_per_connection = 1000000;
+        m_server = factory(m_config, m_web_app.get());
+        m_server->initialize();
+        m_server->start();
+        m_server->wait_until_bound();
+
+        if (seeded_size > 0) {
+            HttpLoadClient client(m_config.m_ip, port);
+            std::size_t body_size{0};
+            client.request(make_put_request(seeded_size), body_size);
+        }
+    }
+
+    ~BenchmarkServer() { m_server->stop(); }
+
+    const hestia::Server::Config& config() const { return m_config; }
+
+  private:
+    hestia::Server::Config m_config;
+    hestia::InMemoryKeyValueStoreClient m_kv_store_client;
+    std::unique_ptr<hestia::UserService> m_user_service;
+    std::unique_ptr<BenchmarkWebApp> m_web_app;
+    std::unique_ptr<hestia::Server> m_server;
+};
+
+using ServerGetter = BenchmarkServer& (*)();
+
+static constexpr std::size_t get_body_size{4096};
+
+template<typename ServerT>
+static std::unique_ptr<hestia::Server> make_server(
+    const hestia::Server::Config& config, hestia::WebApp* web_app)
+{
+    return std::make_unique<ServerT>(config, web_app);
+}
+
+// Function-local so only the benchmarks picked by a filter start servers
+static BenchmarkServer& get_basic_get_server()
+{
+    static BenchmarkServer server(
+        make_server<hestia::BasicHttpServer>, 8190, get_body_size);
+    return server;
+}
+
+static BenchmarkServer& get_basic_put_server()
+{
+    static BenchmarkServer server(make_server<hestia::BasicHttpServer>, 8191);
+    return server;
+}
+
+#ifdef HAVE_PROXYGEN
+static BenchmarkServer& get_proxygen_get_server()
+{
+    static BenchmarkServer server(
+        make_server<hestia::ProxygenServer>, 8192, get_body_size);
+    return server;
+}
+
+static BenchmarkServer& get_proxygen_put_server()
+{
+    static BenchmarkServer server(make_server<hestia::ProxygenServer>, 8193);
+    return server;
+}
+#endif
+
+// Run with several threads, each with its own connection
+static void BM_http_get(benchmark::State& state, ServerGetter get_server)
+{
+    const auto& config = get_server().config();
+    HttpLoadClient client(config.m_ip, config.m_http_port);
+
+    std::size_t body_size{0};
+    for (auto _ : state) {
+        if (!client.request(get_request, body_size)) {
+            state.SkipWithError("Get request failed");
+            break;
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * body_size);
+    state.counters["requests"] = benchmark::Counter(
+        static_cast<double>(state.iterations()), benchmark::Counter::kIsRate);
+}
+
+// Arg: body size
+static void BM_http_put(benchmark::State& state, ServerGetter get_server)
+{
+    const auto& config = get_server().config();
+    HttpLoadClient client(config.m_ip, config.m_http_port);
+    const auto request =
+        make_put_request(static_cast<std::size_t>(state.range(0)));
+
+    std::size_t body_size{0};
+    for (auto _ : state) {
+        if (!client.request(request, body_size)) {
+            state.SkipWithError("Put request failed");
+            break;
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+    state.counters["requests"] = benchmark::Counter(
+        static_cast<double>(state.iterations()), benchmark::Counter::kIsRate);
+}
+
+BENCHMARK_CAPTURE(BM_http_get, basic, get_basic_get_server)
+    ->ThreadRange(1, 8)
+    ->UseRealTime();
+BENCHMARK_CAPTURE(BM_http_put, basic, get_basic_put_server)
+    ->RangeMultiplier(16)
+    ->Range(1024, 1024 * 1024)
+    ->UseRealTime();
+
+#ifdef HAVE_PROXYGEN
+BENCHMARK_CAPTURE(BM_http_get, proxygen, get_proxygen_get_server)
+    ->ThreadRange(1, 8)
+    ->UseRealTime();
+BENCHMARK_CAPTURE(BM_http_put, proxygen, get_proxygen_put_server)
+    ->RangeMultiplier(16)
+    ->Range(1024, 1024 * 1024)
+    ->UseRealTime();
+#endif
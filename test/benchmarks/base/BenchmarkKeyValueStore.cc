@@ -0,0 +1,150 @@
+#include <benchmark/benchmark.h>
+
+#include "FileKeyValueStoreClient.h"
+#include "InMemoryKeyValueStoreClient.h"
+#ifdef TEST_REDIS
+#include "RedisKeyValueStoreClient.h"
+#endif
+
+#include "TestUtils.h"
+
+#include <filesystem>
+#include <functional>
+#include <memory>
+
+using ClientFactory =
+    std::function<std::unique_ptr<hestia::KeyValueStoreClient>()>;
+
+static std::unique_ptr<hestia::KeyValueStoreClient> make_memory_client()
+{
+    return std::make_unique<hestia::InMemoryKeyValueStoreClient>();
+}
+
+static std::unique_ptr<hestia::KeyValueStoreClient> make_file_client()
+{
+    const auto root =
+        TestUtils::get_test_output_dir(__FILE__) / "file_kv_store";
+    std::filesystem::remove_all(root);
+
+    auto client = std::make_unique<hestia::FileKeyValueStoreClient>();
+    hestia::FileKeyValueStoreClientConfig config;
+    config.m_root.update_value(root.string());
+    client->do_initialize({}, config);
+    return client;
+}
+
+#ifdef TEST_REDIS
+static std::unique_ptr<hestia::KeyValueStoreClient> make_redis_client()
+{
+    auto client = std::make_unique<hestia::RedisKeyValueStoreClient>();
+    hestia::RedisKeyValueStoreClientConfig config;
+    client->do_initialize({}, config);
+    return client;
+}
+#endif
+
+static std::string get_key(std::size_t idx)
+{
+    return "hestia:benchmark:object:" + std::to_string(idx);
+}
+
+// A typical serialized item is a few hundred bytes of json
+static const std::string item_value(400, 'v');
+
+static void populate(
+    hestia::KeyValueStoreClient* client, std::size_t num_keys)
+{
+    hestia::VecKeyValuePair pairs;
+    for (std::size_t idx = 0; idx < num_keys; idx++) {
+        pairs.emplace_back(get_key(idx), item_value);
+        if (pairs.size() == 1000 || idx + 1 == num_keys) {
+            (void)client->make_request(
+                {hestia::KeyValueStoreRequestMethod::STRING_SET, pairs});
+            pairs.clear();
+        }
+    }
+}
+
+// Arg: batch size - number of keys set per request
+static void BM_kv_string_set(benchmark::State& state, ClientFactory factory)
+{
+    const auto batch_size = static_cast<std::size_t>(state.range(0));
+    auto client           = factory();
+
+    std::size_t count{0};
+    for (auto _ : state) {
+        hestia::VecKeyValuePair pairs;
+        for (std::size_t idx = 0; idx < batch_size; idx++) {
+            pairs.emplace_back(get_key(count++), item_value);
+        }
+        auto response = client->make_request(
+            {hestia::KeyValueStoreRequestMethod::STRING_SET, pairs});
+        if (!response->ok()) {
+            state.SkipWithError("String set failed");
+            break;
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * batch_size);
+}
+
+// Arg: number of keys in the store
+static void BM_kv_string_get(benchmark::State& state, ClientFactory factory)
+{
+    const auto num_keys = static_cast<std::size_t>(state.range(0));
+    auto client         = factory();
+    populate(client.get(), num_keys);
+
+    std::size_t count{0};
+    for (auto _ : state) {
+        auto response = client->make_request(
+            {hestia::KeyValueStoreRequestMethod::STRING_GET,
+             std::vector<std::string>{get_key(count++ % num_keys)}});
+        if (!response->ok() || response->items().size() != 1) {
+            state.SkipWithError("String get failed");
+            break;
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// Arg: number of entries in the set
+static void BM_kv_set_list(benchmark::State& state, ClientFactory factory)
+{
+    const auto num_entries = static_cast<std::size_t>(state.range(0));
+    auto client            = factory();
+
+    hestia::VecKeyValuePair entries;
+    for (std::size_t idx = 0; idx < num_entries; idx++) {
+        entries.emplace_back("hestia:benchmark:objects", get_key(idx));
+    }
+    (void)client->make_request(
+        {hestia::KeyValueStoreRequestMethod::SET_ADD, entries});
+
+    for (auto _ : state) {
+        auto response = client->make_request(
+            {hestia::KeyValueStoreRequestMethod::SET_LIST,
+             std::vector<std::string>{"hestia:benchmark:objects"}});
+        if (!response->ok()) {
+            state.SkipWithError("Set list failed");
+            break;
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * num_entries);
+}
+
+#define KV_BENCHMARKS(name, factory)                                           \
+    BENCHMARK_CAPTURE(BM_kv_string_set, name, factory)                         \
+        ->RangeMultiplier(10)                                                  \
+        ->Range(1, 1000);                                                      \
+    BENCHMARK_CAPTURE(BM_kv_string_get, name, factory)                         \
+        ->RangeMultiplier(10)                                                  \
+        ->Range(1000, 100000);                                                 \
+    BENCHMARK_CAPTURE(BM_kv_set_list, name, factory)                           \
+        ->RangeMultiplier(10)                                                  \
+        ->Range(10, 10000);
+
+KV_BENCHMARKS(memory, make_memory_client)
+KV_BENCHMARKS(file, make_file_client)
+#ifdef TEST_REDIS
+KV_BENCHMARKS(redis, make_redis_client)
+#endif
@@ -0,0 +1,29 @@
+#include <benchmark/benchmark.h>
+
+#include "Logger.h"
+
+#include <string>
+
+// The logger is set to WARN in main, so this measures the level check
+static void BM_log_filtered(benchmark::State& state)
+{
+    const std::string path = "/my/object/path";
+    std::size_t offset{0};
+    for (auto _ : state) {
+        LOG_INFO("Writing chunk at " << offset << " of " << path << " done.");
+        offset++;
+    }
+    benchmark::DoNotOptimize(offset);
+}
+BENCHMARK(BM_log_filtered);
+
+static void BM_log_to_file(benchmark::State& state)
+{
+    const std::string path = "/my/object/path";
+    std::size_t offset{0};
+    for (auto _ : state) {
+        LOG_WARN("Writing chunk at " << offset << " of " << path << " done.");
+        offset++;
+    }
+}
+BENCHMARK(BM_log_to_file);
@@ -0,0 +1,34 @@
+#include <benchmark/benchmark.h>
+
+#include "InMemoryStreamSink.h"
+#include "InMemoryStreamSource.h"
+#include "Stream.h"
+
+#include <vector>
+
+static constexpr std::size_t stream_size{16 * 1024 * 1024};
+
+// Args: block size, number of staging buffers
+static void BM_stream_flush(benchmark::State& state)
+{
+    const auto block_size  = static_cast<std::size_t>(state.range(0));
+    const auto num_buffers = static_cast<std::size_t>(state.range(1));
+
+    std::vector<char> source_buffer(stream_size, 'a');
+    std::vector<char> sink_buffer(stream_size);
+    for (auto _ : state) {
+        hestia::Stream stream;
+        stream.set_source(hestia::InMemoryStreamSource::create(
+            hestia::ReadableBufferView(source_buffer)));
+        stream.set_sink(hestia::InMemoryStreamSink::create(
+            hestia::WriteableBufferView(sink_buffer)));
+        if (!stream.flush(block_size, num_buffers).ok()) {
+            state.SkipWithError("Stream flush failed");
+            break;
+        }
+    }
+    state.SetBytesProcessed(state.iterations() * stream_size);
+}
+BENCHMARK(BM_stream_flush)
+    ->ArgsProduct({benchmark::CreateRange(4096, 4 * 1024 * 1024, 8), {1, 2}})
+    ->Unit(benchmark::kMillisecond);
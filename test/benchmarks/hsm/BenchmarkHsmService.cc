@@ -0,0 +1,272 @@
+#include <benchmark/benchmark.h>
+
+#include "HestiaClient.h"
+#include "InMemoryStreamSink.h"
+#include "InMemoryStreamSource.h"
+
+#include "EventFeed.h"
+#include "KeyValueStoreClientFactory.h"
+#include "ObjectStoreBackend.h"
+#include "StorageTier.h"
+
+#include "FileUtils.h"
+#include "TestUtils.h"
+
+#include <memory>
+
+// Tiers 0 and 1 are file backed, 2 and 3 in memory
+static constexpr uint8_t file_tier{0};
+static constexpr uint8_t memory_tier{2};
+
+class BenchmarkHestiaClient : public hestia::HestiaClient {
+  public:
+    // Already set up in main
+    void initialize_logger() const override {}
+};
+
+static std::unique_ptr<hestia::Dictionary> make_backend(
+    hestia::ObjectStoreBackend::Type type,
+    const std::vector<std::string>& tier_names,
+    const std::string& root = {})
+{
+    hestia::ObjectStoreBackend backend(type);
+    backend.set_tier_names(tier_names);
+    if (!root.empty()) {
+        hestia::Dictionary backend_config;
+        backend_config.set_map({{"root", root}});
+        backend.set_config(backend_config);
+    }
+
+    auto backend_dict = std::make_unique<hestia::Dictionary>();
+    backend.serialize(*backend_dict);
+    return backend_dict;
+}
+
+static void get_config(
+    const std::string& cache_path, hestia::Dictionary& config)
+{
+    auto cache_path_dict = hestia::Dictionary::create(
+        hestia::Dictionary::Type::SCALAR);
+    cache_path_dict->set_scalar(cache_path);
+
+    hestia::KeyValueStoreClientConfig kv_config;
+    kv_config.set_client_type(hestia::KeyValueStoreClientConfig::Type::MEMORY);
+    auto kv_config_dict = std::make_unique<hestia::Dictionary>();
+    kv_config.serialize(*kv_config_dict);
+
+    hestia::EventFeedConfig event_feed_config;
+    event_feed_config.set_is_active(false);
+    auto event_feed_dict = std::make_unique<hestia::Dictionary>();
+    event_feed_config.serialize(*event_feed_dict);
+
+    auto tiers = hestia::Dictionary::create(hestia::Dictionary::Type::SEQUENCE);
+    for (uint8_t idx = 0; idx < 4; idx++) {
+        hestia::StorageTier tier(idx);
+        auto tier_dict = std::make_unique<hestia::Dictionary>();
+        tier.serialize(*tier_dict);
+        tiers->add_sequence_item(std::move(tier_dict));
+    }
+
+    auto backends =
+        hestia::Dictionary::create(hestia::Dictionary::Type::SEQUENCE);
+    backends->add_sequence_item(make_backend(
+        hestia::ObjectStoreBackend::Type::FILE_HSM, {"0", "1"},
+        cache_path + "/hsm_object_store"));
+    backends->add_sequence_item(make_backend(
+        hestia::ObjectStoreBackend::Type::MEMORY_HSM, {"2", "3"}));
+
+    config.set_map_item("cache_path", std::move(cache_path_dict));
+    config.set_map_item(
+        hestia::KeyValueStoreClientConfig::get_type(),
+        std::move(kv_config_dict));
+    config.set_map_item(
+        hestia::EventFeedConfig::get_type(), std::move(event_feed_dict));
+    config.set_map_item(
+        hestia::StorageTier::get_type() + "s", std::move(tiers));
+    config.set_map_item(
+        hestia::ObjectStoreBackend::get_type() + "s", std::move(backends));
+}
+
+static BenchmarkHestiaClient* get_client()
+{
+    static std::unique_ptr<BenchmarkHestiaClient> client;
+    if (!client) {
+        const auto cache_path =
+            TestUtils::get_test_output_dir(__FILE__) / "hsm_service";
+        hestia::FileUtils::empty_directory(cache_path);
+
+        hestia::Dictionary config;
+        get_config(cache_path, config);
+
+        client = std::make_unique<BenchmarkHestiaClient>();
+        client->initialize({}, {}, config);
+    }
+    return client.get();
+}
+
+static std::string create_object(BenchmarkHestiaClient* client)
+{
+    hestia::VecCrudIdentifier ids;
+    hestia::CrudAttributes attributes;
+    if (!client->create(hestia::HsmItem::Type::OBJECT, ids, attributes).ok()
+        || ids.empty()) {
+        return {};
+    }
+    return ids[0].get_primary_key();
+}
+
+static bool put_object(
+    BenchmarkHestiaClient* client,
+    const std::string& id,
+    uint8_t tier,
+    const std::vector<char>& content)
+{
+    hestia::Stream stream;
+    stream.set_source(hestia::InMemoryStreamSource::create(
+        hestia::ReadableBufferView(content)));
+
+    hestia::HsmAction action(
+        hestia::HsmItem::Type::OBJECT, hestia::HsmAction::Action::PUT_DATA);
+    action.set_subject_key(id);
+    action.set_target_tier(tier);
+    action.set_size(content.size());
+
+    hestia::OpStatus status;
+    client->do_data_io_action(
+        action, &stream,
+        [&status](hestia::OpStatus ret_status, const hestia::HsmAction&) {
+            status = ret_status;
+        });
+    return stream.flush().ok() && status.ok();
+}
+
+static bool get_object(
+    BenchmarkHestiaClient* client,
+    const std::string& id,
+    uint8_t tier,
+    std::vector<char>& buffer)
+{
+    hestia::Stream stream;
+    stream.set_sink(hestia::InMemoryStreamSink::create(
+        hestia::WriteableBufferView(buffer)));
+
+    hestia::HsmAction action(
+        hestia::HsmItem::Type::OBJECT, hestia::HsmAction::Action::GET_DATA);
+    action.set_subject_key(id);
+    action.set_source_tier(tier);
+    action.set_size(buffer.size());
+
+    hestia::OpStatus status;
+    client->do_data_io_action(
+        action, &stream,
+        [&status](hestia::OpStatus ret_status, const hestia::HsmAction&) {
+            status = ret_status;
+        });
+    return stream.flush().ok() && status.ok();
+}
+
+static bool move_object(
+    BenchmarkHestiaClient* client,
+    const std::string& id,
+    hestia::HsmAction::Action method,
+    uint8_t source_tier,
+    uint8_t target_tier = 0)
+{
+    hestia::HsmAction action(hestia::HsmItem::Type::OBJECT, method);
+    action.set_subject_key(id);
+    action.set_source_tier(source_tier);
+    action.set_target_tier(target_tier);
+    return client->do_data_movement_action(action).ok();
+}
+
+// Args: tier, object size
+static void BM_hsm_put(benchmark::State& state)
+{
+    const auto tier = static_cast<uint8_t>(state.range(0));
+    const std::vector<char> content(static_cast<std::size_t>(state.range(1)));
+    auto client = get_client();
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        const auto id = create_object(client);
+        state.ResumeTiming();
+
+        if (!put_object(client, id, tier, content)) {
+            state.SkipWithError("Put failed");
+            break;
+        }
+
+        // Keep the memory tier from growing over the run
+        state.PauseTiming();
+        move_object(client, id, hestia::HsmAction::Action::RELEASE_DATA, tier);
+        state.ResumeTiming();
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(1));
+}
+
+// Args: tier, object size
+static void BM_hsm_get(benchmark::State& state)
+{
+    const auto tier = static_cast<uint8_t>(state.range(0));
+    std::vector<char> buffer(static_cast<std::size_t>(state.range(1)));
+    auto client = get_client();
+
+    const auto id = create_object(client);
+    if (!put_object(client, id, tier, buffer)) {
+        state.SkipWithError("Put failed");
+        return;
+    }
+
+    for (auto _ : state) {
+        if (!get_object(client, id, tier, buffer)) {
+            state.SkipWithError("Get failed");
+            break;
+        }
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(1));
+
+    move_object(client, id, hestia::HsmAction::Action::RELEASE_DATA, tier);
+}
+
+// Arg: object size - moved back and forth between a file and memory tier
+static void BM_hsm_move(benchmark::State& state)
+{
+    const std::vector<char> content(static_cast<std::size_t>(state.range(0)));
+    auto client = get_client();
+
+    const auto id = create_object(client);
+    if (!put_object(client, id, file_tier, content)) {
+        state.SkipWithError("Put failed");
+        return;
+    }
+
+    uint8_t source_tier{file_tier};
+    uint8_t target_tier{memory_tier};
+    for (auto _ : state) {
+        if (!move_object(
+                client, id, hestia::HsmAction::Action::MOVE_DATA, source_tier,
+                target_tier)) {
+            state.SkipWithError("Move failed");
+            break;
+        }
+        std::swap(source_tier, target_tier);
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+
+    move_object(
+        client, id, hestia::HsmAction::Action::RELEASE_DATA, source_tier);
+}
+
+BENCHMARK(BM_hsm_put)
+    ->ArgsProduct(
+        {{file_tier, memory_tier}, {4096, 1024 * 1024, 16 * 1024 * 1024}})
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_hsm_get)
+    ->ArgsProduct(
+        {{file_tier, memory_tier}, {4096, 1024 * 1024, 16 * 1024 * 1024}})
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_hsm_move)
+    ->Arg(4096)
+    ->Arg(1024 * 1024)
+    ->Arg(16 * 1024 * 1024)
+    ->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,32 @@
+#include <benchmark/benchmark.h>
+
+#include "Logger.h"
+
+#include "ProxygenTestUtils.h"
+#include "TestUtils.h"
+
+#include <filesystem>
+
+int main(int argc, char* argv[])
+{
+    const auto output_dir = TestUtils::get_test_output_dir() / "benchmarks";
+    std::filesystem::create_directories(output_dir);
+
+    // Warnings and errors go to file, as in a deployment - so the cost of
+    // the filtered-out info logging on the data path is included.
+    hestia::LoggerConfig logger_config;
+    logger_config.set_level(hestia::LoggerConfig::Level::WARN);
+    logger_config.set_log_path("hestia_benchmarks");
+    hestia::Logger::get_instance().do_initialize(output_dir, logger_config);
+
+    ProxygenTestContext proxygen_context;
+    proxygen_context.do_initialize();
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -7,6 +7,11 @@
 #include "InMemoryKeyValueStoreClient.h"
 #include "UserService.h"
 
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
 class TestWebApp : public hestia::WebApp {
   public:
     TestWebApp(hestia::UserService* user_service) : hestia::WebApp(user_service)
@@ -43,4 +48,128 @@ TEST_CASE_METHOD(
     server.initialize();
     server.start();
     server.wait_until_bound();
+}
+
+static std::size_t count_matches(
+    const std::string& content, const std::string& match)
+{
+    std::size_t count{0};
+    for (auto pos = content.find(match); pos != std::string::npos;
+         pos      = content.find(match, pos + match.size())) {
+        count++;
+    }
+    return count;
+}
+
+TEST_CASE_METHOD(
+    TestBasicHttpServerFixture, "Test Basic Http Server Keep Alive", "[server]")
+{
+    hestia::Server::Config test_config;
+    test_config.m_http_port = 8093;
+    hestia::BasicHttpServer server(test_config, m_web_app.get());
+
+    server.initialize();
+    server.start();
+    server.wait_until_bound();
+
+    sockaddr_in serv_addr{};
+    serv_addr.sin_family = AF_INET;
+    serv_addr.sin_port   = htons(test_config.m_http_port);
+    ::inet_aton(test_config.m_ip.c_str(), &serv_addr.sin_addr);
+
+    const auto handle = ::socket(AF_INET, SOCK_STREAM, 0);
+    timeval timeout{5, 0};
+    ::setsockopt(handle, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    REQUIRE(::connect(handle, (sockaddr*)&serv_addr, sizeof(serv_addr)) == 0);
+
+    auto send_all = [handle](const std::string& message) {
+        REQUIRE(
+            ::write(handle, message.c_str(), message.size())
+            == static_cast<ssize_t>(message.size()));
+    };
+
+    // Two pipelined requests in a single write
+    send_all(
+        "PUT / HTTP/1.1\r\nContent-Length: 5\r\n\r\nhello"
+        "GET / HTTP/1.1\r\n\r\n");
+
+    std::string responses;
+    char buffer[1024];
+    while (count_matches(responses, "HTTP/1.1 200") < 2
+           || responses.find("hello") == std::string::npos) {
+        const auto count = ::read(handle, buffer, sizeof(buffer));
+        REQUIRE(count > 0);
+        responses.append(buffer, count);
+    }
+    REQUIRE(count_matches(responses, "connection:keep-alive") == 2);
+    // The streamed GET body is framed by its source size
+    REQUIRE(count_matches(responses, "content-length:5") == 1);
+
+    // The same connection serves a further request then closes on request
+    send_all("GET / HTTP/1.1\r\nConnection: close\r\n\r\n");
+    responses.clear();
+    ssize_t count{0};
+    while ((count = ::read(handle, buffer, sizeof(buffer))) > 0) {
+        responses.append(buffer, count);
+    }
+    REQUIRE(count == 0);
+    REQUIRE(count_matches(responses, "HTTP/1.1 200") == 1);
+    REQUIRE(count_matches(responses, "connection:close") == 1);
+    ::close(handle);
+}
+
+TEST_CASE_METHOD(
+    TestBasicHttpServerFixture,
+    "Test Basic Http Server Large Body",
+    "[server]")
+{
+    hestia::Server::Config test_config;
+    test_config.m_http_port          = 8094;
+    test_config.m_socket_buffer_size = 64 * 1024;
+    hestia::BasicHttpServer server(test_config, m_web_app.get());
+
+    server.initialize();
+    server.start();
+    server.wait_until_bound();
+
+    sockaddr_in serv_addr{};
+    serv_addr.sin_family = AF_INET;
+    serv_addr.sin_port   = htons(test_config.m_http_port);
+    ::inet_aton(test_config.m_ip.c_str(), &serv_addr.sin_addr);
+
+    const auto handle = ::socket(AF_INET, SOCK_STREAM, 0);
+    timeval timeout{5, 0};
+    ::setsockopt(handle, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    REQUIRE(::connect(handle, (sockaddr*)&serv_addr, sizeof(serv_addr)) == 0);
+
+    // Bigger than the socket buffer so the body arrives over several reads
+    std::string body(1024 * 1024 + 7, 0);
+    for (std::size_t idx = 0; idx < body.size(); idx++) {
+        body[idx] = static_cast<char>('a' + idx % 26);
+    }
+    const std::string request = "PUT / HTTP/1.1\r\nContent-Length: "
+                                + std::to_string(body.size()) + "\r\n\r\n"
+                                + body
+                                + "GET / HTTP/1.1\r\nConnection: close\r\n\r\n";
+
+    std::size_t num_written{0};
+    while (num_written < request.size()) {
+        const auto count = ::write(
+            handle, request.data() + num_written, request.size() - num_written);
+        REQUIRE(count > 0);
+        num_written += count;
+    }
+
+    std::string responses;
+    char buffer[4096];
+    ssize_t count{0};
+    while ((count = ::read(handle, buffer, sizeof(buffer))) > 0) {
+        responses.append(buffer, count);
+    }
+    ::close(handle);
+
+    REQUIRE(count == 0);
+    REQUIRE(count_matches(responses, "HTTP/1.1 200") == 2);
+    REQUIRE(responses.size() > body.size());
+    REQUIRE(responses.substr(responses.size() - body.size()) == body);
 }
\ No newline at end of file
@@ -14,8 +14,10 @@
 #include "ProxygenTestUtils.h"
 #include "TestUtils.h"
 
+#include <atomic>
 #include <iostream>
 #include <memory>
+#include <thread>
 
 class TestWebApp : public hestia::WebApp {
   public:
@@ -166,6 +168,39 @@ TEST_CASE_METHOD(
     REQUIRE(reconstructed_response == content);
 }
 
+TEST_CASE_METHOD(
+    TestCurlClientFixture, "Test Curl client - Handle Reuse", "[curl]")
+{
+    const std::string content = "The quick brown fox jumps over the lazy dog.";
+
+    hestia::HttpRequest put_request(m_url, hestia::HttpRequest::Method::PUT);
+    put_request.body() = content;
+    REQUIRE(!m_client->make_request(put_request)->error());
+    REQUIRE(m_client->get_num_idle_handles() == 1);
+
+    std::atomic<std::size_t> num_matched{0};
+    std::vector<std::thread> threads;
+    for (std::size_t idx = 0; idx < 4; idx++) {
+        threads.emplace_back([this, &content, &num_matched]() {
+            hestia::HttpRequest get_request(
+                m_url, hestia::HttpRequest::Method::GET);
+            for (std::size_t count = 0; count < 10; count++) {
+                auto response = m_client->make_request(get_request);
+                if (response->body() == content) {
+                    num_matched++;
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    REQUIRE(num_matched == 40);
+    REQUIRE(m_client->get_num_idle_handles() >= 1);
+    REQUIRE(m_client->get_num_idle_handles() <= 4);
+}
+
 TEST_CASE_METHOD(TestCurlClientFixture, "Test Redirect", "[.curl]")
 {
     run_redirect_server();
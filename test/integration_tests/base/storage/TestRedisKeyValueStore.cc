@@ -78,5 +78,32 @@ TEST_CASE("Test Redis KV store backend", "[integration]")
     REQUIRE_NOTHROW(kv_store.set_remove({{sample_key1, id}}));
     REQUIRE_NOTHROW(kv_store.set_list({sample_key1}, return_values_uuid));
     REQUIRE(return_values_uuid[0].empty());
+    return_values_uuid.clear();
+
+    // Batch tests
+    REQUIRE_NOTHROW(kv_store.string_set(
+        {{sample_key1, json_value}, {sample_key2, uuid_string}}));
+
+    REQUIRE_NOTHROW(kv_store.string_exists(
+        {sample_key1, "", "hestia:object_name:missing", sample_key2}, exists));
+    REQUIRE(exists == std::vector<bool>{true, false, false, true});
+
+    REQUIRE_NOTHROW(kv_store.string_get(
+        {sample_key1, "hestia:object_name:missing", sample_key2},
+        return_value));
+    REQUIRE(
+        return_value == std::vector<std::string>{json_value, "", uuid_string});
+
+    REQUIRE_NOTHROW(kv_store.set_add({{sample_key1, "a"}, {sample_key1, "b"}}));
+    REQUIRE_NOTHROW(kv_store.set_add({{sample_key2, "c"}}));
+    REQUIRE_NOTHROW(
+        kv_store.set_list({sample_key1, sample_key2}, return_values_uuid));
+    REQUIRE(return_values_uuid.size() == 2);
+    REQUIRE(return_values_uuid[0].size() == 2);
+    REQUIRE(return_values_uuid[1].size() == 1);
+
+    REQUIRE_NOTHROW(kv_store.set_remove(
+        {{sample_key1, "a"}, {sample_key1, "b"}, {sample_key2, "c"}}));
+    REQUIRE_NOTHROW(kv_store.string_remove({sample_key1, sample_key2}));
 }
 #endif
@@ -58,6 +58,8 @@ std::string MockModel::get_type()
 void MockModel::init()
 {
     m_name.set_index_scope(BaseField::IndexScope::PARENT);
+    m_creation_time.set_is_secondary_index(true);
+    m_my_field.set_is_secondary_index(true);
     register_scalar_field(&m_my_field);
 }
 
@@ -105,4 +105,47 @@ TEST_CASE("Test Block List Read Operations - Multiple Write", "[blocklist]")
         std::string recontstructed_content(sink.begin(), sink.end());
         REQUIRE(recontstructed_content == "ajklefghi");
     }
-}
\ No newline at end of file
+}
+TEST_CASE("Test BlockList Operations - Across Blocks", "[blocklist]")
+{
+    hestia::BlockList block_list(hestia::BlockAllocator::create(4));
+
+    std::string content = "0123456789";
+    block_list.write({3, content.size()}, hestia::ReadableBufferView(content));
+    REQUIRE(block_list.get_memory_size() == 4 * 4);
+    REQUIRE(block_list.get_extent_bounds() == hestia::Extent(3, 10));
+
+    REQUIRE(block_list.get_num_new_blocks({0, 4}) == 0);
+    REQUIRE(block_list.get_num_new_blocks({14, 4}) == 1);
+
+    std::string overwrite = "abc";
+    block_list.write({11, 3}, hestia::ReadableBufferView(overwrite));
+
+    std::vector<char> sink(8);
+    hestia::WriteableBufferView write_buffer(sink);
+    const auto& [ok, bytes_read] =
+        block_list.read({6, sink.size()}, write_buffer);
+    REQUIRE(ok);
+    REQUIRE(bytes_read == sink.size());
+    REQUIRE(std::string(sink.begin(), sink.end()) == "34567abc");
+
+    SECTION("Copies are independent")
+    {
+        auto copy = block_list;
+        copy.write({3, 1}, hestia::ReadableBufferView(overwrite));
+
+        std::vector<char> original(1);
+        hestia::WriteableBufferView original_buffer(original);
+        REQUIRE(block_list.read({3, 1}, original_buffer).first);
+        REQUIRE(original[0] == '0');
+    }
+
+    SECTION("Reads over a hole fail")
+    {
+        block_list.write({20, 3}, hestia::ReadableBufferView(overwrite));
+        std::vector<char> hole_sink(12);
+        hestia::WriteableBufferView hole_buffer(hole_sink);
+        REQUIRE_FALSE(block_list.read({10, 12}, hole_buffer).first);
+        REQUIRE(block_list.read({20, 3}, hole_buffer).first);
+    }
+}
@@ -34,6 +34,37 @@ TEST_CASE("Test FileUtils - file name/extension", "[common]")
     std::filesystem::remove_all(test_output_dir);
 }
 
+TEST_CASE("Test FileUtils - copy/move", "[common]")
+{
+    auto test_output_dir =
+        TestUtils::get_test_output_dir() / "TestFileUtilsCopyMove";
+    std::filesystem::remove_all(test_output_dir);
+    std::filesystem::create_directories(test_output_dir);
+
+    const std::string content = "The quick brown fox jumps over the lazy dog.";
+    std::ofstream(test_output_dir / "source.txt") << content;
+    std::ofstream(test_output_dir / "copy.txt") << "Content to be replaced";
+
+    hestia::FileUtils::copy_file(
+        test_output_dir / "source.txt", test_output_dir / "copy.txt");
+    REQUIRE(
+        hestia::FileUtils::get_file_size(test_output_dir / "copy.txt")
+        == content.size());
+
+    hestia::FileUtils::move_file(
+        test_output_dir / "copy.txt", test_output_dir / "moved.txt");
+    REQUIRE_FALSE(std::filesystem::exists(test_output_dir / "copy.txt"));
+
+    std::string moved_content;
+    std::getline(std::ifstream(test_output_dir / "moved.txt"), moved_content);
+    REQUIRE(moved_content == content);
+
+    REQUIRE_THROWS(hestia::FileUtils::copy_file(
+        test_output_dir / "missing.txt", test_output_dir / "copy.txt"));
+
+    std::filesystem::remove_all(test_output_dir);
+}
+
 TEST_CASE("Test File- read/write", "[common]")
 {
     std::string test_data = "Testing data 123";
@@ -7,12 +7,44 @@ TEST_CASE("Test Hashing - sha256", "[hash]")
     auto sha256 = hestia::HashUtils::do_sha256("Test");
 }
 
+TEST_CASE("Test Hashing - incremental sha256", "[hash]")
+{
+    const std::string data = "The quick brown fox jumps over the lazy dog.";
+
+    hestia::EvpHasher hasher(hestia::HashUtils::sha256_digest());
+    hasher.update(data.data(), 10);
+    hasher.update(data.data() + 10, data.size() - 10);
+    REQUIRE(hasher.finish() == hestia::HashUtils::do_sha256(data));
+
+    // Finishing starts a new hash
+    REQUIRE(hasher.finish() == hestia::HashUtils::do_sha256(""));
+}
+
+TEST_CASE("Test Hashing - incremental md5", "[hash]")
+{
+    const std::string data = "The quick brown fox jumps over the lazy dog.";
+
+    hestia::EvpHasher hasher(hestia::HashUtils::md5_digest());
+    hasher.update(data.data(), 10);
+    hasher.update(data.data() + 10, data.size() - 10);
+    REQUIRE(hasher.finish() == "e4d909c290d0fb1ca068ffaddf22cbd0");
+    REQUIRE(hasher.finish() == "d41d8cd98f00b204e9800998ecf8427e");
+}
+
 TEST_CASE("Test Hashing - rand32", "[hash]")
 {
     auto output = hestia::HashUtils::do_rand_32();
     REQUIRE(output.length() == 32);
 }
 
+TEST_CASE("Test Hashing - fnv1a", "[hash]")
+{
+    // Reference values for 64-bit FNV-1a
+    REQUIRE(hestia::HashUtils::do_fnv1a("") == 0xcbf29ce484222325ULL);
+    REQUIRE(hestia::HashUtils::do_fnv1a("a") == 0xaf63dc4c8601ec8cULL);
+    REQUIRE(hestia::HashUtils::do_fnv1a("foobar") == 0x85944171f73967e8ULL);
+}
+
 TEST_CASE("String encoding", "[hash]")
 {
     WHEN("The string contains only allowed characters")
@@ -65,4 +97,14 @@ TEST_CASE("String encoding", "[hash]")
             REQUIRE(encoded == string_to_encode);
         }
     }
+    WHEN("The string contains multi-byte UTF-8 characters")
+    {
+        std::string string_to_encode = "caf\xc3\xa9";
+        THEN("Each byte will be replaced by '%' and its hex value")
+        {
+            std::string encoded =
+                hestia::HashUtils::uri_encode(string_to_encode, false);
+            REQUIRE(encoded == "caf%C3%A9");
+        }
+    }
 }
@@ -30,6 +30,10 @@ TEST_CASE("Test LoggerConfig Functions", "[common]")
     logger_config.set_console_only(false);
     REQUIRE(!logger_config.is_console_only());
 
+    REQUIRE(!logger_config.is_async());
+    logger_config.set_async(true);
+    REQUIRE(logger_config.is_async());
+
     hestia::LoggerConfig new_logger_config(logger_config);
     REQUIRE(logger_config.get_log_path() == new_logger_config.get_log_path());
     REQUIRE(
@@ -40,9 +44,29 @@ TEST_CASE("Test LoggerConfig Functions", "[common]")
     REQUIRE(
         logger_config.is_console_only() == new_logger_config.is_console_only());
     REQUIRE(logger_config.should_assert() == new_logger_config.should_assert());
+    REQUIRE(logger_config.is_async() == new_logger_config.is_async());
+    REQUIRE(
+        logger_config.get_async_queue_size()
+        == new_logger_config.get_async_queue_size());
 
     REQUIRE(logger_config.modified());
 
     logger_config.reset();
     REQUIRE(!logger_config.modified());
+}
+
+TEST_CASE("Test Logger Skips Disabled Messages", "[common]")
+{
+    // The test logger is initialized as inactive in main
+    const auto& logger = hestia::Logger::get_instance();
+    REQUIRE_FALSE(logger.should_log(hestia::LoggerConfig::Level::ERROR));
+
+    std::size_t num_formatted{0};
+    auto format = [&num_formatted]() {
+        num_formatted++;
+        return "message";
+    };
+    LOG_INFO(format());
+    LOG_DEBUG(format());
+    REQUIRE(num_formatted == 0);
 }
\ No newline at end of file
@@ -10,6 +10,10 @@
 
 #include "TestUtils.h"
 
+#include <algorithm>
+#include <sys/socket.h>
+#include <unistd.h>
+
 TEST_CASE("Test In Memory Stream Flush", "[stream]")
 {
     hestia::Stream stream;
@@ -26,6 +30,34 @@ TEST_CASE("Test In Memory Stream Flush", "[stream]")
     REQUIRE(result == data);
 }
 
+TEST_CASE("Test In Memory Stream Function Source", "[stream]")
+{
+    hestia::Stream stream;
+
+    const std::string data = "The quick brown fox jumps over the lazy dog.";
+    auto source_func = [&data](hestia::WriteableBufferView& buffer,
+                               std::size_t offset)
+        -> hestia::InMemoryStreamSource::Status {
+        const auto count = std::min(buffer.length(), data.size() - offset);
+        std::copy_n(data.data() + offset, count, buffer.data());
+        return {true, count};
+    };
+    auto source = hestia::InMemoryStreamSource::create(source_func);
+    source->set_size(data.size());
+    stream.set_source(std::move(source));
+
+    std::vector<char> result_buffer(data.size());
+    stream.set_sink(hestia::InMemoryStreamSink::create(result_buffer));
+
+    // Blocks smaller than the data so the source is called more than once
+    const auto result = stream.flush(8);
+    REQUIRE(result.ok());
+    REQUIRE(result.get_num_transferred() == data.size());
+
+    std::string result_str(result_buffer.begin(), result_buffer.end());
+    REQUIRE(result_str == data);
+}
+
 TEST_CASE("Test File Stream IO", "[stream]")
 {
     hestia::Stream stream;
@@ -93,4 +125,139 @@ TEST_CASE("Test Fifo Stream Read", "[stream]")
 
     std::string result(result_buffer.begin(), result_buffer.end());
     REQUIRE(result == data);
+}
+
+TEST_CASE("Test Pipelined Stream Flush", "[stream]")
+{
+    hestia::Stream stream;
+
+    std::string data;
+    for (std::size_t idx = 0; idx < 1000; idx++) {
+        data += "The quick brown fox jumps over the lazy dog.";
+    }
+    stream.set_source(hestia::InMemoryStreamSource::create(data));
+
+    std::vector<char> result_buffer(data.size());
+    stream.set_sink(hestia::InMemoryStreamSink::create(result_buffer));
+
+    std::size_t last_progress{0};
+    stream.set_progress_func(1000, [&last_progress](std::size_t progress) {
+        last_progress = progress;
+    });
+
+    auto result = stream.flush(64, 4);
+    REQUIRE(result.ok());
+    REQUIRE(result.get_num_transferred() == data.size());
+    REQUIRE(last_progress > 0);
+
+    std::string result_str(result_buffer.begin(), result_buffer.end());
+    REQUIRE(result_str == data);
+}
+
+TEST_CASE("Test Pipelined Stream Flush - exceptions", "[stream]")
+{
+    hestia::Stream stream;
+
+    const std::string data(1000, 'a');
+    stream.set_source(hestia::InMemoryStreamSource::create(data));
+
+    std::vector<char> result_buffer(data.size());
+    stream.set_sink(hestia::InMemoryStreamSink::create(result_buffer));
+
+    stream.set_progress_func(1, [](std::size_t) {
+        throw std::runtime_error("Progress func failed");
+    });
+
+    // More blocks than buffers, so the reader is left waiting on a slot
+    const auto result = stream.flush(64, 2);
+    REQUIRE_FALSE(result.ok());
+    REQUIRE(
+        result.message().find("Progress func failed") != std::string::npos);
+}
+
+TEST_CASE("Test Deferred Stream Flush", "[stream]")
+{
+    hestia::Stream stream;
+
+    const std::string data = "The quick brown fox jumps over the lazy dog.";
+    stream.set_source(hestia::InMemoryStreamSource::create(data));
+
+    std::vector<char> result_buffer(data.size());
+    stream.set_sink(hestia::InMemoryStreamSink::create(result_buffer));
+
+    bool completed{false};
+    std::size_t num_completed{0};
+    stream.set_completion_func(
+        [&completed, &num_completed](hestia::StreamState state) {
+            completed     = state.ok();
+            num_completed = state.get_num_transferred();
+        });
+
+    stream.flush_async(8, 2);
+    REQUIRE(stream.has_pending_flush());
+
+    const auto state = stream.reset();
+    REQUIRE(state.ok());
+    REQUIRE(state.get_num_transferred() == data.size());
+    REQUIRE(completed);
+    REQUIRE(num_completed == data.size());
+    REQUIRE_FALSE(stream.has_pending_flush());
+
+    std::string result(result_buffer.begin(), result_buffer.end());
+    REQUIRE(result == data);
+}
+
+TEST_CASE("Test File Stream Direct Send", "[stream]")
+{
+    hestia::Stream stream;
+
+    std::string data;
+    for (int idx = 0; idx < 1000; idx++) {
+        data += "The quick brown fox jumps over the lazy dog. ";
+    }
+    stream.set_source(hestia::InMemoryStreamSource::create(data));
+    REQUIRE_FALSE(stream.supports_direct_send());
+
+    const auto test_dir =
+        TestUtils::get_test_output_dir(__FILE__) / "FileStreamDirectSend";
+    std::filesystem::remove_all(test_dir);
+    const auto test_file = test_dir / "test.dat";
+
+    stream.set_sink(hestia::FileStreamSink::create(test_file));
+    REQUIRE(stream.flush().ok());
+
+    stream.set_source(hestia::FileStreamSource::create(test_file));
+    REQUIRE(stream.supports_direct_send());
+
+    int handles[2];
+    REQUIRE(::socketpair(AF_UNIX, SOCK_STREAM, 0, handles) == 0);
+
+    // Skip the first sentence with a seek and send the rest in chunks
+    const std::size_t offset = 45;
+    stream.seek_source_to(offset);
+
+    std::string result;
+    std::vector<char> read_buffer(data.size());
+    while (true) {
+        const auto send_result = stream.send_to(handles[0], 4096);
+        REQUIRE(send_result.ok());
+
+        std::size_t num_read{0};
+        while (num_read < send_result.m_num_transferred) {
+            const auto count = ::read(
+                handles[1], read_buffer.data(),
+                send_result.m_num_transferred - num_read);
+            REQUIRE(count > 0);
+            result.append(read_buffer.data(), count);
+            num_read += count;
+        }
+        if (send_result.finished()) {
+            break;
+        }
+    }
+    ::close(handles[0]);
+    ::close(handles[1]);
+
+    REQUIRE(result == data.substr(offset));
+    REQUIRE(stream.reset().ok());
 }
\ No newline at end of file
@@ -1,7 +1,9 @@
 #include <catch2/catch_all.hpp>
+#include <atomic>
 #include <thread>
 
 #include "ThreadCollection.h"
+#include "ThreadPool.h"
 
 TEST_CASE("Thread size returns correct number of threads", "[common]")
 {
@@ -11,4 +13,30 @@ TEST_CASE("Thread size returns correct number of threads", "[common]")
     threads.add(std::move(new_thread));
     REQUIRE(threads.size() == 1);
     // TODO test this more robustly
+}
+
+TEST_CASE("Thread pool runs all queued tasks on shut down", "[common]")
+{
+    ThreadPool pool(3);
+    REQUIRE(pool.size() == 3);
+
+    std::atomic<int> count{0};
+    std::atomic<int> active{0};
+    std::atomic<int> max_active{0};
+    for (int idx = 0; idx < 100; idx++) {
+        REQUIRE(pool.add_task([&]() {
+            const auto now_active = ++active;
+            auto prev_max         = max_active.load();
+            while (now_active > prev_max
+                   && !max_active.compare_exchange_weak(prev_max, now_active)) {
+            }
+            count++;
+            active--;
+        }));
+    }
+
+    pool.shut_down();
+    REQUIRE(count == 100);
+    REQUIRE(max_active <= 3);
+    REQUIRE_FALSE(pool.add_task([]() {}));
 }
\ No newline at end of file
@@ -19,6 +19,20 @@ TEST_CASE("Test TimeUtils - get current time", "[common]")
     REQUIRE(hestialocaltime_str == localtime_str);
 }
 
+TEST_CASE("Test TimeUtils - clock time to seconds", "[common]")
+{
+    // Model timestamps are in system clock ticks, which can't be formatted
+    // as they are
+    const auto before  = std::time(nullptr);
+    const auto seconds = hestia::TimeUtils::to_seconds(
+        hestia::TimeUtils::get_current_time());
+    const auto after   = std::time(nullptr);
+    REQUIRE(seconds >= before);
+    REQUIRE(seconds <= after);
+
+    REQUIRE(hestia::TimeUtils::to_iso8601_basic(seconds).size() == 16);
+}
+
 TEST_CASE("Test Timed Lock - lock/unlock", "[common]")
 {
     std::size_t timeout{5};
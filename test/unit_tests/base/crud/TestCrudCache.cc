@@ -0,0 +1,63 @@
+#include <catch2/catch_all.hpp>
+
+#include "CrudCache.h"
+
+TEST_CASE("Test Crud Cache", "[crud-cache]")
+{
+    hestia::CrudCacheConfig config;
+    config.m_max_size.update_value(1024);
+    config.m_num_shards.update_value(1);
+    hestia::CrudCache cache(config);
+
+    std::string value;
+    REQUIRE_FALSE(cache.get("key0", value));
+
+    cache.put("key0", "value0", cache.get_version("key0"));
+    REQUIRE(cache.get("key0", value));
+    REQUIRE(value == "value0");
+
+    WHEN("A key is removed")
+    {
+        cache.remove({"key0"});
+        REQUIRE_FALSE(cache.get("key0", value));
+    }
+
+    WHEN("A key is removed while its value is being read")
+    {
+        const auto version = cache.get_version("key1");
+        cache.remove({"key1"});
+        cache.put("key1", "stale", version);
+        REQUIRE_FALSE(cache.get("key1", value));
+    }
+
+    WHEN("The budget is exceeded")
+    {
+        const std::string big_value(300, 'x');
+        for (std::size_t idx = 1; idx < 8; idx++) {
+            const auto key = "key" + std::to_string(idx);
+            cache.put(key, big_value, cache.get_version(key));
+        }
+        REQUIRE_FALSE(cache.get("key0", value));
+        REQUIRE(cache.get("key7", value));
+
+        const auto stats = cache.get_stats();
+        REQUIRE(stats.m_size <= 1024);
+        REQUIRE(stats.m_evictions > 0);
+        REQUIRE(stats.m_hits == 2);
+        REQUIRE(stats.m_misses == 2);
+    }
+}
+
+TEST_CASE("Test Crud Cache - Expiry", "[crud-cache]")
+{
+    hestia::CrudCacheConfig config;
+    config.m_max_size.update_value(1024);
+    config.m_ttl.update_value(0);
+    hestia::CrudCache cache(config);
+
+    cache.put("key0", "value0", cache.get_version("key0"));
+
+    std::string value;
+    REQUIRE_FALSE(cache.get("key0", value));
+    REQUIRE(cache.get_stats().m_count == 0);
+}
@@ -1,6 +1,9 @@
 #include <catch2/catch_all.hpp>
 
+#include "CrudClientConfig.h"
 #include "JsonUtils.h"
+#include "KeyValueFieldContext.h"
+#include "KeyValueStoreRequest.h"
 #include "MockCrudService.h"
 #include "MockModel.h"
 #include "TypedCrudRequest.h"
@@ -469,4 +472,286 @@ TEST_CASE_METHOD(
         updated_many_many_response
             ->get_item_as<hestia::mock::MockManyToManyTargetModel>();
     REQUIRE(updated_many_many->get_many_to_many_children().size() == 1);
-}
\ No newline at end of file
+}
+
+TEST_CASE_METHOD(
+    TestCrudServiceFixture, "Test Crud Service - Paging", "[crud-service]")
+{
+    for (std::size_t idx = 0; idx < 5; idx++) {
+        const auto create_response =
+            m_service->make_request(hestia::CrudRequest{
+                hestia::CrudMethod::CREATE,
+                {},
+                {},
+                hestia::CrudQuery::OutputFormat::ITEM});
+        REQUIRE(create_response->ok());
+    }
+
+    hestia::CrudQuery query(hestia::CrudQuery::OutputFormat::ITEM);
+    query.set_offset(1);
+    query.set_count(2);
+    const auto page_response =
+        m_service->make_request(hestia::CrudRequest{query, {}});
+    REQUIRE(page_response->ok());
+    REQUIRE(page_response->items().size() == 2);
+    REQUIRE(page_response->get_total_count() == 5);
+
+    query.set_offset(4);
+    query.set_count(10);
+    const auto last_page_response =
+        m_service->make_request(hestia::CrudRequest{query, {}});
+    REQUIRE(last_page_response->ok());
+    REQUIRE(last_page_response->items().size() == 1);
+
+    hestia::CrudQuery all_query(hestia::CrudQuery::OutputFormat::ITEM);
+    const auto all_response =
+        m_service->make_request(hestia::CrudRequest{all_query, {}});
+    REQUIRE(all_response->ok());
+    REQUIRE(all_response->items().size() == 5);
+    REQUIRE(all_response->get_total_count() == 5);
+}
+
+TEST_CASE_METHOD(
+    TestCrudServiceFixture,
+    "Test Crud Service - Secondary Index Filters",
+    "[crud-service]")
+{
+    std::vector<std::string> ids;
+    for (const auto& value : {"alpha", "alpha", "alphabet", "beta"}) {
+        hestia::mock::MockModel model;
+        model.m_my_field.update_value(value);
+        if (ids.size() == 2) {
+            model.set_name("named_alphabet");
+        }
+        const auto create_response = m_service->make_request(
+            hestia::TypedCrudRequest<hestia::mock::MockModel>{
+                hestia::CrudMethod::CREATE,
+                model,
+                {},
+                hestia::CrudQuery::OutputFormat::ITEM});
+        REQUIRE(create_response->ok());
+        ids.push_back(create_response->get_item()->id());
+        m_service->m_mock_time_provider->increment();
+    }
+
+    auto count_matching = [this](const hestia::VecKeyValuePair& terms) {
+        hestia::Map filter;
+        for (const auto& [key, value] : terms) {
+            filter.set_item(key, value);
+        }
+        hestia::CrudQuery query(
+            filter, hestia::CrudQuery::Format::LIST,
+            hestia::CrudQuery::OutputFormat::ITEM);
+        const auto response =
+            m_service->make_request(hestia::CrudRequest{query, {}});
+        REQUIRE(response->ok());
+        return response->items().size();
+    };
+
+    REQUIRE(count_matching({{"my_field", "alpha"}}) == 2);
+    REQUIRE(count_matching({{"my_field__prefix", "alpha"}}) == 3);
+    REQUIRE(
+        count_matching(
+            {{"my_field__prefix", "alpha"}, {"creation_time__gte", "1"}})
+        == 2);
+    REQUIRE(
+        count_matching({{"my_field", "alpha"}, {"creation_time__lt", "1"}})
+        == 1);
+    REQUIRE(count_matching({{"my_field", "gamma"}}) == 0);
+
+    // Times are ordered as numbers rather than text
+    REQUIRE(count_matching({{"creation_time__lt", "10"}}) == 4);
+    REQUIRE(
+        count_matching(
+            {{"creation_time__gt", "0"}, {"creation_time__lte", "2"}})
+        == 2);
+
+    // Unique index terms can be mixed with secondary index terms
+    REQUIRE(
+        count_matching(
+            {{"name", "named_alphabet"}, {"my_field__prefix", "alpha"}})
+        == 1);
+    REQUIRE(
+        count_matching({{"name", "named_alphabet"}, {"my_field", "beta"}})
+        == 0);
+
+    WHEN("A filter uses a field without an index")
+    {
+        hestia::Map filter;
+        filter.set_item("last_modified_time", "0");
+        hestia::CrudQuery query(
+            filter, hestia::CrudQuery::Format::LIST,
+            hestia::CrudQuery::OutputFormat::ITEM);
+        const auto response =
+            m_service->make_request(hestia::CrudRequest{query, {}});
+
+        THEN("The request is rejected")
+        {
+            REQUIRE_FALSE(response->ok());
+        }
+    }
+
+    WHEN("An indexed field is updated")
+    {
+        hestia::mock::MockModel model_to_update(ids[0]);
+        model_to_update.m_my_field.update_value("beta");
+        const auto update_response = m_service->make_request(
+            hestia::TypedCrudRequest<hestia::mock::MockModel>{
+                hestia::CrudMethod::UPDATE,
+                model_to_update,
+                {},
+                hestia::CrudQuery::OutputFormat::ITEM});
+        REQUIRE(update_response->ok());
+
+        THEN("The item moves between index sets")
+        {
+            REQUIRE(count_matching({{"my_field", "alpha"}}) == 1);
+            REQUIRE(count_matching({{"my_field", "beta"}}) == 2);
+            REQUIRE(count_matching({{"my_field__prefix", "alpha"}}) == 2);
+            REQUIRE(count_matching({{"my_field__gte", "beta"}}) == 2);
+        }
+    }
+
+    WHEN("An item is removed")
+    {
+        const auto remove_response = m_service->make_request(
+            hestia::CrudRequest{
+                hestia::CrudMethod::REMOVE,
+                {},
+                {hestia::CrudIdentifier(ids[3])}});
+        REQUIRE(remove_response->ok());
+
+        THEN("It is removed from the index sets")
+        {
+            REQUIRE(count_matching({{"my_field", "beta"}}) == 0);
+            REQUIRE(count_matching({{"my_field__prefix", "b"}}) == 0);
+            REQUIRE(count_matching({{"creation_time__gte", "0"}}) == 3);
+        }
+    }
+}
+
+TEST_CASE_METHOD(
+    TestCrudServiceFixture,
+    "Test Crud Service - Index Existing Items",
+    "[crud-service]")
+{
+    for (const auto& value : {"alpha", "alphabet", "beta"}) {
+        hestia::mock::MockModel model;
+        model.m_my_field.update_value(value);
+        const auto create_response = m_service->make_request(
+            hestia::TypedCrudRequest<hestia::mock::MockModel>{
+                hestia::CrudMethod::CREATE, model, {}});
+        REQUIRE(create_response->ok());
+    }
+
+    // Replace the ordered index with a distinct values set, as items stored
+    // before the ordered indexes have
+    const auto adapters = hestia::mock::MockModel::create_adapters();
+    const hestia::KeyValueFieldContext field_context(
+        adapters.get(), hestia::CrudClientConfig().m_prefix);
+    const auto order_key =
+        field_context.get_secondary_index_order_key("my_field");
+    const auto values_key =
+        field_context.get_secondary_index_values_key("my_field");
+
+    auto list_set = [this](const std::string& key) {
+        const auto response = m_service->m_kv_store_client->make_request(
+            {hestia::KeyValueStoreRequestMethod::SET_LIST,
+             std::vector<std::string>{key}});
+        REQUIRE(response->ok());
+        return response->ids()[0];
+    };
+
+    hestia::VecKeyValuePair order_members;
+    for (const auto& member : list_set(order_key)) {
+        order_members.emplace_back(order_key, member);
+    }
+    REQUIRE(order_members.size() == 3);
+    REQUIRE(m_service->m_kv_store_client
+                ->make_request(
+                    {hestia::KeyValueStoreRequestMethod::SET_REMOVE,
+                     order_members})
+                ->ok());
+    REQUIRE(m_service->m_kv_store_client
+                ->make_request(
+                    {hestia::KeyValueStoreRequestMethod::SET_ADD,
+                     hestia::VecKeyValuePair{{values_key, "alpha"}}})
+                ->ok());
+
+    hestia::Map filter;
+    filter.set_item("my_field__prefix", "alpha");
+    hestia::CrudQuery query(
+        filter, hestia::CrudQuery::Format::LIST,
+        hestia::CrudQuery::OutputFormat::ITEM);
+    const auto response =
+        m_service->make_request(hestia::CrudRequest{query, {}});
+    REQUIRE(response->ok());
+    REQUIRE(response->items().size() == 2);
+
+    REQUIRE(list_set(order_key).size() == 3);
+    REQUIRE(list_set(values_key).empty());
+}
+
+TEST_CASE_METHOD(
+    TestCrudServiceFixture,
+    "Test Crud Service - Unit Of Work",
+    "[crud-service]")
+{
+    auto unit_of_work = m_service->create_unit_of_work();
+    REQUIRE(unit_of_work != nullptr);
+    REQUIRE(unit_of_work->empty());
+
+    hestia::mock::MockModel model;
+    model.set_name("batched");
+    model.m_my_field.update_value("batched_value");
+
+    hestia::TypedCrudRequest<hestia::mock::MockModel> create_request{
+        hestia::CrudMethod::CREATE,
+        model,
+        {},
+        hestia::CrudQuery::OutputFormat::ITEM};
+    create_request.set_unit_of_work(unit_of_work.get());
+    const auto create_response = m_service->make_request(create_request);
+    REQUIRE(create_response->ok());
+    const auto id = create_response->get_item()->id();
+    REQUIRE_FALSE(unit_of_work->empty());
+
+    auto read_item = [this, id]() {
+        return m_service->make_request(hestia::CrudRequest{
+            hestia::CrudQuery{
+                hestia::CrudIdentifier(id),
+                hestia::CrudQuery::OutputFormat::ITEM},
+            {}});
+    };
+    REQUIRE_FALSE(read_item()->found());
+
+    bool committed{false};
+    unit_of_work->on_commit([&committed]() { committed = true; });
+    unit_of_work->commit();
+    REQUIRE(committed);
+    REQUIRE(unit_of_work->empty());
+
+    const auto read_response = read_item();
+    REQUIRE(read_response->found());
+    REQUIRE(
+        read_response->get_item_as<hestia::mock::MockModel>()
+            ->m_my_field.get_value()
+        == "batched_value");
+}
+
+TEST_CASE_METHOD(
+    TestCrudServiceFixture,
+    "Test Crud Service - Update Missing",
+    "[crud-service]")
+{
+    hestia::mock::MockModel model_to_update("not_an_existing_id");
+    model_to_update.m_my_field.update_value("updated_field_value");
+
+    const auto update_response = m_service->make_request(
+        hestia::TypedCrudRequest<hestia::mock::MockModel>{
+            hestia::CrudMethod::UPDATE,
+            model_to_update,
+            {},
+            hestia::CrudQuery::OutputFormat::ITEM});
+    REQUIRE_FALSE(update_response->ok());
+}
@@ -1,6 +1,7 @@
 #include <catch2/catch_all.hpp>
 
 #include "EventFeed.h"
+#include "EventFeedWriter.h"
 #include "hestia.h"
 
 #include "Dictionary.h"
@@ -115,3 +116,104 @@ TEST_CASE_METHOD(
     // check_output();
     */
 }
+
+class EventFeedWriterTestFixture : public EventFeedTestFixture {
+  public:
+    void init(
+        const std::string& test_name,
+        const std::unordered_map<std::string, std::string>& settings = {})
+    {
+        EventFeedTestFixture::init(test_name);
+
+        hestia::Dictionary dict;
+        dict.set_map(settings);
+        m_config.deserialize(dict);
+    }
+
+    static hestia::Dictionary::Ptr make_event(std::size_t idx)
+    {
+        auto event = hestia::Dictionary::create();
+        event->set_map_item("root", hestia::Dictionary::create());
+        event->get_map_item("root")->set_map({{"id", std::to_string(idx)}});
+        return event;
+    }
+
+    std::string read_output() const
+    {
+        std::ifstream output_file(get_output_path());
+        return std::string(
+            (std::istreambuf_iterator<char>(output_file)),
+            (std::istreambuf_iterator<char>()));
+    }
+
+    hestia::EventFeedConfig m_config;
+};
+
+TEST_CASE_METHOD(
+    EventFeedWriterTestFixture, "Test event feed writer", "[event-feed]")
+{
+    init("writer");
+
+    std::string expected;
+    {
+        hestia::EventFeedWriter writer(get_output_path(), m_config);
+        for (std::size_t idx = 0; idx < 600; idx++) {
+            hestia::YamlUtils::dict_to_yaml(*make_event(idx), expected);
+            REQUIRE(writer.push(make_event(idx)));
+        }
+        writer.flush();
+
+        REQUIRE(read_output() == expected);
+        REQUIRE(writer.get_num_written() == 600);
+        REQUIRE(writer.get_queue_depth() == 0);
+
+        // Anything left is written on close
+        hestia::YamlUtils::dict_to_yaml(*make_event(600), expected);
+        REQUIRE(writer.push(make_event(600)));
+    }
+    REQUIRE(read_output() == expected);
+}
+
+TEST_CASE_METHOD(
+    EventFeedWriterTestFixture,
+    "Test event feed writer drops on full queue",
+    "[event-feed]")
+{
+    init("writer_drops", {{"max_queue_size", "0"}});
+
+    hestia::EventFeedWriter writer(get_output_path(), m_config);
+    REQUIRE_FALSE(writer.push(make_event(0)));
+    REQUIRE(writer.get_num_dropped() == 1);
+    REQUIRE(writer.get_queue_depth() == 0);
+}
+
+TEST_CASE_METHOD(
+    EventFeedWriterTestFixture,
+    "Test event feed writer rotation",
+    "[event-feed]")
+{
+    init("writer_rotation", {{"rotate_size", "64"}, {"fsync_interval", "1"}});
+
+    std::string expected;
+    {
+        hestia::EventFeedWriter writer(get_output_path(), m_config);
+        for (std::size_t idx = 0; idx < 20; idx++) {
+            hestia::YamlUtils::dict_to_yaml(*make_event(idx), expected);
+            REQUIRE(writer.push(make_event(idx)));
+            writer.flush();
+        }
+    }
+
+    std::size_t num_rotated{0};
+    std::size_t total_size{0};
+    for (const auto& entry :
+         std::filesystem::directory_iterator(get_output_dir())) {
+        total_size += entry.file_size();
+        if (entry.path() != get_output_path()) {
+            REQUIRE(entry.file_size() <= 64);
+            num_rotated++;
+        }
+    }
+    REQUIRE(num_rotated > 0);
+    REQUIRE(total_size == expected.size());
+}
@@ -3,6 +3,7 @@
 #include "HttpClient.h"
 #include "HttpCrudClient.h"
 #include "HttpRequest.h"
+#include "RequestException.h"
 #include "StringUtils.h"
 #include "UuidUtils.h"
 
@@ -36,11 +37,16 @@ class MockHttpClient : public hestia::HttpClient {
             hestia::StringUtils::remove_prefix(request.get_path(), m_address));
 
         m_app->on_event(&request_context, hestia::HttpEvent::EOM);
-        return std::make_unique<hestia::HttpResponse>(
+        auto response = std::make_unique<hestia::HttpResponse>(
             *request_context.get_response());
+        if (!m_total_count.empty()) {
+            response->header().set_item("hestia-total_count", m_total_count);
+        }
+        return response;
     }
 
     std::string m_address{"127.0.0.1"};
+    std::string m_total_count;
     hestia::mock::MockCrudService::Ptr m_service;
     hestia::mock::MockCrudWebApp::Ptr m_app;
 };
@@ -122,4 +128,20 @@ TEST_CASE_METHOD(TestHttpCrudClientFixture, "Test HttpCrudClient", "[protocol]")
     m_client->read(read_request2, read_response2);
     REQUIRE(read_response2.ok());
     REQUIRE(read_response2.items().size() == 2);
+}
+
+TEST_CASE_METHOD(
+    TestHttpCrudClientFixture,
+    "Test HttpCrudClient - malformed total count",
+    "[protocol]")
+{
+    m_http_endpoint->m_total_count = "not a count";
+
+    hestia::CrudQuery query(hestia::CrudQuery::OutputFormat::ITEM);
+    hestia::CrudRequest read_request(query, {});
+    hestia::CrudResponse read_response(
+        read_request, hestia::mock::MockModel::get_type());
+    REQUIRE_THROWS_AS(
+        m_client->read(read_request, read_response),
+        hestia::RequestException<hestia::CrudRequestError>);
 }
\ No newline at end of file
@@ -2,6 +2,18 @@
 
 #include "HttpClient.h"
 #include "S3Client.h"
+#include "S3ObjectStoreClient.h"
+#include "S3SigningKeyCache.h"
+
+#include "ObjectStoreTestWrapper.h"
+
+#include "InMemoryStreamSink.h"
+#include "InMemoryStreamSource.h"
+
+#include <map>
+#include <mutex>
+#include <set>
+#include <stdexcept>
 
 class MockHttpClientForS3 : public hestia::HttpClient {
   public:
@@ -18,8 +30,306 @@ class MockHttpClientForS3 : public hestia::HttpClient {
     hestia::HttpResponse m_next_response;
 };
 
+class MockMultipartHttpClient : public hestia::HttpClient {
+  public:
+    hestia::HttpResponse::Ptr make_request(
+        const hestia::HttpRequest& request, hestia::Stream*) override
+    {
+        std::scoped_lock guard(m_mutex);
+        const auto& queries = request.get_queries();
+        const auto method   = request.get_method();
+
+        if (method == hestia::HttpRequest::Method::POST
+            && queries.has_item("uploads")) {
+            hestia::S3CreateMultipartUploadResponse response;
+            response.m_upload_id = "upload_0";
+            return with_body(response.to_string());
+        }
+        else if (
+            method == hestia::HttpRequest::Method::PUT
+            && queries.has_item("partNumber")) {
+            const auto number = std::stoull(queries.get_item("partNumber"));
+            if (m_throwing_parts.count(number) > 0) {
+                throw std::runtime_error("Failed to reach the server");
+            }
+            if (m_num_part_failures[number] > 0) {
+                m_num_part_failures[number]--;
+                return hestia::HttpResponse::create(500, "Internal Error");
+            }
+            m_parts[number] = request.body();
+            auto response   = hestia::HttpResponse::create();
+            response->header().set_item(
+                "ETag", "\"etag_" + std::to_string(number) + "\"");
+            return response;
+        }
+        else if (
+            method == hestia::HttpRequest::Method::POST
+            && queries.has_item("uploadId")) {
+            hestia::S3CompleteMultipartUploadRequest complete_request;
+            complete_request.deserialize(request.body());
+            m_object.clear();
+            for (const auto& part : complete_request.m_parts) {
+                if (part.m_etag
+                    != "\"etag_" + std::to_string(part.m_number) + "\"") {
+                    return hestia::HttpResponse::create(400, "Bad Request");
+                }
+                m_object += m_parts[part.m_number];
+            }
+            hestia::S3CompleteMultipartUploadResponse response;
+            response.m_etag = "\"etag\"";
+            return with_body(response.to_string());
+        }
+        else if (
+            method == hestia::HttpRequest::Method::DELETE
+            && queries.has_item("uploadId")) {
+            m_aborted = true;
+            return hestia::HttpResponse::create();
+        }
+        else if (method == hestia::HttpRequest::Method::GET) {
+            // Header is 'bytes=<first>-<last>'
+            const auto range = request.get_header().get_item("range");
+            const auto dash  = range.find('-');
+            const auto first = std::stoull(range.substr(6, dash - 6));
+            const auto last  = std::stoull(range.substr(dash + 1));
+            if (m_throw_on_get) {
+                throw std::runtime_error("Failed to reach the server");
+            }
+            m_num_range_requests++;
+            return with_body(m_object.substr(first, last - first + 1));
+        }
+        return hestia::HttpResponse::create(400, "Bad Request");
+    }
+
+    hestia::HttpResponse::Ptr with_body(const std::string& body)
+    {
+        auto response = hestia::HttpResponse::create();
+        response->set_body(body);
+        return response;
+    }
+
+    std::mutex m_mutex;
+    std::map<std::size_t, std::string> m_parts;
+    std::map<std::size_t, std::size_t> m_num_part_failures;
+    std::set<std::size_t> m_throwing_parts;
+    bool m_throw_on_get{false};
+    std::string m_object;
+    std::size_t m_num_range_requests{0};
+    bool m_aborted{false};
+};
+
+class MockBucketHttpClient : public hestia::HttpClient {
+  public:
+    hestia::HttpResponse::Ptr make_request(
+        const hestia::HttpRequest& request, hestia::Stream*) override
+    {
+        const auto method = request.get_method();
+        m_num_requests[method]++;
+        if (method == hestia::HttpRequest::Method::HEAD && !m_has_bucket) {
+            return hestia::HttpResponse::create(404, "Not Found");
+        }
+        else if (
+            method == hestia::HttpRequest::Method::PUT
+            && request.get_path().find("my_object") == std::string::npos) {
+            m_has_bucket = true;
+        }
+        else if (method == hestia::HttpRequest::Method::PUT && !m_has_bucket) {
+            auto response = hestia::HttpResponse::create(404, "Not Found");
+            response->set_body(
+                "<Error><Code>NoSuchBucket</Code><Message>The specified bucket does not exist.</Message></Error>");
+            return response;
+        }
+        return hestia::HttpResponse::create();
+    }
+
+    std::map<hestia::HttpRequest::Method, std::size_t> m_num_requests;
+    bool m_has_bucket{false};
+};
+
 TEST_CASE("Test S3 Client", "[protocol]")
 {
     MockHttpClientForS3 http_client;
     hestia::S3Client s3_client(&http_client);
-}
\ No newline at end of file
+}
+
+TEST_CASE("Test S3 signing key cache", "[protocol]")
+{
+    hestia::S3SigningKeyCache cache;
+    hestia::S3Request request;
+    request.m_region = "us-east-1";
+
+    // The scope and key only change with the date, not the time
+    request.m_timestamp.m_value = "20240101T101010Z";
+    REQUIRE(request.get_scope() == "20240101/us-east-1/s3/aws4_request");
+    const auto key = request.get_signing_key("my_secret", &cache);
+    REQUIRE(key == request.get_signing_key("my_secret"));
+
+    request.m_timestamp.m_value = "20240101T235959Z";
+    REQUIRE(request.get_signing_key("my_secret", &cache) == key);
+    REQUIRE(cache.size() == 1);
+
+    const auto other_key = request.get_signing_key("other_secret", &cache);
+    REQUIRE(other_key != key);
+    REQUIRE(other_key == request.get_signing_key("other_secret"));
+    REQUIRE(cache.size() == 2);
+
+    // Keys for earlier dates are dropped as the date moves on
+    request.m_timestamp.m_value = "20240102T000001Z";
+    const auto next_key         = request.get_signing_key("my_secret", &cache);
+    REQUIRE(next_key != key);
+    REQUIRE(cache.size() == 1);
+
+    request.m_timestamp.m_value = "20240101T235959Z";
+    REQUIRE(request.get_signing_key("my_secret", &cache) == key);
+    REQUIRE(cache.size() == 1);
+    request.m_timestamp.m_value = "20240102T120000Z";
+    REQUIRE(request.get_signing_key("my_secret", &cache) == next_key);
+
+    // Requests are signed the same with the cache as without
+    request.set_user_secret_key("my_secret");
+    hestia::HttpRequest http_request(
+        "/my_bucket", hestia::HttpRequest::Method::GET);
+    request.populate_headers("my_bucket", http_request.get_header());
+    auto cached_request = http_request;
+    request.populate_authorization_headers(
+        hestia::S3Request::PayloadSignatureType::SIGNED, http_request);
+    request.populate_authorization_headers(
+        hestia::S3Request::PayloadSignatureType::SIGNED, cached_request,
+        &cache);
+    REQUIRE(
+        cached_request.get_header().get_item("authorization")
+        == http_request.get_header().get_item("authorization"));
+}
+
+TEST_CASE("Test S3 Client parallel transfers", "[protocol]")
+{
+    MockMultipartHttpClient http_client;
+    hestia::S3Client s3_client(&http_client);
+
+    hestia::S3TransferConfig config;
+    config.m_part_size          = 16;
+    config.m_max_parallel_parts = 3;
+    config.m_max_part_attempts  = 2;
+
+    std::string content;
+    for (std::size_t idx = 0; idx < 10; idx++) {
+        content += "Part " + std::to_string(idx) + " of the content.";
+    }
+
+    hestia::S3Object object("my_object");
+    hestia::S3Bucket bucket("my_bucket");
+    hestia::S3Request request;
+
+    // A part failing once is retried on its own
+    http_client.m_num_part_failures[2] = 1;
+
+    hestia::Stream put_stream;
+    put_stream.set_source(hestia::InMemoryStreamSource::create(
+        hestia::ReadableBufferView(content)));
+    auto status = s3_client.put_object_parallel(
+        object, bucket, request, &put_stream, content.size(), config);
+    REQUIRE(status.is_ok());
+    REQUIRE(put_stream.reset().ok());
+    REQUIRE(http_client.m_parts.size() == (content.size() + 15) / 16);
+    REQUIRE(http_client.m_object == content);
+
+    std::vector<char> returned(content.size());
+    hestia::Stream get_stream;
+    get_stream.set_sink(hestia::InMemoryStreamSink::create(
+        hestia::WriteableBufferView(returned)));
+    request.m_range = hestia::S3Range(0, content.size());
+    status = s3_client.get_object_parallel(
+        object, bucket, request, &get_stream, config);
+    REQUIRE(status.is_ok());
+    REQUIRE(get_stream.reset().ok());
+    REQUIRE(std::string(returned.begin(), returned.end()) == content);
+    REQUIRE(http_client.m_num_range_requests == http_client.m_parts.size());
+
+    // A part failing on every attempt aborts the upload
+    http_client.m_num_part_failures[3] = 2;
+    hestia::Stream failed_stream;
+    failed_stream.set_source(hestia::InMemoryStreamSource::create(
+        hestia::ReadableBufferView(content)));
+    status = s3_client.put_object_parallel(
+        object, bucket, request, &failed_stream, content.size(), config);
+    REQUIRE_FALSE(status.is_ok());
+    REQUIRE(http_client.m_aborted);
+}
+
+TEST_CASE("Test S3 Client parallel transfers - throwing client", "[protocol]")
+{
+    MockMultipartHttpClient http_client;
+    hestia::S3Client s3_client(&http_client);
+
+    hestia::S3TransferConfig config;
+    config.m_part_size          = 16;
+    config.m_max_parallel_parts = 2;
+
+    std::string content;
+    for (std::size_t idx = 0; idx < 10; idx++) {
+        content += "Part " + std::to_string(idx) + " of the content.";
+    }
+
+    hestia::S3Object object("my_object");
+    hestia::S3Bucket bucket("my_bucket");
+    hestia::S3Request request;
+
+    // A part whose request throws fails the upload rather than leaving it
+    // waiting on the part
+    http_client.m_throwing_parts = {2, 5};
+    hestia::Stream put_stream;
+    put_stream.set_source(hestia::InMemoryStreamSource::create(
+        hestia::ReadableBufferView(content)));
+    auto status = s3_client.put_object_parallel(
+        object, bucket, request, &put_stream, content.size(), config);
+    REQUIRE_FALSE(status.is_ok());
+    REQUIRE(status.to_string().find("Failed to reach") != std::string::npos);
+    REQUIRE(http_client.m_aborted);
+
+    http_client.m_throwing_parts.clear();
+    hestia::Stream retry_stream;
+    retry_stream.set_source(hestia::InMemoryStreamSource::create(
+        hestia::ReadableBufferView(content)));
+    status = s3_client.put_object_parallel(
+        object, bucket, request, &retry_stream, content.size(), config);
+    REQUIRE(status.is_ok());
+
+    http_client.m_throw_on_get = true;
+    std::vector<char> returned(content.size());
+    hestia::Stream get_stream;
+    get_stream.set_sink(hestia::InMemoryStreamSink::create(
+        hestia::WriteableBufferView(returned)));
+    request.m_range = hestia::S3Range(0, content.size());
+    status          = s3_client.get_object_parallel(
+        object, bucket, request, &get_stream, config);
+    REQUIRE_FALSE(status.is_ok());
+    REQUIRE(status.to_string().find("Failed to reach") != std::string::npos);
+}
+
+TEST_CASE("Test S3 object store client bucket cache", "[protocol]")
+{
+    MockBucketHttpClient http_client;
+    hestia::S3Client s3_client(&http_client);
+    ObjectStoreTestWrapper object_store(
+        hestia::S3ObjectStoreClient::create(&s3_client));
+
+    hestia::StorageObject object("my_object");
+    object.get_metadata_as_writeable().set_item(
+        "hestia-bucket_name", "my_bucket");
+
+    // The bucket is checked, and created, on the first put only
+    object_store.put(object);
+    object_store.put(object);
+    REQUIRE(http_client.m_num_requests[hestia::HttpRequest::Method::HEAD] == 1);
+    REQUIRE(http_client.m_num_requests[hestia::HttpRequest::Method::PUT] == 3);
+
+    // A missing bucket is forgotten, so is checked again on the next put
+    http_client.m_has_bucket = false;
+    hestia::ObjectStoreRequest request(
+        object, hestia::ObjectStoreRequestMethod::PUT);
+    REQUIRE_FALSE(
+        object_store.m_client->make_request(request, nullptr)->ok());
+
+    object_store.put(object);
+    REQUIRE(http_client.m_num_requests[hestia::HttpRequest::Method::HEAD] == 2);
+    REQUIRE(http_client.m_has_bucket);
+}
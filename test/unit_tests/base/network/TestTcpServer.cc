@@ -3,10 +3,16 @@
 #include "Socket.h"
 #include "TcpServer.h"
 
+#include <atomic>
 #include <condition_variable>
 #include <future>
 #include <iostream>
 
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
 class TestSocket : public Socket {
   public:
     TestSocket(const std::string& address, unsigned port) :
@@ -68,4 +74,74 @@ TEST_CASE("Test TcpServer", "[server]")
     server.listen(address, on_connect_func, on_connect_failed_func);
     server.wait_until_bound();
     server.shut_down();
+}
+
+TEST_CASE("Test TcpServer many clients with worker pool", "[server]")
+{
+    TcpServer::Config config;
+    config.m_num_workers     = 2;
+    config.m_listen_backlog  = 512;
+    config.m_max_connections = 4;
+    TcpServer server(config);
+
+    std::atomic<int> active{0};
+    std::atomic<int> max_active{0};
+    std::atomic<std::size_t> max_connections{0};
+    auto on_connect_func = [&](Socket* socket) {
+        const auto now_active = ++active;
+        if (now_active > max_active) {
+            max_active = now_active;
+        }
+        if (server.get_num_connections() > max_connections) {
+            max_connections = server.get_num_connections();
+        }
+
+        const auto request = socket->recieve();
+        socket->respond("ok:" + request);
+        active--;
+        socket->close();
+    };
+
+    auto on_connect_failed_func = [](const ConnectionResult& result) {
+        (void)result;
+    };
+
+    TcpServer::Address address;
+    address.m_host = "127.0.0.1";
+    address.m_port = 8092;
+    server.listen(address, on_connect_func, on_connect_failed_func);
+    server.wait_until_bound();
+
+    const int num_clients = 200;
+    std::vector<int> clients;
+    for (int idx = 0; idx < num_clients; idx++) {
+        sockaddr_in serv_addr{};
+        serv_addr.sin_family = AF_INET;
+        serv_addr.sin_port   = htons(address.m_port);
+        ::inet_aton(address.m_host.c_str(), &serv_addr.sin_addr);
+
+        const auto handle = ::socket(AF_INET, SOCK_STREAM, 0);
+        REQUIRE(
+            ::connect(handle, (sockaddr*)&serv_addr, sizeof(serv_addr)) == 0);
+        const auto message = std::to_string(idx);
+        REQUIRE(
+            ::write(handle, message.c_str(), message.size())
+            == static_cast<ssize_t>(message.size()));
+        clients.push_back(handle);
+    }
+
+    for (int idx = 0; idx < num_clients; idx++) {
+        std::string response;
+        char buffer[64];
+        ssize_t count{0};
+        while ((count = ::read(clients[idx], buffer, sizeof(buffer))) > 0) {
+            response.append(buffer, count);
+        }
+        REQUIRE(response == "ok:" + std::to_string(idx));
+        ::close(clients[idx]);
+    }
+
+    server.shut_down();
+    REQUIRE(max_active <= 2);
+    REQUIRE(max_connections <= 4);
 }
\ No newline at end of file
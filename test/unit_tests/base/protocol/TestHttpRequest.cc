@@ -2,6 +2,7 @@
 
 #include "HttpParser.h"
 #include "HttpRequest.h"
+#include "HttpResponse.h"
 
 TEST_CASE("Test HttpRequest", "[protocol]")
 {
@@ -77,3 +78,16 @@ TEST_CASE("Test HttpRequest - slash and value-less query", "[protocol]")
     REQUIRE(request.get_path() == "/my_path/");
     REQUIRE(request.get_queries().has_item("location"));
 }
+
+TEST_CASE("Test HttpResponse - status codes", "[protocol]")
+{
+    for (const auto& [code, number] :
+         std::vector<std::pair<hestia::HttpStatus::Code, int>>{
+             {hestia::HttpStatus::Code::_200_OK, 200},
+             {hestia::HttpStatus::Code::_201_CREATED, 201},
+             {hestia::HttpStatus::Code::_204_NO_CONTENT, 204},
+             {hestia::HttpStatus::Code::_404_NOT_FOUND, 404}}) {
+        REQUIRE(hestia::HttpResponse::create(code)->code() == number);
+        REQUIRE(hestia::HttpStatus::get_code_from_numeric(number) == code);
+    }
+}
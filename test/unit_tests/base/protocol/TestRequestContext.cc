@@ -0,0 +1,47 @@
+#include <catch2/catch_all.hpp>
+
+#include "InMemoryStreamSource.h"
+#include "RequestContext.h"
+
+#include <vector>
+
+TEST_CASE("Test RequestContext flush stream", "[protocol]")
+{
+    std::string content;
+    for (std::size_t idx = 0; idx < 100; idx++) {
+        content += std::to_string(idx);
+    }
+
+    hestia::RequestContext context;
+    context.set_chunk_size(16);
+    context.get_stream()->set_source(hestia::InMemoryStreamSource::create(
+        hestia::ReadableBufferView(content)));
+
+    SECTION("Whole stream")
+    {
+        std::string output;
+        context.set_output_chunk_handler(
+            [&output](const hestia::ReadableBufferView& buffer, bool) {
+                output += std::string(buffer.data(), buffer.length());
+                return buffer.length();
+            });
+        context.flush_stream();
+
+        REQUIRE(output == content);
+        REQUIRE(context.finished());
+    }
+
+    SECTION("Stops when a chunk isn't taken")
+    {
+        std::size_t num_chunks{0};
+        context.set_output_chunk_handler(
+            [&num_chunks](const hestia::ReadableBufferView& buffer, bool) {
+                num_chunks++;
+                return num_chunks < 3 ? buffer.length() : 0;
+            });
+        context.flush_stream();
+
+        REQUIRE(num_chunks == 3);
+        REQUIRE(context.finished());
+    }
+}
@@ -3,8 +3,10 @@
 #include "BlockStore.h"
 #include "TestUtils.h"
 
+#include <atomic>
 #include <filesystem>
 #include <iostream>
+#include <thread>
 
 TEST_CASE("Test Block Store Read Operations - Single Write", "[block_store]")
 {
@@ -168,4 +170,103 @@ TEST_CASE("Test Block Store IO", "[block_store]")
         "1111", {0, content.length()}, hestia::ReadableBufferView(content));
 
     // store.dump(work_dir / "TestBlockStoreIO");
-}
\ No newline at end of file
+}
+
+TEST_CASE("Test Block Store memory budget", "[block_store]")
+{
+    hestia::BlockStoreConfig config;
+    config.m_block_size    = 4;
+    config.m_num_shards    = 1;
+    config.m_memory_budget = 12;
+    hestia::BlockStore store({}, config);
+
+    std::string content{"01234567"};
+    REQUIRE(
+        store.write("0000", {}, hestia::ReadableBufferView(content)).is_ok());
+    REQUIRE(store.get_memory_size() == 8);
+
+    SECTION("Writes over budget fail")
+    {
+        auto rc = store.write("1111", {}, hestia::ReadableBufferView(content));
+        REQUIRE(
+            rc.m_status == hestia::BlockStore::ReturnCode::Status::NO_SPACE);
+        REQUIRE_FALSE(store.has_key("1111"));
+        REQUIRE(store.has_key("0000"));
+        REQUIRE(store.get_memory_size() == 8);
+    }
+
+    SECTION("Least recently used objects are suggested for eviction")
+    {
+        std::string small{"ab"};
+        REQUIRE(store.write("1111", {}, hestia::ReadableBufferView(small))
+                    .is_ok());
+        REQUIRE(store.get_eviction_candidates("1111", {2, 2}).empty());
+
+        // Reading makes '0000' the most recently used
+        std::vector<char> sink(content.size());
+        hestia::WriteableBufferView write_buffer(sink);
+        REQUIRE(store.read("0000", {}, write_buffer).is_ok());
+
+        REQUIRE(
+            store.get_eviction_candidates("2222", {0, 2})
+            == std::vector<std::string>{"1111"});
+        REQUIRE(
+            store.get_eviction_candidates("2222", {0, 8})
+            == std::vector<std::string>{"1111", "0000"});
+        REQUIRE(
+            store.get_eviction_candidates("0000", {8, 4})
+            == std::vector<std::string>{"1111"});
+        REQUIRE(store.get_eviction_candidates("2222", {0, 16}).empty());
+
+        store.remove("1111");
+        REQUIRE(
+            store.write("2222", {}, hestia::ReadableBufferView(small))
+                .is_ok());
+    }
+}
+
+TEST_CASE("Test Block Store concurrent writes", "[block_store]")
+{
+    hestia::BlockStoreConfig config;
+    config.m_block_size = 16;
+    hestia::BlockStore store({}, config);
+
+    const std::size_t num_threads{4};
+    const std::size_t num_objects{50};
+    std::string content(100, 'a');
+
+    // Catch assertions aren't thread-safe
+    std::atomic<std::size_t> num_failed{0};
+    std::vector<std::thread> threads;
+    for (std::size_t idx = 0; idx < num_threads; idx++) {
+        threads.emplace_back([&, idx]() {
+            for (std::size_t jdx = 0; jdx < num_objects; jdx++) {
+                const auto key =
+                    std::to_string(idx) + "_" + std::to_string(jdx);
+                for (std::size_t offset = 0; offset < content.size();
+                     offset += 10) {
+                    const hestia::ReadableBufferView buffer(
+                        content.data() + offset, 10);
+                    if (!store.write(key, {offset, 10}, buffer).is_ok()) {
+                        num_failed++;
+                    }
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    REQUIRE(num_failed == 0);
+
+    for (std::size_t idx = 0; idx < num_threads; idx++) {
+        for (std::size_t jdx = 0; jdx < num_objects; jdx++) {
+            std::vector<char> sink(content.size());
+            hestia::WriteableBufferView write_buffer(sink);
+            const auto key = std::to_string(idx) + "_" + std::to_string(jdx);
+            REQUIRE(store.read(key, {}, write_buffer).is_ok());
+            REQUIRE(std::string(sink.begin(), sink.end()) == content);
+        }
+    }
+    REQUIRE(store.get_memory_size() == num_threads * num_objects * 7 * 16);
+}
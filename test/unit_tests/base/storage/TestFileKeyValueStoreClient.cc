@@ -0,0 +1,245 @@
+#include <catch2/catch_all.hpp>
+
+#include "FileKeyValueStoreClient.h"
+
+#include "TestUtils.h"
+
+#include <fstream>
+
+class FileKeyValueStoreTestFixture {
+  public:
+    ~FileKeyValueStoreTestFixture()
+    {
+        std::filesystem::remove_all(get_store_path());
+    }
+
+    void init(const std::string& test_name, std::size_t compaction_size = 0)
+    {
+        m_test_name = test_name;
+        std::filesystem::remove_all(get_store_path());
+        reopen(compaction_size);
+    }
+
+    void reopen(std::size_t compaction_size = 0)
+    {
+        m_client = std::make_unique<hestia::FileKeyValueStoreClient>();
+
+        hestia::FileKeyValueStoreClientConfig config;
+        config.m_root.update_value(get_store_path());
+        if (compaction_size > 0) {
+            config.m_compaction_min_size.update_value(compaction_size);
+        }
+        m_client->do_initialize({}, config);
+    }
+
+    std::string get_store_path() const
+    {
+        return TestUtils::get_test_output_dir(__FILE__) / m_test_name;
+    }
+
+    void set(const hestia::VecKeyValuePair& pairs)
+    {
+        auto response = m_client->make_request(
+            {hestia::KeyValueStoreRequestMethod::STRING_SET, pairs});
+        REQUIRE(response->ok());
+    }
+
+    std::vector<std::string> get(const std::vector<std::string>& keys)
+    {
+        auto response = m_client->make_request(
+            {hestia::KeyValueStoreRequestMethod::STRING_GET, keys});
+        REQUIRE(response->ok());
+        return response->items();
+    }
+
+    std::vector<bool> exists(const std::vector<std::string>& keys)
+    {
+        auto response = m_client->make_request(
+            {hestia::KeyValueStoreRequestMethod::STRING_EXISTS, keys});
+        REQUIRE(response->ok());
+        return response->found();
+    }
+
+    void remove(const std::vector<std::string>& keys)
+    {
+        auto response = m_client->make_request(
+            {hestia::KeyValueStoreRequestMethod::STRING_REMOVE, keys});
+        REQUIRE(response->ok());
+    }
+
+    void set_add(const hestia::VecKeyValuePair& pairs)
+    {
+        auto response = m_client->make_request(
+            {hestia::KeyValueStoreRequestMethod::SET_ADD, pairs});
+        REQUIRE(response->ok());
+    }
+
+    void set_remove(const hestia::VecKeyValuePair& pairs)
+    {
+        auto response = m_client->make_request(
+            {hestia::KeyValueStoreRequestMethod::SET_REMOVE, pairs});
+        REQUIRE(response->ok());
+    }
+
+    std::vector<std::string> set_list(const std::string& key)
+    {
+        auto response = m_client->make_request(
+            {hestia::KeyValueStoreRequestMethod::SET_LIST,
+             std::vector<std::string>{key}});
+        REQUIRE(response->ok());
+        REQUIRE(response->ids().size() == 1);
+        return response->ids()[0];
+    }
+
+    std::vector<std::string> set_list_range(
+        const std::string& key,
+        std::size_t offset,
+        std::size_t count,
+        std::size_t& total)
+    {
+        hestia::KeyValueStoreRequest request(
+            hestia::KeyValueStoreRequestMethod::SET_LIST,
+            std::vector<std::string>{key});
+        request.set_range(offset, count);
+        auto response = m_client->make_request(request);
+        REQUIRE(response->ok());
+        REQUIRE(response->ids().size() == 1);
+        REQUIRE(response->set_sizes().size() == 1);
+        total = response->set_sizes()[0];
+        return response->ids()[0];
+    }
+
+    std::string m_test_name;
+    std::unique_ptr<hestia::FileKeyValueStoreClient> m_client;
+};
+
+TEST_CASE_METHOD(
+    FileKeyValueStoreTestFixture,
+    "Test File KV Store - Strings",
+    "[file_kv_store]")
+{
+    init("TestStrings");
+
+    set({{"hestia:object:1", "{\"name\": \"one\"}"}, {"hestia:object:2", "2"}});
+    REQUIRE(get({"hestia:object:1"})[0] == "{\"name\": \"one\"}");
+    REQUIRE(
+        exists({"hestia:object:1", "hestia:object:3"})
+        == std::vector<bool>{true, false});
+
+    set({{"hestia:object:1", "updated"}});
+    remove({"hestia:object:2"});
+
+    reopen();
+    REQUIRE(
+        get({"hestia:object:1", "hestia:object:2"})
+        == std::vector<std::string>{"updated", ""});
+    REQUIRE_FALSE(exists({"hestia:object:2"})[0]);
+}
+
+TEST_CASE_METHOD(
+    FileKeyValueStoreTestFixture,
+    "Test File KV Store - Sets",
+    "[file_kv_store]")
+{
+    init("TestSets");
+
+    set_add({{"hestia:objects", "b"}, {"hestia:objects", "a"}});
+    set_add({{"hestia:objects", "c"}});
+    set_remove({{"hestia:objects", "b"}});
+
+    REQUIRE(set_list("hestia:objects") == std::vector<std::string>{"a", "c"});
+    REQUIRE(set_list("hestia:empty").empty());
+
+    reopen();
+    REQUIRE(set_list("hestia:objects") == std::vector<std::string>{"a", "c"});
+}
+
+TEST_CASE_METHOD(
+    FileKeyValueStoreTestFixture,
+    "Test File KV Store - Set Paging",
+    "[file_kv_store]")
+{
+    init("TestSetPaging");
+
+    set_add({{"set", "d"}, {"set", "a"}, {"set", "c"}, {"set", "b"}});
+
+    std::size_t total{0};
+    REQUIRE(
+        set_list_range("set", 1, 2, total)
+        == std::vector<std::string>{"b", "c"});
+    REQUIRE(total == 4);
+
+    REQUIRE(
+        set_list_range("set", 2, 0, total)
+        == std::vector<std::string>{"c", "d"});
+    REQUIRE(set_list_range("set", 10, 2, total).empty());
+    REQUIRE(total == 4);
+
+    // Following pages resume after the last member listed, so a member added
+    // before it in the meantime doesn't repeat that member
+    REQUIRE(
+        set_list_range("set", 0, 2, total)
+        == std::vector<std::string>{"a", "b"});
+    set_add({{"set", "aa"}});
+    REQUIRE(
+        set_list_range("set", 2, 2, total)
+        == std::vector<std::string>{"c", "d"});
+    REQUIRE(total == 5);
+}
+
+TEST_CASE_METHOD(
+    FileKeyValueStoreTestFixture,
+    "Test File KV Store - Compaction",
+    "[file_kv_store]")
+{
+    init("TestCompaction", 256);
+
+    for (std::size_t idx = 0; idx < 100; idx++) {
+        set({{"key", "value" + std::to_string(idx)}});
+        set_add({{"set", "member" + std::to_string(idx)}});
+        set_remove({{"set", "member" + std::to_string(idx)}});
+    }
+    set_add({{"set", "kept"}});
+
+    const auto log_size = std::filesystem::file_size(
+        std::filesystem::path(get_store_path()) / "strings.log");
+    REQUIRE(log_size < 512);
+    REQUIRE(get({"key"})[0] == "value99");
+
+    reopen(256);
+    REQUIRE(get({"key"})[0] == "value99");
+    REQUIRE(set_list("set") == std::vector<std::string>{"kept"});
+}
+
+TEST_CASE_METHOD(
+    FileKeyValueStoreTestFixture,
+    "Test File KV Store - Legacy Migration",
+    "[file_kv_store]")
+{
+    m_test_name           = "TestMigration";
+    const auto store_path = std::filesystem::path(get_store_path());
+    std::filesystem::remove_all(store_path);
+    std::filesystem::create_directories(store_path);
+    {
+        std::ofstream json_file(store_path / "strings_db.json");
+        json_file << "{\"hestia:object:1\": \"one\"}";
+
+        std::ofstream set_file(store_path / "hestia_objects_set.meta");
+        set_file << "1\n2\n";
+
+        // Left by a migration interrupted before its log was moved in place
+        std::ofstream partial_log(store_path / "strings.log.create");
+        partial_log << "S";
+    }
+
+    reopen();
+    REQUIRE_FALSE(std::filesystem::exists(store_path / "strings.log.create"));
+    REQUIRE(get({"hestia:object:1"})[0] == "one");
+    REQUIRE(set_list("hestia:objects") == std::vector<std::string>{"1", "2"});
+    REQUIRE_FALSE(std::filesystem::exists(store_path / "strings_db.json"));
+    REQUIRE_FALSE(
+        std::filesystem::exists(store_path / "hestia_objects_set.meta"));
+
+    reopen();
+    REQUIRE(get({"hestia:object:1"})[0] == "one");
+}
\ No newline at end of file
@@ -7,6 +7,8 @@
 #include "ObjectStoreTestWrapper.h"
 #include "TestUtils.h"
 
+#include <fstream>
+
 class FileObjectStoreTestFixture {
   public:
     ~FileObjectStoreTestFixture()
@@ -16,15 +18,20 @@ class FileObjectStoreTestFixture {
 
     void init(const std::string& test_name)
     {
-        m_test_name           = test_name;
+        m_test_name = test_name;
+        std::filesystem::remove_all(get_store_path());
+        reopen();
+    }
+
+    void reopen()
+    {
         const auto store_path = get_store_path();
-        std::filesystem::remove_all(store_path);
 
         m_client = ObjectStoreTestWrapper::create(
             hestia::FileObjectStoreClient::create());
 
         hestia::FileObjectStoreClientConfig config;
-        config.m_root = store_path;
+        config.m_root.init_value(store_path);
         config.m_mode.init_value(
             hestia::FileObjectStoreClientConfig::Mode::DATA_AND_METADATA);
 
@@ -79,4 +86,321 @@ TEST_CASE_METHOD(
     m_client->remove(obj);
 
     m_client->exists(obj, false);
-}
\ No newline at end of file
+}
+
+TEST_CASE_METHOD(
+    FileObjectStoreTestFixture,
+    "Test local file object store extents",
+    "[storage]")
+{
+    init("LocalFileObjectStoreExtents");
+
+    hestia::StorageObject obj("0000");
+
+    std::string objdata = "The quick brown fox jumps over the lazy dog.";
+    std::vector<char> buffer(objdata.begin(), objdata.end());
+    obj.set_size(buffer.size());
+
+    hestia::Stream stream;
+    stream.set_source(hestia::InMemoryStreamSource::create(buffer));
+    m_client->put(obj, {0, buffer.size()}, &stream);
+    REQUIRE(stream.flush().ok());
+
+    SECTION("Ranged read")
+    {
+        std::vector<char> read_buffer(5);
+        stream.set_sink(hestia::InMemoryStreamSink::create(read_buffer));
+        m_client->get(obj, {4, 5}, &stream);
+        REQUIRE(stream.flush().ok());
+
+        REQUIRE(std::string(read_buffer.begin(), read_buffer.end()) == "quick");
+    }
+
+    SECTION("Partial write keeps the rest of the object")
+    {
+        std::string part = "slow ";
+        std::vector<char> part_buffer(part.begin(), part.end());
+
+        hestia::StorageObject part_obj("0000");
+        stream.set_source(hestia::InMemoryStreamSource::create(part_buffer));
+        m_client->put(part_obj, {4, part_buffer.size()}, &stream);
+        REQUIRE(stream.flush().ok());
+
+        std::vector<char> read_buffer(buffer.size());
+        stream.set_sink(hestia::InMemoryStreamSink::create(read_buffer));
+        m_client->get(obj, &stream);
+        REQUIRE(stream.flush().ok());
+
+        REQUIRE(
+            std::string(read_buffer.begin(), read_buffer.end())
+            == "The slow  brown fox jumps over the lazy dog.");
+    }
+
+    SECTION("Write past the end leaves a hole")
+    {
+        std::string part = "end";
+        std::vector<char> part_buffer(part.begin(), part.end());
+
+        hestia::StorageObject part_obj("0000");
+        const std::size_t offset = buffer.size() + 10;
+        stream.set_source(hestia::InMemoryStreamSource::create(part_buffer));
+        m_client->put(part_obj, {offset, part_buffer.size()}, &stream);
+        REQUIRE(stream.flush().ok());
+
+        std::vector<char> read_buffer(13);
+        stream.set_sink(hestia::InMemoryStreamSink::create(read_buffer));
+        m_client->get(obj, {buffer.size(), 13}, &stream);
+        REQUIRE(stream.flush().ok());
+
+        std::string expected(10, '\0');
+        expected += part;
+        REQUIRE(
+            std::string(read_buffer.begin(), read_buffer.end()) == expected);
+    }
+
+    SECTION("Whole object write replaces the content")
+    {
+        std::string replacement = "Short";
+        std::vector<char> replacement_buffer(
+            replacement.begin(), replacement.end());
+
+        hestia::StorageObject replacement_obj("0000");
+        replacement_obj.set_size(replacement_buffer.size());
+        stream.set_source(
+            hestia::InMemoryStreamSource::create(replacement_buffer));
+        m_client->put(
+            replacement_obj, {0, replacement_buffer.size()}, &stream);
+        REQUIRE(stream.flush().ok());
+
+        std::vector<char> read_buffer(replacement_buffer.size());
+        stream.set_sink(hestia::InMemoryStreamSink::create(read_buffer));
+        m_client->get(obj, &stream);
+        REQUIRE(stream.get_source_size() == replacement_buffer.size());
+        REQUIRE(stream.flush().ok());
+
+        REQUIRE(read_buffer == replacement_buffer);
+    }
+}
+
+TEST_CASE_METHOD(
+    FileObjectStoreTestFixture,
+    "Test local file object store list",
+    "[storage]")
+{
+    init("LocalFileObjectStoreList");
+
+    for (const auto& [id, colour] :
+         std::vector<std::pair<std::string, std::string>>{
+             {"0000", "red"}, {"0001", "blue"}, {"0002", "red"}}) {
+        hestia::StorageObject obj(id);
+        obj.set_metadata("colour", colour);
+        m_client->put(obj);
+    }
+
+    std::vector<hestia::StorageObject> objects;
+    m_client->list({"colour", "red"}, objects);
+    REQUIRE(objects.size() == 2);
+    REQUIRE(objects[0].id() == "0000");
+    REQUIRE(objects[1].id() == "0002");
+
+    hestia::StorageObject updated("0002");
+    updated.set_metadata("colour", "blue");
+    m_client->put(updated);
+    m_client->remove(hestia::StorageObject("0000"));
+
+    // The metadata log is replayed on startup
+    reopen();
+
+    objects.clear();
+    m_client->list({"colour", "red"}, objects);
+    REQUIRE(objects.empty());
+
+    m_client->list({"colour", "blue"}, objects);
+    REQUIRE(objects.size() == 2);
+    REQUIRE(objects[1].metadata().get_item("colour") == "blue");
+}
+
+TEST_CASE_METHOD(
+    FileObjectStoreTestFixture,
+    "Test local file object store legacy layout",
+    "[storage]")
+{
+    m_test_name           = "LocalFileObjectStoreLegacy";
+    const auto store_path = std::filesystem::path(get_store_path());
+    std::filesystem::remove_all(store_path);
+    std::filesystem::create_directories(store_path);
+    {
+        std::ofstream meta_file(store_path / "0000.meta");
+        meta_file << "colour red\n";
+
+        std::ofstream data_file(store_path / "0000.data");
+        data_file << "legacy content";
+
+        // Left by an import interrupted before its log was moved in place
+        std::ofstream partial_log(store_path / "metadata.log.create");
+        partial_log << "S";
+    }
+
+    reopen();
+    REQUIRE_FALSE(std::filesystem::exists(store_path / "0000.meta"));
+    REQUIRE_FALSE(std::filesystem::exists(store_path / "metadata.log.create"));
+
+    std::vector<hestia::StorageObject> objects;
+    m_client->list({"colour", "red"}, objects);
+    REQUIRE(objects.size() == 1);
+
+    std::vector<char> read_buffer(14);
+    hestia::Stream stream;
+    stream.set_sink(hestia::InMemoryStreamSink::create(read_buffer));
+
+    hestia::StorageObject obj("0000");
+    m_client->get(obj, &stream);
+    REQUIRE(stream.flush().ok());
+    REQUIRE(obj.metadata().get_item("colour") == "red");
+    REQUIRE(
+        std::string(read_buffer.begin(), read_buffer.end())
+        == "legacy content");
+
+    // The data was moved into the sharded layout when first read
+    REQUIRE_FALSE(std::filesystem::exists(store_path / "0000.data"));
+    m_client->exists(obj, true);
+}
+
+TEST_CASE_METHOD(
+    FileObjectStoreTestFixture,
+    "Test local file object store migrate",
+    "[storage]")
+{
+    init("LocalFileObjectStoreMigrate");
+
+    hestia::FileObjectStoreClientConfig config;
+    config.m_mode.init_value(
+        hestia::FileObjectStoreClientConfig::Mode::DATA_AND_METADATA);
+
+    hestia::FileObjectStoreClient source;
+    config.m_root.init_value(get_store_path() + "/source");
+    source.do_initialize("0", {}, config);
+
+    hestia::FileObjectStoreClient target;
+    config.m_root.init_value(get_store_path() + "/target");
+    target.do_initialize("1", {}, config);
+
+    std::string objdata = "The quick brown fox jumps over the lazy dog.";
+    std::vector<char> buffer(objdata.begin(), objdata.end());
+
+    hestia::StorageObject obj("0000");
+    obj.set_metadata("colour", "red");
+
+    hestia::Stream stream;
+    stream.set_source(hestia::InMemoryStreamSource::create(buffer));
+    hestia::ObjectStoreRequest put_request(
+        obj, hestia::ObjectStoreRequestMethod::PUT);
+    REQUIRE(source.make_request(put_request, &stream)->ok());
+    REQUIRE(stream.flush().ok());
+
+    source.migrate("0000", target, true);
+
+    hestia::ObjectStoreRequest exists_request(
+        obj, hestia::ObjectStoreRequestMethod::EXISTS);
+    REQUIRE(source.make_request(exists_request)->object_found());
+    REQUIRE(target.make_request(exists_request)->object_found());
+
+    source.migrate("0000", target, false);
+    REQUIRE_FALSE(source.make_request(exists_request)->object_found());
+
+    std::vector<char> read_buffer(buffer.size());
+    stream.set_sink(hestia::InMemoryStreamSink::create(read_buffer));
+    hestia::ObjectStoreRequest get_request(
+        obj, hestia::ObjectStoreRequestMethod::GET);
+    auto get_response = target.make_request(get_request, &stream);
+    REQUIRE(get_response->ok());
+    REQUIRE(stream.flush().ok());
+
+    REQUIRE(read_buffer == buffer);
+    REQUIRE(get_response->object().metadata().get_item("colour") == "red");
+}
+
+TEST_CASE_METHOD(
+    FileObjectStoreTestFixture,
+    "Test local file object store async io",
+    "[storage]")
+{
+    init("LocalFileObjectStoreAsyncIo");
+
+    // Small blocks and a shallow queue so objects span several ops
+    hestia::FileObjectStoreClientConfig config;
+    config.m_root.init_value(get_store_path());
+    config.m_io_engine.init_value(
+        hestia::FileObjectStoreClientConfig::IoEngine::ASYNC);
+    config.m_queue_depth.init_value(2);
+    config.m_block_size.init_value(4096);
+    config.m_direct_io.init_value(true);
+
+    hestia::FileObjectStoreClient client;
+    client.do_initialize("0", {}, config);
+
+    std::vector<char> buffer(5 * 4096 + 100);
+    for (std::size_t idx = 0; idx < buffer.size(); idx++) {
+        buffer[idx] = static_cast<char>('a' + idx % 26);
+    }
+
+    hestia::StorageObject obj("0000");
+    obj.set_size(buffer.size());
+
+    hestia::Stream stream;
+    stream.set_source(hestia::InMemoryStreamSource::create(buffer));
+    hestia::ObjectStoreRequest put_request(
+        obj, hestia::ObjectStoreRequestMethod::PUT);
+    REQUIRE(client.make_request(put_request, &stream)->ok());
+    REQUIRE(stream.flush().ok());
+
+    SECTION("Whole object")
+    {
+        std::vector<char> read_buffer(buffer.size());
+        stream.set_sink(hestia::InMemoryStreamSink::create(read_buffer));
+        hestia::ObjectStoreRequest get_request(
+            obj, hestia::ObjectStoreRequestMethod::GET);
+        REQUIRE(client.make_request(get_request, &stream)->ok());
+        REQUIRE(stream.flush().ok());
+        REQUIRE(read_buffer == buffer);
+    }
+
+    SECTION("Unaligned range")
+    {
+        const hestia::Extent extent{4000, 2 * 4096};
+        std::vector<char> read_buffer(extent.m_length);
+        stream.set_sink(hestia::InMemoryStreamSink::create(read_buffer));
+        hestia::ObjectStoreRequest get_request(
+            obj, hestia::ObjectStoreRequestMethod::GET);
+        get_request.set_extent(extent);
+        REQUIRE(client.make_request(get_request, &stream)->ok());
+        REQUIRE(stream.flush().ok());
+
+        const auto start = buffer.begin() + extent.m_offset;
+        REQUIRE(std::equal(
+            read_buffer.begin(), read_buffer.end(), start,
+            start + extent.m_length));
+    }
+
+    SECTION("Unaligned partial write")
+    {
+        std::string part = "async";
+        std::vector<char> part_buffer(part.begin(), part.end());
+        stream.set_source(hestia::InMemoryStreamSource::create(part_buffer));
+        hestia::ObjectStoreRequest part_request(
+            hestia::StorageObject("0000"),
+            hestia::ObjectStoreRequestMethod::PUT);
+        part_request.set_extent({4094, part_buffer.size()});
+        REQUIRE(client.make_request(part_request, &stream)->ok());
+        REQUIRE(stream.flush().ok());
+
+        std::copy(part.begin(), part.end(), buffer.begin() + 4094);
+        std::vector<char> read_buffer(buffer.size());
+        stream.set_sink(hestia::InMemoryStreamSink::create(read_buffer));
+        hestia::ObjectStoreRequest get_request(
+            obj, hestia::ObjectStoreRequestMethod::GET);
+        REQUIRE(client.make_request(get_request, &stream)->ok());
+        REQUIRE(stream.flush().ok());
+        REQUIRE(read_buffer == buffer);
+    }
+}
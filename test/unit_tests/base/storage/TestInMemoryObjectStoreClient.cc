@@ -1,5 +1,6 @@
 #include <catch2/catch_all.hpp>
 
+#include "InMemoryHsmObjectStoreClient.h"
 #include "InMemoryObjectStoreClient.h"
 #include "InMemoryStreamSink.h"
 #include "InMemoryStreamSource.h"
@@ -108,6 +109,30 @@ TEST_CASE_METHOD(
         }
     }
 
+    WHEN("Content is followed by an empty write")
+    {
+        REQUIRE(stream.write(content).ok());
+        REQUIRE(stream.write(std::string()).ok());
+        REQUIRE(stream.reset().ok());
+
+        WHEN("Content is read in one chunk")
+        {
+            get(obj, &stream);
+
+            std::vector<char> returned_buffer(content.length());
+            hestia::WriteableBufferView write_buffer(returned_buffer);
+            REQUIRE(stream.read(write_buffer).ok());
+            REQUIRE(stream.reset().ok());
+
+            THEN("It is the same as the original content")
+            {
+                std::string returned_content =
+                    std::string(returned_buffer.begin(), returned_buffer.end());
+                REQUIRE(returned_content == content);
+            }
+        }
+    }
+
     WHEN("Content is passed in multiple chunks")
     {
         std::size_t chunk_size = 10;
@@ -143,5 +168,156 @@ TEST_CASE_METHOD(
                 REQUIRE(returned_content == content);
             }
         }
+
+        WHEN("Content is read in multiple chunks")
+        {
+            get(obj, &stream);
+
+            std::vector<char> returned_buffer(content.length());
+            for (std::size_t offset = 0; offset < content.size();
+                 offset += chunk_size) {
+                hestia::WriteableBufferView write_buffer(
+                    returned_buffer.data() + offset,
+                    std::min(chunk_size, content.size() - offset));
+                REQUIRE(stream.read(write_buffer).ok());
+            }
+            REQUIRE(stream.reset().ok());
+
+            THEN("It is the same as the original content")
+            {
+                std::string returned_content =
+                    std::string(returned_buffer.begin(), returned_buffer.end());
+                REQUIRE(returned_content == content);
+            }
+        }
+    }
+}
+
+TEST_CASE("In Memory object store - Memory budget", "[storage]")
+{
+    hestia::Dictionary config_dict;
+    config_dict.set_map(
+        {{"memory_budget", "8"}, {"block_size", "4"}, {"num_shards", "1"}});
+
+    hestia::InMemoryObjectStoreClient client;
+    client.initialize("0", {}, config_dict);
+
+    std::string content = "abcdefgh";
+    std::vector<bool> written;
+    for (const auto& id : {"0000", "1111"}) {
+        hestia::StorageObject obj(id);
+
+        hestia::Stream stream;
+        hestia::ObjectStoreRequest put_request(
+            obj, hestia::ObjectStoreRequestMethod::PUT);
+        put_request.set_extent({0, content.size()});
+        REQUIRE(client.get_eviction_candidates(put_request)
+                == std::vector<std::string>(written.size(), "0000"));
+        REQUIRE(client.make_request(put_request, &stream)->ok());
+        written.push_back(stream.write(content).ok());
+        (void)stream.reset();
+    }
+
+    REQUIRE(written[0]);
+    REQUIRE_FALSE(written[1]);
+
+    hestia::StorageObject obj("0000");
+    hestia::Stream stream;
+    hestia::ObjectStoreRequest get_request(
+        obj, hestia::ObjectStoreRequestMethod::GET);
+    REQUIRE(client.make_request(get_request, &stream)->ok());
+
+    std::vector<char> returned_buffer(content.length());
+    hestia::WriteableBufferView write_buffer(returned_buffer);
+    REQUIRE(stream.read(write_buffer).ok());
+    REQUIRE(stream.reset().ok());
+    REQUIRE(
+        std::string(returned_buffer.begin(), returned_buffer.end())
+        == content);
+}
+
+class InMemoryHsmStoreTestFixture {
+  public:
+    InMemoryHsmStoreTestFixture()
+    {
+        hestia::Dictionary config_dict;
+        config_dict.set_map(
+            {{"memory_budget", "8"},
+             {"block_size", "4"},
+             {"num_shards", "1"}});
+
+        m_client.set_tier_names({"0", "1"});
+        m_client.initialize("0", {}, config_dict);
+    }
+
+    void put(const std::string& id, uint8_t tier, const std::string& content)
+    {
+        hestia::Stream stream;
+        hestia::HsmObjectStoreRequest request(
+            id, hestia::HsmObjectStoreRequestMethod::PUT);
+        request.set_target_tier(tier);
+        REQUIRE(m_client.make_request(request, &stream)->ok());
+        REQUIRE(stream.write(content).ok());
+        REQUIRE(stream.reset().ok());
+    }
+
+    bool get(const std::string& id, uint8_t tier, std::string& content)
+    {
+        std::vector<char> buffer(8);
+        hestia::Stream stream;
+        stream.set_sink(hestia::InMemoryStreamSink::create(
+            hestia::WriteableBufferView(buffer)));
+
+        hestia::HsmObjectStoreRequest request(
+            id, hestia::HsmObjectStoreRequestMethod::GET);
+        request.set_source_tier(tier);
+        if (!m_client.make_request(request, &stream)->ok()
+            || !stream.flush().ok()) {
+            return false;
+        }
+        content = std::string(buffer.begin(), buffer.end());
+        return true;
+    }
+
+    void copy(const std::string& id, uint8_t source_tier, uint8_t target_tier)
+    {
+        hestia::HsmObjectStoreRequest request(
+            id, hestia::HsmObjectStoreRequestMethod::COPY);
+        request.set_source_tier(source_tier);
+        request.set_target_tier(target_tier);
+        REQUIRE(m_client.make_request(request)->ok());
+    }
+
+    void release(const std::string& id, uint8_t tier)
+    {
+        hestia::HsmObjectStoreRequest request(
+            id, hestia::HsmObjectStoreRequestMethod::REMOVE);
+        request.set_source_tier(tier);
+        REQUIRE(m_client.make_request(request)->ok());
+    }
+
+    hestia::InMemoryHsmObjectStoreClient m_client;
+};
+
+TEST_CASE_METHOD(
+    InMemoryHsmStoreTestFixture,
+    "In Memory hsm object store - Copy then release",
+    "[storage]")
+{
+    std::string content = "abcdefgh";
+    put("0000", 0, content);
+    copy("0000", 0, 1);
+
+    WHEN("The source copy is released")
+    {
+        release("0000", 0);
+
+        THEN("Only the target copy is left")
+        {
+            std::string returned_content;
+            REQUIRE_FALSE(get("0000", 0, returned_content));
+            REQUIRE(get("0000", 1, returned_content));
+            REQUIRE(returned_content == content);
+        }
     }
 }
\ No newline at end of file
@@ -5,7 +5,10 @@
 #include "ObjectStoreBackend.h"
 
 #include "DistributedHsmService.h"
+#include "HashUtils.h"
 #include "HsmService.h"
+#include "S3MultipartUpload.h"
+#include "S3MultipartUploads.h"
 #include "S3Request.h"
 #include "StorageTier.h"
 #include "TypedCrudRequest.h"
@@ -18,7 +21,10 @@
 #include "DistributedHsmServiceTestWrapper.h"
 
 #include "Logger.h"
+
+#include <algorithm>
 #include <iostream>
+#include <sstream>
 
 class WebAppTestFixture {
   public:
@@ -33,7 +39,7 @@ class WebAppTestFixture {
             m_fixture->m_user_service.get());
     }
 
-    void add_s3_headers(hestia::HttpRequest& req)
+    hestia::S3Request get_signing_request(const hestia::HttpRequest& req)
     {
         hestia::S3Request s3_request(req);
         s3_request.m_timestamp.m_value = "20130524";
@@ -42,25 +48,137 @@ class WebAppTestFixture {
         s3_request.set_user_secret_key(m_fixture->m_token_generator->m_token);
         s3_request.m_signed_headers = {
             "host", "range", "x-amz-content-sha256", "x-amz-date"};
+        req.get_queries().for_each_item(
+            [&s3_request](const std::string& key, const std::string& value) {
+                s3_request.m_queries.push_back({key, value});
+            });
+        std::sort(s3_request.m_queries.begin(), s3_request.m_queries.end());
+        return s3_request;
+    }
 
+    void add_s3_headers(
+        hestia::HttpRequest& req, const std::string& payload_sig = {})
+    {
+        auto s3_request = get_signing_request(req);
         s3_request.populate_headers("", req.get_header());
-        s3_request.populate_authorization_headers(
-            hestia::S3Request::PayloadSignatureType::UNSIGNED, req);
+        if (payload_sig.empty()) {
+            s3_request.populate_authorization_headers(
+                hestia::S3Request::PayloadSignatureType::UNSIGNED, req);
+        }
+        else {
+            s3_request.populate_authorization_headers(payload_sig, req);
+        }
+    }
+
+    // Encode the data as signed aws-chunked chunks, chained from the
+    // signature of the request headers
+    std::string encode_aws_chunked(
+        const hestia::HttpRequest& req, const std::string& data)
+    {
+        const auto s3_request  = get_signing_request(req);
+        const auto signing_key = s3_request.get_signing_key(
+            m_fixture->m_token_generator->m_token);
+        const auto& auth = req.get_header().get_item("authorization");
+        auto previous_signature = auth.substr(auth.rfind('=') + 1);
+
+        const std::size_t chunk_size = 16;
+        std::string encoded;
+        std::size_t cursor = 0;
+        while (true) {
+            const auto chunk     = data.substr(cursor, chunk_size);
+            const auto signature = hestia::HashUtils::do_h_mac_hex(
+                signing_key,
+                "AWS4-HMAC-SHA256-PAYLOAD\n"
+                    + req.get_header().get_item("x-amz-date") + "\n"
+                    + s3_request.get_scope() + "\n" + previous_signature
+                    + "\n" + hestia::HashUtils::do_sha256("") + "\n"
+                    + hestia::HashUtils::do_sha256(chunk));
+            std::stringstream sstr;
+            sstr << std::hex << chunk.size();
+            encoded += sstr.str() + ";chunk-signature=" + signature + "\r\n"
+                       + chunk + "\r\n";
+            previous_signature = signature;
+            if (chunk.empty()) {
+                break;
+            }
+            cursor += chunk.size();
+        }
+        return encoded;
     }
 
     hestia::HttpResponse* make_request(
         const std::string& path,
         hestia::HttpRequest::Method method,
-        const std::string& data = {})
+        const std::string& data        = {},
+        const hestia::Map& queries     = {},
+        const std::string& payload_sig = {})
     {
         m_working_context = std::make_unique<hestia::RequestContext>();
         m_working_context->set_request(hestia::HttpRequest{path, method});
+        auto& request = m_working_context->get_writeable_request();
+        request.set_queries(queries);
+        add_s3_headers(request, payload_sig);
+
+        if (payload_sig == streaming_payload) {
+            request.get_header().set_item("content-encoding", "aws-chunked");
+            request.get_header().set_item(
+                "x-amz-decoded-content-length", std::to_string(data.size()));
+            return send_request(method, encode_aws_chunked(request, data));
+        }
+        return send_request(method, data);
+    }
+
+    std::string get_object_data(const std::string& path)
+    {
+        m_working_context = std::make_unique<hestia::RequestContext>();
+        m_working_context->set_request(
+            hestia::HttpRequest{path, hestia::HttpRequest::Method::GET});
         add_s3_headers(m_working_context->get_writeable_request());
 
+        std::string data;
+        m_working_context->set_output_chunk_handler(
+            [&data](const hestia::ReadableBufferView& buffer, bool) {
+                data.append(buffer.data(), buffer.length());
+                return buffer.length();
+            });
+        m_web_app->on_event(
+            m_working_context.get(), hestia::HttpEvent::HEADERS);
+        REQUIRE(m_working_context->get_response()->code() == 200);
+        m_working_context->flush_stream();
+        return data;
+    }
+
+    static std::string get_md5(const std::string& data)
+    {
+        hestia::EvpHasher hasher(hestia::HashUtils::md5_digest());
+        hasher.update(data.data(), data.size());
+        return hasher.finish();
+    }
+
+    hestia::HttpResponse* upload_part(
+        const std::string& path,
+        const std::string& upload_id,
+        std::size_t number,
+        const std::string& data)
+    {
+        hestia::Map queries;
+        queries.set_item("uploadId", upload_id);
+        queries.set_item("partNumber", std::to_string(number));
+        return make_request(
+            path, hestia::HttpRequest::Method::PUT, data, queries);
+    }
+
+    hestia::HttpResponse* send_request(
+        hestia::HttpRequest::Method method, const std::string& data)
+    {
         if (method == hestia::HttpRequest::Method::PUT && !data.empty()) {
             m_working_context->get_writeable_request().get_header().set_item(
                 "Content-Length", std::to_string(data.size()));
         }
+        else if (method == hestia::HttpRequest::Method::POST) {
+            // The server buffers POST bodies before handling them
+            m_working_context->get_writeable_request().body() = data;
+        }
 
         /*
         if (method == hestia::HttpRequest::Method::GET && !data.empty())
@@ -144,6 +262,9 @@ class WebAppTestFixture {
         return m_working_context->get_response();
     }
 
+    static constexpr const char streaming_payload[]{
+        "STREAMING-AWS4-HMAC-SHA256-PAYLOAD"};
+
     std::unique_ptr<DistributedHsmServiceTestWrapper> m_fixture;
     std::unique_ptr<hestia::HestiaS3WebApp> m_web_app;
     std::unique_ptr<hestia::RequestContext> m_working_context;
@@ -191,4 +312,322 @@ TEST_CASE_METHOD(WebAppTestFixture, "Test s3 web app", "[s3]")
     returned_data); REQUIRE(response->code() == 200); REQUIRE(returned_data ==
     obj_data);
     */
-}
\ No newline at end of file
+}
+TEST_CASE_METHOD(WebAppTestFixture, "Test s3 multipart upload", "[s3]")
+{
+    auto response = make_request("/mybucket", hestia::HttpRequest::Method::PUT);
+    REQUIRE(response->code() == 201);
+
+    hestia::Map create_queries;
+    create_queries.set_item("uploads", "");
+    response = make_request(
+        "/mybucket/myobject", hestia::HttpRequest::Method::POST, {},
+        create_queries);
+    REQUIRE(response->code() == 200);
+
+    hestia::S3CreateMultipartUploadResponse create_response;
+    create_response.deserialize(response->body());
+    REQUIRE(create_response.m_bucket == "mybucket");
+    REQUIRE(create_response.m_key == "myobject");
+    const auto upload_id = create_response.m_upload_id;
+    REQUIRE_FALSE(upload_id.empty());
+
+    // The first part fixes the part size, after which parts can come in any
+    // order
+    const std::vector<std::string> parts = {
+        "The quick brown fox ", "jumps over the lazy ", "dog."};
+    hestia::S3CompleteMultipartUploadRequest complete_request;
+    complete_request.m_parts.resize(parts.size());
+    for (const std::size_t idx : {1, 3, 2}) {
+        response =
+            upload_part("/mybucket/myobject", upload_id, idx, parts[idx - 1]);
+        REQUIRE(response->code() == 200);
+        REQUIRE(
+            response->header().get_item("ETag")
+            == "\"" + get_md5(parts[idx - 1]) + "\"");
+        complete_request.m_parts[idx - 1].m_number = idx;
+        complete_request.m_parts[idx - 1].m_etag =
+            response->header().get_item("ETag");
+    }
+
+    hestia::Map upload_queries;
+    upload_queries.set_item("uploadId", upload_id);
+    response = make_request(
+        "/mybucket/myobject", hestia::HttpRequest::Method::GET, {},
+        upload_queries);
+    REQUIRE(response->code() == 200);
+    REQUIRE(
+        response->body().find("<PartNumber>3</PartNumber>")
+        != std::string::npos);
+
+    hestia::Map uploads_queries;
+    uploads_queries.set_item("uploads", "");
+    response = make_request(
+        "/mybucket", hestia::HttpRequest::Method::GET, {}, uploads_queries);
+    REQUIRE(response->code() == 200);
+    REQUIRE(response->body().find(upload_id) != std::string::npos);
+
+    // Staging data isn't listed with the bucket's objects
+    response = make_request("/mybucket", hestia::HttpRequest::Method::GET);
+    REQUIRE(response->code() == 200);
+    REQUIRE(response->body().find("<Key>") == std::string::npos);
+
+    auto bad_request = complete_request;
+    std::swap(bad_request.m_parts[0], bad_request.m_parts[1]);
+    response = make_request(
+        "/mybucket/myobject", hestia::HttpRequest::Method::POST,
+        bad_request.to_string(), upload_queries);
+    REQUIRE(response->code() == 400);
+
+    response = make_request(
+        "/mybucket/myobject", hestia::HttpRequest::Method::POST,
+        complete_request.to_string(), upload_queries);
+    REQUIRE(response->code() == 200);
+    hestia::S3CompleteMultipartUploadResponse complete_response;
+    complete_response.deserialize(response->body());
+    REQUIRE(complete_response.m_key == "myobject");
+    REQUIRE(complete_response.m_etag.find("-3") != std::string::npos);
+    REQUIRE(
+        get_object_data("/mybucket/myobject")
+        == "The quick brown fox jumps over the lazy dog.");
+
+    response = make_request("/mybucket", hestia::HttpRequest::Method::GET);
+    REQUIRE(response->code() == 200);
+    REQUIRE(
+        response->body().find("<Key>myobject</Key>") != std::string::npos);
+    REQUIRE(response->body().find("<Size>44</Size>") != std::string::npos);
+    REQUIRE(
+        response->body().find(".hestia-staging-") == std::string::npos);
+
+    response =
+        make_request("/mybucket/myobject", hestia::HttpRequest::Method::HEAD);
+    REQUIRE(response->code() == 200);
+
+    // The upload is gone once completed
+    response = make_request(
+        "/mybucket/myobject", hestia::HttpRequest::Method::GET, {},
+        upload_queries);
+    REQUIRE(response->code() == 404);
+
+    response = make_request(
+        "/mybucket/otherobject", hestia::HttpRequest::Method::POST, {},
+        create_queries);
+    REQUIRE(response->code() == 200);
+    create_response.deserialize(response->body());
+
+    upload_queries.set_item("uploadId", create_response.m_upload_id);
+    response = make_request(
+        "/mybucket/otherobject", hestia::HttpRequest::Method::DELETE, {},
+        upload_queries);
+    REQUIRE(response->code() == 204);
+
+    response = make_request(
+        "/mybucket", hestia::HttpRequest::Method::GET, {}, uploads_queries);
+    REQUIRE(response->code() == 200);
+    REQUIRE(
+        response->body().find(create_response.m_upload_id)
+        == std::string::npos);
+}
+
+TEST_CASE("Test s3 multipart upload ids", "[s3]")
+{
+    // Ids go out in xml and json, so the raw random bytes can't be used
+    const auto id = hestia::S3MultipartUploads::generate_id();
+    REQUIRE(id.size() == 32);
+    REQUIRE(id.find_first_not_of("0123456789abcdef") == std::string::npos);
+    REQUIRE(id != hestia::S3MultipartUploads::generate_id());
+}
+
+TEST_CASE("Test s3 staging names", "[s3]")
+{
+    const auto name = hestia::S3MultipartUploads::get_staging_name(
+        hestia::S3MultipartUploads::generate_id());
+    REQUIRE(name.rfind(".hestia-staging-", 0) == 0);
+    REQUIRE(hestia::S3MultipartUploads::is_staging_name(name));
+    REQUIRE_FALSE(hestia::S3MultipartUploads::is_staging_name("myobject"));
+}
+
+TEST_CASE_METHOD(
+    WebAppTestFixture, "Test s3 multipart upload out of order", "[s3]")
+{
+    auto response = make_request("/mybucket", hestia::HttpRequest::Method::PUT);
+    REQUIRE(response->code() == 201);
+
+    hestia::Map create_queries;
+    create_queries.set_item("uploads", "");
+    response = make_request(
+        "/mybucket/myobject", hestia::HttpRequest::Method::POST, {},
+        create_queries);
+    REQUIRE(response->code() == 200);
+    hestia::S3CreateMultipartUploadResponse create_response;
+    create_response.deserialize(response->body());
+    const auto upload_id = create_response.m_upload_id;
+
+    // Part 2 can't be placed before part 1 has fixed the part size, so the
+    // client is asked to retry it
+    const std::vector<std::string> parts = {
+        "The quick brown fox jumps ", "over the lazy dog."};
+    response = upload_part("/mybucket/myobject", upload_id, 2, parts[1]);
+    REQUIRE(response->code() == 503);
+    REQUIRE(response->body().find("SlowDown") != std::string::npos);
+
+    hestia::S3CompleteMultipartUploadRequest complete_request;
+    complete_request.m_parts.resize(parts.size());
+    for (const std::size_t idx : {1, 2}) {
+        response =
+            upload_part("/mybucket/myobject", upload_id, idx, parts[idx - 1]);
+        REQUIRE(response->code() == 200);
+        complete_request.m_parts[idx - 1].m_number = idx;
+        complete_request.m_parts[idx - 1].m_etag =
+            response->header().get_item("ETag");
+    }
+
+    // Retrying a short part 1 doesn't move the parts already placed
+    response = upload_part("/mybucket/myobject", upload_id, 1, "The quick");
+    REQUIRE(response->code() == 200);
+    response = upload_part("/mybucket/myobject", upload_id, 1, parts[0]);
+    REQUIRE(response->code() == 200);
+
+    hestia::Map upload_queries;
+    upload_queries.set_item("uploadId", upload_id);
+    response = make_request(
+        "/mybucket/myobject", hestia::HttpRequest::Method::POST,
+        complete_request.to_string(), upload_queries);
+    REQUIRE(response->code() == 200);
+
+    // The ETag is the MD5 of the part MD5s, as with AWS
+    hestia::S3CompleteMultipartUploadResponse complete_response;
+    complete_response.deserialize(response->body());
+    hestia::EvpHasher hasher(hestia::HashUtils::md5_digest());
+    for (const auto& part : parts) {
+        std::vector<unsigned char> md5;
+        hestia::HashUtils::do_md5(part, md5);
+        hasher.update(reinterpret_cast<const char*>(md5.data()), md5.size());
+    }
+    REQUIRE(complete_response.m_etag == "\"" + hasher.finish() + "-2\"");
+
+    REQUIRE(
+        get_object_data("/mybucket/myobject")
+        == "The quick brown fox jumps over the lazy dog.");
+}
+
+TEST_CASE_METHOD(WebAppTestFixture, "Test s3 signed payloads", "[s3]")
+{
+    auto response = make_request("/mybucket", hestia::HttpRequest::Method::PUT);
+    REQUIRE(response->code() == 201);
+
+    const std::string obj_data = "The quick brown fox jumps over the lazy dog.";
+    const auto obj_hash        = hestia::HashUtils::do_sha256(obj_data);
+
+    WHEN("The payload matches its signed hash")
+    {
+        response = make_request(
+            "/mybucket/myobject", hestia::HttpRequest::Method::PUT, obj_data,
+            {}, obj_hash);
+        REQUIRE(response->code() == 200);
+
+        response = make_request(
+            "/mybucket/myobject", hestia::HttpRequest::Method::HEAD);
+        REQUIRE(response->code() == 200);
+    }
+
+    WHEN("The payload does not match its signed hash")
+    {
+        response = make_request(
+            "/mybucket/myobject", hestia::HttpRequest::Method::PUT,
+            "The quick brown fox jumps over the lazy cat.", {}, obj_hash);
+        REQUIRE(response->code() == 400);
+        REQUIRE(
+            response->body().find("XAmzContentSHA256Mismatch")
+            != std::string::npos);
+
+        // The object written as the payload streamed in is rolled back
+        response = make_request(
+            "/mybucket/myobject", hestia::HttpRequest::Method::HEAD);
+        REQUIRE(response->code() == 404);
+    }
+
+    WHEN("An object is overwritten with a payload not matching its hash")
+    {
+        response = make_request(
+            "/mybucket/myobject", hestia::HttpRequest::Method::PUT, obj_data,
+            {}, obj_hash);
+        REQUIRE(response->code() == 200);
+
+        response = make_request(
+            "/mybucket/myobject", hestia::HttpRequest::Method::PUT,
+            "The quick brown fox jumps over the lazy cat.", {}, obj_hash);
+        REQUIRE(response->code() == 400);
+
+        // The existing object is untouched and no staging data is left
+        REQUIRE(get_object_data("/mybucket/myobject") == obj_data);
+        response = make_request("/mybucket", hestia::HttpRequest::Method::GET);
+        REQUIRE(response->code() == 200);
+        REQUIRE(
+            response->body().find("<Key>myobject</Key>") != std::string::npos);
+        REQUIRE(
+            response->body().find(".hestia-staging-") == std::string::npos);
+
+        const std::string new_data = "Pack my box with five dozen liquor jugs.";
+        response                   = make_request(
+            "/mybucket/myobject", hestia::HttpRequest::Method::PUT, new_data,
+            {}, hestia::HashUtils::do_sha256(new_data));
+        REQUIRE(response->code() == 200);
+        REQUIRE(get_object_data("/mybucket/myobject") == new_data);
+    }
+
+    WHEN("The payload is sent as signed aws-chunked chunks")
+    {
+        response = make_request(
+            "/mybucket/myobject", hestia::HttpRequest::Method::PUT, obj_data,
+            {}, streaming_payload);
+        REQUIRE(response->code() == 200);
+
+        // Only the decoded data is stored
+        response = make_request("/mybucket", hestia::HttpRequest::Method::GET);
+        REQUIRE(response->code() == 200);
+        REQUIRE(
+            response->body().find(
+                "<Size>" + std::to_string(obj_data.size()) + "</Size>")
+            != std::string::npos);
+    }
+}
+
+TEST_CASE_METHOD(WebAppTestFixture, "Test s3 overwrite object", "[s3]")
+{
+    auto response =
+        make_request("/mybucket", hestia::HttpRequest::Method::PUT);
+    REQUIRE(response->code() == 201);
+
+    response = make_request(
+        "/mybucket/myobject", hestia::HttpRequest::Method::PUT,
+        "The quick brown fox jumps over the lazy dog.");
+    REQUIRE(response->code() == 200);
+
+    response = make_request(
+        "/mybucket/myobject", hestia::HttpRequest::Method::PUT,
+        "Pack my box with five dozen liquor jugs.");
+    REQUIRE(response->code() == 200);
+    REQUIRE(
+        get_object_data("/mybucket/myobject")
+        == "Pack my box with five dozen liquor jugs.");
+
+    // The replaced object is gone, not left behind under a staging name
+    response = make_request("/mybucket", hestia::HttpRequest::Method::GET);
+    REQUIRE(response->code() == 200);
+    const auto& body  = response->body();
+    const auto first  = body.find("<Key>myobject</Key>");
+    REQUIRE(first != std::string::npos);
+    REQUIRE(body.find("<Key>myobject</Key>", first + 1) == std::string::npos);
+    REQUIRE(body.find(".hestia-staging-") == std::string::npos);
+
+    const auto objects_response =
+        m_fixture->m_dist_hsm_service->make_request(
+            hestia::CrudRequest{
+                hestia::CrudQuery{hestia::CrudQuery::OutputFormat::ITEM},
+                {m_fixture->m_user_service->get_current_user()
+                     .get_primary_key()}},
+            hestia::HsmItem::hsm_object_name);
+    REQUIRE(objects_response->ok());
+    REQUIRE(objects_response->items().size() == 1);
+}
@@ -0,0 +1,178 @@
+#include <catch2/catch_all.hpp>
+
+#include "CapacityDataPlacementEngine.h"
+#include "HsmServicesFactory.h"
+#include "InMemoryKeyValueStoreClient.h"
+#include "ObjectStoreBackend.h"
+#include "StorageTier.h"
+#include "TypedCrudRequest.h"
+#include "UserService.h"
+
+#include <set>
+#include <thread>
+
+class CapacityDataPlacementEngineTestFixture {
+  public:
+    CapacityDataPlacementEngineTestFixture()
+    {
+        m_kv_store_client =
+            std::make_unique<hestia::InMemoryKeyValueStoreClient>();
+        hestia::KeyValueStoreCrudServiceBackend crud_backend(
+            m_kv_store_client.get());
+        m_user_service = hestia::UserService::create({}, &crud_backend);
+
+        hestia::User test_user;
+        test_user.set_name("test_user");
+        auto user_response =
+            m_user_service->make_request(hestia::TypedCrudRequest<hestia::User>(
+                hestia::CrudMethod::CREATE, test_user, {},
+                hestia::CrudQuery::OutputFormat::ITEM));
+        REQUIRE(user_response->ok());
+        m_user_id =
+            user_response->get_item_as<hestia::User>()->get_primary_key();
+
+        m_services = std::make_unique<hestia::HsmServiceCollection>();
+        m_services->create_default_services(
+            {}, &crud_backend, m_user_service.get(), nullptr);
+    }
+
+    std::string add_tier(
+        uint8_t id, std::size_t capacity, std::size_t bandwidth)
+    {
+        hestia::StorageTier tier(id);
+        tier.set_capacity(capacity);
+        tier.set_bandwidth(bandwidth);
+        auto response = get_tier_service()->make_request(
+            hestia::TypedCrudRequest<hestia::StorageTier>{
+                hestia::CrudMethod::CREATE, tier, m_user_id,
+                hestia::CrudQuery::OutputFormat::ITEM});
+        REQUIRE(response->ok());
+        return response->get_item()->get_primary_key();
+    }
+
+    void add_backend(const std::string& tier_id, const std::string& node_id)
+    {
+        hestia::ObjectStoreBackend backend(
+            hestia::ObjectStoreBackend::Type::MEMORY);
+        backend.add_tier_id(tier_id);
+        backend.set_node_id(node_id);
+        auto response =
+            m_services->get_service(hestia::HsmItem::Type::OBJECT_STORE_BACKEND)
+                ->make_request(
+                    hestia::TypedCrudRequest<hestia::ObjectStoreBackend>{
+                        hestia::CrudMethod::CREATE, backend, m_user_id});
+        REQUIRE(response->ok());
+    }
+
+    hestia::CrudService* get_tier_service()
+    {
+        return m_services->get_service(hestia::HsmItem::Type::TIER);
+    }
+
+    std::unique_ptr<hestia::InMemoryKeyValueStoreClient> m_kv_store_client;
+    std::unique_ptr<hestia::UserService> m_user_service;
+    std::unique_ptr<hestia::HsmServiceCollection> m_services;
+    std::string m_user_id;
+};
+
+TEST_CASE_METHOD(
+    CapacityDataPlacementEngineTestFixture,
+    "Test Capacity Data Placement Engine - Spill",
+    "[hsm]")
+{
+    add_tier(0, 1000, 100);
+    add_tier(1, 0, 10);
+    add_tier(2, 1000, 50);
+
+    hestia::CapacityDataPlacementEngine engine(get_tier_service());
+
+    // The hint is used while it has room
+    REQUIRE(engine.choose_tier(500, 0) == 0);
+    engine.on_put_started(0, 500);
+
+    // In-flight writes count against the tier - spill to the next fastest
+    REQUIRE(engine.choose_tier(500, 0) == 2);
+
+    // Failed writes don't use space
+    engine.on_put_finished(0, 500, 0);
+    REQUIRE(engine.choose_tier(500, 0) == 0);
+
+    engine.on_put_started(0, 800);
+    engine.on_put_finished(0, 800, 800);
+    engine.on_put_started(2, 800);
+    engine.on_put_finished(2, 800, 800);
+
+    // Tiers without a capacity never fill
+    REQUIRE(engine.choose_tier(500, 0) == 1);
+
+    // Writes don't go to tiers faster than the hint
+    REQUIRE(engine.choose_tier(10, 1) == 1);
+
+    // No nodes are registered for the tiers
+    REQUIRE(engine.choose_node(0, 10).empty());
+}
+
+TEST_CASE_METHOD(
+    CapacityDataPlacementEngineTestFixture,
+    "Test Capacity Data Placement Engine - Unknown Tier",
+    "[hsm]")
+{
+    add_tier(0, 100, 0);
+
+    hestia::CapacityDataPlacementEngine engine(get_tier_service());
+    REQUIRE(engine.choose_tier(10, 5) == 5);
+
+    // Nothing has room - fall back to the hint
+    REQUIRE(engine.choose_tier(1000, 0) == 0);
+}
+
+TEST_CASE_METHOD(
+    CapacityDataPlacementEngineTestFixture,
+    "Test Capacity Data Placement Engine - Nodes",
+    "[hsm]")
+{
+    const auto tier_id = add_tier(0, 0, 0);
+    for (const auto& node_id : {"node0", "node1", "node2"}) {
+        add_backend(tier_id, node_id);
+    }
+
+    hestia::CapacityDataPlacementEngine engine(get_tier_service());
+
+    // An object gets the same node each time, and objects spread over nodes
+    std::set<std::string> nodes;
+    for (std::size_t idx = 0; idx < 30; idx++) {
+        const auto object_id = "object" + std::to_string(idx);
+        const auto node      = engine.choose_node(0, 10, object_id);
+        REQUIRE_FALSE(node.empty());
+        REQUIRE(engine.choose_node(0, 0, object_id) == node);
+        nodes.insert(node);
+    }
+    REQUIRE(nodes.size() == 3);
+}
+
+TEST_CASE_METHOD(
+    CapacityDataPlacementEngineTestFixture,
+    "Test Capacity Data Placement Engine - Background Refresh",
+    "[hsm]")
+{
+    add_tier(0, 1000, 100);
+
+    // Refresh on every call after the first load
+    hestia::CapacityDataPlacementEngine engine(
+        get_tier_service(), nullptr, std::chrono::seconds(0));
+    REQUIRE(engine.choose_tier(500, 0) == 0);
+    engine.on_put_started(0, 950);
+
+    // The new tier is found by a later refresh, and the in-flight write
+    // still counts against the full tier
+    add_tier(1, 0, 10);
+    std::uint8_t chosen_tier{0};
+    for (std::size_t attempt = 0; attempt < 100 && chosen_tier != 1;
+         attempt++) {
+        chosen_tier = engine.choose_tier(500, 0);
+        if (chosen_tier != 1) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        }
+    }
+    REQUIRE(chosen_tier == 1);
+}
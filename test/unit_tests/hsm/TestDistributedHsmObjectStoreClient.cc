@@ -3,6 +3,7 @@
 #include "DistributedHsmObjectStoreClient.h"
 
 #include "DistributedHsmService.h"
+#include "FileObjectStoreClient.h"
 
 #include "ApplicationMiddleware.h"
 #include "DataPlacementEngine.h"
@@ -19,6 +20,7 @@
 #include "InMemoryKeyValueStoreClient.h"
 #include "InMemoryStreamSink.h"
 #include "InMemoryStreamSource.h"
+#include "StorageTier.h"
 #include "TypedCrudRequest.h"
 #include "UserService.h"
 
@@ -173,16 +175,31 @@ class MockHsmHttpClient : public hestia::HttpClient {
 
 class DistributedHsmObjectStoreClientTestFixture {
   public:
-    DistributedHsmObjectStoreClientTestFixture()
+    DistributedHsmObjectStoreClientTestFixture(
+        const std::vector<hestia::ObjectStoreBackend>& worker_backends =
+            get_memory_backends())
     {
         m_kv_store_client =
             std::make_unique<hestia::InMemoryKeyValueStoreClient>();
 
         setup_controller();
-        setup_worker();
+        setup_worker(worker_backends);
         setup_local_client();
     }
 
+    static std::vector<hestia::ObjectStoreBackend> get_memory_backends()
+    {
+        hestia::InMemoryObjectStoreClientConfig hsm_memory_client_config;
+        hestia::Dictionary serialized_config;
+        hsm_memory_client_config.serialize(serialized_config);
+
+        hestia::ObjectStoreBackend object_store_backend(
+            hestia::ObjectStoreBackend::Type::MEMORY_HSM);
+        object_store_backend.set_tier_names({"0", "1", "2", "3", "4"});
+        object_store_backend.set_config(serialized_config);
+        return {object_store_backend};
+    }
+
     void setup_local_client()
     {
         LOG_INFO("Setting up client");
@@ -284,7 +301,7 @@ class DistributedHsmObjectStoreClientTestFixture {
             {}, m_controller_dist_hsm_service.get());
     }
 
-    void setup_worker()
+    void setup_worker(const std::vector<hestia::ObjectStoreBackend>& backends)
     {
         LOG_INFO("Setting up worker");
         auto client_factory =
@@ -319,16 +336,7 @@ class DistributedHsmObjectStoreClientTestFixture {
         dist_hsm_config.m_self.set_name("my_worker");
         dist_hsm_config.m_is_server = true;
 
-        hestia::InMemoryObjectStoreClientConfig hsm_memory_client_config;
-        hestia::Dictionary serialized_config;
-        hsm_memory_client_config.serialize(serialized_config);
-
-        hestia::ObjectStoreBackend object_store_backend(
-            hestia::ObjectStoreBackend::Type::MEMORY_HSM);
-        object_store_backend.set_tier_names({"0", "1", "2", "3", "4"});
-        object_store_backend.set_config(serialized_config);
-
-        dist_hsm_config.m_backends = {object_store_backend};
+        dist_hsm_config.m_backends = backends;
 
         m_worker_dist_hsm_service = hestia::DistributedHsmService::create(
             dist_hsm_config, std::move(hsm_service), m_user_service.get());
@@ -371,6 +379,234 @@ class DistributedHsmObjectStoreClientTestFixture {
     hestia::User m_test_user;
 };
 
+// Tier 0 is a plain file store and tier 1 a file hsm store, both keeping
+// metadata
+class DistributedHsmFileTierTestFixture :
+    public DistributedHsmObjectStoreClientTestFixture {
+  public:
+    DistributedHsmFileTierTestFixture() :
+        DistributedHsmObjectStoreClientTestFixture(get_file_backends())
+    {
+    }
+
+    static std::filesystem::path get_test_dir()
+    {
+        return TestUtils::get_test_output_dir(__FILE__) / "FileTiers";
+    }
+
+    static std::vector<hestia::ObjectStoreBackend> get_file_backends()
+    {
+        std::filesystem::remove_all(get_test_dir());
+
+        hestia::Dictionary file_config;
+        file_config.set_map(
+            {{"root", (get_test_dir() / "file").string()},
+             {"mode", "data_and_metadata"}});
+        hestia::ObjectStoreBackend file_backend(
+            hestia::ObjectStoreBackend::Type::FILE);
+        file_backend.set_tier_names({"0"});
+        file_backend.set_config(file_config);
+
+        hestia::Dictionary file_hsm_config;
+        file_hsm_config.set_map(
+            {{"root", (get_test_dir() / "file_hsm").string()},
+             {"mode", "data_and_metadata"}});
+        hestia::ObjectStoreBackend file_hsm_backend(
+            hestia::ObjectStoreBackend::Type::FILE_HSM);
+        file_hsm_backend.set_tier_names({"1"});
+        file_hsm_backend.set_config(file_hsm_config);
+        return {file_backend, file_hsm_backend};
+    }
+
+    void put(const hestia::StorageObject& obj, const std::string& content)
+    {
+        hestia::Stream stream;
+        hestia::HsmObjectStoreRequest request(
+            obj, hestia::HsmObjectStoreRequestMethod::PUT);
+        request.set_target_tier(0);
+        REQUIRE(m_worker_object_store_client->make_request(request, &stream)
+                    ->ok());
+        REQUIRE(stream.write(content).ok());
+        REQUIRE(stream.reset().ok());
+    }
+
+    void copy_or_move(
+        const std::string& id,
+        hestia::HsmObjectStoreRequestMethod method,
+        uint8_t source_tier,
+        uint8_t target_tier)
+    {
+        hestia::HsmObjectStoreRequest request(id, method);
+        request.set_source_tier(source_tier);
+        request.set_target_tier(target_tier);
+        REQUIRE(m_worker_object_store_client->make_request(request)->ok());
+    }
+
+    // Responses from a plain file tier don't carry the object back through
+    // the distributed client, so its store is read directly
+    hestia::FileObjectStoreClient::Ptr open_file_tier()
+    {
+        hestia::FileObjectStoreClientConfig config;
+        config.m_root.init_value((get_test_dir() / "file").string());
+        config.m_mode.init_value(
+            hestia::FileObjectStoreClientConfig::Mode::DATA_AND_METADATA);
+        auto client = hestia::FileObjectStoreClient::create();
+        client->do_initialize("0", {}, config);
+        return client;
+    }
+
+    bool is_on_file_tier(const std::string& id)
+    {
+        hestia::ObjectStoreRequest request(
+            id, hestia::ObjectStoreRequestMethod::EXISTS);
+        auto response = open_file_tier()->make_request(request);
+        REQUIRE(response->ok());
+        return response->object_found();
+    }
+
+    void check_object(
+        const std::string& id, uint8_t tier, const std::string& content)
+    {
+        std::vector<char> buffer(content.size());
+        hestia::Stream stream;
+        stream.set_sink(hestia::InMemoryStreamSink::create(
+            hestia::WriteableBufferView(buffer)));
+
+        hestia::StorageObject object;
+        if (tier == 0) {
+            hestia::ObjectStoreRequest request(
+                id, hestia::ObjectStoreRequestMethod::GET);
+            auto response = open_file_tier()->make_request(request, &stream);
+            REQUIRE(response->ok());
+            object = response->object();
+        }
+        else {
+            hestia::HsmObjectStoreRequest request(
+                id, hestia::HsmObjectStoreRequestMethod::GET);
+            request.set_source_tier(tier);
+            auto response =
+                m_worker_object_store_client->make_request(request, &stream);
+            REQUIRE(response->ok());
+            object = response->object();
+        }
+        REQUIRE(stream.flush().ok());
+
+        REQUIRE(object.metadata().get_item("mykey") == "myval");
+        REQUIRE(std::string(buffer.begin(), buffer.end()) == content);
+    }
+};
+
+// Tier 0 is a plain memory store with room for one object, in front of a
+// file hsm store as tier 1
+class DistributedHsmMemoryTierTestFixture :
+    public DistributedHsmObjectStoreClientTestFixture {
+  public:
+    DistributedHsmMemoryTierTestFixture() :
+        DistributedHsmObjectStoreClientTestFixture(get_memory_tier_backends())
+    {
+    }
+
+    static std::filesystem::path get_test_dir()
+    {
+        return TestUtils::get_test_output_dir(__FILE__) / "MemoryTier";
+    }
+
+    static std::vector<hestia::ObjectStoreBackend> get_memory_tier_backends()
+    {
+        std::filesystem::remove_all(get_test_dir());
+
+        hestia::Dictionary memory_config;
+        memory_config.set_map(
+            {{"memory_budget", "8"}, {"block_size", "4"}, {"num_shards", "1"}});
+        hestia::ObjectStoreBackend memory_backend(
+            hestia::ObjectStoreBackend::Type::MEMORY);
+        memory_backend.set_tier_names({"0"});
+        memory_backend.set_config(memory_config);
+
+        hestia::Dictionary file_hsm_config;
+        file_hsm_config.set_map(
+            {{"root", (get_test_dir() / "file_hsm").string()},
+             {"mode", "data_and_metadata"}});
+        hestia::ObjectStoreBackend file_hsm_backend(
+            hestia::ObjectStoreBackend::Type::FILE_HSM);
+        file_hsm_backend.set_tier_names({"1"});
+        file_hsm_backend.set_config(file_hsm_config);
+        return {memory_backend, file_hsm_backend};
+    }
+
+    void put_data(const std::string& id, const std::string& content)
+    {
+        create_object(id);
+
+        hestia::Stream stream;
+        stream.set_source(hestia::InMemoryStreamSource::create(
+            hestia::ReadableBufferView(content)));
+
+        hestia::HsmAction action(
+            hestia::HsmItem::Type::OBJECT, hestia::HsmAction::Action::PUT_DATA);
+        action.set_subject_key(id);
+
+        hestia::HsmActionResponse::Ptr response;
+        m_worker_dist_hsm_service->get_hsm_service()->do_data_io_action(
+            hestia::HsmActionRequest(action, {m_test_user.get_primary_key()}),
+            &stream, [&response](hestia::HsmActionResponse::Ptr result) {
+                response = std::move(result);
+            });
+        REQUIRE(stream.flush().ok());
+        REQUIRE(response != nullptr);
+        REQUIRE(response->ok());
+    }
+
+    std::size_t get_stored_size(const std::string& id, uint8_t tier)
+    {
+        auto hsm_service = m_worker_dist_hsm_service->get_hsm_service();
+
+        std::string tier_id;
+        auto tier_response =
+            hsm_service->get_service(hestia::HsmItem::Type::TIER)
+                ->make_request(hestia::CrudRequest{
+                    hestia::CrudQuery{hestia::CrudQuery::OutputFormat::ITEM},
+                    {m_test_user.get_primary_key()}});
+        for (const auto& item : tier_response->items()) {
+            const auto storage_tier =
+                dynamic_cast<const hestia::StorageTier*>(item.get());
+            if (storage_tier->id_uint() == tier) {
+                tier_id = storage_tier->get_primary_key();
+            }
+        }
+
+        auto response = hsm_service->make_request(
+            hestia::CrudRequest{
+                hestia::CrudQuery(id, hestia::CrudQuery::OutputFormat::ITEM),
+                {m_test_user.get_primary_key()}},
+            hestia::HsmItem::hsm_object_name);
+        REQUIRE(response->found());
+        for (const auto& extents :
+             response->get_item_as<hestia::HsmObject>()->tiers()) {
+            if (extents.get_tier_id() == tier_id) {
+                return extents.get_stored_size();
+            }
+        }
+        return 0;
+    }
+
+    std::string get_data(const std::string& id, uint8_t tier)
+    {
+        std::vector<char> buffer(8);
+        hestia::Stream stream;
+        stream.set_sink(hestia::InMemoryStreamSink::create(
+            hestia::WriteableBufferView(buffer)));
+
+        hestia::HsmObjectStoreRequest request(
+            id, hestia::HsmObjectStoreRequestMethod::GET);
+        request.set_source_tier(tier);
+        REQUIRE(m_worker_object_store_client->make_request(request, &stream)
+                    ->ok());
+        REQUIRE(stream.flush().ok());
+        return std::string(buffer.begin(), buffer.end());
+    }
+};
+
 TEST_CASE_METHOD(
     DistributedHsmObjectStoreClientTestFixture,
     "Test Distributed Hsm Object Store Client",
@@ -422,4 +658,64 @@ TEST_CASE_METHOD(
     REQUIRE(returned_buffer.size() == content.size());
     REQUIRE(
         std::string(returned_buffer.begin(), returned_buffer.end()) == content);
+}
+
+TEST_CASE_METHOD(
+    DistributedHsmFileTierTestFixture,
+    "Test Distributed Hsm Object Store Client - file tiers",
+    "[hsm]")
+{
+    hestia::StorageObject obj("0000");
+    obj.set_metadata("mykey", "myval");
+
+    std::string content = "The quick brown fox jumps over the lazy dog";
+    obj.set_size(content.size());
+    put(obj, content);
+
+    WHEN("The object is moved to the file hsm tier")
+    {
+        copy_or_move(
+            obj.id(), hestia::HsmObjectStoreRequestMethod::MOVE, 0, 1);
+
+        THEN("Its data and metadata are only on the file hsm tier")
+        {
+            check_object(obj.id(), 1, content);
+            REQUIRE_FALSE(is_on_file_tier(obj.id()));
+        }
+
+        WHEN("It is copied back to the file tier")
+        {
+            copy_or_move(
+                obj.id(), hestia::HsmObjectStoreRequestMethod::COPY, 1, 0);
+
+            THEN("Its data and metadata are on both tiers")
+            {
+                check_object(obj.id(), 0, content);
+                check_object(obj.id(), 1, content);
+            }
+        }
+    }
+}
+
+TEST_CASE_METHOD(
+    DistributedHsmMemoryTierTestFixture,
+    "Test Distributed Hsm Object Store Client - memory tier eviction",
+    "[hsm]")
+{
+    put_data("0000", "abcdefgh");
+    REQUIRE(get_stored_size("0000", 0) == 8);
+
+    WHEN("Another object is put on the full memory tier")
+    {
+        put_data("1111", "ijklmnop");
+
+        THEN("The first is moved to the file hsm tier, along with its extents")
+        {
+            REQUIRE(get_stored_size("1111", 0) == 8);
+            REQUIRE(get_stored_size("0000", 0) == 0);
+            REQUIRE(get_stored_size("0000", 1) == 8);
+            REQUIRE(get_data("0000", 1) == "abcdefgh");
+            REQUIRE(get_data("1111", 0) == "ijklmnop");
+        }
+    }
 }
\ No newline at end of file
@@ -10,7 +10,10 @@
 #include "HsmObjectStoreClientManager.h"
 #include "HsmService.h"
 #include "HttpClient.h"
+#include "InMemoryStreamSource.h"
 #include "ObjectStoreBackend.h"
+#include "StorageTier.h"
+#include "TierExtents.h"
 #include "TypedCrudRequest.h"
 #include "UserService.h"
 
@@ -97,3 +100,248 @@ TEST_CASE_METHOD(
     REQUIRE(get_response2->ok());
     REQUIRE(get_response2->items().size() == 2);
 }
+
+// A controller without backends of its own, so data actions are redirected
+class DistributedHsmControllerTestFixture {
+  public:
+    DistributedHsmControllerTestFixture()
+    {
+        m_kv_store_client =
+            std::make_unique<hestia::InMemoryKeyValueStoreClient>();
+        m_object_store_client =
+            std::make_unique<hestia::InMemoryHsmObjectStoreClient>();
+        m_object_store_client->set_tier_names({"0", "1"});
+        m_object_store_client->do_initialize("0000", {}, {});
+
+        hestia::KeyValueStoreCrudServiceBackend crud_backend(
+            m_kv_store_client.get());
+        m_user_service = hestia::UserService::create({}, &crud_backend);
+        REQUIRE(m_user_service->register_user("my_admin", "my_admin_password")
+                    ->ok());
+        REQUIRE(m_user_service
+                    ->authenticate_user("my_admin", "my_admin_password")
+                    ->ok());
+        m_user_id = m_user_service->get_current_user().get_primary_key();
+
+        auto hsm_service = hestia::HsmService::create(
+            hestia::ServiceConfig{}, m_kv_store_client.get(),
+            m_object_store_client.get(), m_user_service.get(), nullptr);
+        m_hsm_service = hsm_service.get();
+        get_service(hestia::HsmItem::Type::DATASET)
+            ->set_default_name("test_default_dataset");
+
+        hestia::DistributedHsmServiceConfig dist_hsm_config;
+        dist_hsm_config.m_is_server = true;
+        dist_hsm_config.m_self.set_is_controller(true);
+        m_dist_hsm_service = hestia::DistributedHsmService::create(
+            dist_hsm_config, std::move(hsm_service), m_user_service.get());
+    }
+
+    std::string add_tier(uint8_t id, std::size_t capacity)
+    {
+        hestia::StorageTier tier(id);
+        tier.set_capacity(capacity);
+        auto response = get_service(hestia::HsmItem::Type::TIER)
+                            ->make_request(
+                                hestia::TypedCrudRequest<hestia::StorageTier>{
+                                    hestia::CrudMethod::CREATE, tier,
+                                    m_user_id,
+                                    hestia::CrudQuery::OutputFormat::ITEM});
+        REQUIRE(response->ok());
+        m_hsm_service->update_tiers(m_user_id);
+        return response->get_item()->get_primary_key();
+    }
+
+    std::string add_node(const std::string& host)
+    {
+        hestia::HsmNode node;
+        node.set_name(host);
+        node.set_host_address(host);
+        auto response = get_service(hestia::HsmItem::Type::NODE)
+                            ->make_request(hestia::TypedCrudRequest{
+                                hestia::CrudMethod::CREATE, node, m_user_id,
+                                hestia::CrudQuery::OutputFormat::ITEM});
+        REQUIRE(response->ok());
+        return response->get_item()->get_primary_key();
+    }
+
+    std::string add_backend(
+        const std::string& tier_id, const std::string& node_id)
+    {
+        hestia::ObjectStoreBackend backend(
+            hestia::ObjectStoreBackend::Type::MEMORY);
+        backend.add_tier_id(tier_id);
+        backend.set_node_id(node_id);
+        auto response =
+            get_service(hestia::HsmItem::Type::OBJECT_STORE_BACKEND)
+                ->make_request(
+                    hestia::TypedCrudRequest<hestia::ObjectStoreBackend>{
+                        hestia::CrudMethod::CREATE, backend, m_user_id,
+                        hestia::CrudQuery::OutputFormat::ITEM});
+        REQUIRE(response->ok());
+        return response->get_item()->get_primary_key();
+    }
+
+    std::string add_object(
+        const std::string& tier_id = {}, const std::string& backend_id = {})
+    {
+        auto response = get_service(hestia::HsmItem::Type::OBJECT)
+                            ->make_request(hestia::CrudRequest{
+                                hestia::CrudMethod::CREATE,
+                                m_user_id,
+                                {},
+                                {},
+                                hestia::CrudQuery::OutputFormat::ITEM});
+        REQUIRE(response->ok());
+        const auto object_id = response->get_item()->get_primary_key();
+
+        if (!backend_id.empty()) {
+            hestia::TierExtents extents;
+            extents.set_object_id(object_id);
+            extents.set_tier_id(tier_id);
+            extents.set_backend_id(backend_id);
+            extents.add_extent({0, 10});
+            REQUIRE(get_service(hestia::HsmItem::Type::EXTENT)
+                        ->make_request(
+                            hestia::TypedCrudRequest<hestia::TierExtents>{
+                                hestia::CrudMethod::CREATE, extents,
+                                m_user_id})
+                        ->ok());
+        }
+        return object_id;
+    }
+
+    hestia::HsmActionResponse::Ptr put(
+        const std::string& object_id,
+        std::size_t size,
+        uint8_t tier,
+        hestia::Stream* stream = nullptr)
+    {
+        hestia::HsmAction action(
+            hestia::HsmItem::Type::OBJECT, hestia::HsmAction::Action::PUT_DATA);
+        action.set_subject_key(object_id);
+        action.set_target_tier(tier);
+        action.set_size(size);
+
+        hestia::HsmActionResponse::Ptr response;
+        m_dist_hsm_service->do_data_io_action(
+            hestia::HsmActionRequest(action, {m_user_id}), stream,
+            [&response](hestia::HsmActionResponse::Ptr completion_response) {
+                response = std::move(completion_response);
+            });
+        REQUIRE(response != nullptr);
+        return response;
+    }
+
+    hestia::CrudService* get_service(hestia::HsmItem::Type type)
+    {
+        return m_hsm_service->get_service(type);
+    }
+
+    std::unique_ptr<hestia::KeyValueStoreClient> m_kv_store_client;
+    std::unique_ptr<hestia::InMemoryHsmObjectStoreClient> m_object_store_client;
+    std::unique_ptr<hestia::UserService> m_user_service;
+    std::unique_ptr<hestia::DistributedHsmService> m_dist_hsm_service;
+    hestia::HsmService* m_hsm_service{nullptr};
+    std::string m_user_id;
+};
+
+TEST_CASE_METHOD(
+    DistributedHsmControllerTestFixture,
+    "Distributed Hsm Service - existing data routing",
+    "[dist-hsm-service]")
+{
+    const auto tier_id = add_tier(0, 0);
+    add_backend(tier_id, add_node("10.0.0.1"));
+    const auto backend_id = add_backend(tier_id, add_node("10.0.0.2"));
+
+    // Reads go to the node holding the data, wherever new data would go
+    for (std::size_t idx = 0; idx < 10; idx++) {
+        const auto object_id = add_object(tier_id, backend_id);
+        REQUIRE(
+            m_dist_hsm_service->get_backend_address(0, object_id)
+            == "10.0.0.2");
+    }
+
+    // New data is placed by the engine, the same way each time
+    const auto object_id = add_object();
+    const auto address = m_dist_hsm_service->get_backend_address(0, object_id);
+    REQUIRE_FALSE(address.empty());
+    REQUIRE(
+        m_dist_hsm_service->get_backend_address(0, object_id) == address);
+}
+
+TEST_CASE_METHOD(
+    DistributedHsmControllerTestFixture,
+    "Distributed Hsm Service - placed writes",
+    "[dist-hsm-service]")
+{
+    add_backend(add_tier(0, 1000), add_node("10.0.0.1"));
+    add_backend(add_tier(1, 0), add_node("10.0.0.2"));
+
+    // The write goes to the node for the tier chosen, which is passed on
+    auto response = put(add_object(), 100, 0);
+    REQUIRE(response->ok());
+    REQUIRE(response->get_redirect_location() == "10.0.0.1");
+    REQUIRE(
+        response->get_redirect_query()
+        == "?" + std::string(hestia::HsmActionRequest::placed_tier_query)
+               + "=0");
+
+    // Too big for tier 0, so spills to tier 1
+    response = put(add_object(), 950, 0);
+    REQUIRE(response->ok());
+    REQUIRE(response->get_redirect_location() == "10.0.0.2");
+    REQUIRE(
+        response->get_redirect_query()
+        == "?" + std::string(hestia::HsmActionRequest::placed_tier_query)
+               + "=1");
+
+    // The node redirected to takes the tier from the redirect query
+    hestia::HsmActionRequest request(
+        hestia::HsmAction(
+            hestia::HsmItem::Type::OBJECT, hestia::HsmAction::Action::PUT_DATA),
+        {m_user_id});
+    hestia::Map queries;
+    queries.set_item(hestia::HsmActionRequest::placed_tier_query, "x");
+    request.set_placed_tier(queries);
+    REQUIRE_FALSE(request.has_placed_tier());
+
+    queries.set_item(hestia::HsmActionRequest::placed_tier_query, "1");
+    request.set_placed_tier(queries);
+    REQUIRE(request.has_placed_tier());
+    REQUIRE(request.target_tier() == 1);
+}
+
+TEST_CASE_METHOD(
+    DistributedHsmControllerTestFixture,
+    "Distributed Hsm Service - overwrite usage",
+    "[dist-hsm-service]")
+{
+    add_tier(0, 1000);
+    add_tier(1, 0);
+
+    const auto object_id = add_object();
+    const std::string content(400, 'a');
+    for (std::size_t idx = 0; idx < 2; idx++) {
+        hestia::Stream stream;
+        stream.set_source(hestia::InMemoryStreamSource::create(
+            hestia::ReadableBufferView{content}));
+
+        hestia::HsmAction action(
+            hestia::HsmItem::Type::OBJECT, hestia::HsmAction::Action::PUT_DATA);
+        action.set_subject_key(object_id);
+
+        hestia::HsmActionResponse::Ptr response;
+        m_hsm_service->do_data_io_action(
+            hestia::HsmActionRequest(action, {m_user_id}), &stream,
+            [&response](hestia::HsmActionResponse::Ptr completion_response) {
+                response = std::move(completion_response);
+            });
+        (void)stream.flush();
+        REQUIRE(response->ok());
+    }
+
+    // Overwriting the object doesn't use more of the tier
+    REQUIRE(m_hsm_service->get_placement_engine()->choose_tier(300, 0) == 0);
+}
@@ -1,6 +1,7 @@
 #include <catch2/catch_all.hpp>
 
 #include "BasicDataPlacementEngine.h"
+#include "CrudCache.h"
 #include "InMemoryHsmObjectStoreClient.h"
 #include "InMemoryKeyValueStoreClient.h"
 #include "InMemoryStreamSink.h"
@@ -16,15 +17,49 @@
 
 #include <iostream>
 
+// Fails the next batch of writes to a key, as a store's transaction might
+class FailingBatchKeyValueStoreClient :
+    public hestia::InMemoryKeyValueStoreClient {
+  public:
+    mutable std::string m_fail_batch_writing;
+
+  protected:
+    void apply_batch(
+        const std::vector<hestia::KeyValueStoreRequest>& requests)
+        const override
+    {
+        if (!m_fail_batch_writing.empty()) {
+            for (const auto& request : requests) {
+                for (const auto& [key, value] : request.get_kv_pairs()) {
+                    if (key.size() >= m_fail_batch_writing.size()
+                        && key.compare(
+                               key.size() - m_fail_batch_writing.size(),
+                               std::string::npos, m_fail_batch_writing)
+                               == 0) {
+                        m_fail_batch_writing.clear();
+                        throw std::runtime_error("Batch failed");
+                    }
+                }
+            }
+        }
+        hestia::KeyValueStoreClient::apply_batch(requests);
+    }
+};
+
 class HsmServiceTestFixture {
   public:
-    HsmServiceTestFixture()
+    explicit HsmServiceTestFixture(std::size_t cache_size = 0)
     {
-        m_kv_store_client =
-            std::make_unique<hestia::InMemoryKeyValueStoreClient>();
+        m_kv_store_client = std::make_unique<FailingBatchKeyValueStoreClient>();
+
+        if (cache_size > 0) {
+            hestia::CrudCacheConfig cache_config;
+            cache_config.m_max_size.update_value(cache_size);
+            m_crud_cache = std::make_unique<hestia::CrudCache>(cache_config);
+        }
 
         hestia::KeyValueStoreCrudServiceBackend crud_backend(
-            m_kv_store_client.get());
+            m_kv_store_client.get(), m_crud_cache.get());
         m_user_service = hestia::UserService::create({}, &crud_backend);
 
         m_test_user.set_name("test_user");
@@ -225,14 +260,25 @@ class HsmServiceTestFixture {
         return false;
     }
 
-    std::unique_ptr<hestia::InMemoryKeyValueStoreClient> m_kv_store_client;
+    void check_data_actions();
+
+    void check_failed_metadata_commit();
+
+    std::unique_ptr<FailingBatchKeyValueStoreClient> m_kv_store_client;
+    std::unique_ptr<hestia::CrudCache> m_crud_cache;
     std::unique_ptr<hestia::InMemoryHsmObjectStoreClient> m_object_store_client;
     std::unique_ptr<hestia::UserService> m_user_service;
     std::unique_ptr<hestia::HsmService> m_hsm_service;
     hestia::User m_test_user;
 };
 
-TEST_CASE_METHOD(HsmServiceTestFixture, "HSM Service test", "[hsm-service]")
+// Runs through the metadata cache so stale entries would show up
+class CachedHsmServiceTestFixture : public HsmServiceTestFixture {
+  public:
+    CachedHsmServiceTestFixture() : HsmServiceTestFixture(1024 * 1024) {}
+};
+
+void HsmServiceTestFixture::check_data_actions()
 {
     std::string id_0 = "0000";
     hestia::HsmObject obj0(id_0);
@@ -327,3 +373,70 @@ TEST_CASE_METHOD(HsmServiceTestFixture, "HSM Service test", "[hsm-service]")
     REQUIRE_FALSE(is_object_on_tier(obj0, tier1_id));
     */
 }
+
+void HsmServiceTestFixture::check_failed_metadata_commit()
+{
+    hestia::HsmObject obj("0000");
+    create(obj);
+
+    const std::string content = "The quick brown fox jumps over the lazy dog.";
+    hestia::Stream stream;
+    stream.set_source(hestia::InMemoryStreamSource::create(
+        hestia::ReadableBufferView{content}));
+    put_data(obj, &stream, 0);
+
+    hestia::HsmAction action(
+        hestia::HsmItem::Type::OBJECT, hestia::HsmAction::Action::COPY_DATA);
+    action.set_source_tier(0);
+    action.set_target_tier(1);
+    action.set_subject_key(obj.get_primary_key());
+
+    // Fail the batch committing the copy, which updates the object
+    m_kv_store_client->m_fail_batch_writing =
+        std::string(":") + hestia::HsmItem::hsm_object_name + ":"
+        + obj.get_primary_key();
+    auto response = m_hsm_service->make_request(
+        hestia::HsmActionRequest(action, {m_test_user.get_primary_key()}));
+    REQUIRE_FALSE(response->ok());
+
+    // The action is marked as failed rather than left running
+    hestia::CrudQuery query(
+        hestia::CrudIdentifier(response->get_action().get_primary_key()),
+        hestia::CrudQuery::OutputFormat::ITEM);
+    auto action_response = m_hsm_service->make_request(
+        hestia::CrudRequest(query, {m_test_user.get_primary_key()}),
+        hestia::HsmItem::hsm_action_name);
+    REQUIRE(action_response->ok());
+    REQUIRE(action_response->found());
+    REQUIRE(
+        action_response->get_item_as<hestia::HsmAction>()->get_status()
+        == hestia::HsmAction::Status::ERROR);
+    REQUIRE_FALSE(is_object_on_tier(obj, 1));
+}
+
+TEST_CASE_METHOD(HsmServiceTestFixture, "HSM Service test", "[hsm-service]")
+{
+    check_data_actions();
+}
+
+TEST_CASE_METHOD(
+    CachedHsmServiceTestFixture, "HSM Service test - cached", "[hsm-service]")
+{
+    check_data_actions();
+}
+
+TEST_CASE_METHOD(
+    HsmServiceTestFixture,
+    "HSM Service failed metadata commit",
+    "[hsm-service]")
+{
+    check_failed_metadata_commit();
+}
+
+TEST_CASE_METHOD(
+    CachedHsmServiceTestFixture,
+    "HSM Service failed metadata commit - cached",
+    "[hsm-service]")
+{
+    check_failed_metadata_commit();
+}
@@ -7,4 +7,15 @@
 TEST_CASE("Test Tier Extents", "[hsm]")
 {
     hestia::TierExtents extents;
+    REQUIRE(extents.get_stored_size() == 0);
+
+    // The stored size leaves out the gap between extents
+    extents.add_extent({0, 10});
+    extents.add_extent({20, 5});
+    REQUIRE(extents.get_size() == 25);
+    REQUIRE(extents.get_stored_size() == 15);
+
+    // Rewriting an extent doesn't add to it
+    extents.add_extent({0, 10});
+    REQUIRE(extents.get_stored_size() == 15);
 }
\ No newline at end of file
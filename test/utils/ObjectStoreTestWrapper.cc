@@ -39,11 +39,31 @@ void ObjectStoreTestWrapper::put(
     REQUIRE(m_client->make_request(request, stream)->ok());
 }
 
+void ObjectStoreTestWrapper::put(
+    const hestia::StorageObject& obj,
+    const hestia::Extent& extent,
+    hestia::Stream* stream)
+{
+    hestia::ObjectStoreRequest request(
+        obj, hestia::ObjectStoreRequestMethod::PUT);
+    request.set_extent(extent);
+    REQUIRE(m_client->make_request(request, stream)->ok());
+}
+
 void ObjectStoreTestWrapper::get(
     hestia::StorageObject& obj, hestia::Stream* stream)
+{
+    get(obj, {}, stream);
+}
+
+void ObjectStoreTestWrapper::get(
+    hestia::StorageObject& obj,
+    const hestia::Extent& extent,
+    hestia::Stream* stream)
 {
     hestia::ObjectStoreRequest request(
         obj, hestia::ObjectStoreRequestMethod::GET);
+    request.set_extent(extent);
     auto response = m_client->make_request(request, stream);
     REQUIRE(response->ok());
     obj = response->object();
@@ -15,8 +15,18 @@ class ObjectStoreTestWrapper {
     void put(
         const hestia::StorageObject& obj, hestia::Stream* stream = nullptr);
 
+    void put(
+        const hestia::StorageObject& obj,
+        const hestia::Extent& extent,
+        hestia::Stream* stream);
+
     void get(hestia::StorageObject& obj, hestia::Stream* stream = nullptr);
 
+    void get(
+        hestia::StorageObject& obj,
+        const hestia::Extent& extent,
+        hestia::Stream* stream);
+
     void exists(const hestia::StorageObject& obj, bool should_exist);
 
     void list(